@@ -87,6 +87,16 @@ struct hg_test_bulk_args {
     hg_size_t target_offset;
 };
 
+struct hg_test_bulk_chunked_args {
+    hg_handle_t handle;
+    hg_thread_mutex_t mutex; /* Protects op_id and nbytes */
+    hg_op_id_t op_id;        /* Op ID of chunked transfer */
+    void *buf;               /* Local buffer */
+    hg_size_t nbytes;        /* Bytes of completed chunks */
+    hg_size_t cancel_size;   /* Cancel after that many bytes (0 for none) */
+    hg_bool_t error;         /* Chunk data did not match */
+};
+
 struct hg_test_bulk_fwd_args {
     hg_handle_t handle;
     hg_handle_t fwd_handle;
@@ -103,6 +113,12 @@ hg_test_bulk_transfer_cb(const struct hg_cb_info *hg_cb_info);
 static hg_return_t
 hg_test_bulk_bind_transfer_cb(const struct hg_cb_info *hg_cb_info);
 
+static hg_return_t
+hg_test_bulk_chunk_cb(void *arg, hg_size_t offset, hg_size_t size);
+
+static hg_return_t
+hg_test_bulk_chunked_transfer_cb(const struct hg_cb_info *hg_cb_info);
+
 static hg_return_t
 hg_test_bulk_bind_forward_fwd_cb(const struct hg_cb_info *hg_cb_info);
 
@@ -114,6 +130,13 @@ hg_test_perf_bulk_transfer_cb(const struct hg_cb_info *hg_cb_info);
 /*******************/
 
 extern hg_id_t hg_test_bulk_bind_write_id_g;
+extern hg_id_t hg_test_view_id_g;
+
+/* RPCs held by hg_test_rpc_hold until the expected count is received */
+static hg_thread_mutex_t hg_test_hold_mutex_g = HG_THREAD_MUTEX_INITIALIZER;
+static hg_handle_t *hg_test_hold_handles_g = NULL;
+static hg_uint32_t *hg_test_hold_indices_g = NULL;
+static hg_uint32_t hg_test_hold_count_g = 0;
 
 // extern hg_id_t hg_test_nested2_id_g;
 // hg_addr_t *hg_addr_table;
@@ -312,6 +335,70 @@ done:
     return ret;
 }
 
+/*---------------------------------------------------------------------------*/
+HG_TEST_RPC_CB(hg_test_view, handle)
+{
+    /* Same callback is registered with and without in place decoding */
+    hg_bool_t use_view = (HG_Get_info(handle)->id == hg_test_view_id_g);
+    view_in_t in_struct;
+    view_out_t out_struct;
+    char *buf, *bytes;
+    hg_size_t buf_size, i;
+    hg_return_t ret = HG_SUCCESS;
+
+    /* Get input buffer that decoded data may point to */
+    ret = HG_Get_input_extra_buf(handle, (void **) &buf, &buf_size);
+    HG_TEST_CHECK_HG_ERROR(done, ret, "HG_Get_input_extra_buf() failed (%s)",
+        HG_Error_to_string(ret));
+    if (buf == NULL) {
+        ret = HG_Get_input_buf(handle, (void **) &buf, &buf_size);
+        HG_TEST_CHECK_HG_ERROR(done, ret, "HG_Get_input_buf() failed (%s)",
+            HG_Error_to_string(ret));
+    }
+
+    /* Get input struct */
+    ret = (use_view) ? HG_Get_input_view(handle, &in_struct)
+                     : HG_Get_input(handle, &in_struct);
+    HG_TEST_CHECK_HG_ERROR(
+        done, ret, "HG_Get_input() failed (%s)", HG_Error_to_string(ret));
+
+    bytes = (char *) in_struct.bytes.data;
+    out_struct.string_len = strlen(in_struct.string);
+    out_struct.bytes_size = in_struct.bytes.size;
+    out_struct.in_place = (hg_uint8_t) (in_struct.string >= buf &&
+                                        in_struct.string < buf + buf_size &&
+                                        bytes >= buf && bytes < buf + buf_size);
+
+    /* Report a size of 0 if data does not match what was sent */
+    for (i = 0; i < out_struct.string_len; i++)
+        if (in_struct.string[i] != 'v')
+            out_struct.string_len = 0;
+    for (i = 0; i < out_struct.bytes_size; i++)
+        if (bytes[i] != (char) i)
+            out_struct.bytes_size = 0;
+
+    /* Send response back */
+    ret = HG_Respond(handle, NULL, NULL, &out_struct);
+    HG_TEST_CHECK_HG_ERROR(
+        done, ret, "HG_Respond() failed (%s)", HG_Error_to_string(ret));
+
+    /* Views must remain valid after responding */
+    HG_TEST_CHECK_ERROR(strlen(in_struct.string) != out_struct.string_len,
+        done, ret, HG_FAULT, "Input string was released");
+
+    ret = (use_view) ? HG_Free_input_view(handle, &in_struct)
+                     : HG_Free_input(handle, &in_struct);
+    HG_TEST_CHECK_HG_ERROR(
+        done, ret, "HG_Free_input() failed (%s)", HG_Error_to_string(ret));
+
+done:
+    ret = HG_Destroy(handle);
+    HG_TEST_CHECK_ERROR_DONE(
+        ret != HG_SUCCESS, "HG_Destroy() failed (%s)", HG_Error_to_string(ret));
+
+    return ret;
+}
+
 /*---------------------------------------------------------------------------*/
 HG_TEST_RPC_CB(hg_test_cancel_rpc, handle)
 {
@@ -329,6 +416,101 @@ HG_TEST_RPC_CB(hg_test_cancel_rpc, handle)
     return ret;
 }
 
+/*---------------------------------------------------------------------------*/
+HG_TEST_RPC_CB(hg_test_rpc_hold, handle)
+{
+    rpc_hold_in_t in_struct;
+    rpc_hold_out_t out_struct;
+    hg_uint32_t count, index, i;
+    hg_return_t ret = HG_SUCCESS;
+
+    /* Get input buffer */
+    ret = HG_Get_input(handle, &in_struct);
+    HG_TEST_CHECK_HG_ERROR(
+        error, ret, "HG_Get_input() failed (%s)", HG_Error_to_string(ret));
+
+    count = in_struct.count;
+    index = in_struct.index;
+
+    ret = HG_Free_input(handle, &in_struct);
+    HG_TEST_CHECK_HG_ERROR(
+        error, ret, "HG_Free_input() failed (%s)", HG_Error_to_string(ret));
+
+    hg_thread_mutex_lock(&hg_test_hold_mutex_g);
+    if (hg_test_hold_count_g == 0) {
+        hg_test_hold_handles_g = (hg_handle_t *) malloc(
+            count * sizeof(hg_handle_t));
+        hg_test_hold_indices_g = (hg_uint32_t *) malloc(
+            count * sizeof(hg_uint32_t));
+        HG_TEST_CHECK_ERROR(
+            hg_test_hold_handles_g == NULL || hg_test_hold_indices_g == NULL,
+            unlock, ret, HG_NOMEM_ERROR, "Could not allocate held handles");
+    }
+    hg_test_hold_indices_g[hg_test_hold_count_g] = index;
+    hg_test_hold_handles_g[hg_test_hold_count_g++] = handle;
+
+    /* Respond to all RPCs once the last one is received, each response
+     * echoes the index of its RPC */
+    if (hg_test_hold_count_g == count) {
+        for (i = 0; i < count; i++) {
+            out_struct.index = hg_test_hold_indices_g[i];
+            ret = HG_Respond(
+                hg_test_hold_handles_g[i], NULL, NULL, &out_struct);
+            HG_TEST_CHECK_ERROR_DONE(ret != HG_SUCCESS,
+                "HG_Respond() failed (%s)", HG_Error_to_string(ret));
+
+            ret = HG_Destroy(hg_test_hold_handles_g[i]);
+            HG_TEST_CHECK_ERROR_DONE(ret != HG_SUCCESS,
+                "HG_Destroy() failed (%s)", HG_Error_to_string(ret));
+        }
+        free(hg_test_hold_handles_g);
+        hg_test_hold_handles_g = NULL;
+        free(hg_test_hold_indices_g);
+        hg_test_hold_indices_g = NULL;
+        hg_test_hold_count_g = 0;
+    }
+    hg_thread_mutex_unlock(&hg_test_hold_mutex_g);
+
+    return ret;
+
+unlock:
+    hg_thread_mutex_unlock(&hg_test_hold_mutex_g);
+error:
+    (void) HG_Destroy(handle);
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+HG_TEST_RPC_CB(hg_test_post_stats, handle)
+{
+    struct hg_post_stats stats;
+    rpc_post_stats_out_t out_struct;
+    hg_return_t ret = HG_SUCCESS;
+
+    ret = HG_Context_get_post_stats(HG_Get_info(handle)->context, &stats);
+    HG_TEST_CHECK_HG_ERROR(done, ret, "HG_Context_get_post_stats() failed (%s)",
+        HG_Error_to_string(ret));
+
+    /* Fill output structure */
+    out_struct.grow_count = stats.grow_count;
+    out_struct.shrink_count = stats.shrink_count;
+    out_struct.total_count = stats.total_count;
+    out_struct.floor_count = stats.floor_count;
+
+    /* Send response back */
+    ret = HG_Respond(handle, NULL, NULL, &out_struct);
+    HG_TEST_CHECK_HG_ERROR(
+        done, ret, "HG_Respond() failed (%s)", HG_Error_to_string(ret));
+
+done:
+    ret = HG_Destroy(handle);
+    HG_TEST_CHECK_ERROR_DONE(
+        ret != HG_SUCCESS, "HG_Destroy() failed (%s)", HG_Error_to_string(ret));
+
+    return ret;
+}
+
 /*---------------------------------------------------------------------------*/
 HG_TEST_RPC_CB(hg_test_bulk_write, handle)
 {
@@ -480,6 +662,87 @@ error:
     return ret;
 }
 
+/*---------------------------------------------------------------------------*/
+HG_TEST_RPC_CB(hg_test_bulk_chunked_write, handle)
+{
+    const struct hg_info *hg_info = HG_Get_info(handle);
+    hg_bulk_t origin_bulk_handle = HG_BULK_NULL;
+    hg_bulk_t local_bulk_handle = HG_BULK_NULL;
+    struct hg_test_bulk_chunked_args *chunked_args = NULL;
+    struct hg_bulk_chunk_info chunk_info;
+    bulk_chunked_write_in_t in_struct;
+    hg_size_t transfer_size;
+    hg_return_t ret = HG_SUCCESS;
+
+    chunked_args = (struct hg_test_bulk_chunked_args *) calloc(
+        1, sizeof(struct hg_test_bulk_chunked_args));
+    HG_TEST_CHECK_ERROR(chunked_args == NULL, error, ret, HG_NOMEM_ERROR,
+        "Could not allocate chunked_args");
+    chunked_args->handle = handle;
+    chunked_args->op_id = HG_OP_ID_NULL;
+    hg_thread_mutex_init(&chunked_args->mutex);
+
+    /* Get input parameters and data */
+    ret = HG_Get_input(handle, &in_struct);
+    HG_TEST_CHECK_HG_ERROR(
+        error, ret, "HG_Get_input() failed (%s)", HG_Error_to_string(ret));
+
+    origin_bulk_handle = in_struct.bulk_handle;
+    transfer_size = in_struct.transfer_size;
+    chunked_args->cancel_size = in_struct.cancel_size;
+    chunk_info.chunk_size = in_struct.chunk_size;
+    chunk_info.max_in_flight = in_struct.max_in_flight;
+    chunk_info.chunk_cb = hg_test_bulk_chunk_cb;
+    chunk_info.chunk_arg = chunked_args;
+
+    ret = HG_Bulk_ref_incr(origin_bulk_handle);
+    HG_TEST_CHECK_HG_ERROR(
+        error, ret, "HG_Bulk_ref_incr() failed (%s)", HG_Error_to_string(ret));
+
+    /* Free input */
+    ret = HG_Free_input(handle, &in_struct);
+    HG_TEST_CHECK_HG_ERROR(
+        error, ret, "HG_Free_input() failed (%s)", HG_Error_to_string(ret));
+
+    /* Create a new block handle to read the data */
+    ret = HG_Bulk_create(hg_info->hg_class, 1, NULL, &transfer_size,
+        HG_BULK_READWRITE, &local_bulk_handle);
+    HG_TEST_CHECK_HG_ERROR(
+        error, ret, "HG_Bulk_create() failed (%s)", HG_Error_to_string(ret));
+
+    ret = HG_Bulk_access(local_bulk_handle, 0, transfer_size,
+        HG_BULK_READWRITE, 1, &chunked_args->buf, NULL, NULL);
+    HG_TEST_CHECK_HG_ERROR(
+        error, ret, "HG_Bulk_access() failed (%s)", HG_Error_to_string(ret));
+
+    /* Pull bulk data, chunks may complete before op ID is returned */
+    hg_thread_mutex_lock(&chunked_args->mutex);
+    ret = HG_Bulk_transfer_chunked(hg_info->context,
+        hg_test_bulk_chunked_transfer_cb, chunked_args, HG_BULK_PULL,
+        hg_info->addr, hg_info->context_id, origin_bulk_handle, 0,
+        local_bulk_handle, 0, transfer_size, &chunk_info,
+        &chunked_args->op_id);
+    hg_thread_mutex_unlock(&chunked_args->mutex);
+    HG_TEST_CHECK_HG_ERROR(error, ret,
+        "HG_Bulk_transfer_chunked() failed (%s)", HG_Error_to_string(ret));
+
+    return ret;
+
+error:
+    if (local_bulk_handle != HG_BULK_NULL)
+        HG_Bulk_free(local_bulk_handle);
+    if (chunked_args != NULL) {
+        hg_thread_mutex_destroy(&chunked_args->mutex);
+        free(chunked_args);
+    }
+
+    ret = HG_Destroy(handle);
+    HG_TEST_CHECK_ERROR_DONE(
+        ret != HG_SUCCESS, "HG_Destroy() failed (%s)", HG_Error_to_string(ret));
+
+    return ret;
+}
+
 /*---------------------------------------------------------------------------*/
 HG_TEST_RPC_CB(hg_test_bulk_bind_forward, handle)
 {
@@ -652,6 +915,82 @@ done:
     return ret;
 }
 
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_test_bulk_chunk_cb(void *arg, hg_size_t offset, hg_size_t size)
+{
+    struct hg_test_bulk_chunked_args *chunked_args =
+        (struct hg_test_bulk_chunked_args *) arg;
+    hg_return_t ret = HG_SUCCESS;
+
+    /* Chunks are consumed as soon as they complete */
+    if (bulk_write(0, chunked_args->buf, offset, 0, size, 0) != size) {
+        chunked_args->error = HG_TRUE;
+        return HG_FAULT;
+    }
+
+    hg_thread_mutex_lock(&chunked_args->mutex);
+    chunked_args->nbytes += size;
+    if (chunked_args->cancel_size > 0 &&
+        chunked_args->nbytes >= chunked_args->cancel_size) {
+        /* Cancel remaining chunks */
+        chunked_args->cancel_size = 0;
+        ret = HG_Bulk_cancel(chunked_args->op_id);
+        HG_TEST_CHECK_ERROR_DONE(ret != HG_SUCCESS,
+            "HG_Bulk_cancel() failed (%s)", HG_Error_to_string(ret));
+    }
+    hg_thread_mutex_unlock(&chunked_args->mutex);
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_test_bulk_chunked_transfer_cb(const struct hg_cb_info *hg_cb_info)
+{
+    struct hg_test_bulk_chunked_args *chunked_args =
+        (struct hg_test_bulk_chunked_args *) hg_cb_info->arg;
+    hg_bulk_t local_bulk_handle = hg_cb_info->info.bulk.local_handle;
+    hg_bulk_t origin_bulk_handle = hg_cb_info->info.bulk.origin_handle;
+    hg_return_t ret = HG_SUCCESS;
+    bulk_write_out_t out_struct;
+
+    /* Return number of bytes that were transferred and checked, a canceled
+     * transfer stops after the chunks that were in flight */
+    if (hg_cb_info->ret == HG_SUCCESS || hg_cb_info->ret == HG_CANCELED)
+        out_struct.ret = chunked_args->nbytes;
+    else {
+        HG_TEST_LOG_ERROR(
+            "Error in HG callback (%s)", HG_Error_to_string(hg_cb_info->ret));
+        out_struct.ret = 0;
+    }
+    if (chunked_args->error)
+        out_struct.ret = 0;
+
+    /* Free block handles */
+    ret = HG_Bulk_free(local_bulk_handle);
+    HG_TEST_CHECK_ERROR_DONE(ret != HG_SUCCESS, "HG_Bulk_free() failed (%s)",
+        HG_Error_to_string(ret));
+
+    ret = HG_Bulk_free(origin_bulk_handle);
+    HG_TEST_CHECK_ERROR_DONE(ret != HG_SUCCESS, "HG_Bulk_free() failed (%s)",
+        HG_Error_to_string(ret));
+
+    /* Send response back */
+    ret = HG_Respond(chunked_args->handle, NULL, NULL, &out_struct);
+    HG_TEST_CHECK_ERROR_DONE(
+        ret != HG_SUCCESS, "HG_Respond() failed (%s)", HG_Error_to_string(ret));
+
+    ret = HG_Destroy(chunked_args->handle);
+    HG_TEST_CHECK_ERROR_DONE(
+        ret != HG_SUCCESS, "HG_Destroy() failed (%s)", HG_Error_to_string(ret));
+
+    hg_thread_mutex_destroy(&chunked_args->mutex);
+    free(chunked_args);
+
+    return ret;
+}
+
 /*---------------------------------------------------------------------------*/
 static hg_return_t
 hg_test_bulk_bind_transfer_cb(const struct hg_cb_info *hg_cb_info)
@@ -1090,11 +1429,15 @@ HG_TEST_THREAD_CB(hg_test_rpc_null)
 HG_TEST_THREAD_CB(hg_test_rpc_open)
 HG_TEST_THREAD_CB(hg_test_rpc_open_no_resp)
 HG_TEST_THREAD_CB(hg_test_overflow)
+HG_TEST_THREAD_CB(hg_test_view)
 HG_TEST_THREAD_CB(hg_test_cancel_rpc)
+HG_TEST_THREAD_CB(hg_test_rpc_hold)
+HG_TEST_THREAD_CB(hg_test_post_stats)
 
 HG_TEST_THREAD_CB(hg_test_bulk_write)
 HG_TEST_THREAD_CB(hg_test_bulk_bind_write)
 HG_TEST_THREAD_CB(hg_test_bulk_bind_forward)
+HG_TEST_THREAD_CB(hg_test_bulk_chunked_write)
 
 HG_TEST_THREAD_CB(hg_test_killed_rpc)
 
@@ -19,7 +19,13 @@ hg_test_rpc_open_no_resp_cb(hg_handle_t handle);
 hg_return_t
 hg_test_overflow_cb(hg_handle_t handle);
 hg_return_t
+hg_test_view_cb(hg_handle_t handle);
+hg_return_t
 hg_test_cancel_rpc_cb(hg_handle_t handle);
+hg_return_t
+hg_test_rpc_hold_cb(hg_handle_t handle);
+hg_return_t
+hg_test_post_stats_cb(hg_handle_t handle);
 
 /**
  * test_bulk
@@ -30,6 +36,8 @@ hg_return_t
 hg_test_bulk_bind_write_cb(hg_handle_t handle);
 hg_return_t
 hg_test_bulk_bind_forward_cb(hg_handle_t handle);
+hg_return_t
+hg_test_bulk_chunked_write_cb(hg_handle_t handle);
 
 /**
  * test_kill
@@ -80,12 +80,17 @@ hg_id_t hg_test_rpc_null_id_g = 0;
 hg_id_t hg_test_rpc_open_id_g = 0;
 hg_id_t hg_test_rpc_open_id_no_resp_g = 0;
 hg_id_t hg_test_overflow_id_g = 0;
+hg_id_t hg_test_view_id_g = 0;
+hg_id_t hg_test_view_copy_id_g = 0;
 hg_id_t hg_test_cancel_rpc_id_g = 0;
+hg_id_t hg_test_rpc_hold_id_g = 0;
+hg_id_t hg_test_post_stats_id_g = 0;
 
 /* test_bulk */
 hg_id_t hg_test_bulk_write_id_g = 0;
 hg_id_t hg_test_bulk_bind_write_id_g = 0;
 hg_id_t hg_test_bulk_bind_forward_id_g = 0;
+hg_id_t hg_test_bulk_chunked_write_id_g = 0;
 
 /* test_kill */
 hg_id_t hg_test_killed_rpc_id_g = 0;
@@ -114,8 +119,12 @@ hg_test_usage(const char *execname)
     printf("    -a, --auth          Run auth key service\n");
     printf("    -x, --handle        Max number of handles\n");
     printf("    -m, --memory        Use shared-memory with local targets\n");
-    printf("    -t, --threads       Number of server threads\n");
+    printf("    -t, --threads       Number of server / perf threads\n");
     printf("    -B, --bidirectional Bidirectional communication\n");
+    printf("    -r, --rails         Number of NA rails per context\n");
+    printf("    -u, --shared_buf    Share request buffers between contexts\n");
+    printf("    -j, --json          Write benchmark results as JSON to file\n"
+           "                        (\"-\" for stdout)\n");
 }
 
 /*---------------------------------------------------------------------------*/
@@ -158,6 +167,15 @@ hg_test_parse_options(int argc, char *argv[], struct hg_test_info *hg_test_info)
             case 'B': /* bidirectional */
                 hg_test_info->bidirectional = HG_TRUE;
                 break;
+            case 'j': /* JSON output */
+                hg_test_info->json_path = na_test_opt_arg_g;
+                break;
+            case 'r': /* number of rails */
+                hg_test_info->rail_count = (hg_uint8_t) atoi(na_test_opt_arg_g);
+                break;
+            case 'u': /* shared request buffers */
+                hg_test_info->buf_shared = HG_TRUE;
+                break;
             default:
                 break;
         }
@@ -377,8 +395,16 @@ hg_test_register(hg_class_t *hg_class)
 
     hg_test_overflow_id_g = MERCURY_REGISTER(hg_class, "hg_test_overflow", void,
         overflow_out_t, hg_test_overflow_cb);
+    hg_test_view_id_g = MERCURY_REGISTER(
+        hg_class, "hg_test_view", view_in_t, view_out_t, hg_test_view_cb);
+    hg_test_view_copy_id_g = MERCURY_REGISTER(
+        hg_class, "hg_test_view_copy", view_in_t, view_out_t, hg_test_view_cb);
     hg_test_cancel_rpc_id_g = MERCURY_REGISTER(
         hg_class, "hg_test_cancel_rpc", void, void, hg_test_cancel_rpc_cb);
+    hg_test_rpc_hold_id_g = MERCURY_REGISTER(hg_class, "hg_test_rpc_hold",
+        rpc_hold_in_t, rpc_hold_out_t, hg_test_rpc_hold_cb);
+    hg_test_post_stats_id_g = MERCURY_REGISTER(hg_class, "hg_test_post_stats",
+        void, rpc_post_stats_out_t, hg_test_post_stats_cb);
 
     /* test_bulk */
     hg_test_bulk_write_id_g = MERCURY_REGISTER(hg_class, "hg_test_bulk_write",
@@ -389,6 +415,9 @@ hg_test_register(hg_class_t *hg_class)
     hg_test_bulk_bind_forward_id_g =
         MERCURY_REGISTER(hg_class, "hg_test_bulk_bind_forward", bulk_write_in_t,
             bulk_write_out_t, hg_test_bulk_bind_forward_cb);
+    hg_test_bulk_chunked_write_id_g = MERCURY_REGISTER(hg_class,
+        "hg_test_bulk_chunked_write", bulk_chunked_write_in_t, bulk_write_out_t,
+        hg_test_bulk_chunked_write_cb);
 
     /* test_kill */
     hg_test_killed_rpc_id_g = MERCURY_REGISTER(
@@ -484,6 +513,15 @@ HG_Test_init(int argc, char *argv[], struct hg_test_info *hg_test_info)
         hg_init_info.na_init_info.max_contexts =
             hg_test_info->na_test_info.max_contexts;
 
+    /* Set number of rails */
+    hg_init_info.na_rail_count = hg_test_info->rail_count;
+
+    /* Let targets adapt the number of posted requests to the load */
+    hg_init_info.request_post_adaptive = hg_test_info->na_test_info.listen;
+
+    /* Set shared request buffers */
+    hg_init_info.request_buf_shared = hg_test_info->buf_shared;
+
     /* Set auto SM mode */
     if (hg_test_info->auto_sm)
         hg_init_info.auto_sm = HG_TRUE;
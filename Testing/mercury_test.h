@@ -44,6 +44,7 @@ struct hg_test_info {
     struct hg_mem_pool *bulk_pool;
     hg_size_t buf_size_min;
     hg_size_t buf_size_max;
+    const char *json_path;
 #ifdef HG_TEST_HAS_CRAY_DRC
     uint32_t credential;
     uint32_t wlm_id;
@@ -52,9 +53,11 @@ struct hg_test_info {
 #endif
     unsigned int handle_max;
     unsigned int thread_count;
+    hg_uint8_t rail_count;
     hg_bool_t auth;
     hg_bool_t auto_sm;
     hg_bool_t bidirectional;
+    hg_bool_t buf_shared;
 };
 
 struct hg_test_context_info {
@@ -13,7 +13,8 @@
 
 int na_test_opt_ind_g = 1;            /* token pointer */
 const char *na_test_opt_arg_g = NULL; /* flag argument (or value) */
-const char *na_test_short_opt_g = "hc:d:p:H:P:LsSk:l:bC:X:VaZ:y:z:w:x:mt:BRvM";
+const char *na_test_short_opt_g =
+    "hc:d:p:H:P:LsSk:l:bC:X:VaZ:y:z:w:x:mt:BRvMj:r:u";
 /* clang-format off */
 const struct na_test_opt na_test_opt_g[] = {
     {"help", no_arg, 'h'},
@@ -43,6 +44,9 @@ const struct na_test_opt na_test_opt_g[] = {
     {"force-register", no_arg, 'R'},
     {"verify", no_arg, 'v'},
     {"millionbps", no_arg, 'M'},
+    {"json", require_arg, 'j'},
+    {"rails", require_arg, 'r'},
+    {"shared_buf", no_arg, 'u'},
     {NULL, 0, '\0'} /* Must add this at the end */
 };
 /* clang-format on */
@@ -0,0 +1,494 @@
+/**
+ * Copyright (c) 2013-2021 UChicago Argonne, LLC and The HDF Group.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "na_test.h"
+
+#include <string.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+/****************/
+/* Local Macros */
+/****************/
+
+/* Size of allocations (not a multiple of the page size) */
+#define NA_TEST_MEM_ALLOC_SIZE (10000)
+
+/* Number of segments allocated by peer, more than the number of unused peer
+ * segments that na_sm keeps mapped (64) */
+#define NA_TEST_MEM_ALLOC_SEG_COUNT (128)
+
+/* Max size of serialized memory handles */
+#define NA_TEST_MEM_ALLOC_SER_MAX (256)
+
+/************************************/
+/* Local Type and Struct Definition */
+/************************************/
+
+struct na_test_mem_alloc_info {
+    na_class_t *na_class;
+    na_context_t *context;
+    na_addr_t self_addr;
+    na_op_id_t *op_id;
+};
+
+/* Serialized memory handle */
+struct na_test_mem_alloc_ser {
+    size_t size;
+    char buf[NA_TEST_MEM_ALLOC_SER_MAX];
+};
+
+/********************/
+/* Local Prototypes */
+/********************/
+
+static int
+na_test_mem_alloc_cb(const struct na_cb_info *na_cb_info);
+
+static na_return_t
+na_test_mem_alloc_get(struct na_test_mem_alloc_info *info,
+    na_mem_handle_t local_handle, na_mem_handle_t remote_handle,
+    na_addr_t remote_addr);
+
+static na_return_t
+na_test_mem_alloc_self(struct na_test_mem_alloc_info *info);
+
+static int
+na_test_mem_alloc_write(int fd, const void *buf, size_t size);
+
+static int
+na_test_mem_alloc_read(int fd, void *buf, size_t size);
+
+static void
+na_test_mem_alloc_child(int tx_fd, int rx_fd);
+
+static na_return_t
+na_test_mem_alloc_peer(struct na_test_mem_alloc_info *info);
+
+/*******************/
+/* Local Variables */
+/*******************/
+
+/*---------------------------------------------------------------------------*/
+static int
+na_test_mem_alloc_cb(const struct na_cb_info *na_cb_info)
+{
+    int *completed = (int *) na_cb_info->arg;
+
+    *completed = (na_cb_info->ret == NA_SUCCESS) ? 1 : -1;
+
+    return 0;
+}
+
+/*---------------------------------------------------------------------------*/
+static na_return_t
+na_test_mem_alloc_get(struct na_test_mem_alloc_info *info,
+    na_mem_handle_t local_handle, na_mem_handle_t remote_handle,
+    na_addr_t remote_addr)
+{
+    int completed = 0;
+    na_return_t ret;
+
+    ret = NA_Get(info->na_class, info->context, na_test_mem_alloc_cb,
+        &completed, local_handle, 0, remote_handle, 0, NA_TEST_MEM_ALLOC_SIZE,
+        remote_addr, 0, info->op_id);
+    if (ret != NA_SUCCESS)
+        return ret;
+
+    while (completed == 0) {
+        unsigned int actual_count = 0;
+
+        ret = NA_Trigger(info->context, 0, 1, NULL, &actual_count);
+        if (completed != 0 || (ret == NA_SUCCESS && actual_count))
+            continue;
+
+        ret = NA_Progress(info->na_class, info->context, 0);
+        NA_TEST_CHECK_ERROR(ret != NA_SUCCESS && ret != NA_TIMEOUT, done, ret,
+            ret, "NA_Progress() failed (%s)", NA_Error_to_string(ret));
+    }
+
+    return (completed == 1) ? NA_SUCCESS : NA_PROTOCOL_ERROR;
+
+done:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static na_return_t
+na_test_mem_alloc_self(struct na_test_mem_alloc_info *info)
+{
+    na_mem_handle_t src_handle = NA_MEM_HANDLE_NULL,
+                    dst_handle = NA_MEM_HANDLE_NULL;
+    char *src_buf = NULL, *dst_buf = NULL;
+    na_return_t ret;
+    size_t i;
+
+    src_buf = (char *) NA_Mem_alloc(info->na_class, NA_TEST_MEM_ALLOC_SIZE);
+    NA_TEST_CHECK_ERROR(src_buf == NULL, done, ret, NA_NOMEM,
+        "NA_Mem_alloc() failed");
+    dst_buf = (char *) NA_Mem_alloc(info->na_class, NA_TEST_MEM_ALLOC_SIZE);
+    NA_TEST_CHECK_ERROR(dst_buf == NULL, done, ret, NA_NOMEM,
+        "NA_Mem_alloc() failed");
+
+    /* Memory is zero-initialized */
+    for (i = 0; i < NA_TEST_MEM_ALLOC_SIZE; i++) {
+        NA_TEST_CHECK_ERROR(src_buf[i] != 0 || dst_buf[i] != 0, done, ret,
+            NA_FAULT, "Memory is not zeroed at offset %zu", i);
+        src_buf[i] = (char) (i % 251 + 1);
+    }
+
+    ret = NA_Mem_handle_create(info->na_class, src_buf, NA_TEST_MEM_ALLOC_SIZE,
+        NA_MEM_READ_ONLY, &src_handle);
+    NA_TEST_CHECK_NA_ERROR(done, ret, "NA_Mem_handle_create() failed (%s)",
+        NA_Error_to_string(ret));
+    ret = NA_Mem_register(info->na_class, src_handle, NA_MEM_TYPE_HOST, 0);
+    NA_TEST_CHECK_NA_ERROR(
+        done, ret, "NA_Mem_register() failed (%s)", NA_Error_to_string(ret));
+    ret = NA_Mem_handle_create(info->na_class, dst_buf, NA_TEST_MEM_ALLOC_SIZE,
+        NA_MEM_READWRITE, &dst_handle);
+    NA_TEST_CHECK_NA_ERROR(done, ret, "NA_Mem_handle_create() failed (%s)",
+        NA_Error_to_string(ret));
+    ret = NA_Mem_register(info->na_class, dst_handle, NA_MEM_TYPE_HOST, 0);
+    NA_TEST_CHECK_NA_ERROR(
+        done, ret, "NA_Mem_register() failed (%s)", NA_Error_to_string(ret));
+
+    ret = na_test_mem_alloc_get(info, dst_handle, src_handle, info->self_addr);
+    NA_TEST_CHECK_NA_ERROR(done, ret, "Could not get data");
+    NA_TEST_CHECK_ERROR(memcmp(src_buf, dst_buf, NA_TEST_MEM_ALLOC_SIZE),
+        done, ret, NA_FAULT, "Data get does not match");
+
+    /* Freeing NULL is a no-op */
+    ret = NA_Mem_free(info->na_class, NULL);
+    NA_TEST_CHECK_NA_ERROR(
+        done, ret, "NA_Mem_free() failed (%s)", NA_Error_to_string(ret));
+
+done:
+    if (src_handle != NA_MEM_HANDLE_NULL) {
+        NA_Mem_deregister(info->na_class, src_handle);
+        NA_Mem_handle_free(info->na_class, src_handle);
+    }
+    if (dst_handle != NA_MEM_HANDLE_NULL) {
+        NA_Mem_deregister(info->na_class, dst_handle);
+        NA_Mem_handle_free(info->na_class, dst_handle);
+    }
+    if (src_buf != NULL && NA_Mem_free(info->na_class, src_buf) != NA_SUCCESS)
+        ret = NA_FAULT;
+    if (dst_buf != NULL && NA_Mem_free(info->na_class, dst_buf) != NA_SUCCESS)
+        ret = NA_FAULT;
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static int
+na_test_mem_alloc_write(int fd, const void *buf, size_t size)
+{
+    const char *ptr = (const char *) buf;
+
+    while (size > 0) {
+        ssize_t rc = write(fd, ptr, size);
+
+        if (rc <= 0)
+            return -1;
+        ptr += rc;
+        size -= (size_t) rc;
+    }
+
+    return 0;
+}
+
+/*---------------------------------------------------------------------------*/
+static int
+na_test_mem_alloc_read(int fd, void *buf, size_t size)
+{
+    char *ptr = (char *) buf;
+
+    while (size > 0) {
+        ssize_t rc = read(fd, ptr, size);
+
+        if (rc <= 0)
+            return -1;
+        ptr += rc;
+        size -= (size_t) rc;
+    }
+
+    return 0;
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+na_test_mem_alloc_child(int tx_fd, int rx_fd)
+{
+    na_class_t *na_class;
+    na_addr_t self_addr = NA_ADDR_NULL;
+    void *bufs[NA_TEST_MEM_ALLOC_SEG_COUNT] = {NULL};
+    na_mem_handle_t handles[NA_TEST_MEM_ALLOC_SEG_COUNT] = {NA_MEM_HANDLE_NULL};
+    char addr_string[NA_TEST_MAX_ADDR_NAME] = {'\0'};
+    size_t addr_string_len = NA_TEST_MAX_ADDR_NAME;
+    struct na_test_mem_alloc_ser ser = {0};
+    int ret = EXIT_FAILURE, i;
+    char c;
+
+    /* Class of parent is not used */
+    na_class = NA_Initialize("na+sm", true);
+    NA_TEST_CHECK_ERROR_NORET(
+        na_class == NULL, done, "Could not initialize child class");
+    NA_TEST_CHECK_ERROR_NORET(NA_Addr_self(na_class, &self_addr) != NA_SUCCESS,
+        finalize, "NA_Addr_self() failed");
+    NA_TEST_CHECK_ERROR_NORET(NA_Addr_to_string(na_class, addr_string,
+                                  &addr_string_len, self_addr) != NA_SUCCESS,
+        finalize, "NA_Addr_to_string() failed");
+    NA_TEST_CHECK_ERROR_NORET(
+        na_test_mem_alloc_write(tx_fd, addr_string, sizeof(addr_string)) < 0,
+        finalize, "Could not send address");
+
+    /* Each segment is filled with its index */
+    for (i = 0; i < NA_TEST_MEM_ALLOC_SEG_COUNT; i++) {
+        bufs[i] = NA_Mem_alloc(na_class, NA_TEST_MEM_ALLOC_SIZE);
+        NA_TEST_CHECK_ERROR_NORET(
+            bufs[i] == NULL, finalize, "NA_Mem_alloc() failed");
+        memset(bufs[i], i + 1, NA_TEST_MEM_ALLOC_SIZE);
+
+        NA_TEST_CHECK_ERROR_NORET(
+            NA_Mem_handle_create(na_class, bufs[i], NA_TEST_MEM_ALLOC_SIZE,
+                NA_MEM_READ_ONLY, &handles[i]) != NA_SUCCESS,
+            finalize, "NA_Mem_handle_create() failed");
+        ser.size = NA_Mem_handle_get_serialize_size(na_class, handles[i]);
+        NA_TEST_CHECK_ERROR_NORET(ser.size > NA_TEST_MEM_ALLOC_SER_MAX,
+            finalize, "Serialized handle is too large (%zu)", ser.size);
+        NA_TEST_CHECK_ERROR_NORET(NA_Mem_handle_serialize(na_class, ser.buf,
+                                      ser.size, handles[i]) != NA_SUCCESS,
+            finalize, "NA_Mem_handle_serialize() failed");
+        NA_TEST_CHECK_ERROR_NORET(
+            na_test_mem_alloc_write(tx_fd, &ser, sizeof(ser)) < 0, finalize,
+            "Could not send handle");
+    }
+
+    /* Wait for parent to have deserialized the handles */
+    NA_TEST_CHECK_ERROR_NORET(na_test_mem_alloc_read(rx_fd, &c, 1) < 0,
+        finalize, "Could not receive ack");
+    ret = EXIT_SUCCESS;
+
+finalize:
+    for (i = 0; i < NA_TEST_MEM_ALLOC_SEG_COUNT; i++) {
+        if (handles[i] != NA_MEM_HANDLE_NULL)
+            NA_Mem_handle_free(na_class, handles[i]);
+        if (bufs[i] != NULL && NA_Mem_free(na_class, bufs[i]) != NA_SUCCESS)
+            ret = EXIT_FAILURE;
+    }
+    if (self_addr != NA_ADDR_NULL)
+        NA_Addr_free(na_class, self_addr);
+    if (NA_Finalize(na_class) != NA_SUCCESS)
+        ret = EXIT_FAILURE;
+
+done:
+    _exit(ret);
+}
+
+/*---------------------------------------------------------------------------*/
+static na_return_t
+na_test_mem_alloc_peer(struct na_test_mem_alloc_info *info)
+{
+    int tx_fds[2] = {-1, -1}, rx_fds[2] = {-1, -1}, status, i;
+    struct na_test_mem_alloc_ser *sers = NULL;
+    na_mem_handle_t handles[NA_TEST_MEM_ALLOC_SEG_COUNT] = {NA_MEM_HANDLE_NULL};
+    na_mem_handle_t handle = NA_MEM_HANDLE_NULL,
+                    dst_handle = NA_MEM_HANDLE_NULL;
+    char addr_string[NA_TEST_MAX_ADDR_NAME];
+    na_addr_t peer_addr = NA_ADDR_NULL;
+    char *dst_buf = NULL;
+    pid_t pid = -1;
+    na_return_t ret;
+    char c = 0;
+
+    sers = (struct na_test_mem_alloc_ser *) malloc(
+        NA_TEST_MEM_ALLOC_SEG_COUNT * sizeof(*sers));
+    NA_TEST_CHECK_ERROR(
+        sers == NULL, done, ret, NA_NOMEM, "Could not allocate handles");
+    dst_buf = (char *) malloc(NA_TEST_MEM_ALLOC_SIZE);
+    NA_TEST_CHECK_ERROR(
+        dst_buf == NULL, done, ret, NA_NOMEM, "Could not allocate buffer");
+    ret = NA_Mem_handle_create(info->na_class, dst_buf, NA_TEST_MEM_ALLOC_SIZE,
+        NA_MEM_READWRITE, &dst_handle);
+    NA_TEST_CHECK_NA_ERROR(done, ret, "NA_Mem_handle_create() failed (%s)",
+        NA_Error_to_string(ret));
+    ret = NA_Mem_register(info->na_class, dst_handle, NA_MEM_TYPE_HOST, 0);
+    NA_TEST_CHECK_NA_ERROR(
+        done, ret, "NA_Mem_register() failed (%s)", NA_Error_to_string(ret));
+
+    /* Peer allocates segments in another process */
+    NA_TEST_CHECK_ERROR(pipe(tx_fds) < 0 || pipe(rx_fds) < 0, done, ret,
+        NA_PROTOCOL_ERROR, "pipe() failed");
+    pid = fork();
+    NA_TEST_CHECK_ERROR(
+        pid < 0, done, ret, NA_PROTOCOL_ERROR, "fork() failed");
+    if (pid == 0) {
+        close(tx_fds[1]);
+        close(rx_fds[0]);
+        na_test_mem_alloc_child(rx_fds[1], tx_fds[0]);
+    }
+    close(tx_fds[0]);
+    tx_fds[0] = -1;
+    close(rx_fds[1]);
+    rx_fds[1] = -1;
+
+    NA_TEST_CHECK_ERROR(
+        na_test_mem_alloc_read(rx_fds[0], addr_string, sizeof(addr_string)) <
+            0,
+        done, ret, NA_PROTOCOL_ERROR, "Could not receive address");
+    ret = NA_Addr_lookup(info->na_class, addr_string, &peer_addr);
+    NA_TEST_CHECK_NA_ERROR(
+        done, ret, "NA_Addr_lookup() failed (%s)", NA_Error_to_string(ret));
+
+    /* All segments remain mapped while handles use them */
+    for (i = 0; i < NA_TEST_MEM_ALLOC_SEG_COUNT; i++) {
+        NA_TEST_CHECK_ERROR(
+            na_test_mem_alloc_read(rx_fds[0], &sers[i], sizeof(*sers)) < 0,
+            done, ret, NA_PROTOCOL_ERROR, "Could not receive handle");
+        ret = NA_Mem_handle_deserialize(
+            info->na_class, &handles[i], sers[i].buf, sers[i].size);
+        NA_TEST_CHECK_NA_ERROR(done, ret,
+            "NA_Mem_handle_deserialize() failed (%s)", NA_Error_to_string(ret));
+    }
+
+    /* Peer frees its segments and exits, so that CMA can no longer be used */
+    NA_TEST_CHECK_ERROR(na_test_mem_alloc_write(tx_fds[1], &c, 1) < 0, done,
+        ret, NA_PROTOCOL_ERROR, "Could not send ack");
+    NA_TEST_CHECK_ERROR(waitpid(pid, &status, 0) != pid, done, ret,
+        NA_PROTOCOL_ERROR, "waitpid() failed");
+    pid = -1;
+    NA_TEST_CHECK_ERROR(!WIFEXITED(status) || WEXITSTATUS(status) != 0, done,
+        ret, NA_PROTOCOL_ERROR, "Peer failed");
+
+    for (i = 0; i < NA_TEST_MEM_ALLOC_SEG_COUNT; i++) {
+        memset(dst_buf, 0, NA_TEST_MEM_ALLOC_SIZE);
+        ret = na_test_mem_alloc_get(info, dst_handle, handles[i], peer_addr);
+        NA_TEST_CHECK_NA_ERROR(done, ret, "Could not get segment %d", i);
+        NA_TEST_CHECK_ERROR(dst_buf[0] != (char) (i + 1) ||
+                                dst_buf[NA_TEST_MEM_ALLOC_SIZE - 1] !=
+                                    (char) (i + 1),
+            done, ret, NA_FAULT, "Data of segment %d does not match", i);
+    }
+
+    /* Only the most recently released mappings are kept */
+    for (i = 0; i < NA_TEST_MEM_ALLOC_SEG_COUNT; i++) {
+        NA_Mem_handle_free(info->na_class, handles[i]);
+        handles[i] = NA_MEM_HANDLE_NULL;
+    }
+
+    i = NA_TEST_MEM_ALLOC_SEG_COUNT - 1;
+    ret = NA_Mem_handle_deserialize(
+        info->na_class, &handle, sers[i].buf, sers[i].size);
+    NA_TEST_CHECK_NA_ERROR(done, ret,
+        "NA_Mem_handle_deserialize() failed (%s)", NA_Error_to_string(ret));
+    ret = na_test_mem_alloc_get(info, dst_handle, handle, peer_addr);
+    NA_TEST_CHECK_NA_ERROR(done, ret, "Cached segment %d was unmapped", i);
+    NA_Mem_handle_free(info->na_class, handle);
+    handle = NA_MEM_HANDLE_NULL;
+
+    i = 0;
+    ret = NA_Mem_handle_deserialize(
+        info->na_class, &handle, sers[i].buf, sers[i].size);
+    NA_TEST_CHECK_NA_ERROR(done, ret,
+        "NA_Mem_handle_deserialize() failed (%s)", NA_Error_to_string(ret));
+    ret = na_test_mem_alloc_get(info, dst_handle, handle, peer_addr);
+    NA_TEST_CHECK_ERROR(ret == NA_SUCCESS, done, ret, NA_FAULT,
+        "Segment %d was not unmapped", i);
+    ret = NA_SUCCESS;
+
+done:
+    if (pid > 0) {
+        close(tx_fds[1]);
+        tx_fds[1] = -1;
+        waitpid(pid, &status, 0);
+    }
+    for (i = 0; i < NA_TEST_MEM_ALLOC_SEG_COUNT; i++)
+        if (handles[i] != NA_MEM_HANDLE_NULL)
+            NA_Mem_handle_free(info->na_class, handles[i]);
+    if (handle != NA_MEM_HANDLE_NULL)
+        NA_Mem_handle_free(info->na_class, handle);
+    if (dst_handle != NA_MEM_HANDLE_NULL) {
+        NA_Mem_deregister(info->na_class, dst_handle);
+        NA_Mem_handle_free(info->na_class, dst_handle);
+    }
+    if (peer_addr != NA_ADDR_NULL)
+        NA_Addr_free(info->na_class, peer_addr);
+    for (i = 0; i < 2; i++) {
+        if (tx_fds[i] >= 0)
+            close(tx_fds[i]);
+        if (rx_fds[i] >= 0)
+            close(rx_fds[i]);
+    }
+    free(dst_buf);
+    free(sers);
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+int
+main(int argc, char *argv[])
+{
+    struct na_test_info na_test_info = {0};
+    struct na_test_mem_alloc_info info = {0};
+    na_return_t na_ret;
+    int ret = EXIT_SUCCESS;
+
+    /* Initialize the interface */
+    na_ret = NA_Test_init(argc, argv, &na_test_info);
+    NA_TEST_CHECK_NA_ERROR(error, na_ret, "NA_Test_init() failed (%s)",
+        NA_Error_to_string(na_ret));
+    info.na_class = na_test_info.na_class;
+
+    info.context = NA_Context_create(info.na_class);
+    NA_TEST_CHECK_ERROR(info.context == NULL, error, na_ret, NA_NOMEM,
+        "NA_Context_create() failed");
+    info.op_id = NA_Op_create(info.na_class);
+    NA_TEST_CHECK_ERROR(info.op_id == NULL, error, na_ret, NA_NOMEM,
+        "NA_Op_create() failed");
+    na_ret = NA_Addr_self(info.na_class, &info.self_addr);
+    NA_TEST_CHECK_NA_ERROR(error, na_ret, "NA_Addr_self() failed (%s)",
+        NA_Error_to_string(na_ret));
+
+    NA_TEST("NA_Mem_alloc() / NA_Mem_free()");
+    na_ret = na_test_mem_alloc_self(&info);
+    if (na_ret != NA_SUCCESS) {
+        NA_FAILED();
+        goto error;
+    }
+    NA_PASSED();
+
+    /* Only na_sm backs allocations with shared-memory that peers map */
+    if (strcmp(NA_Get_class_name(info.na_class), "na") != 0) {
+        printf("# Shared-memory RMA not used by %s plugin, skipping\n",
+            NA_Get_class_name(info.na_class));
+        goto done;
+    }
+
+    NA_TEST("cached mappings of peer segments");
+    na_ret = na_test_mem_alloc_peer(&info);
+    if (na_ret != NA_SUCCESS) {
+        NA_FAILED();
+        goto error;
+    }
+    NA_PASSED();
+
+done:
+    if (info.self_addr != NA_ADDR_NULL)
+        NA_Addr_free(info.na_class, info.self_addr);
+    if (info.op_id != NULL)
+        NA_Op_destroy(info.na_class, info.op_id);
+    if (info.context != NULL)
+        NA_Context_destroy(info.na_class, info.context);
+    NA_Test_finalize(&na_test_info);
+
+    return ret;
+
+error:
+    ret = EXIT_FAILURE;
+    goto done;
+}
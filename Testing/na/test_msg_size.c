@@ -0,0 +1,325 @@
+/**
+ * Copyright (c) 2013-2021 UChicago Argonne, LLC and The HDF Group.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "na_test.h"
+
+#include <string.h>
+
+/****************/
+/* Local Macros */
+/****************/
+
+/* Message size requested when none is passed */
+#define NA_TEST_MSG_SIZE_DEFAULT (65536)
+
+#define NA_TEST_MSG_TAG (42)
+
+/************************************/
+/* Local Type and Struct Definition */
+/************************************/
+
+struct na_test_msg_info {
+    na_class_t *na_class;
+    na_context_t *context;
+    na_addr_t self_addr;
+    na_op_id_t *send_op_id;
+    na_op_id_t *recv_op_id;
+    void *send_buf;
+    void *send_buf_data;
+    void *recv_buf;
+    void *recv_buf_data;
+    size_t buf_size;
+};
+
+/********************/
+/* Local Prototypes */
+/********************/
+
+static int
+na_test_msg_cb(const struct na_cb_info *na_cb_info);
+
+static na_return_t
+na_test_msg_wait(struct na_test_msg_info *info, int *completed);
+
+static na_return_t
+na_test_msg_unexpected(struct na_test_msg_info *info, size_t size);
+
+static na_return_t
+na_test_msg_expected(struct na_test_msg_info *info, size_t size);
+
+static na_return_t
+na_test_msg_overflow(struct na_test_msg_info *info, size_t size);
+
+/*******************/
+/* Local Variables */
+/*******************/
+
+/*---------------------------------------------------------------------------*/
+static int
+na_test_msg_cb(const struct na_cb_info *na_cb_info)
+{
+    int *completed = (int *) na_cb_info->arg;
+
+    *completed = (na_cb_info->ret == NA_SUCCESS) ? 1 : -1;
+
+    return 0;
+}
+
+/*---------------------------------------------------------------------------*/
+static na_return_t
+na_test_msg_wait(struct na_test_msg_info *info, int *completed)
+{
+    na_return_t ret = NA_SUCCESS;
+
+    while (*completed == 0) {
+        unsigned int actual_count = 0;
+
+        do {
+            ret = NA_Trigger(info->context, 0, 1, NULL, &actual_count);
+        } while ((ret == NA_SUCCESS) && actual_count && *completed == 0);
+        if (*completed != 0)
+            break;
+
+        ret = NA_Progress(info->na_class, info->context, 1000);
+        NA_TEST_CHECK_ERROR(ret != NA_SUCCESS && ret != NA_TIMEOUT, done, ret,
+            ret, "NA_Progress() failed (%s)", NA_Error_to_string(ret));
+    }
+    NA_TEST_CHECK_ERROR(*completed < 0, done, ret, NA_PROTOCOL_ERROR,
+        "Operation completed with an error");
+
+    return NA_SUCCESS;
+
+done:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static na_return_t
+na_test_msg_unexpected(struct na_test_msg_info *info, size_t size)
+{
+    size_t header_size = NA_Msg_get_unexpected_header_size(info->na_class);
+    int send_completed = 0, recv_completed = 0;
+    na_return_t ret;
+    size_t i;
+
+    ret = NA_Msg_init_unexpected(info->na_class, info->send_buf, size);
+    NA_TEST_CHECK_NA_ERROR(error, ret, "NA_Msg_init_unexpected() failed (%s)",
+        NA_Error_to_string(ret));
+    for (i = header_size; i < size; i++)
+        ((char *) info->send_buf)[i] = (char) i;
+    memset(info->recv_buf, 0, info->buf_size);
+
+    ret = NA_Msg_recv_unexpected(info->na_class, info->context, na_test_msg_cb,
+        &recv_completed, info->recv_buf, info->buf_size, info->recv_buf_data,
+        info->recv_op_id);
+    NA_TEST_CHECK_NA_ERROR(error, ret, "NA_Msg_recv_unexpected() failed (%s)",
+        NA_Error_to_string(ret));
+
+    ret = NA_Msg_send_unexpected(info->na_class, info->context, na_test_msg_cb,
+        &send_completed, info->send_buf, size, info->send_buf_data,
+        info->self_addr, 0, NA_TEST_MSG_TAG, info->send_op_id);
+    NA_TEST_CHECK_NA_ERROR(error, ret, "NA_Msg_send_unexpected() failed (%s)",
+        NA_Error_to_string(ret));
+
+    ret = na_test_msg_wait(info, &send_completed);
+    NA_TEST_CHECK_NA_ERROR(error, ret, "Could not complete send");
+    ret = na_test_msg_wait(info, &recv_completed);
+    NA_TEST_CHECK_NA_ERROR(error, ret, "Could not complete recv");
+
+    NA_TEST_CHECK_ERROR(memcmp((char *) info->send_buf + header_size,
+                            (char *) info->recv_buf + header_size,
+                            size - header_size),
+        error, ret, NA_FAULT, "Unexpected message data does not match");
+
+    return NA_SUCCESS;
+
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static na_return_t
+na_test_msg_expected(struct na_test_msg_info *info, size_t size)
+{
+    size_t header_size = NA_Msg_get_expected_header_size(info->na_class);
+    int send_completed = 0, recv_completed = 0;
+    na_return_t ret;
+    size_t i;
+
+    ret = NA_Msg_init_expected(info->na_class, info->send_buf, size);
+    NA_TEST_CHECK_NA_ERROR(error, ret, "NA_Msg_init_expected() failed (%s)",
+        NA_Error_to_string(ret));
+    for (i = header_size; i < size; i++)
+        ((char *) info->send_buf)[i] = (char) (size - i);
+    memset(info->recv_buf, 0, info->buf_size);
+
+    ret = NA_Msg_recv_expected(info->na_class, info->context, na_test_msg_cb,
+        &recv_completed, info->recv_buf, info->buf_size, info->recv_buf_data,
+        info->self_addr, 0, NA_TEST_MSG_TAG, info->recv_op_id);
+    NA_TEST_CHECK_NA_ERROR(error, ret, "NA_Msg_recv_expected() failed (%s)",
+        NA_Error_to_string(ret));
+
+    ret = NA_Msg_send_expected(info->na_class, info->context, na_test_msg_cb,
+        &send_completed, info->send_buf, size, info->send_buf_data,
+        info->self_addr, 0, NA_TEST_MSG_TAG, info->send_op_id);
+    NA_TEST_CHECK_NA_ERROR(error, ret, "NA_Msg_send_expected() failed (%s)",
+        NA_Error_to_string(ret));
+
+    ret = na_test_msg_wait(info, &send_completed);
+    NA_TEST_CHECK_NA_ERROR(error, ret, "Could not complete send");
+    ret = na_test_msg_wait(info, &recv_completed);
+    NA_TEST_CHECK_NA_ERROR(error, ret, "Could not complete recv");
+
+    NA_TEST_CHECK_ERROR(memcmp((char *) info->send_buf + header_size,
+                            (char *) info->recv_buf + header_size,
+                            size - header_size),
+        error, ret, NA_FAULT, "Expected message data does not match");
+
+    return NA_SUCCESS;
+
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static na_return_t
+na_test_msg_overflow(struct na_test_msg_info *info, size_t size)
+{
+    int completed = 0;
+    na_return_t ret;
+
+    /* Sends larger than the configured max must be rejected, the receiver
+     * would otherwise truncate them */
+    ret = NA_Msg_init_unexpected(info->na_class, info->send_buf, size);
+    NA_TEST_CHECK_NA_ERROR(error, ret, "NA_Msg_init_unexpected() failed (%s)",
+        NA_Error_to_string(ret));
+    ret = NA_Msg_send_unexpected(info->na_class, info->context, na_test_msg_cb,
+        &completed, info->send_buf, size, info->send_buf_data, info->self_addr,
+        0, NA_TEST_MSG_TAG, info->send_op_id);
+    NA_TEST_CHECK_ERROR(ret != NA_OVERFLOW, error, ret, NA_PROTOCOL_ERROR,
+        "NA_Msg_send_unexpected() of %zu bytes returned %s", size,
+        NA_Error_to_string(ret));
+
+    ret = NA_Msg_init_expected(info->na_class, info->send_buf, size);
+    NA_TEST_CHECK_NA_ERROR(error, ret, "NA_Msg_init_expected() failed (%s)",
+        NA_Error_to_string(ret));
+    ret = NA_Msg_send_expected(info->na_class, info->context, na_test_msg_cb,
+        &completed, info->send_buf, size, info->send_buf_data, info->self_addr,
+        0, NA_TEST_MSG_TAG, info->send_op_id);
+    NA_TEST_CHECK_ERROR(ret != NA_OVERFLOW, error, ret, NA_PROTOCOL_ERROR,
+        "NA_Msg_send_expected() of %zu bytes returned %s", size,
+        NA_Error_to_string(ret));
+
+    return NA_SUCCESS;
+
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+int
+main(int argc, char *argv[])
+{
+    struct na_test_info na_test_info = {0};
+    struct na_test_msg_info info = {0};
+    size_t msg_size;
+    na_return_t na_ret;
+    int ret = EXIT_SUCCESS;
+
+    /* Initialize the interface */
+    na_ret = NA_Test_init(argc, argv, &na_test_info);
+    NA_TEST_CHECK_NA_ERROR(error, na_ret, "NA_Test_init() failed (%s)",
+        NA_Error_to_string(na_ret));
+    info.na_class = na_test_info.na_class;
+    msg_size = (na_test_info.max_msg_size != 0) ? na_test_info.max_msg_size
+                                                : NA_TEST_MSG_SIZE_DEFAULT;
+
+    /* Sizes passed at init must be reported back */
+    NA_TEST("configured max unexpected and expected sizes");
+    if (na_test_info.max_msg_size != 0 &&
+        (NA_Msg_get_max_unexpected_size(info.na_class) != msg_size ||
+            NA_Msg_get_max_expected_size(info.na_class) != msg_size)) {
+        NA_FAILED();
+        NA_TEST_LOG_ERROR("Max sizes (%zu, %zu) do not match %zu",
+            NA_Msg_get_max_unexpected_size(info.na_class),
+            NA_Msg_get_max_expected_size(info.na_class), msg_size);
+        goto error;
+    }
+    NA_PASSED();
+    msg_size = NA_Msg_get_max_unexpected_size(info.na_class);
+    if (NA_Msg_get_max_expected_size(info.na_class) < msg_size)
+        msg_size = NA_Msg_get_max_expected_size(info.na_class);
+    info.buf_size = msg_size;
+    printf("# Max message size %zu\n", msg_size);
+
+    info.context = NA_Context_create(info.na_class);
+    NA_TEST_CHECK_ERROR(info.context == NULL, error, na_ret, NA_NOMEM,
+        "NA_Context_create() failed");
+    info.send_op_id = NA_Op_create(info.na_class);
+    NA_TEST_CHECK_ERROR(info.send_op_id == NULL, error, na_ret, NA_NOMEM,
+        "NA_Op_create() failed");
+    info.recv_op_id = NA_Op_create(info.na_class);
+    NA_TEST_CHECK_ERROR(info.recv_op_id == NULL, error, na_ret, NA_NOMEM,
+        "NA_Op_create() failed");
+    na_ret = NA_Addr_self(info.na_class, &info.self_addr);
+    NA_TEST_CHECK_NA_ERROR(error, na_ret, "NA_Addr_self() failed (%s)",
+        NA_Error_to_string(na_ret));
+
+    /* One extra byte to test overflow */
+    info.send_buf =
+        NA_Msg_buf_alloc(info.na_class, info.buf_size + 1, &info.send_buf_data);
+    NA_TEST_CHECK_ERROR(info.send_buf == NULL, error, na_ret, NA_NOMEM,
+        "NA_Msg_buf_alloc() failed");
+    info.recv_buf =
+        NA_Msg_buf_alloc(info.na_class, info.buf_size, &info.recv_buf_data);
+    NA_TEST_CHECK_ERROR(info.recv_buf == NULL, error, na_ret, NA_NOMEM,
+        "NA_Msg_buf_alloc() failed");
+
+    NA_TEST("unexpected message of max size");
+    na_ret = na_test_msg_unexpected(&info, msg_size);
+    if (na_ret != NA_SUCCESS) {
+        NA_FAILED();
+        goto error;
+    }
+    NA_PASSED();
+
+    NA_TEST("expected message of max size");
+    na_ret = na_test_msg_expected(&info, msg_size);
+    if (na_ret != NA_SUCCESS) {
+        NA_FAILED();
+        goto error;
+    }
+    NA_PASSED();
+
+    NA_TEST("messages larger than max size");
+    na_ret = na_test_msg_overflow(&info, msg_size + 1);
+    if (na_ret != NA_SUCCESS) {
+        NA_FAILED();
+        goto error;
+    }
+    NA_PASSED();
+
+done:
+    if (info.send_buf != NULL)
+        NA_Msg_buf_free(info.na_class, info.send_buf, info.send_buf_data);
+    if (info.recv_buf != NULL)
+        NA_Msg_buf_free(info.na_class, info.recv_buf, info.recv_buf_data);
+    if (info.self_addr != NA_ADDR_NULL)
+        NA_Addr_free(info.na_class, info.self_addr);
+    if (info.send_op_id != NULL)
+        NA_Op_destroy(info.na_class, info.send_op_id);
+    if (info.recv_op_id != NULL)
+        NA_Op_destroy(info.na_class, info.recv_op_id);
+    if (info.context != NULL)
+        NA_Context_destroy(info.na_class, info.context);
+    NA_Test_finalize(&na_test_info);
+
+    return ret;
+
+error:
+    ret = EXIT_FAILURE;
+    goto done;
+}
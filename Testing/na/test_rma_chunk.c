@@ -0,0 +1,402 @@
+/**
+ * Copyright (c) 2013-2021 UChicago Argonne, LLC and The HDF Group.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "na_test.h"
+
+#include <string.h>
+
+/****************/
+/* Local Macros */
+/****************/
+
+/* Size of RMA copied in chunks by na_sm (chunks are 1 MiB) */
+#define NA_TEST_RMA_CHUNK_SIZE (256 << 20)
+
+/* Number of messages exchanged while the RMA is in progress */
+#define NA_TEST_RMA_CHUNK_MSG_COUNT (128)
+
+/* Number of progress calls, and of chunks copied, before cancelation */
+#define NA_TEST_RMA_CHUNK_CANCEL_PROGRESS (4)
+
+/* Size of each chunk (must match na_sm) */
+#define NA_TEST_RMA_CHUNK_CHUNK_SIZE (1 << 20)
+
+#define NA_TEST_RMA_CHUNK_MSG_SIZE (64)
+
+#define NA_TEST_RMA_CHUNK_TAG (42)
+
+/* Exit code that CTest reports as skipped */
+#define NA_TEST_RMA_CHUNK_SKIP (77)
+
+/************************************/
+/* Local Type and Struct Definition */
+/************************************/
+
+struct na_test_rma_chunk_info {
+    na_class_t *na_class;
+    na_context_t *context;
+    na_addr_t self_addr;
+    na_op_id_t *rma_op_id;
+    na_op_id_t *send_op_id;
+    na_op_id_t *recv_op_id;
+    void *send_buf;
+    void *send_buf_data;
+    void *recv_buf;
+    void *recv_buf_data;
+    char *src_buf;
+    char *dst_buf;
+    na_mem_handle_t src_handle;
+    na_mem_handle_t dst_handle;
+};
+
+/********************/
+/* Local Prototypes */
+/********************/
+
+static int
+na_test_rma_chunk_cb(const struct na_cb_info *na_cb_info);
+
+static void
+na_test_rma_chunk_trigger(struct na_test_rma_chunk_info *info);
+
+static na_return_t
+na_test_rma_chunk_wait(struct na_test_rma_chunk_info *info, int *completed);
+
+static na_return_t
+na_test_rma_chunk_get(struct na_test_rma_chunk_info *info, int *completed);
+
+static na_return_t
+na_test_rma_chunk_interleave(struct na_test_rma_chunk_info *info);
+
+static na_return_t
+na_test_rma_chunk_cancel(struct na_test_rma_chunk_info *info);
+
+/*******************/
+/* Local Variables */
+/*******************/
+
+/*---------------------------------------------------------------------------*/
+static int
+na_test_rma_chunk_cb(const struct na_cb_info *na_cb_info)
+{
+    int *completed = (int *) na_cb_info->arg;
+
+    switch (na_cb_info->ret) {
+        case NA_SUCCESS:
+            *completed = 1;
+            break;
+        case NA_CANCELED:
+            *completed = 2;
+            break;
+        default:
+            *completed = -1;
+            break;
+    }
+
+    return 0;
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+na_test_rma_chunk_trigger(struct na_test_rma_chunk_info *info)
+{
+    unsigned int actual_count = 0;
+    na_return_t ret;
+
+    do {
+        ret = NA_Trigger(info->context, 0, 1, NULL, &actual_count);
+    } while ((ret == NA_SUCCESS) && actual_count);
+}
+
+/*---------------------------------------------------------------------------*/
+static na_return_t
+na_test_rma_chunk_wait(struct na_test_rma_chunk_info *info, int *completed)
+{
+    na_return_t ret = NA_SUCCESS;
+
+    while (*completed == 0) {
+        na_test_rma_chunk_trigger(info);
+        if (*completed != 0)
+            break;
+
+        /* Each progress call copies at most one chunk */
+        ret = NA_Progress(info->na_class, info->context, 0);
+        NA_TEST_CHECK_ERROR(ret != NA_SUCCESS && ret != NA_TIMEOUT, done, ret,
+            ret, "NA_Progress() failed (%s)", NA_Error_to_string(ret));
+    }
+    NA_TEST_CHECK_ERROR(*completed < 0, done, ret, NA_PROTOCOL_ERROR,
+        "Operation completed with an error");
+
+    return NA_SUCCESS;
+
+done:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static na_return_t
+na_test_rma_chunk_get(struct na_test_rma_chunk_info *info, int *completed)
+{
+    na_return_t ret;
+
+    memset(info->dst_buf, 0, NA_TEST_RMA_CHUNK_SIZE);
+
+    ret = NA_Get(info->na_class, info->context, na_test_rma_chunk_cb,
+        completed, info->dst_handle, 0, info->src_handle, 0,
+        NA_TEST_RMA_CHUNK_SIZE, info->self_addr, 0, info->rma_op_id);
+    NA_TEST_CHECK_NA_ERROR(
+        error, ret, "NA_Get() failed (%s)", NA_Error_to_string(ret));
+
+    return NA_SUCCESS;
+
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static na_return_t
+na_test_rma_chunk_interleave(struct na_test_rma_chunk_info *info)
+{
+    size_t header_size = NA_Msg_get_unexpected_header_size(info->na_class);
+    int rma_completed = 0;
+    na_return_t ret;
+    unsigned int i;
+
+    ret = NA_Msg_init_unexpected(
+        info->na_class, info->send_buf, NA_TEST_RMA_CHUNK_MSG_SIZE);
+    NA_TEST_CHECK_NA_ERROR(error, ret, "NA_Msg_init_unexpected() failed (%s)",
+        NA_Error_to_string(ret));
+
+    ret = na_test_rma_chunk_get(info, &rma_completed);
+    NA_TEST_CHECK_NA_ERROR(error, ret, "Could not post RMA");
+
+    /* Messages must keep flowing while chunks are copied */
+    for (i = 0; i < NA_TEST_RMA_CHUNK_MSG_COUNT; i++) {
+        int send_completed = 0, recv_completed = 0;
+
+        memset((char *) info->send_buf + header_size, (int) i,
+            NA_TEST_RMA_CHUNK_MSG_SIZE - header_size);
+        ret = NA_Msg_recv_unexpected(info->na_class, info->context,
+            na_test_rma_chunk_cb, &recv_completed, info->recv_buf,
+            NA_TEST_RMA_CHUNK_MSG_SIZE, info->recv_buf_data, info->recv_op_id);
+        NA_TEST_CHECK_NA_ERROR(error, ret,
+            "NA_Msg_recv_unexpected() failed (%s)", NA_Error_to_string(ret));
+
+        ret = NA_Msg_send_unexpected(info->na_class, info->context,
+            na_test_rma_chunk_cb, &send_completed, info->send_buf,
+            NA_TEST_RMA_CHUNK_MSG_SIZE, info->send_buf_data, info->self_addr,
+            0, NA_TEST_RMA_CHUNK_TAG, info->send_op_id);
+        NA_TEST_CHECK_NA_ERROR(error, ret,
+            "NA_Msg_send_unexpected() failed (%s)", NA_Error_to_string(ret));
+
+        ret = na_test_rma_chunk_wait(info, &send_completed);
+        NA_TEST_CHECK_NA_ERROR(error, ret, "Could not complete send");
+        ret = na_test_rma_chunk_wait(info, &recv_completed);
+        NA_TEST_CHECK_NA_ERROR(error, ret, "Could not complete recv");
+        NA_TEST_CHECK_ERROR(memcmp((char *) info->send_buf + header_size,
+                                (char *) info->recv_buf + header_size,
+                                NA_TEST_RMA_CHUNK_MSG_SIZE - header_size),
+            error, ret, NA_FAULT, "Message %u data does not match", i);
+    }
+    NA_TEST_CHECK_ERROR(rma_completed != 0, error, ret, NA_PROTOCOL_ERROR,
+        "RMA completed before %d messages were exchanged",
+        NA_TEST_RMA_CHUNK_MSG_COUNT);
+
+    ret = na_test_rma_chunk_wait(info, &rma_completed);
+    NA_TEST_CHECK_NA_ERROR(error, ret, "Could not complete RMA");
+    NA_TEST_CHECK_ERROR(rma_completed != 1, error, ret, NA_PROTOCOL_ERROR,
+        "RMA was canceled");
+    NA_TEST_CHECK_ERROR(
+        memcmp(info->src_buf, info->dst_buf, NA_TEST_RMA_CHUNK_SIZE), error,
+        ret, NA_FAULT, "Data get does not match");
+
+    return NA_SUCCESS;
+
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static na_return_t
+na_test_rma_chunk_cancel(struct na_test_rma_chunk_info *info)
+{
+    size_t copied =
+        NA_TEST_RMA_CHUNK_CANCEL_PROGRESS * NA_TEST_RMA_CHUNK_CHUNK_SIZE, i;
+    int rma_completed = 0;
+    na_return_t ret;
+
+    ret = na_test_rma_chunk_get(info, &rma_completed);
+    NA_TEST_CHECK_NA_ERROR(error, ret, "Could not post RMA");
+
+    /* Let a few chunks be copied */
+    for (i = 0; i < NA_TEST_RMA_CHUNK_CANCEL_PROGRESS; i++) {
+        ret = NA_Progress(info->na_class, info->context, 0);
+        NA_TEST_CHECK_ERROR(ret != NA_SUCCESS && ret != NA_TIMEOUT, error, ret,
+            ret, "NA_Progress() failed (%s)", NA_Error_to_string(ret));
+    }
+    na_test_rma_chunk_trigger(info);
+    NA_TEST_CHECK_ERROR(rma_completed != 0, error, ret, NA_PROTOCOL_ERROR,
+        "RMA completed after %d progress calls",
+        NA_TEST_RMA_CHUNK_CANCEL_PROGRESS);
+
+    ret = NA_Cancel(info->na_class, info->context, info->rma_op_id);
+    NA_TEST_CHECK_NA_ERROR(
+        error, ret, "NA_Cancel() failed (%s)", NA_Error_to_string(ret));
+
+    ret = na_test_rma_chunk_wait(info, &rma_completed);
+    NA_TEST_CHECK_NA_ERROR(error, ret, "Could not complete canceled RMA");
+    NA_TEST_CHECK_ERROR(rma_completed != 2, error, ret, NA_PROTOCOL_ERROR,
+        "RMA was not canceled");
+
+    /* Chunks copied before cancelation are in place, no chunk is copied
+     * after it */
+    NA_TEST_CHECK_ERROR(memcmp(info->src_buf, info->dst_buf,
+                            NA_TEST_RMA_CHUNK_CHUNK_SIZE),
+        error, ret, NA_FAULT, "First chunk was not copied");
+    for (i = copied; i < NA_TEST_RMA_CHUNK_SIZE; i++)
+        NA_TEST_CHECK_ERROR(info->dst_buf[i] != 0, error, ret, NA_FAULT,
+            "Data was copied at offset %zu after cancelation", i);
+
+    /* Op ID can be reused once canceled */
+    rma_completed = 0;
+    ret = na_test_rma_chunk_get(info, &rma_completed);
+    NA_TEST_CHECK_NA_ERROR(error, ret, "Could not post RMA");
+    ret = na_test_rma_chunk_wait(info, &rma_completed);
+    NA_TEST_CHECK_NA_ERROR(error, ret, "Could not complete RMA");
+    NA_TEST_CHECK_ERROR(
+        memcmp(info->src_buf, info->dst_buf, NA_TEST_RMA_CHUNK_SIZE), error,
+        ret, NA_FAULT, "Data get does not match");
+
+    return NA_SUCCESS;
+
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+int
+main(int argc, char *argv[])
+{
+    struct na_test_info na_test_info = {0};
+    struct na_test_rma_chunk_info info = {0};
+    na_return_t na_ret;
+    size_t i;
+    int ret = EXIT_SUCCESS;
+
+    /* Initialize the interface */
+    na_ret = NA_Test_init(argc, argv, &na_test_info);
+    NA_TEST_CHECK_NA_ERROR(error, na_ret, "NA_Test_init() failed (%s)",
+        NA_Error_to_string(na_ret));
+    info.na_class = na_test_info.na_class;
+
+    /* Only na_sm copies RMAs in chunks across progress calls */
+    if (strcmp(NA_Get_class_name(info.na_class), "na") != 0) {
+        printf("# Chunked RMA not used by %s plugin, skipping\n",
+            NA_Get_class_name(info.na_class));
+        ret = NA_TEST_RMA_CHUNK_SKIP;
+        goto done;
+    }
+
+    info.src_buf = (char *) malloc(NA_TEST_RMA_CHUNK_SIZE);
+    NA_TEST_CHECK_ERROR(info.src_buf == NULL, error, na_ret, NA_NOMEM,
+        "Could not allocate buffer");
+    info.dst_buf = (char *) malloc(NA_TEST_RMA_CHUNK_SIZE);
+    NA_TEST_CHECK_ERROR(info.dst_buf == NULL, error, na_ret, NA_NOMEM,
+        "Could not allocate buffer");
+    for (i = 0; i < NA_TEST_RMA_CHUNK_SIZE; i++)
+        info.src_buf[i] = (char) (i % 251 + 1);
+
+    info.context = NA_Context_create(info.na_class);
+    NA_TEST_CHECK_ERROR(info.context == NULL, error, na_ret, NA_NOMEM,
+        "NA_Context_create() failed");
+    info.rma_op_id = NA_Op_create(info.na_class);
+    NA_TEST_CHECK_ERROR(info.rma_op_id == NULL, error, na_ret, NA_NOMEM,
+        "NA_Op_create() failed");
+    info.send_op_id = NA_Op_create(info.na_class);
+    NA_TEST_CHECK_ERROR(info.send_op_id == NULL, error, na_ret, NA_NOMEM,
+        "NA_Op_create() failed");
+    info.recv_op_id = NA_Op_create(info.na_class);
+    NA_TEST_CHECK_ERROR(info.recv_op_id == NULL, error, na_ret, NA_NOMEM,
+        "NA_Op_create() failed");
+    na_ret = NA_Addr_self(info.na_class, &info.self_addr);
+    NA_TEST_CHECK_NA_ERROR(error, na_ret, "NA_Addr_self() failed (%s)",
+        NA_Error_to_string(na_ret));
+
+    info.send_buf = NA_Msg_buf_alloc(
+        info.na_class, NA_TEST_RMA_CHUNK_MSG_SIZE, &info.send_buf_data);
+    NA_TEST_CHECK_ERROR(info.send_buf == NULL, error, na_ret, NA_NOMEM,
+        "NA_Msg_buf_alloc() failed");
+    info.recv_buf = NA_Msg_buf_alloc(
+        info.na_class, NA_TEST_RMA_CHUNK_MSG_SIZE, &info.recv_buf_data);
+    NA_TEST_CHECK_ERROR(info.recv_buf == NULL, error, na_ret, NA_NOMEM,
+        "NA_Msg_buf_alloc() failed");
+
+    na_ret = NA_Mem_handle_create(info.na_class, info.src_buf,
+        NA_TEST_RMA_CHUNK_SIZE, NA_MEM_READ_ONLY, &info.src_handle);
+    NA_TEST_CHECK_NA_ERROR(error, na_ret, "NA_Mem_handle_create() failed (%s)",
+        NA_Error_to_string(na_ret));
+    na_ret =
+        NA_Mem_register(info.na_class, info.src_handle, NA_MEM_TYPE_HOST, 0);
+    NA_TEST_CHECK_NA_ERROR(error, na_ret, "NA_Mem_register() failed (%s)",
+        NA_Error_to_string(na_ret));
+    na_ret = NA_Mem_handle_create(info.na_class, info.dst_buf,
+        NA_TEST_RMA_CHUNK_SIZE, NA_MEM_READWRITE, &info.dst_handle);
+    NA_TEST_CHECK_NA_ERROR(error, na_ret, "NA_Mem_handle_create() failed (%s)",
+        NA_Error_to_string(na_ret));
+    na_ret =
+        NA_Mem_register(info.na_class, info.dst_handle, NA_MEM_TYPE_HOST, 0);
+    NA_TEST_CHECK_NA_ERROR(error, na_ret, "NA_Mem_register() failed (%s)",
+        NA_Error_to_string(na_ret));
+
+    NA_TEST("messages during a chunked NA_Get()");
+    na_ret = na_test_rma_chunk_interleave(&info);
+    if (na_ret != NA_SUCCESS) {
+        NA_FAILED();
+        goto error;
+    }
+    NA_PASSED();
+
+    NA_TEST("NA_Cancel() of a chunked NA_Get()");
+    na_ret = na_test_rma_chunk_cancel(&info);
+    if (na_ret != NA_SUCCESS) {
+        NA_FAILED();
+        goto error;
+    }
+    NA_PASSED();
+
+done:
+    if (info.src_handle != NA_MEM_HANDLE_NULL) {
+        NA_Mem_deregister(info.na_class, info.src_handle);
+        NA_Mem_handle_free(info.na_class, info.src_handle);
+    }
+    if (info.dst_handle != NA_MEM_HANDLE_NULL) {
+        NA_Mem_deregister(info.na_class, info.dst_handle);
+        NA_Mem_handle_free(info.na_class, info.dst_handle);
+    }
+    if (info.send_buf != NULL)
+        NA_Msg_buf_free(info.na_class, info.send_buf, info.send_buf_data);
+    if (info.recv_buf != NULL)
+        NA_Msg_buf_free(info.na_class, info.recv_buf, info.recv_buf_data);
+    if (info.self_addr != NA_ADDR_NULL)
+        NA_Addr_free(info.na_class, info.self_addr);
+    if (info.rma_op_id != NULL)
+        NA_Op_destroy(info.na_class, info.rma_op_id);
+    if (info.send_op_id != NULL)
+        NA_Op_destroy(info.na_class, info.send_op_id);
+    if (info.recv_op_id != NULL)
+        NA_Op_destroy(info.na_class, info.recv_op_id);
+    if (info.context != NULL)
+        NA_Context_destroy(info.na_class, info.context);
+    free(info.src_buf);
+    free(info.dst_buf);
+    NA_Test_finalize(&na_test_info);
+
+    return ret;
+
+error:
+    ret = EXIT_FAILURE;
+    goto done;
+}
@@ -0,0 +1,402 @@
+/**
+ * Copyright (c) 2013-2021 UChicago Argonne, LLC and The HDF Group.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "na_test.h"
+
+#include <string.h>
+
+/****************/
+/* Local Macros */
+/****************/
+
+/* Size of each memory handle segment */
+#define NA_TEST_RMAV_SEG_SIZE (64)
+
+/* Exit code that CTest reports as skipped */
+#define NA_TEST_RMAV_SKIP (77)
+
+/************************************/
+/* Local Type and Struct Definition */
+/************************************/
+
+struct na_test_rmav_info {
+    na_class_t *na_class;
+    na_context_t *context;
+    na_addr_t self_addr;
+    na_op_id_t *op_id;
+    size_t max_iovcnt;
+    size_t seg_count;
+    size_t buf_size;
+    char *src_buf;
+    char *dst_buf;
+    na_mem_handle_t src_handle;
+    na_mem_handle_t dst_handle;
+};
+
+/********************/
+/* Local Prototypes */
+/********************/
+
+static int
+na_test_rmav_cb(const struct na_cb_info *na_cb_info);
+
+static na_return_t
+na_test_rmav_wait(struct na_test_rmav_info *info, int *completed);
+
+static na_return_t
+na_test_rmav_mem_handle_create(struct na_test_rmav_info *info, char *buf,
+    size_t seg_size, unsigned long flags, na_mem_handle_t *handle_p);
+
+static na_return_t
+na_test_rmav_whole(struct na_test_rmav_info *info);
+
+static na_return_t
+na_test_rmav_straddle(struct na_test_rmav_info *info);
+
+static na_return_t
+na_test_rmav_sparse(struct na_test_rmav_info *info);
+
+/*******************/
+/* Local Variables */
+/*******************/
+
+/*---------------------------------------------------------------------------*/
+static int
+na_test_rmav_cb(const struct na_cb_info *na_cb_info)
+{
+    int *completed = (int *) na_cb_info->arg;
+
+    *completed = (na_cb_info->ret == NA_SUCCESS) ? 1 : -1;
+
+    return 0;
+}
+
+/*---------------------------------------------------------------------------*/
+static na_return_t
+na_test_rmav_wait(struct na_test_rmav_info *info, int *completed)
+{
+    na_return_t ret = NA_SUCCESS;
+
+    while (*completed == 0) {
+        unsigned int actual_count = 0;
+
+        do {
+            ret = NA_Trigger(info->context, 0, 1, NULL, &actual_count);
+        } while ((ret == NA_SUCCESS) && actual_count && *completed == 0);
+        if (*completed != 0)
+            break;
+
+        ret = NA_Progress(info->na_class, info->context, 1000);
+        NA_TEST_CHECK_ERROR(ret != NA_SUCCESS && ret != NA_TIMEOUT, done, ret,
+            ret, "NA_Progress() failed (%s)", NA_Error_to_string(ret));
+    }
+    NA_TEST_CHECK_ERROR(*completed < 0, done, ret, NA_PROTOCOL_ERROR,
+        "Operation completed with an error");
+
+    return NA_SUCCESS;
+
+done:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static na_return_t
+na_test_rmav_mem_handle_create(struct na_test_rmav_info *info, char *buf,
+    size_t seg_size, unsigned long flags, na_mem_handle_t *handle_p)
+{
+    struct na_segment *segments;
+    na_return_t ret;
+    size_t i;
+
+    segments = (struct na_segment *) malloc(
+        info->seg_count * sizeof(struct na_segment));
+    NA_TEST_CHECK_ERROR(segments == NULL, error, ret, NA_NOMEM,
+        "Could not allocate segments");
+    for (i = 0; i < info->seg_count; i++) {
+        segments[i].base = buf + i * seg_size;
+        segments[i].len = seg_size;
+    }
+
+    ret = NA_Mem_handle_create_segments(
+        info->na_class, segments, info->seg_count, flags, handle_p);
+    free(segments);
+    NA_TEST_CHECK_NA_ERROR(error, ret,
+        "NA_Mem_handle_create_segments() failed (%s)", NA_Error_to_string(ret));
+
+    ret = NA_Mem_register(info->na_class, *handle_p, NA_MEM_TYPE_HOST, 0);
+    NA_TEST_CHECK_NA_ERROR(
+        error, ret, "NA_Mem_register() failed (%s)", NA_Error_to_string(ret));
+
+    return NA_SUCCESS;
+
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static na_return_t
+na_test_rmav_whole(struct na_test_rmav_info *info)
+{
+    struct na_rma_iov local_iov[2], remote_iov[1];
+    int completed = 0;
+    na_return_t ret;
+
+    /* Source handle is sent twice, local segments flatten to twice the
+     * number of entries that a vectored operation accepts */
+    local_iov[0] = (struct na_rma_iov){
+        .mem_handle = info->src_handle, .offset = 0, .len = info->buf_size};
+    local_iov[1] = local_iov[0];
+    remote_iov[0] = (struct na_rma_iov){.mem_handle = info->dst_handle,
+        .offset = 0,
+        .len = 2 * info->buf_size};
+    memset(info->dst_buf, 0, 2 * info->buf_size);
+
+    ret = NA_Putv(info->na_class, info->context, na_test_rmav_cb, &completed,
+        local_iov, 2, remote_iov, 1, info->self_addr, 0, info->op_id);
+    NA_TEST_CHECK_NA_ERROR(
+        error, ret, "NA_Putv() failed (%s)", NA_Error_to_string(ret));
+
+    ret = na_test_rmav_wait(info, &completed);
+    NA_TEST_CHECK_NA_ERROR(error, ret, "Could not complete NA_Putv()");
+
+    /* Source is duplicated into both halves of destination */
+    NA_TEST_CHECK_ERROR(memcmp(info->src_buf, info->dst_buf, info->buf_size),
+        error, ret, NA_FAULT, "Data put does not match");
+    NA_TEST_CHECK_ERROR(
+        memcmp(info->src_buf, info->dst_buf + info->buf_size, info->buf_size),
+        error, ret, NA_FAULT, "Data put does not match");
+
+    return NA_SUCCESS;
+
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static na_return_t
+na_test_rmav_straddle(struct na_test_rmav_info *info)
+{
+    struct na_rma_iov *local_iov = NULL, *remote_iov = NULL;
+    size_t start = NA_TEST_RMAV_SEG_SIZE / 2;
+    size_t iovcnt = info->seg_count - 1, i;
+    int completed = 0;
+    na_return_t ret;
+
+    /* Each remote entry straddles two segments, so that the flattened segment
+     * count is twice the number of entries */
+    local_iov =
+        (struct na_rma_iov *) malloc(iovcnt * sizeof(struct na_rma_iov));
+    NA_TEST_CHECK_ERROR(
+        local_iov == NULL, done, ret, NA_NOMEM, "Could not allocate iov");
+    remote_iov =
+        (struct na_rma_iov *) malloc(iovcnt * sizeof(struct na_rma_iov));
+    NA_TEST_CHECK_ERROR(
+        remote_iov == NULL, done, ret, NA_NOMEM, "Could not allocate iov");
+    for (i = 0; i < iovcnt; i++) {
+        na_offset_t offset = start + i * NA_TEST_RMAV_SEG_SIZE;
+
+        local_iov[i] = (struct na_rma_iov){.mem_handle = info->dst_handle,
+            .offset = offset,
+            .len = NA_TEST_RMAV_SEG_SIZE};
+        remote_iov[i] = (struct na_rma_iov){.mem_handle = info->src_handle,
+            .offset = offset,
+            .len = NA_TEST_RMAV_SEG_SIZE};
+    }
+    memset(info->dst_buf, 0, 2 * info->buf_size);
+
+    ret = NA_Getv(info->na_class, info->context, na_test_rmav_cb, &completed,
+        local_iov, iovcnt, remote_iov, iovcnt, info->self_addr, 0,
+        info->op_id);
+    NA_TEST_CHECK_NA_ERROR(
+        done, ret, "NA_Getv() failed (%s)", NA_Error_to_string(ret));
+
+    ret = na_test_rmav_wait(info, &completed);
+    NA_TEST_CHECK_NA_ERROR(done, ret, "Could not complete NA_Getv()");
+
+    NA_TEST_CHECK_ERROR(memcmp(info->src_buf + start, info->dst_buf + start,
+                            iovcnt * NA_TEST_RMAV_SEG_SIZE),
+        done, ret, NA_FAULT, "Data get does not match");
+
+done:
+    free(local_iov);
+    free(remote_iov);
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static na_return_t
+na_test_rmav_sparse(struct na_test_rmav_info *info)
+{
+    struct na_segment *segments = NULL;
+    struct na_rma_iov local_iov[3], remote_iov[1];
+    na_mem_handle_t sparse_handle = NA_MEM_HANDLE_NULL;
+    size_t data_count = info->seg_count / 2, len, i;
+    int completed = 0;
+    na_return_t ret;
+
+    /* Every other segment is empty, source handle is sent three times so
+     * that its non-empty segments exceed what a single copy accepts */
+    segments = (struct na_segment *) malloc(
+        info->seg_count * sizeof(struct na_segment));
+    NA_TEST_CHECK_ERROR(segments == NULL, done, ret, NA_NOMEM,
+        "Could not allocate segments");
+    for (i = 0; i < info->seg_count; i++) {
+        segments[i].base = info->src_buf + (i / 2) * NA_TEST_RMAV_SEG_SIZE;
+        segments[i].len = (i % 2) ? NA_TEST_RMAV_SEG_SIZE : 0;
+    }
+
+    ret = NA_Mem_handle_create_segments(info->na_class, segments,
+        info->seg_count, NA_MEM_READWRITE, &sparse_handle);
+    NA_TEST_CHECK_NA_ERROR(done, ret,
+        "NA_Mem_handle_create_segments() failed (%s)", NA_Error_to_string(ret));
+    ret = NA_Mem_register(info->na_class, sparse_handle, NA_MEM_TYPE_HOST, 0);
+    NA_TEST_CHECK_NA_ERROR(
+        done, ret, "NA_Mem_register() failed (%s)", NA_Error_to_string(ret));
+
+    len = data_count * NA_TEST_RMAV_SEG_SIZE;
+    for (i = 0; i < 3; i++)
+        local_iov[i] = (struct na_rma_iov){
+            .mem_handle = sparse_handle, .offset = 0, .len = len};
+    remote_iov[0] = (struct na_rma_iov){
+        .mem_handle = info->dst_handle, .offset = 0, .len = 3 * len};
+    memset(info->dst_buf, 0, 2 * info->buf_size);
+
+    ret = NA_Putv(info->na_class, info->context, na_test_rmav_cb, &completed,
+        local_iov, 3, remote_iov, 1, info->self_addr, 0, info->op_id);
+    NA_TEST_CHECK_NA_ERROR(
+        done, ret, "NA_Putv() failed (%s)", NA_Error_to_string(ret));
+
+    ret = na_test_rmav_wait(info, &completed);
+    NA_TEST_CHECK_NA_ERROR(done, ret, "Could not complete NA_Putv()");
+
+    /* Non-empty segments are contiguous in the source buffer */
+    for (i = 0; i < 3; i++)
+        NA_TEST_CHECK_ERROR(
+            memcmp(info->src_buf, info->dst_buf + i * len, len), done, ret,
+            NA_FAULT, "Data put does not match");
+
+done:
+    if (sparse_handle != NA_MEM_HANDLE_NULL) {
+        NA_Mem_deregister(info->na_class, sparse_handle);
+        NA_Mem_handle_free(info->na_class, sparse_handle);
+    }
+    free(segments);
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+int
+main(int argc, char *argv[])
+{
+    struct na_test_info na_test_info = {0};
+    struct na_test_rmav_info info = {0};
+    na_return_t na_ret;
+    size_t i;
+    int ret = EXIT_SUCCESS;
+
+    /* Initialize the interface */
+    na_ret = NA_Test_init(argc, argv, &na_test_info);
+    NA_TEST_CHECK_NA_ERROR(error, na_ret, "NA_Test_init() failed (%s)",
+        NA_Error_to_string(na_ret));
+    info.na_class = na_test_info.na_class;
+
+    info.max_iovcnt = NA_Rma_get_max_iovcnt(info.na_class);
+    if (info.max_iovcnt == 0) {
+        printf("# Vectored RMA not supported by %s plugin, skipping\n",
+            NA_Get_class_name(info.na_class));
+        ret = NA_TEST_RMAV_SKIP;
+        goto done;
+    }
+
+    /* Use as many segments per handle as a vectored operation accepts
+     * entries, translated segments then exceed that limit */
+    info.seg_count =
+        NA_Mem_handle_get_max_segments(info.na_class) < info.max_iovcnt
+            ? NA_Mem_handle_get_max_segments(info.na_class)
+            : info.max_iovcnt;
+    NA_TEST_CHECK_ERROR(info.seg_count < 2, error, na_ret, NA_PROTOCOL_ERROR,
+        "Not enough segments per memory handle (%zu)", info.seg_count);
+    info.buf_size = info.seg_count * NA_TEST_RMAV_SEG_SIZE;
+    printf("# Max iovcnt %zu, %zu segments per handle\n", info.max_iovcnt,
+        info.seg_count);
+
+    info.src_buf = (char *) malloc(info.buf_size);
+    NA_TEST_CHECK_ERROR(info.src_buf == NULL, error, na_ret, NA_NOMEM,
+        "Could not allocate buffer");
+    info.dst_buf = (char *) malloc(2 * info.buf_size);
+    NA_TEST_CHECK_ERROR(info.dst_buf == NULL, error, na_ret, NA_NOMEM,
+        "Could not allocate buffer");
+    for (i = 0; i < info.buf_size; i++)
+        info.src_buf[i] = (char) i;
+
+    info.context = NA_Context_create(info.na_class);
+    NA_TEST_CHECK_ERROR(info.context == NULL, error, na_ret, NA_NOMEM,
+        "NA_Context_create() failed");
+    info.op_id = NA_Op_create(info.na_class);
+    NA_TEST_CHECK_ERROR(info.op_id == NULL, error, na_ret, NA_NOMEM,
+        "NA_Op_create() failed");
+    na_ret = NA_Addr_self(info.na_class, &info.self_addr);
+    NA_TEST_CHECK_NA_ERROR(error, na_ret, "NA_Addr_self() failed (%s)",
+        NA_Error_to_string(na_ret));
+
+    na_ret = na_test_rmav_mem_handle_create(&info, info.src_buf,
+        NA_TEST_RMAV_SEG_SIZE, NA_MEM_READWRITE, &info.src_handle);
+    NA_TEST_CHECK_NA_ERROR(error, na_ret, "Could not create source handle");
+    na_ret = na_test_rmav_mem_handle_create(&info, info.dst_buf,
+        2 * NA_TEST_RMAV_SEG_SIZE, NA_MEM_READWRITE, &info.dst_handle);
+    NA_TEST_CHECK_NA_ERROR(error, na_ret, "Could not create dest handle");
+
+    NA_TEST("NA_Putv() of whole handles");
+    na_ret = na_test_rmav_whole(&info);
+    if (na_ret != NA_SUCCESS) {
+        NA_FAILED();
+        goto error;
+    }
+    NA_PASSED();
+
+    NA_TEST("NA_Getv() of entries straddling segments");
+    na_ret = na_test_rmav_straddle(&info);
+    if (na_ret != NA_SUCCESS) {
+        NA_FAILED();
+        goto error;
+    }
+    NA_PASSED();
+
+    NA_TEST("NA_Putv() of handles with empty segments");
+    na_ret = na_test_rmav_sparse(&info);
+    if (na_ret != NA_SUCCESS) {
+        NA_FAILED();
+        goto error;
+    }
+    NA_PASSED();
+
+done:
+    if (info.src_handle != NA_MEM_HANDLE_NULL) {
+        NA_Mem_deregister(info.na_class, info.src_handle);
+        NA_Mem_handle_free(info.na_class, info.src_handle);
+    }
+    if (info.dst_handle != NA_MEM_HANDLE_NULL) {
+        NA_Mem_deregister(info.na_class, info.dst_handle);
+        NA_Mem_handle_free(info.na_class, info.dst_handle);
+    }
+    if (info.self_addr != NA_ADDR_NULL)
+        NA_Addr_free(info.na_class, info.self_addr);
+    if (info.op_id != NULL)
+        NA_Op_destroy(info.na_class, info.op_id);
+    if (info.context != NULL)
+        NA_Context_destroy(info.na_class, info.context);
+    free(info.src_buf);
+    free(info.dst_buf);
+    NA_Test_finalize(&na_test_info);
+
+    return ret;
+
+error:
+    ret = EXIT_FAILURE;
+    goto done;
+}
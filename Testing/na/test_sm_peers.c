@@ -0,0 +1,502 @@
+/**
+ * Copyright (c) 2013-2021 UChicago Argonne, LLC and The HDF Group.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "na_test.h"
+
+#include "mercury_time.h"
+
+#include <signal.h>
+#include <string.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+/****************/
+/* Local Macros */
+/****************/
+
+/* Number of peer processes, each process holds up to 256 NA SM classes */
+#define NA_TEST_SM_PEERS_PROC_COUNT (4)
+
+/* Number of NA SM classes (peers) per process */
+#define NA_TEST_SM_PEERS_PER_PROC (75)
+
+/* Total number of peers, more than the 256 that NA SM used to accept */
+#define NA_TEST_SM_PEERS_COUNT                                                 \
+    (NA_TEST_SM_PEERS_PROC_COUNT * NA_TEST_SM_PEERS_PER_PROC)
+
+#define NA_TEST_SM_PEERS_MSG_SIZE (64)
+
+/* Time after which a peer is considered lost (in seconds) */
+#define NA_TEST_SM_PEERS_TIMEOUT (60)
+
+/* Exit code that CTest reports as skipped */
+#define NA_TEST_SM_PEERS_SKIP (77)
+
+/************************************/
+/* Local Type and Struct Definition */
+/************************************/
+
+/* Peer, messages are tagged with the peer index */
+struct na_test_sm_peer {
+    na_class_t *na_class;
+    na_context_t *context;
+    na_addr_t server_addr;
+    na_op_id_t *send_op_id;
+    na_op_id_t *recv_op_id;
+    void *send_buf;
+    void *send_buf_data;
+    void *recv_buf;
+    void *recv_buf_data;
+    uint32_t index;
+    int send_completed;
+    int recv_completed;
+};
+
+/* Server */
+struct na_test_sm_peers_info {
+    na_class_t *na_class;
+    na_context_t *context;
+    na_op_id_t *op_id;
+    void *buf;
+    void *buf_data;
+    na_addr_t addrs[NA_TEST_SM_PEERS_COUNT];
+};
+
+/* Completion of unexpected receive */
+struct na_test_sm_peers_recv {
+    na_addr_t source;
+    na_tag_t tag;
+    int completed;
+};
+
+/********************/
+/* Local Prototypes */
+/********************/
+
+static int
+na_test_sm_peers_cb(const struct na_cb_info *na_cb_info);
+
+static int
+na_test_sm_peers_recv_cb(const struct na_cb_info *na_cb_info);
+
+static na_return_t
+na_test_sm_peers_wait(na_class_t *na_class, na_context_t *context,
+    na_op_id_t *op_id, int *completed);
+
+static na_return_t
+na_test_sm_peer_init(
+    struct na_test_sm_peer *peer, const char *server_name, uint32_t index);
+
+static void
+na_test_sm_peer_finalize(struct na_test_sm_peer *peer);
+
+static void
+na_test_sm_peers_child(const char *server_name, uint32_t first_index);
+
+static na_return_t
+na_test_sm_peers_serve(struct na_test_sm_peers_info *info);
+
+/*******************/
+/* Local Variables */
+/*******************/
+
+/*---------------------------------------------------------------------------*/
+static int
+na_test_sm_peers_cb(const struct na_cb_info *na_cb_info)
+{
+    int *completed = (int *) na_cb_info->arg;
+
+    *completed = (na_cb_info->ret == NA_SUCCESS) ? 1 : -1;
+
+    return 0;
+}
+
+/*---------------------------------------------------------------------------*/
+static int
+na_test_sm_peers_recv_cb(const struct na_cb_info *na_cb_info)
+{
+    struct na_test_sm_peers_recv *recv =
+        (struct na_test_sm_peers_recv *) na_cb_info->arg;
+
+    if (na_cb_info->ret == NA_SUCCESS) {
+        recv->source = na_cb_info->info.recv_unexpected.source;
+        recv->tag = na_cb_info->info.recv_unexpected.tag;
+        recv->completed = 1;
+    } else
+        recv->completed = -1;
+
+    return 0;
+}
+
+/*---------------------------------------------------------------------------*/
+static na_return_t
+na_test_sm_peers_wait(na_class_t *na_class, na_context_t *context,
+    na_op_id_t *op_id, int *completed)
+{
+    hg_time_t deadline, now;
+    bool canceled = false;
+    na_return_t ret = NA_SUCCESS;
+
+    /* Peers that cannot reserve a queue pair retry forever, do not hang */
+    hg_time_get_current_ms(&now);
+    deadline =
+        hg_time_add(now, hg_time_from_ms(NA_TEST_SM_PEERS_TIMEOUT * 1000));
+
+    while (*completed == 0) {
+        unsigned int actual_count = 0;
+
+        hg_time_get_current_ms(&now);
+        if (!canceled && !hg_time_less(now, deadline)) {
+            NA_TEST_LOG_ERROR("Timed out waiting for peers");
+            ret = NA_Cancel(na_class, context, op_id);
+            NA_TEST_CHECK_NA_ERROR(
+                done, ret, "NA_Cancel() failed (%s)", NA_Error_to_string(ret));
+            canceled = true;
+        }
+
+        do {
+            ret = NA_Trigger(context, 0, 1, NULL, &actual_count);
+        } while ((ret == NA_SUCCESS) && actual_count && *completed == 0);
+        if (*completed != 0)
+            break;
+
+        /* Peers do not notify the server, which must busy-poll */
+        ret = NA_Progress(na_class, context, 0);
+        NA_TEST_CHECK_ERROR(ret != NA_SUCCESS && ret != NA_TIMEOUT, done, ret,
+            ret, "NA_Progress() failed (%s)", NA_Error_to_string(ret));
+    }
+    NA_TEST_CHECK_ERROR(canceled, done, ret, NA_TIMEOUT, "Operation canceled");
+    NA_TEST_CHECK_ERROR(*completed < 0, done, ret, NA_PROTOCOL_ERROR,
+        "Operation completed with an error");
+
+    return NA_SUCCESS;
+
+done:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static na_return_t
+na_test_sm_peer_init(
+    struct na_test_sm_peer *peer, const char *server_name, uint32_t index)
+{
+    struct na_init_info na_init_info = NA_INIT_INFO_INITIALIZER;
+    size_t header_size;
+    na_return_t ret;
+
+    peer->index = index;
+
+    /* Busy-polled peers do not use any file descriptor for notifications */
+    na_init_info.progress_mode = NA_NO_BLOCK;
+    peer->na_class = NA_Initialize_opt("na+sm", false, &na_init_info);
+    NA_TEST_CHECK_ERROR(peer->na_class == NULL, error, ret, NA_NOMEM,
+        "Could not initialize peer %" PRIu32, index);
+    peer->context = NA_Context_create(peer->na_class);
+    NA_TEST_CHECK_ERROR(peer->context == NULL, error, ret, NA_NOMEM,
+        "NA_Context_create() failed");
+    peer->send_op_id = NA_Op_create(peer->na_class);
+    NA_TEST_CHECK_ERROR(peer->send_op_id == NULL, error, ret, NA_NOMEM,
+        "NA_Op_create() failed");
+    peer->recv_op_id = NA_Op_create(peer->na_class);
+    NA_TEST_CHECK_ERROR(peer->recv_op_id == NULL, error, ret, NA_NOMEM,
+        "NA_Op_create() failed");
+    peer->send_buf = NA_Msg_buf_alloc(
+        peer->na_class, NA_TEST_SM_PEERS_MSG_SIZE, &peer->send_buf_data);
+    NA_TEST_CHECK_ERROR(peer->send_buf == NULL, error, ret, NA_NOMEM,
+        "NA_Msg_buf_alloc() failed");
+    peer->recv_buf = NA_Msg_buf_alloc(
+        peer->na_class, NA_TEST_SM_PEERS_MSG_SIZE, &peer->recv_buf_data);
+    NA_TEST_CHECK_ERROR(peer->recv_buf == NULL, error, ret, NA_NOMEM,
+        "NA_Msg_buf_alloc() failed");
+
+    ret = NA_Addr_lookup(peer->na_class, server_name, &peer->server_addr);
+    NA_TEST_CHECK_NA_ERROR(
+        error, ret, "NA_Addr_lookup() failed (%s)", NA_Error_to_string(ret));
+
+    ret = NA_Msg_recv_expected(peer->na_class, peer->context,
+        na_test_sm_peers_cb, &peer->recv_completed, peer->recv_buf,
+        NA_TEST_SM_PEERS_MSG_SIZE, peer->recv_buf_data, peer->server_addr, 0,
+        (na_tag_t) index, peer->recv_op_id);
+    NA_TEST_CHECK_NA_ERROR(error, ret, "NA_Msg_recv_expected() failed (%s)",
+        NA_Error_to_string(ret));
+
+    ret = NA_Msg_init_unexpected(
+        peer->na_class, peer->send_buf, NA_TEST_SM_PEERS_MSG_SIZE);
+    NA_TEST_CHECK_NA_ERROR(error, ret, "NA_Msg_init_unexpected() failed (%s)",
+        NA_Error_to_string(ret));
+    header_size = NA_Msg_get_unexpected_header_size(peer->na_class);
+    memcpy((char *) peer->send_buf + header_size, &index, sizeof(index));
+
+    ret = NA_Msg_send_unexpected(peer->na_class, peer->context,
+        na_test_sm_peers_cb, &peer->send_completed, peer->send_buf,
+        NA_TEST_SM_PEERS_MSG_SIZE, peer->send_buf_data, peer->server_addr, 0,
+        (na_tag_t) index, peer->send_op_id);
+    NA_TEST_CHECK_NA_ERROR(error, ret, "NA_Msg_send_unexpected() failed (%s)",
+        NA_Error_to_string(ret));
+
+    return NA_SUCCESS;
+
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+na_test_sm_peer_finalize(struct na_test_sm_peer *peer)
+{
+    if (peer->na_class == NULL)
+        return;
+
+    if (peer->server_addr != NA_ADDR_NULL)
+        NA_Addr_free(peer->na_class, peer->server_addr);
+    if (peer->send_buf != NULL)
+        NA_Msg_buf_free(peer->na_class, peer->send_buf, peer->send_buf_data);
+    if (peer->recv_buf != NULL)
+        NA_Msg_buf_free(peer->na_class, peer->recv_buf, peer->recv_buf_data);
+    if (peer->send_op_id != NULL)
+        NA_Op_destroy(peer->na_class, peer->send_op_id);
+    if (peer->recv_op_id != NULL)
+        NA_Op_destroy(peer->na_class, peer->recv_op_id);
+    if (peer->context != NULL)
+        NA_Context_destroy(peer->na_class, peer->context);
+    NA_Finalize(peer->na_class);
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+na_test_sm_peers_child(const char *server_name, uint32_t first_index)
+{
+    struct na_test_sm_peer *peers;
+    uint32_t i, pending = NA_TEST_SM_PEERS_PER_PROC;
+    int ret = EXIT_FAILURE;
+
+    peers = (struct na_test_sm_peer *) calloc(
+        NA_TEST_SM_PEERS_PER_PROC, sizeof(*peers));
+    NA_TEST_CHECK_ERROR_NORET(
+        peers == NULL, done, "Could not allocate peers");
+
+    /* All peers connect before any of them disconnects */
+    for (i = 0; i < NA_TEST_SM_PEERS_PER_PROC; i++)
+        NA_TEST_CHECK_ERROR_NORET(na_test_sm_peer_init(&peers[i], server_name,
+                                      first_index + i) != NA_SUCCESS,
+            finalize, "Could not initialize peer %" PRIu32, first_index + i);
+
+    /* Server replies once it has heard from every peer */
+    while (pending > 0) {
+        for (i = 0; i < NA_TEST_SM_PEERS_PER_PROC; i++) {
+            struct na_test_sm_peer *peer = &peers[i];
+            unsigned int actual_count = 0;
+            na_return_t na_ret;
+
+            if (peer->recv_completed != 0 && peer->send_completed != 0)
+                continue;
+
+            na_ret = NA_Progress(peer->na_class, peer->context, 0);
+            NA_TEST_CHECK_ERROR_NORET(
+                na_ret != NA_SUCCESS && na_ret != NA_TIMEOUT, finalize,
+                "NA_Progress() failed (%s)", NA_Error_to_string(na_ret));
+            do {
+                na_ret = NA_Trigger(peer->context, 0, 1, NULL, &actual_count);
+            } while ((na_ret == NA_SUCCESS) && actual_count);
+            NA_TEST_CHECK_ERROR_NORET(
+                peer->send_completed < 0 || peer->recv_completed < 0, finalize,
+                "Peer %" PRIu32 " operation failed", peer->index);
+
+            if (peer->recv_completed != 0 && peer->send_completed != 0) {
+                size_t header_size =
+                    NA_Msg_get_expected_header_size(peer->na_class);
+                uint32_t index;
+
+                memcpy(&index, (char *) peer->recv_buf + header_size,
+                    sizeof(index));
+                NA_TEST_CHECK_ERROR_NORET(index != peer->index, finalize,
+                    "Peer %" PRIu32 " received reply of %" PRIu32, peer->index,
+                    index);
+                pending--;
+            }
+        }
+    }
+    ret = EXIT_SUCCESS;
+
+finalize:
+    for (i = 0; i < NA_TEST_SM_PEERS_PER_PROC; i++)
+        na_test_sm_peer_finalize(&peers[i]);
+    free(peers);
+
+done:
+    _exit(ret);
+}
+
+/*---------------------------------------------------------------------------*/
+static na_return_t
+na_test_sm_peers_serve(struct na_test_sm_peers_info *info)
+{
+    size_t unexpected_header_size =
+        NA_Msg_get_unexpected_header_size(info->na_class);
+    size_t expected_header_size =
+        NA_Msg_get_expected_header_size(info->na_class);
+    na_return_t ret = NA_SUCCESS;
+    uint32_t i;
+
+    /* Receive one message from every peer */
+    for (i = 0; i < NA_TEST_SM_PEERS_COUNT; i++) {
+        struct na_test_sm_peers_recv recv = {NA_ADDR_NULL, 0, 0};
+        uint32_t index;
+
+        ret = NA_Msg_recv_unexpected(info->na_class, info->context,
+            na_test_sm_peers_recv_cb, &recv, info->buf,
+            NA_TEST_SM_PEERS_MSG_SIZE, info->buf_data, info->op_id);
+        NA_TEST_CHECK_NA_ERROR(error, ret,
+            "NA_Msg_recv_unexpected() failed (%s)", NA_Error_to_string(ret));
+        ret = na_test_sm_peers_wait(
+            info->na_class, info->context, info->op_id, &recv.completed);
+        NA_TEST_CHECK_NA_ERROR(error, ret, "Could not complete recv");
+
+        memcpy(&index, (char *) info->buf + unexpected_header_size,
+            sizeof(index));
+        if (index >= NA_TEST_SM_PEERS_COUNT || recv.tag != (na_tag_t) index ||
+            info->addrs[index] != NA_ADDR_NULL) {
+            NA_TEST_LOG_ERROR("Unexpected message from peer %" PRIu32, index);
+            NA_Addr_free(info->na_class, recv.source);
+            ret = NA_PROTOCOL_ERROR;
+            goto error;
+        }
+        info->addrs[index] = recv.source;
+    }
+
+    /* All peers are connected at this point, reply to each of them */
+    ret = NA_Msg_init_expected(
+        info->na_class, info->buf, NA_TEST_SM_PEERS_MSG_SIZE);
+    NA_TEST_CHECK_NA_ERROR(error, ret, "NA_Msg_init_expected() failed (%s)",
+        NA_Error_to_string(ret));
+    for (i = 0; i < NA_TEST_SM_PEERS_COUNT; i++) {
+        int completed = 0;
+
+        memcpy((char *) info->buf + expected_header_size, &i, sizeof(i));
+        ret = NA_Msg_send_expected(info->na_class, info->context,
+            na_test_sm_peers_cb, &completed, info->buf,
+            NA_TEST_SM_PEERS_MSG_SIZE, info->buf_data, info->addrs[i], 0,
+            (na_tag_t) i, info->op_id);
+        NA_TEST_CHECK_NA_ERROR(error, ret,
+            "NA_Msg_send_expected() failed (%s)", NA_Error_to_string(ret));
+        ret = na_test_sm_peers_wait(
+            info->na_class, info->context, info->op_id, &completed);
+        NA_TEST_CHECK_NA_ERROR(
+            error, ret, "Could not complete send to peer %" PRIu32, i);
+    }
+
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+int
+main(int argc, char *argv[])
+{
+    struct na_test_info na_test_info = {0};
+    struct na_test_sm_peers_info *info = NULL;
+    pid_t pids[NA_TEST_SM_PEERS_PROC_COUNT];
+    char server_name[NA_TEST_MAX_ADDR_NAME] = {'\0'};
+    size_t server_name_len = NA_TEST_MAX_ADDR_NAME;
+    na_addr_t self_addr = NA_ADDR_NULL;
+    na_return_t na_ret;
+    int ret = EXIT_SUCCESS, i;
+
+    for (i = 0; i < NA_TEST_SM_PEERS_PROC_COUNT; i++)
+        pids[i] = -1;
+
+    /* Initialize the interface */
+    na_ret = NA_Test_init(argc, argv, &na_test_info);
+    NA_TEST_CHECK_NA_ERROR(error, na_ret, "NA_Test_init() failed (%s)",
+        NA_Error_to_string(na_ret));
+
+    /* Peer limit is specific to na_sm */
+    if (strcmp(NA_Get_class_name(na_test_info.na_class), "na") != 0) {
+        printf("# Test only applies to NA SM, skipping\n");
+        ret = NA_TEST_SM_PEERS_SKIP;
+        goto done;
+    }
+
+    info = (struct na_test_sm_peers_info *) calloc(1, sizeof(*info));
+    NA_TEST_CHECK_ERROR(
+        info == NULL, error, na_ret, NA_NOMEM, "Could not allocate info");
+    info->na_class = na_test_info.na_class;
+    info->context = NA_Context_create(info->na_class);
+    NA_TEST_CHECK_ERROR(info->context == NULL, error, na_ret, NA_NOMEM,
+        "NA_Context_create() failed");
+    info->op_id = NA_Op_create(info->na_class);
+    NA_TEST_CHECK_ERROR(info->op_id == NULL, error, na_ret, NA_NOMEM,
+        "NA_Op_create() failed");
+    info->buf = NA_Msg_buf_alloc(
+        info->na_class, NA_TEST_SM_PEERS_MSG_SIZE, &info->buf_data);
+    NA_TEST_CHECK_ERROR(info->buf == NULL, error, na_ret, NA_NOMEM,
+        "NA_Msg_buf_alloc() failed");
+
+    na_ret = NA_Addr_self(info->na_class, &self_addr);
+    NA_TEST_CHECK_NA_ERROR(error, na_ret, "NA_Addr_self() failed (%s)",
+        NA_Error_to_string(na_ret));
+    na_ret = NA_Addr_to_string(
+        info->na_class, server_name, &server_name_len, self_addr);
+    NA_TEST_CHECK_NA_ERROR(error, na_ret, "NA_Addr_to_string() failed (%s)",
+        NA_Error_to_string(na_ret));
+
+    /* Each process holds a subset of the peers */
+    for (i = 0; i < NA_TEST_SM_PEERS_PROC_COUNT; i++) {
+        pids[i] = fork();
+        NA_TEST_CHECK_ERROR(pids[i] < 0, error, na_ret, NA_PROTOCOL_ERROR,
+            "fork() failed");
+        if (pids[i] == 0)
+            na_test_sm_peers_child(
+                server_name, (uint32_t) (i * NA_TEST_SM_PEERS_PER_PROC));
+    }
+
+    NA_TEST("unexpected messages from more than 256 peers");
+    na_ret = na_test_sm_peers_serve(info);
+    if (na_ret != NA_SUCCESS) {
+        NA_FAILED();
+        goto error;
+    }
+    for (i = 0; i < NA_TEST_SM_PEERS_PROC_COUNT; i++) {
+        int status;
+
+        NA_TEST_CHECK_ERROR(waitpid(pids[i], &status, 0) != pids[i], error,
+            na_ret, NA_PROTOCOL_ERROR, "waitpid() failed");
+        pids[i] = -1;
+        NA_TEST_CHECK_ERROR(!WIFEXITED(status) || WEXITSTATUS(status) != 0,
+            error, na_ret, NA_PROTOCOL_ERROR, "Peer process %d failed", i);
+    }
+    NA_PASSED();
+
+done:
+    for (i = 0; i < NA_TEST_SM_PEERS_PROC_COUNT; i++) {
+        if (pids[i] > 0) {
+            kill(pids[i], SIGKILL);
+            waitpid(pids[i], NULL, 0);
+        }
+    }
+    if (info != NULL) {
+        for (i = 0; i < NA_TEST_SM_PEERS_COUNT; i++)
+            if (info->addrs[i] != NA_ADDR_NULL)
+                NA_Addr_free(info->na_class, info->addrs[i]);
+        if (info->buf != NULL)
+            NA_Msg_buf_free(info->na_class, info->buf, info->buf_data);
+        if (info->op_id != NULL)
+            NA_Op_destroy(info->na_class, info->op_id);
+        if (info->context != NULL)
+            NA_Context_destroy(info->na_class, info->context);
+        free(info);
+    }
+    if (self_addr != NA_ADDR_NULL)
+        NA_Addr_free(na_test_info.na_class, self_addr);
+    NA_Test_finalize(&na_test_info);
+
+    return ret;
+
+error:
+    ret = EXIT_FAILURE;
+    goto done;
+}
@@ -6,10 +6,19 @@
 
 #include "mercury_test.h"
 
+#include "mercury_mem.h"
+
 /****************/
 /* Local Macros */
 /****************/
 
+/* Size and number of buffers used by cache test, only two fit in cache */
+#define CACHE_BUF_SIZE  (4096)
+#define CACHE_BUF_COUNT (3)
+
+/* Number of segments allocated by HG_Bulk_create() in alloc test */
+#define ALLOC_SEG_COUNT (3)
+
 /************************************/
 /* Local Type and Struct Definition */
 /************************************/
@@ -27,6 +36,22 @@ struct forward_cb_args {
 static hg_return_t
 hg_test_bulk_forward_cb(const struct hg_cb_info *callback_info);
 
+static hg_return_t
+hg_test_bulk_chunked(hg_class_t *hg_class, hg_context_t *context,
+    hg_request_class_t *request_class, hg_addr_t target_addr,
+    hg_size_t transfer_size, hg_size_t chunk_size, hg_uint32_t max_in_flight,
+    hg_size_t cancel_size);
+
+static hg_return_t
+hg_test_bulk_cache_check(hg_class_t *hg_class, hg_uint64_t hit_count,
+    hg_uint64_t miss_count, hg_uint32_t entry_count, hg_uint32_t unused_count);
+
+static hg_return_t
+hg_test_bulk_cache(na_class_t *na_class);
+
+static hg_return_t
+hg_test_bulk_alloc(na_class_t *na_class);
+
 /*******************/
 /* Local Variables */
 /*******************/
@@ -34,6 +59,7 @@ hg_test_bulk_forward_cb(const struct hg_cb_info *callback_info);
 extern hg_id_t hg_test_bulk_write_id_g;
 extern hg_id_t hg_test_bulk_bind_write_id_g;
 extern hg_id_t hg_test_bulk_bind_forward_id_g;
+extern hg_id_t hg_test_bulk_chunked_write_id_g;
 
 /*---------------------------------------------------------------------------*/
 static hg_return_t
@@ -469,6 +495,305 @@ done:
     return ret;
 }
 
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_test_bulk_chunked(hg_class_t *hg_class, hg_context_t *context,
+    hg_request_class_t *request_class, hg_addr_t target_addr,
+    hg_size_t transfer_size, hg_size_t chunk_size, hg_uint32_t max_in_flight,
+    hg_size_t cancel_size)
+{
+    hg_request_t *request = NULL;
+    hg_handle_t handle = HG_HANDLE_NULL;
+    hg_bulk_t bulk_handle = HG_BULK_NULL;
+    hg_return_t ret = HG_SUCCESS, cleanup_ret;
+    struct forward_cb_args forward_cb_args;
+    bulk_chunked_write_in_t in_struct;
+    char *bulk_buf = NULL;
+    size_t i;
+
+    /* Prepare bulk_buf */
+    bulk_buf = malloc(transfer_size);
+    HG_TEST_CHECK_ERROR(bulk_buf == NULL, done, ret, HG_NOMEM_ERROR,
+        "Could not allocate bulk_buf");
+    for (i = 0; i < transfer_size; i++)
+        bulk_buf[i] = (char) i;
+
+    request = hg_request_create(request_class);
+
+    /* Register memory */
+    ret = HG_Bulk_create(hg_class, 1, (void **) &bulk_buf, &transfer_size,
+        HG_BULK_READ_ONLY, &bulk_handle);
+    HG_TEST_CHECK_HG_ERROR(
+        done, ret, "HG_Bulk_create() failed (%s)", HG_Error_to_string(ret));
+
+    ret = HG_Create(
+        context, target_addr, hg_test_bulk_chunked_write_id_g, &handle);
+    HG_TEST_CHECK_HG_ERROR(
+        done, ret, "HG_Create() failed (%s)", HG_Error_to_string(ret));
+
+    /* Fill input structure */
+    in_struct.transfer_size = transfer_size;
+    in_struct.chunk_size = chunk_size;
+    in_struct.max_in_flight = max_in_flight;
+    in_struct.cancel_size = cancel_size;
+    in_struct.bulk_handle = bulk_handle;
+
+    /* Target cancels the transfer once cancel_size bytes have completed, with
+     * a single chunk in flight nothing is transferred past that point */
+    forward_cb_args.request = request;
+    forward_cb_args.expected_bytes =
+        (cancel_size > 0) ? cancel_size : transfer_size;
+    forward_cb_args.ret = HG_SUCCESS;
+    ret = HG_Forward(
+        handle, hg_test_bulk_forward_cb, &forward_cb_args, &in_struct);
+    HG_TEST_CHECK_HG_ERROR(
+        done, ret, "HG_Forward() failed (%s)", HG_Error_to_string(ret));
+
+    hg_request_wait(request, HG_MAX_IDLE_TIME, NULL);
+
+    /* Assign ret from CB */
+    ret = forward_cb_args.ret;
+
+done:
+    cleanup_ret = HG_Bulk_free(bulk_handle);
+    HG_TEST_CHECK_ERROR_DONE(cleanup_ret != HG_SUCCESS,
+        "HG_Bulk_free() failed (%s)", HG_Error_to_string(cleanup_ret));
+
+    cleanup_ret = HG_Destroy(handle);
+    HG_TEST_CHECK_ERROR_DONE(cleanup_ret != HG_SUCCESS,
+        "HG_Destroy() failed (%s)", HG_Error_to_string(cleanup_ret));
+
+    hg_request_destroy(request);
+    free(bulk_buf);
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_test_bulk_cache_check(hg_class_t *hg_class, hg_uint64_t hit_count,
+    hg_uint64_t miss_count, hg_uint32_t entry_count, hg_uint32_t unused_count)
+{
+    struct hg_bulk_cache_stats stats;
+    hg_return_t ret;
+
+    ret = HG_Bulk_cache_get_stats(hg_class, &stats);
+    HG_TEST_CHECK_HG_ERROR(done, ret, "HG_Bulk_cache_get_stats() failed (%s)",
+        HG_Error_to_string(ret));
+
+    HG_TEST_CHECK_ERROR(stats.hit_count != hit_count ||
+                            stats.miss_count != miss_count ||
+                            stats.entry_count != entry_count ||
+                            stats.unused_count != unused_count,
+        done, ret, HG_FAULT,
+        "Cache stats (hits %" PRIu64 ", misses %" PRIu64
+        ", entries %" PRIu32 ", unused %" PRIu32 ") do not match expected "
+        "values (%" PRIu64 ", %" PRIu64 ", %" PRIu32 ", %" PRIu32 ")",
+        stats.hit_count, stats.miss_count, stats.entry_count,
+        stats.unused_count, hit_count, miss_count, entry_count, unused_count);
+    HG_TEST_CHECK_ERROR(stats.size != (hg_size_t) entry_count * CACHE_BUF_SIZE,
+        done, ret, HG_FAULT, "Cache holds %" PRIu64 " bytes", stats.size);
+
+done:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_test_bulk_cache(na_class_t *na_class)
+{
+    struct hg_init_info hg_init_info = HG_INIT_INFO_INITIALIZER;
+    hg_class_t *hg_class = NULL;
+    hg_bulk_t bulk_handles[CACHE_BUF_COUNT + 1];
+    char *bufs[CACHE_BUF_COUNT] = {NULL};
+    hg_size_t buf_size = CACHE_BUF_SIZE;
+    hg_return_t ret = HG_SUCCESS, cleanup_ret;
+    unsigned int i;
+
+    for (i = 0; i < CACHE_BUF_COUNT + 1; i++)
+        bulk_handles[i] = HG_BULK_NULL;
+
+    /* Use a separate class on the same NA class to enable the cache */
+    hg_init_info.na_class = na_class;
+    hg_init_info.bulk_cache_size = 2 * CACHE_BUF_SIZE;
+    hg_class = HG_Init_opt(NULL, HG_FALSE, &hg_init_info);
+    HG_TEST_CHECK_ERROR(
+        hg_class == NULL, done, ret, HG_FAULT, "HG_Init_opt() failed");
+
+    for (i = 0; i < CACHE_BUF_COUNT; i++) {
+        bufs[i] = malloc(CACHE_BUF_SIZE);
+        HG_TEST_CHECK_ERROR(bufs[i] == NULL, done, ret, HG_NOMEM_ERROR,
+            "Could not allocate buffer");
+    }
+
+    /* Registering the same buffer again is a hit */
+    ret = HG_Bulk_create(hg_class, 1, (void **) &bufs[0], &buf_size,
+        HG_BULK_READWRITE, &bulk_handles[0]);
+    HG_TEST_CHECK_HG_ERROR(
+        done, ret, "HG_Bulk_create() failed (%s)", HG_Error_to_string(ret));
+    ret = HG_Bulk_create(hg_class, 1, (void **) &bufs[0], &buf_size,
+        HG_BULK_READWRITE, &bulk_handles[1]);
+    HG_TEST_CHECK_HG_ERROR(
+        done, ret, "HG_Bulk_create() failed (%s)", HG_Error_to_string(ret));
+    ret = hg_test_bulk_cache_check(hg_class, 1, 1, 1, 0);
+    HG_TEST_CHECK_HG_ERROR(done, ret, "Second registration was not a hit");
+
+    /* Registration is kept once it is no longer used */
+    for (i = 0; i < 2; i++) {
+        ret = HG_Bulk_free(bulk_handles[i]);
+        bulk_handles[i] = HG_BULK_NULL;
+        HG_TEST_CHECK_HG_ERROR(
+            done, ret, "HG_Bulk_free() failed (%s)", HG_Error_to_string(ret));
+    }
+    ret = hg_test_bulk_cache_check(hg_class, 1, 1, 1, 1);
+    HG_TEST_CHECK_HG_ERROR(done, ret, "Registration was not kept");
+
+    /* Invalidating an entry that is in use defers its release */
+    ret = HG_Bulk_create(hg_class, 1, (void **) &bufs[0], &buf_size,
+        HG_BULK_READWRITE, &bulk_handles[0]);
+    HG_TEST_CHECK_HG_ERROR(
+        done, ret, "HG_Bulk_create() failed (%s)", HG_Error_to_string(ret));
+    ret = HG_Bulk_cache_invalidate(hg_class, bufs[0], CACHE_BUF_SIZE);
+    HG_TEST_CHECK_HG_ERROR(done, ret, "HG_Bulk_cache_invalidate() failed (%s)",
+        HG_Error_to_string(ret));
+    ret = hg_test_bulk_cache_check(hg_class, 2, 1, 1, 0);
+    HG_TEST_CHECK_HG_ERROR(done, ret, "Entry in use was released");
+
+    /* Invalidated entry can no longer be found, range is registered again */
+    ret = HG_Bulk_create(hg_class, 1, (void **) &bufs[0], &buf_size,
+        HG_BULK_READWRITE, &bulk_handles[1]);
+    HG_TEST_CHECK_HG_ERROR(
+        done, ret, "HG_Bulk_create() failed (%s)", HG_Error_to_string(ret));
+    ret = hg_test_bulk_cache_check(hg_class, 2, 2, 2, 0);
+    HG_TEST_CHECK_HG_ERROR(done, ret, "Invalidated entry was found");
+
+    /* Invalidated entry is released with its last handle */
+    ret = HG_Bulk_free(bulk_handles[0]);
+    bulk_handles[0] = HG_BULK_NULL;
+    HG_TEST_CHECK_HG_ERROR(
+        done, ret, "HG_Bulk_free() failed (%s)", HG_Error_to_string(ret));
+    ret = hg_test_bulk_cache_check(hg_class, 2, 2, 1, 0);
+    HG_TEST_CHECK_HG_ERROR(done, ret, "Invalidated entry was not released");
+
+    ret = HG_Bulk_free(bulk_handles[1]);
+    bulk_handles[1] = HG_BULK_NULL;
+    HG_TEST_CHECK_HG_ERROR(
+        done, ret, "HG_Bulk_free() failed (%s)", HG_Error_to_string(ret));
+    ret = HG_Bulk_create(hg_class, 1, (void **) &bufs[0], &buf_size,
+        HG_BULK_READWRITE, &bulk_handles[0]);
+    HG_TEST_CHECK_HG_ERROR(
+        done, ret, "HG_Bulk_create() failed (%s)", HG_Error_to_string(ret));
+    ret = hg_test_bulk_cache_check(hg_class, 3, 2, 1, 0);
+    HG_TEST_CHECK_HG_ERROR(done, ret, "New registration was not cached");
+
+    /* Least recently used registrations are released when cache is full */
+    for (i = 1; i < CACHE_BUF_COUNT; i++) {
+        ret = HG_Bulk_create(hg_class, 1, (void **) &bufs[i], &buf_size,
+            HG_BULK_READWRITE, &bulk_handles[i]);
+        HG_TEST_CHECK_HG_ERROR(done, ret, "HG_Bulk_create() failed (%s)",
+            HG_Error_to_string(ret));
+    }
+    for (i = 0; i < CACHE_BUF_COUNT; i++) {
+        ret = HG_Bulk_free(bulk_handles[i]);
+        bulk_handles[i] = HG_BULK_NULL;
+        HG_TEST_CHECK_HG_ERROR(
+            done, ret, "HG_Bulk_free() failed (%s)", HG_Error_to_string(ret));
+    }
+    ret = hg_test_bulk_cache_check(hg_class, 3, 4, 2, 2);
+    HG_TEST_CHECK_HG_ERROR(done, ret, "Cache exceeds its max size");
+
+    ret = HG_Bulk_create(hg_class, 1, (void **) &bufs[0], &buf_size,
+        HG_BULK_READWRITE, &bulk_handles[0]);
+    HG_TEST_CHECK_HG_ERROR(
+        done, ret, "HG_Bulk_create() failed (%s)", HG_Error_to_string(ret));
+    ret = hg_test_bulk_cache_check(hg_class, 3, 5, 2, 1);
+    HG_TEST_CHECK_HG_ERROR(done, ret, "Least recently used entry was kept");
+
+done:
+    for (i = 0; i < CACHE_BUF_COUNT + 1; i++) {
+        cleanup_ret = HG_Bulk_free(bulk_handles[i]);
+        HG_TEST_CHECK_ERROR_DONE(cleanup_ret != HG_SUCCESS,
+            "HG_Bulk_free() failed (%s)", HG_Error_to_string(cleanup_ret));
+    }
+
+    /* Cached registrations must be released before memory is freed */
+    for (i = 0; i < CACHE_BUF_COUNT; i++) {
+        if (hg_class != NULL && bufs[i] != NULL)
+            HG_Bulk_cache_invalidate(hg_class, bufs[i], CACHE_BUF_SIZE);
+        free(bufs[i]);
+    }
+
+    if (hg_class != NULL) {
+        cleanup_ret = HG_Finalize(hg_class);
+        HG_TEST_CHECK_ERROR_DONE(cleanup_ret != HG_SUCCESS,
+            "HG_Finalize() failed (%s)", HG_Error_to_string(cleanup_ret));
+    }
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_test_bulk_alloc(na_class_t *na_class)
+{
+    struct hg_init_info hg_init_info = HG_INIT_INFO_INITIALIZER;
+    hg_class_t *hg_class = NULL;
+    hg_bulk_t bulk_handle = HG_BULK_NULL;
+    hg_size_t lens[ALLOC_SEG_COUNT] = {100, 5000, 64};
+    void *bufs[ALLOC_SEG_COUNT];
+    hg_size_t buf_sizes[ALLOC_SEG_COUNT];
+    hg_uint32_t actual_count = 0, i;
+    hg_return_t ret = HG_SUCCESS, cleanup_ret;
+    hg_size_t j;
+
+    /* Use a separate class on the same NA class to allocate from NA */
+    hg_init_info.na_class = na_class;
+    hg_init_info.bulk_alloc_na = HG_TRUE;
+    hg_class = HG_Init_opt(NULL, HG_FALSE, &hg_init_info);
+    HG_TEST_CHECK_ERROR(
+        hg_class == NULL, done, ret, HG_FAULT, "HG_Init_opt() failed");
+
+    ret = HG_Bulk_create(
+        hg_class, ALLOC_SEG_COUNT, NULL, lens, HG_BULK_READWRITE, &bulk_handle);
+    HG_TEST_CHECK_HG_ERROR(
+        done, ret, "HG_Bulk_create() failed (%s)", HG_Error_to_string(ret));
+    ret = HG_Bulk_access(bulk_handle, 0, HG_Bulk_get_size(bulk_handle),
+        HG_BULK_READWRITE, ALLOC_SEG_COUNT, bufs, buf_sizes, &actual_count);
+    HG_TEST_CHECK_HG_ERROR(
+        done, ret, "HG_Bulk_access() failed (%s)", HG_Error_to_string(ret));
+    HG_TEST_CHECK_ERROR(actual_count != ALLOC_SEG_COUNT, done, ret, HG_FAULT,
+        "Accessed %" PRIu32 " segments", actual_count);
+
+    /* Segments are zeroed and carved from one allocation without overlap */
+    for (i = 0; i < ALLOC_SEG_COUNT; i++) {
+        HG_TEST_CHECK_ERROR(buf_sizes[i] != lens[i], done, ret, HG_FAULT,
+            "Segment %" PRIu32 " has size %" PRIu64, i, buf_sizes[i]);
+        HG_TEST_CHECK_ERROR((uintptr_t) bufs[i] % HG_MEM_CACHE_LINE_SIZE,
+            done, ret, HG_FAULT, "Segment %" PRIu32 " is not aligned", i);
+        for (j = 0; j < lens[i]; j++)
+            HG_TEST_CHECK_ERROR(((char *) bufs[i])[j] != 0, done, ret,
+                HG_FAULT, "Segment %" PRIu32 " is not zeroed", i);
+        memset(bufs[i], (int) i + 1, lens[i]);
+    }
+    for (i = 0; i < ALLOC_SEG_COUNT; i++)
+        for (j = 0; j < lens[i]; j++)
+            HG_TEST_CHECK_ERROR(((char *) bufs[i])[j] != (char) (i + 1), done,
+                ret, HG_FAULT, "Segment %" PRIu32 " overlaps", i);
+
+done:
+    cleanup_ret = HG_Bulk_free(bulk_handle);
+    HG_TEST_CHECK_ERROR_DONE(cleanup_ret != HG_SUCCESS,
+        "HG_Bulk_free() failed (%s)", HG_Error_to_string(cleanup_ret));
+
+    if (hg_class != NULL) {
+        cleanup_ret = HG_Finalize(hg_class);
+        HG_TEST_CHECK_ERROR_DONE(cleanup_ret != HG_SUCCESS,
+            "HG_Finalize() failed (%s)", HG_Error_to_string(cleanup_ret));
+    }
+
+    return ret;
+}
+
 /*---------------------------------------------------------------------------*/
 int
 main(int argc, char *argv[])
@@ -622,6 +947,45 @@ main(int argc, char *argv[])
         HG_PASSED();
     }
 
+    /* Chunked transfer tests */
+    HG_TEST("chunked RPC bulk (size BUFSIZE, chunks BUFSIZE/8)");
+    hg_ret = hg_test_bulk_chunked(hg_test_info.hg_class, hg_test_info.context,
+        hg_test_info.request_class, hg_test_info.target_addr, buf_size,
+        buf_size / 8, 2, 0);
+    HG_TEST_CHECK_ERROR(hg_ret != HG_SUCCESS, done, ret, EXIT_FAILURE,
+        "chunked RPC bulk failed");
+    HG_PASSED();
+
+    HG_TEST("chunked RPC bulk (size BUFSIZE - 1, chunks BUFSIZE/8)");
+    hg_ret = hg_test_bulk_chunked(hg_test_info.hg_class, hg_test_info.context,
+        hg_test_info.request_class, hg_test_info.target_addr, buf_size - 1,
+        buf_size / 8, 3, 0);
+    HG_TEST_CHECK_ERROR(hg_ret != HG_SUCCESS, done, ret, EXIT_FAILURE,
+        "chunked RPC bulk failed");
+    HG_PASSED();
+
+    HG_TEST("canceled chunked RPC bulk (size BUFSIZE, chunks BUFSIZE/8)");
+    hg_ret = hg_test_bulk_chunked(hg_test_info.hg_class, hg_test_info.context,
+        hg_test_info.request_class, hg_test_info.target_addr, buf_size,
+        buf_size / 8, 1, buf_size / 4);
+    HG_TEST_CHECK_ERROR(hg_ret != HG_SUCCESS, done, ret, EXIT_FAILURE,
+        "canceled chunked RPC bulk failed");
+    HG_PASSED();
+
+    /* Registration cache test */
+    HG_TEST("bulk registration cache");
+    hg_ret = hg_test_bulk_cache(hg_test_info.na_test_info.na_class);
+    HG_TEST_CHECK_ERROR(hg_ret != HG_SUCCESS, done, ret, EXIT_FAILURE,
+        "bulk registration cache failed");
+    HG_PASSED();
+
+    /* Internal allocation test */
+    HG_TEST("bulk memory allocated from NA");
+    hg_ret = hg_test_bulk_alloc(hg_test_info.na_test_info.na_class);
+    HG_TEST_CHECK_ERROR(hg_ret != HG_SUCCESS, done, ret, EXIT_FAILURE,
+        "bulk memory allocated from NA failed");
+    HG_PASSED();
+
 done:
     if (ret != EXIT_SUCCESS)
         HG_FAILED();
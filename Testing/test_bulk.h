@@ -20,6 +20,9 @@ MERCURY_GEN_PROC(bulk_write_in_t,
     ((hg_int32_t)(fildes))((hg_size_t)(transfer_size))((hg_size_t)(
         origin_offset))((hg_size_t)(target_offset))((hg_bulk_t)(bulk_handle)))
 MERCURY_GEN_PROC(bulk_write_out_t, ((hg_size_t)(ret)))
+MERCURY_GEN_PROC(bulk_chunked_write_in_t,
+    ((hg_size_t)(transfer_size))((hg_size_t)(chunk_size))((hg_uint32_t)(
+        max_in_flight))((hg_size_t)(cancel_size))((hg_bulk_t)(bulk_handle)))
 #else
 /* Define bulk_write_in_t */
 typedef struct {
@@ -78,6 +81,45 @@ hg_proc_bulk_write_out_t(hg_proc_t proc, void *data)
 
     return ret;
 }
+
+/* Define bulk_chunked_write_in_t */
+typedef struct {
+    hg_size_t transfer_size;
+    hg_size_t chunk_size;
+    hg_uint32_t max_in_flight;
+    hg_size_t cancel_size;
+    hg_bulk_t bulk_handle;
+} bulk_chunked_write_in_t;
+
+/* Define hg_proc_bulk_chunked_write_in_t */
+static HG_INLINE hg_return_t
+hg_proc_bulk_chunked_write_in_t(hg_proc_t proc, void *data)
+{
+    hg_return_t ret = HG_SUCCESS;
+    bulk_chunked_write_in_t *struct_data = (bulk_chunked_write_in_t *) data;
+
+    ret = hg_proc_hg_size_t(proc, &struct_data->transfer_size);
+    if (ret != HG_SUCCESS)
+        return ret;
+
+    ret = hg_proc_hg_size_t(proc, &struct_data->chunk_size);
+    if (ret != HG_SUCCESS)
+        return ret;
+
+    ret = hg_proc_hg_uint32_t(proc, &struct_data->max_in_flight);
+    if (ret != HG_SUCCESS)
+        return ret;
+
+    ret = hg_proc_hg_size_t(proc, &struct_data->cancel_size);
+    if (ret != HG_SUCCESS)
+        return ret;
+
+    ret = hg_proc_hg_bulk_t(proc, &struct_data->bulk_handle);
+    if (ret != HG_SUCCESS)
+        return ret;
+
+    return ret;
+}
 #endif
 
 #endif /* TEST_BULK_H */
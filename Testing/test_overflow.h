@@ -14,6 +14,10 @@
 
 MERCURY_GEN_PROC(
     overflow_out_t, ((hg_string_t)(string))((hg_uint64_t)(string_len)))
+MERCURY_GEN_PROC(view_in_t, ((hg_string_t)(string))((hg_bytes_view_t)(bytes)))
+MERCURY_GEN_PROC(view_out_t,
+    ((hg_uint64_t)(string_len))((hg_uint64_t)(bytes_size))(
+        (hg_uint8_t)(in_place)))
 #else
 /* Define overflow_out_t */
 typedef struct {
@@ -38,6 +42,59 @@ hg_proc_overflow_out_t(hg_proc_t proc, void *data)
 
     return ret;
 }
+
+/* Define view_in_t */
+typedef struct {
+    hg_string_t string;
+    hg_bytes_view_t bytes;
+} view_in_t;
+
+/* Define hg_proc_view_in_t */
+static HG_INLINE hg_return_t
+hg_proc_view_in_t(hg_proc_t proc, void *data)
+{
+    hg_return_t ret = HG_SUCCESS;
+    view_in_t *struct_data = (view_in_t *) data;
+
+    ret = hg_proc_hg_string_t(proc, &struct_data->string);
+    if (ret != HG_SUCCESS)
+        return ret;
+
+    ret = hg_proc_hg_bytes_view_t(proc, &struct_data->bytes);
+    if (ret != HG_SUCCESS)
+        return ret;
+
+    return ret;
+}
+
+/* Define view_out_t */
+typedef struct {
+    hg_uint64_t string_len;
+    hg_uint64_t bytes_size;
+    hg_uint8_t in_place;
+} view_out_t;
+
+/* Define hg_proc_view_out_t */
+static HG_INLINE hg_return_t
+hg_proc_view_out_t(hg_proc_t proc, void *data)
+{
+    hg_return_t ret = HG_SUCCESS;
+    view_out_t *struct_data = (view_out_t *) data;
+
+    ret = hg_proc_hg_uint64_t(proc, &struct_data->string_len);
+    if (ret != HG_SUCCESS)
+        return ret;
+
+    ret = hg_proc_hg_uint64_t(proc, &struct_data->bytes_size);
+    if (ret != HG_SUCCESS)
+        return ret;
+
+    ret = hg_proc_hg_uint8_t(proc, &struct_data->in_place);
+    if (ret != HG_SUCCESS)
+        return ret;
+
+    return ret;
+}
 #endif
 
 #endif /* TEST_OVERFLOW_H */
@@ -0,0 +1,801 @@
+/**
+ * Copyright (c) 2013-2021 UChicago Argonne, LLC and The HDF Group.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "mercury_atomic.h"
+#include "mercury_test.h"
+#include "mercury_thread.h"
+#include "mercury_time.h"
+
+#include <string.h>
+
+/****************/
+/* Local Macros */
+/****************/
+
+#define BENCHMARK_NAME "HG perf"
+#define STRING(s)      #s
+#define XSTRING(s)     STRING(s)
+#define VERSION_NAME                                                           \
+    XSTRING(HG_VERSION_MAJOR)                                                  \
+    "." XSTRING(HG_VERSION_MINOR) "." XSTRING(HG_VERSION_PATCH)
+
+/* Number of operations per thread and per loop (use -l to increase) */
+#define LAT_COUNT      100
+#define RATE_COUNT     1000
+#define BW_COUNT_SMALL 100
+#define BW_COUNT_LARGE 10
+#define WARMUP_COUNT   10
+#define LARGE_SIZE     8192
+
+/* Progress timeout (ms) */
+#define PROGRESS_TIMEOUT 100
+
+#define NDIGITS 2
+#define NWIDTH  12
+
+/************************************/
+/* Local Type and Struct Definition */
+/************************************/
+
+/* Parameters of a single run */
+struct hg_test_perf_params {
+    hg_id_t rpc_id;         /* RPC ID to forward */
+    void *in_struct;        /* Input struct (shared by all RPCs) */
+    unsigned int threads;   /* Number of client threads */
+    unsigned int in_flight; /* Number of in-flight RPCs per thread */
+    unsigned int op_count;  /* Number of RPCs per thread */
+    hg_bool_t get_output;   /* Decode output */
+    hg_bool_t keep_samples; /* Record latency of each RPC */
+};
+
+/* Aggregated result of a run */
+struct hg_test_perf_result {
+    const char *type;       /* "latency", "rate", "write_bw", "read_bw" */
+    unsigned int threads;   /* Number of client threads */
+    unsigned int in_flight; /* Number of in-flight RPCs per thread */
+    size_t size;            /* Payload size */
+    size_t count;           /* Total number of RPCs */
+    double elapsed;         /* Elapsed time (s) */
+    double lat_avg;         /* Latency percentiles (us) */
+    double lat_min;
+    double lat_p50;
+    double lat_p99;
+    double lat_p999;
+    double lat_max;
+};
+
+/* Output */
+struct hg_test_perf_output {
+    FILE *json;        /* JSON output (NULL if none) */
+    hg_bool_t first;   /* First result written */
+    hg_bool_t verbose; /* Print human-readable results */
+};
+
+struct hg_test_perf_thread;
+
+/* In-flight RPC */
+struct hg_test_perf_op {
+    struct hg_test_perf_thread *thread; /* Thread owning the RPC */
+    hg_handle_t handle;                 /* RPC handle */
+    hg_time_t start;                    /* Time RPC was forwarded */
+};
+
+/* Client thread */
+struct hg_test_perf_thread {
+    const struct hg_test_perf_params *params; /* Run parameters */
+    hg_atomic_int32_t *ready;                 /* Threads ready to start */
+    hg_atomic_int32_t *start;                 /* Start flag */
+    hg_context_t *context;                    /* Context owned by thread */
+    struct hg_test_perf_op *ops;              /* In-flight RPCs */
+    double *samples;                          /* Latency samples (us) */
+    unsigned int timeout;                     /* Progress timeout (ms) */
+    hg_thread_t thread;                       /* Thread */
+    hg_atomic_int32_t posted;                 /* RPCs posted */
+    hg_atomic_int32_t completed;              /* RPCs completed */
+    hg_atomic_int32_t failed;                 /* Error occurred */
+};
+
+/********************/
+/* Local Prototypes */
+/********************/
+
+static hg_return_t
+hg_test_perf_forward_cb(const struct hg_cb_info *callback_info);
+
+static HG_THREAD_RETURN_TYPE
+hg_test_perf_thread(void *arg);
+
+static hg_return_t
+hg_test_perf_run(struct hg_test_info *hg_test_info,
+    const struct hg_test_perf_params *params, double *elapsed,
+    double **samples_p);
+
+static int
+hg_test_perf_cmp(const void *a, const void *b);
+
+static size_t
+hg_test_perf_rank(size_t count, double percentile);
+
+static void
+hg_test_perf_lat_stats(
+    double *samples, size_t count, struct hg_test_perf_result *result);
+
+static void
+hg_test_perf_print(struct hg_test_perf_output *output,
+    const struct hg_test_perf_result *result);
+
+static hg_return_t
+measure_latency(struct hg_test_info *hg_test_info,
+    struct hg_test_perf_output *output, unsigned int threads);
+
+static hg_return_t
+measure_rate(struct hg_test_info *hg_test_info,
+    struct hg_test_perf_output *output, unsigned int threads);
+
+static hg_return_t
+measure_bandwidth(struct hg_test_info *hg_test_info,
+    struct hg_test_perf_output *output, unsigned int threads,
+    hg_bool_t write);
+
+/*******************/
+/* Local Variables */
+/*******************/
+
+extern hg_id_t hg_test_perf_rpc_id_g;
+extern hg_id_t hg_test_perf_rpc_lat_id_g;
+extern hg_id_t hg_test_perf_rpc_lat_bi_id_g;
+extern hg_id_t hg_test_perf_bulk_write_id_g;
+extern hg_id_t hg_test_perf_bulk_read_id_g;
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_test_perf_forward_cb(const struct hg_cb_info *callback_info)
+{
+    struct hg_test_perf_op *op = (struct hg_test_perf_op *) callback_info->arg;
+    struct hg_test_perf_thread *thread = op->thread;
+    const struct hg_test_perf_params *params = thread->params;
+    hg_time_t now;
+    unsigned int idx;
+    hg_return_t ret = callback_info->ret;
+
+    HG_TEST_CHECK_HG_ERROR(
+        error, ret, "HG_Forward() failed (%s)", HG_Error_to_string(ret));
+
+    if (params->get_output) {
+        perf_rpc_lat_out_t out_struct = {NULL, 0};
+
+        /* Get output struct */
+        ret = HG_Get_output(callback_info->info.forward.handle, &out_struct);
+        HG_TEST_CHECK_HG_ERROR(
+            error, ret, "HG_Get_output() failed (%s)", HG_Error_to_string(ret));
+
+        /* Free output struct */
+        ret = HG_Free_output(callback_info->info.forward.handle, &out_struct);
+        HG_TEST_CHECK_HG_ERROR(error, ret, "HG_Free_output() failed (%s)",
+            HG_Error_to_string(ret));
+    }
+
+    hg_time_get_current(&now);
+    idx = (unsigned int) hg_atomic_incr32(&thread->completed) - 1;
+    if (thread->samples)
+        thread->samples[idx] =
+            hg_time_to_double(hg_time_subtract(now, op->start)) * 1.0e6;
+
+    /* Keep the pipeline full, the handle can be re-used from its callback */
+    if ((unsigned int) hg_atomic_incr32(&thread->posted) <= params->op_count) {
+        op->start = now;
+        ret = HG_Forward(
+            op->handle, hg_test_perf_forward_cb, op, params->in_struct);
+        HG_TEST_CHECK_HG_ERROR(
+            error, ret, "HG_Forward() failed (%s)", HG_Error_to_string(ret));
+    }
+
+    return HG_SUCCESS;
+
+error:
+    hg_atomic_set32(&thread->failed, 1);
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static HG_THREAD_RETURN_TYPE
+hg_test_perf_thread(void *arg)
+{
+    struct hg_test_perf_thread *thread = (struct hg_test_perf_thread *) arg;
+    const struct hg_test_perf_params *params = thread->params;
+    hg_thread_ret_t tret = (hg_thread_ret_t) 0;
+    unsigned int i;
+    hg_return_t ret;
+
+    /* Wait for all threads to be ready */
+    hg_atomic_incr32(thread->ready);
+    while (!hg_atomic_get32(thread->start))
+        hg_thread_yield();
+
+    /* Post initial window of RPCs */
+    for (i = 0; i < params->in_flight && i < params->op_count; i++) {
+        struct hg_test_perf_op *op = &thread->ops[i];
+
+        hg_atomic_incr32(&thread->posted);
+        hg_time_get_current(&op->start);
+again:
+        ret = HG_Forward(
+            op->handle, hg_test_perf_forward_cb, op, params->in_struct);
+        if (ret == HG_AGAIN) {
+            ret = HG_Progress(thread->context, 0);
+            HG_TEST_CHECK_ERROR_NORET(ret != HG_SUCCESS && ret != HG_TIMEOUT,
+                error, "HG_Progress() failed (%s)", HG_Error_to_string(ret));
+            goto again;
+        }
+        HG_TEST_CHECK_HG_ERROR(
+            error, ret, "HG_Forward() failed (%s)", HG_Error_to_string(ret));
+    }
+
+    /* Make progress until all RPCs have completed, the context is not shared
+     * so only callbacks of this thread are triggered */
+    while ((unsigned int) hg_atomic_get32(&thread->completed) <
+               params->op_count &&
+           !hg_atomic_get32(&thread->failed)) {
+        unsigned int actual_count = 0;
+
+        do {
+            ret = HG_Trigger(thread->context, 0, 1, &actual_count);
+        } while ((ret == HG_SUCCESS) && actual_count);
+        HG_TEST_CHECK_ERROR_NORET(ret != HG_SUCCESS && ret != HG_TIMEOUT, error,
+            "HG_Trigger() failed (%s)", HG_Error_to_string(ret));
+
+        if ((unsigned int) hg_atomic_get32(&thread->completed) >=
+            params->op_count)
+            break;
+
+        ret = HG_Progress(thread->context, thread->timeout);
+        HG_TEST_CHECK_ERROR_NORET(ret != HG_SUCCESS && ret != HG_TIMEOUT,
+            error, "HG_Progress() failed (%s)", HG_Error_to_string(ret));
+    }
+
+    hg_thread_exit(tret);
+    return tret;
+
+error:
+    hg_atomic_set32(&thread->failed, 1);
+
+    hg_thread_exit(tret);
+    return tret;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_test_perf_run(struct hg_test_info *hg_test_info,
+    const struct hg_test_perf_params *params, double *elapsed,
+    double **samples_p)
+{
+    struct hg_test_perf_thread *threads = NULL;
+    double *samples = NULL;
+    hg_atomic_int32_t ready, start;
+    unsigned int target_count = hg_test_info->na_test_info.max_contexts
+                                    ? hg_test_info->na_test_info.max_contexts
+                                    : 1;
+    unsigned int i, j, started = 0;
+    hg_time_t t1, t2;
+    hg_return_t ret = HG_SUCCESS;
+
+    threads = (struct hg_test_perf_thread *) calloc(
+        params->threads, sizeof(*threads));
+    HG_TEST_CHECK_ERROR(threads == NULL, done, ret, HG_NOMEM_ERROR,
+        "Could not allocate threads");
+
+    if (params->keep_samples) {
+        samples = (double *) malloc(
+            (size_t) params->threads * params->op_count * sizeof(double));
+        HG_TEST_CHECK_ERROR(samples == NULL, done, ret, HG_NOMEM_ERROR,
+            "Could not allocate samples");
+    }
+
+    hg_atomic_init32(&ready, 0);
+    hg_atomic_init32(&start, 0);
+
+    /* Contexts cannot be progressed concurrently by multiple threads, thread i
+     * makes progress on its own context i and sends its RPCs round-robin to
+     * all target contexts */
+    for (i = 0; i < params->threads; i++) {
+        struct hg_test_perf_thread *thread = &threads[i];
+
+        thread->params = params;
+        thread->ready = &ready;
+        thread->start = &start;
+        thread->context = (i == 0) ? hg_test_info->context
+                                   : hg_test_info->secondary_contexts[i - 1];
+        thread->samples =
+            samples ? &samples[(size_t) i * params->op_count] : NULL;
+        thread->timeout =
+            hg_test_info->na_test_info.busy_wait ? 0 : PROGRESS_TIMEOUT;
+        hg_atomic_init32(&thread->posted, 0);
+        hg_atomic_init32(&thread->completed, 0);
+        hg_atomic_init32(&thread->failed, 0);
+
+        thread->ops = (struct hg_test_perf_op *) calloc(
+            params->in_flight, sizeof(*thread->ops));
+        HG_TEST_CHECK_ERROR(thread->ops == NULL, done, ret, HG_NOMEM_ERROR,
+            "Could not allocate ops");
+
+        for (j = 0; j < params->in_flight; j++) {
+            struct hg_test_perf_op *op = &thread->ops[j];
+
+            op->thread = thread;
+            ret = HG_Create(thread->context, hg_test_info->target_addr,
+                params->rpc_id, &op->handle);
+            HG_TEST_CHECK_HG_ERROR(
+                done, ret, "HG_Create() failed (%s)", HG_Error_to_string(ret));
+
+            if (target_count > 1) {
+                ret = HG_Set_target_id(op->handle,
+                    (hg_uint8_t) ((i * params->in_flight + j) % target_count));
+                HG_TEST_CHECK_HG_ERROR(done, ret,
+                    "HG_Set_target_id() failed (%s)", HG_Error_to_string(ret));
+            }
+        }
+    }
+
+    for (i = 0; i < params->threads; i++, started++) {
+        int rc = hg_thread_create(
+            &threads[i].thread, hg_test_perf_thread, &threads[i]);
+        HG_TEST_CHECK_ERROR(rc != HG_UTIL_SUCCESS, join, ret, HG_FAULT,
+            "hg_thread_create() failed");
+    }
+
+    while ((unsigned int) hg_atomic_get32(&ready) < params->threads)
+        hg_thread_yield();
+
+    hg_time_get_current(&t1);
+    hg_atomic_set32(&start, 1);
+
+join:
+    if (started < params->threads) /* Release threads that started */
+        hg_atomic_set32(&start, 1);
+    for (i = 0; i < started; i++)
+        hg_thread_join(threads[i].thread);
+    hg_time_get_current(&t2);
+    if (ret != HG_SUCCESS)
+        goto done;
+
+    for (i = 0; i < params->threads; i++)
+        HG_TEST_CHECK_ERROR(hg_atomic_get32(&threads[i].failed), done, ret,
+            HG_PROTOCOL_ERROR, "Thread %u failed", i);
+
+    *elapsed = hg_time_to_double(hg_time_subtract(t2, t1));
+    if (samples_p) {
+        *samples_p = samples;
+        samples = NULL;
+    }
+
+done:
+    if (threads) {
+        for (i = 0; i < params->threads; i++) {
+            if (threads[i].ops == NULL)
+                continue;
+            for (j = 0; j < params->in_flight; j++) {
+                hg_return_t rc;
+
+                if (threads[i].ops[j].handle == HG_HANDLE_NULL)
+                    continue;
+                rc = HG_Destroy(threads[i].ops[j].handle);
+                HG_TEST_CHECK_ERROR_DONE(rc != HG_SUCCESS,
+                    "HG_Destroy() failed (%s)", HG_Error_to_string(rc));
+            }
+            free(threads[i].ops);
+        }
+        free(threads);
+    }
+    free(samples);
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static int
+hg_test_perf_cmp(const void *a, const void *b)
+{
+    double x = *(const double *) a, y = *(const double *) b;
+
+    return (x > y) - (x < y);
+}
+
+/*---------------------------------------------------------------------------*/
+static size_t
+hg_test_perf_rank(size_t count, double percentile)
+{
+    double rank = percentile * (double) count;
+    size_t idx = (size_t) rank;
+
+    /* Nearest-rank method */
+    if ((double) idx < rank)
+        idx++;
+
+    return (idx > 0) ? idx - 1 : 0;
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+hg_test_perf_lat_stats(
+    double *samples, size_t count, struct hg_test_perf_result *result)
+{
+    double sum = 0;
+    size_t i;
+
+    qsort(samples, count, sizeof(double), hg_test_perf_cmp);
+    for (i = 0; i < count; i++)
+        sum += samples[i];
+
+    result->lat_avg = sum / (double) count;
+    result->lat_min = samples[0];
+    result->lat_p50 = samples[hg_test_perf_rank(count, 0.5)];
+    result->lat_p99 = samples[hg_test_perf_rank(count, 0.99)];
+    result->lat_p999 = samples[hg_test_perf_rank(count, 0.999)];
+    result->lat_max = samples[count - 1];
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+hg_test_perf_print(struct hg_test_perf_output *output,
+    const struct hg_test_perf_result *result)
+{
+    double rate = (double) result->count / result->elapsed;
+    double bw = (double) result->size * rate / (1024 * 1024);
+    hg_bool_t lat = (strcmp(result->type, "latency") == 0);
+    hg_bool_t rpc_rate = (strcmp(result->type, "rate") == 0);
+
+    if (output->verbose) {
+        if (lat)
+            fprintf(stdout, "%-*zu%*.*f%*.*f%*.*f%*.*f%*.*f\n", 10,
+                result->size, NWIDTH, NDIGITS, result->lat_avg, NWIDTH,
+                NDIGITS, result->lat_p50, NWIDTH, NDIGITS, result->lat_p99,
+                NWIDTH, NDIGITS, result->lat_p999, NWIDTH, NDIGITS,
+                result->lat_max);
+        else if (rpc_rate)
+            fprintf(stdout, "%-*u%*.*f\n", 10, result->in_flight, NWIDTH,
+                NDIGITS, rate);
+        else
+            fprintf(stdout, "%-*zu%*.*f%*.*f\n", 10, result->size, NWIDTH,
+                NDIGITS, bw, NWIDTH, NDIGITS, rate);
+        fflush(stdout);
+    }
+
+    if (output->json == NULL)
+        return;
+
+    fprintf(output->json,
+        "%s\n    {\"type\": \"%s\", \"threads\": %u, \"in_flight\": %u, "
+        "\"size\": %zu, \"count\": %zu, \"elapsed_s\": %.6f, "
+        "\"ops_per_sec\": %.2f",
+        output->first ? "" : ",", result->type, result->threads,
+        result->in_flight, result->size, result->count, result->elapsed, rate);
+    if (lat)
+        fprintf(output->json,
+            ", \"avg_us\": %.3f, \"min_us\": %.3f, \"p50_us\": %.3f, "
+            "\"p99_us\": %.3f, \"p999_us\": %.3f, \"max_us\": %.3f",
+            result->lat_avg, result->lat_min, result->lat_p50,
+            result->lat_p99, result->lat_p999, result->lat_max);
+    else if (!rpc_rate)
+        fprintf(output->json, ", \"mb_per_sec\": %.2f", bw);
+    fprintf(output->json, "}");
+    fflush(output->json);
+    output->first = HG_FALSE;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+measure_latency(struct hg_test_info *hg_test_info,
+    struct hg_test_perf_output *output, unsigned int threads)
+{
+    perf_rpc_lat_in_t in_struct = {NULL, 0};
+    struct hg_test_perf_params params;
+    struct hg_test_perf_result result;
+    hg_size_t size_max = HG_Class_get_input_eager_size(hg_test_info->hg_class);
+    double *samples = NULL;
+    char *buf = NULL;
+    size_t size, i;
+    hg_return_t ret = HG_SUCCESS;
+
+    /* Latency is measured for sizes that fit into eager messages */
+    if (size_max > sizeof(in_struct.buf_size))
+        size_max -= sizeof(in_struct.buf_size);
+    if (size_max > hg_test_info->buf_size_max)
+        size_max = hg_test_info->buf_size_max;
+
+    buf = malloc(size_max);
+    HG_TEST_CHECK_ERROR(
+        buf == NULL, done, ret, HG_NOMEM_ERROR, "Could not allocate buf");
+    for (i = 0; i < size_max; i++)
+        buf[i] = (char) i;
+    in_struct.buf = buf;
+
+    if (output->verbose) {
+        fprintf(stdout, "# Latency with %u thread(s)\n", threads);
+        fprintf(stdout, "%-*s%*s%*s%*s%*s%*s\n", 10, "# Size", NWIDTH,
+            "Avg (us)", NWIDTH, "p50 (us)", NWIDTH, "p99 (us)", NWIDTH,
+            "p999 (us)", NWIDTH, "Max (us)");
+    }
+
+    params.threads = threads;
+    params.in_flight = 1;
+    params.in_struct = &in_struct;
+
+    /* NULL RPC first, then doubling payload sizes */
+    for (size = 0; size <= size_max;
+         size = (size == 0) ? MAX(hg_test_info->buf_size_min, 1) : size * 2) {
+        in_struct.buf_size = (hg_uint32_t) size;
+        params.get_output = (size > 0 && hg_test_info->bidirectional);
+        if (size == 0)
+            params.rpc_id = hg_test_perf_rpc_id_g;
+        else if (hg_test_info->bidirectional)
+            params.rpc_id = hg_test_perf_rpc_lat_bi_id_g;
+        else
+            params.rpc_id = hg_test_perf_rpc_lat_id_g;
+
+        /* Warm up */
+        params.op_count = WARMUP_COUNT;
+        params.keep_samples = HG_FALSE;
+        ret = hg_test_perf_run(hg_test_info, &params, &result.elapsed, NULL);
+        HG_TEST_CHECK_HG_ERROR(done, ret, "hg_test_perf_run() failed (%s)",
+            HG_Error_to_string(ret));
+
+        NA_Test_barrier(&hg_test_info->na_test_info);
+
+        params.op_count =
+            LAT_COUNT * (unsigned int) hg_test_info->na_test_info.loop;
+        params.keep_samples = HG_TRUE;
+        ret =
+            hg_test_perf_run(hg_test_info, &params, &result.elapsed, &samples);
+        HG_TEST_CHECK_HG_ERROR(done, ret, "hg_test_perf_run() failed (%s)",
+            HG_Error_to_string(ret));
+
+        result.type = "latency";
+        result.threads = threads;
+        result.in_flight = 1;
+        result.size = size;
+        result.count = (size_t) threads * params.op_count;
+        hg_test_perf_lat_stats(samples, result.count, &result);
+        free(samples);
+        samples = NULL;
+
+        if (hg_test_info->na_test_info.mpi_comm_rank == 0)
+            hg_test_perf_print(output, &result);
+    }
+
+done:
+    free(buf);
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+measure_rate(struct hg_test_info *hg_test_info,
+    struct hg_test_perf_output *output, unsigned int threads)
+{
+    struct hg_test_perf_params params;
+    struct hg_test_perf_result result;
+    unsigned int in_flight;
+    hg_return_t ret = HG_SUCCESS;
+
+    if (output->verbose) {
+        fprintf(stdout, "# NULL RPC rate with %u thread(s)\n", threads);
+        fprintf(stdout, "%-*s%*s\n", 10, "# In-flight", NWIDTH, "RPC/s");
+    }
+
+    params.rpc_id = hg_test_perf_rpc_id_g;
+    params.in_struct = NULL;
+    params.threads = threads;
+    params.get_output = HG_FALSE;
+    params.keep_samples = HG_FALSE;
+
+    for (in_flight = 1; in_flight <= hg_test_info->handle_max;
+         in_flight *= 2) {
+        params.in_flight = in_flight;
+
+        /* Warm up */
+        params.op_count = WARMUP_COUNT;
+        ret = hg_test_perf_run(hg_test_info, &params, &result.elapsed, NULL);
+        HG_TEST_CHECK_HG_ERROR(done, ret, "hg_test_perf_run() failed (%s)",
+            HG_Error_to_string(ret));
+
+        NA_Test_barrier(&hg_test_info->na_test_info);
+
+        params.op_count =
+            RATE_COUNT * (unsigned int) hg_test_info->na_test_info.loop;
+        ret = hg_test_perf_run(hg_test_info, &params, &result.elapsed, NULL);
+        HG_TEST_CHECK_HG_ERROR(done, ret, "hg_test_perf_run() failed (%s)",
+            HG_Error_to_string(ret));
+
+        result.type = "rate";
+        result.threads = threads;
+        result.in_flight = in_flight;
+        result.size = 0;
+        result.count = (size_t) threads * params.op_count;
+
+        if (hg_test_info->na_test_info.mpi_comm_rank == 0)
+            hg_test_perf_print(output, &result);
+    }
+
+done:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+measure_bandwidth(struct hg_test_info *hg_test_info,
+    struct hg_test_perf_output *output, unsigned int threads,
+    hg_bool_t write)
+{
+    bulk_write_in_t in_struct;
+    struct hg_test_perf_params params;
+    struct hg_test_perf_result result;
+    hg_bulk_t bulk_handle = HG_BULK_NULL;
+    char *buf = NULL;
+    size_t size, i;
+    hg_return_t ret = HG_SUCCESS;
+
+    /* All RPCs share the same buffer, content does not matter */
+    buf = malloc(hg_test_info->buf_size_max);
+    HG_TEST_CHECK_ERROR(
+        buf == NULL, done, ret, HG_NOMEM_ERROR, "Could not allocate buf");
+    for (i = 0; i < hg_test_info->buf_size_max; i++)
+        buf[i] = (char) i;
+
+    if (output->verbose) {
+        fprintf(stdout,
+            "# %s BW with %u thread(s), %u in-flight RPC(s)\n",
+            write ? "Write" : "Read", threads, hg_test_info->handle_max);
+        fprintf(stdout, "%-*s%*s%*s\n", 10, "# Size", NWIDTH, "MB/s", NWIDTH,
+            "op/s");
+    }
+
+    memset(&in_struct, 0, sizeof(in_struct));
+    params.rpc_id = write ? hg_test_perf_bulk_write_id_g
+                          : hg_test_perf_bulk_read_id_g;
+    params.in_struct = &in_struct;
+    params.threads = threads;
+    params.in_flight = hg_test_info->handle_max;
+    params.get_output = HG_FALSE;
+    params.keep_samples = HG_FALSE;
+
+    for (size = hg_test_info->buf_size_min; size <= hg_test_info->buf_size_max;
+         size *= 2) {
+        void *buf_ptr = buf;
+        hg_size_t buf_size = (hg_size_t) size;
+
+        ret = HG_Bulk_create(hg_test_info->hg_class, 1, &buf_ptr, &buf_size,
+            write ? HG_BULK_READ_ONLY : HG_BULK_READWRITE, &bulk_handle);
+        HG_TEST_CHECK_HG_ERROR(done, ret, "HG_Bulk_create() failed (%s)",
+            HG_Error_to_string(ret));
+        in_struct.bulk_handle = bulk_handle;
+
+        /* Warm up */
+        params.op_count = WARMUP_COUNT;
+        ret = hg_test_perf_run(hg_test_info, &params, &result.elapsed, NULL);
+        HG_TEST_CHECK_HG_ERROR(done, ret, "hg_test_perf_run() failed (%s)",
+            HG_Error_to_string(ret));
+
+        NA_Test_barrier(&hg_test_info->na_test_info);
+
+        params.op_count = ((size > LARGE_SIZE) ? BW_COUNT_LARGE
+                                               : BW_COUNT_SMALL) *
+                          (unsigned int) hg_test_info->na_test_info.loop;
+        ret = hg_test_perf_run(hg_test_info, &params, &result.elapsed, NULL);
+        HG_TEST_CHECK_HG_ERROR(done, ret, "hg_test_perf_run() failed (%s)",
+            HG_Error_to_string(ret));
+
+        ret = HG_Bulk_free(bulk_handle);
+        bulk_handle = HG_BULK_NULL;
+        HG_TEST_CHECK_HG_ERROR(
+            done, ret, "HG_Bulk_free() failed (%s)", HG_Error_to_string(ret));
+
+        result.type = write ? "write_bw" : "read_bw";
+        result.threads = threads;
+        result.in_flight = params.in_flight;
+        result.size = size;
+        result.count = (size_t) threads * params.op_count;
+
+        if (hg_test_info->na_test_info.mpi_comm_rank == 0)
+            hg_test_perf_print(output, &result);
+    }
+
+done:
+    if (bulk_handle != HG_BULK_NULL)
+        (void) HG_Bulk_free(bulk_handle);
+    free(buf);
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+int
+main(int argc, char *argv[])
+{
+    struct hg_test_info hg_test_info = {0};
+    struct hg_test_perf_output output = {NULL, HG_TRUE, HG_TRUE};
+    unsigned int threads, max_threads;
+    hg_return_t hg_ret;
+    int ret = EXIT_SUCCESS;
+
+    hg_ret = HG_Test_init(argc, argv, &hg_test_info);
+    HG_TEST_CHECK_ERROR(
+        hg_ret != HG_SUCCESS, done, ret, EXIT_FAILURE, "HG_Test_init() failed");
+
+    /* Each thread needs its own context (see -X) */
+    max_threads = hg_test_info.na_test_info.max_contexts
+                      ? hg_test_info.na_test_info.max_contexts
+                      : 1;
+    if (max_threads > hg_test_info.thread_count)
+        max_threads = hg_test_info.thread_count;
+
+    if (hg_test_info.na_test_info.mpi_comm_rank == 0) {
+        if (hg_test_info.json_path) {
+            if (strcmp(hg_test_info.json_path, "-") == 0) {
+                output.json = stdout;
+                output.verbose = HG_FALSE;
+            } else {
+                output.json = fopen(hg_test_info.json_path, "w");
+                HG_TEST_CHECK_ERROR(output.json == NULL, done, ret,
+                    EXIT_FAILURE, "Could not open %s", hg_test_info.json_path);
+            }
+            fprintf(output.json,
+                "{\n  \"benchmark\": \"%s\",\n  \"version\": \"%s\",\n"
+                "  \"comm\": \"%s\",\n  \"protocol\": \"%s\",\n"
+                "  \"busy_wait\": %s,\n  \"self_send\": %s,\n"
+                "  \"loop\": %d,\n  \"results\": [",
+                BENCHMARK_NAME, VERSION_NAME,
+                hg_test_info.na_test_info.comm
+                    ? hg_test_info.na_test_info.comm
+                    : "",
+                hg_test_info.na_test_info.protocol
+                    ? hg_test_info.na_test_info.protocol
+                    : "",
+                hg_test_info.na_test_info.busy_wait ? "true" : "false",
+                hg_test_info.na_test_info.self_send ? "true" : "false",
+                hg_test_info.na_test_info.loop);
+        }
+        if (output.verbose) {
+            fprintf(stdout, "# %s v%s\n", BENCHMARK_NAME, VERSION_NAME);
+            fprintf(stdout,
+                "# Up to %u thread(s), %u in-flight RPC(s), "
+                "sizes %" PRIu64 " to %" PRIu64 " byte(s)\n",
+                max_threads, hg_test_info.handle_max, hg_test_info.buf_size_min,
+                hg_test_info.buf_size_max);
+        }
+    }
+
+    for (threads = 1; threads <= max_threads; threads *= 2) {
+        hg_ret = measure_latency(&hg_test_info, &output, threads);
+        HG_TEST_CHECK_ERROR(hg_ret != HG_SUCCESS, done, ret, EXIT_FAILURE,
+            "measure_latency() failed");
+
+        hg_ret = measure_rate(&hg_test_info, &output, threads);
+        HG_TEST_CHECK_ERROR(hg_ret != HG_SUCCESS, done, ret, EXIT_FAILURE,
+            "measure_rate() failed");
+
+        hg_ret = measure_bandwidth(&hg_test_info, &output, threads, HG_TRUE);
+        HG_TEST_CHECK_ERROR(hg_ret != HG_SUCCESS, done, ret, EXIT_FAILURE,
+            "measure_bandwidth() failed");
+
+        hg_ret = measure_bandwidth(&hg_test_info, &output, threads, HG_FALSE);
+        HG_TEST_CHECK_ERROR(hg_ret != HG_SUCCESS, done, ret, EXIT_FAILURE,
+            "measure_bandwidth() failed");
+    }
+
+done:
+    if (output.json) {
+        fprintf(output.json, "\n  ]\n}\n");
+        if (output.json != stdout)
+            fclose(output.json);
+    }
+
+    hg_ret = HG_Test_finalize(&hg_test_info);
+    HG_TEST_CHECK_ERROR_DONE(hg_ret != HG_SUCCESS, "HG_Test_finalize() failed");
+
+    return ret;
+}
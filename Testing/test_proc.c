@@ -28,6 +28,11 @@ typedef struct {
     hg_const_string_t string;
 } hg_test_proc_string_t;
 
+typedef struct {
+    hg_string_t string;
+    hg_bytes_view_t bytes;
+} hg_test_proc_view_t;
+
 /********************/
 /* Local Prototypes */
 /********************/
@@ -70,6 +75,23 @@ hg_proc_hg_test_proc_string_t(hg_proc_t proc, void *data)
     return ret;
 }
 
+static hg_return_t
+hg_proc_hg_test_proc_view_t(hg_proc_t proc, void *data)
+{
+    hg_test_proc_view_t *struct_data = (hg_test_proc_view_t *) data;
+    hg_return_t ret = HG_SUCCESS;
+
+    ret = hg_proc_hg_string_t(proc, &struct_data->string);
+    if (ret != HG_SUCCESS)
+        return ret;
+
+    ret = hg_proc_hg_bytes_view_t(proc, &struct_data->bytes);
+    if (ret != HG_SUCCESS)
+        return ret;
+
+    return ret;
+}
+
 /*******************/
 /* Local Variables */
 /*******************/
@@ -224,6 +246,112 @@ done:
     return ret;
 }
 
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_test_proc_bytes_view(void)
+{
+    char string[] = "Hello", bytes[] = "Hello view";
+    hg_test_proc_view_t in = {string, {bytes, sizeof(bytes)}}, out;
+    hg_return_t ret;
+
+    /* Without HG_PROC_ZERO_COPY, views are copied like strings */
+    ret = hg_test_proc_generic(hg_proc_hg_test_proc_view_t, &in, &out);
+    HG_TEST_CHECK_HG_ERROR(done, ret, "hg_test_proc_generic() failed");
+
+    HG_TEST_CHECK_ERROR(out.bytes.size != in.bytes.size ||
+                            memcmp(out.bytes.data, bytes, sizeof(bytes)) != 0,
+        done, ret, HG_PROTOCOL_ERROR, "Encoded and decoded views do not match");
+    HG_TEST_CHECK_ERROR(strcmp(in.string, out.string) != 0, done, ret,
+        HG_PROTOCOL_ERROR,
+        "Encoded and decoded strings do not match (%s != %s)", in.string,
+        out.string);
+
+    ret = hg_test_proc_free(hg_proc_hg_test_proc_view_t, &out);
+    HG_TEST_CHECK_HG_ERROR(done, ret, "hg_test_proc_free() failed");
+    HG_TEST_CHECK_ERROR(out.bytes.data != NULL, done, ret, HG_PROTOCOL_ERROR,
+        "Decoded view was not freed");
+
+done:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+#ifndef HG_HAS_XDR
+static hg_return_t
+hg_test_proc_zero_copy(void)
+{
+    char string[] = "Hello", bytes[] = "Hello view";
+    hg_test_proc_view_t in = {string, {bytes, sizeof(bytes)}}, out;
+    hg_proc_t proc = HG_PROC_NULL;
+    char *buf = NULL;
+    size_t buf_size = (size_t) hg_mem_get_page_size();
+    hg_return_t ret;
+
+    ret = hg_proc_create((hg_class_t *) 1, HG_CRC32, &proc);
+    HG_TEST_CHECK_HG_ERROR(done, ret, "Cannot create HG proc");
+
+    buf = (char *) calloc(1, buf_size);
+    HG_TEST_CHECK_ERROR(
+        buf == NULL, done, ret, HG_NOMEM_ERROR, "Could not allocate buf");
+
+    ret = hg_proc_reset(proc, buf, buf_size, HG_ENCODE);
+    HG_TEST_CHECK_HG_ERROR(done, ret, "Could not reset proc");
+
+    ret = hg_proc_hg_test_proc_view_t(proc, &in);
+    HG_TEST_CHECK_HG_ERROR(done, ret, "Could not encode view struct");
+
+    ret = hg_proc_flush(proc);
+    HG_TEST_CHECK_HG_ERROR(done, ret, "Error in proc flush");
+
+    /* Decode in place */
+    ret = hg_proc_reset(proc, buf, buf_size, HG_DECODE);
+    HG_TEST_CHECK_HG_ERROR(done, ret, "Could not reset proc");
+    hg_proc_set_flags(proc, HG_PROC_ZERO_COPY);
+
+    ret = hg_proc_hg_test_proc_view_t(proc, &out);
+    HG_TEST_CHECK_HG_ERROR(done, ret, "Could not decode view struct");
+
+    ret = hg_proc_flush(proc);
+    HG_TEST_CHECK_HG_ERROR(done, ret, "Error in proc flush");
+
+    HG_TEST_CHECK_ERROR(out.string < buf || out.string >= buf + buf_size ||
+                            (char *) out.bytes.data < buf ||
+                            (char *) out.bytes.data >= buf + buf_size,
+        done, ret, HG_PROTOCOL_ERROR, "Data was not decoded in place");
+    HG_TEST_CHECK_ERROR(strcmp(in.string, out.string) != 0 ||
+                            out.bytes.size != in.bytes.size ||
+                            memcmp(out.bytes.data, bytes, sizeof(bytes)) != 0,
+        done, ret, HG_PROTOCOL_ERROR, "Encoded and decoded data do not match");
+
+    /* Free must not release data that points to the proc buffer */
+    ret = hg_proc_reset(proc, buf, buf_size, HG_FREE);
+    HG_TEST_CHECK_HG_ERROR(done, ret, "Could not reset proc");
+    hg_proc_set_flags(proc, HG_PROC_ZERO_COPY);
+
+    ret = hg_proc_hg_test_proc_view_t(proc, &out);
+    HG_TEST_CHECK_HG_ERROR(done, ret, "Could not free view struct");
+    HG_TEST_CHECK_ERROR(out.bytes.data != NULL, done, ret, HG_PROTOCOL_ERROR,
+        "Decoded view was not reset");
+
+    /* Data that does not fit into the buffer cannot be decoded in place */
+    ret = hg_proc_reset(proc, buf, sizeof(hg_uint64_t) + 4, HG_DECODE);
+    HG_TEST_CHECK_HG_ERROR(done, ret, "Could not reset proc");
+    hg_proc_set_flags(proc, HG_PROC_ZERO_COPY);
+
+    ret = hg_proc_hg_string_t(proc, &out.string);
+    HG_TEST_CHECK_ERROR(ret != HG_OVERFLOW, done, ret, HG_PROTOCOL_ERROR,
+        "Truncated string was decoded (%s)", HG_Error_to_string(ret));
+    ret = HG_SUCCESS;
+
+done:
+    if (proc != HG_PROC_NULL)
+        hg_proc_free(proc);
+    free(buf);
+
+    return ret;
+}
+#endif
+
 /*---------------------------------------------------------------------------*/
 int
 main(void)
@@ -245,6 +373,22 @@ main(void)
         "string proc test failed");
     HG_PASSED();
 
+    /* bytes view proc test */
+    HG_TEST("bytes view proc");
+    hg_ret = hg_test_proc_bytes_view();
+    HG_TEST_CHECK_ERROR(hg_ret != HG_SUCCESS, done, ret, EXIT_FAILURE,
+        "bytes view proc test failed");
+    HG_PASSED();
+
+#ifndef HG_HAS_XDR
+    /* zero copy proc test */
+    HG_TEST("zero copy proc");
+    hg_ret = hg_test_proc_zero_copy();
+    HG_TEST_CHECK_ERROR(hg_ret != HG_SUCCESS, done, ret, EXIT_FAILURE,
+        "zero copy proc test failed");
+    HG_PASSED();
+#endif
+
 done:
     if (ret != EXIT_SUCCESS)
         HG_FAILED();
@@ -6,12 +6,39 @@
 
 #include "mercury_test.h"
 
+#include "mercury_time.h"
+
 /****************/
 /* Local Macros */
 /****************/
 
 /* Do not use HG_TEST_MAX_HANDLES for that and keep it fixed */
 #define NINFLIGHT (16)
+#define NOVERFLOW (64)
+
+/* Time waited for posted requests to shrink when idle (in ms) */
+#define POST_IDLE_WAIT (5000)
+#define POST_IDLE_POLL (100)
+
+/* Number of RPCs held by target, more than one block of shared buffers */
+#define SHARED_BUF_COUNT (600)
+
+/* Number of self RPCs queued before triggering, more than the initial size of
+ * the completion queue so that it must grow */
+#define CQ_RPC_COUNT  (64)
+#define CQ_QUEUE_SIZE (2)
+#define CQ_TIMEOUT    (10000) /* ms */
+
+/* Number of self RPCs triggered per batch and RPCs whose forward callback
+ * returns an error (in order of completion) */
+#define TRIGGER_RPC_COUNT    (8)
+#define TRIGGER_FIRST_ERROR  (2)
+#define TRIGGER_SECOND_ERROR (5)
+
+/* Adaptive progress budget, long enough for a queued completion to always be
+ * seen while busy-polling */
+#define PROGRESS_SPIN_US (1000000)
+#define PROGRESS_TIMEOUT (100) /* ms */
 
 /************************************/
 /* Local Type and Struct Definition */
@@ -22,6 +49,37 @@ struct forward_cb_args {
     rpc_handle_t *rpc_handle;
 };
 
+struct overflow_cb_args {
+    hg_request_t *request;
+    hg_return_t ret;
+};
+
+struct view_cb_args {
+    hg_request_t *request;
+    hg_size_t size;      /* Size of string and bytes sent */
+    hg_uint8_t in_place; /* Whether target decoded input in place */
+    hg_return_t ret;
+};
+
+struct hold_cb_args {
+    hg_request_t *request;
+    hg_atomic_int32_t completed; /* Number of completed RPCs */
+    hg_uint32_t count;           /* Number of RPCs sent */
+    hg_uint8_t *received;        /* Whether each RPC got its response */
+    hg_return_t ret;
+};
+
+struct post_stats_cb_args {
+    hg_request_t *request;
+    rpc_post_stats_out_t *stats; /* Stats of target context */
+    hg_return_t ret;
+};
+
+struct trigger_cb_args {
+    unsigned int *triggered; /* Number of forward callbacks triggered */
+    hg_return_t ret;         /* Value returned by forward callback */
+};
+
 /********************/
 /* Local Prototypes */
 /********************/
@@ -37,6 +95,8 @@ hg_test_rpc_forward_reset_cb(const struct hg_cb_info *callback_info);
 #ifndef HG_HAS_XDR
 static hg_return_t
 hg_test_rpc_forward_overflow_cb(const struct hg_cb_info *callback_info);
+static hg_return_t
+hg_test_rpc_forward_view_cb(const struct hg_cb_info *callback_info);
 #endif
 
 static hg_return_t
@@ -58,10 +118,40 @@ hg_test_rpc_multiple(hg_context_t *context, hg_request_class_t *request_class,
 static hg_return_t
 hg_test_overflow(hg_context_t *context, hg_request_class_t *request_class,
     hg_addr_t addr, hg_id_t rpc_id, hg_cb_t callback);
+static hg_return_t
+hg_test_view(hg_context_t *context, hg_request_class_t *request_class,
+    hg_addr_t addr, hg_id_t rpc_id, hg_size_t size, hg_uint8_t in_place,
+    unsigned int count);
 #endif
 static hg_return_t
 hg_test_cancel_rpc(hg_context_t *context, hg_request_class_t *request_class,
     hg_addr_t addr, hg_id_t rpc_id, hg_cb_t callback);
+static hg_return_t
+hg_test_post_stats(hg_context_t *context, hg_request_class_t *request_class,
+    hg_addr_t addr, rpc_post_stats_out_t *stats);
+static hg_return_t
+hg_test_rpc_hold(hg_context_t *context, hg_request_class_t *request_class,
+    hg_addr_t addr, hg_uint32_t count);
+static hg_return_t
+hg_test_post_adapt(
+    hg_context_t *context, hg_request_class_t *request_class, hg_addr_t addr);
+static hg_return_t
+hg_test_shared_buf(
+    hg_context_t *context, hg_request_class_t *request_class, hg_addr_t addr);
+static hg_return_t
+hg_test_cq_rpc_cb(hg_handle_t handle);
+static hg_return_t
+hg_test_cq_forward_cb(const struct hg_cb_info *callback_info);
+static hg_return_t
+hg_test_completion_queue(na_class_t *na_class);
+static hg_return_t
+hg_test_core_rpc_cb(hg_core_handle_t handle);
+static hg_return_t
+hg_test_core_forward_cb(const struct hg_core_cb_info *callback_info);
+static hg_return_t
+hg_test_trigger_batch(na_class_t *na_class);
+static hg_return_t
+hg_test_progress_stats(na_class_t *na_class, hg_uint32_t spin_us);
 
 /*******************/
 /* Local Variables */
@@ -71,7 +161,11 @@ extern hg_id_t hg_test_rpc_null_id_g;
 extern hg_id_t hg_test_rpc_open_id_g;
 extern hg_id_t hg_test_rpc_open_id_no_resp_g;
 extern hg_id_t hg_test_overflow_id_g;
+extern hg_id_t hg_test_view_id_g;
+extern hg_id_t hg_test_view_copy_id_g;
 extern hg_id_t hg_test_cancel_rpc_id_g;
+extern hg_id_t hg_test_rpc_hold_id_g;
+extern hg_id_t hg_test_post_stats_id_g;
 
 /*---------------------------------------------------------------------------*/
 static hg_return_t
@@ -173,16 +267,16 @@ static hg_return_t
 hg_test_rpc_forward_overflow_cb(const struct hg_cb_info *callback_info)
 {
     hg_handle_t handle = callback_info->info.forward.handle;
-    hg_request_t *request = (hg_request_t *) callback_info->arg;
+    struct overflow_cb_args *args =
+        (struct overflow_cb_args *) callback_info->arg;
     overflow_out_t out_struct;
-#    ifdef HG_HAS_DEBUG
     hg_string_t string;
-    size_t string_len;
-#    endif
+    size_t string_len, i;
     hg_return_t ret = HG_SUCCESS;
 
-    HG_TEST_CHECK_ERROR_NORET(callback_info->ret != HG_SUCCESS, done,
-        "Error in HG callback (%s)", HG_Error_to_string(callback_info->ret));
+    ret = callback_info->ret;
+    HG_TEST_CHECK_HG_ERROR(
+        done, ret, "Error in HG callback (%s)", HG_Error_to_string(ret));
 
     /* Get output */
     ret = HG_Get_output(handle, &out_struct);
@@ -190,19 +284,67 @@ hg_test_rpc_forward_overflow_cb(const struct hg_cb_info *callback_info)
         done, ret, "HG_Get_output() failed (%s)", HG_Error_to_string(ret));
 
     /* Get output parameters */
-#    ifdef HG_HAS_DEBUG
     string = out_struct.string;
     string_len = out_struct.string_len;
-#    endif
-    HG_TEST_LOG_DEBUG("Returned string (length %zu): %s", string_len, string);
+    HG_TEST_LOG_DEBUG("Returned string (length %zu)", string_len);
+
+    /* Pooled buffers are reused, make sure that no stale data is returned */
+    for (i = 0; i < string_len && string[i] == 'h'; i++)
+        continue;
+    if (i != string_len || string[i] != '\0') {
+        HG_TEST_LOG_ERROR(
+            "Returned string does not match (length %zu)", string_len);
+        ret = HG_FAULT;
+    }
 
     /* Free request */
-    ret = HG_Free_output(handle, &out_struct);
+    HG_Free_output(handle, &out_struct);
+
+done:
+    args->ret = ret;
+    hg_request_complete(args->request);
+    return ret;
+}
+#endif
+
+/*---------------------------------------------------------------------------*/
+#ifndef HG_HAS_XDR
+static hg_return_t
+hg_test_rpc_forward_view_cb(const struct hg_cb_info *callback_info)
+{
+    hg_handle_t handle = callback_info->info.forward.handle;
+    struct view_cb_args *args = (struct view_cb_args *) callback_info->arg;
+    view_out_t out_struct;
+    hg_return_t ret = HG_SUCCESS;
+
+    ret = callback_info->ret;
     HG_TEST_CHECK_HG_ERROR(
-        done, ret, "HG_Free_output() failed (%s)", HG_Error_to_string(ret));
+        done, ret, "Error in HG callback (%s)", HG_Error_to_string(ret));
+
+    /* Get output */
+    ret = HG_Get_output(handle, &out_struct);
+    HG_TEST_CHECK_HG_ERROR(
+        done, ret, "HG_Get_output() failed (%s)", HG_Error_to_string(ret));
+
+    if (out_struct.string_len != args->size ||
+        out_struct.bytes_size != args->size) {
+        HG_TEST_LOG_ERROR("Target decoded %" PRIu64 "/%" PRIu64
+                          " bytes, expected %" PRIu64,
+            out_struct.string_len, out_struct.bytes_size, args->size);
+        ret = HG_FAULT;
+    } else if (out_struct.in_place != args->in_place) {
+        HG_TEST_LOG_ERROR("Target decoded input %s, expected %s",
+            out_struct.in_place ? "in place" : "as a copy",
+            args->in_place ? "in place" : "as a copy");
+        ret = HG_FAULT;
+    }
+
+    /* Free request */
+    HG_Free_output(handle, &out_struct);
 
 done:
-    hg_request_complete(request);
+    args->ret = ret;
+    hg_request_complete(args->request);
     return ret;
 }
 #endif
@@ -226,6 +368,71 @@ done:
     return ret;
 }
 
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_test_rpc_forward_hold_cb(const struct hg_cb_info *callback_info)
+{
+    hg_handle_t handle = callback_info->info.forward.handle;
+    struct hold_cb_args *args = (struct hold_cb_args *) callback_info->arg;
+    rpc_hold_out_t out_struct;
+    hg_return_t ret;
+
+    HG_TEST_CHECK_ERROR(callback_info->ret != HG_SUCCESS, done, args->ret,
+        callback_info->ret, "Error in HG callback (%s)",
+        HG_Error_to_string(callback_info->ret));
+
+    /* Get output */
+    ret = HG_Get_output(handle, &out_struct);
+    HG_TEST_CHECK_ERROR(ret != HG_SUCCESS, done, args->ret, ret,
+        "HG_Get_output() failed (%s)", HG_Error_to_string(ret));
+
+    /* Each response must carry the index of its own RPC */
+    if (out_struct.index >= args->count || args->received[out_struct.index]) {
+        HG_TEST_LOG_ERROR("Unexpected response index %" PRIu32,
+            out_struct.index);
+        args->ret = HG_FAULT;
+    } else
+        args->received[out_struct.index] = 1;
+
+    ret = HG_Free_output(handle, &out_struct);
+    HG_TEST_CHECK_ERROR(ret != HG_SUCCESS, done, args->ret, ret,
+        "HG_Free_output() failed (%s)", HG_Error_to_string(ret));
+
+done:
+    if ((hg_uint32_t) hg_atomic_incr32(&args->completed) == args->count)
+        hg_request_complete(args->request);
+
+    return HG_SUCCESS;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_test_rpc_forward_post_stats_cb(const struct hg_cb_info *callback_info)
+{
+    hg_handle_t handle = callback_info->info.forward.handle;
+    struct post_stats_cb_args *args =
+        (struct post_stats_cb_args *) callback_info->arg;
+    hg_return_t ret;
+
+    HG_TEST_CHECK_ERROR(callback_info->ret != HG_SUCCESS, done, args->ret,
+        callback_info->ret, "Error in HG callback (%s)",
+        HG_Error_to_string(callback_info->ret));
+
+    /* Get output */
+    args->ret = HG_Get_output(handle, args->stats);
+    HG_TEST_CHECK_HG_ERROR(done, args->ret, "HG_Get_output() failed (%s)",
+        HG_Error_to_string(args->ret));
+
+    ret = HG_Free_output(handle, args->stats);
+    HG_TEST_CHECK_HG_ERROR(
+        done, ret, "HG_Free_output() failed (%s)", HG_Error_to_string(ret));
+
+done:
+    hg_request_complete(args->request);
+
+    return HG_SUCCESS;
+}
+
 /*---------------------------------------------------------------------------*/
 static hg_return_t
 hg_test_rpc_null(
@@ -626,6 +833,7 @@ hg_test_overflow(hg_context_t *context, hg_request_class_t *request_class,
 {
     hg_request_t *request = NULL;
     hg_handle_t handle = HG_HANDLE_NULL;
+    struct overflow_cb_args overflow_cb_args;
     hg_return_t ret = HG_SUCCESS, cleanup_ret;
 
     request = hg_request_create(request_class);
@@ -635,13 +843,17 @@ hg_test_overflow(hg_context_t *context, hg_request_class_t *request_class,
     HG_TEST_CHECK_HG_ERROR(
         done, ret, "HG_Create() failed (%s)", HG_Error_to_string(ret));
 
+    overflow_cb_args.request = request;
+    overflow_cb_args.ret = HG_SUCCESS;
+
     /* Forward call to remote addr and get a new request */
     HG_TEST_LOG_DEBUG("Forwarding RPC, op id: %" PRIu64 "...", rpc_id);
-    ret = HG_Forward(handle, callback, request, NULL);
+    ret = HG_Forward(handle, callback, &overflow_cb_args, NULL);
     HG_TEST_CHECK_HG_ERROR(
         done, ret, "HG_Forward() failed (%s)", HG_Error_to_string(ret));
 
     hg_request_wait(request, HG_MAX_IDLE_TIME, NULL);
+    ret = overflow_cb_args.ret;
 
 done:
     cleanup_ret = HG_Destroy(handle);
@@ -654,6 +866,102 @@ done:
 }
 #endif
 
+/*---------------------------------------------------------------------------*/
+#ifndef HG_HAS_XDR
+static hg_return_t
+hg_test_view(hg_context_t *context, hg_request_class_t *request_class,
+    hg_addr_t addr, hg_id_t rpc_id, hg_size_t size, hg_uint8_t in_place,
+    unsigned int count)
+{
+    hg_request_t **requests = NULL;
+    hg_handle_t *handles = NULL;
+    struct view_cb_args *view_cb_args = NULL;
+    char **strings = NULL, **bytes = NULL;
+    hg_size_t j;
+    unsigned int i, forwarded = 0;
+    hg_return_t ret = HG_SUCCESS, cleanup_ret;
+
+    /* Each RPC sends a different size so that mixed up buffers are caught */
+    requests = (hg_request_t **) calloc(count, sizeof(*requests));
+    handles = (hg_handle_t *) calloc(count, sizeof(*handles));
+    view_cb_args = (struct view_cb_args *) calloc(count, sizeof(*view_cb_args));
+    strings = (char **) calloc(count, sizeof(*strings));
+    bytes = (char **) calloc(count, sizeof(*bytes));
+    HG_TEST_CHECK_ERROR(requests == NULL || handles == NULL ||
+                            view_cb_args == NULL || strings == NULL ||
+                            bytes == NULL,
+        done, ret, HG_NOMEM_ERROR, "Could not allocate RPC arrays");
+
+    for (i = 0; i < count; i++) {
+        view_in_t in_struct;
+        hg_size_t rpc_size = size + i;
+
+        requests[i] = hg_request_create(request_class);
+
+        strings[i] = (char *) malloc(rpc_size + 1);
+        bytes[i] = (char *) malloc(rpc_size);
+        HG_TEST_CHECK_ERROR(strings[i] == NULL || bytes[i] == NULL, done, ret,
+            HG_NOMEM_ERROR, "Could not allocate input data");
+        memset(strings[i], 'v', rpc_size);
+        strings[i][rpc_size] = '\0';
+        for (j = 0; j < rpc_size; j++)
+            bytes[i][j] = (char) j;
+
+        /* Create RPC request */
+        ret = HG_Create(context, addr, rpc_id, &handles[i]);
+        HG_TEST_CHECK_HG_ERROR(
+            done, ret, "HG_Create() failed (%s)", HG_Error_to_string(ret));
+
+        /* Fill input structure */
+        in_struct.string = strings[i];
+        in_struct.bytes.data = bytes[i];
+        in_struct.bytes.size = rpc_size;
+
+        view_cb_args[i].request = requests[i];
+        view_cb_args[i].size = rpc_size;
+        view_cb_args[i].in_place = in_place;
+        view_cb_args[i].ret = HG_SUCCESS;
+
+        /* Forward call to remote addr and get a new request */
+        HG_TEST_LOG_DEBUG("Forwarding RPC, op id: %" PRIu64 "...", rpc_id);
+        ret = HG_Forward(handles[i], hg_test_rpc_forward_view_cb,
+            &view_cb_args[i], &in_struct);
+        HG_TEST_CHECK_HG_ERROR(
+            done, ret, "HG_Forward() failed (%s)", HG_Error_to_string(ret));
+        forwarded++;
+    }
+
+done:
+    /* Forwarded RPCs must complete before they are released */
+    for (i = 0; i < forwarded; i++) {
+        hg_request_wait(requests[i], HG_MAX_IDLE_TIME, NULL);
+        if (ret == HG_SUCCESS)
+            ret = view_cb_args[i].ret;
+    }
+
+    for (i = 0; i < count; i++) {
+        if (handles != NULL) {
+            cleanup_ret = HG_Destroy(handles[i]);
+            HG_TEST_CHECK_ERROR_DONE(cleanup_ret != HG_SUCCESS,
+                "HG_Destroy() failed (%s)", HG_Error_to_string(cleanup_ret));
+        }
+        if (requests != NULL && requests[i] != NULL)
+            hg_request_destroy(requests[i]);
+        if (strings != NULL)
+            free(strings[i]);
+        if (bytes != NULL)
+            free(bytes[i]);
+    }
+    free(requests);
+    free(handles);
+    free(view_cb_args);
+    free(strings);
+    free(bytes);
+
+    return ret;
+}
+#endif
+
 /*---------------------------------------------------------------------------*/
 static hg_return_t
 hg_test_cancel_rpc(hg_context_t *context, hg_request_class_t *request_class,
@@ -694,6 +1002,599 @@ done:
     return ret;
 }
 
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_test_post_stats(hg_context_t *context, hg_request_class_t *request_class,
+    hg_addr_t addr, rpc_post_stats_out_t *stats)
+{
+    hg_request_t *request = NULL;
+    hg_handle_t handle = HG_HANDLE_NULL;
+    struct post_stats_cb_args post_stats_cb_args;
+    hg_return_t ret = HG_SUCCESS, cleanup_ret;
+
+    request = hg_request_create(request_class);
+
+    ret = HG_Create(context, addr, hg_test_post_stats_id_g, &handle);
+    HG_TEST_CHECK_HG_ERROR(
+        done, ret, "HG_Create() failed (%s)", HG_Error_to_string(ret));
+
+    post_stats_cb_args.request = request;
+    post_stats_cb_args.stats = stats;
+    post_stats_cb_args.ret = HG_TIMEOUT;
+
+    ret = HG_Forward(
+        handle, hg_test_rpc_forward_post_stats_cb, &post_stats_cb_args, NULL);
+    HG_TEST_CHECK_HG_ERROR(
+        done, ret, "HG_Forward() failed (%s)", HG_Error_to_string(ret));
+
+    hg_request_wait(request, HG_MAX_IDLE_TIME, NULL);
+    ret = post_stats_cb_args.ret;
+
+done:
+    cleanup_ret = HG_Destroy(handle);
+    HG_TEST_CHECK_ERROR_DONE(cleanup_ret != HG_SUCCESS,
+        "HG_Destroy() failed (%s)", HG_Error_to_string(cleanup_ret));
+
+    hg_request_destroy(request);
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_test_rpc_hold(hg_context_t *context, hg_request_class_t *request_class,
+    hg_addr_t addr, hg_uint32_t count)
+{
+    struct hold_cb_args hold_cb_args;
+    rpc_hold_in_t in_struct;
+    hg_handle_t *handles = NULL;
+    hg_uint32_t i;
+    hg_return_t ret = HG_SUCCESS, cleanup_ret;
+
+    hold_cb_args.request = hg_request_create(request_class);
+    hg_atomic_init32(&hold_cb_args.completed, 0);
+    hold_cb_args.count = count;
+    hold_cb_args.ret = HG_SUCCESS;
+    hold_cb_args.received = (hg_uint8_t *) calloc(count, sizeof(hg_uint8_t));
+    handles = (hg_handle_t *) calloc(count, sizeof(hg_handle_t));
+    HG_TEST_CHECK_ERROR(hold_cb_args.received == NULL || handles == NULL, done,
+        ret, HG_NOMEM_ERROR, "Could not allocate handles");
+
+    /* Target only responds once all RPCs are received */
+    in_struct.count = count;
+    for (i = 0; i < count; i++) {
+        ret = HG_Create(context, addr, hg_test_rpc_hold_id_g, &handles[i]);
+        HG_TEST_CHECK_HG_ERROR(
+            done, ret, "HG_Create() failed (%s)", HG_Error_to_string(ret));
+
+        in_struct.index = i;
+again:
+        ret = HG_Forward(
+            handles[i], hg_test_rpc_forward_hold_cb, &hold_cb_args, &in_struct);
+        if (ret == HG_AGAIN) {
+            hg_request_wait(hold_cb_args.request, 0, NULL);
+            goto again;
+        }
+        HG_TEST_CHECK_HG_ERROR(
+            done, ret, "HG_Forward() failed (%s)", HG_Error_to_string(ret));
+    }
+
+    hg_request_wait(hold_cb_args.request, HG_MAX_IDLE_TIME, NULL);
+    HG_TEST_CHECK_ERROR(
+        (hg_uint32_t) hg_atomic_get32(&hold_cb_args.completed) != count, done,
+        ret, HG_TIMEOUT, "Only %d/%" PRIu32 " RPCs completed",
+        hg_atomic_get32(&hold_cb_args.completed), count);
+    ret = hold_cb_args.ret;
+    HG_TEST_CHECK_HG_ERROR(done, ret, "Held RPCs failed");
+
+done:
+    if (handles != NULL) {
+        for (i = 0; i < count; i++) {
+            cleanup_ret = HG_Destroy(handles[i]);
+            HG_TEST_CHECK_ERROR_DONE(cleanup_ret != HG_SUCCESS,
+                "HG_Destroy() failed (%s)", HG_Error_to_string(cleanup_ret));
+        }
+        free(handles);
+    }
+    free(hold_cb_args.received);
+
+    hg_request_destroy(hold_cb_args.request);
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_test_post_adapt(
+    hg_context_t *context, hg_request_class_t *request_class, hg_addr_t addr)
+{
+    rpc_post_stats_out_t stats_init, stats;
+    hg_uint32_t count;
+    unsigned int elapsed;
+    hg_return_t ret = HG_SUCCESS;
+
+    ret = hg_test_post_stats(context, request_class, addr, &stats_init);
+    HG_TEST_CHECK_HG_ERROR(done, ret, "Could not get post stats");
+
+    /* Holding RPCs requires more requests than initially posted */
+    count = 2 * stats_init.floor_count;
+    ret = hg_test_rpc_hold(context, request_class, addr, count);
+    HG_TEST_CHECK_HG_ERROR(done, ret, "Could not hold RPCs");
+
+    /* Posted requests grew to hold all RPCs */
+    ret = hg_test_post_stats(context, request_class, addr, &stats);
+    HG_TEST_CHECK_HG_ERROR(done, ret, "Could not get post stats");
+    HG_TEST_CHECK_ERROR(
+        stats.grow_count == stats_init.grow_count || stats.total_count < count,
+        done, ret, HG_FAULT,
+        "Posted requests did not grow (%" PRIu32 " requests)",
+        stats.total_count);
+
+    /* And shrink back to the initial ones once the target is idle */
+    for (elapsed = 0;
+         elapsed < POST_IDLE_WAIT && stats.total_count > stats.floor_count;
+         elapsed += POST_IDLE_POLL) {
+        hg_time_sleep(hg_time_from_ms(POST_IDLE_POLL));
+
+        ret = hg_test_post_stats(context, request_class, addr, &stats);
+        HG_TEST_CHECK_HG_ERROR(done, ret, "Could not get post stats");
+    }
+    HG_TEST_CHECK_ERROR(stats.total_count != stats.floor_count ||
+                            stats.shrink_count == stats_init.shrink_count,
+        done, ret, HG_FAULT,
+        "Posted requests did not shrink (%" PRIu32 " requests, %" PRIu32
+        " initially)",
+        stats.total_count, stats.floor_count);
+
+done:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_test_shared_buf(
+    hg_context_t *context, hg_request_class_t *request_class, hg_addr_t addr)
+{
+    hg_return_t ret = HG_SUCCESS;
+
+    /* Concurrent responses exhaust the first block of shared buffers */
+    ret = hg_test_rpc_hold(context, request_class, addr, SHARED_BUF_COUNT);
+    HG_TEST_CHECK_HG_ERROR(done, ret, "Could not hold RPCs");
+
+    /* Buffers returned to the pool are reused by the next responses */
+    ret = hg_test_rpc_hold(context, request_class, addr, SHARED_BUF_COUNT);
+    HG_TEST_CHECK_HG_ERROR(done, ret, "Could not hold RPCs again");
+
+done:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_test_cq_rpc_cb(hg_handle_t handle)
+{
+    hg_return_t ret;
+
+    ret = HG_Respond(handle, NULL, NULL, NULL);
+    HG_TEST_CHECK_HG_ERROR(
+        done, ret, "HG_Respond() failed (%s)", HG_Error_to_string(ret));
+
+done:
+    HG_Destroy(handle);
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_test_cq_forward_cb(const struct hg_cb_info *callback_info)
+{
+    unsigned int *completed = (unsigned int *) callback_info->arg;
+
+    HG_TEST_CHECK_ERROR_NORET(callback_info->ret != HG_SUCCESS, done,
+        "Error in HG callback (%s)", HG_Error_to_string(callback_info->ret));
+
+    (*completed)++;
+
+done:
+    return HG_SUCCESS;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_test_completion_queue(na_class_t *na_class)
+{
+    struct hg_init_info hg_init_info = HG_INIT_INFO_INITIALIZER;
+    hg_class_t *hg_class = NULL;
+    hg_context_t *context = NULL;
+    hg_addr_t self_addr = HG_ADDR_NULL;
+    hg_handle_t handles[CQ_RPC_COUNT];
+    hg_return_t ret = HG_SUCCESS, cleanup_ret;
+    unsigned int i, round;
+    hg_id_t id;
+
+    for (i = 0; i < CQ_RPC_COUNT; i++)
+        handles[i] = HG_HANDLE_NULL;
+
+    /* Use a separate class on the same NA class with a tiny completion
+     * queue */
+    hg_init_info.na_class = na_class;
+    hg_init_info.completion_queue_size = CQ_QUEUE_SIZE;
+    hg_class = HG_Init_opt(NULL, HG_FALSE, &hg_init_info);
+    HG_TEST_CHECK_ERROR(
+        hg_class == NULL, done, ret, HG_FAULT, "HG_Init_opt() failed");
+
+    context = HG_Context_create(hg_class);
+    HG_TEST_CHECK_ERROR(
+        context == NULL, done, ret, HG_FAULT, "HG_Context_create() failed");
+
+    id = MERCURY_REGISTER(hg_class, "cq_rpc", void, void, hg_test_cq_rpc_cb);
+    HG_TEST_CHECK_ERROR(id == 0, done, ret, HG_FAULT, "HG_Register() failed");
+
+    ret = HG_Addr_self(hg_class, &self_addr);
+    HG_TEST_CHECK_HG_ERROR(
+        done, ret, "HG_Addr_self() failed (%s)", HG_Error_to_string(ret));
+
+    for (i = 0; i < CQ_RPC_COUNT; i++) {
+        ret = HG_Create(context, self_addr, id, &handles[i]);
+        HG_TEST_CHECK_HG_ERROR(
+            done, ret, "HG_Create() failed (%s)", HG_Error_to_string(ret));
+    }
+
+    /* Second round runs on the queue left once grown segments are drained
+     * and triggers in batches */
+    for (round = 0; round < 2; round++) {
+        unsigned int completed = 0;
+        hg_bool_t first = HG_TRUE;
+        hg_time_t now, deadline;
+
+        /* Self RPCs complete without progress, none is triggered until all
+         * of them have been queued */
+        for (i = 0; i < CQ_RPC_COUNT; i++) {
+            ret = HG_Forward(
+                handles[i], hg_test_cq_forward_cb, &completed, NULL);
+            HG_TEST_CHECK_HG_ERROR(
+                done, ret, "HG_Forward() failed (%s)", HG_Error_to_string(ret));
+        }
+
+        hg_time_get_current_ms(&now);
+        deadline = hg_time_add(now, hg_time_from_ms(CQ_TIMEOUT));
+        while (completed < CQ_RPC_COUNT) {
+            unsigned int actual_count = 0;
+
+            HG_TEST_CHECK_ERROR(!hg_time_less(now, deadline), done, ret,
+                HG_TIMEOUT, "Only %u of %d RPCs completed", completed,
+                CQ_RPC_COUNT);
+
+            if (round == 0) {
+                ret = HG_Trigger(context, 0, CQ_RPC_COUNT, &actual_count);
+                HG_TEST_CHECK_ERROR(ret != HG_SUCCESS && ret != HG_TIMEOUT,
+                    done, ret, ret, "HG_Trigger() failed (%s)",
+                    HG_Error_to_string(ret));
+            } else {
+                ret = HG_Trigger_batch(
+                    context, 0, 2 * CQ_RPC_COUNT, &actual_count);
+                HG_TEST_CHECK_ERROR(ret != HG_SUCCESS && ret != HG_TIMEOUT,
+                    done, ret, ret, "HG_Trigger_batch() failed (%s)",
+                    HG_Error_to_string(ret));
+
+                /* First batch only has the requests queued by HG_Forward() */
+                HG_TEST_CHECK_ERROR(first && actual_count != CQ_RPC_COUNT,
+                    done, ret, HG_FAULT, "First batch triggered %u entries",
+                    actual_count);
+                first = HG_FALSE;
+            }
+
+            ret = HG_Progress(context, 0);
+            HG_TEST_CHECK_ERROR(ret != HG_SUCCESS && ret != HG_TIMEOUT, done,
+                ret, ret, "HG_Progress() failed (%s)",
+                HG_Error_to_string(ret));
+            ret = HG_SUCCESS;
+
+            hg_time_get_current_ms(&now);
+        }
+    }
+
+done:
+    for (i = 0; i < CQ_RPC_COUNT; i++) {
+        cleanup_ret = HG_Destroy(handles[i]);
+        HG_TEST_CHECK_ERROR_DONE(cleanup_ret != HG_SUCCESS,
+            "HG_Destroy() failed (%s)", HG_Error_to_string(cleanup_ret));
+    }
+
+    if (self_addr != HG_ADDR_NULL) {
+        cleanup_ret = HG_Addr_free(hg_class, self_addr);
+        HG_TEST_CHECK_ERROR_DONE(cleanup_ret != HG_SUCCESS,
+            "HG_Addr_free() failed (%s)", HG_Error_to_string(cleanup_ret));
+    }
+
+    if (context != NULL) {
+        cleanup_ret = HG_Context_destroy(context);
+        HG_TEST_CHECK_ERROR_DONE(cleanup_ret != HG_SUCCESS,
+            "HG_Context_destroy() failed (%s)",
+            HG_Error_to_string(cleanup_ret));
+    }
+
+    if (hg_class != NULL) {
+        cleanup_ret = HG_Finalize(hg_class);
+        HG_TEST_CHECK_ERROR_DONE(cleanup_ret != HG_SUCCESS,
+            "HG_Finalize() failed (%s)", HG_Error_to_string(cleanup_ret));
+    }
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_test_progress_stats(na_class_t *na_class, hg_uint32_t spin_us)
+{
+    struct hg_init_info hg_init_info = HG_INIT_INFO_INITIALIZER;
+    struct hg_progress_stats stats;
+    hg_class_t *hg_class = NULL;
+    hg_context_t *context = NULL;
+    hg_addr_t self_addr = HG_ADDR_NULL;
+    hg_handle_t handle = HG_HANDLE_NULL;
+    unsigned int completed = 0;
+    hg_time_t now, deadline;
+    hg_return_t ret = HG_SUCCESS, cleanup_ret;
+    hg_id_t id;
+
+    /* Use a separate class on the same NA class */
+    hg_init_info.na_class = na_class;
+    hg_init_info.progress_spin_us = spin_us;
+    hg_class = HG_Init_opt(NULL, HG_FALSE, &hg_init_info);
+    HG_TEST_CHECK_ERROR(
+        hg_class == NULL, done, ret, HG_FAULT, "HG_Init_opt() failed");
+
+    context = HG_Context_create(hg_class);
+    HG_TEST_CHECK_ERROR(
+        context == NULL, done, ret, HG_FAULT, "HG_Context_create() failed");
+
+    id = MERCURY_REGISTER(
+        hg_class, "progress_rpc", void, void, hg_test_cq_rpc_cb);
+    HG_TEST_CHECK_ERROR(id == 0, done, ret, HG_FAULT, "HG_Register() failed");
+
+    ret = HG_Addr_self(hg_class, &self_addr);
+    HG_TEST_CHECK_HG_ERROR(
+        done, ret, "HG_Addr_self() failed (%s)", HG_Error_to_string(ret));
+
+    ret = HG_Create(context, self_addr, id, &handle);
+    HG_TEST_CHECK_HG_ERROR(
+        done, ret, "HG_Create() failed (%s)", HG_Error_to_string(ret));
+
+    /* Nothing to progress, timed out calls are not counted */
+    ret = HG_Progress(context, PROGRESS_TIMEOUT);
+    HG_TEST_CHECK_ERROR(ret != HG_TIMEOUT, done, ret, HG_FAULT,
+        "HG_Progress() did not time out (%s)", HG_Error_to_string(ret));
+    ret = HG_SUCCESS;
+
+    ret = HG_Context_get_progress_stats(context, &stats);
+    HG_TEST_CHECK_HG_ERROR(done, ret,
+        "HG_Context_get_progress_stats() failed (%s)",
+        HG_Error_to_string(ret));
+    HG_TEST_CHECK_ERROR(stats.spin_count != 0 || stats.backoff_count != 0 ||
+                            stats.poll_count != 0,
+        done, ret, HG_FAULT,
+        "Unexpected progress stats after timeout (%" PRIu64 ", %" PRIu64
+        ", %" PRIu64 ")",
+        stats.spin_count, stats.backoff_count, stats.poll_count);
+
+    /* Self RPC is queued for triggering without progress */
+    ret = HG_Forward(handle, hg_test_cq_forward_cb, &completed, NULL);
+    HG_TEST_CHECK_HG_ERROR(
+        done, ret, "HG_Forward() failed (%s)", HG_Error_to_string(ret));
+
+    ret = HG_Progress(context, PROGRESS_TIMEOUT);
+    HG_TEST_CHECK_HG_ERROR(
+        done, ret, "HG_Progress() failed (%s)", HG_Error_to_string(ret));
+
+    ret = HG_Context_get_progress_stats(context, &stats);
+    HG_TEST_CHECK_HG_ERROR(done, ret,
+        "HG_Context_get_progress_stats() failed (%s)",
+        HG_Error_to_string(ret));
+    HG_TEST_CHECK_ERROR(stats.spin_count != (spin_us ? 1 : 0) ||
+                            stats.backoff_count != 0 ||
+                            stats.poll_count != (spin_us ? 0 : 1),
+        done, ret, HG_FAULT,
+        "Unexpected progress stats (%" PRIu64 ", %" PRIu64 ", %" PRIu64 ")",
+        stats.spin_count, stats.backoff_count, stats.poll_count);
+
+    /* Non-blocking progress is not counted either */
+    hg_time_get_current_ms(&now);
+    deadline = hg_time_add(now, hg_time_from_ms(CQ_TIMEOUT));
+    while (completed < 1) {
+        unsigned int actual_count = 0;
+
+        HG_TEST_CHECK_ERROR(!hg_time_less(now, deadline), done, ret,
+            HG_TIMEOUT, "RPC did not complete");
+
+        ret = HG_Trigger(context, 0, 1, &actual_count);
+        HG_TEST_CHECK_ERROR(ret != HG_SUCCESS && ret != HG_TIMEOUT, done, ret,
+            ret, "HG_Trigger() failed (%s)", HG_Error_to_string(ret));
+
+        ret = HG_Progress(context, 0);
+        HG_TEST_CHECK_ERROR(ret != HG_SUCCESS && ret != HG_TIMEOUT, done, ret,
+            ret, "HG_Progress() failed (%s)", HG_Error_to_string(ret));
+        ret = HG_SUCCESS;
+
+        hg_time_get_current_ms(&now);
+    }
+
+    ret = HG_Context_get_progress_stats(context, &stats);
+    HG_TEST_CHECK_HG_ERROR(done, ret,
+        "HG_Context_get_progress_stats() failed (%s)",
+        HG_Error_to_string(ret));
+    HG_TEST_CHECK_ERROR(
+        stats.spin_count + stats.backoff_count + stats.poll_count != 1,
+        done, ret, HG_FAULT,
+        "Non-blocking progress was counted (%" PRIu64 ", %" PRIu64
+        ", %" PRIu64 ")",
+        stats.spin_count, stats.backoff_count, stats.poll_count);
+
+done:
+    cleanup_ret = HG_Destroy(handle);
+    HG_TEST_CHECK_ERROR_DONE(cleanup_ret != HG_SUCCESS,
+        "HG_Destroy() failed (%s)", HG_Error_to_string(cleanup_ret));
+
+    if (self_addr != HG_ADDR_NULL) {
+        cleanup_ret = HG_Addr_free(hg_class, self_addr);
+        HG_TEST_CHECK_ERROR_DONE(cleanup_ret != HG_SUCCESS,
+            "HG_Addr_free() failed (%s)", HG_Error_to_string(cleanup_ret));
+    }
+
+    if (context != NULL) {
+        cleanup_ret = HG_Context_destroy(context);
+        HG_TEST_CHECK_ERROR_DONE(cleanup_ret != HG_SUCCESS,
+            "HG_Context_destroy() failed (%s)",
+            HG_Error_to_string(cleanup_ret));
+    }
+
+    if (hg_class != NULL) {
+        cleanup_ret = HG_Finalize(hg_class);
+        HG_TEST_CHECK_ERROR_DONE(cleanup_ret != HG_SUCCESS,
+            "HG_Finalize() failed (%s)", HG_Error_to_string(cleanup_ret));
+    }
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_test_core_rpc_cb(hg_core_handle_t handle)
+{
+    hg_return_t ret;
+
+    ret = HG_Core_respond(handle, NULL, NULL, 0, 0);
+    HG_TEST_CHECK_HG_ERROR(
+        done, ret, "HG_Core_respond() failed (%s)", HG_Error_to_string(ret));
+
+done:
+    HG_Core_destroy(handle);
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_test_core_forward_cb(const struct hg_core_cb_info *callback_info)
+{
+    struct trigger_cb_args *args =
+        (struct trigger_cb_args *) callback_info->arg;
+
+    (*args->triggered)++;
+
+    return args->ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_test_trigger_batch(na_class_t *na_class)
+{
+    struct hg_init_info hg_init_info = HG_INIT_INFO_INITIALIZER;
+    struct trigger_cb_args args[TRIGGER_RPC_COUNT];
+    hg_core_class_t *core_class = NULL;
+    hg_core_context_t *core_context = NULL;
+    hg_core_addr_t self_addr = HG_CORE_ADDR_NULL;
+    hg_core_handle_t handles[TRIGGER_RPC_COUNT];
+    hg_return_t ret = HG_SUCCESS, cleanup_ret;
+    unsigned int triggered = 0, pass, i;
+    hg_id_t id = 1;
+
+    for (i = 0; i < TRIGGER_RPC_COUNT; i++) {
+        handles[i] = HG_CORE_HANDLE_NULL;
+        args[i].triggered = &triggered;
+        args[i].ret = HG_SUCCESS;
+    }
+    args[TRIGGER_FIRST_ERROR].ret = HG_AGAIN;
+    args[TRIGGER_SECOND_ERROR].ret = HG_FAULT;
+
+    /* Use a separate core class on the same NA class, callbacks of the HG
+     * layer never return errors */
+    hg_init_info.na_class = na_class;
+    core_class = HG_Core_init_opt(NULL, HG_FALSE, &hg_init_info);
+    HG_TEST_CHECK_ERROR(
+        core_class == NULL, done, ret, HG_FAULT, "HG_Core_init_opt() failed");
+
+    core_context = HG_Core_context_create(core_class);
+    HG_TEST_CHECK_ERROR(core_context == NULL, done, ret, HG_FAULT,
+        "HG_Core_context_create() failed");
+
+    ret = HG_Core_register(core_class, id, hg_test_core_rpc_cb);
+    HG_TEST_CHECK_HG_ERROR(
+        done, ret, "HG_Core_register() failed (%s)", HG_Error_to_string(ret));
+
+    ret = HG_Core_addr_self(core_class, &self_addr);
+    HG_TEST_CHECK_HG_ERROR(
+        done, ret, "HG_Core_addr_self() failed (%s)", HG_Error_to_string(ret));
+
+    for (i = 0; i < TRIGGER_RPC_COUNT; i++) {
+        ret = HG_Core_create(core_context, self_addr, id, &handles[i]);
+        HG_TEST_CHECK_HG_ERROR(
+            done, ret, "HG_Core_create() failed (%s)", HG_Error_to_string(ret));
+
+        ret = HG_Core_forward(
+            handles[i], hg_test_core_forward_cb, &args[i], 0, 0);
+        HG_TEST_CHECK_HG_ERROR(done, ret, "HG_Core_forward() failed (%s)",
+            HG_Error_to_string(ret));
+    }
+
+    /* Self RPCs queue one entry for their request, then for their response
+     * and finally for their forward callback. Entries queued while a batch
+     * is executed are deferred, each pass triggers one stage of all RPCs. */
+    for (pass = 0; pass < 3; pass++) {
+        unsigned int actual_count = 0;
+
+        ret = HG_Core_trigger_batch(
+            core_context, 0, 2 * TRIGGER_RPC_COUNT, &actual_count);
+        HG_TEST_CHECK_ERROR(actual_count != TRIGGER_RPC_COUNT, done, ret,
+            HG_FAULT, "Pass %u triggered %u entries, expected %d", pass,
+            actual_count, TRIGGER_RPC_COUNT);
+        HG_TEST_CHECK_ERROR(triggered != (pass == 2 ? TRIGGER_RPC_COUNT : 0),
+            done, ret, HG_FAULT, "Pass %u triggered %u forward callbacks",
+            pass, triggered);
+
+        /* All callbacks still run after the first one that fails, which is
+         * the error reported */
+        HG_TEST_CHECK_ERROR(ret != (pass == 2 ? HG_AGAIN : HG_SUCCESS), done,
+            ret, HG_FAULT, "Pass %u returned %s", pass,
+            HG_Error_to_string(ret));
+        ret = HG_SUCCESS;
+    }
+
+    /* Nothing is left */
+    ret = HG_Core_trigger_batch(core_context, 0, 1, NULL);
+    HG_TEST_CHECK_ERROR(ret != HG_TIMEOUT, done, ret, HG_FAULT,
+        "HG_Core_trigger_batch() returned %s", HG_Error_to_string(ret));
+    ret = HG_SUCCESS;
+
+done:
+    for (i = 0; i < TRIGGER_RPC_COUNT; i++) {
+        cleanup_ret = HG_Core_destroy(handles[i]);
+        HG_TEST_CHECK_ERROR_DONE(cleanup_ret != HG_SUCCESS,
+            "HG_Core_destroy() failed (%s)", HG_Error_to_string(cleanup_ret));
+    }
+
+    if (self_addr != HG_CORE_ADDR_NULL) {
+        cleanup_ret = HG_Core_addr_free(self_addr);
+        HG_TEST_CHECK_ERROR_DONE(cleanup_ret != HG_SUCCESS,
+            "HG_Core_addr_free() failed (%s)",
+            HG_Error_to_string(cleanup_ret));
+    }
+
+    if (core_context != NULL) {
+        cleanup_ret = HG_Core_context_destroy(core_context);
+        HG_TEST_CHECK_ERROR_DONE(cleanup_ret != HG_SUCCESS,
+            "HG_Core_context_destroy() failed (%s)",
+            HG_Error_to_string(cleanup_ret));
+    }
+
+    if (core_class != NULL) {
+        cleanup_ret = HG_Core_finalize(core_class);
+        HG_TEST_CHECK_ERROR_DONE(cleanup_ret != HG_SUCCESS,
+            "HG_Core_finalize() failed (%s)", HG_Error_to_string(cleanup_ret));
+    }
+
+    return ret;
+}
+
 /*---------------------------------------------------------------------------*/
 int
 main(int argc, char *argv[])
@@ -701,6 +1602,10 @@ main(int argc, char *argv[])
     struct hg_test_info hg_test_info = {0};
     hg_return_t hg_ret;
     hg_id_t inv_id;
+#ifndef HG_HAS_XDR
+    hg_size_t view_size;
+    unsigned int n;
+#endif
     int ret = EXIT_SUCCESS;
 
     /* Initialize the interface */
@@ -847,6 +1752,57 @@ main(int argc, char *argv[])
     HG_TEST_CHECK_ERROR(hg_ret != HG_SUCCESS, done, ret, EXIT_FAILURE,
         "overflow RPC test failed");
     HG_PASSED();
+
+    /* Input view RPC test, strings and bytes are decoded in place by
+     * HG_Get_input_view() and copied by HG_Get_input() */
+    HG_TEST("input view RPC");
+    hg_ret = hg_test_view(hg_test_info.context, hg_test_info.request_class,
+        hg_test_info.target_addr, hg_test_view_id_g, 64, 1, 1);
+    HG_TEST_CHECK_ERROR(hg_ret != HG_SUCCESS, done, ret, EXIT_FAILURE,
+        "input view RPC test failed");
+    hg_ret = hg_test_view(hg_test_info.context, hg_test_info.request_class,
+        hg_test_info.target_addr, hg_test_view_copy_id_g, 64, 0, 1);
+    HG_TEST_CHECK_ERROR(hg_ret != HG_SUCCESS, done, ret, EXIT_FAILURE,
+        "input copy RPC test failed");
+    HG_PASSED();
+
+    /* Same with input that overflows into an extra buffer */
+    HG_TEST("overflow input view RPC");
+    view_size = HG_Class_get_input_eager_size(hg_test_info.hg_class) * 2;
+    hg_ret = hg_test_view(hg_test_info.context, hg_test_info.request_class,
+        hg_test_info.target_addr, hg_test_view_id_g, view_size, 1, 1);
+    HG_TEST_CHECK_ERROR(hg_ret != HG_SUCCESS, done, ret, EXIT_FAILURE,
+        "overflow input view RPC test failed");
+    hg_ret = hg_test_view(hg_test_info.context, hg_test_info.request_class,
+        hg_test_info.target_addr, hg_test_view_copy_id_g, view_size, 0, 1);
+    HG_TEST_CHECK_ERROR(hg_ret != HG_SUCCESS, done, ret, EXIT_FAILURE,
+        "overflow input copy RPC test failed");
+    HG_PASSED();
+
+    /* Pooled overflow buffers are reused by subsequent RPCs */
+    HG_TEST("overflow RPC reuse");
+    for (n = 0; n < NOVERFLOW; n++) {
+        hg_ret = hg_test_overflow(hg_test_info.context,
+            hg_test_info.request_class, hg_test_info.target_addr,
+            hg_test_overflow_id_g, hg_test_rpc_forward_overflow_cb);
+        HG_TEST_CHECK_ERROR(hg_ret != HG_SUCCESS, done, ret, EXIT_FAILURE,
+            "overflow RPC reuse test failed");
+        hg_ret = hg_test_view(hg_test_info.context, hg_test_info.request_class,
+            hg_test_info.target_addr, hg_test_view_copy_id_g, view_size + n, 0,
+            1);
+        HG_TEST_CHECK_ERROR(hg_ret != HG_SUCCESS, done, ret, EXIT_FAILURE,
+            "overflow input reuse test failed");
+    }
+    HG_PASSED();
+
+    /* Concurrent overflows take distinct buffers from the pool */
+    HG_TEST("concurrent overflow RPCs");
+    hg_ret = hg_test_view(hg_test_info.context, hg_test_info.request_class,
+        hg_test_info.target_addr, hg_test_view_copy_id_g, view_size, 0,
+        NINFLIGHT * 2);
+    HG_TEST_CHECK_ERROR(hg_ret != HG_SUCCESS, done, ret, EXIT_FAILURE,
+        "concurrent overflow RPC test failed");
+    HG_PASSED();
 #endif
 
     /* Cancel RPC test (self cancelation is not supported) */
@@ -860,6 +1816,54 @@ main(int argc, char *argv[])
         HG_PASSED();
     }
 
+    /* Posted requests adapt to the load of the target */
+    if (!hg_test_info.na_test_info.self_send) {
+        HG_TEST("adaptive posted requests");
+        hg_ret = hg_test_post_adapt(hg_test_info.context,
+            hg_test_info.request_class, hg_test_info.target_addr);
+        HG_TEST_CHECK_ERROR(hg_ret != HG_SUCCESS, done, ret, EXIT_FAILURE,
+            "adaptive posted requests test failed");
+        HG_PASSED();
+    }
+
+    /* Concurrent responses draw output buffers from the shared pool */
+    if (!hg_test_info.na_test_info.self_send) {
+        HG_TEST("shared request buffers");
+        hg_ret = hg_test_shared_buf(hg_test_info.context,
+            hg_test_info.request_class, hg_test_info.target_addr);
+        HG_TEST_CHECK_ERROR(hg_ret != HG_SUCCESS, done, ret, EXIT_FAILURE,
+            "shared request buffers test failed");
+        HG_PASSED();
+    }
+
+    /* Completion queue grows past its initial size and shrinks back */
+    HG_TEST("completion queue growth");
+    hg_ret = hg_test_completion_queue(hg_test_info.na_test_info.na_class);
+    HG_TEST_CHECK_ERROR(hg_ret != HG_SUCCESS, done, ret, EXIT_FAILURE,
+        "completion queue growth test failed");
+    HG_PASSED();
+
+    /* Batches only trigger entries that were queued on entry */
+    HG_TEST("trigger batch");
+    hg_ret = hg_test_trigger_batch(hg_test_info.na_test_info.na_class);
+    HG_TEST_CHECK_ERROR(hg_ret != HG_SUCCESS, done, ret, EXIT_FAILURE,
+        "trigger batch test failed");
+    HG_PASSED();
+
+    /* Blocking progress is counted in the phase that resolved it */
+    HG_TEST("progress stats (poll)");
+    hg_ret = hg_test_progress_stats(hg_test_info.na_test_info.na_class, 0);
+    HG_TEST_CHECK_ERROR(hg_ret != HG_SUCCESS, done, ret, EXIT_FAILURE,
+        "progress stats test failed");
+    HG_PASSED();
+
+    HG_TEST("progress stats (spin)");
+    hg_ret = hg_test_progress_stats(
+        hg_test_info.na_test_info.na_class, PROGRESS_SPIN_US);
+    HG_TEST_CHECK_ERROR(hg_ret != HG_SUCCESS, done, ret, EXIT_FAILURE,
+        "progress stats test failed");
+    HG_PASSED();
+
 done:
     if (ret != EXIT_SUCCESS)
         HG_FAILED();
@@ -43,6 +43,12 @@ MERCURY_GEN_STRUCT_PROC(rpc_handle_t, ((hg_uint64_t) (cookie)))
 MERCURY_GEN_PROC(
     rpc_open_in_t, ((hg_const_string_t) (path)) ((rpc_handle_t) (handle)))
 MERCURY_GEN_PROC(rpc_open_out_t, ((hg_int32_t) (ret)) ((hg_int32_t) (event_id)))
+MERCURY_GEN_PROC(
+    rpc_hold_in_t, ((hg_uint32_t) (count)) ((hg_uint32_t) (index)))
+MERCURY_GEN_PROC(rpc_hold_out_t, ((hg_uint32_t) (index)))
+MERCURY_GEN_PROC(rpc_post_stats_out_t,
+    ((hg_uint64_t) (grow_count)) ((hg_uint64_t) (shrink_count))
+        ((hg_uint32_t) (total_count)) ((hg_uint32_t) (floor_count)))
 #else
 /* Dummy function that needs to be shipped (already defined) */
 /* int rpc_open(const char *path, rpc_handle_t handle, int *event_id); */
@@ -108,6 +114,78 @@ hg_proc_rpc_open_out_t(hg_proc_t proc, void *data)
 
     return ret;
 }
+
+/* Define rpc_hold_in_t */
+typedef struct {
+    hg_uint32_t count;
+    hg_uint32_t index;
+} rpc_hold_in_t;
+
+/* Define hg_proc_rpc_hold_in_t */
+static HG_INLINE hg_return_t
+hg_proc_rpc_hold_in_t(hg_proc_t proc, void *data)
+{
+    hg_return_t ret = HG_SUCCESS;
+    rpc_hold_in_t *struct_data = (rpc_hold_in_t *) data;
+
+    ret = hg_proc_uint32_t(proc, &struct_data->count);
+    if (ret != HG_SUCCESS)
+        return ret;
+
+    ret = hg_proc_uint32_t(proc, &struct_data->index);
+    if (ret != HG_SUCCESS)
+        return ret;
+
+    return ret;
+}
+
+/* Define rpc_hold_out_t */
+typedef struct {
+    hg_uint32_t index;
+} rpc_hold_out_t;
+
+/* Define hg_proc_rpc_hold_out_t */
+static HG_INLINE hg_return_t
+hg_proc_rpc_hold_out_t(hg_proc_t proc, void *data)
+{
+    rpc_hold_out_t *struct_data = (rpc_hold_out_t *) data;
+
+    return hg_proc_uint32_t(proc, &struct_data->index);
+}
+
+/* Define rpc_post_stats_out_t */
+typedef struct {
+    hg_uint64_t grow_count;
+    hg_uint64_t shrink_count;
+    hg_uint32_t total_count;
+    hg_uint32_t floor_count;
+} rpc_post_stats_out_t;
+
+/* Define hg_proc_rpc_post_stats_out_t */
+static HG_INLINE hg_return_t
+hg_proc_rpc_post_stats_out_t(hg_proc_t proc, void *data)
+{
+    hg_return_t ret = HG_SUCCESS;
+    rpc_post_stats_out_t *struct_data = (rpc_post_stats_out_t *) data;
+
+    ret = hg_proc_uint64_t(proc, &struct_data->grow_count);
+    if (ret != HG_SUCCESS)
+        return ret;
+
+    ret = hg_proc_uint64_t(proc, &struct_data->shrink_count);
+    if (ret != HG_SUCCESS)
+        return ret;
+
+    ret = hg_proc_uint32_t(proc, &struct_data->total_count);
+    if (ret != HG_SUCCESS)
+        return ret;
+
+    ret = hg_proc_uint32_t(proc, &struct_data->floor_count);
+    if (ret != HG_SUCCESS)
+        return ret;
+
+    return ret;
+}
 #endif
 
 /* Define hg_proc_perf_rpc_lat_in_t */
@@ -8,6 +8,13 @@
 #include "mercury_test.h"
 #include "mercury_time.h"
 
+#ifdef HG_TEST_HAS_PERF_EVENT_H
+#    include <linux/perf_event.h>
+#    include <sys/ioctl.h>
+#    include <sys/syscall.h>
+#    include <unistd.h>
+#endif
+
 /****************/
 /* Local Macros */
 /****************/
@@ -46,6 +53,12 @@ hg_test_perf_forward_cb(const struct hg_cb_info *callback_info);
 static hg_return_t
 measure_rpc_latency(struct hg_test_info *hg_test_info, size_t total_size,
     unsigned int nhandles);
+static int
+cache_miss_open(void);
+static void
+cache_miss_start(void);
+static double
+cache_miss_stop(size_t op_count);
 
 /*******************/
 /* Local Variables */
@@ -55,6 +68,9 @@ extern hg_id_t hg_test_perf_rpc_id_g;
 extern hg_id_t hg_test_perf_rpc_lat_id_g;
 extern hg_id_t hg_test_perf_rpc_lat_bi_id_g;
 
+/* Counter of hardware cache misses of this process (-1 if not available) */
+static int cache_miss_fd_g = -1;
+
 /*---------------------------------------------------------------------------*/
 static hg_return_t
 hg_test_perf_forward_cb(const struct hg_cb_info *callback_info)
@@ -85,6 +101,60 @@ done:
     return ret;
 }
 
+/*---------------------------------------------------------------------------*/
+static int
+cache_miss_open(void)
+{
+#ifdef HG_TEST_HAS_PERF_EVENT_H
+    struct perf_event_attr attr;
+
+    memset(&attr, 0, sizeof(attr));
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = PERF_COUNT_HW_CACHE_MISSES;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+
+    /* Fails when no PMU is exposed (e.g., most VMs) */
+    return (int) syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+#else
+    return -1;
+#endif
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+cache_miss_start(void)
+{
+#ifdef HG_TEST_HAS_PERF_EVENT_H
+    if (cache_miss_fd_g < 0)
+        return;
+    ioctl(cache_miss_fd_g, PERF_EVENT_IOC_RESET, 0);
+    ioctl(cache_miss_fd_g, PERF_EVENT_IOC_ENABLE, 0);
+#endif
+}
+
+/*---------------------------------------------------------------------------*/
+static double
+cache_miss_stop(size_t op_count)
+{
+#ifdef HG_TEST_HAS_PERF_EVENT_H
+    uint64_t count = 0;
+
+    if (cache_miss_fd_g < 0)
+        return 0;
+    ioctl(cache_miss_fd_g, PERF_EVENT_IOC_DISABLE, 0);
+    if (read(cache_miss_fd_g, &count, sizeof(count)) != sizeof(count))
+        return 0;
+
+    return (double) count / (double) op_count;
+#else
+    (void) op_count;
+    return 0;
+#endif
+}
+
 /*---------------------------------------------------------------------------*/
 static hg_return_t
 measure_rpc_latency(
@@ -103,7 +173,7 @@ measure_rpc_latency(
     hg_request_t *request;
     struct hg_test_perf_args args;
     size_t avg_iter;
-    double time_read = 0, read_lat;
+    double time_read = 0, read_lat, misses;
     hg_return_t ret = HG_SUCCESS;
     hg_bool_t bidir = hg_test_info->bidirectional ? HG_TRUE : HG_FALSE;
     size_t i;
@@ -172,6 +242,7 @@ again:
     NA_Test_barrier(&hg_test_info->na_test_info);
 
     /* RPC latency benchmark */
+    cache_miss_start();
     for (avg_iter = 0; avg_iter < loop; avg_iter++) {
         hg_time_t t1, t2;
         unsigned int j;
@@ -213,6 +284,7 @@ again:
                 NDIGITS, (read_lat), NWIDTH, (int) (1.0e6 / read_lat));
 #endif
     }
+    misses = cache_miss_stop(nhandles * loop);
 #ifndef HG_TEST_PRINT_PARTIAL
     read_lat =
         time_read * 1.0e6 /
@@ -222,8 +294,15 @@ again:
         fprintf(stdout, "%-*d%*.*f%*d\r", 10, (int) total_size, NWIDTH, NDIGITS,
             (read_lat), NWIDTH, (int) (1.0e6 / read_lat));
 #endif
-    if (hg_test_info->na_test_info.mpi_comm_rank == 0)
+    if (hg_test_info->na_test_info.mpi_comm_rank == 0) {
+        /* Misses of the origin process, including those of the target when
+         * forwarding to self */
+        if (cache_miss_fd_g >= 0)
+            fprintf(stdout, "%-*d%*.*f%*d%*.*f", 10, (int) total_size, NWIDTH,
+                NDIGITS, (read_lat), NWIDTH, (int) (1.0e6 / read_lat), NWIDTH,
+                NDIGITS, misses);
         fprintf(stdout, "\n");
+    }
 
     /* Complete */
     hg_request_destroy(request);
@@ -253,6 +332,8 @@ main(int argc, char *argv[])
     HG_TEST_CHECK_ERROR(
         hg_ret != HG_SUCCESS, done, ret, EXIT_FAILURE, "HG_Test_init() failed");
 
+    cache_miss_fd_g = cache_miss_open();
+
     for (nhandles = 1; nhandles <= hg_test_info.handle_max; nhandles *= 2) {
         if (hg_test_info.na_test_info.mpi_comm_rank == 0) {
             fprintf(stdout, "# %s v%s\n", BENCHMARK_NAME, VERSION_NAME);
@@ -265,8 +346,13 @@ main(int argc, char *argv[])
             fprintf(
                 stdout, "# WARNING verifying data, output will be slower\n");
 #endif
-            fprintf(stdout, "%-*s%*s%*s\n", 10, "# Size", NWIDTH,
-                "Latency (us)", NWIDTH, "RPC rate (RPC/s)");
+            if (cache_miss_fd_g >= 0)
+                fprintf(stdout, "%-*s%*s%*s%*s\n", 10, "# Size", NWIDTH,
+                    "Latency (us)", NWIDTH, "RPC rate (RPC/s)", NWIDTH,
+                    "Cache misses/RPC");
+            else
+                fprintf(stdout, "%-*s%*s%*s\n", 10, "# Size", NWIDTH,
+                    "Latency (us)", NWIDTH, "RPC rate (RPC/s)");
             fflush(stdout);
         }
 
@@ -287,6 +373,10 @@ main(int argc, char *argv[])
     }
 
 done:
+#ifdef HG_TEST_HAS_PERF_EVENT_H
+    if (cache_miss_fd_g >= 0)
+        close(cache_miss_fd_g);
+#endif
     hg_ret = HG_Test_finalize(&hg_test_info);
     HG_TEST_CHECK_ERROR_DONE(hg_ret != HG_SUCCESS, "HG_Test_finalize() failed");
 
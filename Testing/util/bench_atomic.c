@@ -0,0 +1,127 @@
+#include "mercury_atomic.h"
+#include "mercury_mem.h"
+#include "mercury_thread.h"
+#include "mercury_time.h"
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/* Number of increments per thread (can be overridden by argv[1]) */
+#define ATOMIC_BENCH_NUM_INCRS (1000000)
+
+/* Max number of threads used by benchmark */
+#define ATOMIC_BENCH_MAX_THREADS (16)
+
+/* Status word padded to its own cache line */
+struct padded_status {
+    HG_UTIL_ALIGNED(hg_atomic_int32_t status, HG_MEM_CACHE_LINE_SIZE);
+};
+
+struct bench_args {
+    hg_atomic_int32_t *status;
+    int32_t num_incrs;
+};
+
+/*---------------------------------------------------------------------------*/
+static HG_THREAD_RETURN_TYPE
+bench_func(void *args)
+{
+    struct bench_args *bench_args = (struct bench_args *) args;
+    hg_thread_ret_t ret = 0;
+    int32_t i;
+
+    for (i = 0; i < bench_args->num_incrs; i++)
+        hg_atomic_incr32(bench_args->status);
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static double
+bench_run(hg_atomic_int32_t **status, unsigned int thread_count,
+    int32_t num_incrs)
+{
+    hg_thread_t threads[ATOMIC_BENCH_MAX_THREADS];
+    struct bench_args args[ATOMIC_BENCH_MAX_THREADS];
+    hg_time_t t1, t2;
+    unsigned int i;
+
+    hg_time_get_current(&t1);
+    for (i = 0; i < thread_count; i++) {
+        hg_atomic_init32(status[i], 0);
+        args[i].status = status[i];
+        args[i].num_incrs = num_incrs;
+        hg_thread_create(&threads[i], bench_func, &args[i]);
+    }
+    for (i = 0; i < thread_count; i++)
+        hg_thread_join(threads[i]);
+    hg_time_get_current(&t2);
+
+    for (i = 0; i < thread_count; i++)
+        if (hg_atomic_get32(status[i]) != num_incrs)
+            return -1.0;
+
+    return (double) num_incrs * thread_count /
+           hg_time_to_double(hg_time_subtract(t2, t1)) / 1e6;
+}
+
+/*---------------------------------------------------------------------------*/
+static int
+bench(int32_t num_incrs)
+{
+    hg_atomic_int32_t packed[ATOMIC_BENCH_MAX_THREADS];
+    struct padded_status *padded;
+    hg_atomic_int32_t *packed_ptrs[ATOMIC_BENCH_MAX_THREADS],
+        *padded_ptrs[ATOMIC_BENCH_MAX_THREADS];
+    unsigned int thread_count, i;
+    int ret = EXIT_SUCCESS;
+
+    /* Status words written by different threads, either sharing cache lines
+     * or each on their own line */
+    padded = (struct padded_status *) hg_mem_aligned_alloc(
+        HG_MEM_CACHE_LINE_SIZE,
+        ATOMIC_BENCH_MAX_THREADS * sizeof(struct padded_status));
+    if (padded == NULL) {
+        fprintf(stderr, "Error: could not allocate status words\n");
+        return EXIT_FAILURE;
+    }
+    for (i = 0; i < ATOMIC_BENCH_MAX_THREADS; i++) {
+        packed_ptrs[i] = &packed[i];
+        padded_ptrs[i] = &padded[i].status;
+    }
+
+    printf("# %" PRId32 " increments per thread, throughput in Mops/s\n",
+        num_incrs);
+    printf("%-8s %12s %12s\n", "threads", "packed", "padded");
+    for (thread_count = 1; thread_count <= ATOMIC_BENCH_MAX_THREADS;
+         thread_count *= 2) {
+        double packed_rate, padded_rate;
+
+        packed_rate = bench_run(packed_ptrs, thread_count, num_incrs);
+        padded_rate = bench_run(padded_ptrs, thread_count, num_incrs);
+        if (packed_rate < 0 || padded_rate < 0) {
+            fprintf(stderr, "Error: lost increments\n");
+            ret = EXIT_FAILURE;
+            break;
+        }
+        printf("%-8u %12.2f %12.2f\n", thread_count, packed_rate,
+            padded_rate);
+    }
+
+    hg_mem_aligned_free(padded);
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+int
+main(int argc, char *argv[])
+{
+    int32_t num_incrs = ATOMIC_BENCH_NUM_INCRS;
+
+    if (argc > 1)
+        num_incrs = (int32_t) atoi(argv[1]);
+
+    return bench(num_incrs);
+}
@@ -0,0 +1,148 @@
+#include "mercury_atomic_queue.h"
+#include "mercury_thread.h"
+#include "mercury_time.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/* Number of entries pushed per producer (can be overridden by argv[1]) */
+#define QUEUE_BENCH_NUM_ENTRIES (1 << 18)
+
+/* Max number of producer threads used by benchmark */
+#define QUEUE_BENCH_MAX_THREADS (16)
+
+/* Queue size and number of entries pushed/popped at once when batching */
+#define QUEUE_BENCH_QUEUE_SIZE (1024)
+#define QUEUE_BENCH_BATCH_SIZE (16)
+
+struct bench_args {
+    struct hg_atomic_queue *hg_atomic_queue;
+    unsigned int num_entries;
+    unsigned int batch_size;
+};
+
+/*---------------------------------------------------------------------------*/
+static HG_THREAD_RETURN_TYPE
+bench_producer(void *args)
+{
+    struct bench_args *bench_args = (struct bench_args *) args;
+    hg_thread_ret_t ret = 0;
+    void *entries[QUEUE_BENCH_BATCH_SIZE];
+    unsigned int i, count;
+
+    for (i = 0; i < QUEUE_BENCH_BATCH_SIZE; i++)
+        entries[i] = bench_args;
+
+    for (i = 0; i < bench_args->num_entries; i += count) {
+        unsigned int pushed = 0;
+
+        count = bench_args->num_entries - i;
+        if (count > bench_args->batch_size)
+            count = bench_args->batch_size;
+
+        /* Retry remaining entries while queue is full */
+        while (pushed < count) {
+            unsigned int n;
+
+            if (bench_args->batch_size == 1)
+                n = (hg_atomic_queue_push(bench_args->hg_atomic_queue,
+                         entries[0]) == HG_UTIL_SUCCESS)
+                        ? 1
+                        : 0;
+            else
+                n = hg_atomic_queue_push_n(bench_args->hg_atomic_queue,
+                    &entries[pushed], count - pushed);
+            if (n == 0)
+                hg_thread_yield();
+            pushed += n;
+        }
+    }
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static int
+bench_run(unsigned int thread_count, unsigned int num_entries,
+    unsigned int batch_size)
+{
+    hg_thread_t threads[QUEUE_BENCH_MAX_THREADS];
+    struct bench_args args;
+    void *entries[QUEUE_BENCH_BATCH_SIZE];
+    unsigned long total, popped = 0;
+    unsigned int i, created;
+    hg_time_t t1, t2;
+    int ret = EXIT_SUCCESS;
+
+    args.hg_atomic_queue = hg_atomic_queue_alloc(QUEUE_BENCH_QUEUE_SIZE);
+    if (args.hg_atomic_queue == NULL) {
+        fprintf(stderr, "Error: could not allocate queue\n");
+        return EXIT_FAILURE;
+    }
+    args.num_entries = num_entries;
+    args.batch_size = batch_size;
+
+    hg_time_get_current(&t1);
+    for (created = 0; created < thread_count; created++) {
+        if (hg_thread_create(&threads[created], bench_producer, &args) !=
+            HG_UTIL_SUCCESS) {
+            fprintf(stderr, "Error: could not create thread\n");
+            ret = EXIT_FAILURE;
+            break;
+        }
+    }
+
+    /* Single consumer drains what the created producers push */
+    total = (unsigned long) created * num_entries;
+    while (popped < total) {
+        unsigned int n;
+
+        if (batch_size == 1)
+            n = (hg_atomic_queue_pop_mc(args.hg_atomic_queue)) ? 1 : 0;
+        else
+            n = hg_atomic_queue_pop_n(
+                args.hg_atomic_queue, entries, QUEUE_BENCH_BATCH_SIZE);
+        if (n == 0)
+            hg_thread_yield();
+        popped += n;
+    }
+
+    for (i = 0; i < created; i++)
+        hg_thread_join(threads[i]);
+    hg_time_get_current(&t2);
+
+    if (ret == EXIT_SUCCESS)
+        printf("%-12s %-10u %-10u %.2f\n",
+            (batch_size == 1) ? "push/pop" : "push_n/pop_n", thread_count,
+            batch_size,
+            (double) total / hg_time_to_double(hg_time_subtract(t2, t1)) /
+                1e6);
+
+    hg_atomic_queue_free(args.hg_atomic_queue);
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+int
+main(int argc, char *argv[])
+{
+    unsigned int num_entries = QUEUE_BENCH_NUM_ENTRIES, thread_count;
+
+    if (argc > 1)
+        num_entries = (unsigned int) atoi(argv[1]);
+
+    /* Entries per second as the number of producers increases */
+    printf("# %u entries per producer\n", num_entries);
+    printf("%-12s %-10s %-10s %s\n", "# Mode", "Producers", "Batch",
+        "MEntries/s");
+    for (thread_count = 1; thread_count <= QUEUE_BENCH_MAX_THREADS;
+         thread_count *= 2) {
+        if (bench_run(thread_count, num_entries, 1) != EXIT_SUCCESS ||
+            bench_run(thread_count, num_entries, QUEUE_BENCH_BATCH_SIZE) !=
+                EXIT_SUCCESS)
+            return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,227 @@
+#include "mercury_atomic.h"
+#include "mercury_queue.h"
+#include "mercury_thread_condition.h"
+#include "mercury_thread_mutex.h"
+#include "mercury_thread_pool.h"
+#include "mercury_time.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/* Number of tasks posted per benchmark run (can be overridden by argv[1]) */
+#define POOL_BENCH_NUM_TASKS (20000)
+
+/* Max number of threads used by benchmark */
+#define POOL_BENCH_MAX_THREADS (64)
+
+/* Number of tasks posted at once when batching */
+#define POOL_BENCH_BATCH_SIZE (16)
+
+/* Reference pool with a single global queue protected by a mutex, as the
+ * thread pool was originally implemented */
+struct ref_pool {
+    HG_QUEUE_HEAD(hg_thread_work) queue;
+    hg_thread_mutex_t mutex;
+    hg_thread_cond_t cond;
+    hg_thread_t *threads;
+    unsigned int thread_count;
+    unsigned int sleeping_worker_count;
+    int shutdown;
+};
+
+static hg_atomic_int32_t bench_count;
+
+/*---------------------------------------------------------------------------*/
+static HG_THREAD_RETURN_TYPE
+bench_func(void *args)
+{
+    hg_thread_ret_t ret = 0;
+    (void) args;
+
+    hg_atomic_incr32(&bench_count);
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static HG_THREAD_RETURN_TYPE
+ref_pool_worker(void *args)
+{
+    hg_thread_ret_t ret = 0;
+    struct ref_pool *pool = (struct ref_pool *) args;
+    struct hg_thread_work *work;
+
+    while (1) {
+        hg_thread_mutex_lock(&pool->mutex);
+
+        while (!pool->shutdown && HG_QUEUE_IS_EMPTY(&pool->queue)) {
+            pool->sleeping_worker_count++;
+            hg_thread_cond_wait(&pool->cond, &pool->mutex);
+            pool->sleeping_worker_count--;
+        }
+
+        if (pool->shutdown && HG_QUEUE_IS_EMPTY(&pool->queue))
+            break;
+
+        work = HG_QUEUE_FIRST(&pool->queue);
+        HG_QUEUE_POP_HEAD(&pool->queue, entry);
+        hg_thread_mutex_unlock(&pool->mutex);
+
+        (*work->func)(work->args);
+    }
+    hg_thread_mutex_unlock(&pool->mutex);
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static int
+ref_pool_init(unsigned int thread_count, struct ref_pool *pool)
+{
+    unsigned int i;
+
+    HG_QUEUE_INIT(&pool->queue);
+    hg_thread_mutex_init(&pool->mutex);
+    hg_thread_cond_init(&pool->cond);
+    pool->thread_count = thread_count;
+    pool->sleeping_worker_count = 0;
+    pool->shutdown = 0;
+    pool->threads = (hg_thread_t *) malloc(thread_count * sizeof(hg_thread_t));
+    if (pool->threads == NULL)
+        return HG_UTIL_FAIL;
+
+    for (i = 0; i < thread_count; i++)
+        hg_thread_create(&pool->threads[i], ref_pool_worker, pool);
+
+    return HG_UTIL_SUCCESS;
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+ref_pool_destroy(struct ref_pool *pool)
+{
+    unsigned int i;
+
+    hg_thread_mutex_lock(&pool->mutex);
+    pool->shutdown = 1;
+    hg_thread_cond_broadcast(&pool->cond);
+    hg_thread_mutex_unlock(&pool->mutex);
+
+    for (i = 0; i < pool->thread_count; i++)
+        hg_thread_join(pool->threads[i]);
+
+    hg_thread_mutex_destroy(&pool->mutex);
+    hg_thread_cond_destroy(&pool->cond);
+    free(pool->threads);
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+ref_pool_post(struct ref_pool *pool, struct hg_thread_work *work)
+{
+    hg_thread_mutex_lock(&pool->mutex);
+    HG_QUEUE_PUSH_TAIL(&pool->queue, work, entry);
+    if (pool->sleeping_worker_count)
+        hg_thread_cond_signal(&pool->cond);
+    hg_thread_mutex_unlock(&pool->mutex);
+}
+
+/*---------------------------------------------------------------------------*/
+static double
+bench_wait(hg_time_t t1, int32_t count)
+{
+    hg_time_t t2;
+
+    while (hg_atomic_get32(&bench_count) < count)
+        hg_thread_yield();
+    hg_time_get_current(&t2);
+
+    return (double) count / hg_time_to_double(hg_time_subtract(t2, t1)) / 1e6;
+}
+
+/*---------------------------------------------------------------------------*/
+static int
+bench(unsigned int num_tasks)
+{
+    struct hg_thread_work *work, *batch[POOL_BENCH_BATCH_SIZE];
+    unsigned int thread_count, i, j;
+
+    work = (struct hg_thread_work *) malloc(
+        num_tasks * sizeof(struct hg_thread_work));
+    if (work == NULL) {
+        fprintf(stderr, "Error: could not allocate work\n");
+        return EXIT_FAILURE;
+    }
+    for (i = 0; i < num_tasks; i++) {
+        work[i].func = bench_func;
+        work[i].args = NULL;
+    }
+
+    printf("# %u tasks, throughput in Mtasks/s\n", num_tasks);
+    printf("%-8s %12s %12s %12s\n", "threads", "mutex", "stealing",
+        "stealing+n");
+    for (thread_count = 1; thread_count <= POOL_BENCH_MAX_THREADS;
+         thread_count *= 2) {
+        hg_thread_pool_t *thread_pool;
+        struct ref_pool ref_pool;
+        double ref_rate, rate, batch_rate;
+        hg_time_t t1;
+
+        /* Reference pool */
+        if (ref_pool_init(thread_count, &ref_pool) != HG_UTIL_SUCCESS)
+            goto error;
+        hg_atomic_set32(&bench_count, 0);
+        hg_time_get_current(&t1);
+        for (i = 0; i < num_tasks; i++)
+            ref_pool_post(&ref_pool, &work[i]);
+        ref_rate = bench_wait(t1, (int32_t) num_tasks);
+        ref_pool_destroy(&ref_pool);
+
+        if (hg_thread_pool_init(thread_count, &thread_pool) != HG_UTIL_SUCCESS)
+            goto error;
+
+        /* One task at a time */
+        hg_atomic_set32(&bench_count, 0);
+        hg_time_get_current(&t1);
+        for (i = 0; i < num_tasks; i++)
+            hg_thread_pool_post(thread_pool, &work[i]);
+        rate = bench_wait(t1, (int32_t) num_tasks);
+
+        /* Batches of tasks */
+        hg_atomic_set32(&bench_count, 0);
+        hg_time_get_current(&t1);
+        for (i = 0; i < num_tasks; i += j) {
+            for (j = 0; j < POOL_BENCH_BATCH_SIZE && i + j < num_tasks; j++)
+                batch[j] = &work[i + j];
+            hg_thread_pool_post_n(thread_pool, batch, j);
+        }
+        batch_rate = bench_wait(t1, (int32_t) num_tasks);
+
+        hg_thread_pool_destroy(thread_pool);
+
+        printf("%-8u %12.2f %12.2f %12.2f\n", thread_count, ref_rate, rate,
+            batch_rate);
+    }
+
+    free(work);
+
+    return EXIT_SUCCESS;
+
+error:
+    fprintf(stderr, "Error: could not create thread pool\n");
+    free(work);
+
+    return EXIT_FAILURE;
+}
+
+/*---------------------------------------------------------------------------*/
+int
+main(int argc, char *argv[])
+{
+    unsigned int num_tasks = POOL_BENCH_NUM_TASKS;
+
+    if (argc > 1)
+        num_tasks = (unsigned int) atoi(argv[1]);
+
+    return bench(num_tasks);
+}
@@ -19,7 +19,10 @@ main(void)
     int value1 = 10, value2 = 20;
     struct my_entry my_entry1 = {.value = value1};
     struct my_entry my_entry2 = {.value = value2};
+    struct my_entry my_entries[HG_TEST_QUEUE_SIZE];
     struct my_entry *my_entry_ptr;
+    void *entries[HG_TEST_QUEUE_SIZE];
+    unsigned int i, n;
 
     hg_atomic_queue = hg_atomic_queue_alloc(HG_TEST_QUEUE_SIZE);
     if (!hg_atomic_queue) {
@@ -57,6 +60,48 @@ main(void)
         goto done;
     }
 
+    /* Batch push, queue can only hold HG_TEST_QUEUE_SIZE - 1 entries */
+    for (i = 0; i < HG_TEST_QUEUE_SIZE; i++) {
+        my_entries[i].value = (int) i;
+        entries[i] = &my_entries[i];
+    }
+    n = hg_atomic_queue_push_n(hg_atomic_queue, entries, HG_TEST_QUEUE_SIZE);
+    if (n != HG_TEST_QUEUE_SIZE - 1) {
+        fprintf(stderr, "Error: pushed %u entries, expected %d\n", n,
+            HG_TEST_QUEUE_SIZE - 1);
+        ret = EXIT_FAILURE;
+        goto done;
+    }
+    if (hg_atomic_queue_count(hg_atomic_queue) != HG_TEST_QUEUE_SIZE - 1) {
+        fprintf(stderr, "Error: queue count does not match\n");
+        ret = EXIT_FAILURE;
+        goto done;
+    }
+
+    /* Batch pop (wraps around ring) */
+    n = hg_atomic_queue_pop_n(hg_atomic_queue, entries, HG_TEST_QUEUE_SIZE);
+    if (n != HG_TEST_QUEUE_SIZE - 1) {
+        fprintf(stderr, "Error: popped %u entries, expected %d\n", n,
+            HG_TEST_QUEUE_SIZE - 1);
+        ret = EXIT_FAILURE;
+        goto done;
+    }
+    for (i = 0; i < n; i++) {
+        my_entry_ptr = (struct my_entry *) entries[i];
+        if (my_entry_ptr->value != (int) i) {
+            fprintf(stderr, "Error: values do not match, expected %d, got %d\n",
+                (int) i, my_entry_ptr->value);
+            ret = EXIT_FAILURE;
+            goto done;
+        }
+    }
+    if (!hg_atomic_queue_is_empty(hg_atomic_queue) ||
+        hg_atomic_queue_pop_n(hg_atomic_queue, entries, 1) != 0) {
+        fprintf(stderr, "Error: queue should be empty\n");
+        ret = EXIT_FAILURE;
+        goto done;
+    }
+
 done:
     hg_atomic_queue_free(hg_atomic_queue);
     return ret;
@@ -0,0 +1,173 @@
+#include "mercury_checksum.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#define HG_TEST_CHECK_STRING "123456789"
+#define HG_TEST_CHECK_CRC16  (0xFEE8U)
+#define HG_TEST_CHECK_CRC32C (0xE3069283U)
+#define HG_TEST_CHECK_CRC64  (0x995DC9BBDF1939FAULL)
+
+#define HG_TEST_BUF_SIZE (4096 + 64)
+
+static const char *const hg_test_impls[] = {
+    "generic", "sse4.2", "pclmul", "avx512"};
+
+/*---------------------------------------------------------------------------*/
+static uint16_t
+hg_test_crc16_ref(const unsigned char *buf, size_t size)
+{
+    uint16_t crc = 0;
+    size_t i;
+    int j;
+
+    for (i = 0; i < size; i++) {
+        crc ^= (uint16_t) (buf[i] << 8);
+        for (j = 0; j < 8; j++)
+            crc = (uint16_t) ((crc << 1) ^ ((crc & 0x8000) ? 0x8005U : 0));
+    }
+
+    return crc;
+}
+
+/*---------------------------------------------------------------------------*/
+static uint32_t
+hg_test_crc32c_ref(const unsigned char *buf, size_t size)
+{
+    uint32_t crc = 0xFFFFFFFFU;
+    size_t i;
+    int j;
+
+    for (i = 0; i < size; i++) {
+        crc ^= buf[i];
+        for (j = 0; j < 8; j++)
+            crc = (crc >> 1) ^ ((crc & 1) ? 0x82F63B78U : 0);
+    }
+
+    return ~crc;
+}
+
+/*---------------------------------------------------------------------------*/
+static uint64_t
+hg_test_crc64_ref(const unsigned char *buf, size_t size)
+{
+    uint64_t crc = 0xFFFFFFFFFFFFFFFFULL;
+    size_t i;
+    int j;
+
+    for (i = 0; i < size; i++) {
+        crc ^= buf[i];
+        for (j = 0; j < 8; j++)
+            crc = (crc >> 1) ^ ((crc & 1) ? 0xC96C5795D7870F42ULL : 0);
+    }
+
+    return ~crc;
+}
+
+/*---------------------------------------------------------------------------*/
+static int
+hg_test_checksum(const unsigned char *buf)
+{
+    size_t size, offset;
+
+    if (hg_checksum_crc16(0, HG_TEST_CHECK_STRING, 9) != HG_TEST_CHECK_CRC16) {
+        fprintf(stderr, "Error: CRC16 check value does not match\n");
+        return EXIT_FAILURE;
+    }
+    if (hg_checksum_crc32c(0, HG_TEST_CHECK_STRING, 9) !=
+        HG_TEST_CHECK_CRC32C) {
+        fprintf(stderr, "Error: CRC32C check value does not match\n");
+        return EXIT_FAILURE;
+    }
+    if (hg_checksum_crc64(0, HG_TEST_CHECK_STRING, 9) != HG_TEST_CHECK_CRC64) {
+        fprintf(stderr, "Error: CRC64 check value does not match\n");
+        return EXIT_FAILURE;
+    }
+
+    /* Compare against bitwise reference, including unaligned buffers */
+    for (offset = 0; offset < 8; offset += 3) {
+        for (size = 0; size <= HG_TEST_BUF_SIZE - 8;
+             size += (size < 600) ? 1 : 37) {
+            const unsigned char *ptr = buf + offset;
+
+            if (hg_checksum_crc16(0, ptr, size) !=
+                hg_test_crc16_ref(ptr, size)) {
+                fprintf(stderr,
+                    "Error: CRC16 does not match (size=%zu, offset=%zu)\n",
+                    size, offset);
+                return EXIT_FAILURE;
+            }
+
+            if (hg_checksum_crc32c(0, ptr, size) !=
+                hg_test_crc32c_ref(ptr, size)) {
+                fprintf(stderr,
+                    "Error: CRC32C does not match (size=%zu, offset=%zu)\n",
+                    size, offset);
+                return EXIT_FAILURE;
+            }
+            if (hg_checksum_crc64(0, ptr, size) !=
+                hg_test_crc64_ref(ptr, size)) {
+                fprintf(stderr,
+                    "Error: CRC64 does not match (size=%zu, offset=%zu)\n",
+                    size, offset);
+                return EXIT_FAILURE;
+            }
+        }
+    }
+
+    /* Checksums of non-contiguous data must match */
+    for (size = 0; size < HG_TEST_BUF_SIZE; size += 509) {
+        if (hg_checksum_crc16(hg_checksum_crc16(0, buf, size), buf + size,
+                HG_TEST_BUF_SIZE - size) !=
+            hg_checksum_crc16(0, buf, HG_TEST_BUF_SIZE)) {
+            fprintf(stderr, "Error: chained CRC16 does not match\n");
+            return EXIT_FAILURE;
+        }
+        if (hg_checksum_crc32c(hg_checksum_crc32c(0, buf, size), buf + size,
+                HG_TEST_BUF_SIZE - size) !=
+            hg_checksum_crc32c(0, buf, HG_TEST_BUF_SIZE)) {
+            fprintf(stderr, "Error: chained CRC32C does not match\n");
+            return EXIT_FAILURE;
+        }
+        if (hg_checksum_crc64(hg_checksum_crc64(0, buf, size), buf + size,
+                HG_TEST_BUF_SIZE - size) !=
+            hg_checksum_crc64(0, buf, HG_TEST_BUF_SIZE)) {
+            fprintf(stderr, "Error: chained CRC64 does not match\n");
+            return EXIT_FAILURE;
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/*---------------------------------------------------------------------------*/
+int
+main(void)
+{
+    unsigned char *buf;
+    unsigned int i;
+    int ret = EXIT_SUCCESS;
+
+    buf = (unsigned char *) malloc(HG_TEST_BUF_SIZE);
+    if (!buf) {
+        fprintf(stderr, "Error: could not allocate buffer\n");
+        return EXIT_FAILURE;
+    }
+    for (i = 0; i < HG_TEST_BUF_SIZE; i++)
+        buf[i] = (unsigned char) (rand() & 0xff);
+
+    /* Test every implementation supported by the CPU */
+    for (i = 0; i < sizeof(hg_test_impls) / sizeof(hg_test_impls[0]); i++) {
+        if (hg_checksum_set_impl(hg_test_impls[i]) != HG_UTIL_SUCCESS)
+            break;
+        printf("Testing %s checksums\n", hg_checksum_get_impl());
+
+        ret = hg_test_checksum(buf);
+        if (ret != EXIT_SUCCESS)
+            break;
+    }
+
+    free(buf);
+
+    return ret;
+}
@@ -0,0 +1,356 @@
+#include "mercury_atomic.h"
+#include "mercury_hash_map.h"
+#include "mercury_hash_table.h"
+#include "mercury_thread.h"
+#include "mercury_thread_rwlock.h"
+#include "mercury_time.h"
+
+#include "mercury_test_config.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/****************/
+/* Local Macros */
+/****************/
+
+#define N_KEYS  (1024)
+#define N_ITERS (100)
+
+/* Number of lookups per thread and benchmark run (can be overridden by
+ * argv[1]) */
+#define BENCH_NUM_LOOKUPS (100000)
+
+/* Max number of threads used by benchmark */
+#define BENCH_MAX_THREADS (16)
+
+/************************************/
+/* Local Type and Struct Definition */
+/************************************/
+
+struct thread_args {
+    hg_hash_map_t *map;
+    hg_atomic_int32_t done;
+    hg_atomic_int32_t n_errors;
+};
+
+struct bench_args {
+    hg_hash_map_t *map;
+    hg_hash_table_t *table;
+    hg_thread_rwlock_t lock;
+    unsigned int num_lookups;
+};
+
+/********************/
+/* Local Prototypes */
+/********************/
+
+static unsigned int
+int_hash(const void *key);
+
+static int
+int_equal(const void *key1, const void *key2);
+
+static unsigned int
+int_table_hash(hg_hash_table_key_t key);
+
+static int
+int_table_equal(hg_hash_table_key_t key1, hg_hash_table_key_t key2);
+
+static void
+count_entry(const void *key, void *value, void *arg);
+
+static void
+remove_entry(const void *key, void *value, void *arg);
+
+static HG_THREAD_RETURN_TYPE
+hg_test_hash_map_thread(void *arg);
+
+static HG_THREAD_RETURN_TYPE
+bench_map_thread(void *arg);
+
+static HG_THREAD_RETURN_TYPE
+bench_table_thread(void *arg);
+
+static double
+bench_run(hg_thread_func_t func, struct bench_args *bench_args,
+    unsigned int thread_count);
+
+static int
+bench(hg_hash_map_t *map, unsigned int num_lookups);
+
+/*******************/
+/* Local Variables */
+/*******************/
+
+static int keys[N_KEYS];
+
+/*---------------------------------------------------------------------------*/
+static unsigned int
+int_hash(const void *key)
+{
+    return (unsigned int) *((const int *) key);
+}
+
+/*---------------------------------------------------------------------------*/
+static int
+int_equal(const void *key1, const void *key2)
+{
+    return *((const int *) key1) == *((const int *) key2);
+}
+
+/*---------------------------------------------------------------------------*/
+static unsigned int
+int_table_hash(hg_hash_table_key_t key)
+{
+    return int_hash(key);
+}
+
+/*---------------------------------------------------------------------------*/
+static int
+int_table_equal(hg_hash_table_key_t key1, hg_hash_table_key_t key2)
+{
+    return int_equal(key1, key2);
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+count_entry(const void *key, void *value, void *arg)
+{
+    if (*((const int *) key) == *((int *) value))
+        (*((unsigned int *) arg))++;
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+remove_entry(const void *key, void *value, void *arg)
+{
+    /* Key is overwritten if another entry is moved in its place */
+    int i = *((const int *) key);
+
+    if (hg_hash_map_remove((hg_hash_map_t *) arg, key) == value)
+        keys[i] = -1;
+}
+
+/*---------------------------------------------------------------------------*/
+static HG_THREAD_RETURN_TYPE
+hg_test_hash_map_thread(void *arg)
+{
+    struct thread_args *thread_args = (struct thread_args *) arg;
+    hg_thread_ret_t tret = (hg_thread_ret_t) 0;
+    int i;
+
+    while (!hg_atomic_get32(&thread_args->done)) {
+        for (i = 0; i < N_KEYS; i++) {
+            int *value = (int *) hg_hash_map_lookup(thread_args->map, &i);
+
+            /* Even keys are never removed */
+            if ((value == NULL && (i % 2) == 0) ||
+                (value != NULL && *value != i)) {
+                hg_atomic_incr32(&thread_args->n_errors);
+                return tret;
+            }
+        }
+    }
+
+    return tret;
+}
+
+/*---------------------------------------------------------------------------*/
+static HG_THREAD_RETURN_TYPE
+bench_map_thread(void *arg)
+{
+    struct bench_args *bench_args = (struct bench_args *) arg;
+    hg_thread_ret_t tret = (hg_thread_ret_t) 0;
+    unsigned int i;
+
+    for (i = 0; i < bench_args->num_lookups; i++) {
+        int key = (int) (i % N_KEYS);
+
+        if (hg_hash_map_lookup(bench_args->map, &key) == NULL)
+            break;
+    }
+
+    return tret;
+}
+
+/*---------------------------------------------------------------------------*/
+static HG_THREAD_RETURN_TYPE
+bench_table_thread(void *arg)
+{
+    struct bench_args *bench_args = (struct bench_args *) arg;
+    hg_thread_ret_t tret = (hg_thread_ret_t) 0;
+    unsigned int i;
+
+    for (i = 0; i < bench_args->num_lookups; i++) {
+        int key = (int) (i % N_KEYS);
+        hg_hash_table_value_t value;
+
+        hg_thread_rwlock_rdlock(&bench_args->lock);
+        value = hg_hash_table_lookup(bench_args->table, &key);
+        hg_thread_rwlock_release_rdlock(&bench_args->lock);
+        if (value == HG_HASH_TABLE_NULL)
+            break;
+    }
+
+    return tret;
+}
+
+/*---------------------------------------------------------------------------*/
+static double
+bench_run(hg_thread_func_t func, struct bench_args *bench_args,
+    unsigned int thread_count)
+{
+    hg_thread_t threads[BENCH_MAX_THREADS];
+    hg_time_t t1, t2;
+    unsigned int i;
+
+    hg_time_get_current(&t1);
+    for (i = 0; i < thread_count; i++)
+        hg_thread_create(&threads[i], func, bench_args);
+    for (i = 0; i < thread_count; i++)
+        hg_thread_join(threads[i]);
+    hg_time_get_current(&t2);
+
+    return (double) (thread_count * bench_args->num_lookups) /
+           hg_time_to_double(hg_time_subtract(t2, t1)) / 1e6;
+}
+
+/*---------------------------------------------------------------------------*/
+static int
+bench(hg_hash_map_t *map, unsigned int num_lookups)
+{
+    struct bench_args bench_args;
+    unsigned int thread_count;
+    int i;
+
+    /* Reference table protected by a rwlock */
+    bench_args.table = hg_hash_table_new(int_table_hash, int_table_equal);
+    if (bench_args.table == NULL) {
+        fprintf(stderr, "Error: could not create hash table\n");
+        return EXIT_FAILURE;
+    }
+    for (i = 0; i < N_KEYS; i++)
+        hg_hash_table_insert(bench_args.table, &keys[i], &keys[i]);
+    hg_thread_rwlock_init(&bench_args.lock);
+    bench_args.map = map;
+    bench_args.num_lookups = num_lookups;
+
+    printf("# %d keys, %u lookups per thread, throughput in Mlookups/s\n",
+        N_KEYS, num_lookups);
+    printf("%-8s %12s %12s\n", "threads", "table+rwlock", "map");
+    for (thread_count = 1; thread_count <= BENCH_MAX_THREADS;
+         thread_count *= 2) {
+        double ref_rate, rate;
+
+        ref_rate = bench_run(bench_table_thread, &bench_args, thread_count);
+        rate = bench_run(bench_map_thread, &bench_args, thread_count);
+
+        printf("%-8u %12.2f %12.2f\n", thread_count, ref_rate, rate);
+    }
+
+    hg_thread_rwlock_destroy(&bench_args.lock);
+    hg_hash_table_free(bench_args.table);
+
+    return EXIT_SUCCESS;
+}
+
+/*---------------------------------------------------------------------------*/
+int
+main(int argc, char *argv[])
+{
+    hg_thread_t threads[HG_TEST_NUM_THREADS_DEFAULT];
+    struct thread_args thread_args;
+    unsigned int num_lookups = BENCH_NUM_LOOKUPS, count;
+    int i, j, key;
+
+    if (argc > 1)
+        num_lookups = (unsigned int) atoi(argv[1]);
+    for (i = 0; i < N_KEYS; i++)
+        keys[i] = i;
+    hg_atomic_init32(&thread_args.done, 0);
+    hg_atomic_init32(&thread_args.n_errors, 0);
+
+    thread_args.map = hg_hash_map_new(sizeof(int), int_hash, int_equal);
+    if (thread_args.map == NULL) {
+        fprintf(stderr, "Error: could not create hash map\n");
+        goto error;
+    }
+
+    /* Insert enough keys to grow the map */
+    for (i = 0; i < N_KEYS; i++) {
+        if (hg_hash_map_insert(thread_args.map, &i, &keys[i]) !=
+            HG_UTIL_SUCCESS) {
+            fprintf(stderr, "Error: could not insert key %d\n", i);
+            goto error;
+        }
+    }
+    key = 0;
+    if (hg_hash_map_insert(thread_args.map, &key, &keys[0]) ==
+        HG_UTIL_SUCCESS) {
+        fprintf(stderr, "Error: duplicate key was inserted\n");
+        goto error;
+    }
+    for (i = 0; i < N_KEYS; i++) {
+        if (hg_hash_map_lookup(thread_args.map, &i) != &keys[i]) {
+            fprintf(stderr, "Error: could not find key %d\n", i);
+            goto error;
+        }
+    }
+    count = 0;
+    hg_hash_map_iterate(thread_args.map, count_entry, &count);
+    if (count != N_KEYS || hg_hash_map_num_entries(thread_args.map) != N_KEYS) {
+        fprintf(stderr, "Error: iterated over %u entries\n", count);
+        goto error;
+    }
+
+    /* Remove odd keys while other threads look up keys */
+    for (i = 0; i < HG_TEST_NUM_THREADS_DEFAULT; i++)
+        hg_thread_create(&threads[i], hg_test_hash_map_thread, &thread_args);
+    for (i = 0; i < N_ITERS; i++) {
+        for (j = 1; j < N_KEYS; j += 2) {
+            if (hg_hash_map_remove(thread_args.map, &j) != &keys[j]) {
+                fprintf(stderr, "Error: could not remove key %d\n", j);
+                hg_atomic_incr32(&thread_args.n_errors);
+                break;
+            }
+        }
+        for (j = 1; j < N_KEYS; j += 2)
+            hg_hash_map_insert(thread_args.map, &j, &keys[j]);
+    }
+    hg_atomic_set32(&thread_args.done, 1);
+    for (i = 0; i < HG_TEST_NUM_THREADS_DEFAULT; i++)
+        hg_thread_join(threads[i]);
+
+    if (hg_atomic_get32(&thread_args.n_errors) != 0) {
+        fprintf(stderr, "Error: %d thread(s) got invalid values\n",
+            hg_atomic_get32(&thread_args.n_errors));
+        goto error;
+    }
+
+    if (bench(thread_args.map, num_lookups) != EXIT_SUCCESS)
+        goto error;
+
+    /* Entries can be removed while iterating */
+    hg_hash_map_iterate(thread_args.map, remove_entry, thread_args.map);
+    if (hg_hash_map_num_entries(thread_args.map) != 0) {
+        fprintf(stderr, "Error: %u entries were not removed\n",
+            hg_hash_map_num_entries(thread_args.map));
+        goto error;
+    }
+    for (i = 0; i < N_KEYS; i++) {
+        if (keys[i] != -1) {
+            fprintf(stderr, "Error: key %d was not visited\n", i);
+            goto error;
+        }
+    }
+
+    hg_hash_map_free(thread_args.map);
+
+    return EXIT_SUCCESS;
+
+error:
+    hg_hash_map_free(thread_args.map);
+
+    return EXIT_FAILURE;
+}
@@ -0,0 +1,169 @@
+#include "mercury_atomic.h"
+#include "mercury_thread.h"
+#include "mercury_thread_cache.h"
+
+#include "mercury_test_config.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/****************/
+/* Local Macros */
+/****************/
+
+#define MAG_SIZE    (4)
+#define N_OBJS      (32)
+#define N_ITERS     (1000)
+#define OBJ_PATTERN (0xcafe)
+
+/************************************/
+/* Local Type and Struct Definition */
+/************************************/
+
+struct thread_args {
+    struct hg_thread_cache *cache;
+    hg_atomic_int32_t n_errors;
+};
+
+/********************/
+/* Local Prototypes */
+/********************/
+
+static void *
+hg_test_thread_cache_alloc(void *arg);
+
+static void
+hg_test_thread_cache_free(void *obj, void *arg);
+
+static HG_THREAD_RETURN_TYPE
+hg_test_thread_cache_thread(void *arg);
+
+/*******************/
+/* Local Variables */
+/*******************/
+
+static hg_atomic_int32_t n_objs;
+
+/*---------------------------------------------------------------------------*/
+static void *
+hg_test_thread_cache_alloc(void *arg)
+{
+    int *obj;
+
+    (void) arg;
+
+    obj = (int *) malloc(sizeof(int));
+    if (obj == NULL)
+        return NULL;
+    *obj = OBJ_PATTERN;
+    hg_atomic_incr32(&n_objs);
+
+    return obj;
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+hg_test_thread_cache_free(void *obj, void *arg)
+{
+    (void) arg;
+
+    free(obj);
+    hg_atomic_decr32(&n_objs);
+}
+
+/*---------------------------------------------------------------------------*/
+static HG_THREAD_RETURN_TYPE
+hg_test_thread_cache_thread(void *arg)
+{
+    struct thread_args *thread_args = (struct thread_args *) arg;
+    hg_thread_ret_t tret = (hg_thread_ret_t) 0;
+    int *objs[N_OBJS];
+    int i, j;
+
+    for (i = 0; i < N_ITERS; i++) {
+        for (j = 0; j < N_OBJS; j++) {
+            objs[j] = (int *) hg_thread_cache_get(thread_args->cache);
+            if (objs[j] == NULL || *objs[j] != OBJ_PATTERN) {
+                hg_atomic_incr32(&thread_args->n_errors);
+                return tret;
+            }
+            /* Object must not be handed out twice */
+            *objs[j] = 0;
+        }
+        for (j = 0; j < N_OBJS; j++) {
+            *objs[j] = OBJ_PATTERN;
+            if (hg_thread_cache_put(thread_args->cache, objs[j]) !=
+                HG_UTIL_SUCCESS) {
+                hg_atomic_incr32(&thread_args->n_errors);
+                return tret;
+            }
+        }
+    }
+
+    return tret;
+}
+
+/*---------------------------------------------------------------------------*/
+int
+main(void)
+{
+    hg_thread_t threads[HG_TEST_NUM_THREADS_DEFAULT];
+    struct thread_args thread_args;
+    int *obj1, *obj2;
+    int i;
+
+    hg_atomic_init32(&n_objs, 0);
+    hg_atomic_init32(&thread_args.n_errors, 0);
+
+    thread_args.cache = hg_thread_cache_create(MAG_SIZE,
+        hg_test_thread_cache_alloc, hg_test_thread_cache_free, NULL);
+    if (thread_args.cache == NULL) {
+        fprintf(stderr, "Error: could not create thread cache\n");
+        goto error;
+    }
+
+    /* Objects put back are re-used */
+    obj1 = (int *) hg_thread_cache_get(thread_args.cache);
+    hg_thread_cache_put(thread_args.cache, obj1);
+    obj2 = (int *) hg_thread_cache_get(thread_args.cache);
+    if (obj1 != obj2 || hg_atomic_get32(&n_objs) != 1) {
+        fprintf(stderr, "Error: object was not re-used\n");
+        goto error;
+    }
+    hg_thread_cache_put(thread_args.cache, obj2);
+
+    for (i = 0; i < HG_TEST_NUM_THREADS_DEFAULT; i++)
+        hg_thread_create(
+            &threads[i], hg_test_thread_cache_thread, &thread_args);
+    for (i = 0; i < HG_TEST_NUM_THREADS_DEFAULT; i++)
+        hg_thread_join(threads[i]);
+
+    if (hg_atomic_get32(&thread_args.n_errors) != 0) {
+        fprintf(stderr, "Error: %d thread(s) got invalid objects\n",
+            hg_atomic_get32(&thread_args.n_errors));
+        goto error;
+    }
+
+    /* Only objects in flight at the same time should have been allocated */
+    if (hg_atomic_get32(&n_objs) >
+        (HG_TEST_NUM_THREADS_DEFAULT + 1) * (N_OBJS + 2 * MAG_SIZE)) {
+        fprintf(stderr, "Error: too many objects allocated (%d)\n",
+            hg_atomic_get32(&n_objs));
+        goto error;
+    }
+
+    /* Objects cached by joined threads are released as well */
+    hg_thread_cache_destroy(thread_args.cache);
+    if (hg_atomic_get32(&n_objs) != 0) {
+        fprintf(stderr, "Error: %d object(s) were not freed\n",
+            hg_atomic_get32(&n_objs));
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+
+error:
+    hg_thread_cache_destroy(thread_args.cache);
+
+    return EXIT_FAILURE;
+}
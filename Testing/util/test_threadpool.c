@@ -1,5 +1,7 @@
+#include "mercury_atomic.h"
 #include "mercury_thread_mutex.h"
 #include "mercury_thread_pool.h"
+#include "mercury_time.h"
 
 #include "mercury_test_config.h"
 
@@ -8,6 +10,12 @@
 
 #define POOL_NUM_POSTS 32
 
+/* Number of tasks posted one at a time to an idle pool */
+#define POOL_NUM_WAKEUPS (2000)
+
+/* Time after which a posted task is considered lost (in seconds) */
+#define POOL_WAKEUP_TIMEOUT (10.0)
+
 /*
 #include <sys/syscall.h>
 #include <sys/types.h>
@@ -26,6 +34,13 @@ myfunc(void *args)
 }
 */
 
+struct wakeup_args {
+    hg_thread_pool_t *pool;
+    hg_atomic_int32_t *counts; /* Per-poster count of executed tasks */
+    int32_t index;             /* Index of poster */
+    int ret;
+};
+
 static unsigned int ncalls = 0;
 static hg_thread_mutex_t mymutex;
 
@@ -43,16 +58,113 @@ myfunc(void *args)
     return ret;
 }
 
+/*---------------------------------------------------------------------------*/
+static HG_THREAD_RETURN_TYPE
+wakeup_func(void *args)
+{
+    hg_thread_ret_t ret = 0;
+
+    hg_atomic_incr32((hg_atomic_int32_t *) args);
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static HG_THREAD_RETURN_TYPE
+wakeup_poster(void *args)
+{
+    hg_thread_ret_t ret = 0;
+    struct wakeup_args *wakeup_args = (struct wakeup_args *) args;
+    hg_atomic_int32_t *count = &wakeup_args->counts[wakeup_args->index];
+    struct hg_thread_work *work;
+    int32_t i;
+
+    work = (struct hg_thread_work *) malloc(
+        POOL_NUM_WAKEUPS * sizeof(struct hg_thread_work));
+    if (work == NULL) {
+        wakeup_args->ret = EXIT_FAILURE;
+        return ret;
+    }
+
+    /* Wait for each task before posting the next one so that workers
+     * repeatedly go idle and must be woken up again */
+    for (i = 0; i < POOL_NUM_WAKEUPS; i++) {
+        hg_time_t t1, t2;
+
+        work[i].func = wakeup_func;
+        work[i].args = count;
+        hg_time_get_current(&t1);
+        hg_thread_pool_post(wakeup_args->pool, &work[i]);
+        while (hg_atomic_get32(count) <= i) {
+            hg_time_get_current(&t2);
+            if (hg_time_to_double(hg_time_subtract(t2, t1)) >
+                POOL_WAKEUP_TIMEOUT) {
+                fprintf(stderr, "Task %d of poster %d was never executed\n", i,
+                    wakeup_args->index);
+                wakeup_args->ret = EXIT_FAILURE;
+                goto done;
+            }
+            hg_thread_yield();
+        }
+    }
+
+done:
+    /* Lost tasks may still run once the pool is destroyed */
+    if (wakeup_args->ret == EXIT_SUCCESS)
+        free(work);
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static int
+test_wakeup(unsigned int poster_count)
+{
+    struct hg_thread_pool_init_info init_info = {
+        .queue_size = 0, .spin_count = 1, .cpu_masks = NULL};
+    hg_thread_pool_t *thread_pool;
+    hg_thread_t threads[HG_TEST_NUM_THREADS_DEFAULT];
+    struct wakeup_args args[HG_TEST_NUM_THREADS_DEFAULT];
+    hg_atomic_int32_t counts[HG_TEST_NUM_THREADS_DEFAULT];
+    unsigned int i;
+    int ret = EXIT_SUCCESS;
+
+    /* Workers spin as little as possible before sleeping */
+    if (hg_thread_pool_init_opt(HG_TEST_NUM_THREADS_DEFAULT, &init_info,
+            &thread_pool) != HG_UTIL_SUCCESS) {
+        fprintf(stderr, "Could not create thread pool\n");
+        return EXIT_FAILURE;
+    }
+
+    for (i = 0; i < poster_count; i++) {
+        hg_atomic_init32(&counts[i], 0);
+        args[i].pool = thread_pool;
+        args[i].counts = counts;
+        args[i].index = (int32_t) i;
+        args[i].ret = EXIT_SUCCESS;
+        hg_thread_create(&threads[i], wakeup_poster, &args[i]);
+    }
+    for (i = 0; i < poster_count; i++) {
+        hg_thread_join(threads[i]);
+        if (args[i].ret != EXIT_SUCCESS)
+            ret = EXIT_FAILURE;
+    }
+
+    hg_thread_pool_destroy(thread_pool);
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
 int
-main(int argc, char *argv[])
+main(void)
 {
     int i;
     hg_thread_pool_t *thread_pool;
     struct hg_thread_work work[POOL_NUM_POSTS];
+    struct hg_thread_work *batch[POOL_NUM_POSTS];
     int ret = EXIT_SUCCESS;
 
-    (void) argc;
-    (void) argv;
     hg_thread_mutex_init(&mymutex);
     hg_thread_pool_init(HG_TEST_NUM_THREADS_DEFAULT, &thread_pool);
 
@@ -64,12 +176,45 @@ main(int argc, char *argv[])
 
     /* printf("Finalizing...\n"); */
     hg_thread_pool_destroy(thread_pool);
-    hg_thread_mutex_destroy(&mymutex);
 
     if (ncalls != POOL_NUM_POSTS) {
         fprintf(stderr, "Did not execute all the operations posted (%u/%d)\n",
             ncalls, POOL_NUM_POSTS);
         ret = EXIT_FAILURE;
+        goto done;
     }
+
+    /* Batch post to a pool whose queues overflow */
+    ncalls = 0;
+    {
+        struct hg_thread_pool_init_info init_info = {
+            .queue_size = 2, .spin_count = 0, .cpu_masks = NULL};
+
+        hg_thread_pool_init_opt(
+            HG_TEST_NUM_THREADS_DEFAULT, &init_info, &thread_pool);
+    }
+    for (i = 0; i < POOL_NUM_POSTS; i++)
+        batch[i] = &work[i];
+    hg_thread_pool_post_n(thread_pool, batch, POOL_NUM_POSTS);
+    hg_thread_pool_destroy(thread_pool);
+
+    if (ncalls != POOL_NUM_POSTS) {
+        fprintf(stderr,
+            "Did not execute all the operations batch posted (%u/%d)\n", ncalls,
+            POOL_NUM_POSTS);
+        ret = EXIT_FAILURE;
+        goto done;
+    }
+
+    /* Tasks posted to an idle pool must always wake up a worker, with one
+     * and with concurrent posters */
+    ret = test_wakeup(1);
+    if (ret != EXIT_SUCCESS)
+        goto done;
+    ret = test_wakeup(HG_TEST_NUM_THREADS_DEFAULT);
+
+done:
+    hg_thread_mutex_destroy(&mymutex);
+
     return ret;
 }
@@ -7,6 +7,7 @@
 #include "mercury.h"
 #include "mercury_bulk.h"
 #include "mercury_error.h"
+#include "mercury_overflow_pool.h"
 #include "mercury_proc.h"
 #include "mercury_proc_bulk.h"
 
@@ -45,6 +46,7 @@ struct hg_private_class {
     hg_thread_spin_t register_lock;                    /* Register lock */
     hg_checksum_level_t checksum_level;                /* Checksum level */
     hg_bool_t bulk_eager;                              /* Eager bulk proc */
+    struct hg_overflow_pool *overflow_pool;            /* Overflow buffers */
 };
 
 /* Info for function map */
@@ -75,6 +77,8 @@ struct hg_private_handle {
     hg_bulk_t out_extra_bulk;           /* Extra output bulk handle */
     hg_size_t in_extra_buf_size;        /* Extra input buffer size */
     hg_size_t out_extra_buf_size;       /* Extra output buffer size */
+    struct hg_mem_pool *in_extra_pool;  /* Extra input buffer pool */
+    struct hg_mem_pool *out_extra_pool; /* Extra output buffer pool */
     hg_bool_t use_checksums;            /* Handle uses checksums */
 };
 
@@ -147,11 +151,12 @@ static HG_INLINE hg_return_t
 hg_core_addr_lookup_cb(const struct hg_core_cb_info *callback_info);
 
 /**
- * Decode and get input/output structure.
+ * Decode and get input/output structure, proc_flags are passed to the proc.
  */
 static hg_return_t
 hg_get_struct(struct hg_private_handle *hg_handle,
-    const struct hg_proc_info *hg_proc_info, hg_op_t op, void *struct_ptr);
+    const struct hg_proc_info *hg_proc_info, hg_op_t op, void *struct_ptr,
+    hg_uint8_t proc_flags);
 
 /**
  * Set and encode input/output structure.
@@ -162,11 +167,13 @@ hg_set_struct(struct hg_private_handle *hg_handle,
     hg_size_t *payload_size, hg_bool_t *more_data);
 
 /**
- * Free allocated members from input/output structure.
+ * Free allocated members from input/output structure, proc_flags must match
+ * the ones passed to hg_get_struct().
  */
 static hg_return_t
 hg_free_struct(struct hg_private_handle *hg_handle,
-    const struct hg_proc_info *hg_proc_info, hg_op_t op, void *struct_ptr);
+    const struct hg_proc_info *hg_proc_info, hg_op_t op, void *struct_ptr,
+    hg_uint8_t proc_flags);
 
 /**
  * Get extra user payload using bulk transfer.
@@ -187,6 +194,13 @@ hg_get_extra_payload_cb(const struct hg_cb_info *callback_info);
 static void
 hg_free_extra_payload(struct hg_private_handle *hg_handle);
 
+/**
+ * Free single extra buffer and its bulk handle.
+ */
+static void
+hg_free_extra_buf(void **extra_buf, hg_size_t *extra_buf_size,
+    hg_bulk_t *extra_bulk, struct hg_mem_pool **extra_pool);
+
 /**
  * Forward callback.
  */
@@ -252,6 +266,10 @@ hg_handle_create(struct hg_private_class *hg_class)
     ret = hg_proc_create((hg_class_t *) hg_class, hash, &hg_handle->out_proc);
     HG_CHECK_HG_ERROR(error, ret, "Cannot create HG proc");
 
+    /* Encode payloads that overflow into pre-registered buffers */
+    hg_proc_set_overflow_pool(hg_handle->in_proc, hg_class->overflow_pool);
+    hg_proc_set_overflow_pool(hg_handle->out_proc, hg_class->overflow_pool);
+
     return hg_handle;
 
 error:
@@ -424,7 +442,8 @@ hg_core_addr_lookup_cb(const struct hg_core_cb_info *callback_info)
 /*---------------------------------------------------------------------------*/
 static hg_return_t
 hg_get_struct(struct hg_private_handle *hg_handle,
-    const struct hg_proc_info *hg_proc_info, hg_op_t op, void *struct_ptr)
+    const struct hg_proc_info *hg_proc_info, hg_op_t op, void *struct_ptr,
+    hg_uint8_t proc_flags)
 {
     hg_proc_t proc = HG_PROC_NULL;
     hg_proc_cb_t proc_cb = NULL;
@@ -507,6 +526,15 @@ hg_get_struct(struct hg_private_handle *hg_handle,
     ret = hg_proc_reset(proc, buf, buf_size, HG_DECODE);
     HG_CHECK_HG_ERROR(done, ret, "Could not reset proc");
 
+#ifndef HG_HAS_XDR
+    /* Views are decoded in place, handle remains referenced until
+     * HG_Free_input_view() is called */
+    if (proc_flags)
+        hg_proc_set_flags(proc, proc_flags);
+#else
+    (void) proc_flags;
+#endif
+
     /* Decode parameters */
     ret = proc_cb(proc, struct_ptr);
     HG_CHECK_HG_ERROR(done, ret, "Could not decode parameters");
@@ -544,6 +572,8 @@ hg_set_struct(struct hg_private_handle *hg_handle,
     void *buf, **extra_buf;
     hg_size_t buf_size, *extra_buf_size;
     hg_bulk_t *extra_bulk;
+    struct hg_mem_pool **extra_pool;
+    hg_size_t extra_offset = 0;
     struct hg_header *hg_header = &hg_handle->hg_header;
 #ifdef HG_HAS_CHECKSUMS
     struct hg_header_hash *hg_header_hash = NULL;
@@ -570,6 +600,7 @@ hg_set_struct(struct hg_private_handle *hg_handle,
             extra_buf = &hg_handle->in_extra_buf;
             extra_buf_size = &hg_handle->in_extra_buf_size;
             extra_bulk = &hg_handle->in_extra_bulk;
+            extra_pool = &hg_handle->in_extra_pool;
             break;
         case HG_OUTPUT:
             /* Cannot respond if no_response flag set */
@@ -594,6 +625,7 @@ hg_set_struct(struct hg_private_handle *hg_handle,
             extra_buf = &hg_handle->out_extra_buf;
             extra_buf_size = &hg_handle->out_extra_buf_size;
             extra_bulk = &hg_handle->out_extra_bulk;
+            extra_pool = &hg_handle->out_extra_pool;
             break;
         default:
             HG_GOTO_ERROR(done, ret, HG_INVALID_ARG, "Invalid HG op");
@@ -653,8 +685,14 @@ hg_set_struct(struct hg_private_handle *hg_handle,
      * it to retrieve the data.
      */
     if (hg_proc_get_extra_buf(proc)) {
-        /* Potentially free previous payload if handle was not reset */
-        hg_free_extra_payload(hg_handle);
+        /* Potentially free previous payload if handle was not reset. When
+         * responding, keep the input payload since decoded input may still
+         * point to it until HG_Free_input_view() is called */
+        if (op == HG_OUTPUT)
+            hg_free_extra_buf(
+                extra_buf, extra_buf_size, extra_bulk, extra_pool);
+        else
+            hg_free_extra_payload(hg_handle);
 #ifdef HG_HAS_XDR
         HG_GOTO_ERROR(done, ret, HG_OVERFLOW,
             "Arguments overflow is not supported with XDR");
@@ -666,10 +704,18 @@ hg_set_struct(struct hg_private_handle *hg_handle,
         /* Prevent buffer from being freed when proc_reset is called */
         hg_proc_set_extra_buf_is_mine(proc, HG_TRUE);
 
-        /* Create bulk descriptor */
-        ret = HG_Bulk_create(hg_handle->handle.info.hg_class, 1, extra_buf,
-            extra_buf_size, HG_BULK_READ_ONLY, extra_bulk);
-        HG_CHECK_HG_ERROR(done, ret, "Could not create bulk data handle");
+        /* Buffers taken from the overflow pool are already registered, only
+         * pass the offset of the buffer within the pool's bulk handle */
+        *extra_pool = hg_proc_get_extra_buf_pool(proc, extra_bulk);
+        if (*extra_pool)
+            extra_offset =
+                hg_overflow_pool_offset(*extra_pool, *extra_buf, *extra_bulk);
+        else {
+            /* Create bulk descriptor */
+            ret = HG_Bulk_create(hg_handle->handle.info.hg_class, 1, extra_buf,
+                extra_buf_size, HG_BULK_READ_ONLY, extra_bulk);
+            HG_CHECK_HG_ERROR(done, ret, "Could not create bulk data handle");
+        }
 
         /* Reset proc */
         ret = hg_proc_reset(proc, buf, buf_size, HG_ENCODE);
@@ -698,6 +744,12 @@ hg_set_struct(struct hg_private_handle *hg_handle,
         ret = hg_proc_hg_bulk_t(proc, extra_bulk);
         HG_CHECK_HG_ERROR(done, ret, "Could not process extra bulk handle");
 
+        ret = hg_proc_hg_size_t(proc, &extra_offset);
+        HG_CHECK_HG_ERROR(done, ret, "Could not process extra bulk offset");
+
+        ret = hg_proc_hg_size_t(proc, extra_buf_size);
+        HG_CHECK_HG_ERROR(done, ret, "Could not process extra bulk size");
+
         ret = hg_proc_flush(proc);
         HG_CHECK_HG_ERROR(done, ret, "Error in proc flush");
 
@@ -728,7 +780,8 @@ done:
 /*---------------------------------------------------------------------------*/
 static hg_return_t
 hg_free_struct(struct hg_private_handle *hg_handle,
-    const struct hg_proc_info *hg_proc_info, hg_op_t op, void *struct_ptr)
+    const struct hg_proc_info *hg_proc_info, hg_op_t op, void *struct_ptr,
+    hg_uint8_t proc_flags)
 {
     void *buf = NULL;
     hg_size_t buf_size = 0;
@@ -778,6 +831,14 @@ hg_free_struct(struct hg_private_handle *hg_handle,
     ret = hg_proc_reset(proc, buf, buf_size, HG_FREE);
     HG_CHECK_HG_ERROR(done, ret, "Could not reset proc");
 
+#ifndef HG_HAS_XDR
+    /* Nothing to free for views that were decoded in place */
+    if (proc_flags)
+        hg_proc_set_flags(proc, proc_flags);
+#else
+    (void) proc_flags;
+#endif
+
     /* Free memory allocated during decode operation */
     ret = proc_cb(proc, struct_ptr);
     HG_CHECK_HG_ERROR(done, ret, "Could not free allocated parameters");
@@ -801,6 +862,10 @@ hg_get_extra_payload(struct hg_private_handle *hg_handle, hg_op_t op,
     void *buf, **extra_buf;
     hg_size_t buf_size, *extra_buf_size;
     hg_bulk_t *extra_bulk = NULL;
+    struct hg_mem_pool **extra_pool = NULL;
+    struct hg_overflow_pool *overflow_pool =
+        HG_HANDLE_CLASS(&hg_handle->handle)->overflow_pool;
+    hg_size_t extra_offset = 0, local_offset = 0, alloc_size;
     hg_size_t header_offset = hg_header_get_size(op);
     hg_size_t page_size = (hg_size_t) hg_mem_get_page_size();
     hg_bulk_t local_handle = HG_BULK_NULL;
@@ -820,6 +885,7 @@ hg_get_extra_payload(struct hg_private_handle *hg_handle, hg_op_t op,
             extra_buf = &hg_handle->in_extra_buf;
             extra_buf_size = &hg_handle->in_extra_buf_size;
             extra_bulk = &hg_handle->in_extra_bulk;
+            extra_pool = &hg_handle->in_extra_pool;
             break;
         case HG_OUTPUT:
             /* Use custom header offset */
@@ -834,6 +900,7 @@ hg_get_extra_payload(struct hg_private_handle *hg_handle, hg_op_t op,
             extra_buf = &hg_handle->out_extra_buf;
             extra_buf_size = &hg_handle->out_extra_buf_size;
             extra_bulk = &hg_handle->out_extra_bulk;
+            extra_pool = &hg_handle->out_extra_pool;
             break;
         default:
             HG_GOTO_ERROR(done, ret, HG_INVALID_ARG, "Invalid HG op");
@@ -850,34 +917,54 @@ hg_get_extra_payload(struct hg_private_handle *hg_handle, hg_op_t op,
     ret = hg_proc_hg_bulk_t(proc, extra_bulk);
     HG_CHECK_HG_ERROR(done, ret, "Could not process extra bulk handle");
 
+    ret = hg_proc_hg_size_t(proc, &extra_offset);
+    HG_CHECK_HG_ERROR(done, ret, "Could not process extra bulk offset");
+
+    ret = hg_proc_hg_size_t(proc, extra_buf_size);
+    HG_CHECK_HG_ERROR(done, ret, "Could not process extra bulk size");
+
     ret = hg_proc_flush(proc);
     HG_CHECK_HG_ERROR(done, ret, "Error in proc flush");
 
-    /* Create a new local handle to read the data */
-    *extra_buf_size = HG_Bulk_get_size(*extra_bulk);
-    *extra_buf = hg_mem_aligned_alloc(page_size, *extra_buf_size);
-    HG_CHECK_ERROR(*extra_buf == NULL, done, ret, HG_NOMEM,
-        "Could not allocate extra payload buffer");
+    /* Pull into a pre-registered buffer if there is one large enough */
+    *extra_buf = (overflow_pool)
+                     ? hg_overflow_pool_alloc(overflow_pool, *extra_buf_size,
+                           HG_BULK_WRITE_ONLY, &alloc_size, extra_pool,
+                           &local_handle)
+                     : NULL;
+    if (*extra_buf)
+        local_offset =
+            hg_overflow_pool_offset(*extra_pool, *extra_buf, local_handle);
+    else {
+        /* Create a new local handle to read the data */
+        *extra_buf = hg_mem_aligned_alloc(page_size, *extra_buf_size);
+        HG_CHECK_ERROR(*extra_buf == NULL, done, ret, HG_NOMEM,
+            "Could not allocate extra payload buffer");
 
-    ret = HG_Bulk_create(hg_handle->handle.info.hg_class, 1, extra_buf,
-        extra_buf_size, HG_BULK_READWRITE, &local_handle);
-    HG_CHECK_HG_ERROR(done, ret, "Could not create HG bulk handle");
+        ret = HG_Bulk_create(hg_handle->handle.info.hg_class, 1, extra_buf,
+            extra_buf_size, HG_BULK_WRITE_ONLY, &local_handle);
+        HG_CHECK_HG_ERROR(done, ret, "Could not create HG bulk handle");
+    }
 
     /* Read bulk data here and wait for the data to be here  */
     hg_handle->extra_bulk_transfer_cb = done_cb;
     ret = HG_Bulk_transfer_id(hg_handle->handle.info.context,
         hg_get_extra_payload_cb, hg_handle, HG_BULK_PULL,
         (hg_addr_t) hg_core_info->addr, hg_core_info->context_id, *extra_bulk,
-        0, local_handle, 0, *extra_buf_size,
+        extra_offset, local_handle, local_offset, *extra_buf_size,
         HG_OP_ID_IGNORE /* TODO not used for now */);
     HG_CHECK_HG_ERROR(done, ret, "Could not transfer bulk data");
 
 done:
-    HG_Bulk_free(local_handle);
     if (extra_bulk) {
         HG_Bulk_free(*extra_bulk);
         *extra_bulk = HG_BULK_NULL;
     }
+    /* Keep pool handle, it is needed to release the buffer to the pool */
+    if (extra_pool && *extra_pool)
+        *extra_bulk = local_handle;
+    else
+        HG_Bulk_free(local_handle);
     return ret;
 }
 
@@ -899,21 +986,32 @@ static void
 hg_free_extra_payload(struct hg_private_handle *hg_handle)
 {
     /* Free extra bulk buf if there was any */
-    if (hg_handle->in_extra_buf) {
-        HG_Bulk_free(hg_handle->in_extra_bulk);
-        hg_handle->in_extra_bulk = HG_BULK_NULL;
-        hg_mem_aligned_free(hg_handle->in_extra_buf);
-        hg_handle->in_extra_buf = NULL;
-        hg_handle->in_extra_buf_size = 0;
-    }
+    hg_free_extra_buf(&hg_handle->in_extra_buf, &hg_handle->in_extra_buf_size,
+        &hg_handle->in_extra_bulk, &hg_handle->in_extra_pool);
+    hg_free_extra_buf(&hg_handle->out_extra_buf,
+        &hg_handle->out_extra_buf_size, &hg_handle->out_extra_bulk,
+        &hg_handle->out_extra_pool);
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+hg_free_extra_buf(void **extra_buf, hg_size_t *extra_buf_size,
+    hg_bulk_t *extra_bulk, struct hg_mem_pool **extra_pool)
+{
+    if (*extra_buf == NULL)
+        return;
 
-    if (hg_handle->out_extra_buf) {
-        HG_Bulk_free(hg_handle->out_extra_bulk);
-        hg_handle->out_extra_bulk = HG_BULK_NULL;
-        hg_mem_aligned_free(hg_handle->out_extra_buf);
-        hg_handle->out_extra_buf = NULL;
-        hg_handle->out_extra_buf_size = 0;
+    if (*extra_pool) {
+        /* Bulk handle is owned by the pool */
+        hg_overflow_pool_free(*extra_pool, *extra_buf, *extra_bulk);
+        *extra_pool = NULL;
+    } else {
+        HG_Bulk_free(*extra_bulk);
+        hg_mem_aligned_free(*extra_buf);
     }
+    *extra_bulk = HG_BULK_NULL;
+    *extra_buf = NULL;
+    *extra_buf_size = 0;
 }
 
 /*---------------------------------------------------------------------------*/
@@ -1023,10 +1121,19 @@ HG_Init_opt(const char *na_info_string, hg_bool_t na_listen,
     HG_Core_set_more_data_callback(
         hg_class->hg_class.core_class, hg_more_data_cb, hg_more_data_free_cb);
 
+#ifndef HG_HAS_XDR
+    /* Pre-registered buffers for payloads that exceed the eager size */
+    hg_class->overflow_pool = hg_overflow_pool_create((hg_class_t *) hg_class);
+    HG_CHECK_ERROR_NORET(hg_class->overflow_pool == NULL, error,
+        "Could not create overflow pool");
+#endif
+
     return (hg_class_t *) hg_class;
 
 error:
     if (hg_class) {
+        if (hg_class->hg_class.core_class)
+            HG_Core_finalize(hg_class->hg_class.core_class);
         hg_thread_spin_destroy(&hg_class->register_lock);
         free(hg_class);
     }
@@ -1041,6 +1148,10 @@ HG_Finalize(hg_class_t *hg_class)
         (struct hg_private_class *) hg_class;
     hg_return_t ret = HG_SUCCESS;
 
+    /* Buffers must be deregistered before the core class goes away */
+    hg_overflow_pool_destroy(private_class->overflow_pool);
+    private_class->overflow_pool = NULL;
+
     ret = HG_Core_finalize(private_class->hg_class.core_class);
     HG_CHECK_HG_ERROR(done, ret, "Could not finalize HG core class");
 
@@ -1188,6 +1299,42 @@ done:
     return ret;
 }
 
+/*---------------------------------------------------------------------------*/
+hg_return_t
+HG_Context_get_progress_stats(
+    const hg_context_t *context, struct hg_progress_stats *stats)
+{
+    hg_return_t ret = HG_SUCCESS;
+
+    HG_CHECK_ERROR(
+        context == NULL, done, ret, HG_INVALID_ARG, "NULL HG context");
+
+    ret = HG_Core_context_get_progress_stats(context->core_context, stats);
+    HG_CHECK_HG_ERROR(done, ret, "Could not get progress stats (%s)",
+        HG_Error_to_string(ret));
+
+done:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+hg_return_t
+HG_Context_get_post_stats(
+    const hg_context_t *context, struct hg_post_stats *stats)
+{
+    hg_return_t ret = HG_SUCCESS;
+
+    HG_CHECK_ERROR(
+        context == NULL, done, ret, HG_INVALID_ARG, "NULL HG context");
+
+    ret = HG_Core_context_get_post_stats(context->core_context, stats);
+    HG_CHECK_HG_ERROR(
+        done, ret, "Could not get post stats (%s)", HG_Error_to_string(ret));
+
+done:
+    return ret;
+}
+
 /*---------------------------------------------------------------------------*/
 hg_id_t
 HG_Register_name(hg_class_t *hg_class, const char *func_name,
@@ -1764,8 +1911,8 @@ HG_Get_input(hg_handle_t handle, void *in_struct)
         hg_proc_info == NULL, done, ret, HG_FAULT, "Could not get proc info");
 
     /* Get input struct */
-    ret = hg_get_struct(
-        (struct hg_private_handle *) handle, hg_proc_info, HG_INPUT, in_struct);
+    ret = hg_get_struct((struct hg_private_handle *) handle, hg_proc_info,
+        HG_INPUT, in_struct, 0);
     HG_CHECK_HG_ERROR(
         done, ret, "Could not get input (%s)", HG_Error_to_string(ret));
 
@@ -1792,8 +1939,8 @@ HG_Free_input(hg_handle_t handle, void *in_struct)
         hg_proc_info == NULL, done, ret, HG_FAULT, "Could not get proc info");
 
     /* Free input struct */
-    ret = hg_free_struct(
-        (struct hg_private_handle *) handle, hg_proc_info, HG_INPUT, in_struct);
+    ret = hg_free_struct((struct hg_private_handle *) handle, hg_proc_info,
+        HG_INPUT, in_struct, 0);
     HG_CHECK_HG_ERROR(
         done, ret, "Could not free input (%s)", HG_Error_to_string(ret));
 
@@ -1801,6 +1948,62 @@ done:
     return ret;
 }
 
+/*---------------------------------------------------------------------------*/
+hg_return_t
+HG_Get_input_view(hg_handle_t handle, void *in_struct)
+{
+    const struct hg_proc_info *hg_proc_info;
+    hg_return_t ret = HG_SUCCESS;
+
+    HG_CHECK_ERROR(
+        handle == HG_HANDLE_NULL, done, ret, HG_INVALID_ARG, "NULL HG handle");
+    HG_CHECK_ERROR(in_struct == NULL, done, ret, HG_INVALID_ARG,
+        "NULL pointer to input struct");
+
+    /* Retrieve RPC data */
+    hg_proc_info =
+        (const struct hg_proc_info *) HG_Core_get_rpc_data(handle->core_handle);
+    HG_CHECK_ERROR(
+        hg_proc_info == NULL, done, ret, HG_FAULT, "Could not get proc info");
+
+    /* Get input struct */
+    ret = hg_get_struct((struct hg_private_handle *) handle, hg_proc_info,
+        HG_INPUT, in_struct, HG_PROC_ZERO_COPY);
+    HG_CHECK_HG_ERROR(
+        done, ret, "Could not get input view (%s)", HG_Error_to_string(ret));
+
+done:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+hg_return_t
+HG_Free_input_view(hg_handle_t handle, void *in_struct)
+{
+    const struct hg_proc_info *hg_proc_info;
+    hg_return_t ret = HG_SUCCESS;
+
+    HG_CHECK_ERROR(
+        handle == HG_HANDLE_NULL, done, ret, HG_INVALID_ARG, "NULL HG handle");
+    HG_CHECK_ERROR(in_struct == NULL, done, ret, HG_INVALID_ARG,
+        "NULL pointer to input struct");
+
+    /* Retrieve RPC data */
+    hg_proc_info =
+        (const struct hg_proc_info *) HG_Core_get_rpc_data(handle->core_handle);
+    HG_CHECK_ERROR(
+        hg_proc_info == NULL, done, ret, HG_FAULT, "Could not get proc info");
+
+    /* Free input struct */
+    ret = hg_free_struct((struct hg_private_handle *) handle, hg_proc_info,
+        HG_INPUT, in_struct, HG_PROC_ZERO_COPY);
+    HG_CHECK_HG_ERROR(
+        done, ret, "Could not free input view (%s)", HG_Error_to_string(ret));
+
+done:
+    return ret;
+}
+
 /*---------------------------------------------------------------------------*/
 hg_return_t
 HG_Get_output(hg_handle_t handle, void *out_struct)
@@ -1821,7 +2024,7 @@ HG_Get_output(hg_handle_t handle, void *out_struct)
 
     /* Get output struct */
     ret = hg_get_struct((struct hg_private_handle *) handle, hg_proc_info,
-        HG_OUTPUT, out_struct);
+        HG_OUTPUT, out_struct, 0);
     HG_CHECK_HG_ERROR(
         done, ret, "Could not get output (%s)", HG_Error_to_string(ret));
 
@@ -1849,7 +2052,7 @@ HG_Free_output(hg_handle_t handle, void *out_struct)
 
     /* Free output struct */
     ret = hg_free_struct((struct hg_private_handle *) handle, hg_proc_info,
-        HG_OUTPUT, out_struct);
+        HG_OUTPUT, out_struct, 0);
     HG_CHECK_HG_ERROR(
         done, ret, "Could not free output (%s)", HG_Error_to_string(ret));
 
@@ -2096,6 +2299,26 @@ done:
     return ret;
 }
 
+/*---------------------------------------------------------------------------*/
+hg_return_t
+HG_Trigger_batch(hg_context_t *context, unsigned int timeout,
+    unsigned int max_count, unsigned int *actual_count)
+{
+    hg_return_t ret = HG_SUCCESS;
+
+    HG_CHECK_ERROR(
+        context == NULL, done, ret, HG_INVALID_ARG, "NULL HG context");
+
+    ret = HG_Core_trigger_batch(
+        context->core_context, timeout, max_count, actual_count);
+    HG_CHECK_ERROR_NORET(ret != HG_SUCCESS && ret != HG_TIMEOUT, done,
+        "Could not trigger batch of operations from context (%s)",
+        HG_Error_to_string(ret));
+
+done:
+    return ret;
+}
+
 /*---------------------------------------------------------------------------*/
 hg_return_t
 HG_Cancel(hg_handle_t handle)
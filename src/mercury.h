@@ -355,6 +355,32 @@ HG_Context_set_data(
 static HG_INLINE void *
 HG_Context_get_data(const hg_context_t *context);
 
+/**
+ * Retrieve progress statistics of a given context, see hg_progress_stats for
+ * the meaning of each count.
+ *
+ * \param context [IN]          pointer to HG context
+ * \param stats [OUT]           pointer to progress stats
+ *
+ * \return HG_SUCCESS or corresponding HG error code
+ */
+HG_PUBLIC hg_return_t
+HG_Context_get_progress_stats(
+    const hg_context_t *context, struct hg_progress_stats *stats);
+
+/**
+ * Retrieve statistics of requests posted for incoming RPCs on a given context,
+ * see hg_post_stats for the meaning of each count.
+ *
+ * \param context [IN]          pointer to HG context
+ * \param stats [OUT]           pointer to post stats
+ *
+ * \return HG_SUCCESS or corresponding HG error code
+ */
+HG_PUBLIC hg_return_t
+HG_Context_get_post_stats(
+    const hg_context_t *context, struct hg_post_stats *stats);
+
 /**
  * Dynamically register a function func_name as an RPC as well as the
  * RPC callback executed when the RPC request ID associated to func_name is
@@ -751,6 +777,37 @@ HG_Get_input(hg_handle_t handle, void *in_struct);
 HG_PUBLIC hg_return_t
 HG_Free_input(hg_handle_t handle, void *in_struct);
 
+/**
+ * Get input from handle without copying strings and byte views
+ * (hg_bytes_view_t), which are decoded in place and point directly into the
+ * core input buffer, or the extra input buffer for large payloads. Input must
+ * be freed using HG_Free_input_view().
+ *
+ * \remark Decoded strings and views are only valid until HG_Free_input_view()
+ * is called, the handle remaining referenced until then. They must not be
+ * freed or replaced by the user. With XDR encoding, data is copied as with
+ * HG_Get_input().
+ *
+ * \param handle [IN]           HG handle
+ * \param in_struct [IN/OUT]    pointer to input structure
+ *
+ * \return HG_SUCCESS or corresponding HG error code
+ */
+HG_PUBLIC hg_return_t
+HG_Get_input_view(hg_handle_t handle, void *in_struct);
+
+/**
+ * Free resources allocated when deserializing the input with
+ * HG_Get_input_view(). Strings and byte views decoded in place are not freed.
+ *
+ * \param handle [IN]           HG handle
+ * \param in_struct [IN/OUT]    pointer to input structure
+ *
+ * \return HG_SUCCESS or corresponding HG error code
+ */
+HG_PUBLIC hg_return_t
+HG_Free_input_view(hg_handle_t handle, void *in_struct);
+
 /**
  * Get output from handle (requires registration of output proc to deserialize
  * parameters). Output must be freed using HG_Free_output().
@@ -941,7 +998,7 @@ HG_Progress(hg_context_t *context, unsigned int timeout);
  * \param context [IN]          pointer to HG context
  * \param timeout [IN]          timeout (in milliseconds)
  * \param max_count [IN]        maximum number of callbacks triggered
- * \param actual_count [IN]     actual number of callbacks triggered
+ * \param actual_count [OUT]    actual number of callbacks triggered
  *
  * \return HG_SUCCESS or corresponding HG error code
  */
@@ -949,6 +1006,25 @@ HG_PUBLIC hg_return_t
 HG_Trigger(hg_context_t *context, unsigned int timeout, unsigned int max_count,
     unsigned int *actual_count);
 
+/**
+ * Execute at most max_count callbacks in a single pass. Unlike HG_Trigger(),
+ * completed operations are dequeued in batches before their callbacks get
+ * executed and only the callbacks that were already queued when the call was
+ * made are triggered (callbacks that get queued while executing that batch are
+ * deferred to the next call). If timeout is non-zero, wait up to timeout for
+ * at least one callback to be queued.
+ *
+ * \param context [IN]          pointer to HG context
+ * \param timeout [IN]          timeout (in milliseconds)
+ * \param max_count [IN]        maximum number of callbacks triggered
+ * \param actual_count [OUT]    actual number of callbacks triggered
+ *
+ * \return HG_SUCCESS or corresponding HG error code
+ */
+HG_PUBLIC hg_return_t
+HG_Trigger_batch(hg_context_t *context, unsigned int timeout,
+    unsigned int max_count, unsigned int *actual_count);
+
 /**
  * Cancel an ongoing operation.
  *
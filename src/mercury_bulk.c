@@ -11,7 +11,10 @@
 #include "mercury_private.h"
 
 #include "mercury_atomic.h"
+#include "mercury_hash_table.h"
 #include "mercury_list.h"
+#include "mercury_mem.h"
+#include "mercury_thread_cache.h"
 #include "mercury_thread_condition.h"
 #include "mercury_thread_spin.h"
 
@@ -25,12 +28,20 @@
 /* Limit for number of segments statically allocated */
 #define HG_BULK_STATIC_MAX (8)
 
+/* Number of free op IDs cached per thread magazine */
+#define HG_BULK_OP_CACHE_SIZE (64)
+
 /* Additional internal bulk flags (can hold up to 8 bits) */
 #define HG_BULK_ALLOC (1 << 4) /* memory is allocated */
 #define HG_BULK_BIND  (1 << 5) /* address is bound to segment */
 #define HG_BULK_REGV  (1 << 6) /* single registration for multiple segments */
 #define HG_BULK_VIRT  (1 << 7) /* addresses are virtual */
 
+/* Align internally allocated segments on cache lines */
+#define HG_BULK_ALLOC_ALIGN(len)                                               \
+    (((len) + HG_MEM_CACHE_LINE_SIZE - 1) &                                    \
+        ~((hg_size_t) HG_MEM_CACHE_LINE_SIZE - 1))
+
 /* Op ID status bits */
 #define HG_BULK_OP_COMPLETED (1 << 0)
 #define HG_BULK_OP_CANCELED  (1 << 1)
@@ -171,6 +182,8 @@ struct hg_bulk {
 #endif
     struct hg_bulk_attr attrs;   /* Memory attributes */
     hg_core_addr_t addr;         /* Addr (valid if bound to handle) */
+    void *alloc_buf;             /* Memory allocated from NA */
+    na_class_t *alloc_class;     /* NA class of allocated memory */
     void *serialize_ptr;         /* Cached serialization buffer */
     hg_size_t serialize_size;    /* Cached serialization size */
     hg_atomic_int32_t ref_count; /* Reference count */
@@ -184,12 +197,10 @@ typedef struct {
     na_op_id_t **d;                    /* Dynamic array */
 } hg_bulk_na_op_id_t;
 
-/* HG Bulk op ID */
+/* HG Bulk op ID, fields written by NA callbacks on completion are kept on a
+ * separate cache line from fields written when the operation is posted */
 struct hg_bulk_op_id {
-    struct hg_completion_entry
-        hg_completion_entry;              /* Entry in completion queue */
     struct hg_cb_info callback_info;      /* Callback info struct */
-    HG_LIST_ENTRY(hg_bulk_op_id) pending; /* Pending list entry */
     struct hg_bulk_op_pool *op_pool;      /* Pool that op ID belongs to */
     hg_cb_t callback;                     /* Pointer to function */
     hg_bulk_na_op_id_t na_op_ids;         /* NA operations IDs */
@@ -199,23 +210,78 @@ struct hg_bulk_op_id {
     hg_core_context_t *core_context;      /* Context */
     na_class_t *na_class;                 /* NA class */
     na_context_t *na_context;             /* NA context */
-    hg_atomic_int32_t status;             /* Operation status */
-    hg_atomic_int32_t ret_status;         /* Return status */
-    hg_atomic_int32_t op_completed_count; /* Number of operations completed */
     hg_atomic_int32_t ref_count;          /* Refcount */
+    struct hg_bulk_chunk *chunk;          /* Chunked transfer (or NULL) */
     hg_uint32_t op_count;                 /* Number of ongoing operations */
     hg_bool_t reuse;                      /* Re-use op ID once ref_count is 0 */
+    HG_UTIL_ALIGNED(hg_atomic_int32_t status,
+        HG_MEM_CACHE_LINE_SIZE);          /* Operation status */
+    hg_atomic_int32_t ret_status;         /* Return status */
+    hg_atomic_int32_t op_completed_count; /* Number of operations completed */
+    struct hg_completion_entry
+        hg_completion_entry;              /* Entry in completion queue */
+};
+
+/* Chunk of a chunked transfer */
+struct hg_bulk_chunk_slot {
+    struct hg_bulk_chunk *chunk; /* Chunked transfer */
+    struct hg_bulk_op_id *op_id; /* Op ID of chunk in flight (or NULL) */
+    hg_size_t offset;            /* Offset of chunk from start of transfer */
+};
+
+/* Chunked transfer */
+struct hg_bulk_chunk {
+    struct hg_bulk_chunk_info info;      /* Chunk options */
+    hg_thread_mutex_t mutex;             /* Mutex protecting issue state */
+    struct hg_bulk_op_id *hg_bulk_op_id; /* Op ID returned to user */
+    struct hg_core_addr *origin_addr;    /* Origin address */
+    hg_size_t origin_offset;             /* Origin offset */
+    hg_size_t local_offset;              /* Local offset */
+    hg_size_t next_offset;               /* Offset of next chunk to issue */
+    hg_uint32_t in_flight;               /* Number of chunks in flight */
+    hg_uint8_t origin_id;                /* Origin context ID */
+    struct hg_bulk_chunk_slot slots[];   /* Chunks in flight */
 };
 
 /* Pool of op IDs */
 struct hg_bulk_op_pool {
-    hg_thread_mutex_t extend_mutex;           /* To extend pool */
-    hg_thread_cond_t extend_cond;             /* To extend pool */
-    hg_core_context_t *core_context;          /* Context */
-    HG_LIST_HEAD(hg_bulk_op_id) pending_list; /* Pending op IDs */
-    hg_thread_spin_t pending_list_lock;       /* Pending list lock */
-    unsigned long count;                      /* Number of op IDs */
-    hg_bool_t extending;                      /* When extending the pool */
+    hg_core_context_t *core_context; /* Context */
+    struct hg_thread_cache *cache;   /* Per-thread cache of free op IDs */
+};
+
+/* Registered memory range */
+struct hg_bulk_cache_key {
+    hg_ptr_t base;             /* Base address */
+    hg_size_t len;             /* Length in bytes */
+    unsigned long flags;       /* Access flags */
+    enum na_mem_type mem_type; /* Memory type */
+    uint64_t device;           /* Device ID */
+};
+
+/* Cached registration */
+struct hg_bulk_cache_entry {
+    struct hg_bulk_cache_key key;          /* Registered range */
+    struct hg_bulk_cache_entry *lru_prev;  /* More recently used entry */
+    struct hg_bulk_cache_entry *lru_next;  /* Less recently used entry */
+    na_mem_handle_t mem_handle;            /* NA memory handle */
+    size_t serialize_size;                 /* Cached serialize size */
+    unsigned int ref_count;                /* Number of users */
+    hg_bool_t valid;                       /* Entry can be looked up */
+};
+
+/* Cache of registrations */
+struct hg_bulk_cache {
+    hg_hash_table_t *entries;              /* Valid entries by range */
+    hg_hash_table_t *handles;              /* All entries by NA mem handle */
+    struct hg_bulk_cache_entry *lru_head;  /* Most recently used unused entry */
+    struct hg_bulk_cache_entry *lru_tail;  /* Least recently used one */
+    na_class_t *na_class;                  /* NA class */
+    hg_thread_spin_t lock;                 /* Lock */
+    hg_size_t size;                        /* Registered bytes */
+    hg_size_t max_size;                    /* Max registered bytes */
+    hg_uint64_t hit_count;                 /* Number of cache hits */
+    hg_uint64_t miss_count;                /* Number of cache misses */
+    hg_uint32_t unused_count;              /* Number of entries in LRU list */
 };
 
 /* Wrapper on top of memcpy */
@@ -230,6 +296,13 @@ typedef na_return_t (*na_bulk_op_t)(na_class_t *na_class, na_context_t *context,
     na_offset_t remote_offset, size_t data_size, na_addr_t remote_addr,
     uint8_t remote_id, na_op_id_t *op_id);
 
+/* Wrapper on top of vectored NA layer */
+typedef na_return_t (*na_bulk_opv_t)(na_class_t *na_class,
+    na_context_t *context, na_cb_t callback, void *arg,
+    const struct na_rma_iov *local_iov, size_t local_iovcnt,
+    const struct na_rma_iov *remote_iov, size_t remote_iovcnt,
+    na_addr_t remote_addr, uint8_t remote_id, na_op_id_t *op_id);
+
 /********************/
 /* Local Prototypes */
 /********************/
@@ -253,23 +326,26 @@ hg_bulk_free(struct hg_bulk *hg_bulk);
  */
 static hg_return_t
 hg_bulk_create_na_mem_descs(struct hg_bulk_na_mem_desc *na_mem_descs,
-    na_class_t *na_class, struct hg_bulk_segment *segments, hg_uint32_t count,
-    hg_uint8_t flags, enum na_mem_type mem_type, uint64_t device);
+    struct hg_bulk_cache *hg_bulk_cache, na_class_t *na_class,
+    struct hg_bulk_segment *segments, hg_uint32_t count, hg_uint8_t flags,
+    enum na_mem_type mem_type, uint64_t device);
 
 /**
  * Free NA memory descriptors.
  */
 static hg_return_t
 hg_bulk_free_na_mem_descs(struct hg_bulk_na_mem_desc *na_mem_descs,
-    na_class_t *na_class, hg_uint32_t count, bool registered);
+    struct hg_bulk_cache *hg_bulk_cache, na_class_t *na_class,
+    hg_uint32_t count, bool registered);
 
 /**
- * Register single segment.
+ * Register single segment, using cache if not NULL.
  */
 static hg_return_t
-hg_bulk_register(na_class_t *na_class, void *base, size_t len,
-    unsigned long flags, enum na_mem_type mem_type, uint64_t device,
-    na_mem_handle_t *mem_handle_ptr, size_t *serialize_size_ptr);
+hg_bulk_register(struct hg_bulk_cache *hg_bulk_cache, na_class_t *na_class,
+    void *base, size_t len, unsigned long flags, enum na_mem_type mem_type,
+    uint64_t device, na_mem_handle_t *mem_handle_ptr,
+    size_t *serialize_size_ptr);
 
 /**
  * Register multiple segments.
@@ -281,11 +357,102 @@ hg_bulk_register_segments(na_class_t *na_class, struct na_segment *segments,
     size_t *serialize_size_ptr);
 
 /**
- * Deregister segment.
+ * Deregister segment, release it to cache if it was taken from cache.
+ */
+static hg_return_t
+hg_bulk_deregister(struct hg_bulk_cache *hg_bulk_cache, na_class_t *na_class,
+    na_mem_handle_t mem_handle, bool registered);
+
+/**
+ * Hash registered range.
+ */
+static HG_INLINE unsigned int
+hg_bulk_cache_key_hash(hg_hash_table_key_t key);
+
+/**
+ * Compare registered ranges.
+ */
+static HG_INLINE int
+hg_bulk_cache_key_equal(hg_hash_table_key_t key1, hg_hash_table_key_t key2);
+
+/**
+ * Hash NA memory handle.
+ */
+static HG_INLINE unsigned int
+hg_bulk_cache_handle_hash(hg_hash_table_key_t key);
+
+/**
+ * Compare NA memory handles.
+ */
+static HG_INLINE int
+hg_bulk_cache_handle_equal(
+    hg_hash_table_key_t key1, hg_hash_table_key_t key2);
+
+/**
+ * Get registration from cache or register and add it to cache.
  */
 static hg_return_t
-hg_bulk_deregister(
-    na_class_t *na_class, na_mem_handle_t mem_handle, bool registered);
+hg_bulk_cache_register(struct hg_bulk_cache *hg_bulk_cache, void *base,
+    size_t len, unsigned long flags, enum na_mem_type mem_type,
+    uint64_t device, na_mem_handle_t *mem_handle_ptr,
+    size_t *serialize_size_ptr);
+
+/**
+ * Release registration to cache. Return false if registration is not cached.
+ */
+static hg_bool_t
+hg_bulk_cache_release(
+    struct hg_bulk_cache *hg_bulk_cache, na_mem_handle_t mem_handle);
+
+/**
+ * Remove cached registrations overlapping range.
+ */
+static void
+hg_bulk_cache_invalidate(
+    struct hg_bulk_cache *hg_bulk_cache, hg_ptr_t base, hg_size_t len);
+
+/**
+ * Add cache stats to \stats.
+ */
+static void
+hg_bulk_cache_get_stats(struct hg_bulk_cache *hg_bulk_cache,
+    struct hg_bulk_cache_stats *stats);
+
+/**
+ * Insert unused entry at head of LRU list.
+ */
+static HG_INLINE void
+hg_bulk_cache_lru_push(struct hg_bulk_cache *hg_bulk_cache,
+    struct hg_bulk_cache_entry *hg_bulk_cache_entry);
+
+/**
+ * Remove entry from LRU list.
+ */
+static HG_INLINE void
+hg_bulk_cache_lru_remove(struct hg_bulk_cache *hg_bulk_cache,
+    struct hg_bulk_cache_entry *hg_bulk_cache_entry);
+
+/**
+ * Remove entry from cache and chain it to list of entries to deregister.
+ */
+static void
+hg_bulk_cache_remove(struct hg_bulk_cache *hg_bulk_cache,
+    struct hg_bulk_cache_entry *hg_bulk_cache_entry,
+    struct hg_bulk_cache_entry **free_list);
+
+/**
+ * Remove least recently used entries until cache size is below max size.
+ */
+static void
+hg_bulk_cache_evict(struct hg_bulk_cache *hg_bulk_cache,
+    struct hg_bulk_cache_entry **free_list);
+
+/**
+ * Deregister and free list of entries.
+ */
+static void
+hg_bulk_cache_free_list(struct hg_bulk_cache *hg_bulk_cache,
+    struct hg_bulk_cache_entry *free_list);
 
 /**
  * Get serialize size.
@@ -359,6 +526,18 @@ hg_bulk_op_create(
 static hg_return_t
 hg_bulk_op_destroy(struct hg_bulk_op_id *hg_bulk_op_id);
 
+/**
+ * Allocate bulk operation ID for pool cache.
+ */
+static void *
+hg_bulk_op_pool_alloc(void *arg);
+
+/**
+ * Free bulk operation ID from pool cache.
+ */
+static void
+hg_bulk_op_pool_free(void *obj, void *arg);
+
 /**
  * Retrive bulk operation ID from pool.
  */
@@ -376,6 +555,36 @@ hg_bulk_transfer(hg_core_context_t *core_context, hg_cb_t callback, void *arg,
     struct hg_bulk *hg_bulk_local, hg_size_t local_offset, hg_size_t size,
     hg_op_id_t *op_id);
 
+/**
+ * Chunked bulk transfer.
+ */
+static hg_return_t
+hg_bulk_transfer_chunked(hg_core_context_t *core_context, hg_cb_t callback,
+    void *arg, hg_bulk_op_t op, struct hg_core_addr *origin_addr,
+    hg_uint8_t origin_id, struct hg_bulk *hg_bulk_origin,
+    hg_size_t origin_offset, struct hg_bulk *hg_bulk_local,
+    hg_size_t local_offset, hg_size_t size,
+    const struct hg_bulk_chunk_info *chunk_info, hg_op_id_t *op_id);
+
+/**
+ * Issue chunks until the max number of chunks in flight is reached (must be
+ * called with chunk mutex held).
+ */
+static hg_return_t
+hg_bulk_chunk_issue(struct hg_bulk_chunk *hg_bulk_chunk);
+
+/**
+ * Chunk transfer callback.
+ */
+static hg_return_t
+hg_bulk_chunk_cb(const struct hg_cb_info *callback_info);
+
+/**
+ * Cancel chunks in flight.
+ */
+static hg_return_t
+hg_bulk_chunk_cancel(struct hg_bulk_chunk *hg_bulk_chunk);
+
 /**
  * Bulk transfer to self.
  */
@@ -457,6 +666,23 @@ hg_bulk_transfer_segments_na(na_class_t *na_class, na_context_t *na_context,
     hg_size_t local_segment_start_offset, hg_size_t size,
     na_op_id_t *na_op_ids[], hg_uint32_t na_op_count);
 
+/**
+ * Transfer segments using vectored operations, grouping up to max_iovcnt
+ * segment pairs per NA operation.
+ */
+static hg_return_t
+hg_bulk_transfer_segments_nav(na_class_t *na_class, na_context_t *na_context,
+    na_bulk_opv_t na_bulk_opv, na_cb_t callback, void *arg,
+    na_addr_t origin_addr, uint8_t origin_id,
+    const struct hg_bulk_segment *origin_segments, hg_uint32_t origin_count,
+    na_mem_handle_t *origin_mem_handles, hg_size_t origin_segment_start_index,
+    hg_size_t origin_segment_start_offset,
+    const struct hg_bulk_segment *local_segments, hg_uint32_t local_count,
+    na_mem_handle_t *local_mem_handles, hg_size_t local_segment_start_index,
+    hg_size_t local_segment_start_offset, hg_size_t size,
+    hg_uint32_t piece_count, size_t max_iovcnt, na_op_id_t *na_op_ids[],
+    hg_uint32_t na_op_count);
+
 /**
  * NA_Put wrapper
  */
@@ -487,6 +713,32 @@ hg_bulk_na_get(na_class_t *na_class, na_context_t *context, na_cb_t callback,
         remote_id, op_id);
 }
 
+/**
+ * NA_Putv wrapper
+ */
+static HG_INLINE na_return_t
+hg_bulk_na_putv(na_class_t *na_class, na_context_t *context, na_cb_t callback,
+    void *arg, const struct na_rma_iov *local_iov, size_t local_iovcnt,
+    const struct na_rma_iov *remote_iov, size_t remote_iovcnt,
+    na_addr_t remote_addr, uint8_t remote_id, na_op_id_t *op_id)
+{
+    return NA_Putv(na_class, context, callback, arg, local_iov, local_iovcnt,
+        remote_iov, remote_iovcnt, remote_addr, remote_id, op_id);
+}
+
+/**
+ * NA_Getv wrapper
+ */
+static HG_INLINE na_return_t
+hg_bulk_na_getv(na_class_t *na_class, na_context_t *context, na_cb_t callback,
+    void *arg, const struct na_rma_iov *local_iov, size_t local_iovcnt,
+    const struct na_rma_iov *remote_iov, size_t remote_iovcnt,
+    na_addr_t remote_addr, uint8_t remote_id, na_op_id_t *op_id)
+{
+    return NA_Getv(na_class, context, callback, arg, local_iov, local_iovcnt,
+        remote_iov, remote_iovcnt, remote_addr, remote_id, op_id);
+}
+
 /**
  * Transfer callback.
  */
@@ -518,8 +770,10 @@ hg_bulk_create(hg_core_class_t *core_class, hg_uint32_t count, void **bufs,
     struct hg_bulk *hg_bulk = NULL;
     struct hg_bulk_segment *segments;
     na_class_t *na_class = HG_Core_class_get_na(core_class);
+    struct hg_bulk_cache *hg_bulk_cache = NULL;
 #ifdef NA_HAS_SM
     na_class_t *na_sm_class = HG_Core_class_get_na_sm(core_class);
+    struct hg_bulk_cache *hg_bulk_sm_cache = NULL;
 #endif
     hg_return_t ret = HG_SUCCESS;
 
@@ -550,7 +804,33 @@ hg_bulk_create(hg_core_class_t *core_class, hg_uint32_t count, void **bufs,
         segments = hg_bulk->desc.segments.s;
 
     /* Loop over the list of segments */
-    if (!bufs) {
+    if (!bufs && hg_core_class_get_bulk_alloc_na(core_class)) {
+        hg_size_t alloc_len = 0, offset = 0;
+        hg_uint32_t i;
+
+        /* Allocate buffers internally if only lengths are provided, segments
+         * are carved from a single NA allocation (cache-line aligned) */
+        hg_bulk->desc.info.flags |= HG_BULK_ALLOC;
+        for (i = 0; i < count; i++)
+            alloc_len += HG_BULK_ALLOC_ALIGN(lens[i]);
+        if (alloc_len > 0) {
+            hg_bulk->alloc_class = hg_core_class_get_bulk_alloc_na(core_class);
+            hg_bulk->alloc_buf =
+                NA_Mem_alloc(hg_bulk->alloc_class, (size_t) alloc_len);
+            HG_CHECK_ERROR(hg_bulk->alloc_buf == NULL, error, ret, HG_NOMEM,
+                "Could not allocate segments");
+        }
+
+        for (i = 0; i < count; i++) {
+            if (lens[i] == 0)
+                continue;
+
+            segments[i].base = (hg_ptr_t) hg_bulk->alloc_buf + offset;
+            segments[i].len = lens[i];
+            hg_bulk->desc.info.len += lens[i];
+            offset += HG_BULK_ALLOC_ALIGN(lens[i]);
+        }
+    } else if (!bufs) {
         hg_uint32_t i;
 
         /* Allocate buffers internally if only lengths are provided */
@@ -574,6 +854,14 @@ hg_bulk_create(hg_core_class_t *core_class, hg_uint32_t count, void **bufs,
             segments[i].len = lens[i];
             hg_bulk->desc.info.len += lens[i];
         }
+
+        /* Only user memory is cached, internal memory is freed with handle */
+        hg_bulk_cache = hg_core_class_get_bulk_cache(core_class, na_class);
+#ifdef NA_HAS_SM
+        if (na_sm_class)
+            hg_bulk_sm_cache =
+                hg_core_class_get_bulk_cache(core_class, na_sm_class);
+#endif
     }
 
     HG_LOG_DEBUG("Creating bulk handle with %u segment(s), len is %" PRIu64
@@ -629,15 +917,15 @@ hg_bulk_create(hg_core_class_t *core_class, hg_uint32_t count, void **bufs,
 #endif
     } else {
         /* Register segments individually */
-        ret = hg_bulk_create_na_mem_descs(&hg_bulk->na_mem_descs, na_class,
-            segments, count, flags, (enum na_mem_type) attrs->mem_type,
-            attrs->device);
+        ret = hg_bulk_create_na_mem_descs(&hg_bulk->na_mem_descs,
+            hg_bulk_cache, na_class, segments, count, flags,
+            (enum na_mem_type) attrs->mem_type, attrs->device);
         HG_CHECK_HG_ERROR(error, ret, "Could not create NA mem descriptors");
 
 #ifdef NA_HAS_SM
         if (na_sm_class) {
             ret = hg_bulk_create_na_mem_descs(&hg_bulk->na_sm_mem_descs,
-                na_sm_class, segments, count, flags,
+                hg_bulk_sm_cache, na_sm_class, segments, count, flags,
                 (enum na_mem_type) attrs->mem_type, attrs->device);
             HG_CHECK_HG_ERROR(
                 error, ret, "Could not create NA SM mem descriptors");
@@ -662,6 +950,10 @@ static hg_return_t
 hg_bulk_free(struct hg_bulk *hg_bulk)
 {
     struct hg_bulk_segment *segments;
+    struct hg_bulk_cache *hg_bulk_cache = NULL;
+#ifdef NA_HAS_SM
+    struct hg_bulk_cache *hg_bulk_sm_cache = NULL;
+#endif
     hg_return_t ret = HG_SUCCESS;
 
     if (!hg_bulk)
@@ -671,18 +963,29 @@ hg_bulk_free(struct hg_bulk *hg_bulk)
     if (hg_atomic_decr32(&hg_bulk->ref_count))
         goto done;
 
+    /* Registrations of user memory may come from cache */
+    if (hg_bulk->registered && !(hg_bulk->desc.info.flags & HG_BULK_ALLOC)) {
+        hg_bulk_cache = hg_core_class_get_bulk_cache(
+            hg_bulk->core_class, hg_bulk->na_class);
+#ifdef NA_HAS_SM
+        if (hg_bulk->na_sm_class)
+            hg_bulk_sm_cache = hg_core_class_get_bulk_cache(
+                hg_bulk->core_class, hg_bulk->na_sm_class);
+#endif
+    }
+
     /* Deregister segments */
     if (hg_bulk->desc.info.flags & HG_BULK_REGV ||
         (hg_bulk->desc.info.segment_count == 1)) {
         if (hg_bulk->na_mem_descs.handles.s[0] != NA_MEM_HANDLE_NULL) {
-            ret = hg_bulk_deregister(hg_bulk->na_class,
+            ret = hg_bulk_deregister(hg_bulk_cache, hg_bulk->na_class,
                 hg_bulk->na_mem_descs.handles.s[0], hg_bulk->registered);
             HG_CHECK_HG_ERROR(done, ret, "Could not deregister segment");
         }
 
 #ifdef NA_HAS_SM
         if (hg_bulk->na_sm_mem_descs.handles.s[0] != NA_MEM_HANDLE_NULL) {
-            ret = hg_bulk_deregister(hg_bulk->na_sm_class,
+            ret = hg_bulk_deregister(hg_bulk_sm_cache, hg_bulk->na_sm_class,
                 hg_bulk->na_sm_mem_descs.handles.s[0], hg_bulk->registered);
             HG_CHECK_HG_ERROR(
                 done, ret, "Could not deregister segment with SM");
@@ -690,16 +993,16 @@ hg_bulk_free(struct hg_bulk *hg_bulk)
 #endif
     } else {
         /* Free segments individually */
-        ret =
-            hg_bulk_free_na_mem_descs(&hg_bulk->na_mem_descs, hg_bulk->na_class,
-                hg_bulk->desc.info.segment_count, hg_bulk->registered);
+        ret = hg_bulk_free_na_mem_descs(&hg_bulk->na_mem_descs, hg_bulk_cache,
+            hg_bulk->na_class, hg_bulk->desc.info.segment_count,
+            hg_bulk->registered);
         HG_CHECK_HG_ERROR(done, ret, "Could not free NA mem descriptors");
 
 #ifdef NA_HAS_SM
         if (hg_bulk->na_sm_class) {
             ret = hg_bulk_free_na_mem_descs(&hg_bulk->na_sm_mem_descs,
-                hg_bulk->na_sm_class, hg_bulk->desc.info.segment_count,
-                hg_bulk->registered);
+                hg_bulk_sm_cache, hg_bulk->na_sm_class,
+                hg_bulk->desc.info.segment_count, hg_bulk->registered);
             HG_CHECK_HG_ERROR(
                 done, ret, "Could not free NA SM mem descriptors");
         }
@@ -717,7 +1020,13 @@ hg_bulk_free(struct hg_bulk *hg_bulk)
                    : hg_bulk->desc.segments.s;
 
     /* Free segments if we allocated them */
-    if (hg_bulk->desc.info.flags & HG_BULK_ALLOC) {
+    if (hg_bulk->alloc_buf) {
+        na_return_t na_ret;
+
+        na_ret = NA_Mem_free(hg_bulk->alloc_class, hg_bulk->alloc_buf);
+        HG_CHECK_ERROR(na_ret != NA_SUCCESS, done, ret, (hg_return_t) na_ret,
+            "Could not free segments (%s)", NA_Error_to_string(na_ret));
+    } else if (hg_bulk->desc.info.flags & HG_BULK_ALLOC) {
         hg_uint32_t i;
 
         for (i = 0; i < hg_bulk->desc.info.segment_count; i++)
@@ -737,8 +1046,9 @@ done:
 /*---------------------------------------------------------------------------*/
 static hg_return_t
 hg_bulk_create_na_mem_descs(struct hg_bulk_na_mem_desc *na_mem_descs,
-    na_class_t *na_class, struct hg_bulk_segment *segments, hg_uint32_t count,
-    hg_uint8_t flags, enum na_mem_type mem_type, uint64_t device)
+    struct hg_bulk_cache *hg_bulk_cache, na_class_t *na_class,
+    struct hg_bulk_segment *segments, hg_uint32_t count, hg_uint8_t flags,
+    enum na_mem_type mem_type, uint64_t device)
 {
     na_mem_handle_t *na_mem_handles;
     size_t *na_mem_serialize_sizes;
@@ -771,9 +1081,9 @@ hg_bulk_create_na_mem_descs(struct hg_bulk_na_mem_desc *na_mem_descs,
             continue;
 
         /* Register segment */
-        ret = hg_bulk_register(na_class, (void *) segments[i].base,
-            segments[i].len, flags, mem_type, device, &na_mem_handles[i],
-            &na_mem_serialize_sizes[i]);
+        ret = hg_bulk_register(hg_bulk_cache, na_class,
+            (void *) segments[i].base, segments[i].len, flags, mem_type,
+            device, &na_mem_handles[i], &na_mem_serialize_sizes[i]);
         HG_CHECK_HG_ERROR(error, ret, "Could not register segment");
     }
 
@@ -786,7 +1096,8 @@ error:
 /*---------------------------------------------------------------------------*/
 static hg_return_t
 hg_bulk_free_na_mem_descs(struct hg_bulk_na_mem_desc *na_mem_descs,
-    na_class_t *na_class, hg_uint32_t count, bool registered)
+    struct hg_bulk_cache *hg_bulk_cache, na_class_t *na_class,
+    hg_uint32_t count, bool registered)
 {
     na_mem_handle_t *na_mem_handles;
     hg_return_t ret = HG_SUCCESS;
@@ -804,7 +1115,8 @@ hg_bulk_free_na_mem_descs(struct hg_bulk_na_mem_desc *na_mem_descs,
             if (na_mem_handles[i] == NA_MEM_HANDLE_NULL)
                 continue;
 
-            ret = hg_bulk_deregister(na_class, na_mem_handles[i], registered);
+            ret = hg_bulk_deregister(
+                hg_bulk_cache, na_class, na_mem_handles[i], registered);
             HG_CHECK_HG_ERROR(done, ret, "Could not deregister segment");
         }
         if (count > HG_BULK_STATIC_MAX)
@@ -840,9 +1152,10 @@ done:
 
 /*---------------------------------------------------------------------------*/
 static hg_return_t
-hg_bulk_register(na_class_t *na_class, void *base, size_t len,
-    unsigned long flags, enum na_mem_type mem_type, uint64_t device,
-    na_mem_handle_t *mem_handle_ptr, size_t *serialize_size_ptr)
+hg_bulk_register(struct hg_bulk_cache *hg_bulk_cache, na_class_t *na_class,
+    void *base, size_t len, unsigned long flags, enum na_mem_type mem_type,
+    uint64_t device, na_mem_handle_t *mem_handle_ptr,
+    size_t *serialize_size_ptr)
 {
     na_mem_handle_t mem_handle = NA_MEM_HANDLE_NULL;
     size_t serialize_size = 0;
@@ -850,6 +1163,10 @@ hg_bulk_register(na_class_t *na_class, void *base, size_t len,
     hg_return_t ret = HG_SUCCESS;
     na_return_t na_ret;
 
+    if (hg_bulk_cache)
+        return hg_bulk_cache_register(hg_bulk_cache, base, len, flags,
+            mem_type, device, mem_handle_ptr, serialize_size_ptr);
+
     /* Create NA memory handle */
     na_ret = NA_Mem_handle_create(na_class, base, len, flags, &mem_handle);
     HG_CHECK_ERROR(na_ret != NA_SUCCESS, error, ret, (hg_return_t) na_ret,
@@ -937,12 +1254,17 @@ error:
 
 /*---------------------------------------------------------------------------*/
 static hg_return_t
-hg_bulk_deregister(
-    na_class_t *na_class, na_mem_handle_t mem_handle, bool registered)
+hg_bulk_deregister(struct hg_bulk_cache *hg_bulk_cache, na_class_t *na_class,
+    na_mem_handle_t mem_handle, bool registered)
 {
     hg_return_t ret = HG_SUCCESS;
     na_return_t na_ret;
 
+    /* Registrations taken from cache remain registered */
+    if (registered && hg_bulk_cache &&
+        hg_bulk_cache_release(hg_bulk_cache, mem_handle))
+        goto done;
+
     if (registered) {
         na_ret = NA_Mem_deregister(na_class, mem_handle);
         HG_CHECK_ERROR(na_ret != NA_SUCCESS, done, ret, (hg_return_t) na_ret,
@@ -957,6 +1279,317 @@ done:
     return ret;
 }
 
+/*---------------------------------------------------------------------------*/
+static HG_INLINE unsigned int
+hg_bulk_cache_key_hash(hg_hash_table_key_t key)
+{
+    const struct hg_bulk_cache_key *hg_bulk_cache_key =
+        (const struct hg_bulk_cache_key *) key;
+    uint64_t hash = (uint64_t) hg_bulk_cache_key->base ^
+                    ((uint64_t) hg_bulk_cache_key->len << 20) ^
+                    (uint64_t) hg_bulk_cache_key->flags;
+
+    hash *= 0x9E3779B97F4A7C15ULL;
+
+    return (unsigned int) (hash >> 32);
+}
+
+/*---------------------------------------------------------------------------*/
+static HG_INLINE int
+hg_bulk_cache_key_equal(hg_hash_table_key_t key1, hg_hash_table_key_t key2)
+{
+    const struct hg_bulk_cache_key *k1 =
+        (const struct hg_bulk_cache_key *) key1;
+    const struct hg_bulk_cache_key *k2 =
+        (const struct hg_bulk_cache_key *) key2;
+
+    return k1->base == k2->base && k1->len == k2->len &&
+           k1->flags == k2->flags && k1->mem_type == k2->mem_type &&
+           k1->device == k2->device;
+}
+
+/*---------------------------------------------------------------------------*/
+static HG_INLINE unsigned int
+hg_bulk_cache_handle_hash(hg_hash_table_key_t key)
+{
+    uint64_t hash = (uint64_t) (uintptr_t) key * 0x9E3779B97F4A7C15ULL;
+
+    return (unsigned int) (hash >> 32);
+}
+
+/*---------------------------------------------------------------------------*/
+static HG_INLINE int
+hg_bulk_cache_handle_equal(hg_hash_table_key_t key1, hg_hash_table_key_t key2)
+{
+    return key1 == key2;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_bulk_cache_register(struct hg_bulk_cache *hg_bulk_cache, void *base,
+    size_t len, unsigned long flags, enum na_mem_type mem_type,
+    uint64_t device, na_mem_handle_t *mem_handle_ptr,
+    size_t *serialize_size_ptr)
+{
+    struct hg_bulk_cache_key key = {.base = (hg_ptr_t) base,
+        .len = (hg_size_t) len,
+        .flags = flags,
+        .mem_type = mem_type,
+        .device = device};
+    struct hg_bulk_cache_entry *hg_bulk_cache_entry, *free_list = NULL;
+    na_mem_handle_t mem_handle;
+    size_t serialize_size;
+    hg_return_t ret;
+
+    /* Fast path, range is already registered */
+    hg_thread_spin_lock(&hg_bulk_cache->lock);
+    hg_bulk_cache_entry = (struct hg_bulk_cache_entry *) hg_hash_table_lookup(
+        hg_bulk_cache->entries, (hg_hash_table_key_t) &key);
+    if (hg_bulk_cache_entry != HG_HASH_TABLE_NULL) {
+        if (hg_bulk_cache_entry->ref_count++ == 0)
+            hg_bulk_cache_lru_remove(hg_bulk_cache, hg_bulk_cache_entry);
+        *mem_handle_ptr = hg_bulk_cache_entry->mem_handle;
+        *serialize_size_ptr = hg_bulk_cache_entry->serialize_size;
+        hg_bulk_cache->hit_count++;
+        hg_thread_spin_unlock(&hg_bulk_cache->lock);
+
+        return HG_SUCCESS;
+    }
+    hg_bulk_cache->miss_count++;
+    hg_thread_spin_unlock(&hg_bulk_cache->lock);
+
+    /* Register outside of lock */
+    ret = hg_bulk_register(NULL, hg_bulk_cache->na_class, base, len, flags,
+        mem_type, device, &mem_handle, &serialize_size);
+    HG_CHECK_HG_ERROR(done, ret, "Could not register segment");
+
+    *mem_handle_ptr = mem_handle;
+    *serialize_size_ptr = serialize_size;
+
+    /* Ranges that do not fit are not cached */
+    if (key.len > hg_bulk_cache->max_size)
+        goto done;
+
+    hg_bulk_cache_entry =
+        (struct hg_bulk_cache_entry *) malloc(sizeof(*hg_bulk_cache_entry));
+    HG_CHECK_ERROR_NORET(
+        hg_bulk_cache_entry == NULL, done, "Could not allocate cache entry");
+    memset(hg_bulk_cache_entry, 0, sizeof(*hg_bulk_cache_entry));
+    hg_bulk_cache_entry->key = key;
+    hg_bulk_cache_entry->mem_handle = mem_handle;
+    hg_bulk_cache_entry->serialize_size = serialize_size;
+    hg_bulk_cache_entry->ref_count = 1;
+    hg_bulk_cache_entry->valid = HG_TRUE;
+
+    hg_thread_spin_lock(&hg_bulk_cache->lock);
+    if (hg_hash_table_lookup(hg_bulk_cache->entries,
+            (hg_hash_table_key_t) &key) != HG_HASH_TABLE_NULL) {
+        /* Range was concurrently added, keep registration uncached */
+        hg_thread_spin_unlock(&hg_bulk_cache->lock);
+        free(hg_bulk_cache_entry);
+        goto done;
+    }
+    if (!hg_hash_table_insert(hg_bulk_cache->handles,
+            (hg_hash_table_key_t) mem_handle,
+            (hg_hash_table_value_t) hg_bulk_cache_entry)) {
+        hg_thread_spin_unlock(&hg_bulk_cache->lock);
+        free(hg_bulk_cache_entry);
+        HG_LOG_ERROR("Could not insert cache entry");
+        goto done;
+    }
+    if (!hg_hash_table_insert(hg_bulk_cache->entries,
+            (hg_hash_table_key_t) &hg_bulk_cache_entry->key,
+            (hg_hash_table_value_t) hg_bulk_cache_entry)) {
+        hg_hash_table_remove(
+            hg_bulk_cache->handles, (hg_hash_table_key_t) mem_handle);
+        hg_thread_spin_unlock(&hg_bulk_cache->lock);
+        free(hg_bulk_cache_entry);
+        HG_LOG_ERROR("Could not insert cache entry");
+        goto done;
+    }
+    hg_bulk_cache->size += key.len;
+    hg_bulk_cache_evict(hg_bulk_cache, &free_list);
+    hg_thread_spin_unlock(&hg_bulk_cache->lock);
+
+    hg_bulk_cache_free_list(hg_bulk_cache, free_list);
+
+done:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_bool_t
+hg_bulk_cache_release(
+    struct hg_bulk_cache *hg_bulk_cache, na_mem_handle_t mem_handle)
+{
+    struct hg_bulk_cache_entry *hg_bulk_cache_entry, *free_list = NULL;
+
+    hg_thread_spin_lock(&hg_bulk_cache->lock);
+    hg_bulk_cache_entry = (struct hg_bulk_cache_entry *) hg_hash_table_lookup(
+        hg_bulk_cache->handles, (hg_hash_table_key_t) mem_handle);
+    if (hg_bulk_cache_entry == HG_HASH_TABLE_NULL) {
+        hg_thread_spin_unlock(&hg_bulk_cache->lock);
+        return HG_FALSE;
+    }
+
+    if (--hg_bulk_cache_entry->ref_count == 0) {
+        if (hg_bulk_cache_entry->valid) {
+            /* Keep registration until it gets evicted */
+            hg_bulk_cache_lru_push(hg_bulk_cache, hg_bulk_cache_entry);
+            hg_bulk_cache_evict(hg_bulk_cache, &free_list);
+        } else
+            hg_bulk_cache_remove(
+                hg_bulk_cache, hg_bulk_cache_entry, &free_list);
+    }
+    hg_thread_spin_unlock(&hg_bulk_cache->lock);
+
+    hg_bulk_cache_free_list(hg_bulk_cache, free_list);
+
+    return HG_TRUE;
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+hg_bulk_cache_invalidate(
+    struct hg_bulk_cache *hg_bulk_cache, hg_ptr_t base, hg_size_t len)
+{
+    struct hg_bulk_cache_entry *hg_bulk_cache_entry, *free_list = NULL;
+    hg_hash_table_iter_t hash_table_iter;
+
+    hg_thread_spin_lock(&hg_bulk_cache->lock);
+    hg_hash_table_iterate(hg_bulk_cache->handles, &hash_table_iter);
+    while (hg_hash_table_iter_has_more(&hash_table_iter)) {
+        hg_bulk_cache_entry =
+            (struct hg_bulk_cache_entry *) hg_hash_table_iter_next(
+                &hash_table_iter);
+
+        if (!hg_bulk_cache_entry->valid ||
+            hg_bulk_cache_entry->key.base >= base + len ||
+            hg_bulk_cache_entry->key.base + hg_bulk_cache_entry->key.len <=
+                base)
+            continue;
+
+        /* Entries that are still in use are removed on last release */
+        hg_hash_table_remove(hg_bulk_cache->entries,
+            (hg_hash_table_key_t) &hg_bulk_cache_entry->key);
+        hg_bulk_cache_entry->valid = HG_FALSE;
+        if (hg_bulk_cache_entry->ref_count == 0) {
+            hg_bulk_cache_lru_remove(hg_bulk_cache, hg_bulk_cache_entry);
+            hg_bulk_cache_entry->lru_next = free_list;
+            free_list = hg_bulk_cache_entry;
+        }
+    }
+
+    /* Cannot remove from handle table while iterating */
+    for (hg_bulk_cache_entry = free_list; hg_bulk_cache_entry != NULL;
+         hg_bulk_cache_entry = hg_bulk_cache_entry->lru_next) {
+        hg_hash_table_remove(hg_bulk_cache->handles,
+            (hg_hash_table_key_t) hg_bulk_cache_entry->mem_handle);
+        hg_bulk_cache->size -= hg_bulk_cache_entry->key.len;
+    }
+    hg_thread_spin_unlock(&hg_bulk_cache->lock);
+
+    hg_bulk_cache_free_list(hg_bulk_cache, free_list);
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+hg_bulk_cache_get_stats(
+    struct hg_bulk_cache *hg_bulk_cache, struct hg_bulk_cache_stats *stats)
+{
+    hg_thread_spin_lock(&hg_bulk_cache->lock);
+    stats->hit_count += hg_bulk_cache->hit_count;
+    stats->miss_count += hg_bulk_cache->miss_count;
+    stats->entry_count +=
+        (hg_uint32_t) hg_hash_table_num_entries(hg_bulk_cache->handles);
+    stats->unused_count += hg_bulk_cache->unused_count;
+    stats->size += hg_bulk_cache->size;
+    hg_thread_spin_unlock(&hg_bulk_cache->lock);
+}
+
+/*---------------------------------------------------------------------------*/
+static HG_INLINE void
+hg_bulk_cache_lru_push(struct hg_bulk_cache *hg_bulk_cache,
+    struct hg_bulk_cache_entry *hg_bulk_cache_entry)
+{
+    hg_bulk_cache->unused_count++;
+    hg_bulk_cache_entry->lru_prev = NULL;
+    hg_bulk_cache_entry->lru_next = hg_bulk_cache->lru_head;
+    if (hg_bulk_cache->lru_head)
+        hg_bulk_cache->lru_head->lru_prev = hg_bulk_cache_entry;
+    else
+        hg_bulk_cache->lru_tail = hg_bulk_cache_entry;
+    hg_bulk_cache->lru_head = hg_bulk_cache_entry;
+}
+
+/*---------------------------------------------------------------------------*/
+static HG_INLINE void
+hg_bulk_cache_lru_remove(struct hg_bulk_cache *hg_bulk_cache,
+    struct hg_bulk_cache_entry *hg_bulk_cache_entry)
+{
+    hg_bulk_cache->unused_count--;
+    if (hg_bulk_cache_entry->lru_prev)
+        hg_bulk_cache_entry->lru_prev->lru_next = hg_bulk_cache_entry->lru_next;
+    else
+        hg_bulk_cache->lru_head = hg_bulk_cache_entry->lru_next;
+    if (hg_bulk_cache_entry->lru_next)
+        hg_bulk_cache_entry->lru_next->lru_prev = hg_bulk_cache_entry->lru_prev;
+    else
+        hg_bulk_cache->lru_tail = hg_bulk_cache_entry->lru_prev;
+    hg_bulk_cache_entry->lru_prev = hg_bulk_cache_entry->lru_next = NULL;
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+hg_bulk_cache_remove(struct hg_bulk_cache *hg_bulk_cache,
+    struct hg_bulk_cache_entry *hg_bulk_cache_entry,
+    struct hg_bulk_cache_entry **free_list)
+{
+    if (hg_bulk_cache_entry->valid)
+        hg_hash_table_remove(hg_bulk_cache->entries,
+            (hg_hash_table_key_t) &hg_bulk_cache_entry->key);
+    hg_hash_table_remove(hg_bulk_cache->handles,
+        (hg_hash_table_key_t) hg_bulk_cache_entry->mem_handle);
+    hg_bulk_cache->size -= hg_bulk_cache_entry->key.len;
+
+    hg_bulk_cache_entry->lru_next = *free_list;
+    *free_list = hg_bulk_cache_entry;
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+hg_bulk_cache_evict(struct hg_bulk_cache *hg_bulk_cache,
+    struct hg_bulk_cache_entry **free_list)
+{
+    while (hg_bulk_cache->size > hg_bulk_cache->max_size &&
+           hg_bulk_cache->lru_tail != NULL) {
+        struct hg_bulk_cache_entry *hg_bulk_cache_entry =
+            hg_bulk_cache->lru_tail;
+
+        hg_bulk_cache_lru_remove(hg_bulk_cache, hg_bulk_cache_entry);
+        hg_bulk_cache_remove(hg_bulk_cache, hg_bulk_cache_entry, free_list);
+    }
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+hg_bulk_cache_free_list(struct hg_bulk_cache *hg_bulk_cache,
+    struct hg_bulk_cache_entry *free_list)
+{
+    while (free_list != NULL) {
+        struct hg_bulk_cache_entry *hg_bulk_cache_entry = free_list;
+        hg_return_t ret;
+
+        free_list = free_list->lru_next;
+
+        ret = hg_bulk_deregister(NULL, hg_bulk_cache->na_class,
+            hg_bulk_cache_entry->mem_handle, true);
+        HG_CHECK_ERROR_DONE(
+            ret != HG_SUCCESS, "Could not deregister cached segment");
+        free(hg_bulk_cache_entry);
+    }
+}
+
 /*---------------------------------------------------------------------------*/
 static hg_size_t
 hg_bulk_get_serialize_size(struct hg_bulk *hg_bulk, hg_uint8_t flags)
@@ -1585,8 +2218,9 @@ hg_bulk_op_create(
     hg_return_t ret = HG_SUCCESS;
     int i;
 
-    hg_bulk_op_id =
-        (struct hg_bulk_op_id *) malloc(sizeof(struct hg_bulk_op_id));
+    /* Op IDs must not share cache lines */
+    hg_bulk_op_id = (struct hg_bulk_op_id *) hg_mem_aligned_alloc(
+        HG_MEM_CACHE_LINE_SIZE, sizeof(struct hg_bulk_op_id));
     HG_CHECK_ERROR(hg_bulk_op_id == NULL, error, ret, HG_NOMEM,
         "Could not allocate HG Bulk operation ID");
     memset(hg_bulk_op_id, 0, sizeof(struct hg_bulk_op_id));
@@ -1650,7 +2284,7 @@ error:
             HG_CHECK_ERROR_DONE(na_ret != NA_SUCCESS, "NA_Op_destroy() failed");
         }
 #endif
-        free(hg_bulk_op_id);
+        hg_mem_aligned_free(hg_bulk_op_id);
     }
     return ret;
 }
@@ -1699,6 +2333,13 @@ hg_bulk_op_destroy(struct hg_bulk_op_id *hg_bulk_op_id)
         }
     }
 
+    /* Release chunked transfer */
+    if (hg_bulk_op_id->chunk) {
+        hg_thread_mutex_destroy(&hg_bulk_op_id->chunk->mutex);
+        free(hg_bulk_op_id->chunk);
+        hg_bulk_op_id->chunk = NULL;
+    }
+
     /* Repost handle if we were listening, otherwise destroy it */
     if (hg_bulk_op_id->reuse) {
         HG_LOG_DEBUG("Re-using bulk op ID (%p)", (void *) hg_bulk_op_id);
@@ -1709,10 +2350,8 @@ hg_bulk_op_destroy(struct hg_bulk_op_id *hg_bulk_op_id)
         /* Reset status */
         hg_atomic_set32(&hg_bulk_op_id->status, HG_BULK_OP_COMPLETED);
 
-        hg_thread_spin_lock(&hg_bulk_op_id->op_pool->pending_list_lock);
-        HG_LIST_INSERT_HEAD(
-            &hg_bulk_op_id->op_pool->pending_list, hg_bulk_op_id, pending);
-        hg_thread_spin_unlock(&hg_bulk_op_id->op_pool->pending_list_lock);
+        /* Return op ID to the cache of the calling thread */
+        hg_thread_cache_put(hg_bulk_op_id->op_pool->cache, hg_bulk_op_id);
     } else {
         HG_LOG_DEBUG("Freeing bulk op ID (%p)", (void *) hg_bulk_op_id);
 
@@ -1746,7 +2385,7 @@ hg_bulk_op_destroy(struct hg_bulk_op_id *hg_bulk_op_id)
         }
 #endif
 
-        free(hg_bulk_op_id);
+        hg_mem_aligned_free(hg_bulk_op_id);
     }
 
 done:
@@ -1768,28 +2407,21 @@ hg_bulk_op_pool_create(hg_core_context_t *core_context, unsigned int init_count,
         (struct hg_bulk_op_pool *) malloc(sizeof(struct hg_bulk_op_pool));
     HG_CHECK_ERROR(hg_bulk_op_pool == NULL, error, ret, HG_NOMEM,
         "Could not allocate bulk op pool");
-
-    hg_thread_mutex_init(&hg_bulk_op_pool->extend_mutex);
-    hg_thread_cond_init(&hg_bulk_op_pool->extend_cond);
     hg_bulk_op_pool->core_context = core_context;
-    HG_LIST_INIT(&hg_bulk_op_pool->pending_list);
-    hg_thread_spin_init(&hg_bulk_op_pool->pending_list_lock);
-    hg_bulk_op_pool->count = init_count;
-    hg_bulk_op_pool->extending = HG_FALSE;
 
-    for (i = 0; i < init_count; i++) {
-        struct hg_bulk_op_id *hg_bulk_op_id = NULL;
+    hg_bulk_op_pool->cache = hg_thread_cache_create(HG_BULK_OP_CACHE_SIZE,
+        hg_bulk_op_pool_alloc, hg_bulk_op_pool_free, hg_bulk_op_pool);
+    HG_CHECK_ERROR(hg_bulk_op_pool->cache == NULL, error, ret, HG_NOMEM,
+        "Could not create bulk op ID cache");
 
-        ret = hg_bulk_op_create(core_context, &hg_bulk_op_id);
-        HG_CHECK_HG_ERROR(error, ret, "Could not create bulk op ID");
-
-        hg_bulk_op_id->reuse = HG_TRUE;
-        hg_bulk_op_id->op_pool = hg_bulk_op_pool;
+    /* Pre-populate cache, full magazines are shared between threads */
+    for (i = 0; i < init_count; i++) {
+        struct hg_bulk_op_id *hg_bulk_op_id =
+            (struct hg_bulk_op_id *) hg_bulk_op_pool_alloc(hg_bulk_op_pool);
+        HG_CHECK_ERROR(hg_bulk_op_id == NULL, error, ret, HG_NOMEM,
+            "Could not create bulk op ID");
 
-        hg_thread_spin_lock(&hg_bulk_op_pool->pending_list_lock);
-        HG_LIST_INSERT_HEAD(
-            &hg_bulk_op_pool->pending_list, hg_bulk_op_id, pending);
-        hg_thread_spin_unlock(&hg_bulk_op_pool->pending_list_lock);
+        hg_thread_cache_put(hg_bulk_op_pool->cache, hg_bulk_op_id);
     }
 
     HG_LOG_DEBUG("Created bulk op ID pool (%p)", (void *) hg_bulk_op_pool);
@@ -1799,8 +2431,11 @@ hg_bulk_op_pool_create(hg_core_context_t *core_context, unsigned int init_count,
     return ret;
 
 error:
-    if (hg_bulk_op_pool)
-        hg_bulk_op_pool_destroy(hg_bulk_op_pool);
+    if (hg_bulk_op_pool) {
+        if (hg_bulk_op_pool->cache)
+            hg_thread_cache_destroy(hg_bulk_op_pool->cache);
+        free(hg_bulk_op_pool);
+    }
     return ret;
 }
 
@@ -1808,43 +2443,115 @@ error:
 hg_return_t
 hg_bulk_op_pool_destroy(struct hg_bulk_op_pool *hg_bulk_op_pool)
 {
-    struct hg_bulk_op_id *hg_bulk_op_id = NULL;
+    HG_LOG_DEBUG("Free bulk op ID pool (%p)", (void *) hg_bulk_op_pool);
+
+    /* Destroy op IDs, including those cached by threads that have exited */
+    hg_thread_cache_destroy(hg_bulk_op_pool->cache);
+
+    free(hg_bulk_op_pool);
+
+    return HG_SUCCESS;
+}
+
+/*---------------------------------------------------------------------------*/
+hg_return_t
+hg_bulk_cache_create(na_class_t *na_class, hg_size_t max_size,
+    struct hg_bulk_cache **hg_bulk_cache_ptr)
+{
+    struct hg_bulk_cache *hg_bulk_cache = NULL;
     hg_return_t ret = HG_SUCCESS;
 
-    HG_LOG_DEBUG("Free bulk op ID pool (%p)", (void *) hg_bulk_op_pool);
+    hg_bulk_cache =
+        (struct hg_bulk_cache *) calloc(1, sizeof(struct hg_bulk_cache));
+    HG_CHECK_ERROR(hg_bulk_cache == NULL, error, ret, HG_NOMEM,
+        "Could not allocate bulk cache");
+    hg_bulk_cache->na_class = na_class;
+    hg_bulk_cache->max_size = max_size;
+    hg_thread_spin_init(&hg_bulk_cache->lock);
+
+    hg_bulk_cache->entries =
+        hg_hash_table_new(hg_bulk_cache_key_hash, hg_bulk_cache_key_equal);
+    HG_CHECK_ERROR(hg_bulk_cache->entries == NULL, error, ret, HG_NOMEM,
+        "Could not create hash table");
 
-    hg_thread_spin_lock(&hg_bulk_op_pool->pending_list_lock);
+    hg_bulk_cache->handles = hg_hash_table_new(
+        hg_bulk_cache_handle_hash, hg_bulk_cache_handle_equal);
+    HG_CHECK_ERROR(hg_bulk_cache->handles == NULL, error, ret, HG_NOMEM,
+        "Could not create hash table");
 
-    hg_bulk_op_id = HG_LIST_FIRST(&hg_bulk_op_pool->pending_list);
+    *hg_bulk_cache_ptr = hg_bulk_cache;
 
-    while (hg_bulk_op_id) {
-        struct hg_bulk_op_id *hg_bulk_op_id_next =
-            HG_LIST_NEXT(hg_bulk_op_id, pending);
-        HG_LIST_REMOVE(hg_bulk_op_id, pending);
+    return ret;
+
+error:
+    if (hg_bulk_cache) {
+        if (hg_bulk_cache->entries)
+            hg_hash_table_free(hg_bulk_cache->entries);
+        hg_thread_spin_destroy(&hg_bulk_cache->lock);
+        free(hg_bulk_cache);
+    }
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+hg_return_t
+hg_bulk_cache_destroy(struct hg_bulk_cache *hg_bulk_cache)
+{
+    struct hg_bulk_cache_entry *free_list = NULL;
+    hg_hash_table_iter_t hash_table_iter;
+
+    /* All bulk handles have been freed, release all registrations */
+    hg_hash_table_iterate(hg_bulk_cache->handles, &hash_table_iter);
+    while (hg_hash_table_iter_has_more(&hash_table_iter)) {
+        struct hg_bulk_cache_entry *hg_bulk_cache_entry =
+            (struct hg_bulk_cache_entry *) hg_hash_table_iter_next(
+                &hash_table_iter);
+
+        hg_bulk_cache_entry->lru_next = free_list;
+        free_list = hg_bulk_cache_entry;
+    }
+    hg_bulk_cache_free_list(hg_bulk_cache, free_list);
+
+    hg_hash_table_free(hg_bulk_cache->entries);
+    hg_hash_table_free(hg_bulk_cache->handles);
+    hg_thread_spin_destroy(&hg_bulk_cache->lock);
+    free(hg_bulk_cache);
+
+    return HG_SUCCESS;
+}
+
+/*---------------------------------------------------------------------------*/
+static void *
+hg_bulk_op_pool_alloc(void *arg)
+{
+    struct hg_bulk_op_pool *hg_bulk_op_pool = (struct hg_bulk_op_pool *) arg;
+    struct hg_bulk_op_id *hg_bulk_op_id = NULL;
+    hg_return_t ret;
 
-        /* Prevent re-initialization */
-        hg_bulk_op_id->reuse = HG_FALSE;
+    ret = hg_bulk_op_create(hg_bulk_op_pool->core_context, &hg_bulk_op_id);
+    HG_CHECK_HG_ERROR(error, ret, "Could not create bulk op ID");
 
-        /* Destroy op IDs */
-        ret = hg_bulk_op_destroy(hg_bulk_op_id);
-        HG_CHECK_HG_ERROR(unlock, ret, "Could not destroy bulk op ID");
+    hg_bulk_op_id->reuse = HG_TRUE;
+    hg_bulk_op_id->op_pool = hg_bulk_op_pool;
 
-        hg_bulk_op_id = hg_bulk_op_id_next;
-    }
-    hg_thread_spin_unlock(&hg_bulk_op_pool->pending_list_lock);
+    return hg_bulk_op_id;
 
-    hg_thread_mutex_destroy(&hg_bulk_op_pool->extend_mutex);
-    hg_thread_cond_destroy(&hg_bulk_op_pool->extend_cond);
-    hg_thread_spin_destroy(&hg_bulk_op_pool->pending_list_lock);
+error:
+    return NULL;
+}
 
-    free(hg_bulk_op_pool);
+/*---------------------------------------------------------------------------*/
+static void
+hg_bulk_op_pool_free(void *obj, void *arg)
+{
+    struct hg_bulk_op_id *hg_bulk_op_id = (struct hg_bulk_op_id *) obj;
 
-    return ret;
+    (void) arg;
 
-unlock:
-    hg_thread_spin_unlock(&hg_bulk_op_pool->pending_list_lock);
+    /* Prevent re-initialization */
+    hg_bulk_op_id->reuse = HG_FALSE;
 
-    return ret;
+    hg_bulk_op_destroy(hg_bulk_op_id);
 }
 
 /*---------------------------------------------------------------------------*/
@@ -1855,61 +2562,15 @@ hg_bulk_op_pool_get(struct hg_bulk_op_pool *hg_bulk_op_pool,
     struct hg_bulk_op_id *hg_bulk_op_id = NULL;
     hg_return_t ret = HG_SUCCESS;
 
-    do {
-        unsigned int i;
-
-        hg_thread_spin_lock(&hg_bulk_op_pool->pending_list_lock);
-        if ((hg_bulk_op_id = HG_LIST_FIRST(&hg_bulk_op_pool->pending_list)))
-            HG_LIST_REMOVE(hg_bulk_op_id, pending);
-        hg_thread_spin_unlock(&hg_bulk_op_pool->pending_list_lock);
-
-        if (hg_bulk_op_id)
-            break;
-
-        /* Create another batch of IDs if empty */
-        hg_thread_mutex_lock(&hg_bulk_op_pool->extend_mutex);
-        if (hg_bulk_op_pool->extending) {
-            hg_thread_cond_wait(
-                &hg_bulk_op_pool->extend_cond, &hg_bulk_op_pool->extend_mutex);
-            hg_thread_mutex_unlock(&hg_bulk_op_pool->extend_mutex);
-            continue;
-        }
-        hg_bulk_op_pool->extending = HG_TRUE;
-        hg_thread_mutex_unlock(&hg_bulk_op_pool->extend_mutex);
-
-        /* Only a single thread can extend the pool */
-        for (i = 0; i < hg_bulk_op_pool->count; i++) {
-            struct hg_bulk_op_id *new_op_id = NULL;
-
-            ret = hg_bulk_op_create(hg_bulk_op_pool->core_context, &new_op_id);
-            HG_CHECK_HG_ERROR(error, ret, "Could not create bulk op ID");
-
-            new_op_id->reuse = HG_TRUE;
-            new_op_id->op_pool = hg_bulk_op_pool;
-
-            hg_thread_spin_lock(&hg_bulk_op_pool->pending_list_lock);
-            HG_LIST_INSERT_HEAD(
-                &hg_bulk_op_pool->pending_list, new_op_id, pending);
-            hg_thread_spin_unlock(&hg_bulk_op_pool->pending_list_lock);
-        }
-        hg_bulk_op_pool->count *= 2;
-
-        hg_thread_mutex_lock(&hg_bulk_op_pool->extend_mutex);
-        hg_bulk_op_pool->extending = HG_FALSE;
-        hg_thread_cond_broadcast(&hg_bulk_op_pool->extend_cond);
-        hg_thread_mutex_unlock(&hg_bulk_op_pool->extend_mutex);
-    } while (!hg_bulk_op_id);
+    /* Cache allocates new op IDs when empty */
+    hg_bulk_op_id =
+        (struct hg_bulk_op_id *) hg_thread_cache_get(hg_bulk_op_pool->cache);
+    HG_CHECK_ERROR(hg_bulk_op_id == NULL, done, ret, HG_NOMEM,
+        "Could not get bulk op ID from pool");
 
     *hg_bulk_op_id_ptr = hg_bulk_op_id;
 
-    return ret;
-
-error:
-    hg_thread_mutex_lock(&hg_bulk_op_pool->extend_mutex);
-    hg_bulk_op_pool->extending = HG_FALSE;
-    hg_thread_cond_broadcast(&hg_bulk_op_pool->extend_cond);
-    hg_thread_mutex_unlock(&hg_bulk_op_pool->extend_mutex);
-
+done:
     return ret;
 }
 
@@ -1993,7 +2654,8 @@ hg_bulk_transfer(hg_core_context_t *core_context, hg_cb_t callback, void *arg,
             HG_LOG_DEBUG("Using default NA class for this transfer");
 
             hg_bulk_op_id->na_class = hg_bulk_origin->na_class;
-            hg_bulk_op_id->na_context = HG_Core_context_get_na(core_context);
+            hg_bulk_op_id->na_context = hg_core_context_get_na_rail(
+                core_context, origin_addr, size, &origin_id);
             na_origin_addr = HG_Core_addr_get_na(origin_addr);
             origin_mem_descs = &hg_bulk_origin->na_mem_descs;
             local_mem_descs = &hg_bulk_local->na_mem_descs;
@@ -2026,6 +2688,227 @@ error:
     return ret;
 }
 
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_bulk_transfer_chunked(hg_core_context_t *core_context, hg_cb_t callback,
+    void *arg, hg_bulk_op_t op, struct hg_core_addr *origin_addr,
+    hg_uint8_t origin_id, struct hg_bulk *hg_bulk_origin,
+    hg_size_t origin_offset, struct hg_bulk *hg_bulk_local,
+    hg_size_t local_offset, hg_size_t size,
+    const struct hg_bulk_chunk_info *chunk_info, hg_op_id_t *op_id)
+{
+    struct hg_bulk_op_id *hg_bulk_op_id = NULL;
+    struct hg_bulk_op_pool *hg_bulk_op_pool =
+        hg_core_context_get_bulk_op_pool(core_context);
+    struct hg_bulk_chunk *hg_bulk_chunk = NULL;
+    hg_size_t chunk_size = chunk_info->chunk_size, chunk_count;
+    hg_uint32_t max_in_flight, i;
+    hg_return_t ret = HG_SUCCESS;
+
+    /* Nothing to split */
+    if (size == 0)
+        return hg_bulk_transfer(core_context, callback, arg, op, origin_addr,
+            origin_id, hg_bulk_origin, origin_offset, hg_bulk_local,
+            local_offset, size, op_id);
+
+    if (chunk_size == 0 || chunk_size > size)
+        chunk_size = size;
+    chunk_count = (size + chunk_size - 1) / chunk_size;
+    max_in_flight = (chunk_info->max_in_flight > 0) ? chunk_info->max_in_flight
+                                                    : 1;
+    if ((hg_size_t) max_in_flight > chunk_count)
+        max_in_flight = (hg_uint32_t) chunk_count;
+
+    hg_bulk_chunk = (struct hg_bulk_chunk *) calloc(1,
+        sizeof(*hg_bulk_chunk) +
+            max_in_flight * sizeof(struct hg_bulk_chunk_slot));
+    HG_CHECK_ERROR(hg_bulk_chunk == NULL, error, ret, HG_NOMEM,
+        "Could not allocate chunked transfer");
+    hg_bulk_chunk->info = *chunk_info;
+    hg_bulk_chunk->info.chunk_size = chunk_size;
+    hg_bulk_chunk->info.max_in_flight = max_in_flight;
+    hg_bulk_chunk->origin_addr = origin_addr;
+    hg_bulk_chunk->origin_offset = origin_offset;
+    hg_bulk_chunk->local_offset = local_offset;
+    hg_bulk_chunk->origin_id = origin_id;
+    for (i = 0; i < max_in_flight; i++)
+        hg_bulk_chunk->slots[i].chunk = hg_bulk_chunk;
+    hg_thread_mutex_init(&hg_bulk_chunk->mutex);
+
+    /* Get a new OP ID from context, chunks are issued with their own op IDs
+     * and this one only completes once all of them have completed */
+    if (hg_bulk_op_pool) {
+        ret = hg_bulk_op_pool_get(hg_bulk_op_pool, &hg_bulk_op_id);
+        HG_CHECK_HG_ERROR(error, ret, "Could not get bulk op ID");
+    } else {
+        ret = hg_bulk_op_create(core_context, &hg_bulk_op_id);
+        HG_CHECK_HG_ERROR(error, ret, "Could not create bulk op ID");
+    }
+    hg_bulk_chunk->hg_bulk_op_id = hg_bulk_op_id;
+    hg_bulk_op_id->chunk = hg_bulk_chunk;
+
+    hg_bulk_op_id->callback = callback;
+    hg_bulk_op_id->callback_info.arg = arg;
+    hg_bulk_op_id->callback_info.info.bulk.origin_handle = hg_bulk_origin;
+    hg_atomic_incr32(&hg_bulk_origin->ref_count);
+    hg_bulk_op_id->callback_info.info.bulk.local_handle = hg_bulk_local;
+    hg_atomic_incr32(&hg_bulk_local->ref_count);
+    hg_bulk_op_id->callback_info.info.bulk.op = op;
+    hg_bulk_op_id->callback_info.info.bulk.size = size;
+    hg_bulk_op_id->na_class = NULL;
+    hg_bulk_op_id->na_context = NULL;
+    hg_bulk_op_id->op_count = 0;
+
+    /* Reset status */
+    hg_atomic_set32(&hg_bulk_op_id->status, 0);
+    hg_atomic_set32(&hg_bulk_op_id->ret_status, (int32_t) HG_SUCCESS);
+
+    HG_LOG_DEBUG("Transferring %" PRIu64 " bytes in %" PRIu64
+                 " chunk(s), %u in flight",
+        size, chunk_count, max_in_flight);
+
+    hg_thread_mutex_lock(&hg_bulk_chunk->mutex);
+    ret = hg_bulk_chunk_issue(hg_bulk_chunk);
+    if (ret != HG_SUCCESS && hg_bulk_chunk->in_flight == 0) {
+        hg_thread_mutex_unlock(&hg_bulk_chunk->mutex);
+        HG_LOG_ERROR("Could not issue first chunk");
+        goto error_ref;
+    }
+    hg_thread_mutex_unlock(&hg_bulk_chunk->mutex);
+
+    /* Assign op_id */
+    if (op_id && op_id != HG_OP_ID_IGNORE)
+        *op_id = (hg_op_id_t) hg_bulk_op_id;
+
+    /* Errors on chunks other than the first one are reported through the
+     * callback once the chunks in flight complete */
+    return HG_SUCCESS;
+
+error_ref:
+    hg_atomic_decr32(&hg_bulk_origin->ref_count);
+    hg_atomic_decr32(&hg_bulk_local->ref_count);
+
+error:
+    if (hg_bulk_op_id) {
+        hg_return_t hg_ret = hg_bulk_op_destroy(hg_bulk_op_id);
+        HG_CHECK_ERROR_DONE(hg_ret != HG_SUCCESS, "Could not destroy op ID");
+    } else if (hg_bulk_chunk) {
+        hg_thread_mutex_destroy(&hg_bulk_chunk->mutex);
+        free(hg_bulk_chunk);
+    }
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_bulk_chunk_issue(struct hg_bulk_chunk *hg_bulk_chunk)
+{
+    struct hg_bulk_op_id *hg_bulk_op_id = hg_bulk_chunk->hg_bulk_op_id;
+    struct hg_cb_info_bulk *bulk_info = &hg_bulk_op_id->callback_info.info.bulk;
+    hg_return_t ret = HG_SUCCESS;
+    hg_uint32_t i = 0;
+
+    while (hg_bulk_chunk->in_flight < hg_bulk_chunk->info.max_in_flight &&
+           hg_bulk_chunk->next_offset < bulk_info->size &&
+           hg_atomic_get32(&hg_bulk_op_id->ret_status) ==
+               (int32_t) HG_SUCCESS) {
+        struct hg_bulk_chunk_slot *slot;
+        hg_size_t offset = hg_bulk_chunk->next_offset;
+        hg_size_t chunk_size = HG_BULK_MIN(
+            hg_bulk_chunk->info.chunk_size, bulk_info->size - offset);
+        hg_op_id_t chunk_op_id = HG_OP_ID_NULL;
+
+        /* Find a free slot */
+        while (hg_bulk_chunk->slots[i].op_id != NULL)
+            i++;
+        slot = &hg_bulk_chunk->slots[i];
+        slot->offset = offset;
+
+        ret = hg_bulk_transfer(hg_bulk_op_id->core_context, hg_bulk_chunk_cb,
+            slot, bulk_info->op, hg_bulk_chunk->origin_addr,
+            hg_bulk_chunk->origin_id,
+            (struct hg_bulk *) bulk_info->origin_handle,
+            hg_bulk_chunk->origin_offset + offset,
+            (struct hg_bulk *) bulk_info->local_handle,
+            hg_bulk_chunk->local_offset + offset, chunk_size, &chunk_op_id);
+        if (ret != HG_SUCCESS) {
+            hg_atomic_cas32(&hg_bulk_op_id->ret_status, (int32_t) HG_SUCCESS,
+                (int32_t) ret);
+            HG_GOTO_ERROR(done, ret, ret,
+                "Could not transfer chunk at offset %" PRIu64, offset);
+        }
+
+        slot->op_id = (struct hg_bulk_op_id *) chunk_op_id;
+        hg_bulk_chunk->next_offset += chunk_size;
+        hg_bulk_chunk->in_flight++;
+    }
+
+done:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_bulk_chunk_cb(const struct hg_cb_info *callback_info)
+{
+    struct hg_bulk_chunk_slot *slot =
+        (struct hg_bulk_chunk_slot *) callback_info->arg;
+    struct hg_bulk_chunk *hg_bulk_chunk = slot->chunk;
+    struct hg_bulk_op_id *hg_bulk_op_id = hg_bulk_chunk->hg_bulk_op_id;
+    hg_return_t ret = callback_info->ret;
+    hg_bool_t completed;
+
+    /* Let the user consume the chunk before its slot gets re-used */
+    if (ret == HG_SUCCESS && hg_bulk_chunk->info.chunk_cb)
+        ret = hg_bulk_chunk->info.chunk_cb(hg_bulk_chunk->info.chunk_arg,
+            slot->offset, callback_info->info.bulk.size);
+
+    /* Keep first non-success ret status */
+    if (ret != HG_SUCCESS)
+        hg_atomic_cas32(&hg_bulk_op_id->ret_status, (int32_t) HG_SUCCESS,
+            (int32_t) ret);
+
+    hg_thread_mutex_lock(&hg_bulk_chunk->mutex);
+    slot->op_id = NULL;
+    hg_bulk_chunk->in_flight--;
+    (void) hg_bulk_chunk_issue(hg_bulk_chunk);
+    completed = (hg_bulk_chunk->in_flight == 0);
+    hg_thread_mutex_unlock(&hg_bulk_chunk->mutex);
+
+    /* Chunk state can no longer be accessed once completed */
+    if (completed)
+        hg_bulk_complete(hg_bulk_op_id,
+            (hg_return_t) hg_atomic_get32(&hg_bulk_op_id->ret_status), HG_TRUE);
+
+    return HG_SUCCESS;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_bulk_chunk_cancel(struct hg_bulk_chunk *hg_bulk_chunk)
+{
+    hg_return_t ret = HG_SUCCESS;
+    hg_uint32_t i;
+
+    /* Prevent remaining chunks from being issued */
+    hg_atomic_cas32(&hg_bulk_chunk->hg_bulk_op_id->ret_status,
+        (int32_t) HG_SUCCESS, (int32_t) HG_CANCELED);
+
+    hg_thread_mutex_lock(&hg_bulk_chunk->mutex);
+    for (i = 0; i < hg_bulk_chunk->info.max_in_flight; i++) {
+        if (hg_bulk_chunk->slots[i].op_id == NULL)
+            continue;
+
+        ret = hg_bulk_cancel(hg_bulk_chunk->slots[i].op_id);
+        HG_CHECK_HG_ERROR(done, ret, "Could not cancel chunk");
+    }
+
+done:
+    hg_thread_mutex_unlock(&hg_bulk_chunk->mutex);
+
+    return ret;
+}
+
 /*---------------------------------------------------------------------------*/
 static hg_return_t
 hg_bulk_transfer_self(hg_bulk_op_t op,
@@ -2140,15 +3023,18 @@ hg_bulk_transfer_na(hg_bulk_op_t op, na_addr_t na_origin_addr,
 {
     hg_bulk_na_op_id_t *hg_bulk_na_op_ids;
     na_bulk_op_t na_bulk_op;
+    na_bulk_opv_t na_bulk_opv;
     hg_return_t ret = HG_SUCCESS;
 
     /* Map op to NA op */
     switch (op) {
         case HG_BULK_PUSH:
             na_bulk_op = hg_bulk_na_put;
+            na_bulk_opv = hg_bulk_na_putv;
             break;
         case HG_BULK_PULL:
             na_bulk_op = hg_bulk_na_get;
+            na_bulk_opv = hg_bulk_na_getv;
             break;
         default:
             HG_GOTO_ERROR(done, ret, HG_INVALID_ARG, "Unknown bulk operation");
@@ -2179,6 +3065,8 @@ hg_bulk_transfer_na(hg_bulk_op_t op, na_addr_t na_origin_addr,
                     local_segment_start_index = 0;
         hg_size_t origin_segment_start_offset = 0,
                   local_segment_start_offset = 0;
+        size_t max_iovcnt = NA_Rma_get_max_iovcnt(hg_bulk_op_id->na_class);
+        hg_uint32_t piece_count;
         na_op_id_t **na_op_ids;
 
         /* Translate bulk_offset */
@@ -2192,14 +3080,24 @@ hg_bulk_transfer_na(hg_bulk_op_t op, na_addr_t na_origin_addr,
             hg_bulk_offset_translate(local_segments, local_count, local_offset,
                 &local_segment_start_index, &local_segment_start_offset);
 
-        /* Determine number of NA operations that will be needed */
-        hg_bulk_op_id->op_count = hg_bulk_transfer_get_op_count(origin_segments,
+        /* Determine number of segment pairs that will be transferred */
+        piece_count = hg_bulk_transfer_get_op_count(origin_segments,
             origin_count, origin_segment_start_index,
             origin_segment_start_offset, local_segments, local_count,
             local_segment_start_index, local_segment_start_offset, size);
-        HG_CHECK_ERROR(hg_bulk_op_id->op_count == 0, done, ret, HG_INVALID_ARG,
+        HG_CHECK_ERROR(piece_count == 0, done, ret, HG_INVALID_ARG,
             "Could not get bulk op_count");
 
+        /* Group segment pairs into vectored operations when supported. NB.
+         * plugins that register segments as a single handle (e.g., na_sm)
+         * only get here when there are more segments than the handle can
+         * hold */
+        if (max_iovcnt > 1 && piece_count > 1)
+            hg_bulk_op_id->op_count = (hg_uint32_t) (
+                (piece_count + max_iovcnt - 1) / max_iovcnt);
+        else
+            hg_bulk_op_id->op_count = piece_count;
+
         HG_LOG_DEBUG("Transferring data through NA in %u operation(s)",
             hg_bulk_op_id->op_count);
 
@@ -2225,14 +3123,24 @@ hg_bulk_transfer_na(hg_bulk_op_t op, na_addr_t na_origin_addr,
             na_op_ids = hg_bulk_na_op_ids->s;
 
         /* Do actual transfer */
-        ret = hg_bulk_transfer_segments_na(hg_bulk_op_id->na_class,
-            hg_bulk_op_id->na_context, na_bulk_op, hg_bulk_transfer_cb,
-            hg_bulk_op_id, na_origin_addr, origin_id, origin_segments,
-            origin_count, origin_mem_handles, origin_segment_start_index,
-            origin_segment_start_offset, local_segments, local_count,
-            local_mem_handles, local_segment_start_index,
-            local_segment_start_offset, size, na_op_ids,
-            hg_bulk_op_id->op_count);
+        if (hg_bulk_op_id->op_count < piece_count)
+            ret = hg_bulk_transfer_segments_nav(hg_bulk_op_id->na_class,
+                hg_bulk_op_id->na_context, na_bulk_opv, hg_bulk_transfer_cb,
+                hg_bulk_op_id, na_origin_addr, origin_id, origin_segments,
+                origin_count, origin_mem_handles, origin_segment_start_index,
+                origin_segment_start_offset, local_segments, local_count,
+                local_mem_handles, local_segment_start_index,
+                local_segment_start_offset, size, piece_count, max_iovcnt,
+                na_op_ids, hg_bulk_op_id->op_count);
+        else
+            ret = hg_bulk_transfer_segments_na(hg_bulk_op_id->na_class,
+                hg_bulk_op_id->na_context, na_bulk_op, hg_bulk_transfer_cb,
+                hg_bulk_op_id, na_origin_addr, origin_id, origin_segments,
+                origin_count, origin_mem_handles, origin_segment_start_index,
+                origin_segment_start_offset, local_segments, local_count,
+                local_mem_handles, local_segment_start_index,
+                local_segment_start_offset, size, na_op_ids,
+                hg_bulk_op_id->op_count);
         HG_CHECK_HG_ERROR(done, ret, "Could not transfer data segments");
     }
 
@@ -2363,6 +3271,107 @@ done:
     return ret;
 }
 
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_bulk_transfer_segments_nav(na_class_t *na_class, na_context_t *na_context,
+    na_bulk_opv_t na_bulk_opv, na_cb_t callback, void *arg,
+    na_addr_t origin_addr, uint8_t origin_id,
+    const struct hg_bulk_segment *origin_segments, hg_uint32_t origin_count,
+    na_mem_handle_t *origin_mem_handles, hg_size_t origin_segment_start_index,
+    hg_size_t origin_segment_start_offset,
+    const struct hg_bulk_segment *local_segments, hg_uint32_t local_count,
+    na_mem_handle_t *local_mem_handles, hg_size_t local_segment_start_index,
+    hg_size_t local_segment_start_offset, hg_size_t size,
+    hg_uint32_t piece_count, size_t max_iovcnt, na_op_id_t *na_op_ids[],
+    hg_uint32_t na_op_count)
+{
+    hg_size_t origin_segment_index = origin_segment_start_index;
+    hg_size_t local_segment_index = local_segment_start_index;
+    hg_size_t origin_segment_offset = origin_segment_start_offset;
+    hg_size_t local_segment_offset = local_segment_start_offset;
+    hg_size_t remaining_size = size;
+    struct na_rma_iov *local_iov = NULL, *origin_iov = NULL;
+    hg_uint32_t i, count = 0;
+    hg_return_t ret = HG_SUCCESS;
+
+    local_iov =
+        (struct na_rma_iov *) malloc(piece_count * sizeof(struct na_rma_iov));
+    HG_CHECK_ERROR(local_iov == NULL, done, ret, HG_NOMEM,
+        "Could not allocate local iov");
+    origin_iov =
+        (struct na_rma_iov *) malloc(piece_count * sizeof(struct na_rma_iov));
+    HG_CHECK_ERROR(origin_iov == NULL, done, ret, HG_NOMEM,
+        "Could not allocate origin iov");
+
+    /* Same segment walk as hg_bulk_transfer_segments_na(), each segment pair
+     * becomes one entry of the local and origin iovs */
+    for (i = 0; remaining_size > 0 && i < piece_count; i++) {
+        /* Can only transfer smallest size */
+        hg_size_t transfer_size = HG_BULK_MIN(
+            (origin_segments[origin_segment_index].len - origin_segment_offset),
+            (local_segments[local_segment_index].len - local_segment_offset));
+
+        /* Remaining size may be smaller */
+        transfer_size = HG_BULK_MIN(remaining_size, transfer_size);
+
+        local_iov[i] = (struct na_rma_iov){
+            .mem_handle = local_mem_handles[local_segment_index],
+            .offset = local_segment_offset,
+            .len = transfer_size};
+        origin_iov[i] = (struct na_rma_iov){
+            .mem_handle = origin_mem_handles[origin_segment_index],
+            .offset = origin_segment_offset,
+            .len = transfer_size};
+
+        remaining_size -= transfer_size;
+
+        /* Increment offsets from the size of data we transferred */
+        origin_segment_offset += transfer_size;
+        local_segment_offset += transfer_size;
+
+        /* Change segment if new offset exceeds segment size */
+        if (origin_segment_index < origin_count - 1 &&
+            origin_segment_offset >=
+                origin_segments[origin_segment_index].len) {
+            origin_segment_index++;
+            origin_segment_offset = 0;
+        }
+        if (local_segment_index < local_count - 1 &&
+            local_segment_offset >= local_segments[local_segment_index].len) {
+            local_segment_index++;
+            local_segment_offset = 0;
+        }
+    }
+    HG_CHECK_ERROR(i != piece_count || remaining_size > 0, done, ret,
+        HG_PROTOCOL_ERROR, "Expected %u segments, found %u", piece_count, i);
+
+    /* Post up to max_iovcnt segment pairs per operation */
+    for (i = 0; i < piece_count; count++) {
+        size_t iovcnt = HG_BULK_MIN(max_iovcnt, (size_t) (piece_count - i));
+        na_return_t na_ret;
+
+        HG_CHECK_ERROR(count >= na_op_count, done, ret, HG_PROTOCOL_ERROR,
+            "Exceeded expected number of operations (%u)", na_op_count);
+
+        na_ret = na_bulk_opv(na_class, na_context, callback, arg, &local_iov[i],
+            iovcnt, &origin_iov[i], iovcnt, origin_addr, origin_id,
+            na_op_ids[count]);
+        HG_CHECK_ERROR(na_ret != NA_SUCCESS, done, ret, (hg_return_t) na_ret,
+            "Could not transfer data (%s)", NA_Error_to_string(na_ret));
+
+        i += (hg_uint32_t) iovcnt;
+    }
+
+    HG_CHECK_ERROR(count != na_op_count, done, ret, HG_PROTOCOL_ERROR,
+        "Expected %u operations, issued %u", na_op_count, count);
+
+done:
+    free(local_iov);
+    free(origin_iov);
+
+    return ret;
+}
+
 /*---------------------------------------------------------------------------*/
 static int
 hg_bulk_transfer_cb(const struct na_cb_info *callback_info)
@@ -2442,6 +3451,10 @@ hg_bulk_cancel(struct hg_bulk_op_id *hg_bulk_op_id)
         HG_BULK_OP_CANCELED)
         return HG_SUCCESS;
 
+    /* Chunked transfers have no NA operations of their own */
+    if (hg_bulk_op_id->chunk)
+        return hg_bulk_chunk_cancel(hg_bulk_op_id->chunk);
+
 #ifdef NA_HAS_SM
     if (hg_bulk_op_id->na_class ==
         hg_bulk_op_id->core_context->core_class->na_sm_class)
@@ -2585,6 +3598,68 @@ done:
     return ret;
 }
 
+/*---------------------------------------------------------------------------*/
+hg_return_t
+HG_Bulk_cache_invalidate(
+    hg_class_t *hg_class, void *buf_ptr, hg_size_t buf_size)
+{
+    struct hg_bulk_cache *hg_bulk_cache;
+    hg_return_t ret = HG_SUCCESS;
+
+    HG_CHECK_ERROR(
+        hg_class == NULL, done, ret, HG_INVALID_ARG, "NULL HG class");
+
+    hg_bulk_cache = hg_core_class_get_bulk_cache(
+        hg_class->core_class, HG_Core_class_get_na(hg_class->core_class));
+    if (hg_bulk_cache)
+        hg_bulk_cache_invalidate(hg_bulk_cache, (hg_ptr_t) buf_ptr, buf_size);
+
+#ifdef NA_HAS_SM
+    if (HG_Core_class_get_na_sm(hg_class->core_class)) {
+        hg_bulk_cache = hg_core_class_get_bulk_cache(hg_class->core_class,
+            HG_Core_class_get_na_sm(hg_class->core_class));
+        if (hg_bulk_cache)
+            hg_bulk_cache_invalidate(
+                hg_bulk_cache, (hg_ptr_t) buf_ptr, buf_size);
+    }
+#endif
+
+done:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+hg_return_t
+HG_Bulk_cache_get_stats(
+    const hg_class_t *hg_class, struct hg_bulk_cache_stats *stats)
+{
+    struct hg_bulk_cache *hg_bulk_cache;
+    hg_return_t ret = HG_SUCCESS;
+
+    HG_CHECK_ERROR(
+        hg_class == NULL, done, ret, HG_INVALID_ARG, "NULL HG class");
+    HG_CHECK_ERROR(stats == NULL, done, ret, HG_INVALID_ARG, "NULL stats");
+
+    memset(stats, 0, sizeof(*stats));
+
+    hg_bulk_cache = hg_core_class_get_bulk_cache(
+        hg_class->core_class, HG_Core_class_get_na(hg_class->core_class));
+    if (hg_bulk_cache)
+        hg_bulk_cache_get_stats(hg_bulk_cache, stats);
+
+#ifdef NA_HAS_SM
+    if (HG_Core_class_get_na_sm(hg_class->core_class)) {
+        hg_bulk_cache = hg_core_class_get_bulk_cache(hg_class->core_class,
+            HG_Core_class_get_na_sm(hg_class->core_class));
+        if (hg_bulk_cache)
+            hg_bulk_cache_get_stats(hg_bulk_cache, stats);
+    }
+#endif
+
+done:
+    return ret;
+}
+
 /*---------------------------------------------------------------------------*/
 hg_return_t
 HG_Bulk_ref_incr(hg_bulk_t handle)
@@ -2899,6 +3974,68 @@ done:
     return ret;
 }
 
+/*---------------------------------------------------------------------------*/
+hg_return_t
+HG_Bulk_transfer_chunked(hg_context_t *context, hg_cb_t callback, void *arg,
+    hg_bulk_op_t op, hg_addr_t origin_addr, hg_uint8_t origin_id,
+    hg_bulk_t origin_handle, hg_size_t origin_offset, hg_bulk_t local_handle,
+    hg_size_t local_offset, hg_size_t size,
+    const struct hg_bulk_chunk_info *chunk_info, hg_op_id_t *op_id)
+{
+    struct hg_bulk *hg_bulk_origin = (struct hg_bulk *) origin_handle;
+    struct hg_bulk *hg_bulk_local = (struct hg_bulk *) local_handle;
+    hg_core_addr_t core_addr = (hg_core_addr_t) origin_addr;
+    hg_return_t ret = HG_SUCCESS;
+
+    HG_CHECK_ERROR(
+        context == NULL, done, ret, HG_INVALID_ARG, "NULL HG context");
+    HG_CHECK_ERROR(chunk_info == NULL, done, ret, HG_INVALID_ARG,
+        "NULL chunk info passed");
+
+    /* Origin handle sanity checks */
+    HG_CHECK_ERROR(hg_bulk_origin == NULL, done, ret, HG_INVALID_ARG,
+        "NULL origin handle passed");
+    HG_CHECK_ERROR((origin_offset + size) > hg_bulk_origin->desc.info.len, done,
+        ret, HG_INVALID_ARG,
+        "Exceeding size of memory exposed by origin handle (%" PRIu64
+        " + %" PRIu64 " > %" PRIu64 ")",
+        origin_offset, size, hg_bulk_origin->desc.info.len);
+    if (hg_bulk_origin->addr != HG_CORE_ADDR_NULL) {
+        HG_CHECK_ERROR(origin_addr != HG_ADDR_NULL, done, ret, HG_INVALID_ARG,
+            "Address information embedded into origin_handle, origin_addr "
+            "must be HG_ADDR_NULL");
+        core_addr = hg_bulk_origin->addr;
+        origin_id = hg_bulk_origin->context_id;
+    }
+
+    /* Local handle sanity checks */
+    HG_CHECK_ERROR(hg_bulk_local == NULL, done, ret, HG_INVALID_ARG,
+        "NULL origin handle passed");
+    HG_CHECK_ERROR((local_offset + size) > hg_bulk_local->desc.info.len, done,
+        ret, HG_INVALID_ARG,
+        "Exceeding size of memory exposed by local handle (%" PRIu64
+        " + %" PRIu64 " > %" PRIu64 ")",
+        local_offset, size, hg_bulk_local->desc.info.len);
+
+    /* Check permission flags */
+    HG_BULK_CHECK_FLAGS(op, hg_bulk_origin->desc.info.flags,
+        hg_bulk_local->desc.info.flags, done, ret);
+
+    HG_LOG_DEBUG("Transferring data between bulk handle (%p) and bulk handle "
+                 "(%p) in chunks of %" PRIu64 " bytes",
+        (void *) hg_bulk_origin, (void *) hg_bulk_local,
+        chunk_info->chunk_size);
+
+    /* Do bulk transfer */
+    ret = hg_bulk_transfer_chunked(context->core_context, callback, arg, op,
+        core_addr, origin_id, hg_bulk_origin, origin_offset, hg_bulk_local,
+        local_offset, size, chunk_info, op_id);
+    HG_CHECK_HG_ERROR(done, ret, "Could not start transfer of bulk data");
+
+done:
+    return ret;
+}
+
 /*---------------------------------------------------------------------------*/
 hg_return_t
 HG_Bulk_cancel(hg_op_id_t op_id)
@@ -13,6 +13,30 @@
 /* Public Type and Struct Definition */
 /*************************************/
 
+/* Callback executed after each chunk of a chunked transfer, \offset is the
+ * offset of the chunk from the start of the transfer. Returning a value other
+ * than HG_SUCCESS stops the transfer. */
+typedef hg_return_t (*hg_bulk_chunk_cb_t)(
+    void *arg, hg_size_t offset, hg_size_t size);
+
+/* Chunked transfer options */
+struct hg_bulk_chunk_info {
+    hg_size_t chunk_size;        /* Max size of each chunk (0 for no limit) */
+    hg_uint32_t max_in_flight;   /* Max number of chunks in flight (min 1) */
+    hg_bulk_chunk_cb_t chunk_cb; /* Chunk callback (optional) */
+    void *chunk_arg;             /* Pointer to data passed to chunk_cb */
+};
+
+/* Statistics of the registration cache (see bulk_cache_size in hg_init_info),
+ * registrations of the auto SM class are included */
+struct hg_bulk_cache_stats {
+    hg_uint64_t hit_count;    /* Registrations found in cache */
+    hg_uint64_t miss_count;   /* Registrations made on a cache miss */
+    hg_uint32_t entry_count;  /* Registrations currently held by cache */
+    hg_uint32_t unused_count; /* Held registrations not used by any handle */
+    hg_size_t size;           /* Registered bytes currently held by cache */
+};
+
 /*****************/
 /* Public Macros */
 /*****************/
@@ -37,6 +61,9 @@ extern "C" {
  * \remark If NULL is passed to buf_ptrs, i.e.,
  * \verbatim HG_Bulk_create(count, NULL, buf_sizes, flags, &handle) \endverbatim
  * memory for the missing buf_ptrs array will be internally allocated.
+ * If bulk_alloc_na is set in hg_init_info, internally allocated memory is
+ * obtained from NA_Mem_alloc(), which lets the SM plugin back it with
+ * shared-memory that local peers can copy without cross-memory attach.
  *
  * \param hg_class [IN]         pointer to HG class
  * \param count [IN]            number of segments
@@ -89,6 +116,36 @@ HG_Bulk_create_attr(hg_class_t *hg_class, hg_uint32_t count, void **buf_ptrs,
 HG_PUBLIC hg_return_t
 HG_Bulk_free(hg_bulk_t handle);
 
+/**
+ * Release cached memory registrations that overlap the specified memory
+ * range. When the bulk registration cache is enabled (see bulk_cache_size in
+ * hg_init_info), this must be called before memory that was passed to
+ * HG_Bulk_create() is freed or unmapped. Registrations that are still in use
+ * by bulk handles are released once the last handle using them is freed.
+ *
+ * \param hg_class [IN]         pointer to HG class
+ * \param buf_ptr [IN]          pointer to memory
+ * \param buf_size [IN]         size of memory
+ *
+ * \return HG_SUCCESS or corresponding HG error code
+ */
+HG_PUBLIC hg_return_t
+HG_Bulk_cache_invalidate(
+    hg_class_t *hg_class, void *buf_ptr, hg_size_t buf_size);
+
+/**
+ * Retrieve statistics of the registration cache, see hg_bulk_cache_stats for
+ * the meaning of each count. All counts are zero if the cache is disabled.
+ *
+ * \param hg_class [IN]         pointer to HG class
+ * \param stats [OUT]           pointer to cache stats
+ *
+ * \return HG_SUCCESS or corresponding HG error code
+ */
+HG_PUBLIC hg_return_t
+HG_Bulk_cache_get_stats(
+    const hg_class_t *hg_class, struct hg_bulk_cache_stats *stats);
+
 /**
  * Increment ref count on bulk handle.
  *
@@ -325,6 +382,44 @@ HG_Bulk_transfer_id(hg_context_t *context, hg_cb_t callback, void *arg,
     hg_bulk_t origin_handle, hg_size_t origin_offset, hg_bulk_t local_handle,
     hg_size_t local_offset, hg_size_t size, hg_op_id_t *op_id);
 
+/**
+ * Transfer data to/from origin using abstract bulk handles, splitting the
+ * transfer into chunks of at most \chunk_info->chunk_size bytes. At most
+ * \chunk_info->max_in_flight chunks are in flight at any time, a new chunk
+ * being issued each time one completes. Chunk callbacks are placed into the
+ * completion queue and can be triggered using HG_Trigger(), chunks may
+ * complete out of order when more than one chunk is in flight. After all
+ * chunks complete, user callback is placed into the completion queue.
+ * Canceling the returned operation ID cancels all the chunks in flight.
+ *
+ * \remark If address information is embedded into origin_handle (see
+ * HG_Bulk_bind()), origin_addr must be HG_ADDR_NULL and origin_id is ignored.
+ *
+ * \param context [IN]          pointer to HG context
+ * \param callback [IN]         pointer to function callback
+ * \param arg [IN]              pointer to data passed to callback
+ * \param op [IN]               transfer operation:
+ *                                  - HG_BULK_PUSH
+ *                                  - HG_BULK_PULL
+ * \param origin_addr [IN]      abstract address of origin
+ * \param origin_id [IN]        context ID of origin
+ * \param origin_handle [IN]    abstract bulk handle
+ * \param origin_offset [IN]    offset
+ * \param local_handle [IN]     abstract bulk handle
+ * \param local_offset [IN]     offset
+ * \param size [IN]             size of data to be transferred
+ * \param chunk_info [IN]       pointer to chunked transfer options
+ * \param op_id [OUT]           pointer to returned operation ID
+ *
+ * \return HG_SUCCESS or corresponding HG error code
+ */
+HG_PUBLIC hg_return_t
+HG_Bulk_transfer_chunked(hg_context_t *context, hg_cb_t callback, void *arg,
+    hg_bulk_op_t op, hg_addr_t origin_addr, hg_uint8_t origin_id,
+    hg_bulk_t origin_handle, hg_size_t origin_offset, hg_bulk_t local_handle,
+    hg_size_t local_offset, hg_size_t size,
+    const struct hg_bulk_chunk_info *chunk_info, hg_op_id_t *op_id);
+
 /**
  * Cancel an ongoing operation.
  *
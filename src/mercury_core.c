@@ -10,11 +10,14 @@
 #include "mercury_atomic_queue.h"
 #include "mercury_error.h"
 #include "mercury_event.h"
-#include "mercury_hash_table.h"
+#include "mercury_hash_map.h"
 #include "mercury_list.h"
 #include "mercury_mem.h"
+#include "mercury_mem_pool.h"
+#include "mercury_param.h"
 #include "mercury_poll.h"
 #include "mercury_queue.h"
+#include "mercury_thread_cache.h"
 #include "mercury_thread_condition.h"
 #include "mercury_thread_mutex.h"
 #include "mercury_thread_pool.h"
@@ -35,7 +38,8 @@
 /* Private flags */
 #define HG_CORE_SELF_FORWARD (1 << 3) /* Forward to self */
 
-/* Size of comletion queue used for holding completed requests */
+/* Default initial size of completion queue used for holding completed
+ * requests (new segments of twice the size are appended when full) */
 #define HG_CORE_ATOMIC_QUEUE_SIZE (1024)
 
 /* Pre-posted requests and op IDs */
@@ -43,12 +47,48 @@
 #define HG_CORE_POST_INCR          (256)
 #define HG_CORE_BULK_OP_INIT_COUNT (256)
 
+/* Number of buffers per block of shared request buffer pools */
+#define HG_CORE_REQUEST_BUF_COUNT (256)
+
+/* Period (ms) over which load is measured when adapting posted requests */
+#define HG_CORE_POST_PERIOD (1000)
+
+/* Post more requests when less than 1/HG_CORE_POST_LOW of them remain */
+#define HG_CORE_POST_LOW (4)
+
+/* Max number of posted requests released per batch */
+#define HG_CORE_POST_RELEASE_COUNT (32)
+
+/* Time in ms, used to check the end of a period without locking */
+#define HG_CORE_TIME_MS(t) ((int64_t) (hg_time_to_double(t) * 1000.0))
+
+/* Number of free handles cached per thread magazine */
+#define HG_CORE_HANDLE_CACHE_SIZE (64)
+
+/* Bulk transfers of at least that size are striped across NA rails */
+#define HG_CORE_RAIL_STRIPE_SIZE (65536)
+
+/* Max time (ms) spent blocking on one NA rail when rails have no poll set */
+#define HG_CORE_RAIL_POLL_SLICE (1)
+
 /* Timeout on finalize */
 #define HG_CORE_CLEANUP_TIMEOUT (5000)
 
-/* Max number of events for progress */
-#define HG_CORE_MAX_EVENTS        (1)
-#define HG_CORE_MAX_TRIGGER_COUNT (1)
+/* Default max number of events for progress */
+#define HG_CORE_MAX_EVENTS (16)
+
+/* Default max number of completions harvested/dequeued in a single pass */
+#define HG_CORE_MAX_TRIGGER_COUNT (32)
+
+/* Upper bound of the number of completions dequeued in a single pass, which
+ * are held on the stack */
+#define HG_CORE_TRIGGER_COUNT_LIMIT (256)
+
+/* Number of entries in per-context RPC dispatch cache (must be power of 2) */
+#define HG_CORE_RPC_CACHE_SIZE (64)
+
+/* Max number of cpu_spinwait() calls between polls when backing off */
+#define HG_CORE_PROGRESS_BACKOFF_MAX (1024)
 
 #ifdef NA_HAS_SM
 /* Addr string format */
@@ -102,6 +142,10 @@
 #define HG_CORE_HANDLE_CONTEXT(handle)                                         \
     ((struct hg_core_private_context *) (handle->core_handle.info.context))
 
+/* NA context ID of rail, rails of a context use consecutive IDs */
+#define HG_CORE_RAIL_ID(hg_core_class, id, rail)                               \
+    ((hg_uint8_t) ((id) * (hg_core_class)->na_rail_count + (rail)))
+
 #define HG_CORE_ADDR_CLASS(addr)                                               \
     ((struct hg_core_private_class *) (addr->core_addr.core_class))
 
@@ -120,13 +164,25 @@ struct hg_core_counters {
     hg_atomic_int64_t *bulk_count;           /* Bulk count */
 };
 
+/* RPC info stored in function map */
+struct hg_core_private_rpc_info {
+    struct hg_core_rpc_info rpc_info; /* Must remain as first field */
+    hg_id_t id;                       /* RPC ID */
+};
+
+/* Completion queue ring segment */
+struct hg_core_completion_queue {
+    struct hg_atomic_queue *queue; /* Atomic ring */
+    hg_atomic_int64_t next;        /* Next (larger) segment */
+};
+
 /* HG class */
 struct hg_core_private_class {
     struct hg_core_class core_class; /* Must remain as first field */
 #ifdef NA_HAS_SM
     na_sm_id_t host_id; /* Host ID for local identification */
 #endif
-    hg_hash_table_t *func_map; /* Function map */
+    hg_hash_map_t *func_map; /* Function map */
     hg_return_t (*more_data_acquire)(hg_core_handle_t, hg_op_t,
         void (*done_callback)(
             hg_core_handle_t, hg_return_t));     /* more_data_acquire */
@@ -140,10 +196,27 @@ struct hg_core_private_class {
     hg_atomic_int32_t n_addrs;      /* Atomic used for number of addrs */
     hg_atomic_int32_t n_bulks;      /* Atomic used for number of bulk handles */
     hg_atomic_int32_t request_tag;  /* Atomic used for tag generation */
+    hg_atomic_int32_t func_map_gen; /* Function map generation */
     hg_thread_spin_t func_map_lock; /* Function map lock */
+    struct hg_bulk_cache *bulk_cache; /* Registration cache */
+#ifdef NA_HAS_SM
+    struct hg_bulk_cache *bulk_sm_cache; /* SM registration cache */
+#endif
+    struct hg_mem_pool *request_buf_pool; /* Shared request buffers */
+#ifdef NA_HAS_SM
+    struct hg_mem_pool *request_sm_buf_pool; /* Shared SM request buffers */
+#endif
     uint32_t progress_mode;         /* NA progress mode */
     hg_uint32_t request_post_init;  /* Init count of posted requests */
     hg_uint32_t request_post_incr;  /* Incr count of posted requests */
+    hg_uint32_t completion_queue_size; /* Init size of completion queues */
+    hg_uint32_t trigger_count;         /* Completions dequeued per pass */
+    hg_uint32_t poll_event_count;      /* Max events per poll wait */
+    hg_time_t progress_spin_time;      /* Adaptive progress budget */
+    hg_uint8_t na_rail_count;          /* NA contexts per HG context */
+    hg_bool_t progress_adaptive;       /* Use adaptive progress */
+    hg_bool_t request_post_adaptive;   /* Adapt number of posted requests */
+    hg_bool_t bulk_alloc_na;           /* Allocate bulk memory from NA */
     hg_bool_t na_ext_init;          /* NA externally initialized */
     hg_bool_t loopback;             /* Able to self forward */
 };
@@ -154,18 +227,35 @@ typedef enum hg_core_poll_type {
 #ifdef NA_HAS_SM
     HG_CORE_POLL_SM,
 #endif
-    HG_CORE_POLL_NA
+    HG_CORE_POLL_NA /* Must remain last, rail N uses HG_CORE_POLL_NA + N */
 } hg_core_poll_type_t;
 
+/* Requests posted for incoming RPCs (protected by pending list lock) */
+struct hg_core_post_state {
+    hg_time_t period_start;        /* Start of current period */
+    hg_atomic_int64_t period_end;  /* End of current period (ms) */
+    hg_uint64_t recv_count;        /* Requests received */
+    hg_uint64_t grow_count;        /* Requests posted to grow */
+    hg_uint64_t shrink_count;      /* Requests released */
+    double recv_rate;              /* Requests/s during last period */
+    hg_uint32_t period_recv_count; /* Requests received in current period */
+    hg_uint32_t posted_count;      /* Requests currently posted */
+    hg_uint32_t total_count;       /* Requests posted or in use */
+    hg_uint32_t floor_count;       /* Initial number of requests */
+    hg_uint32_t peak_count;        /* Peak of requests in use in period */
+    hg_uint32_t target_count;      /* Requests kept after shrinking */
+};
+
 /* HG context */
 struct hg_core_private_context {
     struct hg_core_context core_context;      /* Must remain as first field */
     hg_thread_cond_t completion_queue_cond;   /* Completion queue cond */
     hg_thread_mutex_t completion_queue_mutex; /* Completion queue mutex */
-    hg_thread_mutex_t completion_queue_notify_mutex;   /* Notify mutex */
-    HG_QUEUE_HEAD(hg_completion_entry) backfill_queue; /* Backfill queue */
-    struct hg_atomic_queue *completion_queue;          /* Default queue */
+    hg_atomic_int64_t completion_queue_head;  /* Oldest segment */
+    hg_atomic_int64_t completion_queue_tail;  /* Segment currently pushed to */
+#ifdef HG_HAS_DEBUG
     HG_LIST_HEAD(hg_core_private_handle) created_list; /* Created handle list */
+#endif
     HG_LIST_HEAD(hg_core_private_handle) pending_list; /* Pending handle list */
 #ifdef NA_HAS_SM
     HG_LIST_HEAD(hg_core_private_handle) sm_pending_list; /* Pending handles */
@@ -173,12 +263,25 @@ struct hg_core_private_context {
     hg_return_t (*handle_create)(hg_core_handle_t, void *); /* Create cb */
     void *handle_create_arg;                                /* Create args */
     struct hg_bulk_op_pool *hg_bulk_op_pool;                /* Pool of op IDs */
+    struct hg_thread_cache *handle_cache;                   /* Free handles */
+    na_context_t **na_rails;                                /* NA rails */
     struct hg_poll_set *poll_set;                           /* Poll set */
-    struct hg_poll_event poll_events[HG_CORE_MAX_EVENTS];   /* Poll events */
+    struct hg_poll_event *poll_events;                      /* Poll events */
+    struct hg_core_post_state post_state;                   /* Posted state */
+    hg_atomic_int64_t rpc_cache[HG_CORE_RPC_CACHE_SIZE];    /* RPC info cache */
+    hg_atomic_int32_t rpc_cache_gen; /* Func map generation of RPC cache */
     hg_atomic_int32_t completion_queue_must_notify; /* Will notify if set */
-    hg_atomic_int32_t backfill_queue_count;         /* Backfill queue count */
+    hg_atomic_int32_t completion_queue_refs;        /* Segment users */
+    hg_atomic_int32_t completion_queue_waiters;     /* Waiting on cond */
+    hg_atomic_int32_t completion_queue_retiring;    /* Retiring segment */
     hg_atomic_int32_t n_handles;                    /* Number of handles */
+    hg_atomic_int32_t na_rail_next;                 /* Next striped rail */
+    hg_atomic_int64_t progress_spin_count;    /* Waits resolved spinning */
+    hg_atomic_int64_t progress_backoff_count; /* Waits resolved backing off */
+    hg_atomic_int64_t progress_poll_count;    /* Waits resolved polling */
+#ifdef HG_HAS_DEBUG
     hg_thread_spin_t created_list_lock;             /* Handle list lock */
+#endif
     hg_thread_spin_t pending_list_lock;             /* Pending list lock */
     int completion_queue_notify;                    /* Self notification */
     hg_bool_t finalizing;                           /* Prevent reposts */
@@ -220,48 +323,57 @@ typedef enum {
     HG_CORE_PROCESS       /*!< Process completion */
 } hg_core_op_type_t;
 
-/* HG core handle */
+/* Ack sent once more data is processed (allocated on first use) */
+struct hg_core_ack {
+    void *buf;         /* Ack buffer */
+    void *plugin_data; /* Ack buffer NA plugin data */
+    na_op_id_t *op_id; /* Operation ID for ack */
+};
+
+/* HG core handle, fields used by every RPC come first and rarely used state
+ * is kept out of line. Fields written by NA callbacks on completion start a
+ * new cache line so that they do not share it with fields written by the
+ * thread that posts the operation. */
 struct hg_core_private_handle {
     struct hg_core_handle core_handle; /* Must remain as first field */
-    struct hg_completion_entry hg_completion_entry; /* Completion queue entry */
-    HG_LIST_ENTRY(hg_core_private_handle) created;  /* Created list entry */
-    HG_LIST_ENTRY(hg_core_private_handle) pending;  /* Pending list entry */
-    struct hg_core_header in_header;                /* Input header */
-    struct hg_core_header out_header;               /* Output header */
-    na_class_t *na_class;                           /* NA class */
-    na_context_t *na_context;                       /* NA context */
-    na_addr_t na_addr;                              /* NA addr */
-    hg_core_cb_t request_callback;                  /* Request callback */
-    void *request_arg;              /* Request callback arguments */
-    hg_core_cb_t response_callback; /* Response callback */
-    void *response_arg;             /* Response callback arguments */
-    hg_return_t (*forward)(
-        struct hg_core_private_handle *hg_core_handle); /* forward */
-    hg_return_t (*respond)(
-        struct hg_core_private_handle *hg_core_handle); /* respond */
-    hg_return_t (*no_respond)(
-        struct hg_core_private_handle *hg_core_handle); /* no_respond */
-    void *ack_buf;             /* Ack buf for more data */
-    void *in_buf_plugin_data;  /* Input buffer NA plugin data */
-    void *out_buf_plugin_data; /* Output buffer NA plugin data */
-    void *ack_buf_plugin_data; /* Ack plugin data */
+    hg_atomic_int32_t ref_count;             /* Reference count */
+    unsigned int na_op_count;                /* Expected NA operation count */
+    hg_core_op_type_t op_type;               /* Core operation type */
+    hg_return_t ret;         /* Return code associated to handle */
+    na_tag_t tag;            /* Tag used for request and response */
+    hg_uint8_t cookie;       /* Cookie */
+    hg_uint8_t rail;         /* Rail of NA context (default NA class) */
+    hg_uint8_t na_target_id; /* NA context ID of target */
+    hg_bool_t repost;        /* Repost handle on completion (listen) */
+    hg_bool_t is_self;       /* Self processed */
+    hg_bool_t no_response;   /* Require response or not */
+    na_class_t *na_class;      /* NA class */
+    na_context_t *na_context;  /* NA context */
+    na_addr_t na_addr;         /* NA addr */
     na_op_id_t *na_send_op_id; /* Operation ID for send */
     na_op_id_t *na_recv_op_id; /* Operation ID for recv */
-    na_op_id_t *na_ack_op_id;  /* Operation ID for ack */
+    void *in_buf_plugin_data;  /* Input buffer NA plugin data */
+    void *out_buf_plugin_data; /* Output buffer NA plugin data */
     size_t in_buf_used;        /* Amount of input buffer used */
     size_t out_buf_used;       /* Amount of output buffer used */
-    na_tag_t tag;              /* Tag used for request and response */
-    hg_atomic_int32_t na_op_completed_count; /* Completed NA operation count */
-    hg_atomic_int32_t ref_count;             /* Reference count */
-    hg_atomic_int32_t status;                /* Handle status */
-    hg_atomic_int32_t ret_status;            /* Handle return status */
-    unsigned int na_op_count;                /* Expected NA operation count */
-    hg_core_op_type_t op_type;               /* Core operation type */
-    hg_return_t ret;       /* Return code associated to handle */
-    hg_uint8_t cookie;     /* Cookie */
-    hg_bool_t repost;      /* Repost handle on completion (listen) */
-    hg_bool_t is_self;     /* Self processed */
-    hg_bool_t no_response; /* Require response or not */
+    hg_core_cb_t request_callback;  /* Request callback */
+    void *request_arg;              /* Request callback arguments */
+    hg_core_cb_t response_callback; /* Response callback */
+    void *response_arg;             /* Response callback arguments */
+    HG_UTIL_ALIGNED(hg_atomic_int32_t status,
+        HG_MEM_CACHE_LINE_SIZE);                    /* Handle status */
+    hg_atomic_int32_t ret_status;                   /* Handle return status */
+    hg_atomic_int32_t na_op_completed_count;        /* Completed NA op count */
+    struct hg_completion_entry hg_completion_entry; /* Completion queue entry */
+    HG_LIST_ENTRY(hg_core_private_handle) pending;  /* Pending list entry */
+    struct hg_core_header in_header;                /* Input header */
+    struct hg_core_header out_header;               /* Output header */
+    struct hg_core_ack *ack;                        /* Ack of more data */
+    hg_atomic_int32_t ack_published;                /* Ack can be canceled */
+    struct hg_mem_pool *buf_pool;                   /* Shared in/out bufs */
+#ifdef HG_HAS_DEBUG
+    HG_LIST_ENTRY(hg_core_private_handle) created;  /* Created list entry */
+#endif
 };
 
 /* HG op id */
@@ -287,20 +399,28 @@ struct hg_core_op_id {
 /**
  * Equal function for function map.
  */
-static HG_INLINE int
-hg_core_int_equal(void *vlocation1, void *vlocation2);
+static int
+hg_core_int_equal(const void *vlocation1, const void *vlocation2);
 
 /**
  * Hash function for function map.
  */
-static HG_INLINE unsigned int
-hg_core_int_hash(void *vlocation);
+static unsigned int
+hg_core_int_hash(const void *vlocation);
 
 /**
  * Free function for value in function map.
  */
 static void
-hg_core_func_map_value_free(hg_hash_table_value_t value);
+hg_core_func_map_value_free(const void *key, void *value, void *arg);
+
+/**
+ * Retrieve RPC info from function map. Lookups are first resolved from the
+ * context's RPC cache without taking the function map lock.
+ */
+static HG_INLINE struct hg_core_rpc_info *
+hg_core_func_map_lookup(struct hg_core_private_class *hg_core_class,
+    struct hg_core_private_context *context, hg_id_t id);
 
 /**
  * Generate a new tag.
@@ -368,6 +488,35 @@ static hg_return_t
 hg_core_context_check_pending(struct hg_core_private_context *context,
     na_class_t *na_class, na_context_t *na_context, unsigned int request_count);
 
+/**
+ * Measure load over last period and release posted requests that are no
+ * longer needed.
+ */
+static hg_return_t
+hg_core_context_post_adapt(struct hg_core_private_context *context);
+
+/**
+ * Select up to max posted requests to release, keeping initial ones on each
+ * rail. Must be called with pending_list_lock held.
+ */
+static unsigned int
+hg_core_context_post_release(struct hg_core_private_context *context,
+    struct hg_core_private_handle **handles, unsigned int max);
+
+/**
+ * Get poll descriptor of NA rail (-1 if shared with a previous rail).
+ */
+static int
+hg_core_context_rail_fd(
+    struct hg_core_private_context *context, unsigned int rail);
+
+/**
+ * Select NA rail for a transfer of size bytes to addr.
+ */
+static HG_INLINE unsigned int
+hg_core_context_rail(
+    struct hg_core_private_context *context, const void *addr, hg_size_t size);
+
 /**
  * Wail until handle lists are empty.
  */
@@ -460,7 +609,7 @@ hg_core_addr_deserialize(struct hg_core_private_class *hg_core_class,
  */
 static hg_return_t
 hg_core_create(struct hg_core_private_context *context, na_class_t *na_class,
-    na_context_t *na_context,
+    na_context_t *na_context, struct hg_mem_pool *buf_pool,
     struct hg_core_private_handle **hg_core_handle_ptr);
 
 /**
@@ -469,6 +618,18 @@ hg_core_create(struct hg_core_private_context *context, na_class_t *na_class,
 static hg_return_t
 hg_core_destroy(struct hg_core_private_handle *hg_core_handle);
 
+/**
+ * Allocate memory for handle cache.
+ */
+static void *
+hg_core_handle_mem_alloc(void *arg);
+
+/**
+ * Free memory from handle cache.
+ */
+static void
+hg_core_handle_mem_free(void *obj, void *arg);
+
 /**
  * Allocate new handle.
  */
@@ -486,7 +647,8 @@ hg_core_free(struct hg_core_private_handle *hg_core_handle);
  */
 static hg_return_t
 hg_core_alloc_na(struct hg_core_private_handle *hg_core_handle,
-    na_class_t *na_class, na_context_t *na_context);
+    na_class_t *na_class, na_context_t *na_context,
+    struct hg_mem_pool *buf_pool);
 
 /**
  * Freee NA resources.
@@ -494,6 +656,39 @@ hg_core_alloc_na(struct hg_core_private_handle *hg_core_handle,
 static hg_return_t
 hg_core_free_na(struct hg_core_private_handle *hg_core_handle);
 
+/**
+ * Allocate ack buffer, ack op ID is created on first use.
+ */
+static hg_return_t
+hg_core_ack_alloc(
+    struct hg_core_private_handle *hg_core_handle, size_t buf_size);
+
+/**
+ * Free ack buffer.
+ */
+static void
+hg_core_ack_buf_free(struct hg_core_private_handle *hg_core_handle);
+
+/**
+ * Create pool of request buffers shared by all contexts (NULL if buffers of
+ * NA class cannot be shared).
+ */
+static hg_return_t
+hg_core_request_buf_pool_create(
+    na_class_t *na_class, struct hg_mem_pool **pool_ptr);
+
+/**
+ * Get output buffer from shared pool once request is received.
+ */
+static hg_return_t
+hg_core_out_buf_attach(struct hg_core_private_handle *hg_core_handle);
+
+/**
+ * Return output buffer to shared pool.
+ */
+static void
+hg_core_out_buf_detach(struct hg_core_private_handle *hg_core_handle);
+
 /**
  * Reset handle.
  */
@@ -665,6 +860,14 @@ static hg_return_t
 hg_core_progress(
     struct hg_core_private_context *context, unsigned int timeout_ms);
 
+/**
+ * Busy-poll context then poll with exponential backoff, each phase lasting
+ * for the adaptive progress budget. Returns HG_TIMEOUT if nothing progressed.
+ */
+static hg_return_t
+hg_core_progress_spin(
+    struct hg_core_private_context *context, hg_time_t deadline);
+
 /**
  * Determines when it is safe to block.
  */
@@ -690,6 +893,14 @@ hg_core_poll(struct hg_core_private_context *context, unsigned int timeout_ms,
  */
 static hg_return_t
 hg_core_progress_na(na_class_t *na_class, na_context_t *na_context,
+    unsigned int trigger_count, unsigned int timeout_ms,
+    hg_bool_t *progressed_ptr);
+
+/**
+ * Make progress on all the NA rails of the default NA class.
+ */
+static hg_return_t
+hg_core_progress_rails(struct hg_core_private_context *context,
     unsigned int timeout_ms, hg_bool_t *progressed_ptr);
 
 /**
@@ -699,6 +910,61 @@ static HG_INLINE hg_return_t
 hg_core_progress_loopback_notify(
     struct hg_core_private_context *context, hg_bool_t *progressed_ptr);
 
+/**
+ * Allocate completion queue segment that can hold count entries.
+ */
+static struct hg_core_completion_queue *
+hg_core_completion_queue_alloc(unsigned int count);
+
+/**
+ * Free completion queue segment and all the segments that follow it.
+ */
+static void
+hg_core_completion_queue_free(
+    struct hg_core_completion_queue *hg_core_completion_queue);
+
+/**
+ * Push entry to completion queue, a new segment is appended if the last
+ * segment is full.
+ */
+static int
+hg_core_completion_queue_push(struct hg_core_private_context *context,
+    struct hg_completion_entry *hg_completion_entry);
+
+/**
+ * Free oldest completion queue segments once they are drained and a newer
+ * segment exists. Caller must hold a reference to the segments.
+ */
+static void
+hg_core_completion_queue_retire(struct hg_core_private_context *context);
+
+/**
+ * Determine whether all completion queue segments are empty.
+ */
+static HG_INLINE hg_bool_t
+hg_core_completion_queue_is_empty(struct hg_core_private_context *context);
+
+/**
+ * Return number of entries currently in completion queues.
+ */
+static HG_INLINE unsigned int
+hg_core_completion_count(struct hg_core_private_context *context);
+
+/**
+ * Dequeue up to max_count entries from completion queues.
+ */
+static unsigned int
+hg_core_completion_pop(struct hg_core_private_context *context,
+    struct hg_completion_entry *hg_completion_entries[],
+    unsigned int max_count);
+
+/**
+ * Wait for completion queues to be non-empty.
+ */
+static hg_return_t
+hg_core_completion_wait(
+    struct hg_core_private_context *context, unsigned int timeout_ms);
+
 /**
  * Trigger callbacks.
  */
@@ -707,6 +973,21 @@ hg_core_trigger(struct hg_core_private_context *context,
     unsigned int timeout_ms, unsigned int max_count,
     unsigned int *actual_count);
 
+/**
+ * Trigger callbacks already queued in a single pass.
+ */
+static hg_return_t
+hg_core_trigger_batch(struct hg_core_private_context *context,
+    unsigned int timeout_ms, unsigned int max_count,
+    unsigned int *actual_count);
+
+/**
+ * Trigger array of completion entries.
+ */
+static hg_return_t
+hg_core_trigger_entries(struct hg_completion_entry *hg_completion_entries[],
+    unsigned int count);
+
 /**
  * Trigger callback from HG lookup op ID.
  */
@@ -745,31 +1026,73 @@ HG_LOG_SUBSYS_DLOG_DECL_REGISTER(diag, hg);
 #endif
 
 /*---------------------------------------------------------------------------*/
-static HG_INLINE int
-hg_core_int_equal(void *vlocation1, void *vlocation2)
+static int
+hg_core_int_equal(const void *vlocation1, const void *vlocation2)
 {
-    return *((int *) vlocation1) == *((int *) vlocation2);
+    return *((const hg_id_t *) vlocation1) == *((const hg_id_t *) vlocation2);
 }
 
 /*---------------------------------------------------------------------------*/
-static HG_INLINE unsigned int
-hg_core_int_hash(void *vlocation)
+static unsigned int
+hg_core_int_hash(const void *vlocation)
 {
-    return *((unsigned int *) vlocation);
+    hg_id_t id = *((const hg_id_t *) vlocation);
+
+    return (unsigned int) (id ^ (id >> 32));
 }
 
 /*---------------------------------------------------------------------------*/
 static void
-hg_core_func_map_value_free(hg_hash_table_value_t value)
+hg_core_func_map_value_free(const void *key, void *value, void *arg)
 {
     struct hg_core_rpc_info *hg_core_rpc_info =
         (struct hg_core_rpc_info *) value;
 
+    (void) key;
+    (void) arg;
+
     if (hg_core_rpc_info->free_callback)
         hg_core_rpc_info->free_callback(hg_core_rpc_info->data);
     free(hg_core_rpc_info);
 }
 
+/*---------------------------------------------------------------------------*/
+static HG_INLINE struct hg_core_rpc_info *
+hg_core_func_map_lookup(struct hg_core_private_class *hg_core_class,
+    struct hg_core_private_context *context, hg_id_t id)
+{
+    hg_atomic_int64_t *cache_entry =
+        &context->rpc_cache[id & (HG_CORE_RPC_CACHE_SIZE - 1)];
+    struct hg_core_private_rpc_info *hg_core_rpc_info;
+    int32_t func_map_gen;
+    unsigned int i;
+
+    /* Cache is only valid if no RPC was deregistered since it was filled */
+    if (hg_atomic_get32(&context->rpc_cache_gen) ==
+        hg_atomic_get32(&hg_core_class->func_map_gen)) {
+        hg_core_rpc_info =
+            (struct hg_core_private_rpc_info *) hg_atomic_get64(cache_entry);
+        if (hg_core_rpc_info && hg_core_rpc_info->id == id)
+            return &hg_core_rpc_info->rpc_info;
+    }
+
+    /* Cache miss, all cache updates are serialized by the func map lock */
+    hg_thread_spin_lock(&hg_core_class->func_map_lock);
+    func_map_gen = hg_atomic_get32(&hg_core_class->func_map_gen);
+    if (hg_atomic_get32(&context->rpc_cache_gen) != func_map_gen) {
+        for (i = 0; i < HG_CORE_RPC_CACHE_SIZE; i++)
+            hg_atomic_set64(&context->rpc_cache[i], 0);
+        hg_atomic_set32(&context->rpc_cache_gen, func_map_gen);
+    }
+    hg_core_rpc_info = (struct hg_core_private_rpc_info *) hg_hash_map_lookup(
+        hg_core_class->func_map, &id);
+    if (hg_core_rpc_info)
+        hg_atomic_set64(cache_entry, (int64_t) hg_core_rpc_info);
+    hg_thread_spin_unlock(&hg_core_class->func_map_lock);
+
+    return (hg_core_rpc_info) ? &hg_core_rpc_info->rpc_info : NULL;
+}
+
 /*---------------------------------------------------------------------------*/
 static HG_INLINE na_tag_t
 hg_core_gen_request_tag(struct hg_core_private_class *hg_core_class)
@@ -848,6 +1171,8 @@ hg_core_init(const char *na_info_string, hg_bool_t na_listen,
     const char *na_class_name;
     hg_bool_t auto_sm = HG_FALSE;
 #endif
+    hg_size_t bulk_cache_size = 0;
+    hg_bool_t request_buf_shared = HG_FALSE;
     hg_bool_t diag = HG_FALSE;
     hg_return_t ret = HG_SUCCESS;
 
@@ -873,7 +1198,32 @@ hg_core_init(const char *na_info_string, hg_bool_t na_listen,
             hg_core_class->request_post_init = hg_init_info->request_post_init;
             hg_core_class->request_post_incr = hg_init_info->request_post_incr;
         }
+        hg_core_class->request_post_adaptive =
+            hg_init_info->request_post_adaptive;
+        /* Adaptive mode needs to post more requests when running out */
+        if (hg_core_class->request_post_adaptive &&
+            hg_core_class->request_post_incr == 0)
+            hg_core_class->request_post_incr = HG_CORE_POST_INCR;
         hg_core_class->progress_mode = hg_init_info->na_init_info.progress_mode;
+        /* Busy-polling is pointless if progress never blocks */
+        if (hg_init_info->progress_spin_us > 0 &&
+            !(hg_core_class->progress_mode & NA_NO_BLOCK)) {
+            hg_core_class->progress_adaptive = HG_TRUE;
+            hg_core_class->progress_spin_time = hg_time_from_double(
+                (double) hg_init_info->progress_spin_us / 1000000.0);
+        }
+        /* Round up completion queue size to next power of 2 */
+        if (hg_init_info->completion_queue_size == 0)
+            hg_core_class->completion_queue_size = HG_CORE_ATOMIC_QUEUE_SIZE;
+        else {
+            hg_core_class->completion_queue_size = 2;
+            while (hg_core_class->completion_queue_size <
+                       hg_init_info->completion_queue_size &&
+                   hg_core_class->completion_queue_size < (UINT32_MAX >> 2))
+                hg_core_class->completion_queue_size <<= 1;
+        }
+        hg_core_class->trigger_count = hg_init_info->trigger_batch_size;
+        hg_core_class->poll_event_count = hg_init_info->poll_event_count;
 #ifdef NA_HAS_SM
         auto_sm = hg_init_info->auto_sm;
 #else
@@ -882,6 +1232,10 @@ hg_core_init(const char *na_info_string, hg_bool_t na_listen,
             "please turn ON NA_USE_SM in CMake options");
 #endif
         hg_core_class->loopback = !hg_init_info->no_loopback;
+        bulk_cache_size = hg_init_info->bulk_cache_size;
+        request_buf_shared = hg_init_info->request_buf_shared;
+        hg_core_class->bulk_alloc_na = hg_init_info->bulk_alloc_na;
+        hg_core_class->na_rail_count = hg_init_info->na_rail_count;
 #ifdef HG_HAS_DEBUG
         diag = hg_init_info->stats;
 #else
@@ -900,8 +1254,17 @@ hg_core_init(const char *na_info_string, hg_bool_t na_listen,
     } else {
         hg_core_class->request_post_init = HG_CORE_POST_INIT;
         hg_core_class->request_post_incr = HG_CORE_POST_INCR;
+        hg_core_class->completion_queue_size = HG_CORE_ATOMIC_QUEUE_SIZE;
         hg_core_class->loopback = HG_TRUE;
     }
+    if (hg_core_class->na_rail_count == 0)
+        hg_core_class->na_rail_count = 1;
+    if (hg_core_class->trigger_count == 0)
+        hg_core_class->trigger_count = HG_CORE_MAX_TRIGGER_COUNT;
+    else if (hg_core_class->trigger_count > HG_CORE_TRIGGER_COUNT_LIMIT)
+        hg_core_class->trigger_count = HG_CORE_TRIGGER_COUNT_LIMIT;
+    if (hg_core_class->poll_event_count == 0)
+        hg_core_class->poll_event_count = HG_CORE_MAX_EVENTS;
 
     if (diag)
         hg_log_set_subsys_level("diag", HG_LOG_LEVEL_DEBUG);
@@ -976,6 +1339,37 @@ hg_core_init(const char *na_info_string, hg_bool_t na_listen,
     }
 #endif
 
+    /* Create registration caches */
+    if (bulk_cache_size > 0) {
+        ret = hg_bulk_cache_create(hg_core_class->core_class.na_class,
+            bulk_cache_size, &hg_core_class->bulk_cache);
+        HG_CHECK_HG_ERROR(error, ret, "Could not create bulk cache");
+#ifdef NA_HAS_SM
+        if (hg_core_class->core_class.na_sm_class) {
+            ret = hg_bulk_cache_create(hg_core_class->core_class.na_sm_class,
+                bulk_cache_size, &hg_core_class->bulk_sm_cache);
+            HG_CHECK_HG_ERROR(error, ret, "Could not create bulk SM cache");
+        }
+#endif
+    }
+
+    /* Create pools of request buffers shared by contexts */
+    if (request_buf_shared) {
+        ret = hg_core_request_buf_pool_create(
+            hg_core_class->core_class.na_class,
+            &hg_core_class->request_buf_pool);
+        HG_CHECK_HG_ERROR(error, ret, "Could not create request buffer pool");
+#ifdef NA_HAS_SM
+        if (hg_core_class->core_class.na_sm_class) {
+            ret = hg_core_request_buf_pool_create(
+                hg_core_class->core_class.na_sm_class,
+                &hg_core_class->request_sm_buf_pool);
+            HG_CHECK_HG_ERROR(
+                error, ret, "Could not create SM request buffer pool");
+        }
+#endif
+    }
+
     /* Compute max request tag */
     na_max_tag = NA_Msg_get_max_tag(hg_core_class->core_class.na_class);
     HG_CHECK_ERROR(
@@ -1005,18 +1399,15 @@ hg_core_init(const char *na_info_string, hg_bool_t na_listen,
     /* No bulk created yet */
     hg_atomic_init32(&hg_core_class->n_bulks, 0);
 
-    /* Create new function map */
-    hg_core_class->func_map =
-        hg_hash_table_new(hg_core_int_hash, hg_core_int_equal);
+    /* Create new function map (lookups do not take the function map lock) */
+    hg_core_class->func_map = hg_hash_map_new(
+        sizeof(hg_id_t), hg_core_int_hash, hg_core_int_equal);
     HG_CHECK_ERROR(hg_core_class->func_map == NULL, error, ret, HG_NOMEM,
         "Could not create function map");
 
-    /* Automatically free all the values with the hash map */
-    hg_hash_table_register_free_functions(
-        hg_core_class->func_map, free, hg_core_func_map_value_free);
-
     /* Initialize mutex */
     hg_thread_spin_init(&hg_core_class->func_map_lock);
+    hg_atomic_init32(&hg_core_class->func_map_gen, 0);
 
     // TODO return error code
     (void) ret;
@@ -1052,9 +1443,12 @@ hg_core_finalize(struct hg_core_private_class *hg_core_class)
     HG_CHECK_ERROR(n_addrs != 0, done, ret, HG_BUSY,
         "HG addrs must be freed before finalizing HG (%d remaining)", n_addrs);
 
-    /* Delete function map */
-    if (hg_core_class->func_map)
-        hg_hash_table_free(hg_core_class->func_map);
+    /* Delete function map and free all the values */
+    if (hg_core_class->func_map) {
+        hg_hash_map_iterate(
+            hg_core_class->func_map, hg_core_func_map_value_free, NULL);
+        hg_hash_map_free(hg_core_class->func_map);
+    }
     hg_core_class->func_map = NULL;
 
     /* Free user data */
@@ -1065,6 +1459,28 @@ hg_core_finalize(struct hg_core_private_class *hg_core_class)
     /* Destroy mutex */
     hg_thread_spin_destroy(&hg_core_class->func_map_lock);
 
+    /* Release cached registrations before NA classes are finalized */
+    if (hg_core_class->bulk_cache) {
+        ret = hg_bulk_cache_destroy(hg_core_class->bulk_cache);
+        HG_CHECK_HG_ERROR(done, ret, "Could not destroy bulk cache");
+        hg_core_class->bulk_cache = NULL;
+    }
+#ifdef NA_HAS_SM
+    if (hg_core_class->bulk_sm_cache) {
+        ret = hg_bulk_cache_destroy(hg_core_class->bulk_sm_cache);
+        HG_CHECK_HG_ERROR(done, ret, "Could not destroy bulk SM cache");
+        hg_core_class->bulk_sm_cache = NULL;
+    }
+#endif
+
+    /* Release shared request buffers */
+    hg_mem_pool_destroy(hg_core_class->request_buf_pool);
+    hg_core_class->request_buf_pool = NULL;
+#ifdef NA_HAS_SM
+    hg_mem_pool_destroy(hg_core_class->request_sm_buf_pool);
+    hg_core_class->request_sm_buf_pool = NULL;
+#endif
+
     if (!hg_core_class->na_ext_init) {
         /* Finalize interface */
         na_ret = NA_Finalize(hg_core_class->core_class.na_class);
@@ -1103,13 +1519,44 @@ hg_core_bulk_decr(hg_core_class_t *hg_core_class)
         &((struct hg_core_private_class *) hg_core_class)->n_bulks);
 }
 
+/*---------------------------------------------------------------------------*/
+struct hg_bulk_cache *
+hg_core_class_get_bulk_cache(
+    hg_core_class_t *hg_core_class, na_class_t *na_class)
+{
+#ifdef NA_HAS_SM
+    if (na_class == hg_core_class->na_sm_class)
+        return ((struct hg_core_private_class *) hg_core_class)->bulk_sm_cache;
+#endif
+    (void) na_class;
+
+    return ((struct hg_core_private_class *) hg_core_class)->bulk_cache;
+}
+
+/*---------------------------------------------------------------------------*/
+na_class_t *
+hg_core_class_get_bulk_alloc_na(hg_core_class_t *hg_core_class)
+{
+    if (!((struct hg_core_private_class *) hg_core_class)->bulk_alloc_na)
+        return NULL;
+#ifdef NA_HAS_SM
+    /* Local peers can then copy memory without cross-memory attach */
+    if (hg_core_class->na_sm_class)
+        return hg_core_class->na_sm_class;
+#endif
+
+    return hg_core_class->na_class;
+}
+
 /*---------------------------------------------------------------------------*/
 static hg_return_t
 hg_core_context_create(hg_core_class_t *hg_core_class, hg_uint8_t id,
     struct hg_core_private_context **context_ptr)
 {
     struct hg_core_private_context *context = NULL;
+    struct hg_core_completion_queue *completion_queue;
     hg_return_t ret = HG_SUCCESS;
+    unsigned int rail_count, i;
     int na_poll_fd;
 
     context = (struct hg_core_private_context *) malloc(
@@ -1119,38 +1566,70 @@ hg_core_context_create(hg_core_class_t *hg_core_class, hg_uint8_t id,
 
     memset(context, 0, sizeof(struct hg_core_private_context));
     context->core_context.core_class = hg_core_class;
-    context->completion_queue =
-        hg_atomic_queue_alloc(HG_CORE_ATOMIC_QUEUE_SIZE);
-    HG_CHECK_ERROR(context->completion_queue == NULL, error, ret, HG_NOMEM,
+    completion_queue = hg_core_completion_queue_alloc(
+        ((struct hg_core_private_class *) hg_core_class)
+            ->completion_queue_size);
+    HG_CHECK_ERROR(completion_queue == NULL, error, ret, HG_NOMEM,
         "Could not allocate queue");
+    hg_atomic_init64(
+        &context->completion_queue_head, (int64_t) completion_queue);
+    hg_atomic_init64(
+        &context->completion_queue_tail, (int64_t) completion_queue);
+    hg_atomic_init32(&context->completion_queue_refs, 0);
+    hg_atomic_init32(&context->completion_queue_waiters, 0);
+    hg_atomic_init32(&context->completion_queue_retiring, 0);
 
-    HG_QUEUE_INIT(&context->backfill_queue);
-    hg_atomic_init32(&context->backfill_queue_count, 0);
     HG_LIST_INIT(&context->pending_list);
 #ifdef NA_HAS_SM
     HG_LIST_INIT(&context->sm_pending_list);
 #endif
+#ifdef HG_HAS_DEBUG
     HG_LIST_INIT(&context->created_list);
+#endif
 
     /* No handle created yet */
     hg_atomic_init32(&context->n_handles, 0);
 
+    /* Progress stats */
+    hg_atomic_init64(&context->progress_spin_count, 0);
+    hg_atomic_init64(&context->progress_backoff_count, 0);
+    hg_atomic_init64(&context->progress_poll_count, 0);
+
     /* Notifications of completion queue events */
     hg_atomic_init32(&context->completion_queue_must_notify, 0);
-    hg_thread_mutex_init(&context->completion_queue_notify_mutex);
 
     /* Initialize completion queue mutex/cond */
     hg_thread_mutex_init(&context->completion_queue_mutex);
     hg_thread_cond_init(&context->completion_queue_cond);
 
     hg_thread_spin_init(&context->pending_list_lock);
+#ifdef HG_HAS_DEBUG
     hg_thread_spin_init(&context->created_list_lock);
+#endif
 
-    /* Create NA context */
-    context->core_context.na_context =
-        NA_Context_create_id(hg_core_class->na_class, id);
-    HG_CHECK_ERROR(context->core_context.na_context == NULL, error, ret,
-        HG_NOMEM, "Could not create NA context");
+    /* Create per-thread cache of handles */
+    context->handle_cache = hg_thread_cache_create(HG_CORE_HANDLE_CACHE_SIZE,
+        hg_core_handle_mem_alloc, hg_core_handle_mem_free, NULL);
+    HG_CHECK_ERROR(context->handle_cache == NULL, error, ret, HG_NOMEM,
+        "Could not create handle cache");
+
+    /* Create NA contexts, first rail is the default NA context */
+    rail_count = HG_CORE_CONTEXT_CLASS(context)->na_rail_count;
+    HG_CHECK_ERROR((unsigned int) id * rail_count + rail_count - 1 > UINT8_MAX,
+        error, ret, HG_INVALID_ARG,
+        "Context ID (%" PRIu8 ") too large for %u NA rails", id, rail_count);
+    context->na_rails =
+        (na_context_t **) calloc(rail_count, sizeof(na_context_t *));
+    HG_CHECK_ERROR(context->na_rails == NULL, error, ret, HG_NOMEM,
+        "Could not allocate NA rails");
+    for (i = 0; i < rail_count; i++) {
+        context->na_rails[i] = NA_Context_create_id(hg_core_class->na_class,
+            HG_CORE_RAIL_ID(HG_CORE_CONTEXT_CLASS(context), id, i));
+        HG_CHECK_ERROR(context->na_rails[i] == NULL, error, ret, HG_NOMEM,
+            "Could not create NA context (rail %u)", i);
+    }
+    context->core_context.na_context = context->na_rails[0];
+    hg_atomic_init32(&context->na_rail_next, 0);
 
 #ifdef NA_HAS_SM
     if (hg_core_class->na_sm_class) {
@@ -1175,11 +1654,23 @@ hg_core_context_create(hg_core_class_t *hg_core_class, hg_uint8_t id,
         context->poll_set = hg_poll_create();
         HG_CHECK_ERROR(context->poll_set == NULL, error, ret, HG_NOMEM,
             "Could not create poll set");
-
-        event.data.u32 = (uint32_t) HG_CORE_POLL_NA;
-        rc = hg_poll_add(context->poll_set, na_poll_fd, &event);
-        HG_CHECK_ERROR(rc != HG_UTIL_SUCCESS, error, ret, HG_NOMEM,
-            "hg_poll_add() failed (na_poll_fd=%d)", na_poll_fd);
+        context->poll_events = (struct hg_poll_event *) malloc(
+            HG_CORE_CONTEXT_CLASS(context)->poll_event_count *
+            sizeof(struct hg_poll_event));
+        HG_CHECK_ERROR(context->poll_events == NULL, error, ret, HG_NOMEM,
+            "Could not allocate poll events");
+
+        /* Rails may share the same descriptor */
+        for (i = 0; i < rail_count; i++) {
+            na_poll_fd = hg_core_context_rail_fd(context, i);
+            if (na_poll_fd <= 0)
+                continue;
+
+            event.data.u32 = (uint32_t) HG_CORE_POLL_NA + i;
+            rc = hg_poll_add(context->poll_set, na_poll_fd, &event);
+            HG_CHECK_ERROR(rc != HG_UTIL_SUCCESS, error, ret, HG_NOMEM,
+                "hg_poll_add() failed (na_poll_fd=%d)", na_poll_fd);
+        }
 
 #ifdef NA_HAS_SM
         if (hg_core_class->na_sm_class && context->core_context.na_sm_context) {
@@ -1236,8 +1727,8 @@ static hg_return_t
 hg_core_context_destroy(struct hg_core_private_context *context)
 {
     int32_t n_handles;
-    hg_bool_t empty;
     hg_return_t ret = HG_SUCCESS;
+    unsigned int i;
     int rc;
 
     if (!context)
@@ -1255,6 +1746,7 @@ hg_core_context_destroy(struct hg_core_private_context *context)
         HG_LOG_ERROR("HG core handles must be freed before destroying context "
                      "(%d remaining)",
             n_handles);
+#ifdef HG_HAS_DEBUG
         hg_thread_spin_lock(&context->created_list_lock);
         HG_LIST_FOREACH (hg_core_handle, &context->created_list, created) {
             /* TODO ideally we'd want the upper layer to print that */
@@ -1265,6 +1757,7 @@ hg_core_context_destroy(struct hg_core_private_context *context)
                 "Core handle (%p) was not destroyed", (void *) hg_core_handle);
         }
         hg_thread_spin_unlock(&context->created_list_lock);
+#endif
 
         hg_thread_spin_lock(&context->pending_list_lock);
         HG_LIST_FOREACH (hg_core_handle, &context->pending_list, pending) {
@@ -1281,16 +1774,12 @@ hg_core_context_destroy(struct hg_core_private_context *context)
     }
 
     /* Check that atomic completion queue is empty now */
-    HG_CHECK_ERROR(!hg_atomic_queue_is_empty(context->completion_queue), done,
-        ret, HG_BUSY, "Completion queue should be empty");
-    hg_atomic_queue_free(context->completion_queue);
-
-    /* Check that backfill completion queue is empty now */
-    hg_thread_mutex_lock(&context->completion_queue_mutex);
-    empty = HG_QUEUE_IS_EMPTY(&context->backfill_queue);
-    hg_thread_mutex_unlock(&context->completion_queue_mutex);
-    HG_CHECK_ERROR(
-        !empty, done, ret, HG_BUSY, "Completion queue should be empty");
+    HG_CHECK_ERROR(!hg_core_completion_queue_is_empty(context), done, ret,
+        HG_BUSY, "Completion queue should be empty");
+    hg_core_completion_queue_free(
+        (struct hg_core_completion_queue *) hg_atomic_get64(
+            &context->completion_queue_head));
+    hg_atomic_set64(&context->completion_queue_head, 0);
 
     /* Destroy pool of bulk op IDs */
     if (context->hg_bulk_op_pool) {
@@ -1312,10 +1801,11 @@ hg_core_context_destroy(struct hg_core_private_context *context)
 
     if (context->poll_set) {
         /* If NA plugin exposes fd, remove it from poll set */
-        int na_poll_fd =
-            NA_Poll_get_fd(context->core_context.core_class->na_class,
-                context->core_context.na_context);
-        if (na_poll_fd > 0) {
+        for (i = 0; i < HG_CORE_CONTEXT_CLASS(context)->na_rail_count; i++) {
+            int na_poll_fd = hg_core_context_rail_fd(context, i);
+            if (na_poll_fd <= 0)
+                continue;
+
             rc = hg_poll_remove(context->poll_set, na_poll_fd);
             HG_CHECK_ERROR(rc != HG_UTIL_SUCCESS, done, ret, HG_NOENTRY,
                 "Could not remove NA poll descriptor from poll set");
@@ -1342,14 +1832,28 @@ hg_core_context_destroy(struct hg_core_private_context *context)
         HG_CHECK_ERROR(rc != HG_UTIL_SUCCESS, done, ret, HG_FAULT,
             "Could not destroy poll set");
     }
+    free(context->poll_events);
+    context->poll_events = NULL;
 
-    /* Destroy NA context */
-    if (context->core_context.na_context) {
-        na_return_t na_ret =
-            NA_Context_destroy(context->core_context.core_class->na_class,
-                context->core_context.na_context);
-        HG_CHECK_ERROR(na_ret != NA_SUCCESS, done, ret, (hg_return_t) na_ret,
-            "Could not destroy NA context (%s)", NA_Error_to_string(na_ret));
+    /* Destroy NA contexts */
+    if (context->na_rails) {
+        for (i = 0; i < HG_CORE_CONTEXT_CLASS(context)->na_rail_count; i++) {
+            na_return_t na_ret;
+
+            if (context->na_rails[i] == NULL)
+                continue;
+
+            na_ret =
+                NA_Context_destroy(context->core_context.core_class->na_class,
+                    context->na_rails[i]);
+            HG_CHECK_ERROR(na_ret != NA_SUCCESS, done, ret,
+                (hg_return_t) na_ret, "Could not destroy NA context (%s)",
+                NA_Error_to_string(na_ret));
+            context->na_rails[i] = NULL;
+        }
+        free(context->na_rails);
+        context->na_rails = NULL;
+        context->core_context.na_context = NULL;
     }
 
 #ifdef NA_HAS_SM
@@ -1368,11 +1872,16 @@ hg_core_context_destroy(struct hg_core_private_context *context)
         context->core_context.data_free_callback(context->core_context.data);
 
     /* Destroy completion queue mutex/cond */
-    hg_thread_mutex_destroy(&context->completion_queue_notify_mutex);
     hg_thread_mutex_destroy(&context->completion_queue_mutex);
     hg_thread_cond_destroy(&context->completion_queue_cond);
     hg_thread_spin_destroy(&context->pending_list_lock);
+#ifdef HG_HAS_DEBUG
     hg_thread_spin_destroy(&context->created_list_lock);
+#endif
+
+    /* Free cached handles */
+    if (context->handle_cache)
+        hg_thread_cache_destroy(context->handle_cache);
 
     /* Decrement context count of parent class */
     hg_atomic_decr32(&HG_CORE_CONTEXT_CLASS(context)->n_contexts);
@@ -1388,18 +1897,30 @@ static hg_return_t
 hg_core_context_post(struct hg_core_private_context *context,
     na_class_t *na_class, na_context_t *na_context, unsigned int request_count)
 {
+    struct hg_mem_pool *buf_pool =
+        HG_CORE_CONTEXT_CLASS(context)->request_buf_pool;
     hg_return_t ret = HG_SUCCESS;
     unsigned int nentry = 0;
 
+#ifdef NA_HAS_SM
+    if (na_class == context->core_context.core_class->na_sm_class)
+        buf_pool = HG_CORE_CONTEXT_CLASS(context)->request_sm_buf_pool;
+#endif
+
     /* Create a bunch of handles and post unexpected receives */
     for (nentry = 0; nentry < request_count; nentry++) {
         struct hg_core_private_handle *hg_core_handle = NULL;
         struct hg_core_private_addr *hg_core_addr = NULL;
 
         /* Create new handle */
-        ret = hg_core_create(context, na_class, na_context, &hg_core_handle);
+        ret = hg_core_create(
+            context, na_class, na_context, buf_pool, &hg_core_handle);
         HG_CHECK_HG_ERROR(error, ret, "Could not create HG core handle");
 
+        hg_thread_spin_lock(&context->pending_list_lock);
+        context->post_state.total_count++;
+        hg_thread_spin_unlock(&context->pending_list_lock);
+
         /* Reset status */
         hg_atomic_set32(&hg_core_handle->status, 0);
         hg_atomic_set32(&hg_core_handle->ret_status, (int32_t) HG_SUCCESS);
@@ -1477,6 +1998,7 @@ static hg_return_t
 hg_core_context_check_pending(struct hg_core_private_context *context,
     na_class_t *na_class, na_context_t *na_context, unsigned int request_count)
 {
+    struct hg_core_post_state *post_state = &context->post_state;
     hg_bool_t pending_empty = HG_FALSE;
     hg_return_t ret = HG_SUCCESS;
 
@@ -1488,6 +2010,12 @@ hg_core_context_check_pending(struct hg_core_private_context *context,
     else
 #endif
         pending_empty = HG_LIST_IS_EMPTY(&context->pending_list);
+    /* Do not wait for the list to be empty if requests are running out */
+    if (HG_CORE_CONTEXT_CLASS(context)->request_post_adaptive &&
+        post_state->posted_count < post_state->total_count / HG_CORE_POST_LOW)
+        pending_empty = HG_TRUE;
+    if (pending_empty)
+        post_state->grow_count += request_count;
     hg_thread_spin_unlock(&context->pending_list_lock);
 
     /* If pending list is empty, post more handles */
@@ -1503,22 +2031,189 @@ done:
 
 /*---------------------------------------------------------------------------*/
 static hg_return_t
-hg_core_context_lists_wait(struct hg_core_private_context *context)
+hg_core_context_post_adapt(struct hg_core_private_context *context)
 {
-    bool created_list_empty = false;
-    hg_time_t deadline, now;
-    hg_return_t ret = HG_SUCCESS, hg_ret;
+    struct hg_core_post_state *post_state = &context->post_state;
+    struct hg_core_private_handle *handles[HG_CORE_POST_RELEASE_COUNT];
+    unsigned int count, i;
+    hg_time_t now;
+    double elapsed;
+    hg_return_t ret = HG_SUCCESS;
 
+    /* Do not contend for the lock before the end of the period */
     hg_time_get_current_ms(&now);
-    deadline = hg_time_add(now, hg_time_from_ms(HG_CORE_CLEANUP_TIMEOUT));
-
-    /* Make first progress pass without waiting to empty trigger queues */
-    hg_ret = hg_core_progress(context, 0);
-    HG_CHECK_ERROR(hg_ret != HG_SUCCESS && hg_ret != HG_TIMEOUT, done, ret,
-        hg_ret, "Could not make progress");
+    if (HG_CORE_TIME_MS(now) < hg_atomic_get64(&post_state->period_end))
+        return ret;
 
-    for (;;) {
-        unsigned int actual_count = 0;
+    if (hg_thread_spin_try_lock(&context->pending_list_lock) !=
+        HG_UTIL_SUCCESS)
+        return ret; /* Another thread is using the lists */
+
+    /* Another thread may have just started a new period */
+    elapsed =
+        hg_time_to_double(hg_time_subtract(now, post_state->period_start));
+    if (elapsed * 1000.0 < (double) HG_CORE_POST_PERIOD) {
+        hg_thread_spin_unlock(&context->pending_list_lock);
+        return ret;
+    }
+
+    /* Keep twice the peak of requests that were in use during last period */
+    post_state->recv_rate = (double) post_state->period_recv_count / elapsed;
+    post_state->target_count =
+        MAX(post_state->floor_count, 2 * post_state->peak_count);
+    post_state->peak_count = post_state->total_count - post_state->posted_count;
+    post_state->period_recv_count = 0;
+    post_state->period_start = now;
+    hg_atomic_set64(&post_state->period_end,
+        HG_CORE_TIME_MS(now) + HG_CORE_POST_PERIOD);
+
+    if (post_state->total_count > post_state->target_count &&
+        !context->finalizing)
+        HG_LOG_DEBUG("Releasing %" PRIu32 " posted requests on context (%p)",
+            post_state->total_count - post_state->target_count,
+            (void *) context);
+
+    /* Cancel idle requests by batches, without holding the lock */
+    do {
+        count = context->finalizing
+                    ? 0
+                    : hg_core_context_post_release(
+                          context, handles, HG_CORE_POST_RELEASE_COUNT);
+        hg_thread_spin_unlock(&context->pending_list_lock);
+
+        for (i = 0; i < count; i++) {
+            if (ret == HG_SUCCESS) {
+                ret = hg_core_cancel(handles[i]);
+                HG_CHECK_ERROR_DONE(
+                    ret != HG_SUCCESS, "Could not cancel handle");
+            }
+
+            /* Release reference taken when handle was selected */
+            (void) hg_core_destroy(handles[i]);
+        }
+        if (ret != HG_SUCCESS || count < HG_CORE_POST_RELEASE_COUNT)
+            break;
+
+        hg_thread_spin_lock(&context->pending_list_lock);
+    } while (1);
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static unsigned int
+hg_core_context_post_release(struct hg_core_private_context *context,
+    struct hg_core_private_handle **handles, unsigned int max)
+{
+    struct hg_core_post_state *post_state = &context->post_state;
+    hg_uint32_t kept[UINT8_MAX + 1] = {0};
+    struct hg_core_private_handle *hg_core_handle;
+    hg_uint32_t request_post_init =
+        HG_CORE_CONTEXT_CLASS(context)->request_post_init;
+    unsigned int count = 0;
+
+    HG_LIST_FOREACH (hg_core_handle, &context->pending_list, pending) {
+        unsigned int rail;
+
+        if (count == max || post_state->total_count <= post_state->target_count)
+            return count;
+        if (!hg_core_handle->repost)
+            continue; /* Already released */
+        for (rail = 0; context->na_rails[rail] != hg_core_handle->na_context;
+             rail++)
+            continue;
+        if (kept[rail] < request_post_init) {
+            kept[rail]++;
+            continue;
+        }
+
+        /* Handle must remain valid until it is canceled */
+        hg_core_handle->repost = HG_FALSE;
+        hg_atomic_incr32(&hg_core_handle->ref_count);
+        post_state->total_count--;
+        post_state->shrink_count++;
+        handles[count++] = hg_core_handle;
+    }
+
+#ifdef NA_HAS_SM
+    /* SM requests are counted in last slot, which no rail uses */
+    HG_LIST_FOREACH (hg_core_handle, &context->sm_pending_list, pending) {
+        if (count == max || post_state->total_count <= post_state->target_count)
+            return count;
+        if (!hg_core_handle->repost)
+            continue; /* Already released */
+        if (kept[UINT8_MAX] < request_post_init) {
+            kept[UINT8_MAX]++;
+            continue;
+        }
+
+        hg_core_handle->repost = HG_FALSE;
+        hg_atomic_incr32(&hg_core_handle->ref_count);
+        post_state->total_count--;
+        post_state->shrink_count++;
+        handles[count++] = hg_core_handle;
+    }
+#endif
+
+    return count;
+}
+
+/*---------------------------------------------------------------------------*/
+static int
+hg_core_context_rail_fd(
+    struct hg_core_private_context *context, unsigned int rail)
+{
+    na_class_t *na_class = context->core_context.core_class->na_class;
+    int na_poll_fd = NA_Poll_get_fd(na_class, context->na_rails[rail]);
+    unsigned int i;
+
+    for (i = 0; i < rail; i++)
+        if (NA_Poll_get_fd(na_class, context->na_rails[i]) == na_poll_fd)
+            return -1;
+
+    return na_poll_fd;
+}
+
+/*---------------------------------------------------------------------------*/
+static HG_INLINE unsigned int
+hg_core_context_rail(
+    struct hg_core_private_context *context, const void *addr, hg_size_t size)
+{
+    unsigned int rail_count = HG_CORE_CONTEXT_CLASS(context)->na_rail_count;
+    uint64_t hash;
+
+    if (rail_count == 1)
+        return 0;
+
+    /* Stripe large transfers */
+    if (size >= HG_CORE_RAIL_STRIPE_SIZE)
+        return (unsigned int) hg_atomic_incr32(&context->na_rail_next) %
+               rail_count;
+
+    /* Keep messages to the same address on the same rail */
+    hash = (uint64_t) (uintptr_t) addr * UINT64_C(0x9E3779B97F4A7C15);
+
+    return (unsigned int) ((hash >> 32) % rail_count);
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_core_context_lists_wait(struct hg_core_private_context *context)
+{
+    bool handles_freed = false;
+    hg_time_t deadline, now;
+    hg_return_t ret = HG_SUCCESS, hg_ret;
+
+    hg_time_get_current_ms(&now);
+    deadline = hg_time_add(now, hg_time_from_ms(HG_CORE_CLEANUP_TIMEOUT));
+
+    /* Make first progress pass without waiting to empty trigger queues */
+    hg_ret = hg_core_progress(context, 0);
+    HG_CHECK_ERROR(hg_ret != HG_SUCCESS && hg_ret != HG_TIMEOUT, done, ret,
+        hg_ret, "Could not make progress");
+
+    for (;;) {
+        unsigned int actual_count = 0;
 
         /* Trigger everything we can from HG */
         do {
@@ -1527,12 +2222,10 @@ hg_core_context_lists_wait(struct hg_core_private_context *context)
         HG_CHECK_ERROR(hg_ret != HG_SUCCESS && hg_ret != HG_TIMEOUT, done, ret,
             hg_ret, "Could not trigger entry");
 
-        /* When created list is empty, pending list and list of handles in use
+        /* When all handles are freed, pending list and list of handles in use
          * should be empty */
-        hg_thread_spin_lock(&context->created_list_lock);
-        created_list_empty = HG_LIST_IS_EMPTY(&context->created_list);
-        hg_thread_spin_unlock(&context->created_list_lock);
-        if (created_list_empty)
+        handles_freed = (hg_atomic_get32(&context->n_handles) == 0);
+        if (handles_freed)
             break;
 
         /* Gives a chance to always call trigger after progress */
@@ -1546,7 +2239,7 @@ hg_core_context_lists_wait(struct hg_core_private_context *context)
             hg_ret, "Could not make progress");
     }
 
-    HG_LOG_DEBUG("Created list empty: %d (timeout=%u ms)", created_list_empty,
+    HG_LOG_DEBUG("Handles freed: %d (timeout=%u ms)", handles_freed,
         hg_time_to_ms(hg_time_subtract(deadline, now)));
 
 done:
@@ -1560,6 +2253,21 @@ hg_core_context_get_bulk_op_pool(struct hg_core_context *core_context)
     return ((struct hg_core_private_context *) core_context)->hg_bulk_op_pool;
 }
 
+/*---------------------------------------------------------------------------*/
+na_context_t *
+hg_core_context_get_na_rail(struct hg_core_context *core_context,
+    hg_core_addr_t addr, hg_size_t size, hg_uint8_t *id_ptr)
+{
+    struct hg_core_private_context *context =
+        (struct hg_core_private_context *) core_context;
+    unsigned int rail = hg_core_context_rail(context, addr, size);
+
+    /* Peers use the same number of rails */
+    *id_ptr = HG_CORE_RAIL_ID(HG_CORE_CONTEXT_CLASS(context), *id_ptr, rail);
+
+    return context->na_rails[rail];
+}
+
 /*---------------------------------------------------------------------------*/
 static hg_return_t
 hg_core_addr_lookup(struct hg_core_private_class *hg_core_class,
@@ -2151,7 +2859,7 @@ error:
 /*---------------------------------------------------------------------------*/
 static hg_return_t
 hg_core_create(struct hg_core_private_context *context, na_class_t *na_class,
-    na_context_t *na_context,
+    na_context_t *na_context, struct hg_mem_pool *buf_pool,
     struct hg_core_private_handle **hg_core_handle_ptr)
 {
     struct hg_core_private_handle *hg_core_handle = NULL;
@@ -2163,7 +2871,7 @@ hg_core_create(struct hg_core_private_context *context, na_class_t *na_class,
         "Could not allocate handle");
 
     /* Alloc/init NA resources */
-    ret = hg_core_alloc_na(hg_core_handle, na_class, na_context);
+    ret = hg_core_alloc_na(hg_core_handle, na_class, na_context, buf_pool);
     HG_CHECK_HG_ERROR(error, ret, "Could not allocate NA handle ops");
 
     /* Execute class callback on handle, this allows upper layers to
@@ -2234,6 +2942,26 @@ done:
     return ret;
 }
 
+/*---------------------------------------------------------------------------*/
+static void *
+hg_core_handle_mem_alloc(void *arg)
+{
+    (void) arg;
+
+    /* Handles must not share cache lines */
+    return hg_mem_aligned_alloc(
+        HG_MEM_CACHE_LINE_SIZE, sizeof(struct hg_core_private_handle));
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+hg_core_handle_mem_free(void *obj, void *arg)
+{
+    (void) arg;
+
+    hg_mem_aligned_free(obj);
+}
+
 /*---------------------------------------------------------------------------*/
 static struct hg_core_private_handle *
 hg_core_alloc(struct hg_core_private_context *context)
@@ -2244,8 +2972,8 @@ hg_core_alloc(struct hg_core_private_context *context)
             ? HG_TRUE
             : HG_FALSE;
 
-    hg_core_handle = (struct hg_core_private_handle *) malloc(
-        sizeof(struct hg_core_private_handle));
+    hg_core_handle = (struct hg_core_private_handle *) hg_thread_cache_get(
+        context->handle_cache);
     HG_CHECK_ERROR_NORET(
         hg_core_handle == NULL, done, "Could not allocate handle");
 
@@ -2262,6 +2990,7 @@ hg_core_alloc(struct hg_core_private_context *context)
     /* Default return code */
     hg_core_handle->ret = HG_SUCCESS;
 
+#ifdef HG_HAS_DEBUG
     /* Add handle to handle list so that we can track it */
     hg_thread_spin_lock(
         &HG_CORE_HANDLE_CONTEXT(hg_core_handle)->created_list_lock);
@@ -2269,11 +2998,13 @@ hg_core_alloc(struct hg_core_private_context *context)
         hg_core_handle, created);
     hg_thread_spin_unlock(
         &HG_CORE_HANDLE_CONTEXT(hg_core_handle)->created_list_lock);
+#endif
 
     /* Completed by default */
     hg_atomic_init32(&hg_core_handle->status, HG_CORE_OP_COMPLETED);
     hg_atomic_init32(
         &hg_core_handle->ret_status, (int32_t) hg_core_handle->ret);
+    hg_atomic_init32(&hg_core_handle->ack_published, 0);
 
     /* Init in/out header */
     hg_core_header_request_init(&hg_core_handle->in_header, use_checksum);
@@ -2300,12 +3031,14 @@ hg_core_free(struct hg_core_private_handle *hg_core_handle)
         (struct hg_core_private_addr *) hg_core_handle->core_handle.info.addr);
     HG_CHECK_HG_ERROR(done, ret, "Could not free address");
 
+#ifdef HG_HAS_DEBUG
     /* Remove handle from list */
     hg_thread_spin_lock(
         &HG_CORE_HANDLE_CONTEXT(hg_core_handle)->created_list_lock);
     HG_LIST_REMOVE(hg_core_handle, created);
     hg_thread_spin_unlock(
         &HG_CORE_HANDLE_CONTEXT(hg_core_handle)->created_list_lock);
+#endif
 
     /* Decrement N handles from HG context */
     hg_atomic_decr32(&HG_CORE_HANDLE_CONTEXT(hg_core_handle)->n_handles);
@@ -2313,7 +3046,9 @@ hg_core_free(struct hg_core_private_handle *hg_core_handle)
     hg_core_header_request_finalize(&hg_core_handle->in_header);
     hg_core_header_response_finalize(&hg_core_handle->out_header);
 
-    free(hg_core_handle);
+    /* Return handle memory to the cache of the calling thread */
+    hg_thread_cache_put(
+        HG_CORE_HANDLE_CONTEXT(hg_core_handle)->handle_cache, hg_core_handle);
 
 done:
     return ret;
@@ -2322,7 +3057,8 @@ done:
 /*---------------------------------------------------------------------------*/
 static hg_return_t
 hg_core_alloc_na(struct hg_core_private_handle *hg_core_handle,
-    na_class_t *na_class, na_context_t *na_context)
+    na_class_t *na_class, na_context_t *na_context,
+    struct hg_mem_pool *buf_pool)
 {
     hg_return_t ret = HG_SUCCESS;
     na_return_t na_ret;
@@ -2330,6 +3066,7 @@ hg_core_alloc_na(struct hg_core_private_handle *hg_core_handle,
     /* Set NA class / context */
     hg_core_handle->na_class = na_class;
     hg_core_handle->na_context = na_context;
+    hg_core_handle->buf_pool = buf_pool;
 
     /* Initialize in/out buffers and use unexpected message size */
     hg_core_handle->core_handle.in_buf_size =
@@ -2341,9 +3078,13 @@ hg_core_alloc_na(struct hg_core_private_handle *hg_core_handle,
     hg_core_handle->core_handle.na_out_header_offset =
         NA_Msg_get_expected_header_size(na_class);
 
-    hg_core_handle->core_handle.in_buf =
-        NA_Msg_buf_alloc(na_class, hg_core_handle->core_handle.in_buf_size,
-            &hg_core_handle->in_buf_plugin_data);
+    if (buf_pool)
+        hg_core_handle->core_handle.in_buf = hg_mem_pool_alloc(
+            buf_pool, hg_core_handle->core_handle.in_buf_size, NULL);
+    else
+        hg_core_handle->core_handle.in_buf =
+            NA_Msg_buf_alloc(na_class, hg_core_handle->core_handle.in_buf_size,
+                &hg_core_handle->in_buf_plugin_data);
     HG_CHECK_ERROR(hg_core_handle->core_handle.in_buf == NULL, error, ret,
         HG_NOMEM, "Could not allocate buffer for input");
 
@@ -2353,16 +3094,21 @@ hg_core_alloc_na(struct hg_core_private_handle *hg_core_handle,
     HG_CHECK_ERROR(na_ret != NA_SUCCESS, error, ret, (hg_return_t) na_ret,
         "Could not initialize input buffer (%s)", NA_Error_to_string(na_ret));
 
-    hg_core_handle->core_handle.out_buf =
-        NA_Msg_buf_alloc(na_class, hg_core_handle->core_handle.out_buf_size,
-            &hg_core_handle->out_buf_plugin_data);
-    HG_CHECK_ERROR(hg_core_handle->core_handle.out_buf == NULL, error, ret,
-        HG_NOMEM, "Could not allocate buffer for output");
+    /* Shared output buffers are only attached once requests are received */
+    if (!buf_pool) {
+        hg_core_handle->core_handle.out_buf =
+            NA_Msg_buf_alloc(na_class, hg_core_handle->core_handle.out_buf_size,
+                &hg_core_handle->out_buf_plugin_data);
+        HG_CHECK_ERROR(hg_core_handle->core_handle.out_buf == NULL, error, ret,
+            HG_NOMEM, "Could not allocate buffer for output");
 
-    na_ret = NA_Msg_init_expected(na_class, hg_core_handle->core_handle.out_buf,
-        hg_core_handle->core_handle.out_buf_size);
-    HG_CHECK_ERROR(na_ret != NA_SUCCESS, error, ret, (hg_return_t) na_ret,
-        "Could not initialize output buffer (%s)", NA_Error_to_string(na_ret));
+        na_ret =
+            NA_Msg_init_expected(na_class, hg_core_handle->core_handle.out_buf,
+                hg_core_handle->core_handle.out_buf_size);
+        HG_CHECK_ERROR(na_ret != NA_SUCCESS, error, ret, (hg_return_t) na_ret,
+            "Could not initialize output buffer (%s)",
+            NA_Error_to_string(na_ret));
+    }
 
     /* Create NA operation IDs */
     hg_core_handle->na_send_op_id = NA_Op_create(na_class);
@@ -2371,9 +3117,6 @@ hg_core_alloc_na(struct hg_core_private_handle *hg_core_handle,
     hg_core_handle->na_recv_op_id = NA_Op_create(na_class);
     HG_CHECK_ERROR(hg_core_handle->na_recv_op_id == NULL, error, ret,
         HG_NA_ERROR, "Could not create NA op ID");
-    hg_core_handle->na_ack_op_id = NA_Op_create(na_class);
-    HG_CHECK_ERROR(hg_core_handle->na_ack_op_id == NULL, error, ret,
-        HG_NA_ERROR, "Could not create NA op ID");
 
     hg_core_handle->na_op_count = 1; /* Default (no response) */
     hg_atomic_init32(&hg_core_handle->na_op_completed_count, 0);
@@ -2405,36 +3148,40 @@ hg_core_free_na(struct hg_core_private_handle *hg_core_handle)
         "Could not destroy recv op ID (%s)", NA_Error_to_string(na_ret));
     hg_core_handle->na_recv_op_id = NULL;
 
-    na_ret =
-        NA_Op_destroy(hg_core_handle->na_class, hg_core_handle->na_ack_op_id);
-    HG_CHECK_ERROR(na_ret != NA_SUCCESS, done, ret, (hg_return_t) na_ret,
-        "Could not destroy ack op ID (%s)", NA_Error_to_string(na_ret));
-    hg_core_handle->na_ack_op_id = NULL;
+    if (hg_core_handle->ack) {
+        hg_atomic_set32(&hg_core_handle->ack_published, 0);
+        hg_core_ack_buf_free(hg_core_handle);
+        na_ret = NA_Op_destroy(
+            hg_core_handle->na_class, hg_core_handle->ack->op_id);
+        HG_CHECK_ERROR(na_ret != NA_SUCCESS, done, ret, (hg_return_t) na_ret,
+            "Could not destroy ack op ID (%s)", NA_Error_to_string(na_ret));
+        free(hg_core_handle->ack);
+        hg_core_handle->ack = NULL;
+    }
 
     /* Free buffers */
-    na_ret = NA_Msg_buf_free(hg_core_handle->na_class,
-        hg_core_handle->core_handle.in_buf, hg_core_handle->in_buf_plugin_data);
-    HG_CHECK_ERROR(na_ret != NA_SUCCESS, done, ret, (hg_return_t) na_ret,
-        "Could not free input buffer (%s)", NA_Error_to_string(na_ret));
-    hg_core_handle->core_handle.in_buf = NULL;
-    hg_core_handle->in_buf_plugin_data = NULL;
-
-    na_ret = NA_Msg_buf_free(hg_core_handle->na_class,
-        hg_core_handle->core_handle.out_buf,
-        hg_core_handle->out_buf_plugin_data);
-    HG_CHECK_ERROR(na_ret != NA_SUCCESS, done, ret, (hg_return_t) na_ret,
-        "Could not free output buffer (%s)", NA_Error_to_string(na_ret));
-    hg_core_handle->core_handle.out_buf = NULL;
-    hg_core_handle->out_buf_plugin_data = NULL;
+    if (hg_core_handle->buf_pool) {
+        hg_mem_pool_free(hg_core_handle->buf_pool,
+            hg_core_handle->core_handle.in_buf, NULL);
+        hg_core_out_buf_detach(hg_core_handle);
+        hg_core_handle->buf_pool = NULL;
+    } else {
+        na_ret = NA_Msg_buf_free(hg_core_handle->na_class,
+            hg_core_handle->core_handle.in_buf,
+            hg_core_handle->in_buf_plugin_data);
+        HG_CHECK_ERROR(na_ret != NA_SUCCESS, done, ret, (hg_return_t) na_ret,
+            "Could not free input buffer (%s)", NA_Error_to_string(na_ret));
 
-    if (hg_core_handle->ack_buf) {
         na_ret = NA_Msg_buf_free(hg_core_handle->na_class,
-            hg_core_handle->ack_buf, hg_core_handle->ack_buf_plugin_data);
+            hg_core_handle->core_handle.out_buf,
+            hg_core_handle->out_buf_plugin_data);
         HG_CHECK_ERROR(na_ret != NA_SUCCESS, done, ret, (hg_return_t) na_ret,
-            "Could not free ack buffer (%s)", NA_Error_to_string(na_ret));
-        hg_core_handle->ack_buf = NULL;
-        hg_core_handle->ack_buf_plugin_data = NULL;
+            "Could not free output buffer (%s)", NA_Error_to_string(na_ret));
     }
+    hg_core_handle->core_handle.in_buf = NULL;
+    hg_core_handle->in_buf_plugin_data = NULL;
+    hg_core_handle->core_handle.out_buf = NULL;
+    hg_core_handle->out_buf_plugin_data = NULL;
 
     hg_core_handle->na_class = NULL;
     hg_core_handle->na_context = NULL;
@@ -2443,6 +3190,124 @@ done:
     return ret;
 }
 
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_core_ack_alloc(
+    struct hg_core_private_handle *hg_core_handle, size_t buf_size)
+{
+    struct hg_core_ack *ack = hg_core_handle->ack;
+    hg_return_t ret = HG_SUCCESS;
+    na_return_t na_ret;
+
+    /* Most RPCs never need an ack, only allocate resources when they do */
+    if (ack == NULL) {
+        ack = (struct hg_core_ack *) calloc(1, sizeof(struct hg_core_ack));
+        HG_CHECK_ERROR(
+            ack == NULL, done, ret, HG_NOMEM, "Could not allocate ack");
+        ack->op_id = NA_Op_create(hg_core_handle->na_class);
+        if (ack->op_id == NULL) {
+            free(ack);
+            HG_GOTO_ERROR(done, ret, HG_NA_ERROR, "Could not create NA op ID");
+        }
+        hg_core_handle->ack = ack;
+
+        /* Ack may be canceled from another thread once published */
+        hg_atomic_set32(&hg_core_handle->ack_published, 1);
+    }
+
+    ack->buf = NA_Msg_buf_alloc(
+        hg_core_handle->na_class, buf_size, &ack->plugin_data);
+    HG_CHECK_ERROR(ack->buf == NULL, done, ret, HG_NA_ERROR,
+        "Could not allocate buffer for ack");
+
+    na_ret = NA_Msg_init_expected(hg_core_handle->na_class, ack->buf, buf_size);
+    HG_CHECK_ERROR(na_ret != NA_SUCCESS, done, ret, (hg_return_t) na_ret,
+        "Could not initialize ack buffer (%s)", NA_Error_to_string(na_ret));
+
+done:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+hg_core_ack_buf_free(struct hg_core_private_handle *hg_core_handle)
+{
+    struct hg_core_ack *ack = hg_core_handle->ack;
+    na_return_t na_ret;
+
+    if (ack == NULL || ack->buf == NULL)
+        return;
+
+    na_ret =
+        NA_Msg_buf_free(hg_core_handle->na_class, ack->buf, ack->plugin_data);
+    HG_CHECK_ERROR_DONE(na_ret != NA_SUCCESS, "Could not free ack buffer (%s)",
+        NA_Error_to_string(na_ret));
+    ack->buf = NULL;
+    ack->plugin_data = NULL;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_core_request_buf_pool_create(
+    na_class_t *na_class, struct hg_mem_pool **pool_ptr)
+{
+    size_t in_buf_size = NA_Msg_get_max_unexpected_size(na_class),
+           out_buf_size = NA_Msg_get_max_expected_size(na_class);
+    hg_return_t ret = HG_SUCCESS;
+
+    /* Buffers registered by the NA plugin cannot be carved out of a pool */
+    if (na_class->ops->msg_buf_alloc) {
+        HG_LOG_WARNING("NA class %s requires registered message buffers, "
+                       "request buffers will not be shared",
+            NA_Get_class_name(na_class));
+        *pool_ptr = NULL;
+        goto done;
+    }
+
+    *pool_ptr = hg_mem_pool_create(MAX(in_buf_size, out_buf_size),
+        HG_CORE_REQUEST_BUF_COUNT, 0, NULL, NULL, NULL);
+    HG_CHECK_ERROR(*pool_ptr == NULL, done, ret, HG_NOMEM,
+        "Could not create request buffer pool");
+
+done:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_core_out_buf_attach(struct hg_core_private_handle *hg_core_handle)
+{
+    hg_return_t ret = HG_SUCCESS;
+    na_return_t na_ret;
+
+    if (hg_core_handle->core_handle.out_buf)
+        goto done;
+
+    hg_core_handle->core_handle.out_buf =
+        hg_mem_pool_alloc(hg_core_handle->buf_pool,
+            hg_core_handle->core_handle.out_buf_size, NULL);
+    HG_CHECK_ERROR(hg_core_handle->core_handle.out_buf == NULL, done, ret,
+        HG_NOMEM, "Could not allocate buffer for output");
+
+    na_ret = NA_Msg_init_expected(hg_core_handle->na_class,
+        hg_core_handle->core_handle.out_buf,
+        hg_core_handle->core_handle.out_buf_size);
+    HG_CHECK_ERROR(na_ret != NA_SUCCESS, done, ret, (hg_return_t) na_ret,
+        "Could not initialize output buffer (%s)", NA_Error_to_string(na_ret));
+
+done:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+hg_core_out_buf_detach(struct hg_core_private_handle *hg_core_handle)
+{
+    hg_mem_pool_free(
+        hg_core_handle->buf_pool, hg_core_handle->core_handle.out_buf, NULL);
+    hg_core_handle->core_handle.out_buf = NULL;
+}
+
 /*---------------------------------------------------------------------------*/
 static void
 hg_core_reset(struct hg_core_private_handle *hg_core_handle)
@@ -2470,20 +3335,10 @@ hg_core_reset(struct hg_core_private_handle *hg_core_handle)
         HG_CORE_HANDLE_CLASS(hg_core_handle)
             ->more_data_release((hg_core_handle_t) hg_core_handle);
 
-    if (hg_core_handle->ack_buf) {
-        na_return_t na_ret = NA_Msg_buf_free(hg_core_handle->na_class,
-            hg_core_handle->ack_buf, hg_core_handle->ack_buf_plugin_data);
-        HG_CHECK_ERROR_NORET(na_ret != NA_SUCCESS, done,
-            "Could not free ack buffer (%s)", NA_Error_to_string(na_ret));
-        hg_core_handle->ack_buf = NULL;
-        hg_core_handle->ack_buf_plugin_data = NULL;
-    }
+    hg_core_ack_buf_free(hg_core_handle);
 
     hg_core_header_request_reset(&hg_core_handle->in_header);
     hg_core_header_response_reset(&hg_core_handle->out_header);
-
-done:
-    return;
 }
 
 /*---------------------------------------------------------------------------*/
@@ -2511,6 +3366,10 @@ hg_core_reset_post(struct hg_core_private_handle *hg_core_handle)
     hg_atomic_set32(&hg_core_handle->status, 0);
     hg_atomic_set32(&hg_core_handle->ret_status, (int32_t) hg_core_handle->ret);
 
+    /* Output buffer is not needed until next request is received */
+    if (hg_core_handle->buf_pool)
+        hg_core_out_buf_detach(hg_core_handle);
+
     /* Safe to repost */
     ret = hg_core_post(hg_core_handle);
     HG_CHECK_HG_ERROR(done, ret, "Cannot post handle");
@@ -2546,9 +3405,6 @@ hg_core_set_rpc(struct hg_core_private_handle *hg_core_handle,
         hg_core_handle->is_self =
             HG_CORE_HANDLE_CLASS(hg_core_handle)->loopback &&
             hg_core_addr->core_addr.is_self;
-
-        hg_core_handle->forward =
-            hg_core_handle->is_self ? hg_core_forward_self : hg_core_forward_na;
     }
 
     /* We also allow for NULL RPC id to be passed (same reason as above) */
@@ -2556,13 +3412,9 @@ hg_core_set_rpc(struct hg_core_private_handle *hg_core_handle,
         struct hg_core_rpc_info *hg_core_rpc_info;
 
         /* Retrieve ID function from function map */
-        hg_thread_spin_lock(
-            &HG_CORE_HANDLE_CLASS(hg_core_handle)->func_map_lock);
-        hg_core_rpc_info = (struct hg_core_rpc_info *) hg_hash_table_lookup(
-            HG_CORE_HANDLE_CLASS(hg_core_handle)->func_map,
-            (hg_hash_table_key_t) &id);
-        hg_thread_spin_unlock(
-            &HG_CORE_HANDLE_CLASS(hg_core_handle)->func_map_lock);
+        hg_core_rpc_info =
+            hg_core_func_map_lookup(HG_CORE_HANDLE_CLASS(hg_core_handle),
+                HG_CORE_HANDLE_CONTEXT(hg_core_handle), id);
         if (!hg_core_rpc_info)
             HG_GOTO_DONE(done, ret, HG_NOENTRY);
 
@@ -2591,6 +3443,7 @@ hg_core_post(struct hg_core_private_handle *hg_core_handle)
         HG_LIST_INSERT_HEAD(
             &HG_CORE_HANDLE_CONTEXT(hg_core_handle)->sm_pending_list,
             hg_core_handle, pending);
+        HG_CORE_HANDLE_CONTEXT(hg_core_handle)->post_state.posted_count++;
         hg_thread_spin_unlock(
             &HG_CORE_HANDLE_CONTEXT(hg_core_handle)->pending_list_lock);
     } else {
@@ -2600,6 +3453,7 @@ hg_core_post(struct hg_core_private_handle *hg_core_handle)
         HG_LIST_INSERT_HEAD(
             &HG_CORE_HANDLE_CONTEXT(hg_core_handle)->pending_list,
             hg_core_handle, pending);
+        HG_CORE_HANDLE_CONTEXT(hg_core_handle)->post_state.posted_count++;
         hg_thread_spin_unlock(
             &HG_CORE_HANDLE_CONTEXT(hg_core_handle)->pending_list_lock);
 #ifdef NA_HAS_SM
@@ -2624,6 +3478,7 @@ error:
     hg_thread_spin_lock(
         &HG_CORE_HANDLE_CONTEXT(hg_core_handle)->pending_list_lock);
     HG_LIST_REMOVE(hg_core_handle, pending);
+    HG_CORE_HANDLE_CONTEXT(hg_core_handle)->post_state.posted_count--;
     hg_thread_spin_unlock(
         &HG_CORE_HANDLE_CONTEXT(hg_core_handle)->pending_list_lock);
 
@@ -2686,9 +3541,17 @@ hg_core_forward(struct hg_core_private_handle *hg_core_handle,
     hg_core_handle->in_header.msg.request.flags = flags;
     /* Set the cookie as origin context ID, so that when the cookie is unpacked
      * by the target and assigned to HG info context_id, the NA layer knows
-     * which context ID it needs to send the response to. */
-    hg_core_handle->in_header.msg.request.cookie =
-        hg_core_handle->core_handle.info.context->id;
+     * which context ID it needs to send the response to. When using rails of
+     * the default NA class, this is the NA context ID of the rail. */
+    if (hg_core_handle->na_class ==
+        hg_core_handle->core_handle.info.core_class->na_class)
+        hg_core_handle->in_header.msg.request.cookie =
+            HG_CORE_RAIL_ID(HG_CORE_HANDLE_CLASS(hg_core_handle),
+                hg_core_handle->core_handle.info.context->id,
+                hg_core_handle->rail);
+    else
+        hg_core_handle->in_header.msg.request.cookie =
+            hg_core_handle->core_handle.info.context->id;
 
     /* Encode request header */
     ret = hg_core_proc_header_request(
@@ -2697,7 +3560,8 @@ hg_core_forward(struct hg_core_private_handle *hg_core_handle,
 
     /* If addr is self, forward locally, otherwise send the encoded buffer
      * through NA and pre-post response */
-    ret = hg_core_handle->forward(hg_core_handle);
+    ret = hg_core_handle->is_self ? hg_core_forward_self(hg_core_handle)
+                                  : hg_core_forward_na(hg_core_handle);
     HG_CHECK_HG_ERROR(error, ret, "Could not forward buffer");
 
 #ifdef HG_HAS_DEBUG
@@ -2744,6 +3608,17 @@ hg_core_forward_na(struct hg_core_private_handle *hg_core_handle)
     hg_core_handle->tag =
         hg_core_gen_request_tag(HG_CORE_HANDLE_CLASS(hg_core_handle));
 
+    /* Target receives on the same rail as origin */
+    if (hg_core_handle->na_class ==
+        hg_core_handle->core_handle.info.core_class->na_class)
+        hg_core_handle->na_target_id =
+            HG_CORE_RAIL_ID(HG_CORE_HANDLE_CLASS(hg_core_handle),
+                hg_core_handle->core_handle.info.context_id,
+                hg_core_handle->rail);
+    else
+        hg_core_handle->na_target_id =
+            hg_core_handle->core_handle.info.context_id;
+
     /* Pre-post recv (output) if response is expected */
     if (!hg_core_handle->no_response) {
         na_ret = NA_Msg_recv_expected(hg_core_handle->na_class,
@@ -2751,7 +3626,7 @@ hg_core_forward_na(struct hg_core_private_handle *hg_core_handle)
             hg_core_handle->core_handle.out_buf,
             hg_core_handle->core_handle.out_buf_size,
             hg_core_handle->out_buf_plugin_data, hg_core_handle->na_addr,
-            hg_core_handle->core_handle.info.context_id, hg_core_handle->tag,
+            hg_core_handle->na_target_id, hg_core_handle->tag,
             hg_core_handle->na_recv_op_id);
         HG_CHECK_ERROR(na_ret != NA_SUCCESS, done, ret, (hg_return_t) na_ret,
             "Could not post recv for output buffer (%s)",
@@ -2769,7 +3644,7 @@ hg_core_forward_na(struct hg_core_private_handle *hg_core_handle)
         hg_core_handle->na_context, hg_core_send_input_cb, hg_core_handle,
         hg_core_handle->core_handle.in_buf, hg_core_handle->in_buf_used,
         hg_core_handle->in_buf_plugin_data, hg_core_handle->na_addr,
-        hg_core_handle->core_handle.info.context_id, hg_core_handle->tag,
+        hg_core_handle->na_target_id, hg_core_handle->tag,
         hg_core_handle->na_send_op_id);
     HG_CHECK_ERROR(na_ret != NA_SUCCESS, error, ret, (hg_return_t) na_ret,
         "Could not post send for input buffer (%s)",
@@ -2852,7 +3727,8 @@ hg_core_respond(struct hg_core_private_handle *hg_core_handle,
 
     /* If addr is self, forward locally, otherwise send the encoded buffer
      * through NA and pre-post response */
-    ret = hg_core_handle->respond(hg_core_handle);
+    ret = hg_core_handle->is_self ? hg_core_respond_self(hg_core_handle)
+                                  : hg_core_respond_na(hg_core_handle);
     HG_CHECK_HG_ERROR(error, ret, "Could not respond");
 
 #ifdef HG_HAS_DEBUG
@@ -2918,15 +3794,8 @@ hg_core_respond_na(struct hg_core_private_handle *hg_core_handle)
     if (hg_core_handle->out_header.msg.response.flags & HG_CORE_MORE_DATA) {
         size_t buf_size = hg_core_handle->core_handle.na_out_header_offset +
                           sizeof(hg_uint8_t);
-        hg_core_handle->ack_buf = NA_Msg_buf_alloc(hg_core_handle->na_class,
-            buf_size, &hg_core_handle->ack_buf_plugin_data);
-        HG_CHECK_ERROR(hg_core_handle->ack_buf == NULL, error, ret, HG_NA_ERROR,
-            "Could not allocate buffer for ack");
-
-        na_ret = NA_Msg_init_expected(
-            hg_core_handle->na_class, hg_core_handle->ack_buf, buf_size);
-        HG_CHECK_ERROR(na_ret != NA_SUCCESS, error, ret, (hg_return_t) na_ret,
-            "Could not initialize ack buffer (%s)", NA_Error_to_string(na_ret));
+        ret = hg_core_ack_alloc(hg_core_handle, buf_size);
+        HG_CHECK_HG_ERROR(error, ret, "Could not allocate ack");
 
         /* Increment number of expected NA operations */
         hg_core_handle->na_op_count++;
@@ -2934,10 +3803,10 @@ hg_core_respond_na(struct hg_core_private_handle *hg_core_handle)
         /* Pre-post recv (ack) if more data is expected */
         na_ret = NA_Msg_recv_expected(hg_core_handle->na_class,
             hg_core_handle->na_context, hg_core_ack_cb, hg_core_handle,
-            hg_core_handle->ack_buf, buf_size,
-            hg_core_handle->ack_buf_plugin_data, hg_core_handle->na_addr,
+            hg_core_handle->ack->buf, buf_size,
+            hg_core_handle->ack->plugin_data, hg_core_handle->na_addr,
             hg_core_handle->core_handle.info.context_id, hg_core_handle->tag,
-            hg_core_handle->na_ack_op_id);
+            hg_core_handle->ack->op_id);
         HG_CHECK_ERROR(na_ret != NA_SUCCESS, error, ret, (hg_return_t) na_ret,
             "Could not post recv for ack buffer (%s)",
             NA_Error_to_string(na_ret));
@@ -2976,20 +3845,14 @@ error:
 
         /* Cancel the above posted recv ack op */
         na_ret = NA_Cancel(hg_core_handle->na_class, hg_core_handle->na_context,
-            hg_core_handle->na_ack_op_id);
+            hg_core_handle->ack->op_id);
         HG_CHECK_ERROR_DONE(na_ret != NA_SUCCESS,
             "Could not cancel ack op id (%s)", NA_Error_to_string(na_ret));
 
         /* Return success here but callback will return canceled */
         return HG_SUCCESS;
-    } else if (hg_core_handle->ack_buf) {
-        na_ret = NA_Msg_buf_free(hg_core_handle->na_class,
-            hg_core_handle->ack_buf, hg_core_handle->ack_buf_plugin_data);
-        HG_CHECK_ERROR_DONE(na_ret != NA_SUCCESS,
-            "Could not free ack buffer (%s)", NA_Error_to_string(na_ret));
-        hg_core_handle->ack_buf = NULL;
-        hg_core_handle->ack_buf_plugin_data = NULL;
-    }
+    } else
+        hg_core_ack_buf_free(hg_core_handle);
 
     return ret;
 }
@@ -3062,6 +3925,8 @@ hg_core_recv_input_cb(const struct na_cb_info *callback_info)
         (struct hg_core_private_handle *) callback_info->arg;
     const struct na_cb_info_recv_unexpected *na_cb_info_recv_unexpected =
         &callback_info->info.recv_unexpected;
+    struct hg_core_post_state *post_state =
+        &HG_CORE_HANDLE_CONTEXT(hg_core_handle)->post_state;
     hg_bool_t completed = HG_TRUE;
     hg_return_t ret;
 
@@ -3069,6 +3934,13 @@ hg_core_recv_input_cb(const struct na_cb_info *callback_info)
     hg_thread_spin_lock(
         &HG_CORE_HANDLE_CONTEXT(hg_core_handle)->pending_list_lock);
     HG_LIST_REMOVE(hg_core_handle, pending);
+    post_state->posted_count--;
+    if (callback_info->ret == NA_SUCCESS) {
+        post_state->recv_count++;
+        post_state->period_recv_count++;
+        post_state->peak_count = MAX(post_state->peak_count,
+            post_state->total_count - post_state->posted_count);
+    }
     hg_thread_spin_unlock(
         &HG_CORE_HANDLE_CONTEXT(hg_core_handle)->pending_list_lock);
 
@@ -3083,6 +3955,12 @@ hg_core_recv_input_cb(const struct na_cb_info *callback_info)
                 error, ret, "Could not check and repost pending requests");
         }
 
+        /* Attach shared output buffer */
+        if (hg_core_handle->buf_pool) {
+            ret = hg_core_out_buf_attach(hg_core_handle);
+            HG_CHECK_HG_ERROR(error, ret, "Could not attach output buffer");
+        }
+
         /* Fill unexpected info */
         hg_core_handle->na_addr = na_cb_info_recv_unexpected->source;
 #ifdef NA_HAS_SM
@@ -3187,14 +4065,6 @@ hg_core_process_input(
     /* Parse flags */
     hg_core_handle->no_response =
         hg_core_handle->in_header.msg.request.flags & HG_CORE_NO_RESPONSE;
-    hg_core_handle->respond =
-        hg_core_handle->in_header.msg.request.flags & HG_CORE_SELF_FORWARD
-            ? hg_core_respond_self
-            : hg_core_respond_na;
-    hg_core_handle->no_respond =
-        hg_core_handle->in_header.msg.request.flags & HG_CORE_SELF_FORWARD
-            ? hg_core_no_respond_self
-            : hg_core_no_respond_na;
 
     HG_LOG_DEBUG("Processed input for handle %p, ID=%" PRIu64 ", cookie=%" PRIu8
                  ", no_response=%d",
@@ -3409,22 +4279,15 @@ hg_core_send_ack(hg_core_handle_t handle, hg_return_t ret)
     hg_core_handle->na_op_count++;
 
     /* Allocate buffer for ack */
-    hg_core_handle->ack_buf = NA_Msg_buf_alloc(hg_core_handle->na_class,
-        buf_size, &hg_core_handle->ack_buf_plugin_data);
-    HG_CHECK_ERROR(hg_core_handle->ack_buf == NULL, error, hg_ret, HG_NA_ERROR,
-        "Could not allocate buffer for ack");
-
-    na_ret = NA_Msg_init_expected(
-        hg_core_handle->na_class, hg_core_handle->ack_buf, buf_size);
-    HG_CHECK_ERROR(na_ret != NA_SUCCESS, error, hg_ret, (hg_return_t) na_ret,
-        "Could not initialize ack buffer (%s)", NA_Error_to_string(na_ret));
+    hg_ret = hg_core_ack_alloc(hg_core_handle, buf_size);
+    HG_CHECK_HG_ERROR(error, hg_ret, "Could not allocate ack");
 
     /* Post expected send (ack) */
     na_ret = NA_Msg_send_expected(hg_core_handle->na_class,
         hg_core_handle->na_context, hg_core_ack_cb, hg_core_handle,
-        hg_core_handle->ack_buf, buf_size, hg_core_handle->ack_buf_plugin_data,
-        hg_core_handle->na_addr, hg_core_handle->core_handle.info.context_id,
-        hg_core_handle->tag, hg_core_handle->na_ack_op_id);
+        hg_core_handle->ack->buf, buf_size, hg_core_handle->ack->plugin_data,
+        hg_core_handle->na_addr, hg_core_handle->na_target_id,
+        hg_core_handle->tag, hg_core_handle->ack->op_id);
     /* Expected sends should always succeed after retry */
     HG_CHECK_ERROR(na_ret != NA_SUCCESS, error, hg_ret, (hg_return_t) na_ret,
         "Could not post send for ack buffer (%s)", NA_Error_to_string(na_ret));
@@ -3432,14 +4295,7 @@ hg_core_send_ack(hg_core_handle_t handle, hg_return_t ret)
     return;
 
 error:
-    if (hg_core_handle->ack_buf) {
-        na_ret = NA_Msg_buf_free(hg_core_handle->na_class,
-            hg_core_handle->ack_buf, hg_core_handle->ack_buf_plugin_data);
-        HG_CHECK_ERROR_DONE(na_ret != NA_SUCCESS,
-            "Could not free ack buffer (%s)", NA_Error_to_string(na_ret));
-        hg_core_handle->ack_buf = NULL;
-        hg_core_handle->ack_buf_plugin_data = NULL;
-    }
+    hg_core_ack_buf_free(hg_core_handle);
     /* Mark handle as errored */
     if (hg_ret != HG_CANCELED)
         hg_atomic_or32(&hg_core_handle->status, HG_CORE_OP_ERRORED);
@@ -3556,11 +4412,10 @@ hg_core_process(struct hg_core_private_handle *hg_core_handle)
     hg_return_t ret = HG_SUCCESS;
 
     /* Retrieve exe function from function map */
-    hg_thread_spin_lock(&HG_CORE_HANDLE_CLASS(hg_core_handle)->func_map_lock);
-    hg_core_rpc_info = (struct hg_core_rpc_info *) hg_hash_table_lookup(
-        HG_CORE_HANDLE_CLASS(hg_core_handle)->func_map,
-        (hg_hash_table_key_t) &hg_core_handle->core_handle.info.id);
-    hg_thread_spin_unlock(&HG_CORE_HANDLE_CLASS(hg_core_handle)->func_map_lock);
+    hg_core_rpc_info = hg_core_func_map_lookup(
+        HG_CORE_HANDLE_CLASS(hg_core_handle),
+        HG_CORE_HANDLE_CONTEXT(hg_core_handle),
+        hg_core_handle->core_handle.info.id);
     if (!hg_core_rpc_info) {
         HG_LOG_WARNING("Could not find RPC ID in function map");
         ret = HG_NOENTRY;
@@ -3640,35 +4495,31 @@ hg_core_completion_add(struct hg_core_context *context,
             HG_CORE_CONTEXT_CLASS(private_context)->counters.bulk_count);
 #endif
 
-    rc = hg_atomic_queue_push(
-        private_context->completion_queue, hg_completion_entry);
-    if (rc != HG_UTIL_SUCCESS) {
-        /* Queue is full */
+    /* Queue only fails to grow when memory is exhausted, retry until a
+     * consumer has made room */
+    while (hg_core_completion_queue_push(private_context,
+               hg_completion_entry) != HG_UTIL_SUCCESS)
+        hg_thread_yield();
+
+    /* Callback is pushed to the completion queue when something completes
+     * so wake up anyone waiting in trigger */
+    if (hg_atomic_get32(&private_context->completion_queue_waiters) > 0) {
         hg_thread_mutex_lock(&private_context->completion_queue_mutex);
-        HG_QUEUE_PUSH_TAIL(
-            &private_context->backfill_queue, hg_completion_entry, entry);
-        hg_atomic_incr32(&private_context->backfill_queue_count);
+        hg_thread_cond_signal(&private_context->completion_queue_cond);
         hg_thread_mutex_unlock(&private_context->completion_queue_mutex);
     }
 
-    /* Callback is pushed to the completion queue when something completes
-     * so wake up anyone waiting in trigger */
-    hg_thread_mutex_lock(&private_context->completion_queue_mutex);
-    hg_thread_cond_signal(&private_context->completion_queue_cond);
-    hg_thread_mutex_unlock(&private_context->completion_queue_mutex);
-
-    if (self_notify && private_context->completion_queue_notify > 0) {
-        hg_thread_mutex_lock(&private_context->completion_queue_notify_mutex);
-        /* Do not bother notifying if it's not needed as any event call will
-         * increase latency */
-        if (hg_atomic_get32(&private_context->completion_queue_must_notify)) {
-            rc = hg_event_set(private_context->completion_queue_notify);
-            HG_CHECK_ERROR_NORET(rc != HG_UTIL_SUCCESS, unlock,
-                "Could not signal completion queue");
-        }
-unlock:
-        hg_thread_mutex_unlock(&private_context->completion_queue_notify_mutex);
+    /* Do not bother notifying if it's not needed as any event call will
+     * increase latency */
+    if (self_notify && private_context->completion_queue_notify > 0 &&
+        hg_atomic_get32(&private_context->completion_queue_must_notify)) {
+        rc = hg_event_set(private_context->completion_queue_notify);
+        HG_CHECK_ERROR_NORET(
+            rc != HG_UTIL_SUCCESS, done, "Could not signal completion queue");
     }
+
+done:
+    return;
 }
 
 /*---------------------------------------------------------------------------*/
@@ -3679,10 +4530,27 @@ hg_core_progress(
     hg_time_t deadline, now = hg_time_from_ms(0);
     hg_return_t ret;
 
+    /* Release posted requests that are no longer needed */
+    if (HG_CORE_CONTEXT_CLASS(context)->request_post_adaptive) {
+        ret = hg_core_context_post_adapt(context);
+        HG_CHECK_HG_ERROR(
+            error, ret, "Could not adapt number of posted requests");
+    }
+
     if (timeout_ms != 0)
         hg_time_get_current_ms(&now);
     deadline = hg_time_add(now, hg_time_from_ms(timeout_ms));
 
+    /* Try to avoid arming the poll set if something completes shortly */
+    if (timeout_ms != 0 && HG_CORE_CONTEXT_CLASS(context)->progress_adaptive) {
+        ret = hg_core_progress_spin(context, deadline);
+        if (ret != HG_TIMEOUT)
+            return ret;
+        hg_time_get_current_ms(&now);
+        if (!hg_time_less(now, deadline))
+            return HG_TIMEOUT;
+    }
+
     do {
         hg_bool_t safe_wait = HG_FALSE, progressed = HG_FALSE;
         unsigned int poll_timeout = 0;
@@ -3691,16 +4559,16 @@ hg_core_progress(
         if (timeout_ms == 0) {
             ; // nothing to do
         } else if (context->poll_set) {
-            hg_thread_mutex_lock(&context->completion_queue_notify_mutex);
+            /* We need to be notified when doing blocking progress. Request
+             * it before checking the queue so that a completion added after
+             * the check always sees the flag and signals the event */
+            hg_atomic_or32(&context->completion_queue_must_notify, 1);
 
             if (hg_core_poll_try_wait(context)) {
                 safe_wait = HG_TRUE;
                 poll_timeout = hg_time_to_ms(hg_time_subtract(deadline, now));
-
-                /* We need to be notified when doing blocking progress */
-                hg_atomic_set32(&context->completion_queue_must_notify, 1);
-            }
-            hg_thread_mutex_unlock(&context->completion_queue_notify_mutex);
+            } else
+                hg_atomic_set32(&context->completion_queue_must_notify, 0);
         } else if (!HG_CORE_CONTEXT_CLASS(context)->loopback &&
                    hg_core_poll_try_wait(context)) {
             /* This is the case for NA plugins that don't expose a fd */
@@ -3719,10 +4587,11 @@ hg_core_progress(
         }
 
         /* We progressed or we have something to trigger */
-        if (progressed ||
-            !hg_atomic_queue_is_empty(context->completion_queue) ||
-            (hg_atomic_get32(&context->backfill_queue_count) > 0))
+        if (progressed || !hg_core_completion_queue_is_empty(context)) {
+            if (timeout_ms != 0)
+                hg_atomic_incr64(&context->progress_poll_count);
             return HG_SUCCESS;
+        }
 
         if (timeout_ms != 0)
             hg_time_get_current_ms(&now);
@@ -3735,24 +4604,75 @@ error:
 }
 
 /*---------------------------------------------------------------------------*/
-static HG_INLINE hg_bool_t
-hg_core_poll_try_wait(struct hg_core_private_context *context)
+static hg_return_t
+hg_core_progress_spin(
+    struct hg_core_private_context *context, hg_time_t deadline)
 {
-    /* Something is in one of the completion queues */
-    if (!hg_atomic_queue_is_empty(context->completion_queue) ||
-        (hg_atomic_get32(&context->backfill_queue_count) > 0))
-        return HG_FALSE;
+    hg_time_t spin_time = HG_CORE_CONTEXT_CLASS(context)->progress_spin_time;
+    hg_time_t now, spin_deadline, backoff_deadline;
+    unsigned int backoff = 1;
+    hg_return_t ret;
 
-#ifdef NA_HAS_SM
-    if (context->core_context.core_class->na_sm_class &&
+    hg_time_get_current(&now);
+    spin_deadline = hg_time_add(now, spin_time);
+    backoff_deadline = hg_time_add(spin_deadline, spin_time);
+    if (hg_time_less(deadline, backoff_deadline))
+        backoff_deadline = deadline;
+
+    do {
+        hg_bool_t progressed = HG_FALSE;
+        hg_bool_t spinning = hg_time_less(now, spin_deadline);
+
+        ret = hg_core_poll(context, 0, &progressed);
+        HG_CHECK_HG_ERROR(
+            error, ret, "Could not make non-blocking progress on context");
+
+        /* We progressed or we have something to trigger */
+        if (progressed || !hg_core_completion_queue_is_empty(context)) {
+            hg_atomic_incr64(spinning ? &context->progress_spin_count
+                                      : &context->progress_backoff_count);
+            return HG_SUCCESS;
+        }
+
+        if (!spinning) {
+            unsigned int i;
+
+            for (i = 0; i < backoff; i++)
+                cpu_spinwait();
+            if (backoff < HG_CORE_PROGRESS_BACKOFF_MAX)
+                backoff <<= 1;
+        }
+
+        hg_time_get_current(&now);
+    } while (hg_time_less(now, backoff_deadline));
+
+    return HG_TIMEOUT;
+
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static HG_INLINE hg_bool_t
+hg_core_poll_try_wait(struct hg_core_private_context *context)
+{
+    unsigned int i;
+
+    /* Something is in one of the completion queues */
+    if (!hg_core_completion_queue_is_empty(context))
+        return HG_FALSE;
+
+#ifdef NA_HAS_SM
+    if (context->core_context.core_class->na_sm_class &&
         !NA_Poll_try_wait(context->core_context.core_class->na_sm_class,
             context->core_context.na_sm_context))
         return HG_FALSE;
 #endif
 
-    if (!NA_Poll_try_wait(context->core_context.core_class->na_class,
-            context->core_context.na_context))
-        return HG_FALSE;
+    for (i = 0; i < HG_CORE_CONTEXT_CLASS(context)->na_rail_count; i++)
+        if (!NA_Poll_try_wait(context->core_context.core_class->na_class,
+                context->na_rails[i]))
+            return HG_FALSE;
 
     return HG_TRUE;
 }
@@ -3762,13 +4682,17 @@ static hg_return_t
 hg_core_poll_wait(struct hg_core_private_context *context,
     unsigned int timeout_ms, hg_bool_t *progressed_ptr)
 {
+    uint32_t na_poll_min = (uint32_t) HG_CORE_POLL_NA,
+             na_poll_max =
+                 na_poll_min + HG_CORE_CONTEXT_CLASS(context)->na_rail_count;
     unsigned int i, nevents;
     hg_return_t ret = HG_SUCCESS;
     hg_bool_t progressed = HG_FALSE;
     int rc;
 
-    rc = hg_poll_wait(context->poll_set, timeout_ms, HG_CORE_MAX_EVENTS,
-        context->poll_events, &nevents);
+    rc = hg_poll_wait(context->poll_set, timeout_ms,
+        HG_CORE_CONTEXT_CLASS(context)->poll_event_count, context->poll_events,
+        &nevents);
 
     /* No longer need to notify when we're not waiting */
     hg_atomic_set32(&context->completion_queue_must_notify, 0);
@@ -3801,23 +4725,26 @@ hg_core_poll_wait(struct hg_core_private_context *context,
                 /* TODO force epoll_wait */
                 ret = hg_core_progress_na(
                     HG_CORE_CONTEXT_CLASS(context)->core_class.na_sm_class,
-                    context->core_context.na_sm_context, 0, &progressed_event);
+                    context->core_context.na_sm_context,
+                    HG_CORE_CONTEXT_CLASS(context)->trigger_count, 0,
+                    &progressed_event);
                 HG_CHECK_HG_ERROR(done, ret, "hg_core_progress_na() failed");
                 break;
 #endif
-            case HG_CORE_POLL_NA:
-                HG_LOG_DEBUG("HG_CORE_POLL_NA event");
-
-                /* TODO force epoll_wait */
-                ret = hg_core_progress_na(
-                    HG_CORE_CONTEXT_CLASS(context)->core_class.na_class,
-                    context->core_context.na_context, 0, &progressed_event);
-                HG_CHECK_HG_ERROR(done, ret, "hg_core_progress_na() failed");
-                break;
             default:
-                HG_GOTO_ERROR(done, ret, HG_INVALID_ARG,
+                HG_CHECK_ERROR(context->poll_events[i].data.u32 < na_poll_min ||
+                                   context->poll_events[i].data.u32 >=
+                                       na_poll_max,
+                    done, ret, HG_INVALID_ARG,
                     "Invalid type of poll event (%d)",
                     (int) context->poll_events[i].data.u32);
+                HG_LOG_DEBUG("HG_CORE_POLL_NA event");
+
+                /* Completions of one rail may be progressed through another
+                 * rail that shares the same endpoint, progress all of them */
+                ret = hg_core_progress_rails(context, 0, &progressed_event);
+                HG_CHECK_HG_ERROR(
+                    done, ret, "hg_core_progress_rails() failed");
         }
         progressed |= progressed_event;
     }
@@ -3842,7 +4769,8 @@ hg_core_poll(struct hg_core_private_context *context, unsigned int timeout_ms,
     if (context->core_context.na_sm_context) {
         ret = hg_core_progress_na(
             HG_CORE_CONTEXT_CLASS(context)->core_class.na_sm_class,
-            context->core_context.na_sm_context, 0, &progressed_na);
+            context->core_context.na_sm_context,
+            HG_CORE_CONTEXT_CLASS(context)->trigger_count, 0, &progressed_na);
         HG_CHECK_HG_ERROR(done, ret, "hg_core_progress_na() failed");
 
         progressed |= progressed_na;
@@ -3856,10 +4784,8 @@ hg_core_poll(struct hg_core_private_context *context, unsigned int timeout_ms,
 #endif
 
     /* Poll over defaut NA */
-    ret =
-        hg_core_progress_na(HG_CORE_CONTEXT_CLASS(context)->core_class.na_class,
-            context->core_context.na_context, progress_timeout, &progressed_na);
-    HG_CHECK_HG_ERROR(done, ret, "hg_core_progress_na() failed");
+    ret = hg_core_progress_rails(context, progress_timeout, &progressed_na);
+    HG_CHECK_HG_ERROR(done, ret, "hg_core_progress_rails() failed");
 
     *progressed_ptr = progressed | progressed_na;
 
@@ -3870,7 +4796,8 @@ done:
 /*---------------------------------------------------------------------------*/
 static hg_return_t
 hg_core_progress_na(na_class_t *na_class, na_context_t *na_context,
-    unsigned int timeout_ms, hg_bool_t *progressed_ptr)
+    unsigned int trigger_count, unsigned int timeout_ms,
+    hg_bool_t *progressed_ptr)
 {
     hg_time_t deadline, now = hg_time_from_ms(0);
     unsigned int completed_count = 0;
@@ -3888,11 +4815,11 @@ hg_core_progress_na(na_class_t *na_class, na_context_t *na_context,
         /* Trigger everything we can from NA, if something completed it will
          * be moved to the HG context completion queue */
         do {
-            int cb_ret[HG_CORE_MAX_TRIGGER_COUNT] = {0};
+            int cb_ret[HG_CORE_TRIGGER_COUNT_LIMIT];
             unsigned int i;
 
-            na_ret = NA_Trigger(na_context, 0, HG_CORE_MAX_TRIGGER_COUNT,
-                cb_ret, &actual_count);
+            na_ret = NA_Trigger(
+                na_context, 0, trigger_count, cb_ret, &actual_count);
 
             /* Return value of callback is completion count */
             for (i = 0; i < actual_count; i++)
@@ -3932,6 +4859,59 @@ done:
     return ret;
 }
 
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_core_progress_rails(struct hg_core_private_context *context,
+    unsigned int timeout_ms, hg_bool_t *progressed_ptr)
+{
+    na_class_t *na_class = HG_CORE_CONTEXT_CLASS(context)->core_class.na_class;
+    unsigned int rail_count = HG_CORE_CONTEXT_CLASS(context)->na_rail_count, i;
+    unsigned int trigger_count = HG_CORE_CONTEXT_CLASS(context)->trigger_count;
+    unsigned int rail_timeout = 0;
+    hg_time_t deadline, now = hg_time_from_ms(0);
+    hg_bool_t progressed = HG_FALSE;
+    hg_return_t ret = HG_SUCCESS;
+
+    if (rail_count == 1)
+        return hg_core_progress_na(na_class, context->na_rails[0],
+            trigger_count, timeout_ms, progressed_ptr);
+
+    if (timeout_ms != 0)
+        hg_time_get_current_ms(&now);
+    deadline = hg_time_add(now, hg_time_from_ms(timeout_ms));
+
+    /* Blocking on one rail for the whole timeout would delay the others, poll
+     * all rails first and then block on each of them in turn for at most
+     * HG_CORE_RAIL_POLL_SLICE ms until something completes */
+    for (;;) {
+        for (i = 0; i < rail_count; i++) {
+            hg_bool_t progressed_rail = HG_FALSE;
+
+            ret = hg_core_progress_na(na_class, context->na_rails[i],
+                trigger_count, rail_timeout, &progressed_rail);
+            HG_CHECK_HG_ERROR(done, ret, "hg_core_progress_na() failed");
+
+            progressed |= progressed_rail;
+        }
+
+        if (progressed || timeout_ms == 0)
+            break;
+
+        hg_time_get_current_ms(&now);
+        if (!hg_time_less(now, deadline))
+            break;
+
+        rail_timeout = hg_time_to_ms(hg_time_subtract(deadline, now));
+        if (rail_timeout > HG_CORE_RAIL_POLL_SLICE)
+            rail_timeout = HG_CORE_RAIL_POLL_SLICE;
+    }
+
+    *progressed_ptr = progressed;
+
+done:
+    return ret;
+}
+
 /*---------------------------------------------------------------------------*/
 static HG_INLINE hg_return_t
 hg_core_progress_loopback_notify(
@@ -3950,6 +4930,241 @@ done:
     return ret;
 }
 
+/*---------------------------------------------------------------------------*/
+static struct hg_core_completion_queue *
+hg_core_completion_queue_alloc(unsigned int count)
+{
+    struct hg_core_completion_queue *hg_core_completion_queue = NULL;
+
+    hg_core_completion_queue = (struct hg_core_completion_queue *) malloc(
+        sizeof(struct hg_core_completion_queue));
+    HG_CHECK_ERROR_NORET(hg_core_completion_queue == NULL, error,
+        "Could not allocate completion queue segment");
+
+    hg_core_completion_queue->queue = hg_atomic_queue_alloc(count);
+    HG_CHECK_ERROR_NORET(hg_core_completion_queue->queue == NULL, error,
+        "Could not allocate atomic queue");
+    hg_atomic_init64(&hg_core_completion_queue->next, 0);
+
+    return hg_core_completion_queue;
+
+error:
+    free(hg_core_completion_queue);
+
+    return NULL;
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+hg_core_completion_queue_free(
+    struct hg_core_completion_queue *hg_core_completion_queue)
+{
+    while (hg_core_completion_queue) {
+        struct hg_core_completion_queue *next =
+            (struct hg_core_completion_queue *) hg_atomic_get64(
+                &hg_core_completion_queue->next);
+
+        hg_atomic_queue_free(hg_core_completion_queue->queue);
+        free(hg_core_completion_queue);
+        hg_core_completion_queue = next;
+    }
+}
+
+/*---------------------------------------------------------------------------*/
+static int
+hg_core_completion_queue_push(struct hg_core_private_context *context,
+    struct hg_completion_entry *hg_completion_entry)
+{
+    int ret = HG_UTIL_FAIL;
+
+    /* Segments are not freed while a reference is held */
+    hg_atomic_incr32(&context->completion_queue_refs);
+
+    for (;;) {
+        struct hg_core_completion_queue *tail =
+            (struct hg_core_completion_queue *) hg_atomic_get64(
+                &context->completion_queue_tail);
+        struct hg_core_completion_queue *next;
+
+        if (hg_atomic_queue_push(tail->queue, hg_completion_entry) ==
+            HG_UTIL_SUCCESS)
+            break;
+
+        /* Segment is full, append a new segment twice as large if no other
+         * producer has done it already */
+        next = (struct hg_core_completion_queue *) hg_atomic_get64(&tail->next);
+        if (next == NULL) {
+            HG_CHECK_ERROR_NORET(tail->queue->prod_size > (UINT32_MAX >> 2),
+                done, "Completion queue reached max size");
+
+            next = hg_core_completion_queue_alloc(tail->queue->prod_size * 2);
+            if (next == NULL)
+                goto done;
+
+            if (!hg_atomic_cas64(&tail->next, 0, (int64_t) next)) {
+                hg_core_completion_queue_free(next);
+                next = (struct hg_core_completion_queue *) hg_atomic_get64(
+                    &tail->next);
+            }
+        }
+
+        /* Move tail forward (may already have been done by someone else) */
+        hg_atomic_cas64(
+            &context->completion_queue_tail, (int64_t) tail, (int64_t) next);
+    }
+    ret = HG_UTIL_SUCCESS;
+
+done:
+    hg_atomic_decr32(&context->completion_queue_refs);
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+hg_core_completion_queue_retire(struct hg_core_private_context *context)
+{
+    struct hg_core_completion_queue *head, *next;
+
+    /* Only one thread retires segments, so that head is not moved by anyone
+     * else while it is unlinked */
+    if (!hg_atomic_cas32(&context->completion_queue_retiring, 0, 1))
+        return;
+
+    for (;;) {
+        head = (struct hg_core_completion_queue *) hg_atomic_get64(
+            &context->completion_queue_head);
+        next = (struct hg_core_completion_queue *) hg_atomic_get64(
+            &head->next);
+
+        /* Tail only moves forward, once it has moved past the head segment
+         * new producers can no longer reach it */
+        if (next == NULL ||
+            hg_atomic_get64(&context->completion_queue_tail) ==
+                (int64_t) head ||
+            !hg_atomic_queue_is_empty(head->queue))
+            break;
+
+        /* Unlink segment so that threads no longer start from it, it can
+         * then be freed if the caller is the only thread holding a
+         * reference. Otherwise a late producer or consumer may still use it,
+         * link it back and retry later. The reference count is checked with
+         * a CAS so that a thread taking a reference afterwards is ordered
+         * after the unlink and starts from the new head. */
+        hg_atomic_cas64(
+            &context->completion_queue_head, (int64_t) head, (int64_t) next);
+        if (!hg_atomic_cas32(&context->completion_queue_refs, 1, 1) ||
+            !hg_atomic_queue_is_empty(head->queue)) {
+            hg_atomic_set64(&context->completion_queue_head, (int64_t) head);
+            break;
+        }
+        hg_atomic_set64(&head->next, 0);
+        hg_core_completion_queue_free(head);
+    }
+
+    hg_atomic_set32(&context->completion_queue_retiring, 0);
+}
+
+/*---------------------------------------------------------------------------*/
+static HG_INLINE hg_bool_t
+hg_core_completion_queue_is_empty(struct hg_core_private_context *context)
+{
+    struct hg_core_completion_queue *hg_core_completion_queue;
+    hg_bool_t ret = HG_TRUE;
+
+    hg_atomic_incr32(&context->completion_queue_refs);
+    for (hg_core_completion_queue =
+             (struct hg_core_completion_queue *) hg_atomic_get64(
+                 &context->completion_queue_head);
+         hg_core_completion_queue != NULL;
+         hg_core_completion_queue =
+             (struct hg_core_completion_queue *) hg_atomic_get64(
+                 &hg_core_completion_queue->next)) {
+        if (!hg_atomic_queue_is_empty(hg_core_completion_queue->queue)) {
+            ret = HG_FALSE;
+            break;
+        }
+    }
+    hg_atomic_decr32(&context->completion_queue_refs);
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static HG_INLINE unsigned int
+hg_core_completion_count(struct hg_core_private_context *context)
+{
+    struct hg_core_completion_queue *hg_core_completion_queue;
+    unsigned int count = 0;
+
+    hg_atomic_incr32(&context->completion_queue_refs);
+    for (hg_core_completion_queue =
+             (struct hg_core_completion_queue *) hg_atomic_get64(
+                 &context->completion_queue_head);
+         hg_core_completion_queue != NULL;
+         hg_core_completion_queue =
+             (struct hg_core_completion_queue *) hg_atomic_get64(
+                 &hg_core_completion_queue->next))
+        count += hg_atomic_queue_count(hg_core_completion_queue->queue);
+    hg_atomic_decr32(&context->completion_queue_refs);
+
+    return count;
+}
+
+/*---------------------------------------------------------------------------*/
+static unsigned int
+hg_core_completion_pop(struct hg_core_private_context *context,
+    struct hg_completion_entry *hg_completion_entries[], unsigned int max_count)
+{
+    struct hg_core_completion_queue *hg_core_completion_queue;
+    unsigned int count = 0;
+
+    hg_atomic_incr32(&context->completion_queue_refs);
+
+    /* Drain segments oldest first, reserving all available entries of a
+     * segment at once */
+    for (hg_core_completion_queue =
+             (struct hg_core_completion_queue *) hg_atomic_get64(
+                 &context->completion_queue_head);
+         hg_core_completion_queue != NULL && count < max_count;
+         hg_core_completion_queue =
+             (struct hg_core_completion_queue *) hg_atomic_get64(
+                 &hg_core_completion_queue->next))
+        count += hg_atomic_queue_pop_n(hg_core_completion_queue->queue,
+            (void **) &hg_completion_entries[count], max_count - count);
+
+    /* Once a burst has been drained, only the last segment is kept */
+    if (hg_atomic_get64(&context->completion_queue_head) !=
+        hg_atomic_get64(&context->completion_queue_tail))
+        hg_core_completion_queue_retire(context);
+
+    hg_atomic_decr32(&context->completion_queue_refs);
+
+    return count;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_core_completion_wait(
+    struct hg_core_private_context *context, unsigned int timeout_ms)
+{
+    hg_return_t ret = HG_SUCCESS;
+
+    /* Producers only signal the cond if someone is registered as waiting */
+    hg_thread_mutex_lock(&context->completion_queue_mutex);
+    hg_atomic_incr32(&context->completion_queue_waiters);
+    if (hg_core_completion_queue_is_empty(context)) {
+        if (hg_thread_cond_timedwait(&context->completion_queue_cond,
+                &context->completion_queue_mutex,
+                timeout_ms) != HG_UTIL_SUCCESS)
+            ret = HG_TIMEOUT; /* Timeout occurred so leave */
+    }
+    hg_atomic_decr32(&context->completion_queue_waiters);
+    hg_thread_mutex_unlock(&context->completion_queue_mutex);
+
+    return ret;
+}
+
 /*---------------------------------------------------------------------------*/
 static hg_return_t
 hg_core_trigger(struct hg_core_private_context *context,
@@ -3964,89 +5179,148 @@ hg_core_trigger(struct hg_core_private_context *context,
     deadline = hg_time_add(now, hg_time_from_ms(timeout_ms));
 
     while (count < max_count) {
-        struct hg_completion_entry *hg_completion_entry = NULL;
-
-        hg_completion_entry = hg_atomic_queue_pop_mc(context->completion_queue);
-        if (!hg_completion_entry) {
-            /* Check backfill queue */
-            if (hg_atomic_get32(&context->backfill_queue_count)) {
-                hg_thread_mutex_lock(&context->completion_queue_mutex);
-                hg_completion_entry = HG_QUEUE_FIRST(&context->backfill_queue);
-                HG_QUEUE_POP_HEAD(&context->backfill_queue, entry);
-                hg_atomic_decr32(&context->backfill_queue_count);
-                hg_thread_mutex_unlock(&context->completion_queue_mutex);
-                if (!hg_completion_entry)
-                    continue; /* Give another change to grab it */
-            } else {
-                /* If something was already processed leave */
-                if (count)
-                    break;
-
-                /* Timeout is 0 so leave */
-                if (!hg_time_less(now, deadline)) {
-                    ret = HG_TIMEOUT;
-                    break;
-                }
-
-                hg_thread_mutex_lock(&context->completion_queue_mutex);
-                /* Otherwise wait remaining ms */
-                if (hg_atomic_queue_is_empty(context->completion_queue) &&
-                    !hg_atomic_get32(&context->backfill_queue_count)) {
-                    if (hg_thread_cond_timedwait(
-                            &context->completion_queue_cond,
-                            &context->completion_queue_mutex,
-                            hg_time_to_ms(hg_time_subtract(deadline, now))) !=
-                        HG_UTIL_SUCCESS)
-                        ret = HG_TIMEOUT; /* Timeout occurred so leave */
-                }
-                hg_thread_mutex_unlock(&context->completion_queue_mutex);
-                if (ret == HG_TIMEOUT)
-                    break;
-
-                if (timeout_ms != 0)
-                    hg_time_get_current_ms(&now);
-                continue; /* Give another change to grab it */
+        struct hg_completion_entry
+            *hg_completion_entries[HG_CORE_TRIGGER_COUNT_LIMIT];
+        unsigned int n_entries;
+
+        n_entries = hg_core_completion_pop(context, hg_completion_entries,
+            MIN(max_count - count,
+                HG_CORE_CONTEXT_CLASS(context)->trigger_count));
+        if (n_entries == 0) {
+            /* If something was already processed leave */
+            if (count)
+                break;
+
+            /* Timeout is 0 so leave */
+            if (!hg_time_less(now, deadline)) {
+                ret = HG_TIMEOUT;
+                break;
             }
+
+            /* Otherwise wait remaining ms */
+            ret = hg_core_completion_wait(
+                context, hg_time_to_ms(hg_time_subtract(deadline, now)));
+            if (ret == HG_TIMEOUT)
+                break;
+
+            if (timeout_ms != 0)
+                hg_time_get_current_ms(&now);
+            continue; /* Give another change to grab it */
         }
 
-        /* Completion queue should not be empty now */
-        HG_CHECK_ERROR(hg_completion_entry == NULL, done, ret, HG_FAULT,
-            "NULL completion entry");
+        /* Trigger entries */
+        ret = hg_core_trigger_entries(hg_completion_entries, n_entries);
+        count += n_entries;
+        HG_CHECK_HG_ERROR(done, ret, "Could not trigger completion entries");
+    }
+
+done:
+    if (actual_count)
+        *actual_count = count;
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_core_trigger_batch(struct hg_core_private_context *context,
+    unsigned int timeout_ms, unsigned int max_count, unsigned int *actual_count)
+{
+    hg_time_t deadline, now = hg_time_from_ms(0);
+    unsigned int count = 0, queued_count;
+    hg_return_t ret = HG_SUCCESS;
+
+    if (timeout_ms != 0)
+        hg_time_get_current_ms(&now);
+    deadline = hg_time_add(now, hg_time_from_ms(timeout_ms));
+
+    /* Wait until something is queued */
+    while ((queued_count = hg_core_completion_count(context)) == 0) {
+        /* Timeout is 0 so leave */
+        if (!hg_time_less(now, deadline))
+            HG_GOTO_DONE(done, ret, HG_TIMEOUT);
+
+        ret = hg_core_completion_wait(
+            context, hg_time_to_ms(hg_time_subtract(deadline, now)));
+        if (ret == HG_TIMEOUT)
+            goto done;
+
+        if (timeout_ms != 0)
+            hg_time_get_current_ms(&now);
+    }
+
+    /* Only process entries that were queued on entry so that callbacks
+     * queued from within triggered callbacks are deferred to the next call */
+    max_count = MIN(max_count, queued_count);
+
+    while (count < max_count) {
+        struct hg_completion_entry
+            *hg_completion_entries[HG_CORE_TRIGGER_COUNT_LIMIT];
+        unsigned int n_entries;
+
+        n_entries = hg_core_completion_pop(context, hg_completion_entries,
+            MIN(max_count - count,
+                HG_CORE_CONTEXT_CLASS(context)->trigger_count));
+        if (n_entries == 0)
+            break; /* Entries may have been consumed by another thread */
+
+        ret = hg_core_trigger_entries(hg_completion_entries, n_entries);
+        count += n_entries;
+        HG_CHECK_HG_ERROR(done, ret, "Could not trigger completion entries");
+    }
+
+done:
+    if (actual_count)
+        *actual_count = count;
+
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_return_t
+hg_core_trigger_entries(
+    struct hg_completion_entry *hg_completion_entries[], unsigned int count)
+{
+    hg_return_t ret = HG_SUCCESS;
+    unsigned int i;
+
+    /* Entries have already been dequeued, always trigger all of them and
+     * report the first error encountered */
+    for (i = 0; i < count; i++) {
+        struct hg_completion_entry *hg_completion_entry =
+            hg_completion_entries[i];
+        hg_return_t trigger_ret;
 
-        /* Trigger entry */
         switch (hg_completion_entry->op_type) {
             case HG_ADDR:
-                ret = hg_core_trigger_lookup_entry(
+                trigger_ret = hg_core_trigger_lookup_entry(
                     hg_completion_entry->op_id.hg_core_op_id);
-                HG_CHECK_HG_ERROR(
-                    done, ret, "Could not trigger addr completion entry");
+                HG_CHECK_ERROR_DONE(trigger_ret != HG_SUCCESS,
+                    "Could not trigger addr completion entry");
                 break;
             case HG_RPC:
-                ret = hg_core_trigger_entry(
+                trigger_ret = hg_core_trigger_entry(
                     (struct hg_core_private_handle *)
                         hg_completion_entry->op_id.hg_core_handle);
-                HG_CHECK_HG_ERROR(
-                    done, ret, "Could not trigger RPC completion entry");
+                HG_CHECK_ERROR_DONE(trigger_ret != HG_SUCCESS,
+                    "Could not trigger RPC completion entry");
                 break;
             case HG_BULK:
-                ret = hg_bulk_trigger_entry(
+                trigger_ret = hg_bulk_trigger_entry(
                     hg_completion_entry->op_id.hg_bulk_op_id);
-                HG_CHECK_HG_ERROR(
-                    done, ret, "Could not trigger bulk completion entry");
+                HG_CHECK_ERROR_DONE(trigger_ret != HG_SUCCESS,
+                    "Could not trigger bulk completion entry");
                 break;
             default:
-                HG_GOTO_ERROR(done, ret, HG_INVALID_ARG,
-                    "Invalid type of completion entry (%d)",
+                trigger_ret = HG_INVALID_ARG;
+                HG_LOG_ERROR("Invalid type of completion entry (%d)",
                     (int) hg_completion_entry->op_type);
         }
 
-        count++;
+        if (ret == HG_SUCCESS)
+            ret = trigger_ret;
     }
 
-    if (actual_count)
-        *actual_count = count;
-
-done:
     return ret;
 }
 
@@ -4066,7 +5340,7 @@ hg_core_trigger_lookup_entry(struct hg_core_op_id *hg_core_op_id)
         hg_core_cb_info.info.lookup.addr =
             (hg_core_addr_t) hg_core_op_id->info.lookup.hg_core_addr;
 
-        hg_core_op_id->callback(&hg_core_cb_info);
+        ret = hg_core_op_id->callback(&hg_core_cb_info);
     }
 
     /* NB. OK to free after callback execution, op ID is not re-used */
@@ -4079,7 +5353,7 @@ hg_core_trigger_lookup_entry(struct hg_core_op_id *hg_core_op_id)
 static hg_return_t
 hg_core_trigger_entry(struct hg_core_private_handle *hg_core_handle)
 {
-    hg_return_t ret = HG_SUCCESS;
+    hg_return_t ret = HG_SUCCESS, destroy_ret;
 
     hg_atomic_and32(&hg_core_handle->status, ~HG_CORE_OP_QUEUED);
 
@@ -4108,7 +5382,9 @@ hg_core_trigger_entry(struct hg_core_private_handle *hg_core_handle)
 
         /* No response callback */
         if (hg_core_handle->no_response) {
-            ret = hg_core_handle->no_respond(hg_core_handle);
+            ret = hg_core_handle->is_self
+                      ? hg_core_no_respond_self(hg_core_handle)
+                      : hg_core_no_respond_na(hg_core_handle);
             HG_CHECK_HG_ERROR(done, ret, "Could not complete handle");
         }
     } else {
@@ -4148,17 +5424,20 @@ hg_core_trigger_entry(struct hg_core_private_handle *hg_core_handle)
                     "Invalid core operation type");
         }
 
-        /* Execute user callback.
+        /* Execute user callback, its return value is reported by trigger.
          * NB. The handle cannot be destroyed before the callback execution as
          * the user may carry the handle in the callback. */
         if (hg_cb)
-            hg_cb(&hg_core_cb_info);
+            ret = hg_cb(&hg_core_cb_info);
     }
 
 done:
     /* Repost handle if we were listening, otherwise destroy it */
-    ret = hg_core_destroy(hg_core_handle);
-    HG_CHECK_HG_ERROR(done, ret, "Could not destroy handle");
+    destroy_ret = hg_core_destroy(hg_core_handle);
+    HG_CHECK_ERROR_DONE(
+        destroy_ret != HG_SUCCESS, "Could not destroy handle");
+    if (ret == HG_SUCCESS)
+        ret = destroy_ret;
 
     return ret;
 }
@@ -4199,9 +5478,10 @@ hg_core_cancel(struct hg_core_private_handle *hg_core_handle)
             "Could not cancel send op id (%s)", NA_Error_to_string(na_ret));
     }
 
-    if (hg_core_handle->na_ack_op_id != NULL) {
+    /* Ack is allocated lazily by the thread processing the RPC */
+    if (hg_atomic_get32(&hg_core_handle->ack_published)) {
         na_return_t na_ret = NA_Cancel(hg_core_handle->na_class,
-            hg_core_handle->na_context, hg_core_handle->na_ack_op_id);
+            hg_core_handle->na_context, hg_core_handle->ack->op_id);
         HG_CHECK_ERROR(na_ret != NA_SUCCESS, done, ret, (hg_return_t) na_ret,
             "Could not cancel ack op id (%s)", NA_Error_to_string(na_ret));
     }
@@ -4364,13 +5644,69 @@ done:
     return ret;
 }
 
+/*---------------------------------------------------------------------------*/
+hg_return_t
+HG_Core_context_get_progress_stats(
+    hg_core_context_t *context, struct hg_progress_stats *stats)
+{
+    struct hg_core_private_context *private_context =
+        (struct hg_core_private_context *) context;
+    hg_return_t ret = HG_SUCCESS;
+
+    HG_CHECK_ERROR(
+        context == NULL, done, ret, HG_INVALID_ARG, "NULL HG core context");
+    HG_CHECK_ERROR(stats == NULL, done, ret, HG_INVALID_ARG, "NULL stats");
+
+    stats->spin_count =
+        (hg_uint64_t) hg_atomic_get64(&private_context->progress_spin_count);
+    stats->backoff_count =
+        (hg_uint64_t) hg_atomic_get64(&private_context->progress_backoff_count);
+    stats->poll_count =
+        (hg_uint64_t) hg_atomic_get64(&private_context->progress_poll_count);
+
+done:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+hg_return_t
+HG_Core_context_get_post_stats(
+    hg_core_context_t *context, struct hg_post_stats *stats)
+{
+    struct hg_core_private_context *private_context =
+        (struct hg_core_private_context *) context;
+    struct hg_core_post_state *post_state;
+    hg_return_t ret = HG_SUCCESS;
+
+    HG_CHECK_ERROR(
+        context == NULL, done, ret, HG_INVALID_ARG, "NULL HG core context");
+    HG_CHECK_ERROR(stats == NULL, done, ret, HG_INVALID_ARG, "NULL stats");
+    post_state = &private_context->post_state;
+
+    hg_thread_spin_lock(&private_context->pending_list_lock);
+    stats->recv_count = post_state->recv_count;
+    stats->grow_count = post_state->grow_count;
+    stats->shrink_count = post_state->shrink_count;
+    stats->posted_count = post_state->posted_count;
+    stats->total_count = post_state->total_count;
+    stats->target_count = post_state->target_count;
+    stats->floor_count = post_state->floor_count;
+    stats->recv_rate = post_state->recv_rate;
+    hg_thread_spin_unlock(&private_context->pending_list_lock);
+
+done:
+    return ret;
+}
+
 /*---------------------------------------------------------------------------*/
 hg_return_t
 HG_Core_context_post(hg_core_context_t *context)
 {
+    struct hg_core_private_context *private_context =
+        (struct hg_core_private_context *) context;
     hg_return_t ret = HG_SUCCESS;
     hg_bool_t posted = HG_FALSE;
-    unsigned int request_count;
+    unsigned int request_count, i;
 
     HG_CHECK_ERROR(
         context == NULL, error, ret, HG_INVALID_ARG, "NULL HG core context");
@@ -4383,10 +5719,15 @@ HG_Core_context_post(hg_core_context_t *context)
     HG_LOG_DEBUG(
         "Posting %u requests on context (%p)", request_count, (void *) context);
 
-    ret = hg_core_context_post((struct hg_core_private_context *) context,
-        context->core_class->na_class, context->na_context, request_count);
-    HG_CHECK_HG_ERROR(error, ret, "Could not post requests on context");
-    posted = HG_TRUE;
+    /* Each rail has its own set of posted requests */
+    for (i = 0; i < HG_CORE_CONTEXT_CLASS(private_context)->na_rail_count;
+         i++) {
+        ret = hg_core_context_post(private_context,
+            context->core_class->na_class, private_context->na_rails[i],
+            request_count);
+        HG_CHECK_HG_ERROR(error, ret, "Could not post requests on context");
+        posted = HG_TRUE;
+    }
 
 #ifdef NA_HAS_SM
     if (context->na_sm_context) {
@@ -4397,6 +5738,18 @@ HG_Core_context_post(hg_core_context_t *context)
     }
 #endif
 
+    /* Initial requests are never released */
+    hg_thread_spin_lock(&private_context->pending_list_lock);
+    private_context->post_state.floor_count =
+        private_context->post_state.total_count;
+    private_context->post_state.target_count =
+        private_context->post_state.total_count;
+    hg_time_get_current_ms(&private_context->post_state.period_start);
+    hg_atomic_set64(&private_context->post_state.period_end,
+        HG_CORE_TIME_MS(private_context->post_state.period_start) +
+            HG_CORE_POST_PERIOD);
+    hg_thread_spin_unlock(&private_context->pending_list_lock);
+
     HG_LOG_DEBUG(
         "Posted %u handles on context (%p)", request_count, (void *) context);
 
@@ -4416,54 +5769,45 @@ HG_Core_register(
 {
     struct hg_core_private_class *private_class =
         (struct hg_core_private_class *) hg_core_class;
-    hg_id_t *func_key = NULL;
-    struct hg_core_rpc_info *hg_core_rpc_info = NULL;
+    struct hg_core_private_rpc_info *hg_core_rpc_info = NULL,
+                                    *new_rpc_info = NULL;
     hg_return_t ret = HG_SUCCESS;
     int hash_ret;
 
-    HG_CHECK_ERROR(hg_core_class == NULL, error, ret, HG_INVALID_ARG,
+    HG_CHECK_ERROR(hg_core_class == NULL, done, ret, HG_INVALID_ARG,
         "NULL HG core class");
 
-    // TODO use RW lock
-
-    /* Check if registered and set RPC CB */
+    /* Allocate new info outside of the lock, freed if already registered */
+    new_rpc_info = (struct hg_core_private_rpc_info *) malloc(
+        sizeof(struct hg_core_private_rpc_info));
+    HG_CHECK_ERROR(new_rpc_info == NULL, done, ret, HG_NOMEM,
+        "Could not allocate HG info");
+    new_rpc_info->rpc_info.rpc_cb = rpc_cb;
+    new_rpc_info->rpc_info.data = NULL;
+    new_rpc_info->rpc_info.free_callback = NULL;
+    new_rpc_info->id = id;
+
+    /* Check if registered and set RPC CB, otherwise store new info into the
+     * function map (key is copied into the map) */
     hg_thread_spin_lock(&private_class->func_map_lock);
-    hg_core_rpc_info = (struct hg_core_rpc_info *) hg_hash_table_lookup(
-        private_class->func_map, (hg_hash_table_key_t) &id);
-    if (hg_core_rpc_info && rpc_cb)
-        hg_core_rpc_info->rpc_cb = rpc_cb;
-    hg_thread_spin_unlock(&private_class->func_map_lock);
-
-    if (!hg_core_rpc_info) {
-        /* Allocate the key */
-        func_key = (hg_id_t *) malloc(sizeof(hg_id_t));
-        HG_CHECK_ERROR(func_key == NULL, error, ret, HG_NOMEM,
-            "Could not allocate ID key");
-        *func_key = id;
-
-        /* Fill info and store it into the function map */
-        hg_core_rpc_info =
-            (struct hg_core_rpc_info *) malloc(sizeof(struct hg_core_rpc_info));
-        HG_CHECK_ERROR(hg_core_rpc_info == NULL, error, ret, HG_NOMEM,
-            "Could not allocate HG info");
-
-        hg_core_rpc_info->rpc_cb = rpc_cb;
-        hg_core_rpc_info->data = NULL;
-        hg_core_rpc_info->free_callback = NULL;
-
-        hg_thread_spin_lock(&private_class->func_map_lock);
-        hash_ret = hg_hash_table_insert(private_class->func_map,
-            (hg_hash_table_key_t) func_key, hg_core_rpc_info);
-        hg_thread_spin_unlock(&private_class->func_map_lock);
-        HG_CHECK_ERROR(hash_ret == 0, error, ret, HG_INVALID_ARG,
-            "Could not insert RPC ID into function map (already registered?)");
+    hg_core_rpc_info = (struct hg_core_private_rpc_info *) hg_hash_map_lookup(
+        private_class->func_map, &id);
+    if (hg_core_rpc_info) {
+        if (rpc_cb)
+            hg_core_rpc_info->rpc_info.rpc_cb = rpc_cb;
+        hash_ret = HG_UTIL_SUCCESS;
+    } else {
+        hash_ret =
+            hg_hash_map_insert(private_class->func_map, &id, new_rpc_info);
+        if (hash_ret == HG_UTIL_SUCCESS)
+            new_rpc_info = NULL;
     }
+    hg_thread_spin_unlock(&private_class->func_map_lock);
+    HG_CHECK_ERROR(hash_ret != HG_UTIL_SUCCESS, done, ret, HG_NOMEM,
+        "Could not insert RPC ID into function map");
 
-    return ret;
-
-error:
-    free(func_key);
-    free(hg_core_rpc_info);
+done:
+    free(new_rpc_info);
 
     return ret;
 }
@@ -4474,19 +5818,24 @@ HG_Core_deregister(hg_core_class_t *hg_core_class, hg_id_t id)
 {
     struct hg_core_private_class *private_class =
         (struct hg_core_private_class *) hg_core_class;
+    void *hg_core_rpc_info;
     hg_return_t ret = HG_SUCCESS;
-    int hash_ret;
 
     HG_CHECK_ERROR(
         hg_core_class == NULL, done, ret, HG_INVALID_ARG, "NULL HG core class");
 
     hg_thread_spin_lock(&private_class->func_map_lock);
-    hash_ret = hg_hash_table_remove(
-        private_class->func_map, (hg_hash_table_key_t) &id);
+    hg_core_rpc_info = hg_hash_map_remove(private_class->func_map, &id);
+    /* Invalidate context RPC caches (only existing entries are cached so
+     * newly registered RPCs do not require invalidation) */
+    if (hg_core_rpc_info != NULL)
+        hg_atomic_incr32(&private_class->func_map_gen);
     hg_thread_spin_unlock(&private_class->func_map_lock);
-    HG_CHECK_ERROR(hash_ret == 0, done, ret, HG_NOENTRY,
+    HG_CHECK_ERROR(hg_core_rpc_info == NULL, done, ret, HG_NOENTRY,
         "Could not deregister RPC ID from function map");
 
+    hg_core_func_map_value_free(&id, hg_core_rpc_info, NULL);
+
 done:
     return ret;
 }
@@ -4503,10 +5852,8 @@ HG_Core_registered(hg_core_class_t *hg_core_class, hg_id_t id, hg_bool_t *flag)
         hg_core_class == NULL, done, ret, HG_INVALID_ARG, "NULL HG core class");
     HG_CHECK_ERROR(flag == NULL, done, ret, HG_INVALID_ARG, "NULL flag");
 
-    hg_thread_spin_lock(&private_class->func_map_lock);
-    *flag = (hg_bool_t) (hg_hash_table_lookup(private_class->func_map,
-                             (hg_hash_table_key_t) &id) != HG_HASH_TABLE_NULL);
-    hg_thread_spin_unlock(&private_class->func_map_lock);
+    *flag =
+        (hg_bool_t) (hg_hash_map_lookup(private_class->func_map, &id) != NULL);
 
 done:
     return ret;
@@ -4525,18 +5872,20 @@ HG_Core_register_data(hg_core_class_t *hg_core_class, hg_id_t id, void *data,
     HG_CHECK_ERROR(
         hg_core_class == NULL, done, ret, HG_INVALID_ARG, "NULL HG core class");
 
+    /* Do not update an entry that is being deregistered */
     hg_thread_spin_lock(&private_class->func_map_lock);
-    hg_core_rpc_info = (struct hg_core_rpc_info *) hg_hash_table_lookup(
-        private_class->func_map, (hg_hash_table_key_t) &id);
+    hg_core_rpc_info = (struct hg_core_rpc_info *) hg_hash_map_lookup(
+        private_class->func_map, &id);
+    if (hg_core_rpc_info) {
+        HG_CHECK_WARNING(
+            hg_core_rpc_info->data, "Overriding data previously registered");
+        hg_core_rpc_info->data = data;
+        hg_core_rpc_info->free_callback = free_callback;
+    }
     hg_thread_spin_unlock(&private_class->func_map_lock);
     HG_CHECK_ERROR(hg_core_rpc_info == NULL, done, ret, HG_NOENTRY,
         "Could not find RPC ID in function map");
 
-    HG_CHECK_WARNING(
-        hg_core_rpc_info->data, "Overriding data previously registered");
-    hg_core_rpc_info->data = data;
-    hg_core_rpc_info->free_callback = free_callback;
-
 done:
     return ret;
 }
@@ -4552,10 +5901,8 @@ HG_Core_registered_data(hg_core_class_t *hg_core_class, hg_id_t id)
 
     HG_CHECK_ERROR_NORET(hg_core_class == NULL, done, "NULL HG core class");
 
-    hg_thread_spin_lock(&private_class->func_map_lock);
-    hg_core_rpc_info = (struct hg_core_rpc_info *) hg_hash_table_lookup(
-        private_class->func_map, (hg_hash_table_key_t) &id);
-    hg_thread_spin_unlock(&private_class->func_map_lock);
+    hg_core_rpc_info = (struct hg_core_rpc_info *) hg_hash_map_lookup(
+        private_class->func_map, &id);
     HG_CHECK_ERROR_NORET(hg_core_rpc_info == NULL, done,
         "Could not find RPC ID in function map");
 
@@ -4844,6 +6191,7 @@ HG_Core_create(hg_core_context_t *context, hg_core_addr_t addr, hg_id_t id,
     na_class_t *na_class;
     na_context_t *na_context;
     na_addr_t na_addr = NA_ADDR_NULL;
+    unsigned int rail = 0;
     hg_return_t ret = HG_SUCCESS;
 
     HG_CHECK_ERROR(
@@ -4868,7 +6216,10 @@ HG_Core_create(hg_core_context_t *context, hg_core_addr_t addr, hg_id_t id,
 
         /* Default */
         na_class = context->core_class->na_class;
-        na_context = context->na_context;
+        rail = hg_core_context_rail(
+            (struct hg_core_private_context *) context, hg_core_addr, 0);
+        na_context =
+            ((struct hg_core_private_context *) context)->na_rails[rail];
         if (hg_core_addr)
             na_addr = hg_core_addr->core_addr.na_addr;
 #ifdef NA_HAS_SM
@@ -4877,8 +6228,9 @@ HG_Core_create(hg_core_context_t *context, hg_core_addr_t addr, hg_id_t id,
 
     /* Create new handle */
     ret = hg_core_create((struct hg_core_private_context *) context, na_class,
-        na_context, &hg_core_handle);
+        na_context, NULL, &hg_core_handle);
     HG_CHECK_HG_ERROR(error, ret, "Could not create HG core handle");
+    hg_core_handle->rail = (hg_uint8_t) rail;
 
     /* Set addr / RPC ID */
     ret = hg_core_set_rpc(hg_core_handle, hg_core_addr, na_addr, id);
@@ -4928,6 +6280,7 @@ HG_Core_reset(hg_core_handle_t handle, hg_core_addr_t addr, hg_id_t id)
     na_class_t *na_class;
     na_context_t *na_context;
     na_addr_t na_addr = NA_ADDR_NULL;
+    unsigned int rail = 0;
     hg_return_t ret = HG_SUCCESS;
     int32_t status;
 
@@ -4958,7 +6311,9 @@ HG_Core_reset(hg_core_handle_t handle, hg_core_addr_t addr, hg_id_t id)
 
         /* Default */
         na_class = hg_core_handle->core_handle.info.core_class->na_class;
-        na_context = hg_core_handle->core_handle.info.context->na_context;
+        rail = hg_core_context_rail(HG_CORE_HANDLE_CONTEXT(hg_core_handle),
+            hg_core_addr, 0);
+        na_context = HG_CORE_HANDLE_CONTEXT(hg_core_handle)->na_rails[rail];
         if (hg_core_addr)
             na_addr = hg_core_addr->core_addr.na_addr;
 #ifdef NA_HAS_SM
@@ -4970,12 +6325,14 @@ HG_Core_reset(hg_core_handle_t handle, hg_core_addr_t addr, hg_id_t id)
         ret = hg_core_free_na(hg_core_handle);
         HG_CHECK_HG_ERROR(done, ret, "Could not release NA resources");
 
-        ret = hg_core_alloc_na(hg_core_handle, na_class, na_context);
+        ret = hg_core_alloc_na(hg_core_handle, na_class, na_context, NULL);
         HG_CHECK_HG_ERROR(done, ret, "Could not re-allocate NA resources");
     }
 
     /* Reset handle */
     hg_core_reset(hg_core_handle);
+    hg_core_handle->na_context = na_context;
+    hg_core_handle->rail = (hg_uint8_t) rail;
 
     /* Set addr / RPC ID */
     ret = hg_core_set_rpc(hg_core_handle, hg_core_addr, na_addr, id);
@@ -5105,6 +6462,25 @@ done:
     return ret;
 }
 
+/*---------------------------------------------------------------------------*/
+hg_return_t
+HG_Core_trigger_batch(hg_core_context_t *context, unsigned int timeout,
+    unsigned int max_count, unsigned int *actual_count)
+{
+    hg_return_t ret = HG_SUCCESS;
+
+    HG_CHECK_ERROR(
+        context == NULL, done, ret, HG_INVALID_ARG, "NULL HG core context");
+
+    ret = hg_core_trigger_batch((struct hg_core_private_context *) context,
+        timeout, max_count, actual_count);
+    HG_CHECK_ERROR_NORET(ret != HG_SUCCESS && ret != HG_TIMEOUT, done,
+        "Could not trigger batch of callbacks");
+
+done:
+    return ret;
+}
+
 /*---------------------------------------------------------------------------*/
 hg_return_t
 HG_Core_cancel(hg_core_handle_t handle)
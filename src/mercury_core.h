@@ -382,6 +382,30 @@ HG_Core_context_set_handle_create_callback(hg_core_context_t *context,
 HG_PUBLIC hg_return_t
 HG_Core_context_post(hg_core_context_t *context);
 
+/**
+ * Retrieve progress statistics of a given context.
+ *
+ * \param context [IN]          pointer to HG core context
+ * \param stats [OUT]           pointer to progress stats
+ *
+ * \return HG_SUCCESS or corresponding HG error code
+ */
+HG_PUBLIC hg_return_t
+HG_Core_context_get_progress_stats(
+    hg_core_context_t *context, struct hg_progress_stats *stats);
+
+/**
+ * Retrieve statistics of requests posted for incoming RPCs on a given context.
+ *
+ * \param context [IN]          pointer to HG core context
+ * \param stats [OUT]           pointer to post stats
+ *
+ * \return HG_SUCCESS or corresponding HG error code
+ */
+HG_PUBLIC hg_return_t
+HG_Core_context_get_post_stats(
+    hg_core_context_t *context, struct hg_post_stats *stats);
+
 /**
  * Dynamically register an RPC ID as well as the RPC callback executed
  * when the RPC request ID is received.
@@ -833,12 +857,14 @@ HG_Core_progress(hg_core_context_t *context, unsigned int timeout);
 /**
  * Execute at most max_count callbacks. If timeout is non-zero, wait up to
  * timeout before returning. Function can return when at least one or more
- * callbacks are triggered (at most max_count).
+ * callbacks are triggered (at most max_count). Callbacks that were dequeued
+ * are all executed even if one of them returns an error, the first error
+ * returned is then reported.
  *
  * \param context [IN]          pointer to HG core context
  * \param timeout [IN]          timeout (in milliseconds)
  * \param max_count [IN]        maximum number of callbacks triggered
- * \param actual_count [IN]     actual number of callbacks triggered
+ * \param actual_count [OUT]    actual number of callbacks triggered
  *
  * \return HG_SUCCESS or corresponding HG error code
  */
@@ -846,6 +872,27 @@ HG_PUBLIC hg_return_t
 HG_Core_trigger(hg_core_context_t *context, unsigned int timeout,
     unsigned int max_count, unsigned int *actual_count);
 
+/**
+ * Execute at most max_count callbacks in a single pass. Unlike
+ * HG_Core_trigger(), completed operations are dequeued in batches before
+ * their callbacks get executed and only the callbacks that were already queued
+ * when the call was made are triggered (callbacks that get queued while
+ * executing that batch are deferred to the next call). If timeout is non-zero,
+ * wait up to timeout for at least one callback to be queued. As with
+ * HG_Core_trigger(), the first error returned by a callback is reported once
+ * the whole batch has been executed.
+ *
+ * \param context [IN]          pointer to HG core context
+ * \param timeout [IN]          timeout (in milliseconds)
+ * \param max_count [IN]        maximum number of callbacks triggered
+ * \param actual_count [OUT]    actual number of callbacks triggered
+ *
+ * \return HG_SUCCESS or corresponding HG error code
+ */
+HG_PUBLIC hg_return_t
+HG_Core_trigger_batch(hg_core_context_t *context, unsigned int timeout,
+    unsigned int max_count, unsigned int *actual_count);
+
 /**
  * Cancel an ongoing operation.
  *
@@ -8,7 +8,7 @@
 #include "mercury_error.h"
 
 #ifdef HG_HAS_CHECKSUMS
-#    include <mchecksum.h>
+#    include "mercury_checksum.h"
 #endif
 
 #include "mercury_inet.h"
@@ -20,8 +20,6 @@
 /* Local Macros */
 /****************/
 
-#define HG_CORE_HEADER_CHECKSUM "crc16"
-
 /* Convert values between host and network byte order */
 #define hg_core_header_proc_hg_uint8_t_enc(x)  (x & 0xff)
 #define hg_core_header_proc_hg_uint8_t_dec(x)  (x & 0xff)
@@ -42,17 +40,6 @@
 #define hg_core_header_proc_hg_int8_t_dec(x)                                   \
     (hg_int8_t) hg_core_header_proc_hg_uint8_t_dec((hg_uint8_t) x)
 
-/* Update checksum */
-#ifdef HG_HAS_CHECKSUMS
-#    define HG_CORE_HEADER_CHECKSUM_UPDATE(hg_header, data, type)              \
-        do {                                                                   \
-            if (hg_header->checksum != MCHECKSUM_OBJECT_NULL)                  \
-                mchecksum_update(hg_header->checksum, &data, sizeof(type));    \
-        } while (0)
-#else
-#    define HG_CORE_HEADER_CHECKSUM_UPDATE(hg_header, data, type)
-#endif
-
 /* Proc type */
 #define HG_CORE_HEADER_PROC_TYPE(buf_ptr, data, type, op)                      \
     do {                                                                       \
@@ -67,12 +54,12 @@
         buf_ptr = (char *) buf_ptr + sizeof(type);                             \
     } while (0)
 
-/* Proc */
-#define HG_CORE_HEADER_PROC(hg_header, buf_ptr, data, type, op)                \
-    do {                                                                       \
-        HG_CORE_HEADER_PROC_TYPE(buf_ptr, data, type, op);                     \
-        HG_CORE_HEADER_CHECKSUM_UPDATE(hg_header, data, type);                 \
-    } while (0)
+/* Header checksum (16-bits), computed in one pass over encoded header */
+#ifdef HG_HAS_CHECKSUMS
+#    define HG_CORE_HEADER_CHECKSUM(buf, buf_ptr)                              \
+        hg_checksum_crc16(                                                     \
+            0, buf, (size_t) ((const char *) buf_ptr - (const char *) buf))
+#endif
 
 /************************************/
 /* Local Type and Struct Definition */
@@ -94,9 +81,7 @@ hg_core_header_request_init(
     struct hg_core_header *hg_core_header, hg_bool_t use_checksum)
 {
 #ifdef HG_HAS_CHECKSUMS
-    /* Create a new checksum (CRC16) */
-    if (use_checksum)
-        mchecksum_init(HG_CORE_HEADER_CHECKSUM, &hg_core_header->checksum);
+    hg_core_header->use_checksum = use_checksum;
 #else
     (void) use_checksum;
 #endif
@@ -110,9 +95,7 @@ hg_core_header_response_init(
     struct hg_core_header *hg_core_header, hg_bool_t use_checksum)
 {
 #ifdef HG_HAS_CHECKSUMS
-    /* Create a new checksum (CRC16) */
-    if (use_checksum)
-        mchecksum_init(HG_CORE_HEADER_CHECKSUM, &hg_core_header->checksum);
+    hg_core_header->use_checksum = use_checksum;
 #else
     (void) use_checksum;
 #endif
@@ -124,24 +107,14 @@ hg_core_header_response_init(
 void
 hg_core_header_request_finalize(struct hg_core_header *hg_core_header)
 {
-#ifdef HG_HAS_CHECKSUMS
-    mchecksum_destroy(hg_core_header->checksum);
-    hg_core_header->checksum = MCHECKSUM_OBJECT_NULL;
-#else
     (void) hg_core_header;
-#endif
 }
 
 /*---------------------------------------------------------------------------*/
 void
 hg_core_header_response_finalize(struct hg_core_header *hg_core_header)
 {
-#ifdef HG_HAS_CHECKSUMS
-    mchecksum_destroy(hg_core_header->checksum);
-    hg_core_header->checksum = MCHECKSUM_OBJECT_NULL;
-#else
     (void) hg_core_header;
-#endif
 }
 
 /*---------------------------------------------------------------------------*/
@@ -152,11 +125,6 @@ hg_core_header_request_reset(struct hg_core_header *hg_core_header)
         &hg_core_header->msg.request, 0, sizeof(struct hg_core_header_request));
     hg_core_header->msg.request.hg = HG_CORE_IDENTIFIER;
     hg_core_header->msg.request.protocol = HG_CORE_PROTOCOL_VERSION;
-
-#ifdef HG_HAS_CHECKSUMS
-    if (hg_core_header->checksum != MCHECKSUM_OBJECT_NULL)
-        mchecksum_reset(hg_core_header->checksum);
-#endif
 }
 
 /*---------------------------------------------------------------------------*/
@@ -165,11 +133,6 @@ hg_core_header_response_reset(struct hg_core_header *hg_core_header)
 {
     memset(&hg_core_header->msg.response, 0,
         sizeof(struct hg_core_header_response));
-
-#ifdef HG_HAS_CHECKSUMS
-    if (hg_core_header->checksum != MCHECKSUM_OBJECT_NULL)
-        mchecksum_reset(hg_core_header->checksum);
-#endif
 }
 
 /*---------------------------------------------------------------------------*/
@@ -184,34 +147,25 @@ hg_core_header_request_proc(hg_proc_op_t op, void *buf, size_t buf_size,
     HG_CHECK_ERROR(buf_size < sizeof(struct hg_core_header_request), done, ret,
         HG_INVALID_ARG, "Invalid buffer size");
 
-#ifdef HG_HAS_CHECKSUMS
-    /* Reset header checksum first */
-    if (hg_core_header->checksum != MCHECKSUM_OBJECT_NULL)
-        mchecksum_reset(hg_core_header->checksum);
-#endif
-
     /* HG byte */
-    HG_CORE_HEADER_PROC(hg_core_header, buf_ptr, header->hg, hg_uint8_t, op);
+    HG_CORE_HEADER_PROC_TYPE(buf_ptr, header->hg, hg_uint8_t, op);
 
     /* Protocol */
-    HG_CORE_HEADER_PROC(
-        hg_core_header, buf_ptr, header->protocol, hg_uint8_t, op);
+    HG_CORE_HEADER_PROC_TYPE(buf_ptr, header->protocol, hg_uint8_t, op);
 
     /* RPC ID */
-    HG_CORE_HEADER_PROC(hg_core_header, buf_ptr, header->id, hg_uint64_t, op);
+    HG_CORE_HEADER_PROC_TYPE(buf_ptr, header->id, hg_uint64_t, op);
 
     /* Flags */
-    HG_CORE_HEADER_PROC(hg_core_header, buf_ptr, header->flags, hg_uint8_t, op);
+    HG_CORE_HEADER_PROC_TYPE(buf_ptr, header->flags, hg_uint8_t, op);
 
     /* Cookie */
-    HG_CORE_HEADER_PROC(
-        hg_core_header, buf_ptr, header->cookie, hg_uint8_t, op);
+    HG_CORE_HEADER_PROC_TYPE(buf_ptr, header->cookie, hg_uint8_t, op);
 
 #ifdef HG_HAS_CHECKSUMS
-    if (hg_core_header->checksum != MCHECKSUM_OBJECT_NULL) {
+    if (hg_core_header->use_checksum) {
         /* Checksum of header */
-        mchecksum_get(hg_core_header->checksum, &header->hash.header,
-            sizeof(hg_uint16_t), MCHECKSUM_FINALIZE);
+        header->hash.header = HG_CORE_HEADER_CHECKSUM(buf, buf_ptr);
 
         if (op == HG_ENCODE) {
             HG_CORE_HEADER_PROC_TYPE(
@@ -245,28 +199,19 @@ hg_core_header_response_proc(hg_proc_op_t op, void *buf, size_t buf_size,
     HG_CHECK_ERROR(buf_size < sizeof(struct hg_core_header_response), done, ret,
         HG_OVERFLOW, "Invalid buffer size");
 
-#ifdef HG_HAS_CHECKSUMS
-    /* Reset header checksum first */
-    if (hg_core_header->checksum != MCHECKSUM_OBJECT_NULL)
-        mchecksum_reset(hg_core_header->checksum);
-#endif
-
     /* Return code */
-    HG_CORE_HEADER_PROC(
-        hg_core_header, buf_ptr, header->ret_code, hg_int8_t, op);
+    HG_CORE_HEADER_PROC_TYPE(buf_ptr, header->ret_code, hg_int8_t, op);
 
     /* Flags */
-    HG_CORE_HEADER_PROC(hg_core_header, buf_ptr, header->flags, hg_uint8_t, op);
+    HG_CORE_HEADER_PROC_TYPE(buf_ptr, header->flags, hg_uint8_t, op);
 
     /* Cookie */
-    HG_CORE_HEADER_PROC(
-        hg_core_header, buf_ptr, header->cookie, hg_uint16_t, op);
+    HG_CORE_HEADER_PROC_TYPE(buf_ptr, header->cookie, hg_uint16_t, op);
 
 #ifdef HG_HAS_CHECKSUMS
-    if (hg_core_header->checksum != MCHECKSUM_OBJECT_NULL) {
+    if (hg_core_header->use_checksum) {
         /* Checksum of header */
-        mchecksum_get(hg_core_header->checksum, &header->hash.header,
-            sizeof(hg_uint16_t), MCHECKSUM_FINALIZE);
+        header->hash.header = HG_CORE_HEADER_CHECKSUM(buf, buf_ptr);
 
         if (op == HG_ENCODE) {
             HG_CORE_HEADER_PROC_TYPE(
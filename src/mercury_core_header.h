@@ -63,7 +63,7 @@ struct hg_core_header {
         struct hg_core_header_response response;
     } msg;
 #ifdef HG_HAS_CHECKSUMS
-    struct mchecksum_object *checksum; /* Checksum of header */
+    hg_bool_t use_checksum; /* Checksum header */
 #endif
 };
 
@@ -89,7 +89,7 @@ struct hg_core_header {
 #define HG_CORE_IDENTIFIER (('H' << 1) | ('G')) /* 0xD7 */
 
 /* Mercury protocol version number */
-#define HG_CORE_PROTOCOL_VERSION 0x05
+#define HG_CORE_PROTOCOL_VERSION 0x07
 
 /*********************/
 /* Public Prototypes */
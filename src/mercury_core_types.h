@@ -84,6 +84,106 @@ struct hg_init_info {
     /* (Debug) Print stats at exit.
      * Default is: false */
     hg_bool_t stats;
+
+    /* Controls the initial number of entries of the completion queue that is
+     * allocated on context creation (rounded up to a power of 2). The queue
+     * grows by adding larger segments when that number is exceeded.
+     * A value of zero is equivalent to using the internal default value.
+     * Default value is: 1024 */
+    hg_uint32_t completion_queue_size;
+
+    /* Enables caching of the memory registrations made by HG_Bulk_create()
+     * and sets the maximum number of bytes that can remain registered. When
+     * enabled, registrations are kept after HG_Bulk_free() and re-used by
+     * subsequent HG_Bulk_create() calls on the same buffer, least recently
+     * used registrations are released first when that limit is exceeded.
+     * Memory that was used to create bulk handles must then be passed to
+     * HG_Bulk_cache_invalidate() before it is freed or unmapped.
+     * Default value is: 0 (disabled) */
+    hg_size_t bulk_cache_size;
+
+    /* Controls the number of NA contexts (rails) that each HG context
+     * aggregates on the default NA class. Each rail has its own pre-posted
+     * requests, RPCs are spread across rails by target address, large bulk
+     * transfers are striped across rails in round-robin and progress is made
+     * on all rails. Rail r of context ID c uses NA context ID
+     * (c * na_rail_count + r), peers must therefore use the same value and
+     * the NA class must support enough contexts (see max_contexts).
+     * A value of zero is equivalent to 1.
+     * Default value is: 1 */
+    hg_uint8_t na_rail_count;
+
+    /* Controls whether the number of posted requests adapts to the load
+     * observed on each context. request_post_init is then used as a floor and
+     * request_post_incr as the increment (internal default if zero). More
+     * requests are posted before posted requests run out, requests in excess
+     * of twice the peak number of requests in use are released after a period
+     * of lower activity. See HG_Context_get_post_stats().
+     * Default is: false */
+    hg_bool_t request_post_adaptive;
+
+    /* Controls whether the buffers of requests posted by all the contexts of
+     * a class are drawn from a single pool instead of being allocated for
+     * each request. Output buffers are then only attached to requests while
+     * they are processed, so that memory follows the number of requests in
+     * flight. Each context keeps request_post_init requests as a reserve, use
+     * request_post_adaptive to return other buffers to the pool when idle.
+     * This option has no effect with NA plugins that register message
+     * buffers themselves.
+     * Default is: false */
+    hg_bool_t request_buf_shared;
+
+    /* Controls whether the memory that HG_Bulk_create() allocates when no
+     * buffers are passed is obtained from NA_Mem_alloc() (from the NA SM
+     * class when auto_sm is set) rather than from the heap. With NA SM, each
+     * bulk handle is then backed by its own shared-memory object, which local
+     * peers map and copy without cross-memory attach.
+     * Default is: false */
+    hg_bool_t bulk_alloc_na;
+
+    /* Controls the maximum number of completions that are dequeued at once
+     * and then triggered by HG_Trigger() and HG_Trigger_batch(), as well as
+     * the number of NA callbacks triggered at once when making progress.
+     * A value of zero is equivalent to using the internal default value,
+     * values above 256 are reduced to 256.
+     * Default value is: 32 */
+    hg_uint32_t trigger_batch_size;
+
+    /* Controls the maximum number of events that are retrieved from the poll
+     * set of a context by a single blocking wait when making progress.
+     * A value of zero is equivalent to using the internal default value.
+     * Default value is: 16 */
+    hg_uint32_t poll_event_count;
+
+    /* Controls the adaptive progress budget (in microseconds). When non-zero
+     * and progress is not NA_NO_BLOCK, blocking progress on a context first
+     * busy-polls for that amount of time, then keeps polling with exponential
+     * backoff for the same amount of time, and only then waits on the poll
+     * set of the context.
+     * Default is: 0 (disabled) */
+    hg_uint32_t progress_spin_us;
+};
+
+/* Progress statistics, each count is the number of times a blocking progress
+ * call was resolved in the corresponding phase (spin and backoff phases are
+ * only used when progress_spin_us is set) */
+struct hg_progress_stats {
+    hg_uint64_t spin_count;    /* Resolved while busy-polling */
+    hg_uint64_t backoff_count; /* Resolved while polling with backoff */
+    hg_uint64_t poll_count;    /* Resolved after waiting on the poll set */
+};
+
+/* Statistics of requests posted for incoming RPCs (sizes are only adjusted
+ * when request_post_adaptive is set) */
+struct hg_post_stats {
+    hg_uint64_t recv_count;   /* Requests received */
+    hg_uint64_t grow_count;   /* Requests posted in addition to initial ones */
+    hg_uint64_t shrink_count; /* Requests released */
+    hg_uint32_t posted_count; /* Requests currently posted */
+    hg_uint32_t total_count;  /* Requests currently posted or in use */
+    hg_uint32_t target_count; /* Number of requests kept after shrinking */
+    hg_uint32_t floor_count;  /* Initial requests, never released */
+    double recv_rate;         /* Requests/s received during last period */
 };
 
 /* Error return codes:
@@ -166,7 +266,8 @@ typedef enum {
 #define HG_INIT_INFO_INITIALIZER                                               \
     {                                                                          \
         NA_INIT_INFO_INITIALIZER, NULL, 0, 0, HG_FALSE, NULL,                  \
-            HG_CHECKSUM_NONE, HG_FALSE, HG_FALSE, HG_FALSE                     \
+            HG_CHECKSUM_NONE, HG_FALSE, HG_FALSE, HG_FALSE, 0, 0, 0,           \
+            HG_FALSE, HG_FALSE, HG_FALSE, 0, 0, 0                              \
     }
 
 #endif /* MERCURY_CORE_TYPES_H */
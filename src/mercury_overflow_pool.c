@@ -0,0 +1,256 @@
+/**
+ * Copyright (c) 2013-2021 UChicago Argonne, LLC and The HDF Group.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "mercury_overflow_pool.h"
+#include "mercury_bulk.h"
+#include "mercury_error.h"
+
+#include "mercury_mem_pool.h"
+#include "mercury_thread_spin.h"
+
+#include <stdlib.h>
+
+/****************/
+/* Local Macros */
+/****************/
+
+/* Number of size classes */
+#define HG_OVERFLOW_POOL_CLASSES (4)
+
+/* Smallest size class, each following class is 4 times larger */
+#define HG_OVERFLOW_POOL_SIZE_MIN   (8192)
+#define HG_OVERFLOW_POOL_SIZE_SHIFT (2)
+
+/* Number of buffers per registered block for the smallest size class, each
+ * following class has half as many buffers */
+#define HG_OVERFLOW_POOL_COUNT_MAX (16)
+
+/* Sets of size classes, one per access mode */
+#define HG_OVERFLOW_POOL_SRC  (0) /* Read-only, exposed to peers */
+#define HG_OVERFLOW_POOL_DST  (1) /* Write-only, local pull destination */
+#define HG_OVERFLOW_POOL_SETS (2)
+
+/************************************/
+/* Local Type and Struct Definition */
+/************************************/
+
+/* Set of size classes registered with the same access mode */
+struct hg_overflow_pool_set {
+    hg_class_t *hg_class; /* HG class used for registration */
+    hg_uint8_t flags;     /* Bulk permission flags of blocks */
+    struct hg_mem_pool
+        *mem_pools[HG_OVERFLOW_POOL_CLASSES]; /* Size class memory pools */
+};
+
+/* Overflow pool */
+struct hg_overflow_pool {
+    struct hg_overflow_pool_set sets[HG_OVERFLOW_POOL_SETS]; /* Sets */
+    hg_thread_spin_t lock; /* Lock for pool creation */
+};
+
+/********************/
+/* Local Prototypes */
+/********************/
+
+/**
+ * Register memory block.
+ */
+static int
+hg_overflow_pool_register(
+    const void *buf, size_t size, void **handle, void *arg);
+
+/**
+ * Deregister memory block.
+ */
+static int
+hg_overflow_pool_deregister(void *handle, void *arg);
+
+/**
+ * Get memory pool of size class, create it if needed.
+ */
+static struct hg_mem_pool *
+hg_overflow_pool_get(struct hg_overflow_pool *hg_overflow_pool,
+    struct hg_overflow_pool_set *set, unsigned int i);
+
+/*******************/
+/* Local Variables */
+/*******************/
+
+/*---------------------------------------------------------------------------*/
+static int
+hg_overflow_pool_register(
+    const void *buf, size_t size, void **handle, void *arg)
+{
+    struct hg_overflow_pool_set *set = (struct hg_overflow_pool_set *) arg;
+    union {
+        const void *const_ptr;
+        void *ptr;
+    } buf_ptr = {.const_ptr = buf};
+    hg_size_t buf_size = (hg_size_t) size;
+    hg_bulk_t bulk = HG_BULK_NULL;
+    hg_return_t ret;
+
+    /* The handle of the whole block is sent to peers, only give them the
+     * access they need */
+    ret = HG_Bulk_create(
+        set->hg_class, 1, &buf_ptr.ptr, &buf_size, set->flags, &bulk);
+    HG_CHECK_HG_ERROR(error, ret, "Could not register overflow pool block");
+
+    *handle = (void *) bulk;
+
+    return HG_UTIL_SUCCESS;
+
+error:
+    return HG_UTIL_FAIL;
+}
+
+/*---------------------------------------------------------------------------*/
+static int
+hg_overflow_pool_deregister(void *handle, void *arg)
+{
+    hg_return_t ret;
+
+    (void) arg;
+
+    ret = HG_Bulk_free((hg_bulk_t) handle);
+    HG_CHECK_HG_ERROR(error, ret, "Could not free overflow pool block");
+
+    return HG_UTIL_SUCCESS;
+
+error:
+    return HG_UTIL_FAIL;
+}
+
+/*---------------------------------------------------------------------------*/
+static struct hg_mem_pool *
+hg_overflow_pool_get(struct hg_overflow_pool *hg_overflow_pool,
+    struct hg_overflow_pool_set *set, unsigned int i)
+{
+    struct hg_mem_pool *mem_pool;
+
+    hg_thread_spin_lock(&hg_overflow_pool->lock);
+    mem_pool = set->mem_pools[i];
+    hg_thread_spin_unlock(&hg_overflow_pool->lock);
+    if (mem_pool)
+        return mem_pool;
+
+    /* Create and register outside of lock, only keep first one created */
+    mem_pool = hg_mem_pool_create(
+        (size_t) HG_OVERFLOW_POOL_SIZE_MIN
+            << (i * HG_OVERFLOW_POOL_SIZE_SHIFT),
+        (size_t) HG_OVERFLOW_POOL_COUNT_MAX >> i, 1, hg_overflow_pool_register,
+        hg_overflow_pool_deregister, set);
+    HG_CHECK_ERROR_NORET(
+        mem_pool == NULL, done, "Could not create overflow memory pool");
+
+    hg_thread_spin_lock(&hg_overflow_pool->lock);
+    if (set->mem_pools[i] == NULL) {
+        set->mem_pools[i] = mem_pool;
+        hg_thread_spin_unlock(&hg_overflow_pool->lock);
+    } else {
+        struct hg_mem_pool *tmp = mem_pool;
+
+        mem_pool = set->mem_pools[i];
+        hg_thread_spin_unlock(&hg_overflow_pool->lock);
+        hg_mem_pool_destroy(tmp);
+    }
+
+done:
+    return mem_pool;
+}
+
+/*---------------------------------------------------------------------------*/
+struct hg_overflow_pool *
+hg_overflow_pool_create(hg_class_t *hg_class)
+{
+    struct hg_overflow_pool *hg_overflow_pool;
+
+    hg_overflow_pool =
+        (struct hg_overflow_pool *) calloc(1, sizeof(*hg_overflow_pool));
+    HG_CHECK_ERROR_NORET(
+        hg_overflow_pool == NULL, done, "Could not allocate overflow pool");
+
+    hg_overflow_pool->sets[HG_OVERFLOW_POOL_SRC].hg_class = hg_class;
+    hg_overflow_pool->sets[HG_OVERFLOW_POOL_SRC].flags = HG_BULK_READ_ONLY;
+    hg_overflow_pool->sets[HG_OVERFLOW_POOL_DST].hg_class = hg_class;
+    hg_overflow_pool->sets[HG_OVERFLOW_POOL_DST].flags = HG_BULK_WRITE_ONLY;
+    hg_thread_spin_init(&hg_overflow_pool->lock);
+
+done:
+    return hg_overflow_pool;
+}
+
+/*---------------------------------------------------------------------------*/
+void
+hg_overflow_pool_destroy(struct hg_overflow_pool *hg_overflow_pool)
+{
+    unsigned int i, j;
+
+    if (hg_overflow_pool == NULL)
+        return;
+
+    for (i = 0; i < HG_OVERFLOW_POOL_SETS; i++)
+        for (j = 0; j < HG_OVERFLOW_POOL_CLASSES; j++)
+            if (hg_overflow_pool->sets[i].mem_pools[j])
+                hg_mem_pool_destroy(hg_overflow_pool->sets[i].mem_pools[j]);
+
+    hg_thread_spin_destroy(&hg_overflow_pool->lock);
+    free(hg_overflow_pool);
+}
+
+/*---------------------------------------------------------------------------*/
+void *
+hg_overflow_pool_alloc(struct hg_overflow_pool *hg_overflow_pool,
+    hg_size_t size, hg_uint8_t flags, hg_size_t *alloc_size,
+    struct hg_mem_pool **mem_pool, hg_bulk_t *bulk)
+{
+    struct hg_overflow_pool_set *set =
+        &hg_overflow_pool->sets[(flags == HG_BULK_READ_ONLY)
+                                    ? HG_OVERFLOW_POOL_SRC
+                                    : HG_OVERFLOW_POOL_DST];
+    hg_size_t class_size = HG_OVERFLOW_POOL_SIZE_MIN;
+    struct hg_mem_pool *class_pool;
+    void *buf = NULL;
+    unsigned int i;
+
+    /* Find smallest size class that fits */
+    for (i = 0; i < HG_OVERFLOW_POOL_CLASSES; i++) {
+        if (size <= class_size)
+            break;
+        class_size <<= HG_OVERFLOW_POOL_SIZE_SHIFT;
+    }
+    if (i == HG_OVERFLOW_POOL_CLASSES)
+        goto done;
+
+    class_pool = hg_overflow_pool_get(hg_overflow_pool, set, i);
+    if (class_pool == NULL)
+        goto done;
+
+    buf = hg_mem_pool_alloc(class_pool, (size_t) class_size, (void **) bulk);
+    HG_CHECK_ERROR_NORET(
+        buf == NULL, done, "Could not allocate buffer from overflow pool");
+
+    *alloc_size = class_size;
+    *mem_pool = class_pool;
+
+done:
+    return buf;
+}
+
+/*---------------------------------------------------------------------------*/
+void
+hg_overflow_pool_free(struct hg_mem_pool *mem_pool, void *buf, hg_bulk_t bulk)
+{
+    hg_mem_pool_free(mem_pool, buf, (void *) bulk);
+}
+
+/*---------------------------------------------------------------------------*/
+hg_size_t
+hg_overflow_pool_offset(
+    struct hg_mem_pool *mem_pool, void *buf, hg_bulk_t bulk)
+{
+    return (hg_size_t) hg_mem_pool_chunk_offset(mem_pool, buf, (void *) bulk);
+}
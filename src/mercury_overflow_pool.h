@@ -0,0 +1,107 @@
+/**
+ * Copyright (c) 2013-2021 UChicago Argonne, LLC and The HDF Group.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef MERCURY_OVERFLOW_POOL_H
+#define MERCURY_OVERFLOW_POOL_H
+
+#include "mercury_types.h"
+
+/*************************************/
+/* Public Type and Struct Definition */
+/*************************************/
+
+struct hg_overflow_pool;
+struct hg_mem_pool;
+
+/*****************/
+/* Public Macros */
+/*****************/
+
+/*********************/
+/* Public Prototypes */
+/*********************/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Create a pool of pre-registered buffers used for payloads that exceed the
+ * eager size. Buffers are organized in size classes, each size class is
+ * backed by a hg_mem_pool that is only created on first use. Buffers that are
+ * pulled from by peers and buffers that are pulled into are taken from
+ * separate blocks, registered read-only and write-only respectively.
+ *
+ * \param hg_class [IN]         pointer to HG class
+ *
+ * \return Pointer to pool or NULL in case of failure
+ */
+HG_PRIVATE struct hg_overflow_pool *
+hg_overflow_pool_create(hg_class_t *hg_class);
+
+/**
+ * Destroy pool. All buffers must have been released.
+ *
+ * \param hg_overflow_pool [IN/OUT] pointer to pool
+ */
+HG_PRIVATE void
+hg_overflow_pool_destroy(struct hg_overflow_pool *hg_overflow_pool);
+
+/**
+ * Allocate a buffer of at least \size bytes from the smallest size class
+ * that fits. \alloc_size is set to the size of the buffer that was actually
+ * allocated. \mem_pool and \bulk must be passed to hg_overflow_pool_free()
+ * to release the buffer, \bulk is the bulk handle of the registered block
+ * the buffer belongs to and must not be freed.
+ *
+ * \remark \bulk gives access to the whole block, other buffers of a
+ * HG_BULK_READ_ONLY block can therefore be read by peers that the handle is
+ * sent to.
+ *
+ * \param hg_overflow_pool [IN/OUT] pointer to pool
+ * \param size [IN]                 requested size
+ * \param flags [IN]                HG_BULK_READ_ONLY for buffers that peers
+ *                                  pull from, HG_BULK_WRITE_ONLY for buffers
+ *                                  that are pulled into
+ * \param alloc_size [OUT]          allocated size
+ * \param mem_pool [OUT]            pointer to size class memory pool
+ * \param bulk [OUT]                pointer to bulk handle
+ *
+ * \return Pointer to buffer or NULL if \size exceeds the largest size class
+ */
+HG_PRIVATE void *
+hg_overflow_pool_alloc(struct hg_overflow_pool *hg_overflow_pool,
+    hg_size_t size, hg_uint8_t flags, hg_size_t *alloc_size,
+    struct hg_mem_pool **mem_pool, hg_bulk_t *bulk);
+
+/**
+ * Release buffer.
+ *
+ * \param mem_pool [IN/OUT]     pointer to size class memory pool
+ * \param buf [IN]              pointer to buffer
+ * \param bulk [IN]             bulk handle
+ */
+HG_PRIVATE void
+hg_overflow_pool_free(struct hg_mem_pool *mem_pool, void *buf, hg_bulk_t bulk);
+
+/**
+ * Retrieve offset of buffer within its bulk handle.
+ *
+ * \param mem_pool [IN/OUT]     pointer to size class memory pool
+ * \param buf [IN]              pointer to buffer
+ * \param bulk [IN]             bulk handle
+ *
+ * \return Offset
+ */
+HG_PRIVATE hg_size_t
+hg_overflow_pool_offset(
+    struct hg_mem_pool *mem_pool, void *buf, hg_bulk_t bulk);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MERCURY_OVERFLOW_POOL_H */
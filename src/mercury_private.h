@@ -37,6 +37,7 @@ struct hg_completion_entry {
 };
 
 struct hg_bulk_op_pool;
+struct hg_bulk_cache;
 
 /*****************/
 /* Public Macros */
@@ -62,12 +63,35 @@ hg_core_bulk_incr(hg_core_class_t *hg_core_class);
 HG_PRIVATE void
 hg_core_bulk_decr(hg_core_class_t *hg_core_class);
 
+/**
+ * Get bulk registration cache associated to NA class (NULL if disabled).
+ */
+HG_PRIVATE struct hg_bulk_cache *
+hg_core_class_get_bulk_cache(
+    hg_core_class_t *hg_core_class, na_class_t *na_class);
+
+/**
+ * Get NA class that internally allocated bulk memory is obtained from (NULL
+ * if that memory is allocated from the heap).
+ */
+HG_PRIVATE na_class_t *
+hg_core_class_get_bulk_alloc_na(hg_core_class_t *hg_core_class);
+
 /**
  * Get bulk op pool.
  */
 HG_PRIVATE struct hg_bulk_op_pool *
 hg_core_context_get_bulk_op_pool(struct hg_core_context *core_context);
 
+/**
+ * Get NA context (rail) of default NA class used to transfer size bytes to
+ * context ID *id_ptr of addr. *id_ptr is replaced by the NA context ID of the
+ * matching remote rail.
+ */
+HG_PRIVATE na_context_t *
+hg_core_context_get_na_rail(struct hg_core_context *core_context,
+    hg_core_addr_t addr, hg_size_t size, hg_uint8_t *id_ptr);
+
 /**
  * Add entry to completion queue.
  */
@@ -94,6 +118,19 @@ hg_bulk_op_pool_create(hg_core_context_t *core_context, unsigned int init_count,
 HG_PRIVATE hg_return_t
 hg_bulk_op_pool_destroy(struct hg_bulk_op_pool *hg_bulk_op_pool);
 
+/**
+ * Create cache of memory registrations.
+ */
+HG_PRIVATE hg_return_t
+hg_bulk_cache_create(na_class_t *na_class, hg_size_t max_size,
+    struct hg_bulk_cache **hg_bulk_cache_ptr);
+
+/**
+ * Destroy cache of memory registrations.
+ */
+HG_PRIVATE hg_return_t
+hg_bulk_cache_destroy(struct hg_bulk_cache *hg_bulk_cache);
+
 #ifdef __cplusplus
 }
 #endif
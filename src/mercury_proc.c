@@ -5,11 +5,13 @@
  */
 
 #include "mercury_proc.h"
+#include "mercury_bulk.h"
 #include "mercury_error.h"
 #include "mercury_mem.h"
+#include "mercury_overflow_pool.h"
 
 #ifdef HG_HAS_CHECKSUMS
-#    include <mchecksum.h>
+#    include "mercury_checksum.h"
 #endif
 #include <stdlib.h>
 
@@ -25,6 +27,20 @@
 /* Local Prototypes */
 /********************/
 
+/**
+ * Free extra buffer if owned by proc.
+ */
+static void
+hg_proc_free_extra_buf(struct hg_proc *hg_proc);
+
+#ifdef HG_HAS_CHECKSUMS
+/**
+ * Copy checksum value to hash buffer of checksum size.
+ */
+static void
+hg_proc_checksum_to_hash(const struct hg_proc *hg_proc, void *hash);
+#endif
+
 /*******************/
 /* Local Variables */
 /*******************/
@@ -34,9 +50,6 @@ hg_return_t
 hg_proc_create(hg_class_t *hg_class, hg_proc_hash_t hash, hg_proc_t *proc)
 {
     struct hg_proc *hg_proc = NULL;
-#ifdef HG_HAS_CHECKSUMS
-    const char *hash_method;
-#endif
     hg_return_t ret = HG_SUCCESS;
 
     HG_CHECK_ERROR(
@@ -50,32 +63,21 @@ hg_proc_create(hg_class_t *hg_class, hg_proc_hash_t hash, hg_proc_t *proc)
     hg_proc->hg_class = hg_class;
 
 #ifdef HG_HAS_CHECKSUMS
-    /* Map enum to string */
     switch (hash) {
         case HG_CRC16:
-            hash_method = "crc16";
+            hg_proc->checksum_size = sizeof(hg_uint16_t);
             break;
         case HG_CRC32:
-            hash_method = "crc32c";
+            hg_proc->checksum_size = sizeof(hg_uint32_t);
             break;
         case HG_CRC64:
-            hash_method = "crc64";
+            hg_proc->checksum_size = sizeof(hg_uint64_t);
             break;
         default:
-            hash_method = NULL;
+            hg_proc->checksum_size = 0;
             break;
     }
-
-    if (hash_method) {
-        int rc = mchecksum_init(hash_method, &hg_proc->checksum);
-        HG_CHECK_ERROR(rc != 0, error, ret, HG_CHECKSUM_ERROR,
-            "Could not initialize checksum");
-
-        hg_proc->checksum_size = mchecksum_get_size(hg_proc->checksum);
-        hg_proc->checksum_hash = (char *) malloc(hg_proc->checksum_size);
-        HG_CHECK_ERROR(hg_proc->checksum_hash == NULL, error, ret, HG_NOMEM,
-            "Could not allocate space for checksum hash");
-    }
+    hg_proc->hash = hash;
 #else
     (void) hash;
 #endif
@@ -88,13 +90,7 @@ hg_proc_create(hg_class_t *hg_class, hg_proc_hash_t hash, hg_proc_t *proc)
     return ret;
 
 error:
-    if (hg_proc) {
-#ifdef HG_HAS_CHECKSUMS
-        mchecksum_destroy(hg_proc->checksum);
-        free(hg_proc->checksum_hash);
-#endif
-        free(hg_proc);
-    }
+    free(hg_proc);
     return ret;
 }
 
@@ -133,14 +129,8 @@ hg_proc_free(hg_proc_t proc)
     if (!hg_proc)
         goto done;
 
-#ifdef HG_HAS_CHECKSUMS
-    mchecksum_destroy(hg_proc->checksum);
-    free(hg_proc->checksum_hash);
-#endif
-
     /* Free extra proc buffer if needed */
-    if (hg_proc->extra_buf.buf && hg_proc->extra_buf.is_mine)
-        hg_mem_aligned_free(hg_proc->extra_buf.buf);
+    hg_proc_free_extra_buf(hg_proc);
 
     /* Free proc */
     free(hg_proc);
@@ -192,10 +182,11 @@ hg_proc_reset(hg_proc_t proc, void *buf, hg_size_t buf_size, hg_proc_op_t op)
     hg_proc->proc_buf.size_left = hg_proc->proc_buf.size;
 
     /* Free extra proc buffer if needed */
-    if (hg_proc->extra_buf.buf && hg_proc->extra_buf.is_mine)
-        hg_mem_aligned_free(hg_proc->extra_buf.buf);
+    hg_proc_free_extra_buf(hg_proc);
     hg_proc->extra_buf.buf = NULL;
     hg_proc->extra_buf.size = 0;
+    hg_proc->extra_buf.mem_pool = NULL;
+    hg_proc->extra_buf.bulk = HG_BULK_NULL;
     hg_proc->extra_buf.buf_ptr = hg_proc->extra_buf.buf;
     hg_proc->extra_buf.size_left = hg_proc->extra_buf.size;
 
@@ -204,18 +195,27 @@ hg_proc_reset(hg_proc_t proc, void *buf, hg_size_t buf_size, hg_proc_op_t op)
 
 #ifdef HG_HAS_CHECKSUMS
     /* Reset checksum */
-    if (hg_proc->checksum != MCHECKSUM_OBJECT_NULL) {
-        int rc = mchecksum_reset(hg_proc->checksum);
-        HG_CHECK_ERROR(
-            rc != 0, done, ret, HG_CHECKSUM_ERROR, "Could not reset checksum");
-        memset(hg_proc->checksum_hash, 0, hg_proc->checksum_size);
-    }
+    hg_proc->checksum = 0;
 #endif
 
 done:
     return ret;
 }
 
+/*---------------------------------------------------------------------------*/
+static void
+hg_proc_free_extra_buf(struct hg_proc *hg_proc)
+{
+    if (!hg_proc->extra_buf.buf || !hg_proc->extra_buf.is_mine)
+        return;
+
+    if (hg_proc->extra_buf.mem_pool)
+        hg_overflow_pool_free(hg_proc->extra_buf.mem_pool,
+            hg_proc->extra_buf.buf, hg_proc->extra_buf.bulk);
+    else
+        hg_mem_aligned_free(hg_proc->extra_buf.buf);
+}
+
 /*---------------------------------------------------------------------------*/
 hg_return_t
 hg_proc_set_size(hg_proc_t proc, hg_size_t req_buf_size)
@@ -224,11 +224,12 @@ hg_proc_set_size(hg_proc_t proc, hg_size_t req_buf_size)
     hg_size_t new_buf_size;
     hg_size_t page_size = (hg_size_t) hg_mem_get_page_size();
     void *new_buf = NULL;
+    struct hg_mem_pool *new_mem_pool = NULL;
+    hg_bulk_t new_bulk = HG_BULK_NULL;
     ptrdiff_t current_pos;
-    hg_bool_t allocated = HG_FALSE;
     hg_return_t ret = HG_SUCCESS;
 
-    HG_CHECK_ERROR(proc == HG_PROC_NULL, error, ret, HG_INVALID_ARG,
+    HG_CHECK_ERROR(proc == HG_PROC_NULL, done, ret, HG_INVALID_ARG,
         "Proc is not initialized");
 
     /* Save current position */
@@ -237,18 +238,22 @@ hg_proc_set_size(hg_proc_t proc, hg_size_t req_buf_size)
 
     /* Get one more page size buf */
     new_buf_size = ((hg_size_t) (req_buf_size / page_size) + 1) * page_size;
-    HG_CHECK_ERROR(new_buf_size <= hg_proc_get_size(proc), error, ret,
+    HG_CHECK_ERROR(new_buf_size <= hg_proc_get_size(proc), done, ret,
         HG_INVALID_ARG, "Buffer is already of the size requested");
 
-    /* If was not using extra buffer init extra buffer */
-    if (!hg_proc->extra_buf.buf) {
-        /* Allocate buffer */
-        new_buf = hg_mem_aligned_alloc(page_size, new_buf_size);
-        allocated = HG_TRUE;
-    } else
-        new_buf = realloc(hg_proc->extra_buf.buf, new_buf_size);
-    HG_CHECK_ERROR(new_buf == NULL, error, ret, HG_NOMEM,
-        "Could not allocate buffer of size %" PRIu64, new_buf_size);
+    /* Take buffer from overflow pool first, buffer is already registered */
+    if (hg_proc->overflow_pool && hg_proc->op == HG_ENCODE)
+        new_buf = hg_overflow_pool_alloc(hg_proc->overflow_pool, new_buf_size,
+            HG_BULK_READ_ONLY, &new_buf_size, &new_mem_pool, &new_bulk);
+
+    if (new_buf == NULL) {
+        if (hg_proc->extra_buf.buf && !hg_proc->extra_buf.mem_pool)
+            new_buf = realloc(hg_proc->extra_buf.buf, new_buf_size);
+        else
+            new_buf = hg_mem_aligned_alloc(page_size, new_buf_size);
+        HG_CHECK_ERROR(new_buf == NULL, done, ret, HG_NOMEM,
+            "Could not allocate buffer of size %" PRIu64, new_buf_size);
+    }
 
     if (!hg_proc->extra_buf.buf) {
         /* Copy proc_buf (should be small) */
@@ -256,6 +261,10 @@ hg_proc_set_size(hg_proc_t proc, hg_size_t req_buf_size)
 
         /* Switch buffer */
         hg_proc->current_buf = &hg_proc->extra_buf;
+    } else if (new_mem_pool || hg_proc->extra_buf.mem_pool) {
+        /* Buffer was not reallocated in place */
+        memcpy(new_buf, hg_proc->extra_buf.buf, (size_t) current_pos);
+        hg_proc_free_extra_buf(hg_proc);
     }
 
     hg_proc->extra_buf.buf = new_buf;
@@ -264,12 +273,10 @@ hg_proc_set_size(hg_proc_t proc, hg_size_t req_buf_size)
     hg_proc->extra_buf.size_left =
         hg_proc->extra_buf.size - (hg_size_t) current_pos;
     hg_proc->extra_buf.is_mine = HG_TRUE;
+    hg_proc->extra_buf.mem_pool = new_mem_pool;
+    hg_proc->extra_buf.bulk = new_bulk;
 
-    return ret;
-
-error:
-    if (new_buf && allocated)
-        hg_mem_aligned_free(new_buf);
+done:
     return ret;
 }
 
@@ -317,13 +324,9 @@ hg_proc_restore_ptr(hg_proc_t proc, void *data, hg_size_t data_size)
     HG_CHECK_ERROR_NORET(((struct hg_proc *) proc)->op == HG_FREE, done,
         "Cannot restore_ptr on HG_FREE");
 
-#ifdef HG_HAS_CHECKSUMS
-    hg_proc_checksum_update(proc, data, data_size);
-#else
-    /* Silent warning */
+    /* Data is checksummed along with the rest of the buffer on flush */
     (void) data;
     (void) data_size;
-#endif
 
 done:
     return ret;
@@ -347,6 +350,25 @@ done:
     return ret;
 }
 
+/*---------------------------------------------------------------------------*/
+void
+hg_proc_set_overflow_pool(
+    hg_proc_t proc, struct hg_overflow_pool *overflow_pool)
+{
+    ((struct hg_proc *) proc)->overflow_pool = overflow_pool;
+}
+
+/*---------------------------------------------------------------------------*/
+struct hg_mem_pool *
+hg_proc_get_extra_buf_pool(hg_proc_t proc, hg_bulk_t *bulk)
+{
+    struct hg_proc *hg_proc = (struct hg_proc *) proc;
+
+    *bulk = hg_proc->extra_buf.bulk;
+
+    return hg_proc->extra_buf.mem_pool;
+}
+
 /*---------------------------------------------------------------------------*/
 hg_return_t
 hg_proc_flush(hg_proc_t proc)
@@ -354,20 +376,20 @@ hg_proc_flush(hg_proc_t proc)
     hg_return_t ret;
 #ifdef HG_HAS_CHECKSUMS
     struct hg_proc *hg_proc = (struct hg_proc *) proc;
-    int rc;
 #endif
 
     HG_CHECK_ERROR(proc == HG_PROC_NULL, error, ret, HG_INVALID_ARG,
         "Proc is not initialized");
 
 #ifdef HG_HAS_CHECKSUMS
-    if (hg_proc->checksum == MCHECKSUM_OBJECT_NULL)
+    if (hg_proc->checksum_size == 0)
         return HG_SUCCESS;
 
-    rc = mchecksum_get(hg_proc->checksum, hg_proc->checksum_hash,
-        hg_proc->checksum_size, MCHECKSUM_FINALIZE);
-    HG_CHECK_ERROR(
-        rc != 0, error, ret, HG_CHECKSUM_ERROR, "Could not get checksum");
+    /* Checksum everything that was processed in one pass, current buffer
+     * always contains the entire encoded data */
+    hg_proc_checksum_update(proc, hg_proc->current_buf->buf,
+        (hg_size_t) ((char *) hg_proc->current_buf->buf_ptr -
+                     (char *) hg_proc->current_buf->buf));
 #endif
 
     return HG_SUCCESS;
@@ -376,23 +398,91 @@ error:
     return ret;
 }
 
+/*---------------------------------------------------------------------------*/
+hg_return_t
+hg_proc_hg_bytes_view_t(hg_proc_t proc, void *data)
+{
+    hg_bytes_view_t *view = (hg_bytes_view_t *) data;
+    hg_uint64_t size = 0;
+    hg_return_t ret = HG_SUCCESS;
+
+    switch (hg_proc_get_op(proc)) {
+        case HG_ENCODE:
+            size = (view->data) ? (hg_uint64_t) view->size : 0;
+            ret = hg_proc_uint64_t(proc, &size);
+            HG_CHECK_HG_ERROR(done, ret, "Could not encode view size");
+            if (size == 0)
+                break;
+            ret = hg_proc_bytes(proc, view->data, size);
+            HG_CHECK_HG_ERROR(done, ret, "Could not encode view data");
+            break;
+        case HG_DECODE:
+            ret = hg_proc_uint64_t(proc, &size);
+            HG_CHECK_HG_ERROR(done, ret, "Could not decode view size");
+            view->size = (hg_size_t) size;
+            if (size == 0) {
+                view->data = NULL;
+                break;
+            }
+#ifndef HG_HAS_XDR
+            if (hg_proc_get_flags(proc) & HG_PROC_ZERO_COPY) {
+                /* Point directly into the proc buffer */
+                HG_CHECK_ERROR(hg_proc_get_size_left(proc) < size, done, ret,
+                    HG_OVERFLOW, "View size exceeds proc buffer size left");
+                view->data = hg_proc_save_ptr(proc, size);
+                ret = hg_proc_restore_ptr(proc, view->data, size);
+                break;
+            }
+#endif
+            view->data = malloc((size_t) size);
+            HG_CHECK_ERROR(view->data == NULL, done, ret, HG_NOMEM,
+                "Could not allocate view data of size %" PRIu64, size);
+            ret = hg_proc_bytes(proc, view->data, size);
+            if (ret != HG_SUCCESS) {
+                free(view->data);
+                view->data = NULL;
+                goto done;
+            }
+            break;
+        case HG_FREE:
+            if (!(hg_proc_get_flags(proc) & HG_PROC_ZERO_COPY))
+                free(view->data);
+            view->data = NULL;
+            view->size = 0;
+            break;
+        default:
+            break;
+    }
+
+done:
+    return ret;
+}
+
 /*---------------------------------------------------------------------------*/
 #ifdef HG_HAS_CHECKSUMS
 void
 hg_proc_checksum_update(hg_proc_t proc, void *data, hg_size_t data_size)
 {
     struct hg_proc *hg_proc = (struct hg_proc *) proc;
-    int rc;
-
-    if (hg_proc->checksum == MCHECKSUM_OBJECT_NULL)
-        return;
 
     /* Update checksum */
-    rc = mchecksum_update(((struct hg_proc *) proc)->checksum, data, data_size);
-    HG_CHECK_ERROR_NORET(rc != 0, done, "Could not update checksum");
-
-done:
-    return;
+    switch (hg_proc->hash) {
+        case HG_CRC16:
+            hg_proc->checksum = hg_checksum_crc16(
+                (hg_uint16_t) hg_proc->checksum, data, (size_t) data_size);
+            break;
+        case HG_CRC32:
+            hg_proc->checksum = hg_checksum_crc32c(
+                (hg_uint32_t) hg_proc->checksum, data, (size_t) data_size);
+            break;
+        case HG_CRC64:
+            hg_proc->checksum =
+                hg_checksum_crc64(hg_proc->checksum, data, (size_t) data_size);
+            break;
+        case HG_NOHASH:
+        default:
+            break;
+    }
 }
 
 /*---------------------------------------------------------------------------*/
@@ -406,12 +496,12 @@ hg_proc_checksum_get(hg_proc_t proc, void *hash, hg_size_t hash_size)
         "Proc is not initialized");
     HG_CHECK_ERROR(
         hash == NULL, done, ret, HG_INVALID_ARG, "NULL hash pointer");
-    HG_CHECK_ERROR(hg_proc->checksum_hash == NULL, done, ret, HG_INVALID_ARG,
+    HG_CHECK_ERROR(hg_proc->checksum_size == 0, done, ret, HG_INVALID_ARG,
         "Proc has no checksum hash");
     HG_CHECK_ERROR(hash_size < hg_proc->checksum_size, done, ret,
         HG_INVALID_ARG, "Hash size passed is too small");
 
-    memcpy(hash, hg_proc->checksum_hash, hg_proc->checksum_size);
+    hg_proc_checksum_to_hash(hg_proc, hash);
 
 done:
     return ret;
@@ -422,34 +512,32 @@ hg_return_t
 hg_proc_checksum_verify(hg_proc_t proc, const void *hash, hg_size_t hash_size)
 {
     struct hg_proc *hg_proc = (struct hg_proc *) proc;
+    hg_uint64_t checksum_hash = 0, expected_hash = 0;
     hg_return_t ret = HG_SUCCESS;
 
     HG_CHECK_ERROR(proc == HG_PROC_NULL, done, ret, HG_INVALID_ARG,
         "Proc is not initialized");
     HG_CHECK_ERROR(
         hash == NULL, done, ret, HG_INVALID_ARG, "NULL hash pointer");
-    HG_CHECK_ERROR(hg_proc->checksum_hash == NULL, done, ret, HG_INVALID_ARG,
+    HG_CHECK_ERROR(hg_proc->checksum_size == 0, done, ret, HG_INVALID_ARG,
         "Proc has no checksum hash");
     HG_CHECK_ERROR(hash_size < hg_proc->checksum_size, done, ret,
         HG_INVALID_ARG, "Hash size passed is too small");
 
     /* Verify checksums */
-    if (memcmp(hash, hg_proc->checksum_hash, hg_proc->checksum_size) != 0) {
+    hg_proc_checksum_to_hash(hg_proc, &checksum_hash);
+    memcpy(&expected_hash, hash, hg_proc->checksum_size);
+    if (checksum_hash != expected_hash) {
         if (hg_proc->checksum_size == sizeof(hg_uint16_t))
             HG_LOG_ERROR("checksum 0x%04X does not match (expected 0x%04X!)",
-                *(hg_uint16_t *) hg_proc->checksum_hash,
-                *(const hg_uint16_t *) hash);
+                (hg_uint16_t) hg_proc->checksum, *(const hg_uint16_t *) hash);
         else if (hg_proc->checksum_size == sizeof(hg_uint32_t))
             HG_LOG_ERROR("checksum 0x%08X does not match (expected 0x%08X!)",
-                *(hg_uint32_t *) hg_proc->checksum_hash,
-                *(const hg_uint32_t *) hash);
-        else if (hg_proc->checksum_size == sizeof(hg_uint64_t))
+                (hg_uint32_t) hg_proc->checksum, *(const hg_uint32_t *) hash);
+        else
             HG_LOG_ERROR("checksum 0x%016" PRIx64
                          " does not match (expected 0x%016" PRIx64 "!)",
-                *(hg_uint64_t *) hg_proc->checksum_hash,
-                *(const hg_uint64_t *) hash);
-        else
-            HG_LOG_ERROR("Checksums do not match (unknown size?)");
+                hg_proc->checksum, *(const hg_uint64_t *) hash);
         ret = HG_CHECKSUM_ERROR;
         goto done;
     }
@@ -457,4 +545,28 @@ hg_proc_checksum_verify(hg_proc_t proc, const void *hash, hg_size_t hash_size)
 done:
     return ret;
 }
+
+/*---------------------------------------------------------------------------*/
+static void
+hg_proc_checksum_to_hash(const struct hg_proc *hg_proc, void *hash)
+{
+    hg_uint16_t hash16;
+    hg_uint32_t hash32;
+
+    switch (hg_proc->checksum_size) {
+        case sizeof(hg_uint16_t):
+            hash16 = (hg_uint16_t) hg_proc->checksum;
+            memcpy(hash, &hash16, sizeof(hash16));
+            break;
+        case sizeof(hg_uint32_t):
+            hash32 = (hg_uint32_t) hg_proc->checksum;
+            memcpy(hash, &hash32, sizeof(hash32));
+            break;
+        case sizeof(hg_uint64_t):
+            memcpy(hash, &hg_proc->checksum, sizeof(hg_proc->checksum));
+            break;
+        default:
+            break;
+    }
+}
 #endif
@@ -40,6 +40,20 @@
  */
 typedef enum { HG_CRC16, HG_CRC32, HG_CRC64, HG_NOHASH } hg_proc_hash_t;
 
+/**
+ * View on a stream of bytes. When decoded with the HG_PROC_ZERO_COPY flag
+ * set, data points directly into the proc buffer and is only valid as long
+ * as that buffer is (e.g., until HG_Free_input_view() is called).
+ */
+typedef struct hg_bytes_view {
+    void *data;     /* Pointer to data */
+    hg_size_t size; /* Data size */
+} hg_bytes_view_t;
+
+/* Pool of pre-registered overflow buffers (see mercury_overflow_pool.h) */
+struct hg_overflow_pool;
+struct hg_mem_pool;
+
 /*****************/
 /* Public Macros */
 /*****************/
@@ -56,6 +70,7 @@ typedef enum { HG_CRC16, HG_CRC32, HG_CRC64, HG_NOHASH } hg_proc_hash_t;
  */
 #define HG_PROC_SM         (1 << 0)
 #define HG_PROC_BULK_EAGER (1 << 1)
+#define HG_PROC_ZERO_COPY  (1 << 2) /* Decode bytes/strings in place */
 
 /* Branch predictor hints */
 #ifndef _WIN32
@@ -112,14 +127,6 @@ typedef enum { HG_CRC16, HG_CRC32, HG_CRC64, HG_NOHASH } hg_proc_hash_t;
         ((struct hg_proc *) proc)->current_buf->size_left -= size;             \
     } while (0)
 
-/* Update checksum */
-#ifdef HG_HAS_CHECKSUMS
-#    define HG_PROC_CHECKSUM_UPDATE(proc, data, size)                          \
-        hg_proc_checksum_update(proc, data, size)
-#else
-#    define HG_PROC_CHECKSUM_UPDATE(proc, data, size)
-#endif
-
 /* Base proc function */
 #ifdef HG_HAS_XDR
 #    define HG_PROC_TYPE(proc, type, data, label, ret)                         \
@@ -132,7 +139,6 @@ typedef enum { HG_CRC16, HG_CRC32, HG_CRC64, HG_NOHASH } hg_proc_hash_t;
             }                                                                  \
                                                                                \
             HG_PROC_UPDATE(proc, sizeof(type));                                \
-            HG_PROC_CHECKSUM_UPDATE(proc, data, sizeof(type));                 \
         } while (0)
 #else
 #    define HG_PROC_TYPE(proc, type, data, label, ret)                         \
@@ -153,7 +159,6 @@ typedef enum { HG_CRC16, HG_CRC32, HG_CRC64, HG_NOHASH } hg_proc_hash_t;
                                                                                \
             /* Update proc pointers etc */                                     \
             HG_PROC_UPDATE(proc, sizeof(type));                                \
-            HG_PROC_CHECKSUM_UPDATE(proc, data, sizeof(type));                 \
         } while (0)
 #endif
 
@@ -170,7 +175,6 @@ typedef enum { HG_CRC16, HG_CRC32, HG_CRC64, HG_NOHASH } hg_proc_hash_t;
             }                                                                  \
                                                                                \
             HG_PROC_UPDATE(proc, size);                                        \
-            HG_PROC_CHECKSUM_UPDATE(proc, data, size);                         \
         } while (0)
 #else
 #    define HG_PROC_BYTES(proc, data, size, label, ret)                        \
@@ -191,7 +195,6 @@ typedef enum { HG_CRC16, HG_CRC32, HG_CRC64, HG_NOHASH } hg_proc_hash_t;
                                                                                \
             /* Update proc pointers etc */                                     \
             HG_PROC_UPDATE(proc, size);                                        \
-            HG_PROC_CHECKSUM_UPDATE(proc, data, size);                         \
         } while (0)
 #endif
 
@@ -410,9 +413,33 @@ hg_proc_get_extra_size(hg_proc_t proc);
 HG_PUBLIC hg_return_t
 hg_proc_set_extra_buf_is_mine(hg_proc_t proc, hg_bool_t mine);
 
+/**
+ * Attach a pool of pre-registered buffers that is used in place of malloc()
+ * when the processor needs to allocate an extra buffer for encoding.
+ *
+ * \param proc [IN/OUT]         abstract processor object
+ * \param overflow_pool [IN]    pointer to overflow pool
+ */
+HG_PRIVATE void
+hg_proc_set_overflow_pool(
+    hg_proc_t proc, struct hg_overflow_pool *overflow_pool);
+
+/**
+ * Get the memory pool and bulk handle that the extra buffer was allocated
+ * from. The bulk handle is owned by the pool and must not be freed.
+ *
+ * \param proc [IN]             abstract processor object
+ * \param bulk [OUT]            pointer to bulk handle
+ *
+ * \return Pointer to memory pool or NULL if extra buffer is not pooled
+ */
+HG_PRIVATE struct hg_mem_pool *
+hg_proc_get_extra_buf_pool(hg_proc_t proc, hg_bulk_t *bulk);
+
 /**
  * Flush the proc after data has been encoded or decoded and finalize
  * internal checksum if checksum of data processed was initially requested.
+ * The checksum is computed in a single pass over the encoded data.
  *
  * \param proc [IN]             abstract processor object
  *
@@ -554,6 +581,19 @@ hg_proc_hg_uint64_t(hg_proc_t proc, void *data);
 static HG_INLINE hg_return_t
 hg_proc_bytes(hg_proc_t proc, void *data, hg_size_t data_size);
 
+/**
+ * Generic processing routine for byte views. Encodes the view size followed
+ * by the bytes it points to. On decode, data is either pointed directly into
+ * the proc buffer if HG_PROC_ZERO_COPY is set, or allocated and copied.
+ *
+ * \param proc [IN/OUT]         abstract processor object
+ * \param data [IN/OUT]         pointer to hg_bytes_view_t
+ *
+ * \return HG_SUCCESS or corresponding HG error code
+ */
+HG_PUBLIC hg_return_t
+hg_proc_hg_bytes_view_t(hg_proc_t proc, void *data);
+
 /**
  * For convenience map stdint types to hg types
  */
@@ -593,6 +633,8 @@ struct hg_proc_buf {
     hg_size_t size;      /* Total buffer size */
     hg_size_t size_left; /* Available size for user */
     hg_bool_t is_mine;
+    struct hg_mem_pool *mem_pool; /* Overflow pool buffer was taken from */
+    hg_bulk_t bulk;               /* Bulk handle of overflow pool buffer */
 #ifdef HG_HAS_XDR
     XDR xdr;
 #endif
@@ -604,10 +646,11 @@ struct hg_proc {
     struct hg_proc_buf extra_buf;
     hg_class_t *hg_class; /* HG class */
     struct hg_proc_buf *current_buf;
+    struct hg_overflow_pool *overflow_pool; /* Overflow pool (optional) */
 #ifdef HG_HAS_CHECKSUMS
-    struct mchecksum_object *checksum; /* Checksum */
-    void *checksum_hash;               /* Base checksum buf */
-    size_t checksum_size;              /* Checksum size */
+    hg_uint64_t checksum;  /* Checksum */
+    size_t checksum_size;  /* Checksum size (0 if no checksum) */
+    hg_proc_hash_t hash;   /* Hash method */
 #endif
     hg_proc_op_t op;
     hg_uint8_t flags;
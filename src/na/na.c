@@ -957,6 +957,56 @@ done:
     return ret;
 }
 
+/*---------------------------------------------------------------------------*/
+void *
+NA_Mem_alloc(na_class_t *na_class, size_t size)
+{
+    void *ret = NULL;
+
+    NA_CHECK_SUBSYS_ERROR_NORET(mem, na_class == NULL, done, "NULL NA class");
+    NA_CHECK_SUBSYS_ERROR_NORET(mem, size == 0, done, "NULL buffer size");
+
+    NA_CHECK_SUBSYS_ERROR_NORET(
+        mem, na_class->ops == NULL, done, "NULL NA class ops");
+    if (na_class->ops->mem_alloc)
+        ret = na_class->ops->mem_alloc(na_class, size);
+    else
+        ret = calloc(1, size);
+    NA_CHECK_SUBSYS_ERROR_NORET(
+        mem, ret == NULL, done, "Could not allocate %zu bytes", size);
+
+    NA_LOG_SUBSYS_DEBUG(
+        mem, "Allocated mem buffer (%p), size (%zu bytes)", ret, size);
+
+done:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+na_return_t
+NA_Mem_free(na_class_t *na_class, void *buf)
+{
+    na_return_t ret = NA_SUCCESS;
+
+    NA_CHECK_SUBSYS_ERROR(
+        mem, na_class == NULL, done, ret, NA_INVALID_ARG, "NULL NA class");
+    if (buf == NULL)
+        goto done;
+
+    NA_CHECK_SUBSYS_ERROR(mem, na_class->ops == NULL, done, ret, NA_INVALID_ARG,
+        "NULL NA class ops");
+
+    NA_LOG_SUBSYS_DEBUG(mem, "Freeing mem buffer (%p)", buf);
+
+    if (na_class->ops->mem_free)
+        ret = na_class->ops->mem_free(na_class, buf);
+    else
+        free(buf);
+
+done:
+    return ret;
+}
+
 /*---------------------------------------------------------------------------*/
 na_return_t
 NA_Mem_handle_create(na_class_t *na_class, void *buf, size_t buf_size,
@@ -579,6 +579,35 @@ NA_Msg_recv_expected(na_class_t *na_class, na_context_t *context,
     na_cb_t callback, void *arg, void *buf, size_t buf_size, void *plugin_data,
     na_addr_t source_addr, uint8_t source_id, na_tag_t tag, na_op_id_t *op_id);
 
+/**
+ * Allocate size bytes of zero-initialized memory that is suitable for RMA
+ * operations. Plugins may place that memory so that transfers to and from it
+ * are cheaper than transfers of user memory (e.g., NA SM allocates it from
+ * shared-memory so that peers can copy it without a system call). Plugins
+ * that do not provide an allocator fall back to regular heap allocation.
+ * Memory must still be registered with NA_Mem_handle_create().
+ *
+ * \param na_class [IN/OUT]     pointer to NA class
+ * \param size [IN]             buffer size
+ *
+ * \return Pointer to allocated memory or NULL in case of failure
+ */
+NA_PUBLIC void *
+NA_Mem_alloc(na_class_t *na_class, size_t size) NA_WARN_UNUSED_RESULT;
+
+/**
+ * Free memory that was allocated with NA_Mem_alloc(). Memory handles created
+ * on that memory must be freed first. If buf is NULL, no operation is
+ * performed.
+ *
+ * \param na_class [IN/OUT]     pointer to NA class
+ * \param buf [IN]              pointer to buffer
+ *
+ * \return NA_SUCCESS or corresponding NA error code
+ */
+NA_PUBLIC na_return_t
+NA_Mem_free(na_class_t *na_class, void *buf);
+
 /**
  * Create memory handle for RMA operations.
  * For non-contiguous memory, use NA_Mem_handle_create_segments() instead.
@@ -782,6 +811,73 @@ NA_Get(na_class_t *na_class, na_context_t *context, na_cb_t callback, void *arg,
     size_t data_size, na_addr_t remote_addr, uint8_t remote_id,
     na_op_id_t *op_id);
 
+/**
+ * Get the maximum number of segments that can be passed to NA_Putv() and
+ * NA_Getv() on either side of the transfer.
+ *
+ * \param na_class [IN]         pointer to NA class
+ *
+ * \return Maximum number of segments or 0 if vectored operations are not
+ * supported by the plugin
+ */
+static NA_INLINE size_t
+NA_Rma_get_max_iovcnt(const na_class_t *na_class) NA_WARN_UNUSED_RESULT;
+
+/**
+ * Put data to remote address using a list of local and remote segments.
+ * The total length of the local segments must match the total length of the
+ * remote segments. The transfer completes as a single operation: after
+ * completion, the user callback is placed into a completion queue and can be
+ * triggered using NA_Trigger(). The segment arrays are only accessed during
+ * the call and can be released as soon as the call returns.
+ * \remark Memory must be registered and handles exchanged between peers.
+ *
+ * \param na_class [IN/OUT]      pointer to NA class
+ * \param context [IN/OUT]       pointer to context of execution
+ * \param callback [IN]          pointer to function callback
+ * \param arg [IN]               pointer to data passed to callback
+ * \param local_iov [IN]         array of local segments
+ * \param local_iovcnt [IN]      number of local segments
+ * \param remote_iov [IN]        array of remote segments
+ * \param remote_iovcnt [IN]     number of remote segments
+ * \param remote_addr [IN]       abstract address of remote destination
+ * \param remote_id [IN]         target ID of remote destination
+ * \param op_id [IN/OUT]         pointer to operation ID
+ *
+ * \return NA_SUCCESS or corresponding NA error code (NA_OPNOTSUPPORTED if
+ * vectored operations are not supported by the plugin)
+ */
+static NA_INLINE na_return_t
+NA_Putv(na_class_t *na_class, na_context_t *context, na_cb_t callback,
+    void *arg, const struct na_rma_iov *local_iov, size_t local_iovcnt,
+    const struct na_rma_iov *remote_iov, size_t remote_iovcnt,
+    na_addr_t remote_addr, uint8_t remote_id, na_op_id_t *op_id);
+
+/**
+ * Get data from remote address using a list of local and remote segments.
+ * See NA_Putv() for details.
+ *
+ * \param na_class [IN/OUT]      pointer to NA class
+ * \param context [IN/OUT]       pointer to context of execution
+ * \param callback [IN]          pointer to function callback
+ * \param arg [IN]               pointer to data passed to callback
+ * \param local_iov [IN]         array of local segments
+ * \param local_iovcnt [IN]      number of local segments
+ * \param remote_iov [IN]        array of remote segments
+ * \param remote_iovcnt [IN]     number of remote segments
+ * \param remote_addr [IN]       abstract address of remote source
+ * \param remote_id [IN]         target ID of remote source
+ * \param op_id [IN/OUT]         pointer to operation ID
+ *
+ * \return NA_SUCCESS or corresponding NA error code (NA_OPNOTSUPPORTED if
+ * vectored operations are not supported by the plugin)
+ */
+static NA_INLINE na_return_t
+NA_Getv(na_class_t *na_class, na_context_t *context, na_cb_t callback,
+    void *arg, const struct na_rma_iov *local_iov, size_t local_iovcnt,
+    const struct na_rma_iov *remote_iov, size_t remote_iovcnt,
+    na_addr_t remote_addr, uint8_t remote_id, na_op_id_t *op_id);
+
 /**
  * Retrieve file descriptor from NA plugin when supported. The descriptor
  * can be used by upper layers for manual polling through the usual
@@ -993,12 +1089,25 @@ struct na_class_ops {
         na_offset_t local_offset, na_mem_handle_t remote_mem_handle,
         na_offset_t remote_offset, size_t length, na_addr_t remote_addr,
         uint8_t remote_id, na_op_id_t *op_id);
+    size_t (*rma_get_max_iovcnt)(const na_class_t *na_class);
+    na_return_t (*putv)(na_class_t *na_class, na_context_t *context,
+        na_cb_t callback, void *arg, const struct na_rma_iov *local_iov,
+        size_t local_iovcnt, const struct na_rma_iov *remote_iov,
+        size_t remote_iovcnt, na_addr_t remote_addr, uint8_t remote_id,
+        na_op_id_t *op_id);
+    na_return_t (*getv)(na_class_t *na_class, na_context_t *context,
+        na_cb_t callback, void *arg, const struct na_rma_iov *local_iov,
+        size_t local_iovcnt, const struct na_rma_iov *remote_iov,
+        size_t remote_iovcnt, na_addr_t remote_addr, uint8_t remote_id,
+        na_op_id_t *op_id);
     int (*na_poll_get_fd)(na_class_t *na_class, na_context_t *context);
     bool (*na_poll_try_wait)(na_class_t *na_class, na_context_t *context);
     na_return_t (*progress)(
         na_class_t *na_class, na_context_t *context, unsigned int timeout);
     na_return_t (*cancel)(
         na_class_t *na_class, na_context_t *context, na_op_id_t *op_id);
+    void *(*mem_alloc)(na_class_t *na_class, size_t size);
+    na_return_t (*mem_free)(na_class_t *na_class, void *buf);
 };
 
 /*---------------------------------------------------------------------------*/
@@ -1162,6 +1271,44 @@ NA_Get(na_class_t *na_class, na_context_t *context, na_cb_t callback, void *arg,
         data_size, remote_addr, remote_id, op_id);
 }
 
+/*---------------------------------------------------------------------------*/
+static NA_INLINE size_t
+NA_Rma_get_max_iovcnt(const na_class_t *na_class)
+{
+    return (na_class->ops->rma_get_max_iovcnt && na_class->ops->putv &&
+               na_class->ops->getv)
+               ? na_class->ops->rma_get_max_iovcnt(na_class)
+               : 0;
+}
+
+/*---------------------------------------------------------------------------*/
+static NA_INLINE na_return_t
+NA_Putv(na_class_t *na_class, na_context_t *context, na_cb_t callback,
+    void *arg, const struct na_rma_iov *local_iov, size_t local_iovcnt,
+    const struct na_rma_iov *remote_iov, size_t remote_iovcnt,
+    na_addr_t remote_addr, uint8_t remote_id, na_op_id_t *op_id)
+{
+    return (na_class->ops->putv)
+               ? na_class->ops->putv(na_class, context, callback, arg,
+                     local_iov, local_iovcnt, remote_iov, remote_iovcnt,
+                     remote_addr, remote_id, op_id)
+               : NA_OPNOTSUPPORTED;
+}
+
+/*---------------------------------------------------------------------------*/
+static NA_INLINE na_return_t
+NA_Getv(na_class_t *na_class, na_context_t *context, na_cb_t callback,
+    void *arg, const struct na_rma_iov *local_iov, size_t local_iovcnt,
+    const struct na_rma_iov *remote_iov, size_t remote_iovcnt,
+    na_addr_t remote_addr, uint8_t remote_id, na_op_id_t *op_id)
+{
+    return (na_class->ops->getv)
+               ? na_class->ops->getv(na_class, context, callback, arg,
+                     local_iov, local_iovcnt, remote_iov, remote_iovcnt,
+                     remote_addr, remote_id, op_id)
+               : NA_OPNOTSUPPORTED;
+}
+
 /*---------------------------------------------------------------------------*/
 static NA_INLINE int
 NA_Poll_get_fd(na_class_t *na_class, na_context_t *context)
@@ -481,10 +481,15 @@ const struct na_class_ops NA_PLUGIN_OPS(bmi) = {
     na_bmi_mem_handle_deserialize,        /* mem_handle_deserialize */
     na_bmi_put,                           /* put */
     na_bmi_get,                           /* get */
+    NULL,                                 /* rma_get_max_iovcnt */
+    NULL,                                 /* putv */
+    NULL,                                 /* getv */
     NULL,                                 /* poll_get_fd */
     NULL,                                 /* poll_try_wait */
     na_bmi_progress,                      /* progress */
-    na_bmi_cancel                         /* cancel */
+    na_bmi_cancel,                        /* cancel */
+    NULL,                                 /* mem_alloc */
+    NULL                                  /* mem_free */
 };
 
 /********************/
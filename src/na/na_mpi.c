@@ -425,10 +425,15 @@ const struct na_class_ops NA_PLUGIN_OPS(mpi) = {
     na_mpi_mem_handle_deserialize,        /* mem_handle_deserialize */
     na_mpi_put,                           /* put */
     na_mpi_get,                           /* get */
+    NULL,                                 /* rma_get_max_iovcnt */
+    NULL,                                 /* putv */
+    NULL,                                 /* getv */
     NULL,                                 /* poll_get_fd */
     NULL,                                 /* poll_try_wait */
     na_mpi_progress,                      /* progress */
-    na_mpi_cancel                         /* cancel */
+    na_mpi_cancel,                        /* cancel */
+    NULL,                                 /* mem_alloc */
+    NULL                                  /* mem_free */
 };
 
 static MPI_Comm na_mpi_init_comm_g = MPI_COMM_NULL; /* MPI comm used at init */
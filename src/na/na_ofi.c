@@ -532,7 +532,8 @@ struct na_ofi_op_id {
     na_context_t *context;              /* NA context associated    */
     struct na_ofi_addr *addr;           /* Address associated       */
     uint64_t fi_op_flags;               /* Operation flags          */
-    hg_atomic_int32_t status;           /* Operation status         */
+    NA_ALIGNED(hg_atomic_int32_t status,
+        HG_MEM_CACHE_LINE_SIZE); /* Operation status (own cache line) */
 };
 
 /* Op ID queue */
@@ -1465,10 +1466,15 @@ const struct na_class_ops NA_PLUGIN_OPS(ofi) = {
     na_ofi_mem_handle_deserialize,         /* mem_handle_deserialize */
     na_ofi_put,                            /* put */
     na_ofi_get,                            /* get */
+    NULL,                                  /* rma_get_max_iovcnt */
+    NULL,                                  /* putv */
+    NULL,                                  /* getv */
     na_ofi_poll_get_fd,                    /* poll_get_fd */
     na_ofi_poll_try_wait,                  /* poll_try_wait */
     na_ofi_progress,                       /* progress */
-    na_ofi_cancel                          /* cancel */
+    na_ofi_cancel,                         /* cancel */
+    NULL,                                  /* mem_alloc */
+    NULL                                   /* mem_free */
 };
 
 /* Fabric list */
@@ -5507,9 +5513,12 @@ na_ofi_op_create(na_class_t *na_class)
 {
     struct na_ofi_op_id *na_ofi_op_id = NULL;
 
-    na_ofi_op_id = (struct na_ofi_op_id *) calloc(1, sizeof(*na_ofi_op_id));
+    /* Op IDs must not share cache lines */
+    na_ofi_op_id = (struct na_ofi_op_id *) hg_mem_aligned_alloc(
+        HG_MEM_CACHE_LINE_SIZE, sizeof(*na_ofi_op_id));
     NA_CHECK_SUBSYS_ERROR_NORET(op, na_ofi_op_id == NULL, error,
         "Could not allocate NA OFI operation ID");
+    memset(na_ofi_op_id, 0, sizeof(*na_ofi_op_id));
     na_ofi_op_id->na_ofi_class = NA_OFI_CLASS(na_class);
 
     /* Completed by default */
@@ -5532,7 +5541,7 @@ na_ofi_op_destroy(na_class_t NA_UNUSED *na_class, na_op_id_t *op_id)
         !(hg_atomic_get32(&na_ofi_op_id->status) & NA_OFI_OP_COMPLETED), out,
         ret, NA_BUSY, "Attempting to free OP ID that was not completed");
 
-    free(na_ofi_op_id);
+    hg_mem_aligned_free(na_ofi_op_id);
 
 out:
     return ret;
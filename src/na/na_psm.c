@@ -2659,8 +2659,13 @@ const struct na_class_ops NA_PSM_PLUGIN_VARIABLE = {
     na_psm_mem_handle_deserialize,         /* mem_handle_deserialize */
     na_psm_put,                            /* put */
     na_psm_get,                            /* get */
+    NULL,                                  /* rma_get_max_iovcnt */
+    NULL,                                  /* putv */
+    NULL,                                  /* getv */
     NULL,                                  /* poll_get_fd */
     NULL,                                  /* poll_try_wait */
     na_psm_progress,                       /* progress */
-    na_psm_cancel                          /* cancel */
+    na_psm_cancel,                         /* cancel */
+    NULL,                                  /* mem_alloc */
+    NULL                                   /* mem_free */
 };
@@ -11,7 +11,7 @@
 #include "na_plugin.h"
 
 #include "mercury_event.h"
-#include "mercury_hash_table.h"
+#include "mercury_hash_map.h"
 #include "mercury_list.h"
 #include "mercury_mem.h"
 #include "mercury_poll.h"
@@ -68,26 +68,56 @@
 /* Max filename length used for shared files */
 #define NA_SM_MAX_FILENAME 64
 
-/* Max number of shared-memory buffers (reserved by 64-bit atomic integer) */
-#define NA_SM_NUM_BUFS 64
+/* Number of shared-memory buffer size classes */
+#define NA_SM_NUM_BUF_CLASSES 3
 
-/* Size of shared-memory buffer */
-#define NA_SM_COPY_BUF_SIZE NA_SM_PAGE_SIZE
+/* Number of shared-memory buffers per size class (each class is reserved by a
+ * 64-bit atomic integer) */
+#define NA_SM_NUM_BUFS_SMALL  64
+#define NA_SM_NUM_BUFS_MEDIUM 16
+#define NA_SM_NUM_BUFS_LARGE  4
+#define NA_SM_NUM_BUFS                                                         \
+    (NA_SM_NUM_BUFS_SMALL + NA_SM_NUM_BUFS_MEDIUM + NA_SM_NUM_BUFS_LARGE)
+
+/* Size of shared-memory buffers per size class */
+#define NA_SM_COPY_BUF_SIZE_SMALL  NA_SM_PAGE_SIZE
+#define NA_SM_COPY_BUF_SIZE_MEDIUM (64 * 1024)
+#define NA_SM_COPY_BUF_SIZE_LARGE  (1024 * 1024)
+
+/* Size of shared-memory buffer arena */
+#define NA_SM_COPY_BUF_ARENA_SIZE                                              \
+    (NA_SM_NUM_BUFS_SMALL * NA_SM_COPY_BUF_SIZE_SMALL +                        \
+        NA_SM_NUM_BUFS_MEDIUM * NA_SM_COPY_BUF_SIZE_MEDIUM +                   \
+        NA_SM_NUM_BUFS_LARGE * NA_SM_COPY_BUF_SIZE_LARGE)
+
+/* Number of entries in msg queues */
+#define NA_SM_MSG_QUEUE_SIZE 64
 
 /* Max number of fds used for cleanup */
 #define NA_SM_CLEANUP_NFDS 16
 
+/* Number of queue pairs per segment and max number of segments, the first
+ * segment is embedded in the shared region and others are mapped on demand */
+#define NA_SM_QUEUE_PAIR_SEG_SIZE 64
+#define NA_SM_NUM_QUEUE_PAIR_SEGS 64
+
 /* Max number of peers */
-#define NA_SM_MAX_PEERS (NA_CONTEXT_ID_MAX + 1)
+#define NA_SM_MAX_PEERS (NA_SM_QUEUE_PAIR_SEG_SIZE * NA_SM_NUM_QUEUE_PAIR_SEGS)
 
 /* Addr status bits */
 #define NA_SM_ADDR_RESERVED   (1 << 0)
 #define NA_SM_ADDR_CMD_PUSHED (1 << 1)
 #define NA_SM_ADDR_RESOLVED   (1 << 2)
 
-/* Msg sizes */
-#define NA_SM_UNEXPECTED_SIZE NA_SM_COPY_BUF_SIZE
+/* Msg sizes (default and max that can be requested through init info) */
+#define NA_SM_UNEXPECTED_SIZE NA_SM_COPY_BUF_SIZE_SMALL
 #define NA_SM_EXPECTED_SIZE   NA_SM_UNEXPECTED_SIZE
+#define NA_SM_MSG_SIZE_MAX    NA_SM_COPY_BUF_SIZE_LARGE
+
+/* Buffer index and size must fit in msg header */
+#if NA_SM_NUM_BUFS > 128 || NA_SM_MSG_SIZE_MAX >= (1 << 21)
+#    error "Shared-memory buffer classes exceed msg header limits"
+#endif
 
 /* Max tag */
 #define NA_SM_MAX_TAG NA_TAG_MAX
@@ -98,12 +128,19 @@
 /* Max events */
 #define NA_SM_MAX_EVENTS 16
 
+/* RMAs larger than this are copied one chunk per progress call */
+#define NA_SM_RMA_CHUNK_SIZE (1 << 20)
+
+/* Max number of peer RMA segments that remain mapped once unused */
+#define NA_SM_SHM_SEG_CACHE_MAX (64)
+
 /* Op ID status bits */
 #define NA_SM_OP_COMPLETED (1 << 0)
 #define NA_SM_OP_RETRYING  (1 << 1)
 #define NA_SM_OP_CANCELED  (1 << 2)
 #define NA_SM_OP_QUEUED    (1 << 3)
 #define NA_SM_OP_ERRORED   (1 << 4)
+#define NA_SM_OP_COPYING   (1 << 5)
 
 /* Private data access */
 #define NA_SM_CLASS(na_class) ((struct na_sm_class *) (na_class->plugin_class))
@@ -154,6 +191,14 @@
 #define NA_SM_PRINT_SHM_NAME(str, size, uri)                                   \
     snprintf(str, size, NA_SM_SHM_PREFIX "-%s", uri)
 
+/* Generate SHM file name of RMA segment */
+#define NA_SM_PRINT_RMA_SHM_NAME(str, size, pid, id)                           \
+    snprintf(str, size, NA_SM_SHM_PREFIX "-%d-rma-%" PRIu32, pid, id)
+
+/* Generate SHM file name of queue pair segment */
+#define NA_SM_PRINT_QUEUE_PAIR_SHM_NAME(str, size, uri, seg)                   \
+    snprintf(str, size, NA_SM_SHM_PREFIX "-%s-qp-%u", uri, seg)
+
 /* Generate socket path */
 #define NA_SM_PRINT_SOCK_PATH(str, size, uri)                                  \
     snprintf(str, size, NA_SM_TMP_DIRECTORY "/" NA_SM_SHM_PREFIX "-%s", uri);
@@ -169,6 +214,10 @@
 #define NA_SM_IOV(x)                                                           \
     ((x)->info.iovcnt > NA_SM_IOV_STATIC_MAX) ? (x)->iov.d : (x)->iov.s
 
+/* Get queue pair from the segment it belongs to */
+#define NA_SM_QUEUE_PAIR(seg, idx)                                             \
+    (&(seg)->queue_pairs[(idx) % NA_SM_QUEUE_PAIR_SEG_SIZE])
+
 /************************************/
 /* Local Type and Struct Definition */
 /************************************/
@@ -177,9 +226,9 @@
 NA_PACKED(union na_sm_msg_hdr {
     struct {
         unsigned int tag : 32;      /* Message tag : UINT MAX */
-        unsigned int buf_size : 16; /* Buffer length: 4KB MAX */
-        unsigned int buf_idx : 8;   /* Index reserved: 64 MAX */
-        unsigned int type : 8;      /* Message type */
+        unsigned int buf_size : 21; /* Buffer length: 2MB MAX */
+        unsigned int buf_idx : 7;   /* Index reserved: 128 MAX */
+        unsigned int type : 4;      /* Message type */
     } hdr;
     uint64_t val;
 });
@@ -190,16 +239,22 @@ union na_sm_cacheline_atomic_int64 {
     char pad[NA_SM_CACHE_LINE_SIZE];
 };
 
-union na_sm_cacheline_atomic_int256 {
-    hg_atomic_int64_t val[4];
-    char pad[NA_SM_CACHE_LINE_SIZE];
+/* Msg buffers (page aligned), buffers of each size class are laid out
+ * contiguously in the arena, smallest class first */
+struct na_sm_copy_buf {
+    hg_thread_spin_t buf_locks[NA_SM_NUM_BUFS]; /* Locks on buffers */
+    NA_ALIGNED(char buf[NA_SM_COPY_BUF_ARENA_SIZE],
+        NA_SM_PAGE_SIZE); /* Buffer arena */
+    union na_sm_cacheline_atomic_int64
+        available[NA_SM_NUM_BUF_CLASSES]; /* Available bitmasks */
 };
 
-/* Msg buffers (page aligned) */
-struct na_sm_copy_buf {
-    hg_thread_spin_t buf_locks[NA_SM_NUM_BUFS];    /* Locks on buffers */
-    char buf[NA_SM_NUM_BUFS][NA_SM_COPY_BUF_SIZE]; /* Array of buffers */
-    union na_sm_cacheline_atomic_int64 available;  /* Available bitmask */
+/* Msg buffer size class */
+struct na_sm_buf_class {
+    size_t size;        /* Size of each buffer */
+    size_t offset;      /* Offset of first buffer in arena */
+    unsigned int count; /* Number of buffers */
+    unsigned int index; /* Index of first buffer */
 };
 
 /* Msg queue (allocate queue's flexible array member statically) */
@@ -213,7 +268,8 @@ struct na_sm_msg_queue {
     hg_atomic_int32_t cons_tail;
     unsigned int cons_size;
     unsigned int cons_mask;
-    NA_ALIGNED(hg_atomic_int64_t ring[NA_SM_NUM_BUFS], HG_MEM_CACHE_LINE_SIZE);
+    NA_ALIGNED(
+        hg_atomic_int64_t ring[NA_SM_MSG_QUEUE_SIZE], HG_MEM_CACHE_LINE_SIZE);
 };
 
 /* Shared queue pair */
@@ -222,17 +278,22 @@ struct na_sm_queue_pair {
     struct na_sm_msg_queue rx_queue; /* Recv queue */
 };
 
+/* Segment of shared queue pairs */
+struct na_sm_queue_pair_seg {
+    NA_ALIGNED(struct na_sm_queue_pair queue_pairs[NA_SM_QUEUE_PAIR_SEG_SIZE],
+        NA_SM_PAGE_SIZE); /* Msg queue pairs */
+};
+
 /* Cmd values */
 enum na_sm_cmd { NA_SM_RESERVED = 1, NA_SM_RELEASED };
 
 /* Cmd header */
 NA_PACKED(union na_sm_cmd_hdr {
     struct {
-        unsigned int pid : 32;     /* PID */
-        unsigned int id : 8;       /* ID */
-        unsigned int pair_idx : 8; /* Index reserved */
-        unsigned int type : 8;     /* Cmd type */
-        unsigned int pad : 8;      /* 8 bits left */
+        unsigned int pid : 32;      /* PID */
+        unsigned int id : 8;        /* ID */
+        unsigned int pair_idx : 16; /* Index reserved */
+        unsigned int type : 8;      /* Cmd type */
     } hdr;
     uint64_t val;
 });
@@ -261,12 +322,18 @@ struct na_sm_addr_key {
 
 /* Shared region */
 struct na_sm_region {
-    struct na_sm_addr_key addr_key;  /* Region IDs */
-    struct na_sm_copy_buf copy_bufs; /* Pool of msg buffers */
-    NA_ALIGNED(struct na_sm_queue_pair queue_pairs[NA_SM_MAX_PEERS],
-        NA_SM_PAGE_SIZE);                          /* Msg queue pairs */
-    struct na_sm_cmd_queue cmd_queue;              /* Cmd queue */
-    union na_sm_cacheline_atomic_int256 available; /* Available pairs */
+    struct na_sm_addr_key addr_key;             /* Region IDs */
+    struct na_sm_copy_buf copy_bufs;            /* Pool of msg buffers */
+    struct na_sm_queue_pair_seg queue_pair_seg; /* First queue pair segment */
+    struct na_sm_cmd_queue cmd_queue;           /* Cmd queue */
+    union na_sm_cacheline_atomic_int64
+        queue_pair_segs;                        /* Segments created */
+    union na_sm_cacheline_atomic_int64
+        doorbell_segs;                          /* Segments with pending msgs */
+    union na_sm_cacheline_atomic_int64
+        available[NA_SM_NUM_QUEUE_PAIR_SEGS];   /* Available pairs */
+    union na_sm_cacheline_atomic_int64
+        doorbell[NA_SM_NUM_QUEUE_PAIR_SEGS];    /* Pairs with pending msgs */
 };
 
 /* Poll type */
@@ -283,6 +350,8 @@ struct na_sm_addr {
     struct na_sm_addr_key addr_key;     /* Address key */
     struct na_sm_endpoint *endpoint;    /* Endpoint */
     struct na_sm_region *shared_region; /* Shared-memory region */
+    struct na_sm_queue_pair_seg
+        *queue_pair_seg;                /* Segment of queue pair */
     struct na_sm_msg_queue *tx_queue;   /* Pointer to shared tx queue */
     struct na_sm_msg_queue *rx_queue;   /* Pointer to shared rx queue */
     char *uri;                          /* Generated URI */
@@ -292,7 +361,7 @@ struct na_sm_addr {
     enum na_sm_poll_type rx_poll_type;  /* Rx poll type */
     hg_atomic_int32_t refcount;         /* Ref count */
     hg_atomic_int32_t status;           /* Status bits */
-    uint8_t queue_pair_idx;             /* Shared queue pair index */
+    uint16_t queue_pair_idx;            /* Shared queue pair index */
     bool unexpected;                    /* Unexpected address */
 };
 
@@ -302,16 +371,20 @@ struct na_sm_addr_list {
     hg_thread_spin_t lock;
 };
 
-/* Map (used to cache addresses) */
+/* Map (used to cache addresses), lookups do not take the lock */
 struct na_sm_map {
-    hg_thread_rwlock_t lock;
-    hg_hash_table_t *map;
+    hg_thread_mutex_t lock;
+    hg_hash_map_t *map;
 };
 
 /* Memory descriptor info */
 struct na_sm_mem_desc_info {
     unsigned long iovcnt; /* Segment count */
     size_t len;           /* Size of region */
+    uintptr_t shm_base;   /* Owner's address of RMA segment */
+    size_t shm_len;       /* Size of RMA segment (0 if none) */
+    pid_t shm_pid;        /* Owner of RMA segment */
+    uint32_t shm_id;      /* ID of RMA segment */
     uint8_t flags;        /* Flag of operation access */
 };
 
@@ -324,9 +397,42 @@ union na_sm_iov {
 /* Memory handle */
 struct na_sm_mem_handle {
     struct na_sm_mem_desc_info info; /* Segment info */
+    char *shm_addr;                  /* Local mapping of RMA segment */
+    struct na_sm_shm_seg *shm_seg;   /* Cached mapping of peer segment */
     union na_sm_iov iov;             /* Remain last */
 };
 
+/* Shared-memory RMA segment key */
+struct na_sm_shm_seg_key {
+    pid_t pid;   /* Owner PID */
+    uint32_t id; /* Segment ID */
+};
+
+/* Shared-memory RMA segment */
+struct na_sm_shm_seg {
+    struct na_sm_shm_seg_key key;       /* Segment key */
+    HG_LIST_ENTRY(na_sm_shm_seg) entry; /* Entry in segment list */
+    HG_QUEUE_ENTRY(na_sm_shm_seg) lru;  /* Entry in LRU queue of cache */
+    char *addr;                         /* Local mapping */
+    size_t len;                         /* Mapped length */
+    uintptr_t base;                     /* Owner's address */
+    unsigned int ref_count;             /* Handles using cached mapping */
+};
+
+/* Shared-memory RMA segment list */
+struct na_sm_shm_seg_list {
+    HG_LIST_HEAD(na_sm_shm_seg) list;
+    hg_thread_rwlock_t lock;
+};
+
+/* Cache of mapped peer RMA segments */
+struct na_sm_shm_seg_cache {
+    HG_QUEUE_HEAD(na_sm_shm_seg) lru; /* Unused mappings, oldest first */
+    hg_hash_map_t *map;               /* Mappings keyed on (pid, id) */
+    hg_thread_mutex_t lock;           /* Cache lock */
+    unsigned int lru_count;           /* Number of unused mappings */
+};
+
 /* Msg info */
 struct na_sm_msg_info {
     union {
@@ -337,6 +443,23 @@ struct na_sm_msg_info {
     na_tag_t tag;
 };
 
+/* RMA op */
+typedef na_return_t (*na_sm_process_vm_op_t)(pid_t pid,
+    const struct iovec *local_iov, unsigned long liovcnt,
+    const struct iovec *remote_iov, unsigned long riovcnt, size_t length);
+
+/* Chunked RMA info */
+struct na_sm_rma_info {
+    na_sm_process_vm_op_t process_vm_op; /* Copy function */
+    struct iovec *local_iov;             /* Local segments */
+    struct iovec *remote_iov;            /* Remote segments */
+    unsigned long local_iovcnt;          /* Local segment count */
+    unsigned long remote_iovcnt;         /* Remote segment count */
+    unsigned long iov_max;               /* Max segments per copy */
+    size_t length;                       /* Total length */
+    size_t offset;                       /* Length copied so far */
+};
+
 /* Unexpected msg info */
 struct na_sm_unexpected_info {
     HG_QUEUE_ENTRY(na_sm_unexpected_info) entry;
@@ -352,22 +475,19 @@ struct na_sm_unexpected_msg_queue {
     hg_thread_spin_t lock;
 };
 
-/* RMA op */
-typedef na_return_t (*na_sm_process_vm_op_t)(pid_t pid,
-    const struct iovec *local_iov, unsigned long liovcnt,
-    const struct iovec *remote_iov, unsigned long riovcnt, size_t length);
-
 /* Operation ID */
 struct na_sm_op_id {
     struct na_cb_completion_data completion_data; /* Completion data */
     union {
         struct na_sm_msg_info msg;
+        struct na_sm_rma_info rma;
     } info;                            /* Op info                  */
     HG_QUEUE_ENTRY(na_sm_op_id) entry; /* Entry in queue           */
     na_class_t *na_class;              /* NA class associated      */
     na_context_t *context;             /* NA context associated    */
     struct na_sm_addr *addr;           /* Address associated       */
-    hg_atomic_int32_t status;          /* Operation status         */
+    NA_ALIGNED(hg_atomic_int32_t status,
+        NA_SM_CACHE_LINE_SIZE); /* Operation status (own cache line) */
 };
 
 /* Op ID queue */
@@ -384,7 +504,12 @@ struct na_sm_endpoint {
     struct na_sm_op_queue unexpected_op_queue; /* Unexpected op queue */
     struct na_sm_op_queue expected_op_queue;   /* Expected op queue */
     struct na_sm_op_queue retry_op_queue;      /* Retry op queue */
+    struct na_sm_op_queue rma_op_queue;        /* Chunked RMA op queue */
     struct na_sm_addr_list poll_addr_list;     /* List of addresses to poll */
+    struct na_sm_addr
+        *doorbell_addrs[NA_SM_MAX_PEERS];      /* Addresses rung by doorbell */
+    struct na_sm_queue_pair_seg
+        *queue_pair_segs[NA_SM_NUM_QUEUE_PAIR_SEGS]; /* Mapped segments */
     struct na_sm_addr *source_addr;            /* Source addr */
     hg_poll_set_t *poll_set;                   /* Poll set */
     int sock;                                  /* Sock fd */
@@ -401,9 +526,13 @@ struct na_sm_context {
 
 /* Private data */
 struct na_sm_class {
-    struct na_sm_endpoint endpoint; /* Endpoint */
-    size_t iov_max;                 /* Max number of IOVs */
-    uint8_t context_max;            /* Max number of contexts */
+    struct na_sm_endpoint endpoint;           /* Endpoint */
+    struct na_sm_shm_seg_list shm_segs;       /* Allocated RMA segments */
+    struct na_sm_shm_seg_cache shm_seg_cache; /* Mapped peer RMA segments */
+    size_t unexpected_size_max;               /* Max unexpected size */
+    size_t expected_size_max;                 /* Max expected size */
+    size_t iov_max;                           /* Max number of IOVs */
+    uint8_t context_max;                      /* Max number of contexts */
 };
 
 /********************/
@@ -443,6 +572,66 @@ static int
 na_sm_shm_cleanup(
     const char *fpath, const struct stat *sb, int typeflag, struct FTW *ftwbuf);
 
+/**
+ * Find allocated RMA segment that contains buffer.
+ */
+static struct na_sm_shm_seg *
+na_sm_shm_seg_find(
+    struct na_sm_shm_seg_list *na_sm_shm_segs, const void *buf, size_t len);
+
+/**
+ * Unmap all RMA segments of list and unlink them.
+ */
+static void
+na_sm_shm_seg_list_destroy(struct na_sm_shm_seg_list *na_sm_shm_segs);
+
+/**
+ * Key hash for RMA segment cache.
+ */
+static NA_INLINE unsigned int
+na_sm_shm_seg_key_hash(const void *key);
+
+/**
+ * Compare RMA segment keys.
+ */
+static NA_INLINE int
+na_sm_shm_seg_key_equal(const void *key1, const void *key2);
+
+/**
+ * Initialize cache of peer RMA segments.
+ */
+static na_return_t
+na_sm_shm_seg_cache_init(struct na_sm_shm_seg_cache *na_sm_shm_seg_cache);
+
+/**
+ * Unmap all cached RMA segments and destroy cache.
+ */
+static void
+na_sm_shm_seg_cache_destroy(struct na_sm_shm_seg_cache *na_sm_shm_seg_cache);
+
+/**
+ * Map RMA segment of peer, or take a reference to the cached mapping.
+ * Returns NULL if the segment cannot be mapped.
+ */
+static struct na_sm_shm_seg *
+na_sm_shm_seg_cache_acquire(struct na_sm_shm_seg_cache *na_sm_shm_seg_cache,
+    pid_t pid, uint32_t id, uintptr_t base, size_t len);
+
+/**
+ * Release reference to cached mapping. Least recently used mappings are
+ * unmapped once more than NA_SM_SHM_SEG_CACHE_MAX of them are unused.
+ */
+static void
+na_sm_shm_seg_cache_release(struct na_sm_shm_seg_cache *na_sm_shm_seg_cache,
+    struct na_sm_shm_seg *na_sm_shm_seg);
+
+/**
+ * Remove unused mapping from cache and unmap it.
+ */
+static void
+na_sm_shm_seg_cache_remove(struct na_sm_shm_seg_cache *na_sm_shm_seg_cache,
+    struct na_sm_shm_seg *na_sm_shm_seg);
+
 /**
  * Initialize queue.
  */
@@ -469,6 +658,13 @@ na_sm_msg_queue_pop(
 static NA_INLINE bool
 na_sm_msg_queue_is_empty(struct na_sm_msg_queue *na_sm_queue);
 
+/**
+ * Signal to the owner of the region that the tx queue of pair \idx has pending
+ * messages.
+ */
+static NA_INLINE void
+na_sm_doorbell_ring(struct na_sm_region *na_sm_region, uint16_t idx);
+
 /**
  * Initialize queue.
  */
@@ -490,16 +686,16 @@ na_sm_cmd_queue_pop(
     struct na_sm_cmd_queue *na_sm_queue, union na_sm_cmd_hdr *cmd_hdr);
 
 /**
- * Key hash for hash table.
+ * Key hash for hash map.
  */
-static NA_INLINE unsigned int
-na_sm_addr_key_hash(hg_hash_table_key_t key);
+static unsigned int
+na_sm_addr_key_hash(const void *key);
 
 /**
  * Compare key.
  */
-static NA_INLINE int
-na_sm_addr_key_equal(hg_hash_table_key_t key1, hg_hash_table_key_t key2);
+static int
+na_sm_addr_key_equal(const void *key1, const void *key2);
 
 /**
  * Get SM address from string.
@@ -526,6 +722,21 @@ na_sm_region_close(const char *uri, struct na_sm_region *region);
 static na_return_t
 na_sm_region_get_addr_key(const char *uri, struct na_sm_addr_key *addr_key_p);
 
+/**
+ * Map segment \seg of queue pairs, create it if it does not exist yet and
+ * \create is true. The first segment is embedded in the region itself.
+ */
+static na_return_t
+na_sm_queue_pair_seg_map(const char *uri, struct na_sm_region *region,
+    unsigned int seg, bool create, struct na_sm_queue_pair_seg **seg_p);
+
+/**
+ * Unmap segment \seg of queue pairs, also remove it if \uri is not NULL.
+ */
+static na_return_t
+na_sm_queue_pair_seg_unmap(
+    const char *uri, unsigned int seg, struct na_sm_queue_pair_seg *seg_addr);
+
 /**
  * Open UNIX domain socket.
  */
@@ -562,13 +773,13 @@ na_sm_sock_path_cleanup(
  */
 static na_return_t
 na_sm_event_create(
-    const char *uri, uint8_t pair_index, unsigned char pair, int *event);
+    const char *uri, uint16_t pair_index, unsigned char pair, int *event);
 
 /**
  * Destroy event.
  */
 static na_return_t
-na_sm_event_destroy(const char *uri, uint8_t pair_index, unsigned char pair,
+na_sm_event_destroy(const char *uri, uint16_t pair_index, unsigned char pair,
     bool remove, int event);
 
 /**
@@ -612,13 +823,20 @@ na_sm_endpoint_close(struct na_sm_endpoint *na_sm_endpoint);
  * Reserve queue pair.
  */
 static na_return_t
-na_sm_queue_pair_reserve(struct na_sm_region *na_sm_region, uint8_t *index);
+na_sm_queue_pair_reserve(struct na_sm_region *na_sm_region, uint16_t *index);
 
 /**
  * Release queue pair.
  */
 static NA_INLINE void
-na_sm_queue_pair_release(struct na_sm_region *na_sm_region, uint8_t index);
+na_sm_queue_pair_release(struct na_sm_region *na_sm_region, uint16_t index);
+
+/**
+ * Get segment \seg of the endpoint's queue pairs, map it on first use.
+ */
+static na_return_t
+na_sm_endpoint_queue_pair_seg_get(struct na_sm_endpoint *na_sm_endpoint,
+    unsigned int seg, struct na_sm_queue_pair_seg **seg_p);
 
 /**
  * Lookup addr key from map.
@@ -628,7 +846,7 @@ na_sm_addr_map_lookup(
     struct na_sm_map *na_sm_map, struct na_sm_addr_key *addr_key);
 
 /**
- * Insert new addr key into map. Execute callback while write lock is acquired.
+ * Insert new addr key into map. Execute callback while lock is acquired.
  */
 static na_return_t
 na_sm_addr_map_insert(struct na_sm_endpoint *na_sm_endpoint,
@@ -713,10 +931,23 @@ na_sm_msg_send_post(struct na_sm_endpoint *na_sm_endpoint, na_cb_type_t cb_type,
     na_tag_t tag);
 
 /**
- * Reserve shared buffer.
+ * Get size class of shared buffer index.
+ */
+static NA_INLINE const struct na_sm_buf_class *
+na_sm_buf_class_get(unsigned int index);
+
+/**
+ * Get pointer to shared buffer.
+ */
+static NA_INLINE char *
+na_sm_buf_ptr(struct na_sm_copy_buf *na_sm_copy_buf, unsigned int index);
+
+/**
+ * Reserve shared buffer from the smallest size class that can hold size bytes.
  */
 static NA_INLINE na_return_t
-na_sm_buf_reserve(struct na_sm_copy_buf *na_sm_copy_buf, unsigned int *index);
+na_sm_buf_reserve(
+    struct na_sm_copy_buf *na_sm_copy_buf, size_t size, unsigned int *index);
 
 /**
  * Release shared buffer.
@@ -750,6 +981,68 @@ na_sm_rma(struct na_sm_class *na_sm_class, na_context_t *context,
     size_t length, struct na_sm_addr *na_sm_addr,
     struct na_sm_op_id *na_sm_op_id);
 
+/**
+ * Vectored RMA op.
+ */
+static na_return_t
+na_sm_rmav(struct na_sm_class *na_sm_class, na_context_t *context,
+    na_cb_type_t cb_type, na_cb_t callback, void *arg,
+    na_sm_process_vm_op_t process_vm_op, const struct na_rma_iov *local_iov,
+    size_t local_iovcnt, const struct na_rma_iov *remote_iov,
+    size_t remote_iovcnt, struct na_sm_addr *na_sm_addr,
+    struct na_sm_op_id *na_sm_op_id);
+
+/**
+ * Copy RMA segments, either immediately or, for transfers larger than
+ * NA_SM_RMA_CHUNK_SIZE, by queuing the operation so that it is copied one
+ * chunk at a time by subsequent progress calls.
+ */
+static na_return_t
+na_sm_rma_post(struct na_sm_class *na_sm_class,
+    struct na_sm_op_id *na_sm_op_id, na_sm_process_vm_op_t process_vm_op,
+    const struct iovec *local_iov, unsigned long local_iovcnt,
+    const struct iovec *remote_iov, unsigned long remote_iovcnt,
+    size_t length);
+
+/**
+ * Copy next chunk of a queued RMA operation.
+ */
+static na_return_t
+na_sm_rma_chunk_copy(struct na_sm_op_id *na_sm_op_id);
+
+/**
+ * Call process_vm_op, splitting the copy so that no call is passed more than
+ * iov_max segments on either side.
+ */
+static na_return_t
+na_sm_rma_copy(na_sm_process_vm_op_t process_vm_op, pid_t pid,
+    unsigned long iov_max, const struct iovec *local_iov,
+    unsigned long local_iovcnt, const struct iovec *remote_iov,
+    unsigned long remote_iovcnt, size_t length);
+
+/**
+ * Get length covered by at most iov_max non-empty segments from an IOV
+ * index/offset.
+ */
+static NA_INLINE size_t
+na_sm_iov_get_len(const struct iovec *iov, unsigned long iovcnt,
+    unsigned long iov_start_index, na_offset_t iov_start_offset,
+    unsigned long iov_max);
+
+/**
+ * Complete queued RMA operation.
+ */
+static void
+na_sm_rma_complete(struct na_sm_op_id *na_sm_op_id, na_return_t cb_ret);
+
+/**
+ * Translate list of RMA segments into a single IOV.
+ */
+static na_return_t
+na_sm_rma_iov_translate(const struct na_rma_iov *rma_iov, size_t rma_iovcnt,
+    unsigned long iov_max, union na_sm_iov *trans_iov, unsigned long *iovcnt_p,
+    size_t *length_p);
+
 /**
  * Get IOV index and offset pair from an absolute offset.
  */
@@ -759,20 +1052,58 @@ na_sm_iov_get_index_offset(const struct iovec *iov, unsigned long iovcnt,
     na_offset_t *iov_start_offset);
 
 /**
- * Get IOV count for a given length.
+ * Get IOV count for a given length, zero-length segments are not counted.
  */
 static NA_INLINE unsigned long
 na_sm_iov_get_count(const struct iovec *iov, unsigned long iovcnt,
     unsigned long iov_start_index, na_offset_t iov_start_offset, size_t len);
 
 /**
- * Create new IOV for transferring length data.
+ * Create new IOV for transferring length data, leaving out zero-length
+ * segments.
  */
 static NA_INLINE void
 na_sm_iov_translate(const struct iovec *iov, unsigned long iovcnt,
     unsigned long iov_start_index, na_offset_t iov_start_offset, size_t len,
     struct iovec *new_iov, unsigned long new_iovcnt);
 
+/**
+ * Record RMA segment that memory handle was carved from, if any.
+ */
+static void
+na_sm_mem_handle_shm_set(struct na_sm_shm_seg_list *na_sm_shm_segs,
+    struct na_sm_mem_handle *na_sm_mem_handle);
+
+/**
+ * Translate remote IOV into the local mapping of its RMA segment.
+ */
+static NA_INLINE void
+na_sm_shm_iov_rebase(const struct na_sm_mem_handle *na_sm_mem_handle,
+    struct iovec *iov, unsigned long iovcnt);
+
+/**
+ * Copy length data between IOVs.
+ */
+static void
+na_sm_iov_copy(const struct iovec *dst_iov, unsigned long dst_iovcnt,
+    const struct iovec *src_iov, unsigned long src_iovcnt, size_t length);
+
+/**
+ * Copy to mapped RMA segment of peer (same signature as process_vm_writev()).
+ */
+static na_return_t
+na_sm_shm_writev(pid_t pid, const struct iovec *local_iov,
+    unsigned long liovcnt, const struct iovec *remote_iov,
+    unsigned long riovcnt, size_t length);
+
+/**
+ * Copy from mapped RMA segment of peer (same signature as process_vm_readv()).
+ */
+static na_return_t
+na_sm_shm_readv(pid_t pid, const struct iovec *local_iov,
+    unsigned long liovcnt, const struct iovec *remote_iov,
+    unsigned long riovcnt, size_t length);
+
 /**
  * Wrapper for process_vm_writev().
  */
@@ -802,6 +1133,12 @@ na_sm_poll_wait(na_context_t *context, struct na_sm_endpoint *na_sm_endpoint,
 static na_return_t
 na_sm_poll(struct na_sm_endpoint *na_sm_endpoint, bool *progressed_ptr);
 
+/**
+ * Progress rx queues of addresses whose doorbell was rung.
+ */
+static na_return_t
+na_sm_poll_doorbell(struct na_sm_endpoint *na_sm_endpoint, bool *progressed);
+
 /**
  * Progress on endpoint sock.
  */
@@ -862,6 +1199,14 @@ na_sm_process_expected(struct na_sm_op_queue *expected_op_queue,
 static na_return_t
 na_sm_process_retries(struct na_sm_endpoint *na_sm_endpoint);
 
+/**
+ * Copy one chunk of the first queued RMA operation. Operations that still
+ * have data left are moved to the back of the queue so that concurrent
+ * transfers progress evenly.
+ */
+static na_return_t
+na_sm_process_rma(struct na_sm_endpoint *na_sm_endpoint, bool *progressed);
+
 /**
  * Push operation for retry.
  */
@@ -1051,6 +1396,25 @@ na_sm_get(na_class_t *na_class, na_context_t *context, na_cb_t callback,
     na_mem_handle_t remote_mem_handle, na_offset_t remote_offset, size_t length,
     na_addr_t remote_addr, uint8_t remote_id, na_op_id_t *op_id);
 
+/* rma_get_max_iovcnt (IOV_MAX, segments of memory handles beyond that are
+ * copied in batches) */
+static size_t
+na_sm_rma_get_max_iovcnt(const na_class_t *na_class);
+
+/* putv */
+static NA_INLINE na_return_t
+na_sm_putv(na_class_t *na_class, na_context_t *context, na_cb_t callback,
+    void *arg, const struct na_rma_iov *local_iov, size_t local_iovcnt,
+    const struct na_rma_iov *remote_iov, size_t remote_iovcnt,
+    na_addr_t remote_addr, uint8_t remote_id, na_op_id_t *op_id);
+
+/* getv */
+static NA_INLINE na_return_t
+na_sm_getv(na_class_t *na_class, na_context_t *context, na_cb_t callback,
+    void *arg, const struct na_rma_iov *local_iov, size_t local_iovcnt,
+    const struct na_rma_iov *remote_iov, size_t remote_iovcnt,
+    na_addr_t remote_addr, uint8_t remote_id, na_op_id_t *op_id);
+
 /* poll_get_fd */
 static NA_INLINE int
 na_sm_poll_get_fd(na_class_t *na_class, na_context_t *context);
@@ -1068,10 +1432,31 @@ na_sm_progress(
 static na_return_t
 na_sm_cancel(na_class_t *na_class, na_context_t *context, na_op_id_t *op_id);
 
+/* mem_alloc */
+static void *
+na_sm_mem_alloc(na_class_t *na_class, size_t size);
+
+/* mem_free */
+static na_return_t
+na_sm_mem_free(na_class_t *na_class, void *buf);
+
 /*******************/
 /* Local Variables */
 /*******************/
 
+/* Msg buffer size classes (must match NA_SM_COPY_BUF_ARENA_SIZE layout) */
+static const struct na_sm_buf_class
+    na_sm_buf_classes_g[NA_SM_NUM_BUF_CLASSES] = {
+        {NA_SM_COPY_BUF_SIZE_SMALL, 0, NA_SM_NUM_BUFS_SMALL, 0},
+        {NA_SM_COPY_BUF_SIZE_MEDIUM,
+            NA_SM_NUM_BUFS_SMALL * NA_SM_COPY_BUF_SIZE_SMALL,
+            NA_SM_NUM_BUFS_MEDIUM, NA_SM_NUM_BUFS_SMALL},
+        {NA_SM_COPY_BUF_SIZE_LARGE,
+            NA_SM_NUM_BUFS_SMALL * NA_SM_COPY_BUF_SIZE_SMALL +
+                NA_SM_NUM_BUFS_MEDIUM * NA_SM_COPY_BUF_SIZE_MEDIUM,
+            NA_SM_NUM_BUFS_LARGE,
+            NA_SM_NUM_BUFS_SMALL + NA_SM_NUM_BUFS_MEDIUM}};
+
 const struct na_class_ops NA_PLUGIN_OPS(sm) = {
     "na",                              /* name */
     na_sm_check_protocol,              /* check_protocol */
@@ -1121,10 +1506,15 @@ const struct na_class_ops NA_PLUGIN_OPS(sm) = {
     na_sm_mem_handle_deserialize,        /* mem_handle_deserialize */
     na_sm_put,                           /* put */
     na_sm_get,                           /* get */
+    na_sm_rma_get_max_iovcnt,            /* rma_get_max_iovcnt */
+    na_sm_putv,                          /* putv */
+    na_sm_getv,                          /* getv */
     na_sm_poll_get_fd,                   /* poll_get_fd */
     na_sm_poll_try_wait,                 /* poll_try_wait */
     na_sm_progress,                      /* progress */
-    na_sm_cancel                         /* cancel */
+    na_sm_cancel,                        /* cancel */
+    na_sm_mem_alloc,                     /* mem_alloc */
+    na_sm_mem_free                       /* mem_free */
 };
 
 /********************/
@@ -1388,96 +1778,338 @@ na_sm_shm_cleanup(const char *fpath, const struct stat NA_UNUSED *sb,
 }
 
 /*---------------------------------------------------------------------------*/
-static void
-na_sm_msg_queue_init(struct na_sm_msg_queue *na_sm_queue)
+static struct na_sm_shm_seg *
+na_sm_shm_seg_find(
+    struct na_sm_shm_seg_list *na_sm_shm_segs, const void *buf, size_t len)
 {
-    unsigned int count = NA_SM_NUM_BUFS;
+    struct na_sm_shm_seg *na_sm_shm_seg;
 
-    na_sm_queue->prod_size = na_sm_queue->cons_size = count;
-    na_sm_queue->prod_mask = na_sm_queue->cons_mask = count - 1;
-    hg_atomic_init32(&na_sm_queue->prod_head, 0);
-    hg_atomic_init32(&na_sm_queue->cons_head, 0);
-    hg_atomic_init32(&na_sm_queue->prod_tail, 0);
-    hg_atomic_init32(&na_sm_queue->cons_tail, 0);
+    hg_thread_rwlock_rdlock(&na_sm_shm_segs->lock);
+    HG_LIST_FOREACH (na_sm_shm_seg, &na_sm_shm_segs->list, entry) {
+        if ((const char *) buf >= na_sm_shm_seg->addr &&
+            (const char *) buf + len <=
+                na_sm_shm_seg->addr + na_sm_shm_seg->len)
+            break;
+    }
+    hg_thread_rwlock_release_rdlock(&na_sm_shm_segs->lock);
+
+    return na_sm_shm_seg;
 }
 
 /*---------------------------------------------------------------------------*/
-static NA_INLINE bool
-na_sm_msg_queue_push(
-    struct na_sm_msg_queue *na_sm_queue, const union na_sm_msg_hdr *msg_hdr)
+static void
+na_sm_shm_seg_list_destroy(struct na_sm_shm_seg_list *na_sm_shm_segs)
 {
-    int32_t prod_head, prod_next, cons_tail;
-
-    do {
-        prod_head = hg_atomic_get32(&na_sm_queue->prod_head);
-        prod_next = (prod_head + 1) & (int) na_sm_queue->prod_mask;
-        cons_tail = hg_atomic_get32(&na_sm_queue->cons_tail);
+    struct na_sm_shm_seg *na_sm_shm_seg;
 
-        if (prod_next == cons_tail) {
-            hg_atomic_fence();
-            if (prod_head == hg_atomic_get32(&na_sm_queue->prod_head) &&
-                cons_tail == hg_atomic_get32(&na_sm_queue->cons_tail)) {
-                na_sm_queue->drops++;
-                /* Full */
-                return false;
-            }
-            continue;
-        }
-    } while (!hg_atomic_cas32(&na_sm_queue->prod_head, prod_head, prod_next));
+    while ((na_sm_shm_seg = HG_LIST_FIRST(&na_sm_shm_segs->list))) {
+        char shm_name[NA_SM_MAX_FILENAME] = {'\0'};
+        na_return_t ret;
 
-    hg_atomic_set64(&na_sm_queue->ring[prod_head], (int64_t) msg_hdr->val);
+        HG_LIST_REMOVE(na_sm_shm_seg, entry);
 
-    /*
-     * If there are other enqueues in progress
-     * that preceded us, we need to wait for them
-     * to complete
-     */
-    while (hg_atomic_get32(&na_sm_queue->prod_tail) != prod_head)
-        cpu_spinwait();
+        NA_SM_PRINT_RMA_SHM_NAME(shm_name, NA_SM_MAX_FILENAME,
+            na_sm_shm_seg->key.pid, na_sm_shm_seg->key.id);
+        ret =
+            na_sm_shm_unmap(shm_name, na_sm_shm_seg->addr, na_sm_shm_seg->len);
+        NA_CHECK_SUBSYS_WARNING(
+            mem, ret != NA_SUCCESS, "Could not unmap RMA segment");
+        free(na_sm_shm_seg);
+    }
+    hg_thread_rwlock_destroy(&na_sm_shm_segs->lock);
+}
 
-    hg_atomic_set32(&na_sm_queue->prod_tail, prod_next);
+/*---------------------------------------------------------------------------*/
+static NA_INLINE unsigned int
+na_sm_shm_seg_key_hash(const void *key)
+{
+    const struct na_sm_shm_seg_key *shm_seg_key =
+        (const struct na_sm_shm_seg_key *) key;
 
-    return true;
+    /* Segment IDs are sequential within each PID */
+    return ((unsigned int) shm_seg_key->pid << 16) ^ shm_seg_key->id;
 }
 
 /*---------------------------------------------------------------------------*/
-static NA_INLINE bool
-na_sm_msg_queue_pop(
-    struct na_sm_msg_queue *na_sm_queue, union na_sm_msg_hdr *msg_hdr)
+static NA_INLINE int
+na_sm_shm_seg_key_equal(const void *key1, const void *key2)
 {
-    int32_t cons_head, cons_next;
+    const struct na_sm_shm_seg_key *shm_seg_key1 =
+        (const struct na_sm_shm_seg_key *) key1;
+    const struct na_sm_shm_seg_key *shm_seg_key2 =
+        (const struct na_sm_shm_seg_key *) key2;
 
-    do {
-        cons_head = hg_atomic_get32(&na_sm_queue->cons_head);
-        cons_next = (cons_head + 1) & (int) na_sm_queue->cons_mask;
+    return (shm_seg_key1->pid == shm_seg_key2->pid &&
+            shm_seg_key1->id == shm_seg_key2->id);
+}
 
-        if (cons_head == hg_atomic_get32(&na_sm_queue->prod_tail))
-            return false;
-    } while (!hg_atomic_cas32(&na_sm_queue->cons_head, cons_head, cons_next));
+/*---------------------------------------------------------------------------*/
+static na_return_t
+na_sm_shm_seg_cache_init(struct na_sm_shm_seg_cache *na_sm_shm_seg_cache)
+{
+    na_return_t ret = NA_SUCCESS;
 
-    msg_hdr->val = (uint64_t) hg_atomic_get64(&na_sm_queue->ring[cons_head]);
+    na_sm_shm_seg_cache->map = hg_hash_map_new(sizeof(struct na_sm_shm_seg_key),
+        na_sm_shm_seg_key_hash, na_sm_shm_seg_key_equal);
+    NA_CHECK_SUBSYS_ERROR(mem, na_sm_shm_seg_cache->map == NULL, done, ret,
+        NA_NOMEM, "hg_hash_map_new() failed");
+    HG_QUEUE_INIT(&na_sm_shm_seg_cache->lru);
+    na_sm_shm_seg_cache->lru_count = 0;
+    hg_thread_mutex_init(&na_sm_shm_seg_cache->lock);
 
-    /*
-     * If there are other dequeues in progress
-     * that preceded us, we need to wait for them
-     * to complete
-     */
-    while (hg_atomic_get32(&na_sm_queue->cons_tail) != cons_head)
-        cpu_spinwait();
+done:
+    return ret;
+}
 
-    hg_atomic_set32(&na_sm_queue->cons_tail, cons_next);
+/*---------------------------------------------------------------------------*/
+static void
+na_sm_shm_seg_cache_free_cb(
+    const void NA_UNUSED *key, void *value, void NA_UNUSED *arg)
+{
+    struct na_sm_shm_seg *na_sm_shm_seg = (struct na_sm_shm_seg *) value;
+    na_return_t ret;
 
-    return true;
+    NA_CHECK_SUBSYS_WARNING(mem, na_sm_shm_seg->ref_count > 0,
+        "RMA segment still in use by %u memory handle(s)",
+        na_sm_shm_seg->ref_count);
+    ret = na_sm_shm_unmap(NULL, na_sm_shm_seg->addr, na_sm_shm_seg->len);
+    NA_CHECK_SUBSYS_WARNING(
+        mem, ret != NA_SUCCESS, "Could not unmap RMA segment");
+    free(na_sm_shm_seg);
 }
 
 /*---------------------------------------------------------------------------*/
-static NA_INLINE bool
+static void
+na_sm_shm_seg_cache_destroy(struct na_sm_shm_seg_cache *na_sm_shm_seg_cache)
+{
+    if (na_sm_shm_seg_cache->map == NULL)
+        return;
+
+    hg_hash_map_iterate(
+        na_sm_shm_seg_cache->map, na_sm_shm_seg_cache_free_cb, NULL);
+    hg_hash_map_free(na_sm_shm_seg_cache->map);
+    na_sm_shm_seg_cache->map = NULL;
+    hg_thread_mutex_destroy(&na_sm_shm_seg_cache->lock);
+}
+
+/*---------------------------------------------------------------------------*/
+static struct na_sm_shm_seg *
+na_sm_shm_seg_cache_acquire(struct na_sm_shm_seg_cache *na_sm_shm_seg_cache,
+    pid_t pid, uint32_t id, uintptr_t base, size_t len)
+{
+    struct na_sm_shm_seg_key shm_seg_key = {.pid = pid, .id = id};
+    char shm_name[NA_SM_MAX_FILENAME] = {'\0'};
+    struct na_sm_shm_seg *na_sm_shm_seg;
+    int rc;
+
+    hg_thread_mutex_lock(&na_sm_shm_seg_cache->lock);
+
+    na_sm_shm_seg = (struct na_sm_shm_seg *) hg_hash_map_lookup(
+        na_sm_shm_seg_cache->map, &shm_seg_key);
+    if (na_sm_shm_seg) {
+        if (na_sm_shm_seg->base == base && na_sm_shm_seg->len == len) {
+            /* Mapping is no longer unused */
+            if (na_sm_shm_seg->ref_count++ == 0) {
+                HG_QUEUE_REMOVE(&na_sm_shm_seg_cache->lru, na_sm_shm_seg,
+                    na_sm_shm_seg, lru);
+                na_sm_shm_seg_cache->lru_count--;
+            }
+            goto unlock;
+        }
+
+        /* Owner PID was reused, stale mapping can only go once unused */
+        if (na_sm_shm_seg->ref_count > 0) {
+            na_sm_shm_seg = NULL;
+            goto unlock;
+        }
+        HG_QUEUE_REMOVE(
+            &na_sm_shm_seg_cache->lru, na_sm_shm_seg, na_sm_shm_seg, lru);
+        na_sm_shm_seg_cache->lru_count--;
+        na_sm_shm_seg_cache_remove(na_sm_shm_seg_cache, na_sm_shm_seg);
+        na_sm_shm_seg = NULL;
+    }
+
+    rc = NA_SM_PRINT_RMA_SHM_NAME(shm_name, NA_SM_MAX_FILENAME, pid, id);
+    NA_CHECK_SUBSYS_ERROR_NORET(mem, rc < 0 || rc > NA_SM_MAX_FILENAME,
+        error, "NA_SM_PRINT_RMA_SHM_NAME() failed, rc: %d", rc);
+
+    na_sm_shm_seg =
+        (struct na_sm_shm_seg *) malloc(sizeof(struct na_sm_shm_seg));
+    NA_CHECK_SUBSYS_ERROR_NORET(mem, na_sm_shm_seg == NULL, error,
+        "Could not allocate RMA segment");
+    na_sm_shm_seg->key = shm_seg_key;
+    na_sm_shm_seg->len = len;
+    na_sm_shm_seg->base = base;
+    na_sm_shm_seg->ref_count = 1;
+
+    /* Segment may already have been freed by its owner */
+    NA_LOG_SUBSYS_DEBUG(mem, "shm_map() %s", shm_name);
+    na_sm_shm_seg->addr = (char *) na_sm_shm_map(shm_name, len, false);
+    if (na_sm_shm_seg->addr == NULL)
+        goto error;
+
+    rc = hg_hash_map_insert(
+        na_sm_shm_seg_cache->map, &na_sm_shm_seg->key, na_sm_shm_seg);
+    if (rc != HG_UTIL_SUCCESS)
+        (void) na_sm_shm_unmap(NULL, na_sm_shm_seg->addr, len);
+    NA_CHECK_SUBSYS_ERROR_NORET(
+        mem, rc != HG_UTIL_SUCCESS, error, "hg_hash_map_insert() failed");
+
+unlock:
+    hg_thread_mutex_unlock(&na_sm_shm_seg_cache->lock);
+
+    return na_sm_shm_seg;
+
+error:
+    hg_thread_mutex_unlock(&na_sm_shm_seg_cache->lock);
+    free(na_sm_shm_seg);
+
+    return NULL;
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+na_sm_shm_seg_cache_release(struct na_sm_shm_seg_cache *na_sm_shm_seg_cache,
+    struct na_sm_shm_seg *na_sm_shm_seg)
+{
+    hg_thread_mutex_lock(&na_sm_shm_seg_cache->lock);
+
+    if (--na_sm_shm_seg->ref_count == 0) {
+        HG_QUEUE_PUSH_TAIL(&na_sm_shm_seg_cache->lru, na_sm_shm_seg, lru);
+        if (++na_sm_shm_seg_cache->lru_count > NA_SM_SHM_SEG_CACHE_MAX) {
+            struct na_sm_shm_seg *na_sm_shm_seg_lru =
+                HG_QUEUE_FIRST(&na_sm_shm_seg_cache->lru);
+
+            HG_QUEUE_POP_HEAD(&na_sm_shm_seg_cache->lru, lru);
+            na_sm_shm_seg_cache->lru_count--;
+            na_sm_shm_seg_cache_remove(na_sm_shm_seg_cache, na_sm_shm_seg_lru);
+        }
+    }
+
+    hg_thread_mutex_unlock(&na_sm_shm_seg_cache->lock);
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+na_sm_shm_seg_cache_remove(struct na_sm_shm_seg_cache *na_sm_shm_seg_cache,
+    struct na_sm_shm_seg *na_sm_shm_seg)
+{
+    na_return_t ret;
+
+    (void) hg_hash_map_remove(na_sm_shm_seg_cache->map, &na_sm_shm_seg->key);
+
+    NA_LOG_SUBSYS_DEBUG(mem, "Unmapping RMA segment %d-%" PRIu32,
+        na_sm_shm_seg->key.pid, na_sm_shm_seg->key.id);
+    ret = na_sm_shm_unmap(NULL, na_sm_shm_seg->addr, na_sm_shm_seg->len);
+    NA_CHECK_SUBSYS_WARNING(
+        mem, ret != NA_SUCCESS, "Could not unmap RMA segment");
+    free(na_sm_shm_seg);
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+na_sm_msg_queue_init(struct na_sm_msg_queue *na_sm_queue)
+{
+    unsigned int count = NA_SM_MSG_QUEUE_SIZE;
+
+    na_sm_queue->prod_size = na_sm_queue->cons_size = count;
+    na_sm_queue->prod_mask = na_sm_queue->cons_mask = count - 1;
+    hg_atomic_init32(&na_sm_queue->prod_head, 0);
+    hg_atomic_init32(&na_sm_queue->cons_head, 0);
+    hg_atomic_init32(&na_sm_queue->prod_tail, 0);
+    hg_atomic_init32(&na_sm_queue->cons_tail, 0);
+}
+
+/*---------------------------------------------------------------------------*/
+static NA_INLINE bool
+na_sm_msg_queue_push(
+    struct na_sm_msg_queue *na_sm_queue, const union na_sm_msg_hdr *msg_hdr)
+{
+    int32_t prod_head, prod_next, cons_tail;
+
+    do {
+        prod_head = hg_atomic_get32(&na_sm_queue->prod_head);
+        prod_next = (prod_head + 1) & (int) na_sm_queue->prod_mask;
+        cons_tail = hg_atomic_get32(&na_sm_queue->cons_tail);
+
+        if (prod_next == cons_tail) {
+            hg_atomic_fence();
+            if (prod_head == hg_atomic_get32(&na_sm_queue->prod_head) &&
+                cons_tail == hg_atomic_get32(&na_sm_queue->cons_tail)) {
+                na_sm_queue->drops++;
+                /* Full */
+                return false;
+            }
+            continue;
+        }
+    } while (!hg_atomic_cas32(&na_sm_queue->prod_head, prod_head, prod_next));
+
+    hg_atomic_set64(&na_sm_queue->ring[prod_head], (int64_t) msg_hdr->val);
+
+    /*
+     * If there are other enqueues in progress
+     * that preceded us, we need to wait for them
+     * to complete
+     */
+    while (hg_atomic_get32(&na_sm_queue->prod_tail) != prod_head)
+        cpu_spinwait();
+
+    hg_atomic_set32(&na_sm_queue->prod_tail, prod_next);
+
+    return true;
+}
+
+/*---------------------------------------------------------------------------*/
+static NA_INLINE bool
+na_sm_msg_queue_pop(
+    struct na_sm_msg_queue *na_sm_queue, union na_sm_msg_hdr *msg_hdr)
+{
+    int32_t cons_head, cons_next;
+
+    do {
+        cons_head = hg_atomic_get32(&na_sm_queue->cons_head);
+        cons_next = (cons_head + 1) & (int) na_sm_queue->cons_mask;
+
+        if (cons_head == hg_atomic_get32(&na_sm_queue->prod_tail))
+            return false;
+    } while (!hg_atomic_cas32(&na_sm_queue->cons_head, cons_head, cons_next));
+
+    msg_hdr->val = (uint64_t) hg_atomic_get64(&na_sm_queue->ring[cons_head]);
+
+    /*
+     * If there are other dequeues in progress
+     * that preceded us, we need to wait for them
+     * to complete
+     */
+    while (hg_atomic_get32(&na_sm_queue->cons_tail) != cons_head)
+        cpu_spinwait();
+
+    hg_atomic_set32(&na_sm_queue->cons_tail, cons_next);
+
+    return true;
+}
+
+/*---------------------------------------------------------------------------*/
+static NA_INLINE bool
 na_sm_msg_queue_is_empty(struct na_sm_msg_queue *na_sm_queue)
 {
     return (hg_atomic_get32(&na_sm_queue->cons_head) ==
             hg_atomic_get32(&na_sm_queue->prod_tail));
 }
 
+/*---------------------------------------------------------------------------*/
+static NA_INLINE void
+na_sm_doorbell_ring(struct na_sm_region *na_sm_region, uint16_t idx)
+{
+    unsigned int seg = idx / NA_SM_QUEUE_PAIR_SEG_SIZE;
+
+    /* Ring the pair's bit first, the owner clears the segment bit before
+     * looking at the pair bits so that no ring can be missed */
+    hg_atomic_or64(&na_sm_region->doorbell[seg].val,
+        (int64_t) 1 << (idx % NA_SM_QUEUE_PAIR_SEG_SIZE));
+    hg_atomic_or64(&na_sm_region->doorbell_segs.val, (int64_t) 1 << seg);
+}
+
 /*---------------------------------------------------------------------------*/
 static void
 na_sm_cmd_queue_init(struct na_sm_cmd_queue *na_sm_queue)
@@ -1562,19 +2194,21 @@ na_sm_cmd_queue_pop(
 }
 
 /*---------------------------------------------------------------------------*/
-static NA_INLINE unsigned int
-na_sm_addr_key_hash(hg_hash_table_key_t key)
+static unsigned int
+na_sm_addr_key_hash(const void *key)
 {
     /* Hashing through PIDs should be sufficient in practice */
-    return (unsigned int) ((struct na_sm_addr_key *) key)->pid;
+    return (unsigned int) ((const struct na_sm_addr_key *) key)->pid;
 }
 
 /*---------------------------------------------------------------------------*/
-static NA_INLINE int
-na_sm_addr_key_equal(hg_hash_table_key_t key1, hg_hash_table_key_t key2)
+static int
+na_sm_addr_key_equal(const void *key1, const void *key2)
 {
-    struct na_sm_addr_key *addr_key1 = (struct na_sm_addr_key *) key1,
-                          *addr_key2 = (struct na_sm_addr_key *) key2;
+    const struct na_sm_addr_key *addr_key1 =
+        (const struct na_sm_addr_key *) key1;
+    const struct na_sm_addr_key *addr_key2 =
+        (const struct na_sm_addr_key *) key2;
 
     return (addr_key1->pid == addr_key2->pid && addr_key1->id == addr_key2->id);
 }
@@ -1632,24 +2266,27 @@ na_sm_region_open(const char *uri, bool create, struct na_sm_region **region_p)
     if (create) {
         int i;
 
-        /* Initialize copy buf (all buffers are available by default) */
-        hg_atomic_init64(
-            &na_sm_region->copy_bufs.available.val, ~((int64_t) 0));
-        memset(&na_sm_region->copy_bufs.buf, 0,
-            sizeof(na_sm_region->copy_bufs.buf));
+        /* Initialize copy buf (all buffers are available by default), the
+         * arena itself is zero-filled by the newly created shm object so
+         * leave its pages untouched until they are needed */
+        for (i = 0; i < NA_SM_NUM_BUF_CLASSES; i++)
+            hg_atomic_init64(&na_sm_region->copy_bufs.available[i].val,
+                (na_sm_buf_classes_g[i].count == 64)
+                    ? ~((int64_t) 0)
+                    : (((int64_t) 1 << na_sm_buf_classes_g[i].count) - 1));
 
         /* Initialize locks */
         for (i = 0; i < NA_SM_NUM_BUFS; i++)
             hg_thread_spin_init(&na_sm_region->copy_bufs.buf_locks[i]);
 
-        /* Initialize queue pairs */
-        for (i = 0; i < 4; i++)
-            hg_atomic_init64(&na_sm_region->available.val[i], ~((int64_t) 0));
-
-        for (i = 0; i < NA_SM_MAX_PEERS; i++) {
-            na_sm_msg_queue_init(&na_sm_region->queue_pairs[i].rx_queue);
-            na_sm_msg_queue_init(&na_sm_region->queue_pairs[i].tx_queue);
+        /* Initialize queue pairs (queues themselves are initialized by the
+         * peer that reserves them so that segments can be mapped lazily) */
+        for (i = 0; i < NA_SM_NUM_QUEUE_PAIR_SEGS; i++) {
+            hg_atomic_init64(&na_sm_region->available[i].val, ~((int64_t) 0));
+            hg_atomic_init64(&na_sm_region->doorbell[i].val, 0);
         }
+        hg_atomic_init64(&na_sm_region->queue_pair_segs.val, 1);
+        hg_atomic_init64(&na_sm_region->doorbell_segs.val, 0);
 
         /* Initialize command queue */
         na_sm_cmd_queue_init(&na_sm_region->cmd_queue);
@@ -1670,8 +2307,22 @@ na_sm_region_close(const char *uri, struct na_sm_region *region)
     na_return_t ret = NA_SUCCESS;
 
     if (uri) {
+        int64_t segs = hg_atomic_get64(&region->queue_pair_segs.val) & ~1;
+        int rc;
+
+        /* Remove queue pair segments created by peers */
+        while (segs) {
+            unsigned int seg =
+                (unsigned int) __builtin_ctzll((unsigned long long) segs);
+            na_return_t err_ret = na_sm_queue_pair_seg_unmap(uri, seg, NULL);
+
+            NA_CHECK_SUBSYS_ERROR_DONE(cls, err_ret != NA_SUCCESS,
+                "Could not remove queue pair segment %u", seg);
+            segs &= segs - 1;
+        }
+
         /* Generate SHM object name */
-        int rc = NA_SM_PRINT_SHM_NAME(filename, NA_SM_MAX_FILENAME, uri);
+        rc = NA_SM_PRINT_SHM_NAME(filename, NA_SM_MAX_FILENAME, uri);
         NA_CHECK_SUBSYS_ERROR(cls, rc < 0 || rc > NA_SM_MAX_FILENAME, done, ret,
             NA_OVERFLOW, "NA_SM_PRINT_SHM_NAME() failed, rc: %d", rc);
         filename_p = filename;
@@ -1719,6 +2370,79 @@ done:
     return ret;
 }
 
+/*---------------------------------------------------------------------------*/
+static na_return_t
+na_sm_queue_pair_seg_map(const char *uri, struct na_sm_region *region,
+    unsigned int seg, bool create, struct na_sm_queue_pair_seg **seg_p)
+{
+    char filename[NA_SM_MAX_FILENAME];
+    struct na_sm_queue_pair_seg *na_sm_queue_pair_seg = NULL;
+    na_return_t ret = NA_SUCCESS;
+    int rc;
+
+    if (seg == 0) {
+        *seg_p = &region->queue_pair_seg;
+        goto done;
+    }
+
+    /* Generate SHM object name */
+    rc = NA_SM_PRINT_QUEUE_PAIR_SHM_NAME(
+        filename, NA_SM_MAX_FILENAME, uri, seg);
+    NA_CHECK_SUBSYS_ERROR(addr, rc < 0 || rc > NA_SM_MAX_FILENAME, done, ret,
+        NA_OVERFLOW, "NA_SM_PRINT_QUEUE_PAIR_SHM_NAME() failed, rc: %d", rc);
+
+    /* Open SHM object, concurrent peers may create it at the same time */
+    NA_LOG_SUBSYS_DEBUG(addr, "shm_map() %s", filename);
+    na_sm_queue_pair_seg = (struct na_sm_queue_pair_seg *) na_sm_shm_map(
+        filename, sizeof(struct na_sm_queue_pair_seg), create);
+    NA_CHECK_SUBSYS_ERROR(addr, na_sm_queue_pair_seg == NULL, done, ret,
+        NA_NODEV, "Could not map queue pair segment (%s)", filename);
+
+    /* Let the owner of the region know that it must remove the segment */
+    if (create)
+        hg_atomic_or64(&region->queue_pair_segs.val, (int64_t) 1 << seg);
+
+    *seg_p = na_sm_queue_pair_seg;
+
+done:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static na_return_t
+na_sm_queue_pair_seg_unmap(
+    const char *uri, unsigned int seg, struct na_sm_queue_pair_seg *seg_addr)
+{
+    char filename[NA_SM_MAX_FILENAME];
+    char *filename_p = NULL;
+    na_return_t ret = NA_SUCCESS;
+
+    /* First segment is part of the region */
+    if (seg == 0)
+        goto done;
+
+    if (uri) {
+        /* Generate SHM object name */
+        int rc = NA_SM_PRINT_QUEUE_PAIR_SHM_NAME(
+            filename, NA_SM_MAX_FILENAME, uri, seg);
+        NA_CHECK_SUBSYS_ERROR(addr, rc < 0 || rc > NA_SM_MAX_FILENAME, done,
+            ret, NA_OVERFLOW,
+            "NA_SM_PRINT_QUEUE_PAIR_SHM_NAME() failed, rc: %d", rc);
+        filename_p = filename;
+    }
+
+    NA_LOG_SUBSYS_DEBUG(
+        addr, "shm_unmap() %s", (filename_p == NULL) ? "is NULL" : filename_p);
+    ret = na_sm_shm_unmap(filename_p, seg_addr,
+        (seg_addr == NULL) ? 0 : sizeof(struct na_sm_queue_pair_seg));
+    NA_CHECK_SUBSYS_NA_ERROR(addr, done, ret,
+        "Could not unmap queue pair segment (%s)",
+        (filename_p == NULL) ? "is NULL" : filename_p);
+
+done:
+    return ret;
+}
+
 /*---------------------------------------------------------------------------*/
 static na_return_t
 na_sm_sock_open(const char *uri, bool create, int *sock)
@@ -1916,7 +2640,7 @@ na_sm_sock_path_cleanup(const char *fpath, const struct stat NA_UNUSED *sb,
 
 /*---------------------------------------------------------------------------*/
 static na_return_t
-na_sm_event_create(const char NA_UNUSED *uri, uint8_t NA_UNUSED pair_index,
+na_sm_event_create(const char NA_UNUSED *uri, uint16_t NA_UNUSED pair_index,
     unsigned char NA_UNUSED pair, int *event)
 {
     na_return_t ret = NA_SUCCESS;
@@ -1976,7 +2700,7 @@ error:
 
 /*---------------------------------------------------------------------------*/
 static na_return_t
-na_sm_event_destroy(const char NA_UNUSED *uri, uint8_t NA_UNUSED pair_index,
+na_sm_event_destroy(const char NA_UNUSED *uri, uint16_t NA_UNUSED pair_index,
     unsigned char NA_UNUSED pair, bool NA_UNUSED remove, int event)
 {
     na_return_t ret = NA_SUCCESS;
@@ -2107,7 +2831,7 @@ na_sm_endpoint_open(struct na_sm_endpoint *na_sm_endpoint, const char *name,
     struct na_sm_addr_key addr_key = {0, 0};
     struct na_sm_region *shared_region = NULL;
     char uri[NA_SM_MAX_FILENAME], *uri_p = NULL;
-    uint8_t queue_pair_idx = 0;
+    uint16_t queue_pair_idx = 0;
     bool queue_pair_reserved = false, sock_registered = false,
          tx_notify_registered = false;
     int tx_notify = -1, rx_notify = -1;
@@ -2140,6 +2864,9 @@ na_sm_endpoint_open(struct na_sm_endpoint *na_sm_endpoint, const char *name,
     HG_QUEUE_INIT(&na_sm_endpoint->retry_op_queue.queue);
     hg_thread_spin_init(&na_sm_endpoint->retry_op_queue.lock);
 
+    HG_QUEUE_INIT(&na_sm_endpoint->rma_op_queue.queue);
+    hg_thread_spin_init(&na_sm_endpoint->rma_op_queue.lock);
+
     /* Initialize number of fds */
     hg_atomic_init32(&na_sm_endpoint->nofile, 0);
     na_sm_endpoint->nofile_max = nofile_max;
@@ -2147,13 +2874,16 @@ na_sm_endpoint_open(struct na_sm_endpoint *na_sm_endpoint, const char *name,
     /* Initialize poll addr list */
     HG_LIST_INIT(&na_sm_endpoint->poll_addr_list.list);
     hg_thread_spin_init(&na_sm_endpoint->poll_addr_list.lock);
+    memset(na_sm_endpoint->doorbell_addrs, 0,
+        sizeof(na_sm_endpoint->doorbell_addrs));
 
-    /* Create addr hash-table */
+    /* Create addr hash-map */
     na_sm_endpoint->addr_map.map =
-        hg_hash_table_new(na_sm_addr_key_hash, na_sm_addr_key_equal);
+        hg_hash_map_new(sizeof(struct na_sm_addr_key), na_sm_addr_key_hash,
+            na_sm_addr_key_equal);
     NA_CHECK_SUBSYS_ERROR(cls, na_sm_endpoint->addr_map.map == NULL, error, ret,
-        NA_NOMEM, "hg_hash_table_new() failed");
-    hg_thread_rwlock_init(&na_sm_endpoint->addr_map.lock);
+        NA_NOMEM, "hg_hash_map_new() failed");
+    hg_thread_mutex_init(&na_sm_endpoint->addr_map.lock);
 
     if (listen) {
         /* Create URI */
@@ -2186,11 +2916,16 @@ na_sm_endpoint_open(struct na_sm_endpoint *na_sm_endpoint, const char *name,
         /* Keep addr key in shared-region in case URI does not have PID/ID */
         shared_region->addr_key = addr_key;
 
-        /* Reserve queue pair for loopback */
+        /* Reserve queue pair for loopback, the region was just created so
+         * it always lands in the first segment */
         ret = na_sm_queue_pair_reserve(shared_region, &queue_pair_idx);
         NA_CHECK_SUBSYS_NA_ERROR(
             cls, error, ret, "Could not reserve queue pair");
         queue_pair_reserved = true;
+        na_sm_endpoint->queue_pair_segs[0] = &shared_region->queue_pair_seg;
+        na_sm_msg_queue_init(
+            &NA_SM_QUEUE_PAIR(&shared_region->queue_pair_seg, queue_pair_idx)
+                 ->tx_queue);
     }
 
     if (!no_wait) {
@@ -2240,9 +2975,12 @@ na_sm_endpoint_open(struct na_sm_endpoint *na_sm_endpoint, const char *name,
     if (listen) {
         na_sm_endpoint->source_addr->queue_pair_idx = queue_pair_idx;
         na_sm_endpoint->source_addr->shared_region = shared_region;
+        na_sm_endpoint->source_addr->queue_pair_seg =
+            &shared_region->queue_pair_seg;
 
         na_sm_endpoint->source_addr->tx_queue =
-            &shared_region->queue_pairs[queue_pair_idx].tx_queue;
+            &NA_SM_QUEUE_PAIR(&shared_region->queue_pair_seg, queue_pair_idx)
+                 ->tx_queue;
         /* Tx = Rx for loopback */
         na_sm_endpoint->source_addr->rx_queue =
             na_sm_endpoint->source_addr->tx_queue;
@@ -2273,10 +3011,11 @@ na_sm_endpoint_open(struct na_sm_endpoint *na_sm_endpoint, const char *name,
     hg_atomic_or32(&na_sm_endpoint->source_addr->status, NA_SM_ADDR_RESOLVED);
 
     if (listen) {
-        /* Add address to list of addresses to poll */
+        /* Loopback messages are pushed to our own region, poll them through
+         * the doorbell */
         hg_thread_spin_lock(&na_sm_endpoint->poll_addr_list.lock);
-        HG_LIST_INSERT_HEAD(&na_sm_endpoint->poll_addr_list.list,
-            na_sm_endpoint->source_addr, entry);
+        na_sm_endpoint->doorbell_addrs[queue_pair_idx] =
+            na_sm_endpoint->source_addr;
         hg_thread_spin_unlock(&na_sm_endpoint->poll_addr_list.lock);
     }
 
@@ -2315,19 +3054,22 @@ error:
         hg_poll_destroy(na_sm_endpoint->poll_set);
         hg_atomic_decr32(&na_sm_endpoint->nofile);
     }
-    if (queue_pair_reserved)
+    if (queue_pair_reserved) {
         na_sm_queue_pair_release(shared_region, queue_pair_idx);
+        na_sm_endpoint->queue_pair_segs[0] = NULL;
+    }
     if (shared_region)
         na_sm_region_close(uri_p, shared_region);
     if (na_sm_endpoint->addr_map.map) {
-        hg_hash_table_free(na_sm_endpoint->addr_map.map);
-        hg_thread_rwlock_destroy(&na_sm_endpoint->addr_map.lock);
+        hg_hash_map_free(na_sm_endpoint->addr_map.map);
+        hg_thread_mutex_destroy(&na_sm_endpoint->addr_map.lock);
     }
 
     hg_thread_spin_destroy(&na_sm_endpoint->unexpected_msg_queue.lock);
     hg_thread_spin_destroy(&na_sm_endpoint->unexpected_op_queue.lock);
     hg_thread_spin_destroy(&na_sm_endpoint->expected_op_queue.lock);
     hg_thread_spin_destroy(&na_sm_endpoint->retry_op_queue.lock);
+    hg_thread_spin_destroy(&na_sm_endpoint->rma_op_queue.lock);
     hg_thread_spin_destroy(&na_sm_endpoint->poll_addr_list.lock);
 
     return ret;
@@ -2340,6 +3082,16 @@ na_sm_endpoint_close(struct na_sm_endpoint *na_sm_endpoint)
     struct na_sm_addr *source_addr = na_sm_endpoint->source_addr;
     na_return_t ret = NA_SUCCESS;
     bool empty;
+    int i;
+
+    /* Destroy remaining addresses polled through the doorbell */
+    for (i = 0; i < NA_SM_MAX_PEERS; i++) {
+        struct na_sm_addr *na_sm_addr = na_sm_endpoint->doorbell_addrs[i];
+
+        na_sm_endpoint->doorbell_addrs[i] = NULL;
+        if (na_sm_addr && na_sm_addr != source_addr)
+            na_sm_addr_destroy(na_sm_addr);
+    }
 
     /* Check that poll addr list is empty */
     empty = HG_LIST_IS_EMPTY(&na_sm_endpoint->poll_addr_list.list);
@@ -2383,11 +3135,31 @@ na_sm_endpoint_close(struct na_sm_endpoint *na_sm_endpoint)
     NA_CHECK_SUBSYS_ERROR(cls, empty == false, done, ret, NA_BUSY,
         "Retry op queue should be empty");
 
+    /* Check that RMA op queue is empty */
+    empty = HG_QUEUE_IS_EMPTY(&na_sm_endpoint->rma_op_queue.queue);
+    NA_CHECK_SUBSYS_ERROR(cls, empty == false, done, ret, NA_BUSY,
+        "RMA op queue should be empty");
+
     if (source_addr) {
         if (source_addr->shared_region) {
             na_sm_queue_pair_release(
                 source_addr->shared_region, source_addr->queue_pair_idx);
 
+            /* Unmap queue pair segments that peers have reserved pairs in */
+            for (i = 1; i < NA_SM_NUM_QUEUE_PAIR_SEGS; i++) {
+                struct na_sm_queue_pair_seg *na_sm_queue_pair_seg =
+                    na_sm_endpoint->queue_pair_segs[i];
+
+                if (na_sm_queue_pair_seg == NULL)
+                    continue;
+                ret = na_sm_queue_pair_seg_unmap(
+                    NULL, (unsigned int) i, na_sm_queue_pair_seg);
+                NA_CHECK_SUBSYS_NA_ERROR(
+                    cls, done, ret, "na_sm_queue_pair_seg_unmap() failed");
+                na_sm_endpoint->queue_pair_segs[i] = NULL;
+            }
+            na_sm_endpoint->queue_pair_segs[0] = NULL;
+
             ret = na_sm_region_close(
                 source_addr->uri, source_addr->shared_region);
             NA_CHECK_SUBSYS_NA_ERROR(
@@ -2447,10 +3219,10 @@ na_sm_endpoint_close(struct na_sm_endpoint *na_sm_endpoint)
         na_sm_endpoint->poll_set = NULL;
     }
 
-    /* Free hash table */
+    /* Free hash map */
     if (na_sm_endpoint->addr_map.map) {
-        hg_hash_table_free(na_sm_endpoint->addr_map.map);
-        hg_thread_rwlock_destroy(&na_sm_endpoint->addr_map.lock);
+        hg_hash_map_free(na_sm_endpoint->addr_map.map);
+        hg_thread_mutex_destroy(&na_sm_endpoint->addr_map.lock);
     }
 
     /* Check that all fds have been freed */
@@ -2464,6 +3236,7 @@ na_sm_endpoint_close(struct na_sm_endpoint *na_sm_endpoint)
     hg_thread_spin_destroy(&na_sm_endpoint->unexpected_op_queue.lock);
     hg_thread_spin_destroy(&na_sm_endpoint->expected_op_queue.lock);
     hg_thread_spin_destroy(&na_sm_endpoint->retry_op_queue.lock);
+    hg_thread_spin_destroy(&na_sm_endpoint->rma_op_queue.lock);
     hg_thread_spin_destroy(&na_sm_endpoint->poll_addr_list.lock);
 
 done:
@@ -2472,17 +3245,19 @@ done:
 
 /*---------------------------------------------------------------------------*/
 static na_return_t
-na_sm_queue_pair_reserve(struct na_sm_region *na_sm_region, uint8_t *index)
+na_sm_queue_pair_reserve(struct na_sm_region *na_sm_region, uint16_t *index)
 {
     unsigned int j = 0;
 
+    /* Segments are scanned in order so that pairs are packed into the first
+     * segments and later ones only get mapped when they are needed */
     do {
         int64_t bits = (int64_t) 1;
         unsigned int i = 0;
 
         do {
             int64_t available =
-                hg_atomic_get64(&na_sm_region->available.val[j]);
+                hg_atomic_get64(&na_sm_region->available[j].val);
             if (!available) {
                 j++;
                 break;
@@ -2496,50 +3271,88 @@ na_sm_queue_pair_reserve(struct na_sm_region *na_sm_region, uint8_t *index)
                 continue;
             }
 
-            if (hg_atomic_cas64(&na_sm_region->available.val[j], available,
+            if (hg_atomic_cas64(&na_sm_region->available[j].val, available,
                     available & ~bits)) {
 #ifdef NA_HAS_DEBUG
                 char buf[65] = {'\0'};
-                available = hg_atomic_get64(&na_sm_region->available.val[j]);
+                available = hg_atomic_get64(&na_sm_region->available[j].val);
                 NA_LOG_SUBSYS_DEBUG(addr,
-                    "Reserved pair index %u\n### Available: %s", (i + (j * 64)),
+                    "Reserved pair index %u\n### Available: %s",
+                    (i + (j * NA_SM_QUEUE_PAIR_SEG_SIZE)),
                     lltoa((uint64_t) available, buf, 2));
 #endif
-                *index = (uint8_t) (i + (j * 64));
+                *index = (uint16_t) (i + (j * NA_SM_QUEUE_PAIR_SEG_SIZE));
                 return NA_SUCCESS;
             }
 
             /* Can't use atomic XOR directly, if there is a race and the cas
              * fails, we should be able to pick the next one available */
-        } while (i < 64);
-    } while (j < 4);
+        } while (i < NA_SM_QUEUE_PAIR_SEG_SIZE);
+    } while (j < NA_SM_NUM_QUEUE_PAIR_SEGS);
 
     return NA_AGAIN;
 }
 
 /*---------------------------------------------------------------------------*/
 static NA_INLINE void
-na_sm_queue_pair_release(struct na_sm_region *na_sm_region, uint8_t index)
+na_sm_queue_pair_release(struct na_sm_region *na_sm_region, uint16_t index)
 {
-    hg_atomic_or64(
-        &na_sm_region->available.val[index / 64], (int64_t) 1 << index % 64);
+    unsigned int seg = index / NA_SM_QUEUE_PAIR_SEG_SIZE;
+
+    hg_atomic_or64(&na_sm_region->available[seg].val,
+        (int64_t) 1 << (index % NA_SM_QUEUE_PAIR_SEG_SIZE));
     NA_LOG_SUBSYS_DEBUG(addr, "Released pair index %u", index);
 }
 
+/*---------------------------------------------------------------------------*/
+static na_return_t
+na_sm_endpoint_queue_pair_seg_get(struct na_sm_endpoint *na_sm_endpoint,
+    unsigned int seg, struct na_sm_queue_pair_seg **seg_p)
+{
+    struct na_sm_addr *source_addr = na_sm_endpoint->source_addr;
+    struct na_sm_queue_pair_seg *na_sm_queue_pair_seg, *cached_seg;
+    na_return_t ret;
+
+    hg_thread_spin_lock(&na_sm_endpoint->poll_addr_list.lock);
+    na_sm_queue_pair_seg = na_sm_endpoint->queue_pair_segs[seg];
+    hg_thread_spin_unlock(&na_sm_endpoint->poll_addr_list.lock);
+    if (na_sm_queue_pair_seg != NULL) {
+        *seg_p = na_sm_queue_pair_seg;
+        return NA_SUCCESS;
+    }
+
+    /* Segment was created by the peer that reserved the pair */
+    ret = na_sm_queue_pair_seg_map(source_addr->uri,
+        source_addr->shared_region, seg, false, &na_sm_queue_pair_seg);
+    NA_CHECK_SUBSYS_NA_ERROR(
+        addr, done, ret, "Could not map queue pair segment %u", seg);
+
+    /* Keep the first mapping if we raced with another thread */
+    hg_thread_spin_lock(&na_sm_endpoint->poll_addr_list.lock);
+    cached_seg = na_sm_endpoint->queue_pair_segs[seg];
+    if (cached_seg == NULL)
+        na_sm_endpoint->queue_pair_segs[seg] = na_sm_queue_pair_seg;
+    hg_thread_spin_unlock(&na_sm_endpoint->poll_addr_list.lock);
+    if (cached_seg != NULL) {
+        ret = na_sm_queue_pair_seg_unmap(NULL, seg, na_sm_queue_pair_seg);
+        NA_CHECK_SUBSYS_NA_ERROR(
+            addr, done, ret, "Could not unmap queue pair segment %u", seg);
+        na_sm_queue_pair_seg = cached_seg;
+    }
+
+    *seg_p = na_sm_queue_pair_seg;
+
+done:
+    return ret;
+}
+
 /*---------------------------------------------------------------------------*/
 static NA_INLINE struct na_sm_addr *
 na_sm_addr_map_lookup(
     struct na_sm_map *na_sm_map, struct na_sm_addr_key *addr_key)
 {
-    hg_hash_table_value_t value = NULL;
-
-    /* Lookup key */
-    hg_thread_rwlock_rdlock(&na_sm_map->lock);
-    value =
-        hg_hash_table_lookup(na_sm_map->map, (hg_hash_table_key_t) addr_key);
-    hg_thread_rwlock_release_rdlock(&na_sm_map->lock);
-
-    return (value == HG_HASH_TABLE_NULL) ? NULL : (struct na_sm_addr *) value;
+    /* Lookup key (lock-free) */
+    return (struct na_sm_addr *) hg_hash_map_lookup(na_sm_map->map, addr_key);
 }
 
 /*---------------------------------------------------------------------------*/
@@ -2552,11 +3365,11 @@ na_sm_addr_map_insert(struct na_sm_endpoint *na_sm_endpoint,
     na_return_t ret = NA_SUCCESS;
     int rc;
 
-    hg_thread_rwlock_wrlock(&na_sm_map->lock);
+    hg_thread_mutex_lock(&na_sm_map->lock);
 
-    /* Look up again to prevent race between lock release/acquire */
-    na_sm_addr = (struct na_sm_addr *) hg_hash_table_lookup(
-        na_sm_map->map, (hg_hash_table_key_t) addr_key);
+    /* Look up again to prevent race with other inserts */
+    na_sm_addr =
+        (struct na_sm_addr *) hg_hash_map_lookup(na_sm_map->map, addr_key);
     if (na_sm_addr) {
         ret = NA_EXIST; /* Entry already exists */
         goto done;
@@ -2567,21 +3380,19 @@ na_sm_addr_map_insert(struct na_sm_endpoint *na_sm_endpoint,
     NA_CHECK_SUBSYS_NA_ERROR(addr, error, ret, "Could not allocate address");
 
     /* Insert new value */
-    rc = hg_hash_table_insert(na_sm_map->map,
-        (hg_hash_table_key_t) &na_sm_addr->addr_key,
-        (hg_hash_table_value_t) na_sm_addr);
-    NA_CHECK_SUBSYS_ERROR(
-        addr, rc == 0, error, ret, NA_NOMEM, "hg_hash_table_insert() failed");
+    rc = hg_hash_map_insert(na_sm_map->map, &na_sm_addr->addr_key, na_sm_addr);
+    NA_CHECK_SUBSYS_ERROR(addr, rc != HG_UTIL_SUCCESS, error, ret, NA_NOMEM,
+        "hg_hash_map_insert() failed");
 
 done:
-    hg_thread_rwlock_release_wrlock(&na_sm_map->lock);
+    hg_thread_mutex_unlock(&na_sm_map->lock);
 
     *na_sm_addr_p = na_sm_addr;
 
     return ret;
 
 error:
-    hg_thread_rwlock_release_wrlock(&na_sm_map->lock);
+    hg_thread_mutex_unlock(&na_sm_map->lock);
     if (na_sm_addr)
         na_sm_addr_destroy(na_sm_addr);
 
@@ -2593,21 +3404,10 @@ static na_return_t
 na_sm_addr_map_remove(
     struct na_sm_map *na_sm_map, struct na_sm_addr_key *addr_key)
 {
-    na_return_t ret = NA_SUCCESS;
-    int rc;
-
-    hg_thread_rwlock_wrlock(&na_sm_map->lock);
-    if (hg_hash_table_lookup(na_sm_map->map, (hg_hash_table_key_t) addr_key) ==
-        HG_HASH_TABLE_NULL)
-        goto unlock;
-
-    rc = hg_hash_table_remove(na_sm_map->map, (hg_hash_table_key_t) addr_key);
-    NA_CHECK_SUBSYS_ERROR_DONE(addr, rc == 0, "Could not remove key");
-
-unlock:
-    hg_thread_rwlock_release_wrlock(&na_sm_map->lock);
+    /* Removals are serialized by the map itself */
+    (void) hg_hash_map_remove(na_sm_map->map, addr_key);
 
-    return ret;
+    return NA_SUCCESS;
 }
 
 /*---------------------------------------------------------------------------*/
@@ -2697,9 +3497,15 @@ na_sm_addr_ref_decr(struct na_sm_addr *na_sm_addr)
         na_sm_addr->addr_key.pid, na_sm_addr->addr_key.id);
 
     if (resolved) {
-        /* Remove address from list of addresses to poll */
+        /* Remove address from addresses to poll */
         hg_thread_spin_lock(&na_sm_endpoint->poll_addr_list.lock);
-        HG_LIST_REMOVE(na_sm_addr, entry);
+        if (na_sm_addr->unexpected) {
+            if (na_sm_endpoint->doorbell_addrs[na_sm_addr->queue_pair_idx] ==
+                na_sm_addr)
+                na_sm_endpoint->doorbell_addrs[na_sm_addr->queue_pair_idx] =
+                    NULL;
+        } else
+            HG_LIST_REMOVE(na_sm_addr, entry);
         hg_thread_spin_unlock(&na_sm_endpoint->poll_addr_list.lock);
     }
 
@@ -2730,26 +3536,39 @@ na_sm_addr_resolve(struct na_sm_addr *na_sm_addr)
 
     /* Reserve queue pair */
     if (!(hg_atomic_get32(&na_sm_addr->status) & NA_SM_ADDR_RESERVED)) {
+        struct na_sm_queue_pair *na_sm_queue_pair;
+
         ret = na_sm_queue_pair_reserve(
             na_sm_addr->shared_region, &na_sm_addr->queue_pair_idx);
         NA_CHECK_SUBSYS_NA_ERROR(
             addr, error, ret, "Could not reserve queue pair");
         hg_atomic_or32(&na_sm_addr->status, NA_SM_ADDR_RESERVED);
 
+        /* Map (and create if needed) the segment that the pair belongs to */
+        ret = na_sm_queue_pair_seg_map(na_sm_addr->uri,
+            na_sm_addr->shared_region,
+            na_sm_addr->queue_pair_idx / NA_SM_QUEUE_PAIR_SEG_SIZE, true,
+            &na_sm_addr->queue_pair_seg);
+        NA_CHECK_SUBSYS_NA_ERROR(
+            addr, error, ret, "Could not map queue pair segment");
+
+        /* Pairs are initialized by the peer that reserves them, the owner of
+         * the region only accesses them once it has processed our cmd */
+        na_sm_queue_pair = NA_SM_QUEUE_PAIR(
+            na_sm_addr->queue_pair_seg, na_sm_addr->queue_pair_idx);
+        na_sm_msg_queue_init(&na_sm_queue_pair->tx_queue);
+        na_sm_msg_queue_init(&na_sm_queue_pair->rx_queue);
+
         /* Keep tx/rx queues for convenience */
-        na_sm_addr->tx_queue =
-            &na_sm_addr->shared_region->queue_pairs[na_sm_addr->queue_pair_idx]
-                 .tx_queue;
-        na_sm_addr->rx_queue =
-            &na_sm_addr->shared_region->queue_pairs[na_sm_addr->queue_pair_idx]
-                 .rx_queue;
+        na_sm_addr->tx_queue = &na_sm_queue_pair->tx_queue;
+        na_sm_addr->rx_queue = &na_sm_queue_pair->rx_queue;
     }
 
     /* Fill cmd header */
     cmd_hdr = (union na_sm_cmd_hdr){.hdr.type = NA_SM_RESERVED,
         .hdr.pid = (unsigned int) na_sm_endpoint->source_addr->addr_key.pid,
         .hdr.id = na_sm_endpoint->source_addr->addr_key.id & 0xff,
-        .hdr.pair_idx = na_sm_addr->queue_pair_idx & 0xff};
+        .hdr.pair_idx = na_sm_addr->queue_pair_idx & 0xffff};
 
     NA_LOG_SUBSYS_DEBUG(addr, "Pushing cmd with %d for %d/%u/%u val=%" PRIu64,
         cmd_hdr.hdr.type, cmd_hdr.hdr.pid, cmd_hdr.hdr.id, cmd_hdr.hdr.pair_idx,
@@ -2823,6 +3642,15 @@ error:
                 na_sm_addr->shared_region, na_sm_addr->queue_pair_idx);
             hg_atomic_and32(&na_sm_addr->status, ~NA_SM_ADDR_RESERVED);
 
+            if (na_sm_addr->queue_pair_seg) {
+                err_ret = na_sm_queue_pair_seg_unmap(NULL,
+                    na_sm_addr->queue_pair_idx / NA_SM_QUEUE_PAIR_SEG_SIZE,
+                    na_sm_addr->queue_pair_seg);
+                NA_CHECK_SUBSYS_ERROR_DONE(addr, err_ret != NA_SUCCESS,
+                    "na_sm_queue_pair_seg_unmap() failed");
+                na_sm_addr->queue_pair_seg = NULL;
+            }
+
             if (na_sm_addr->tx_notify > 0) {
                 err_ret = na_sm_event_destroy(na_sm_addr->uri,
                     na_sm_addr->queue_pair_idx, 't', true,
@@ -2870,7 +3698,7 @@ na_sm_addr_release(struct na_sm_addr *na_sm_addr)
         cmd_hdr = (union na_sm_cmd_hdr){.hdr.type = NA_SM_RELEASED,
             .hdr.pid = (unsigned int) na_sm_endpoint->source_addr->addr_key.pid,
             .hdr.id = na_sm_endpoint->source_addr->addr_key.id & 0xff,
-            .hdr.pair_idx = na_sm_addr->queue_pair_idx & 0xff};
+            .hdr.pair_idx = na_sm_addr->queue_pair_idx & 0xffff};
 
         if (na_sm_endpoint->poll_set) {
             /* Send events to remote process (silence error as this is best
@@ -2894,6 +3722,13 @@ na_sm_addr_release(struct na_sm_addr *na_sm_addr)
                 addr, rc == false, done, ret, NA_AGAIN, "Full queue");
         }
 
+        /* Unmap queue pair segment */
+        ret = na_sm_queue_pair_seg_unmap(NULL,
+            na_sm_addr->queue_pair_idx / NA_SM_QUEUE_PAIR_SEG_SIZE,
+            na_sm_addr->queue_pair_seg);
+        NA_CHECK_SUBSYS_NA_ERROR(
+            addr, done, ret, "Could not unmap queue pair segment");
+
         /* Close shared-memory region */
         ret = na_sm_region_close(NULL, na_sm_addr->shared_region);
         NA_CHECK_SUBSYS_NA_ERROR(
@@ -3068,10 +3903,15 @@ na_sm_msg_send(struct na_sm_class *na_sm_class, na_context_t *context,
     size_t buf_size, struct na_sm_addr *na_sm_addr, na_tag_t tag,
     struct na_sm_op_id *na_sm_op_id)
 {
+    size_t size_max = (cb_type == NA_CB_SEND_UNEXPECTED)
+                          ? na_sm_class->unexpected_size_max
+                          : na_sm_class->expected_size_max;
     na_return_t ret;
 
-    NA_CHECK_SUBSYS_ERROR(msg, buf_size > NA_SM_COPY_BUF_SIZE, error, ret,
-        NA_OVERFLOW, "Exceeds copy buf size, %zu", buf_size);
+    NA_CHECK_SUBSYS_ERROR(msg, buf_size > size_max, error, ret, NA_OVERFLOW,
+        "Exceeds max %s size, %zu > %zu",
+        (cb_type == NA_CB_SEND_UNEXPECTED) ? "unexpected" : "expected",
+        buf_size, size_max);
 
     /* Check op_id */
     NA_CHECK_SUBSYS_ERROR(op, na_sm_op_id == NULL, error, ret, NA_INVALID_ARG,
@@ -3137,8 +3977,8 @@ na_sm_msg_send_post(struct na_sm_endpoint *na_sm_endpoint, na_cb_type_t cb_type,
     /* No need to reserve for 0-size messages */
     if (buf_size > 0) {
         /* Try to reserve buffer atomically */
-        ret =
-            na_sm_buf_reserve(&na_sm_addr->shared_region->copy_bufs, &buf_idx);
+        ret = na_sm_buf_reserve(
+            &na_sm_addr->shared_region->copy_bufs, buf_size, &buf_idx);
         if (unlikely(ret == NA_AGAIN))
             return NA_AGAIN;
 
@@ -3149,13 +3989,23 @@ na_sm_msg_send_post(struct na_sm_endpoint *na_sm_endpoint, na_cb_type_t cb_type,
 
     /* Post message to queue */
     msg_hdr = (union na_sm_msg_hdr){.hdr.type = cb_type,
-        .hdr.buf_idx = buf_idx & 0xff,
-        .hdr.buf_size = buf_size & 0xffff,
+        .hdr.buf_idx = buf_idx & 0x7f,
+        .hdr.buf_size = buf_size & 0x1fffff,
         .hdr.tag = tag};
 
     rc = na_sm_msg_queue_push(na_sm_addr->tx_queue, &msg_hdr);
-    NA_CHECK_SUBSYS_ERROR(
-        msg, rc == false, release, ret, NA_AGAIN, "Full queue");
+    if (unlikely(rc == false)) {
+        /* Not an error, message is retried once peer has consumed others */
+        NA_LOG_SUBSYS_DEBUG(msg, "Full queue");
+        ret = NA_AGAIN;
+        goto release;
+    }
+
+    /* Unless replying to a peer, the queue belongs to the region owner, which
+     * only polls queues whose doorbell was rung */
+    if (!na_sm_addr->unexpected)
+        na_sm_doorbell_ring(
+            na_sm_addr->shared_region, na_sm_addr->queue_pair_idx);
 
     /* Notify remote if notifications are enabled */
     if (na_sm_addr == na_sm_endpoint->source_addr &&
@@ -3180,40 +4030,60 @@ error:
 }
 
 /*---------------------------------------------------------------------------*/
-static NA_INLINE na_return_t
-na_sm_buf_reserve(struct na_sm_copy_buf *na_sm_copy_buf, unsigned int *index)
+static NA_INLINE const struct na_sm_buf_class *
+na_sm_buf_class_get(unsigned int index)
 {
-    int64_t bits = (int64_t) 1;
-    unsigned int i = 0;
+    int i;
 
-    do {
-        int64_t available = hg_atomic_get64(&na_sm_copy_buf->available.val);
-        if (!available) {
-            /* Nothing available */
+    for (i = NA_SM_NUM_BUF_CLASSES - 1; i > 0; i--)
+        if (index >= na_sm_buf_classes_g[i].index)
             break;
-        }
-        if ((available & bits) != bits) {
-            /* Already reserved */
-            hg_atomic_fence();
-            i++;
-            bits <<= 1;
+
+    return &na_sm_buf_classes_g[i];
+}
+
+/*---------------------------------------------------------------------------*/
+static NA_INLINE char *
+na_sm_buf_ptr(struct na_sm_copy_buf *na_sm_copy_buf, unsigned int index)
+{
+    const struct na_sm_buf_class *buf_class = na_sm_buf_class_get(index);
+
+    return na_sm_copy_buf->buf + buf_class->offset +
+           (index - buf_class->index) * buf_class->size;
+}
+
+/*---------------------------------------------------------------------------*/
+static NA_INLINE na_return_t
+na_sm_buf_reserve(
+    struct na_sm_copy_buf *na_sm_copy_buf, size_t size, unsigned int *index)
+{
+    unsigned int i;
+
+    /* Start from the smallest class that fits and fall back to larger
+     * classes when it is exhausted */
+    for (i = 0; i < NA_SM_NUM_BUF_CLASSES; i++) {
+        hg_atomic_int64_t *available_p = &na_sm_copy_buf->available[i].val;
+        int64_t available;
+
+        if (size > na_sm_buf_classes_g[i].size)
             continue;
-        }
 
-        if (hg_atomic_cas64(
-                &na_sm_copy_buf->available.val, available, available & ~bits)) {
-#ifdef NA_HAS_DEBUG
-            char buf[65] = {'\0'};
-            available = hg_atomic_get64(&na_sm_copy_buf->available.val);
-            NA_LOG_SUBSYS_DEBUG(msg, "Reserved bit index %u\n### Available: %s",
-                i, lltoa((uint64_t) available, buf, 2));
-#endif
-            *index = i;
-            return NA_SUCCESS;
+        /* Pick the lowest available bit directly instead of scanning, retry
+         * on the same class if the cas races with another reservation */
+        while ((available = hg_atomic_get64(available_p)) != 0) {
+            unsigned int bit =
+                (unsigned int) __builtin_ctzll((unsigned long long) available);
+
+            if (hg_atomic_cas64(available_p, available,
+                    available & ~((int64_t) 1 << bit))) {
+                *index = na_sm_buf_classes_g[i].index + bit;
+                NA_LOG_SUBSYS_DEBUG(msg,
+                    "Reserved bit index %u (class %u, size %zu)", *index, i,
+                    na_sm_buf_classes_g[i].size);
+                return NA_SUCCESS;
+            }
         }
-        /* Can't use atomic XOR directly, if there is a race and the cas
-         * fails, we should be able to pick the next one available */
-    } while (i < NA_SM_NUM_BUFS);
+    }
 
     return NA_AGAIN;
 }
@@ -3222,7 +4092,11 @@ na_sm_buf_reserve(struct na_sm_copy_buf *na_sm_copy_buf, unsigned int *index)
 static NA_INLINE void
 na_sm_buf_release(struct na_sm_copy_buf *na_sm_copy_buf, unsigned int index)
 {
-    hg_atomic_or64(&na_sm_copy_buf->available.val, (int64_t) 1 << index);
+    const struct na_sm_buf_class *buf_class = na_sm_buf_class_get(index);
+
+    hg_atomic_or64(
+        &na_sm_copy_buf->available[buf_class - na_sm_buf_classes_g].val,
+        (int64_t) 1 << (index - buf_class->index));
     NA_LOG_SUBSYS_DEBUG(msg, "Released bit index %u", index);
 }
 
@@ -3232,7 +4106,7 @@ na_sm_buf_copy_to(struct na_sm_copy_buf *na_sm_copy_buf, unsigned int index,
     const void *src, size_t n)
 {
     hg_thread_spin_lock(&na_sm_copy_buf->buf_locks[index]);
-    memcpy(na_sm_copy_buf->buf[index], src, n);
+    memcpy(na_sm_buf_ptr(na_sm_copy_buf, index), src, n);
     hg_thread_spin_unlock(&na_sm_copy_buf->buf_locks[index]);
 }
 
@@ -3242,7 +4116,7 @@ na_sm_buf_copy_from(struct na_sm_copy_buf *na_sm_copy_buf, unsigned int index,
     void *dest, size_t n)
 {
     hg_thread_spin_lock(&na_sm_copy_buf->buf_locks[index]);
-    memcpy(dest, na_sm_copy_buf->buf[index], n);
+    memcpy(dest, na_sm_buf_ptr(na_sm_copy_buf, index), n);
     hg_thread_spin_unlock(&na_sm_copy_buf->buf_locks[index]);
 }
 
@@ -3263,15 +4137,10 @@ na_sm_rma(struct na_sm_class *na_sm_class, na_context_t *context,
     unsigned long local_iov_start_index = 0, remote_iov_start_index = 0;
     na_offset_t local_iov_start_offset = 0, remote_iov_start_offset = 0;
     union na_sm_iov local_trans_iov, remote_trans_iov;
-    struct iovec *liov, *riov;
+    struct iovec *liov = NULL, *riov = NULL;
     unsigned long liovcnt = 0, riovcnt = 0;
     na_return_t ret;
 
-#if !defined(NA_SM_HAS_CMA) && !defined(__APPLE__)
-    NA_GOTO_SUBSYS_ERROR(
-        error, ret, NA_OPNOTSUPPORTED, "Not implemented for this platform");
-#endif
-
     switch (na_sm_mem_handle_remote->info.flags) {
         case NA_MEM_READ_ONLY:
             NA_CHECK_SUBSYS_ERROR(rma, cb_type == NA_CB_PUT, error, ret,
@@ -3307,81 +4176,479 @@ na_sm_rma(struct na_sm_class *na_sm_class, na_context_t *context,
         liovcnt = na_sm_iov_get_count(local_iov, local_iovcnt,
             local_iov_start_index, local_iov_start_offset, length);
 
-        if (liovcnt > NA_SM_IOV_STATIC_MAX) {
-            local_trans_iov.d =
-                (struct iovec *) malloc(liovcnt * sizeof(struct iovec));
-            NA_CHECK_SUBSYS_ERROR(rma, local_trans_iov.d == NULL, release, ret,
-                NA_NOMEM, "Could not allocate iovec");
+        if (liovcnt > NA_SM_IOV_STATIC_MAX) {
+            local_trans_iov.d =
+                (struct iovec *) malloc(liovcnt * sizeof(struct iovec));
+            NA_CHECK_SUBSYS_ERROR(rma, local_trans_iov.d == NULL, release, ret,
+                NA_NOMEM, "Could not allocate iovec");
+
+            liov = local_trans_iov.d;
+        } else
+            liov = local_trans_iov.s;
+
+        na_sm_iov_translate(local_iov, local_iovcnt, local_iov_start_index,
+            local_iov_start_offset, length, liov, liovcnt);
+    } else {
+        liov = local_iov;
+        liovcnt = local_iovcnt;
+    }
+
+    /* Translate remote offset */
+    if (remote_offset > 0)
+        na_sm_iov_get_index_offset(remote_iov, remote_iovcnt, remote_offset,
+            &remote_iov_start_index, &remote_iov_start_offset);
+
+    /* Segments of mapped memory are rebased, which requires a copy */
+    if (length != na_sm_mem_handle_remote->info.len ||
+        na_sm_mem_handle_remote->shm_addr) {
+        riovcnt = na_sm_iov_get_count(remote_iov, remote_iovcnt,
+            remote_iov_start_index, remote_iov_start_offset, length);
+
+        if (riovcnt > NA_SM_IOV_STATIC_MAX) {
+            remote_trans_iov.d =
+                (struct iovec *) malloc(riovcnt * sizeof(struct iovec));
+            NA_CHECK_SUBSYS_ERROR(rma, remote_trans_iov.d == NULL, release, ret,
+                NA_NOMEM, "Could not allocate iovec");
+
+            riov = remote_trans_iov.d;
+        } else
+            riov = remote_trans_iov.s;
+
+        na_sm_iov_translate(remote_iov, remote_iovcnt, remote_iov_start_index,
+            remote_iov_start_offset, length, riov, riovcnt);
+    } else {
+        riov = remote_iov;
+        riovcnt = remote_iovcnt;
+    }
+
+    /* Remote memory is mapped, copy it directly */
+    if (na_sm_mem_handle_remote->shm_addr) {
+        na_sm_shm_iov_rebase(na_sm_mem_handle_remote, riov, riovcnt);
+        process_vm_op =
+            (cb_type == NA_CB_PUT) ? na_sm_shm_writev : na_sm_shm_readv;
+    }
+#if !defined(NA_SM_HAS_CMA) && !defined(__APPLE__)
+    else
+        NA_GOTO_SUBSYS_ERROR(rma, release, ret, NA_OPNOTSUPPORTED,
+            "Not implemented for this platform");
+#endif
+
+    NA_LOG_SUBSYS_DEBUG(rma, "Posting rma op (op id=%p)", (void *) na_sm_op_id);
+
+    ret = na_sm_rma_post(na_sm_class, na_sm_op_id, process_vm_op, liov,
+        liovcnt, riov, riovcnt, length);
+    NA_CHECK_SUBSYS_NA_ERROR(rma, release, ret, "Could not post rma op");
+
+    if (liovcnt > NA_SM_IOV_STATIC_MAX &&
+        (length != na_sm_mem_handle_local->info.len))
+        free(local_trans_iov.d);
+    if (riovcnt > NA_SM_IOV_STATIC_MAX && riov != remote_iov)
+        free(remote_trans_iov.d);
+
+    return NA_SUCCESS;
+
+release:
+    if (liovcnt > NA_SM_IOV_STATIC_MAX &&
+        (length != na_sm_mem_handle_local->info.len))
+        free(local_trans_iov.d);
+    if (riovcnt > NA_SM_IOV_STATIC_MAX && riov != remote_iov)
+        free(remote_trans_iov.d);
+
+    NA_SM_OP_RELEASE(na_sm_op_id);
+
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static na_return_t
+na_sm_rmav(struct na_sm_class *na_sm_class, na_context_t *context,
+    na_cb_type_t cb_type, na_cb_t callback, void *arg,
+    na_sm_process_vm_op_t process_vm_op, const struct na_rma_iov *local_iov,
+    size_t local_iovcnt, const struct na_rma_iov *remote_iov,
+    size_t remote_iovcnt, struct na_sm_addr *na_sm_addr,
+    struct na_sm_op_id *na_sm_op_id)
+{
+    union na_sm_iov local_trans_iov, remote_trans_iov;
+    unsigned long liovcnt = 0, riovcnt = 0;
+    size_t local_length = 0, remote_length = 0, i;
+    na_return_t ret;
+
+#if !defined(NA_SM_HAS_CMA)
+    NA_GOTO_SUBSYS_ERROR(rma, error, ret, NA_OPNOTSUPPORTED,
+        "Vectored RMA not implemented for this platform");
+#endif
+
+    for (i = 0; i < remote_iovcnt; i++) {
+        struct na_sm_mem_handle *na_sm_mem_handle_remote =
+            (struct na_sm_mem_handle *) remote_iov[i].mem_handle;
+
+        switch (na_sm_mem_handle_remote->info.flags) {
+            case NA_MEM_READ_ONLY:
+                NA_CHECK_SUBSYS_ERROR(rma, cb_type == NA_CB_PUT, error, ret,
+                    NA_PERMISSION,
+                    "Registered memory requires write permission");
+                break;
+            case NA_MEM_WRITE_ONLY:
+                NA_CHECK_SUBSYS_ERROR(rma, cb_type == NA_CB_GET, error, ret,
+                    NA_PERMISSION,
+                    "Registered memory requires write permission");
+                break;
+            case NA_MEM_READWRITE:
+                break;
+            default:
+                NA_GOTO_SUBSYS_ERROR(rma, error, ret, NA_INVALID_ARG,
+                    "Invalid memory access flag");
+        }
+    }
+
+    /* Check op_id */
+    NA_CHECK_SUBSYS_ERROR(op, na_sm_op_id == NULL, error, ret, NA_INVALID_ARG,
+        "Invalid operation ID");
+    NA_CHECK_SUBSYS_ERROR(op,
+        !(hg_atomic_get32(&na_sm_op_id->status) & NA_SM_OP_COMPLETED), error,
+        ret, NA_BUSY, "Attempting to use OP ID that was not completed (%s)",
+        na_cb_type_to_string(na_sm_op_id->completion_data.callback_info.type));
+
+    /* Flatten local and remote segments */
+    ret = na_sm_rma_iov_translate(local_iov, local_iovcnt,
+        (unsigned long) na_sm_class->iov_max, &local_trans_iov, &liovcnt,
+        &local_length);
+    NA_CHECK_SUBSYS_NA_ERROR(rma, error, ret, "Could not translate local IOV");
+
+    ret = na_sm_rma_iov_translate(remote_iov, remote_iovcnt,
+        (unsigned long) na_sm_class->iov_max, &remote_trans_iov, &riovcnt,
+        &remote_length);
+    NA_CHECK_SUBSYS_NA_ERROR(
+        rma, release_local, ret, "Could not translate remote IOV");
+
+    NA_CHECK_SUBSYS_ERROR(rma, local_length != remote_length, release, ret,
+        NA_INVALID_ARG,
+        "Local length (%zu) does not match remote length (%zu)", local_length,
+        remote_length);
+
+    NA_SM_OP_RESET(na_sm_op_id, context, cb_type, callback, arg, na_sm_addr);
+
+    NA_LOG_SUBSYS_DEBUG(rma,
+        "Posting vectored rma op (op id=%p, liovcnt=%lu, riovcnt=%lu)",
+        (void *) na_sm_op_id, liovcnt, riovcnt);
+
+    /* Single completion for all the segments */
+    ret = na_sm_rma_post(na_sm_class, na_sm_op_id, process_vm_op,
+        (liovcnt > NA_SM_IOV_STATIC_MAX) ? local_trans_iov.d
+                                         : local_trans_iov.s,
+        liovcnt,
+        (riovcnt > NA_SM_IOV_STATIC_MAX) ? remote_trans_iov.d
+                                         : remote_trans_iov.s,
+        riovcnt, local_length);
+    NA_CHECK_SUBSYS_NA_ERROR(rma, release_op, ret, "Could not post rma op");
+
+    if (liovcnt > NA_SM_IOV_STATIC_MAX)
+        free(local_trans_iov.d);
+    if (riovcnt > NA_SM_IOV_STATIC_MAX)
+        free(remote_trans_iov.d);
+
+    return NA_SUCCESS;
+
+release_op:
+    NA_SM_OP_RELEASE(na_sm_op_id);
+release:
+    if (riovcnt > NA_SM_IOV_STATIC_MAX)
+        free(remote_trans_iov.d);
+release_local:
+    if (liovcnt > NA_SM_IOV_STATIC_MAX)
+        free(local_trans_iov.d);
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static na_return_t
+na_sm_rma_post(struct na_sm_class *na_sm_class,
+    struct na_sm_op_id *na_sm_op_id, na_sm_process_vm_op_t process_vm_op,
+    const struct iovec *local_iov, unsigned long local_iovcnt,
+    const struct iovec *remote_iov, unsigned long remote_iovcnt,
+    size_t length)
+{
+    struct na_sm_op_queue *rma_op_queue = &na_sm_class->endpoint.rma_op_queue;
+    struct na_sm_rma_info *rma_info = &na_sm_op_id->info.rma;
+    na_return_t ret;
+
+    if (length <= NA_SM_RMA_CHUNK_SIZE) {
+        /* NB. addr does not need to be fully "resolved" to issue RMA */
+        ret = na_sm_rma_copy(process_vm_op, na_sm_op_id->addr->addr_key.pid,
+            (unsigned long) na_sm_class->iov_max, local_iov, local_iovcnt,
+            remote_iov, remote_iovcnt, length);
+        NA_CHECK_SUBSYS_NA_ERROR(rma, error, ret, "process_vm_op() failed");
+
+        /* Immediate completion */
+        na_sm_complete(na_sm_op_id, NA_SUCCESS);
+
+        /* Notify local completion */
+        na_sm_complete_signal(na_sm_class);
+
+        return NA_SUCCESS;
+    }
+
+    /* Keep our own copy of the segments as they may have been translated */
+    rma_info->local_iov =
+        (struct iovec *) malloc(local_iovcnt * sizeof(struct iovec));
+    NA_CHECK_SUBSYS_ERROR(rma, rma_info->local_iov == NULL, error, ret,
+        NA_NOMEM, "Could not allocate iovec");
+    memcpy(rma_info->local_iov, local_iov, local_iovcnt * sizeof(struct iovec));
+
+    rma_info->remote_iov =
+        (struct iovec *) malloc(remote_iovcnt * sizeof(struct iovec));
+    NA_CHECK_SUBSYS_ERROR(rma, rma_info->remote_iov == NULL, error_free, ret,
+        NA_NOMEM, "Could not allocate iovec");
+    memcpy(rma_info->remote_iov, remote_iov,
+        remote_iovcnt * sizeof(struct iovec));
+
+    rma_info->process_vm_op = process_vm_op;
+    rma_info->local_iovcnt = local_iovcnt;
+    rma_info->remote_iovcnt = remote_iovcnt;
+    rma_info->iov_max = (unsigned long) na_sm_class->iov_max;
+    rma_info->length = length;
+    rma_info->offset = 0;
+
+    NA_LOG_SUBSYS_DEBUG(rma, "Queuing %zu bytes for chunked copy (op id=%p)",
+        length, (void *) na_sm_op_id);
+
+    hg_thread_spin_lock(&rma_op_queue->lock);
+    HG_QUEUE_PUSH_TAIL(&rma_op_queue->queue, na_sm_op_id, entry);
+    hg_atomic_or32(&na_sm_op_id->status, NA_SM_OP_QUEUED);
+    hg_thread_spin_unlock(&rma_op_queue->lock);
+
+    /* Wake up progress so that it starts copying */
+    na_sm_complete_signal(na_sm_class);
+
+    return NA_SUCCESS;
+
+error_free:
+    free(rma_info->local_iov);
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static na_return_t
+na_sm_rma_chunk_copy(struct na_sm_op_id *na_sm_op_id)
+{
+    struct na_sm_rma_info *rma_info = &na_sm_op_id->info.rma;
+    size_t len = MIN(rma_info->length - rma_info->offset, NA_SM_RMA_CHUNK_SIZE);
+    unsigned long local_iov_start_index = 0, remote_iov_start_index = 0;
+    na_offset_t local_iov_start_offset = 0, remote_iov_start_offset = 0;
+    union na_sm_iov local_trans_iov, remote_trans_iov;
+    struct iovec *liov, *riov;
+    unsigned long liovcnt, riovcnt;
+    na_return_t ret;
+
+    /* Translate local segments of this chunk */
+    na_sm_iov_get_index_offset(rma_info->local_iov, rma_info->local_iovcnt,
+        rma_info->offset, &local_iov_start_index, &local_iov_start_offset);
+    liovcnt = na_sm_iov_get_count(rma_info->local_iov, rma_info->local_iovcnt,
+        local_iov_start_index, local_iov_start_offset, len);
+    if (liovcnt > NA_SM_IOV_STATIC_MAX) {
+        local_trans_iov.d =
+            (struct iovec *) malloc(liovcnt * sizeof(struct iovec));
+        NA_CHECK_SUBSYS_ERROR(rma, local_trans_iov.d == NULL, error, ret,
+            NA_NOMEM, "Could not allocate iovec");
+
+        liov = local_trans_iov.d;
+    } else
+        liov = local_trans_iov.s;
+    na_sm_iov_translate(rma_info->local_iov, rma_info->local_iovcnt,
+        local_iov_start_index, local_iov_start_offset, len, liov, liovcnt);
+
+    /* Translate remote segments of this chunk */
+    na_sm_iov_get_index_offset(rma_info->remote_iov, rma_info->remote_iovcnt,
+        rma_info->offset, &remote_iov_start_index, &remote_iov_start_offset);
+    riovcnt = na_sm_iov_get_count(rma_info->remote_iov,
+        rma_info->remote_iovcnt, remote_iov_start_index,
+        remote_iov_start_offset, len);
+    if (riovcnt > NA_SM_IOV_STATIC_MAX) {
+        remote_trans_iov.d =
+            (struct iovec *) malloc(riovcnt * sizeof(struct iovec));
+        NA_CHECK_SUBSYS_ERROR(rma, remote_trans_iov.d == NULL, release, ret,
+            NA_NOMEM, "Could not allocate iovec");
+
+        riov = remote_trans_iov.d;
+    } else
+        riov = remote_trans_iov.s;
+    na_sm_iov_translate(rma_info->remote_iov, rma_info->remote_iovcnt,
+        remote_iov_start_index, remote_iov_start_offset, len, riov, riovcnt);
+
+    ret = na_sm_rma_copy(rma_info->process_vm_op,
+        na_sm_op_id->addr->addr_key.pid, rma_info->iov_max, liov, liovcnt,
+        riov, riovcnt, len);
+    NA_CHECK_SUBSYS_NA_ERROR(
+        rma, release_remote, ret, "process_vm_op() failed");
+
+    rma_info->offset += len;
+
+release_remote:
+    if (riovcnt > NA_SM_IOV_STATIC_MAX)
+        free(remote_trans_iov.d);
+release:
+    if (liovcnt > NA_SM_IOV_STATIC_MAX)
+        free(local_trans_iov.d);
+error:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+na_sm_rma_complete(struct na_sm_op_id *na_sm_op_id, na_return_t cb_ret)
+{
+    free(na_sm_op_id->info.rma.local_iov);
+    na_sm_op_id->info.rma.local_iov = NULL;
+    free(na_sm_op_id->info.rma.remote_iov);
+    na_sm_op_id->info.rma.remote_iov = NULL;
+
+    na_sm_complete(na_sm_op_id, cb_ret);
+}
+
+/*---------------------------------------------------------------------------*/
+static na_return_t
+na_sm_rma_copy(na_sm_process_vm_op_t process_vm_op, pid_t pid,
+    unsigned long iov_max, const struct iovec *local_iov,
+    unsigned long local_iovcnt, const struct iovec *remote_iov,
+    unsigned long remote_iovcnt, size_t length)
+{
+    struct iovec *liov = NULL, *riov = NULL;
+    size_t offset = 0;
+    na_return_t ret;
+
+    if (local_iovcnt <= iov_max && remote_iovcnt <= iov_max)
+        return process_vm_op(
+            pid, local_iov, local_iovcnt, remote_iov, remote_iovcnt, length);
+
+    /* Flattened segments exceed IOV_MAX, copy them in several calls */
+    liov = (struct iovec *) malloc(2 * iov_max * sizeof(struct iovec));
+    NA_CHECK_SUBSYS_ERROR(rma, liov == NULL, error, ret, NA_NOMEM,
+        "Could not allocate iovec");
+    riov = liov + iov_max;
+
+    while (offset < length) {
+        unsigned long local_iov_start_index = 0, remote_iov_start_index = 0;
+        na_offset_t local_iov_start_offset = 0, remote_iov_start_offset = 0;
+        unsigned long liovcnt, riovcnt;
+        size_t len;
+
+        na_sm_iov_get_index_offset(local_iov, local_iovcnt, offset,
+            &local_iov_start_index, &local_iov_start_offset);
+        na_sm_iov_get_index_offset(remote_iov, remote_iovcnt, offset,
+            &remote_iov_start_index, &remote_iov_start_offset);
 
-            liov = local_trans_iov.d;
-        } else
-            liov = local_trans_iov.s;
+        /* Largest length that fits within iov_max segments on both sides */
+        len = MIN(length - offset,
+            na_sm_iov_get_len(local_iov, local_iovcnt, local_iov_start_index,
+                local_iov_start_offset, iov_max));
+        len = MIN(len, na_sm_iov_get_len(remote_iov, remote_iovcnt,
+                           remote_iov_start_index, remote_iov_start_offset,
+                           iov_max));
 
+        liovcnt = na_sm_iov_get_count(local_iov, local_iovcnt,
+            local_iov_start_index, local_iov_start_offset, len);
         na_sm_iov_translate(local_iov, local_iovcnt, local_iov_start_index,
-            local_iov_start_offset, length, liov, liovcnt);
-    } else {
-        liov = local_iov;
-        liovcnt = local_iovcnt;
+            local_iov_start_offset, len, liov, liovcnt);
+        riovcnt = na_sm_iov_get_count(remote_iov, remote_iovcnt,
+            remote_iov_start_index, remote_iov_start_offset, len);
+        na_sm_iov_translate(remote_iov, remote_iovcnt, remote_iov_start_index,
+            remote_iov_start_offset, len, riov, riovcnt);
+
+        ret = process_vm_op(pid, liov, liovcnt, riov, riovcnt, len);
+        NA_CHECK_SUBSYS_NA_ERROR(rma, error, ret, "process_vm_op() failed");
+
+        offset += len;
     }
 
-    /* Translate remote offset */
-    if (remote_offset > 0)
-        na_sm_iov_get_index_offset(remote_iov, remote_iovcnt, remote_offset,
-            &remote_iov_start_index, &remote_iov_start_offset);
+    free(liov);
 
-    if (length != na_sm_mem_handle_remote->info.len) {
-        riovcnt = na_sm_iov_get_count(remote_iov, remote_iovcnt,
-            remote_iov_start_index, remote_iov_start_offset, length);
+    return NA_SUCCESS;
 
-        if (riovcnt > NA_SM_IOV_STATIC_MAX) {
-            remote_trans_iov.d =
-                (struct iovec *) malloc(riovcnt * sizeof(struct iovec));
-            NA_CHECK_SUBSYS_ERROR(rma, remote_trans_iov.d == NULL, release, ret,
-                NA_NOMEM, "Could not allocate iovec");
+error:
+    free(liov);
 
-            riov = remote_trans_iov.d;
-        } else
-            riov = remote_trans_iov.s;
+    return ret;
+}
 
-        na_sm_iov_translate(remote_iov, remote_iovcnt, remote_iov_start_index,
-            remote_iov_start_offset, length, riov, riovcnt);
-    } else {
-        riov = remote_iov;
-        riovcnt = remote_iovcnt;
-    }
+/*---------------------------------------------------------------------------*/
+static na_return_t
+na_sm_rma_iov_translate(const struct na_rma_iov *rma_iov, size_t rma_iovcnt,
+    unsigned long iov_max, union na_sm_iov *trans_iov, unsigned long *iovcnt_p,
+    size_t *length_p)
+{
+    struct iovec *new_iov;
+    unsigned long iovcnt = 0, new_iovcnt = 0;
+    size_t length = 0, i;
+    na_return_t ret;
 
-    NA_LOG_SUBSYS_DEBUG(rma, "Posting rma op (op id=%p)", (void *) na_sm_op_id);
+    /* Number of segments is limited by na_sm_rma_get_max_iovcnt(), the memory
+     * handle segments that they cover may exceed iov_max once flattened and
+     * are then copied in batches by na_sm_rma_copy() */
+    NA_CHECK_SUBSYS_ERROR(rma, rma_iovcnt > iov_max, error, ret, NA_OVERFLOW,
+        "Segment count (%zu) exceeds IOV_MAX limit (%lu)", rma_iovcnt,
+        iov_max);
+
+    /* Count total number of IOVs needed */
+    for (i = 0; i < rma_iovcnt; i++) {
+        struct na_sm_mem_handle *na_sm_mem_handle =
+            (struct na_sm_mem_handle *) rma_iov[i].mem_handle;
+        unsigned long iov_start_index = 0;
+        na_offset_t iov_start_offset = 0;
+
+        NA_CHECK_SUBSYS_ERROR(rma,
+            rma_iov[i].offset + rma_iov[i].len > na_sm_mem_handle->info.len,
+            error, ret, NA_OVERFLOW, "Segment %zu exceeds memory handle size",
+            i);
+        if (rma_iov[i].len == 0)
+            continue;
 
-    /* NB. addr does not need to be fully "resolved" to issue RMA */
-    ret = process_vm_op(
-        na_sm_addr->addr_key.pid, liov, liovcnt, riov, riovcnt, length);
-    NA_CHECK_SUBSYS_NA_ERROR(rma, release, ret, "process_vm_op() failed");
+        na_sm_iov_get_index_offset(NA_SM_IOV(na_sm_mem_handle),
+            na_sm_mem_handle->info.iovcnt, rma_iov[i].offset, &iov_start_index,
+            &iov_start_offset);
+        iovcnt += na_sm_iov_get_count(NA_SM_IOV(na_sm_mem_handle),
+            na_sm_mem_handle->info.iovcnt, iov_start_index, iov_start_offset,
+            rma_iov[i].len);
+    }
 
-    /* Free before adding to completion queue */
-    if (liovcnt > NA_SM_IOV_STATIC_MAX &&
-        (length != na_sm_mem_handle_local->info.len))
-        free(local_trans_iov.d);
-    if (riovcnt > NA_SM_IOV_STATIC_MAX &&
-        (length != na_sm_mem_handle_remote->info.len))
-        free(remote_trans_iov.d);
+    if (iovcnt > NA_SM_IOV_STATIC_MAX) {
+        trans_iov->d = (struct iovec *) malloc(iovcnt * sizeof(struct iovec));
+        NA_CHECK_SUBSYS_ERROR(rma, trans_iov->d == NULL, error, ret, NA_NOMEM,
+            "Could not allocate iovec");
 
-    /* Immediate completion */
-    na_sm_complete(na_sm_op_id, NA_SUCCESS);
+        new_iov = trans_iov->d;
+    } else
+        new_iov = trans_iov->s;
 
-    /* Notify local completion */
-    na_sm_complete_signal(na_sm_class);
+    /* Fill IOV */
+    for (i = 0; i < rma_iovcnt; i++) {
+        struct na_sm_mem_handle *na_sm_mem_handle =
+            (struct na_sm_mem_handle *) rma_iov[i].mem_handle;
+        unsigned long iov_start_index = 0, count;
+        na_offset_t iov_start_offset = 0;
 
-    return NA_SUCCESS;
+        if (rma_iov[i].len == 0)
+            continue;
 
-release:
-    if (liovcnt > NA_SM_IOV_STATIC_MAX &&
-        (length != na_sm_mem_handle_local->info.len))
-        free(local_trans_iov.d);
-    if (riovcnt > NA_SM_IOV_STATIC_MAX &&
-        (length != na_sm_mem_handle_remote->info.len))
-        free(remote_trans_iov.d);
+        na_sm_iov_get_index_offset(NA_SM_IOV(na_sm_mem_handle),
+            na_sm_mem_handle->info.iovcnt, rma_iov[i].offset, &iov_start_index,
+            &iov_start_offset);
+        count = na_sm_iov_get_count(NA_SM_IOV(na_sm_mem_handle),
+            na_sm_mem_handle->info.iovcnt, iov_start_index, iov_start_offset,
+            rma_iov[i].len);
+        na_sm_iov_translate(NA_SM_IOV(na_sm_mem_handle),
+            na_sm_mem_handle->info.iovcnt, iov_start_index, iov_start_offset,
+            rma_iov[i].len, &new_iov[new_iovcnt], count);
+        new_iovcnt += count;
+        length += rma_iov[i].len;
+    }
 
-    NA_SM_OP_RELEASE(na_sm_op_id);
+    *iovcnt_p = iovcnt;
+    *length_p = length;
+
+    return NA_SUCCESS;
 
 error:
     return ret;
@@ -3421,14 +4688,41 @@ na_sm_iov_get_count(const struct iovec *iov, unsigned long iovcnt,
     unsigned long i, iov_index;
 
     for (i = 1, iov_index = iov_start_index + 1;
-         remaining_len > 0 && iov_index < iovcnt; i++, iov_index++) {
+         remaining_len > 0 && iov_index < iovcnt; iov_index++) {
+        /* Zero-length segments are skipped */
+        if (iov[iov_index].iov_len == 0)
+            continue;
+
         /* Decrease remaining len from the len of data */
         remaining_len -= MIN(remaining_len, iov[iov_index].iov_len);
+        i++;
     }
 
     return i;
 }
 
+/*---------------------------------------------------------------------------*/
+static NA_INLINE size_t
+na_sm_iov_get_len(const struct iovec *iov, unsigned long iovcnt,
+    unsigned long iov_start_index, na_offset_t iov_start_offset,
+    unsigned long iov_max)
+{
+    size_t len = iov[iov_start_index].iov_len - iov_start_offset;
+    unsigned long i, iov_index;
+
+    /* Zero-length segments are skipped and do not count towards iov_max */
+    for (i = 1, iov_index = iov_start_index + 1;
+         i < iov_max && iov_index < iovcnt; iov_index++) {
+        if (iov[iov_index].iov_len == 0)
+            continue;
+
+        len += iov[iov_index].iov_len;
+        i++;
+    }
+
+    return len;
+}
+
 /*---------------------------------------------------------------------------*/
 static NA_INLINE void
 na_sm_iov_translate(const struct iovec *iov, unsigned long iovcnt,
@@ -3447,15 +4741,120 @@ na_sm_iov_translate(const struct iovec *iov, unsigned long iovcnt,
 
     for (i = 1, iov_index = iov_start_index + 1;
          remaining_len > 0 && i < new_iovcnt && iov_index < iovcnt;
-         i++, iov_index++) {
+         iov_index++) {
+        /* Zero-length segments are skipped */
+        if (iov[iov_index].iov_len == 0)
+            continue;
+
         new_iov[i].iov_base = iov[iov_index].iov_base;
         new_iov[i].iov_len = MIN(remaining_len, iov[iov_index].iov_len);
 
         /* Decrease remaining len from the len of data */
         remaining_len -= new_iov[i].iov_len;
+        i++;
+    }
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+na_sm_mem_handle_shm_set(struct na_sm_shm_seg_list *na_sm_shm_segs,
+    struct na_sm_mem_handle *na_sm_mem_handle)
+{
+    const struct iovec *iov = NA_SM_IOV(na_sm_mem_handle);
+    struct na_sm_shm_seg *na_sm_shm_seg = NULL;
+    unsigned long i;
+
+    /* All the segments must come from the same RMA segment */
+    for (i = 0; i < na_sm_mem_handle->info.iovcnt; i++) {
+        if (iov[i].iov_len == 0)
+            continue;
+        if (na_sm_shm_seg == NULL) {
+            na_sm_shm_seg = na_sm_shm_seg_find(
+                na_sm_shm_segs, iov[i].iov_base, iov[i].iov_len);
+            if (na_sm_shm_seg == NULL)
+                return;
+        } else if ((char *) iov[i].iov_base < na_sm_shm_seg->addr ||
+                   (char *) iov[i].iov_base + iov[i].iov_len >
+                       na_sm_shm_seg->addr + na_sm_shm_seg->len)
+            return;
+    }
+    if (na_sm_shm_seg == NULL)
+        return;
+
+    na_sm_mem_handle->info.shm_base = na_sm_shm_seg->base;
+    na_sm_mem_handle->info.shm_len = na_sm_shm_seg->len;
+    na_sm_mem_handle->info.shm_pid = na_sm_shm_seg->key.pid;
+    na_sm_mem_handle->info.shm_id = na_sm_shm_seg->key.id;
+    na_sm_mem_handle->shm_addr = na_sm_shm_seg->addr;
+}
+
+/*---------------------------------------------------------------------------*/
+static NA_INLINE void
+na_sm_shm_iov_rebase(const struct na_sm_mem_handle *na_sm_mem_handle,
+    struct iovec *iov, unsigned long iovcnt)
+{
+    unsigned long i;
+
+    for (i = 0; i < iovcnt; i++) {
+        if (iov[i].iov_len == 0)
+            continue;
+        iov[i].iov_base =
+            na_sm_mem_handle->shm_addr + ((uintptr_t) iov[i].iov_base -
+                                             na_sm_mem_handle->info.shm_base);
+    }
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+na_sm_iov_copy(const struct iovec *dst_iov, unsigned long dst_iovcnt,
+    const struct iovec *src_iov, unsigned long src_iovcnt, size_t length)
+{
+    unsigned long dst_index = 0, src_index = 0;
+    size_t dst_offset = 0, src_offset = 0;
+
+    while (length > 0 && dst_index < dst_iovcnt && src_index < src_iovcnt) {
+        size_t len = MIN(length, MIN(dst_iov[dst_index].iov_len - dst_offset,
+                                     src_iov[src_index].iov_len - src_offset));
+
+        memcpy((char *) dst_iov[dst_index].iov_base + dst_offset,
+            (const char *) src_iov[src_index].iov_base + src_offset, len);
+        length -= len;
+
+        dst_offset += len;
+        if (dst_offset == dst_iov[dst_index].iov_len) {
+            dst_index++;
+            dst_offset = 0;
+        }
+        src_offset += len;
+        if (src_offset == src_iov[src_index].iov_len) {
+            src_index++;
+            src_offset = 0;
+        }
     }
 }
 
+/*---------------------------------------------------------------------------*/
+static na_return_t
+na_sm_shm_writev(pid_t NA_UNUSED pid, const struct iovec *local_iov,
+    unsigned long liovcnt, const struct iovec *remote_iov,
+    unsigned long riovcnt, size_t length)
+{
+    na_sm_iov_copy(remote_iov, riovcnt, local_iov, liovcnt, length);
+
+    return NA_SUCCESS;
+}
+
+/*---------------------------------------------------------------------------*/
+static na_return_t
+na_sm_shm_readv(pid_t NA_UNUSED pid, const struct iovec *local_iov,
+    unsigned long liovcnt, const struct iovec *remote_iov,
+    unsigned long riovcnt, size_t length)
+{
+    na_sm_iov_copy(local_iov, liovcnt, remote_iov, riovcnt, length);
+
+    return NA_SUCCESS;
+}
+
 #ifdef NA_SM_HAS_CMA
 /*---------------------------------------------------------------------------*/
 static na_return_t
@@ -3477,6 +4876,7 @@ na_sm_process_vm_writev(pid_t pid, const struct iovec *local_iov,
                 "or if set to restricted, add the following call to your "
                 "application:\n"
                 "prctl(PR_SET_PTRACER, PR_SET_PTRACER_ANY, 0, 0, 0);\n"
+                "or allocate remote memory with NA_Mem_alloc().\n"
                 "See https://www.kernel.org/doc/Documentation/security/Yama.txt"
                 " for more details.",
                 strerror(errno));
@@ -3551,6 +4951,7 @@ na_sm_process_vm_readv(pid_t pid, const struct iovec *local_iov,
                 "or if set to restricted, add the following call to your "
                 "application:\n"
                 "prctl(PR_SET_PTRACER, PR_SET_PTRACER_ANY, 0, 0, 0);\n"
+                "or allocate remote memory with NA_Mem_alloc().\n"
                 "See https://www.kernel.org/doc/Documentation/security/Yama.txt"
                 " for more details.",
                 strerror(errno));
@@ -3691,7 +5092,17 @@ na_sm_poll(struct na_sm_endpoint *na_sm_endpoint, bool *progressed_ptr)
     bool progressed = false;
     na_return_t ret = NA_SUCCESS;
 
-    /* Check whether something is in one of the rx queues */
+    /* Check rx queues of our own region that have pending messages */
+    if (na_sm_endpoint->source_addr->shared_region) {
+        bool progressed_doorbell = false;
+
+        ret = na_sm_poll_doorbell(na_sm_endpoint, &progressed_doorbell);
+        NA_CHECK_SUBSYS_NA_ERROR(
+            poll, done, ret, "Could not progress doorbell");
+        progressed |= progressed_doorbell;
+    }
+
+    /* Check whether something is in one of the remote rx queues */
     hg_thread_spin_lock(&poll_addr_list->lock);
     HG_LIST_FOREACH (poll_addr, &poll_addr_list->list, entry) {
         bool progressed_rx = false;
@@ -3724,6 +5135,63 @@ done:
     return ret;
 }
 
+/*---------------------------------------------------------------------------*/
+static na_return_t
+na_sm_poll_doorbell(struct na_sm_endpoint *na_sm_endpoint, bool *progressed)
+{
+    struct na_sm_region *na_sm_region =
+        na_sm_endpoint->source_addr->shared_region;
+    na_return_t ret = NA_SUCCESS;
+    int64_t segs;
+
+    *progressed = false;
+
+    if (hg_atomic_get64(&na_sm_region->doorbell_segs.val) == 0)
+        goto done;
+
+    /* Clear the segment bits before looking at the pair bits, senders ring
+     * both again after pushing anything that we may miss */
+    segs = hg_atomic_and64(&na_sm_region->doorbell_segs.val, 0);
+    while (segs) {
+        int seg = __builtin_ctzll((unsigned long long) segs);
+        int64_t bits;
+
+        segs &= segs - 1;
+
+        bits = hg_atomic_and64(&na_sm_region->doorbell[seg].val, 0);
+        while (bits) {
+            int bit = __builtin_ctzll((unsigned long long) bits);
+            uint16_t idx = (uint16_t) (seg * NA_SM_QUEUE_PAIR_SEG_SIZE + bit);
+            struct na_sm_addr *poll_addr;
+            bool progressed_rx = false;
+
+            bits &= bits - 1;
+
+            /* Bits of pairs that are not yet (or no longer) connected are
+             * dropped, the doorbell is rung again on connection */
+            hg_thread_spin_lock(&na_sm_endpoint->poll_addr_list.lock);
+            poll_addr = na_sm_endpoint->doorbell_addrs[idx];
+            hg_thread_spin_unlock(&na_sm_endpoint->poll_addr_list.lock);
+            if (poll_addr == NULL)
+                continue;
+
+            ret = na_sm_progress_rx_queue(
+                na_sm_endpoint, poll_addr, &progressed_rx);
+            NA_CHECK_SUBSYS_NA_ERROR(
+                poll, done, ret, "Could not progress rx queue");
+            *progressed |= progressed_rx;
+
+            /* Only one message is processed per queue and per poll, ring
+             * again if more are pending */
+            if (!na_sm_msg_queue_is_empty(poll_addr->rx_queue))
+                na_sm_doorbell_ring(na_sm_region, idx);
+        }
+    }
+
+done:
+    return ret;
+}
+
 /*---------------------------------------------------------------------------*/
 static na_return_t
 na_sm_progress_sock(struct na_sm_endpoint *na_sm_endpoint, bool *progressed)
@@ -3784,15 +5252,29 @@ na_sm_process_cmd(struct na_sm_endpoint *na_sm_endpoint,
 
     NA_LOG_SUBSYS_DEBUG(addr,
         "Processing cmd with %d from %d/%u/%u val=%" PRIu64, cmd_hdr.hdr.type,
-        cmd_hdr.hdr.pid, cmd_hdr.hdr.id & 0xff, cmd_hdr.hdr.pair_idx & 0xff,
+        cmd_hdr.hdr.pid, cmd_hdr.hdr.id & 0xff, cmd_hdr.hdr.pair_idx & 0xffff,
         cmd_hdr.val);
 
     switch (cmd_hdr.hdr.type) {
         case NA_SM_RESERVED: {
             struct na_sm_addr *na_sm_addr = NULL;
+            struct na_sm_queue_pair_seg *queue_pair_seg = NULL;
+            struct na_sm_queue_pair *queue_pair;
+            uint16_t queue_pair_idx = (uint16_t) cmd_hdr.hdr.pair_idx;
             struct na_sm_addr_key addr_key = {
                 .pid = (pid_t) cmd_hdr.hdr.pid, .id = cmd_hdr.hdr.id};
 
+            NA_CHECK_SUBSYS_ERROR(addr, queue_pair_idx >= NA_SM_MAX_PEERS,
+                done, ret, NA_INVALID_ARG, "Invalid queue pair index (%u)",
+                queue_pair_idx);
+
+            /* Segment mappings are shared by all unexpected addresses */
+            ret = na_sm_endpoint_queue_pair_seg_get(na_sm_endpoint,
+                queue_pair_idx / NA_SM_QUEUE_PAIR_SEG_SIZE, &queue_pair_seg);
+            NA_CHECK_SUBSYS_NA_ERROR(
+                addr, done, ret, "Could not get queue pair segment");
+            queue_pair = NA_SM_QUEUE_PAIR(queue_pair_seg, queue_pair_idx);
+
             /* Allocate source address */
             ret = na_sm_addr_create(
                 na_sm_endpoint, NULL, &addr_key, true, &na_sm_addr);
@@ -3801,17 +5283,12 @@ na_sm_process_cmd(struct na_sm_endpoint *na_sm_endpoint,
 
             na_sm_addr->shared_region =
                 na_sm_endpoint->source_addr->shared_region;
-            na_sm_addr->queue_pair_idx = cmd_hdr.hdr.pair_idx;
+            na_sm_addr->queue_pair_idx = queue_pair_idx;
+            na_sm_addr->queue_pair_seg = queue_pair_seg;
 
             /* Invert queues so that local rx is remote tx */
-            na_sm_addr->tx_queue =
-                &na_sm_addr->shared_region
-                     ->queue_pairs[na_sm_addr->queue_pair_idx]
-                     .rx_queue;
-            na_sm_addr->rx_queue =
-                &na_sm_addr->shared_region
-                     ->queue_pairs[na_sm_addr->queue_pair_idx]
-                     .tx_queue;
+            na_sm_addr->tx_queue = &queue_pair->rx_queue;
+            na_sm_addr->rx_queue = &queue_pair->tx_queue;
 
             /* Invert descriptors so that local rx is remote tx */
             na_sm_addr->tx_notify = rx_notify;
@@ -3832,28 +5309,29 @@ na_sm_process_cmd(struct na_sm_endpoint *na_sm_endpoint,
             /* Unexpected addresses are always resolved */
             hg_atomic_or32(&na_sm_addr->status, NA_SM_ADDR_RESOLVED);
 
-            /* Add address to list of addresses to poll */
+            /* Add address to addresses polled through the doorbell and ring
+             * it in case messages were pushed before the cmd was processed */
             hg_thread_spin_lock(&na_sm_endpoint->poll_addr_list.lock);
-            HG_LIST_INSERT_HEAD(
-                &na_sm_endpoint->poll_addr_list.list, na_sm_addr, entry);
+            na_sm_endpoint->doorbell_addrs[na_sm_addr->queue_pair_idx] =
+                na_sm_addr;
             hg_thread_spin_unlock(&na_sm_endpoint->poll_addr_list.lock);
+            na_sm_doorbell_ring(
+                na_sm_addr->shared_region, na_sm_addr->queue_pair_idx);
             break;
         }
         case NA_SM_RELEASED: {
             struct na_sm_addr *na_sm_addr = NULL;
             bool found = false;
 
-            /* Find address from list of addresses to poll */
+            /* Find address from addresses polled through the doorbell */
             hg_thread_spin_lock(&na_sm_endpoint->poll_addr_list.lock);
-            HG_LIST_FOREACH (
-                na_sm_addr, &na_sm_endpoint->poll_addr_list.list, entry) {
-                if ((na_sm_addr->queue_pair_idx == cmd_hdr.hdr.pair_idx) &&
-                    (na_sm_addr->addr_key.pid == (pid_t) cmd_hdr.hdr.pid) &&
-                    (na_sm_addr->addr_key.id == cmd_hdr.hdr.id)) {
-                    found = true;
-                    break;
-                }
-            }
+            if (cmd_hdr.hdr.pair_idx < NA_SM_MAX_PEERS)
+                na_sm_addr =
+                    na_sm_endpoint->doorbell_addrs[cmd_hdr.hdr.pair_idx];
+            if (na_sm_addr && na_sm_addr->unexpected &&
+                (na_sm_addr->addr_key.pid == (pid_t) cmd_hdr.hdr.pid) &&
+                (na_sm_addr->addr_key.id == cmd_hdr.hdr.id))
+                found = true;
             hg_thread_spin_unlock(&na_sm_endpoint->poll_addr_list.lock);
 
             if (!found) {
@@ -3976,6 +5454,12 @@ na_sm_process_unexpected(struct na_sm_op_queue *unexpected_op_queue,
     hg_thread_spin_unlock(&unexpected_op_queue->lock);
 
     if (likely(na_sm_op_id)) {
+        /* Sender may use larger messages than what was posted */
+        na_return_t cb_ret =
+            (msg_hdr.hdr.buf_size > na_sm_op_id->info.msg.buf_size)
+                ? NA_MSGSIZE
+                : NA_SUCCESS;
+
         /* Fill info */
         na_sm_op_id->completion_data.callback_info.info.recv_unexpected =
             (struct na_cb_info_recv_unexpected){
@@ -3988,7 +5472,7 @@ na_sm_process_unexpected(struct na_sm_op_queue *unexpected_op_queue,
             /* Copy buffer */
             na_sm_buf_copy_from(&poll_addr->shared_region->copy_bufs,
                 msg_hdr.hdr.buf_idx, na_sm_op_id->info.msg.buf.ptr,
-                msg_hdr.hdr.buf_size);
+                MIN(msg_hdr.hdr.buf_size, na_sm_op_id->info.msg.buf_size));
 
             /* Release buffer */
             na_sm_buf_release(
@@ -3996,7 +5480,7 @@ na_sm_process_unexpected(struct na_sm_op_queue *unexpected_op_queue,
         }
 
         /* Complete operation (no need to notify) */
-        na_sm_complete(na_sm_op_id, NA_SUCCESS);
+        na_sm_complete(na_sm_op_id, cb_ret);
     } else {
         /* If no error and message arrived, keep a copy of the struct in
          * the unexpected message queue (should rarely happen) */
@@ -4077,7 +5561,7 @@ na_sm_process_expected(struct na_sm_op_queue *expected_op_queue,
         /* Copy buffer */
         na_sm_buf_copy_from(&poll_addr->shared_region->copy_bufs,
             msg_hdr.hdr.buf_idx, na_sm_op_id->info.msg.buf.ptr,
-            msg_hdr.hdr.buf_size);
+            MIN(msg_hdr.hdr.buf_size, na_sm_op_id->info.msg.buf_size));
 
         /* Release buffer */
         na_sm_buf_release(
@@ -4085,7 +5569,9 @@ na_sm_process_expected(struct na_sm_op_queue *expected_op_queue,
     }
 
     /* Complete operation */
-    na_sm_complete(na_sm_op_id, NA_SUCCESS);
+    na_sm_complete(na_sm_op_id,
+        (msg_hdr.hdr.buf_size > na_sm_op_id->info.msg.buf_size) ? NA_MSGSIZE
+                                                                : NA_SUCCESS);
 
 done:
     return ret;
@@ -4166,6 +5652,57 @@ na_sm_process_retries(struct na_sm_endpoint *na_sm_endpoint)
     return NA_SUCCESS;
 }
 
+/*---------------------------------------------------------------------------*/
+static na_return_t
+na_sm_process_rma(struct na_sm_endpoint *na_sm_endpoint, bool *progressed)
+{
+    struct na_sm_op_queue *op_queue = &na_sm_endpoint->rma_op_queue;
+    struct na_sm_op_id *na_sm_op_id = NULL;
+    na_return_t ret;
+    bool complete = false;
+
+    *progressed = false;
+
+    hg_thread_spin_lock(&op_queue->lock);
+    na_sm_op_id = HG_QUEUE_FIRST(&op_queue->queue);
+    if (!na_sm_op_id) {
+        hg_thread_spin_unlock(&op_queue->lock);
+        /* Queue is empty */
+        return NA_SUCCESS;
+    }
+    /* We won't try to cancel an op that's being copied */
+    hg_atomic_or32(&na_sm_op_id->status, NA_SM_OP_COPYING);
+    hg_thread_spin_unlock(&op_queue->lock);
+
+    ret = na_sm_rma_chunk_copy(na_sm_op_id);
+
+    hg_thread_spin_lock(&op_queue->lock);
+    hg_atomic_and32(&na_sm_op_id->status, ~NA_SM_OP_COPYING);
+    if (ret != NA_SUCCESS) {
+        NA_LOG_SUBSYS_ERROR(rma, "Could not copy rma chunk");
+        hg_atomic_or32(&na_sm_op_id->status, NA_SM_OP_ERRORED);
+        complete = true;
+    } else if (hg_atomic_get32(&na_sm_op_id->status) & NA_SM_OP_CANCELED) {
+        ret = NA_CANCELED;
+        complete = true;
+    } else if (na_sm_op_id->info.rma.offset == na_sm_op_id->info.rma.length)
+        complete = true;
+
+    HG_QUEUE_REMOVE(&op_queue->queue, na_sm_op_id, na_sm_op_id, entry);
+    if (complete)
+        hg_atomic_and32(&na_sm_op_id->status, ~NA_SM_OP_QUEUED);
+    else
+        HG_QUEUE_PUSH_TAIL(&op_queue->queue, na_sm_op_id, entry);
+    hg_thread_spin_unlock(&op_queue->lock);
+
+    if (complete) {
+        na_sm_rma_complete(na_sm_op_id, ret);
+        *progressed = true;
+    }
+
+    return NA_SUCCESS;
+}
+
 /*---------------------------------------------------------------------------*/
 static NA_INLINE void
 na_sm_op_retry(struct na_sm_class *na_sm_class, struct na_sm_op_id *na_sm_op_id)
@@ -4248,6 +5785,8 @@ na_sm_initialize(
     struct rlimit rlimit;
     bool no_wait = false;
     uint8_t context_max = 1; /* Default */
+    size_t unexpected_size_max = NA_SM_UNEXPECTED_SIZE,
+           expected_size_max = NA_SM_EXPECTED_SIZE;
     na_return_t ret = NA_SUCCESS;
     int rc;
 
@@ -4258,6 +5797,13 @@ na_sm_initialize(
             no_wait = true;
         /* Max contexts */
         context_max = na_info->na_init_info->max_contexts;
+        /* Msg size limits (larger sizes use larger buffer classes) */
+        if (na_info->na_init_info->max_unexpected_size)
+            unexpected_size_max = MIN(
+                na_info->na_init_info->max_unexpected_size, NA_SM_MSG_SIZE_MAX);
+        if (na_info->na_init_info->max_expected_size)
+            expected_size_max = MIN(
+                na_info->na_init_info->max_expected_size, NA_SM_MSG_SIZE_MAX);
     }
 
     /* Reset errno */
@@ -4276,12 +5822,19 @@ na_sm_initialize(
     NA_CHECK_SUBSYS_ERROR(cls, na_class->plugin_class == NULL, error, ret,
         NA_NOMEM, "Could not allocate SM private class");
     memset(na_class->plugin_class, 0, sizeof(struct na_sm_class));
+    HG_LIST_INIT(&NA_SM_CLASS(na_class)->shm_segs.list);
+    hg_thread_rwlock_init(&NA_SM_CLASS(na_class)->shm_segs.lock);
+    ret = na_sm_shm_seg_cache_init(&NA_SM_CLASS(na_class)->shm_seg_cache);
+    NA_CHECK_SUBSYS_NA_ERROR(
+        cls, error, ret, "Could not initialize RMA segment cache");
 #ifdef NA_SM_HAS_CMA
     NA_SM_CLASS(na_class)->iov_max = (size_t) sysconf(_SC_IOV_MAX);
 #else
     NA_SM_CLASS(na_class)->iov_max = 1;
 #endif
     NA_SM_CLASS(na_class)->context_max = context_max;
+    NA_SM_CLASS(na_class)->unexpected_size_max = unexpected_size_max;
+    NA_SM_CLASS(na_class)->expected_size_max = expected_size_max;
 
     /* Open endpoint */
     ret = na_sm_endpoint_open(&NA_SM_CLASS(na_class)->endpoint,
@@ -4292,6 +5845,8 @@ na_sm_initialize(
 
 error:
     if (na_class->plugin_class) {
+        hg_thread_rwlock_destroy(&NA_SM_CLASS(na_class)->shm_segs.lock);
+        na_sm_shm_seg_cache_destroy(&NA_SM_CLASS(na_class)->shm_seg_cache);
         free(na_class->plugin_class);
         na_class->plugin_class = NULL;
     }
@@ -4314,6 +5869,10 @@ na_sm_finalize(na_class_t *na_class)
     ret = na_sm_endpoint_close(&NA_SM_CLASS(na_class)->endpoint);
     NA_CHECK_SUBSYS_NA_ERROR(cls, done, ret, "Could not close endpoint");
 
+    /* Release RMA segments that were not freed and mappings of peers */
+    na_sm_shm_seg_list_destroy(&NA_SM_CLASS(na_class)->shm_segs);
+    na_sm_shm_seg_cache_destroy(&NA_SM_CLASS(na_class)->shm_seg_cache);
+
     free(na_class->plugin_class);
     na_class->plugin_class = NULL;
 
@@ -4369,7 +5928,9 @@ na_sm_op_create(na_class_t *na_class)
 {
     struct na_sm_op_id *na_sm_op_id = NULL;
 
-    na_sm_op_id = (struct na_sm_op_id *) malloc(sizeof(struct na_sm_op_id));
+    /* Op IDs must not share cache lines */
+    na_sm_op_id = (struct na_sm_op_id *) hg_mem_aligned_alloc(
+        NA_SM_CACHE_LINE_SIZE, sizeof(struct na_sm_op_id));
     NA_CHECK_SUBSYS_ERROR_NORET(
         op, na_sm_op_id == NULL, done, "Could not allocate NA SM operation ID");
     memset(na_sm_op_id, 0, sizeof(struct na_sm_op_id));
@@ -4399,7 +5960,7 @@ na_sm_op_destroy(na_class_t NA_UNUSED *na_class, na_op_id_t *op_id)
         ret, NA_BUSY, "Attempting to use OP ID that was not completed (%s)",
         na_cb_type_to_string(na_sm_op_id->completion_data.callback_info.type));
 
-    free(na_sm_op_id);
+    hg_mem_aligned_free(na_sm_op_id);
 
 done:
     return ret;
@@ -4611,16 +6172,16 @@ done:
 
 /*---------------------------------------------------------------------------*/
 static NA_INLINE size_t
-na_sm_msg_get_max_unexpected_size(const na_class_t NA_UNUSED *na_class)
+na_sm_msg_get_max_unexpected_size(const na_class_t *na_class)
 {
-    return NA_SM_UNEXPECTED_SIZE;
+    return NA_SM_CLASS(na_class)->unexpected_size_max;
 }
 
 /*---------------------------------------------------------------------------*/
 static NA_INLINE size_t
-na_sm_msg_get_max_expected_size(const na_class_t NA_UNUSED *na_class)
+na_sm_msg_get_max_expected_size(const na_class_t *na_class)
 {
-    return NA_SM_EXPECTED_SIZE;
+    return NA_SM_CLASS(na_class)->expected_size_max;
 }
 
 /*---------------------------------------------------------------------------*/
@@ -4654,7 +6215,8 @@ na_sm_msg_recv_unexpected(na_class_t *na_class, na_context_t *context,
     struct na_sm_op_id *na_sm_op_id = (struct na_sm_op_id *) op_id;
     na_return_t ret;
 
-    NA_CHECK_SUBSYS_ERROR(msg, buf_size > NA_SM_UNEXPECTED_SIZE, error, ret,
+    NA_CHECK_SUBSYS_ERROR(msg,
+        buf_size > NA_SM_CLASS(na_class)->unexpected_size_max, error, ret,
         NA_OVERFLOW, "Exceeds unexpected size, %zu", buf_size);
 
     /* Check op_id */
@@ -4679,7 +6241,7 @@ na_sm_msg_recv_unexpected(na_class_t *na_class, na_context_t *context,
     if (unlikely(na_sm_unexpected_info)) {
         /* Copy buffers */
         memcpy(na_sm_op_id->info.msg.buf.ptr, na_sm_unexpected_info->buf,
-            na_sm_unexpected_info->buf_size);
+            MIN(na_sm_unexpected_info->buf_size, buf_size));
 
         /* Fill unexpected info */
         na_sm_op_id->completion_data.callback_info.info.recv_unexpected =
@@ -4690,8 +6252,10 @@ na_sm_msg_recv_unexpected(na_class_t *na_class, na_context_t *context,
         na_sm_addr_ref_incr(na_sm_unexpected_info->na_sm_addr);
 
         free(na_sm_unexpected_info->buf);
+        na_sm_complete(na_sm_op_id,
+            (na_sm_unexpected_info->buf_size > buf_size) ? NA_MSGSIZE
+                                                         : NA_SUCCESS);
         free(na_sm_unexpected_info);
-        na_sm_complete(na_sm_op_id, NA_SUCCESS);
 
         /* Notify local completion */
         na_sm_complete_signal(NA_SM_CLASS(na_class));
@@ -4742,7 +6306,8 @@ na_sm_msg_recv_expected(na_class_t *na_class, na_context_t *context,
     struct na_sm_addr *na_sm_addr = (struct na_sm_addr *) source_addr;
     na_return_t ret;
 
-    NA_CHECK_SUBSYS_ERROR(msg, buf_size > NA_SM_EXPECTED_SIZE, error, ret,
+    NA_CHECK_SUBSYS_ERROR(msg,
+        buf_size > NA_SM_CLASS(na_class)->expected_size_max, error, ret,
         NA_OVERFLOW, "Exceeds expected size, %zu", buf_size);
 
     /* Check op_id */
@@ -4777,8 +6342,8 @@ error:
 
 /*---------------------------------------------------------------------------*/
 static na_return_t
-na_sm_mem_handle_create(na_class_t NA_UNUSED *na_class, void *buf,
-    size_t buf_size, unsigned long flags, na_mem_handle_t *mem_handle_p)
+na_sm_mem_handle_create(na_class_t *na_class, void *buf, size_t buf_size,
+    unsigned long flags, na_mem_handle_t *mem_handle_p)
 {
     struct na_sm_mem_handle *na_sm_mem_handle = NULL;
     na_return_t ret = NA_SUCCESS;
@@ -4795,6 +6360,10 @@ na_sm_mem_handle_create(na_class_t NA_UNUSED *na_class, void *buf,
     na_sm_mem_handle->info.flags = flags & 0xff;
     na_sm_mem_handle->info.len = buf_size;
 
+    /* Peers map RMA segments instead of using CMA */
+    na_sm_mem_handle_shm_set(
+        &NA_SM_CLASS(na_class)->shm_segs, na_sm_mem_handle);
+
     *mem_handle_p = (na_mem_handle_t) na_sm_mem_handle;
 
 done:
@@ -4846,6 +6415,10 @@ na_sm_mem_handle_create_segments(na_class_t *na_class,
     na_sm_mem_handle->info.iovcnt = segment_count;
     na_sm_mem_handle->info.flags = flags & 0xff;
 
+    /* Peers map RMA segments instead of using CMA */
+    na_sm_mem_handle_shm_set(
+        &NA_SM_CLASS(na_class)->shm_segs, na_sm_mem_handle);
+
     *mem_handle_p = (na_mem_handle_t) na_sm_mem_handle;
 
     return ret;
@@ -4862,12 +6435,14 @@ error:
 
 /*---------------------------------------------------------------------------*/
 static na_return_t
-na_sm_mem_handle_free(
-    na_class_t NA_UNUSED *na_class, na_mem_handle_t mem_handle)
+na_sm_mem_handle_free(na_class_t *na_class, na_mem_handle_t mem_handle)
 {
     struct na_sm_mem_handle *na_sm_mem_handle =
         (struct na_sm_mem_handle *) mem_handle;
 
+    if (na_sm_mem_handle->shm_seg)
+        na_sm_shm_seg_cache_release(&NA_SM_CLASS(na_class)->shm_seg_cache,
+            na_sm_mem_handle->shm_seg);
     if (na_sm_mem_handle->info.iovcnt > NA_SM_IOV_STATIC_MAX)
         free(na_sm_mem_handle->iov.d);
     free(na_sm_mem_handle);
@@ -4920,7 +6495,7 @@ done:
 
 /*---------------------------------------------------------------------------*/
 static na_return_t
-na_sm_mem_handle_deserialize(na_class_t NA_UNUSED *na_class,
+na_sm_mem_handle_deserialize(na_class_t *na_class,
     na_mem_handle_t *mem_handle_p, const void *buf, NA_UNUSED size_t buf_size)
 {
     struct na_sm_mem_handle *na_sm_mem_handle = NULL;
@@ -4935,6 +6510,8 @@ na_sm_mem_handle_deserialize(na_class_t NA_UNUSED *na_class,
         "Could not allocate NA SM memory handle");
     na_sm_mem_handle->iov.d = NULL;
     na_sm_mem_handle->info.iovcnt = 0;
+    na_sm_mem_handle->shm_addr = NULL;
+    na_sm_mem_handle->shm_seg = NULL;
 
     /* Descriptor info */
     NA_DECODE(error, ret, buf_ptr, buf_size_left, &na_sm_mem_handle->info,
@@ -4955,6 +6532,28 @@ na_sm_mem_handle_deserialize(na_class_t NA_UNUSED *na_class,
     NA_DECODE_ARRAY(error, ret, buf_ptr, buf_size_left, iov, struct iovec,
         na_sm_mem_handle->info.iovcnt);
 
+    /* Map RMA segment if memory was carved from one, RMA falls back to CMA if
+     * the segment cannot be mapped */
+    if (na_sm_mem_handle->info.shm_len > 0) {
+        struct na_sm_class *na_sm_class = NA_SM_CLASS(na_class);
+
+        if (na_sm_mem_handle->info.shm_pid ==
+            na_sm_class->endpoint.source_addr->addr_key.pid)
+            na_sm_mem_handle->shm_addr =
+                (char *) na_sm_mem_handle->info.shm_base;
+        else {
+            /* Mapping is held until the handle is freed */
+            na_sm_mem_handle->shm_seg =
+                na_sm_shm_seg_cache_acquire(&na_sm_class->shm_seg_cache,
+                    na_sm_mem_handle->info.shm_pid,
+                    na_sm_mem_handle->info.shm_id,
+                    na_sm_mem_handle->info.shm_base,
+                    na_sm_mem_handle->info.shm_len);
+            if (na_sm_mem_handle->shm_seg)
+                na_sm_mem_handle->shm_addr = na_sm_mem_handle->shm_seg->addr;
+        }
+    }
+
     *mem_handle_p = (na_mem_handle_t) na_sm_mem_handle;
 
     return ret;
@@ -4996,6 +6595,43 @@ na_sm_get(na_class_t *na_class, na_context_t *context, na_cb_t callback,
         (struct na_sm_op_id *) op_id);
 }
 
+/*---------------------------------------------------------------------------*/
+static size_t
+na_sm_rma_get_max_iovcnt(const na_class_t NA_UNUSED *na_class)
+{
+#ifdef NA_SM_HAS_CMA
+    return NA_SM_CLASS(na_class)->iov_max;
+#else
+    return 0;
+#endif
+}
+
+/*---------------------------------------------------------------------------*/
+static NA_INLINE na_return_t
+na_sm_putv(na_class_t *na_class, na_context_t *context, na_cb_t callback,
+    void *arg, const struct na_rma_iov *local_iov, size_t local_iovcnt,
+    const struct na_rma_iov *remote_iov, size_t remote_iovcnt,
+    na_addr_t remote_addr, uint8_t NA_UNUSED remote_id, na_op_id_t *op_id)
+{
+    return na_sm_rmav(NA_SM_CLASS(na_class), context, NA_CB_PUT, callback, arg,
+        na_sm_process_vm_writev, local_iov, local_iovcnt, remote_iov,
+        remote_iovcnt, (struct na_sm_addr *) remote_addr,
+        (struct na_sm_op_id *) op_id);
+}
+
+/*---------------------------------------------------------------------------*/
+static NA_INLINE na_return_t
+na_sm_getv(na_class_t *na_class, na_context_t *context, na_cb_t callback,
+    void *arg, const struct na_rma_iov *local_iov, size_t local_iovcnt,
+    const struct na_rma_iov *remote_iov, size_t remote_iovcnt,
+    na_addr_t remote_addr, uint8_t NA_UNUSED remote_id, na_op_id_t *op_id)
+{
+    return na_sm_rmav(NA_SM_CLASS(na_class), context, NA_CB_GET, callback, arg,
+        na_sm_process_vm_readv, local_iov, local_iovcnt, remote_iov,
+        remote_iovcnt, (struct na_sm_addr *) remote_addr,
+        (struct na_sm_op_id *) op_id);
+}
+
 /*---------------------------------------------------------------------------*/
 static NA_INLINE int
 na_sm_poll_get_fd(na_class_t *na_class, na_context_t NA_UNUSED *context)
@@ -5020,7 +6656,14 @@ na_sm_poll_try_wait(na_class_t *na_class, na_context_t NA_UNUSED *context)
     struct na_sm_addr *na_sm_addr;
     bool empty = false;
 
-    /* Check whether something is in one of the rx queues */
+    /* Check whether a doorbell was rung */
+    if (na_sm_endpoint->source_addr->shared_region &&
+        hg_atomic_get64(
+            &na_sm_endpoint->source_addr->shared_region->doorbell_segs.val) !=
+            0)
+        return false;
+
+    /* Check whether something is in one of the remote rx queues */
     hg_thread_spin_lock(&na_sm_endpoint->poll_addr_list.lock);
     HG_LIST_FOREACH (na_sm_addr, &na_sm_endpoint->poll_addr_list.list, entry) {
         if (!na_sm_msg_queue_is_empty(na_sm_addr->rx_queue)) {
@@ -5037,6 +6680,13 @@ na_sm_poll_try_wait(na_class_t *na_class, na_context_t NA_UNUSED *context)
     if (!empty)
         return false;
 
+    /* Check whether RMAs are being copied */
+    hg_thread_spin_lock(&na_sm_endpoint->rma_op_queue.lock);
+    empty = HG_QUEUE_IS_EMPTY(&na_sm_endpoint->rma_op_queue.queue);
+    hg_thread_spin_unlock(&na_sm_endpoint->rma_op_queue.lock);
+    if (!empty)
+        return false;
+
     return true;
 }
 
@@ -5054,12 +6704,15 @@ na_sm_progress(
     deadline = hg_time_add(now, hg_time_from_ms(timeout_ms));
 
     do {
-        bool progressed = false;
+        bool progressed = false, progressed_rma = false;
 
         if (na_sm_endpoint->poll_set) {
-            /* Make blocking progress */
+            /* Make blocking progress, unless RMAs are being copied */
             ret = na_sm_poll_wait(context, na_sm_endpoint,
-                hg_time_to_ms(hg_time_subtract(deadline, now)), &progressed);
+                HG_QUEUE_IS_EMPTY(&na_sm_endpoint->rma_op_queue.queue)
+                    ? hg_time_to_ms(hg_time_subtract(deadline, now))
+                    : 0,
+                &progressed);
             NA_CHECK_SUBSYS_NA_ERROR(poll, error, ret,
                 "Could not make blocking progress on context");
         } else {
@@ -5074,7 +6727,12 @@ na_sm_progress(
         NA_CHECK_SUBSYS_NA_ERROR(
             poll, error, ret, "Could not process retried msgs");
 
-        if (progressed)
+        /* Copy next RMA chunk */
+        ret = na_sm_process_rma(na_sm_endpoint, &progressed_rma);
+        NA_CHECK_SUBSYS_NA_ERROR(
+            poll, error, ret, "Could not process rma chunks");
+
+        if (progressed || progressed_rma)
             return NA_SUCCESS;
 
         if (timeout_ms != 0)
@@ -5123,7 +6781,8 @@ na_sm_cancel(
             break;
         case NA_CB_PUT:
         case NA_CB_GET:
-            /* Nothing */
+            /* Must remove op_id from RMA op queue if not copied yet */
+            op_queue = &NA_SM_CLASS(na_class)->endpoint.rma_op_queue;
             break;
         default:
             NA_GOTO_SUBSYS_ERROR(op, error, ret, NA_INVALID_ARG,
@@ -5139,9 +6798,10 @@ na_sm_cancel(
         if (hg_atomic_get32(&na_sm_op_id->status) & NA_SM_OP_QUEUED) {
             hg_atomic_or32(&na_sm_op_id->status, NA_SM_OP_CANCELED);
 
-            /* If being retried by process_retries() in the meantime, we'll just
-             * let it cancel there */
-            if (!(hg_atomic_get32(&na_sm_op_id->status) & NA_SM_OP_RETRYING)) {
+            /* If being retried by process_retries() or copied by
+             * process_rma() in the meantime, we'll just let it cancel there */
+            if (!(hg_atomic_get32(&na_sm_op_id->status) &
+                    (NA_SM_OP_RETRYING | NA_SM_OP_COPYING))) {
                 HG_QUEUE_REMOVE(
                     &op_queue->queue, na_sm_op_id, na_sm_op_id, entry);
                 hg_atomic_and32(&na_sm_op_id->status, ~NA_SM_OP_QUEUED);
@@ -5152,7 +6812,10 @@ na_sm_cancel(
 
         /* Cancel op id */
         if (canceled) {
-            na_sm_complete(na_sm_op_id, NA_CANCELED);
+            if (op_queue == &NA_SM_CLASS(na_class)->endpoint.rma_op_queue)
+                na_sm_rma_complete(na_sm_op_id, NA_CANCELED);
+            else
+                na_sm_complete(na_sm_op_id, NA_CANCELED);
 
             na_sm_complete_signal(NA_SM_CLASS(na_class));
         }
@@ -5163,3 +6826,90 @@ na_sm_cancel(
 error:
     return ret;
 }
+
+/*---------------------------------------------------------------------------*/
+static void *
+na_sm_mem_alloc(na_class_t *na_class, size_t size)
+{
+    static hg_atomic_int32_t shm_id_g = HG_ATOMIC_VAR_INIT(0);
+    struct na_sm_shm_seg_list *na_sm_shm_segs =
+        &NA_SM_CLASS(na_class)->shm_segs;
+    size_t page_size = (size_t) hg_mem_get_page_size();
+    char shm_name[NA_SM_MAX_FILENAME] = {'\0'};
+    struct na_sm_shm_seg *na_sm_shm_seg;
+    int rc;
+
+    na_sm_shm_seg =
+        (struct na_sm_shm_seg *) malloc(sizeof(struct na_sm_shm_seg));
+    NA_CHECK_SUBSYS_ERROR_NORET(mem, na_sm_shm_seg == NULL, error,
+        "Could not allocate RMA segment");
+
+    /* Each allocation is backed by its own shared-memory object, which peers
+     * map on first use */
+    na_sm_shm_seg->len = (size + page_size - 1) / page_size * page_size;
+    na_sm_shm_seg->key.pid =
+        NA_SM_CLASS(na_class)->endpoint.source_addr->addr_key.pid;
+    na_sm_shm_seg->key.id = (uint32_t) hg_atomic_incr32(&shm_id_g);
+    na_sm_shm_seg->ref_count = 0;
+
+    rc = NA_SM_PRINT_RMA_SHM_NAME(shm_name, NA_SM_MAX_FILENAME,
+        na_sm_shm_seg->key.pid, na_sm_shm_seg->key.id);
+    NA_CHECK_SUBSYS_ERROR_NORET(mem, rc < 0 || rc > NA_SM_MAX_FILENAME,
+        error, "NA_SM_PRINT_RMA_SHM_NAME() failed, rc: %d", rc);
+
+    NA_LOG_SUBSYS_DEBUG(mem, "shm_map() %s", shm_name);
+    na_sm_shm_seg->addr =
+        (char *) na_sm_shm_map(shm_name, na_sm_shm_seg->len, true);
+    NA_CHECK_SUBSYS_ERROR_NORET(mem, na_sm_shm_seg->addr == NULL, error,
+        "Could not map RMA segment %s", shm_name);
+    na_sm_shm_seg->base = (uintptr_t) na_sm_shm_seg->addr;
+
+    hg_thread_rwlock_wrlock(&na_sm_shm_segs->lock);
+    HG_LIST_INSERT_HEAD(&na_sm_shm_segs->list, na_sm_shm_seg, entry);
+    hg_thread_rwlock_release_wrlock(&na_sm_shm_segs->lock);
+
+    return na_sm_shm_seg->addr;
+
+error:
+    free(na_sm_shm_seg);
+
+    return NULL;
+}
+
+/*---------------------------------------------------------------------------*/
+static na_return_t
+na_sm_mem_free(na_class_t *na_class, void *buf)
+{
+    struct na_sm_shm_seg_list *na_sm_shm_segs =
+        &NA_SM_CLASS(na_class)->shm_segs;
+    char shm_name[NA_SM_MAX_FILENAME] = {'\0'};
+    struct na_sm_shm_seg *na_sm_shm_seg;
+    na_return_t ret;
+    int rc;
+
+    hg_thread_rwlock_wrlock(&na_sm_shm_segs->lock);
+    HG_LIST_FOREACH (na_sm_shm_seg, &na_sm_shm_segs->list, entry) {
+        if (na_sm_shm_seg->addr == (char *) buf) {
+            HG_LIST_REMOVE(na_sm_shm_seg, entry);
+            break;
+        }
+    }
+    hg_thread_rwlock_release_wrlock(&na_sm_shm_segs->lock);
+    NA_CHECK_SUBSYS_ERROR(mem, na_sm_shm_seg == NULL, error, ret,
+        NA_INVALID_ARG, "Buffer (%p) was not allocated by NA SM", buf);
+
+    /* Peers keep their mapping until it is evicted from their cache */
+    rc = NA_SM_PRINT_RMA_SHM_NAME(shm_name, NA_SM_MAX_FILENAME,
+        na_sm_shm_seg->key.pid, na_sm_shm_seg->key.id);
+    NA_CHECK_SUBSYS_ERROR(mem, rc < 0 || rc > NA_SM_MAX_FILENAME, release, ret,
+        NA_OVERFLOW, "NA_SM_PRINT_RMA_SHM_NAME() failed, rc: %d", rc);
+
+    NA_LOG_SUBSYS_DEBUG(mem, "shm_unmap() %s", shm_name);
+    ret = na_sm_shm_unmap(shm_name, na_sm_shm_seg->addr, na_sm_shm_seg->len);
+    NA_CHECK_SUBSYS_NA_ERROR(mem, release, ret, "Could not unmap RMA segment");
+
+release:
+    free(na_sm_shm_seg);
+error:
+    return ret;
+}
@@ -90,6 +90,13 @@ struct na_segment {
     size_t len; /* Size of the segment in bytes */
 };
 
+/* RMA segment (used for vectored put/get) */
+struct na_rma_iov {
+    na_mem_handle_t mem_handle; /* Memory handle of the segment */
+    na_offset_t offset;         /* Offset within the memory handle */
+    size_t len;                 /* Size of the segment in bytes */
+};
+
 /* Return codes:
  * Functions return 0 for success or corresponding return code */
 #define NA_RETURN_VALUES                                                       \
@@ -864,10 +864,15 @@ const struct na_class_ops NA_PLUGIN_OPS(ucx) = {
     na_ucx_mem_handle_deserialize,        /* mem_handle_deserialize */
     na_ucx_put,                           /* put */
     na_ucx_get,                           /* get */
+    NULL,                                 /* rma_get_max_iovcnt */
+    NULL,                                 /* putv */
+    NULL,                                 /* getv */
     na_ucx_poll_get_fd,                   /* poll_get_fd */
     na_ucx_poll_try_wait,                 /* poll_try_wait */
     na_ucx_progress,                      /* progress */
-    na_ucx_cancel                         /* cancel */
+    na_ucx_cancel,                        /* cancel */
+    NULL,                                 /* mem_alloc */
+    NULL                                  /* mem_free */
 };
 
 /* Thread mode names */
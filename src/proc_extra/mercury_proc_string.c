@@ -20,10 +20,54 @@
 /* Local Prototypes */
 /********************/
 
+#ifndef HG_HAS_XDR
+/**
+ * Decode string object in place, pointing to the proc buffer.
+ */
+static hg_return_t
+hg_proc_string_object_view(
+    hg_proc_t proc, hg_string_object_t *strobj, hg_uint64_t string_len);
+#endif
+
 /*******************/
 /* Local Variables */
 /*******************/
 
+/*---------------------------------------------------------------------------*/
+#ifndef HG_HAS_XDR
+static hg_return_t
+hg_proc_string_object_view(
+    hg_proc_t proc, hg_string_object_t *strobj, hg_uint64_t string_len)
+{
+    char *data;
+    hg_return_t ret;
+
+    if (hg_proc_get_size_left(proc) < string_len)
+        return HG_OVERFLOW;
+
+    data = (char *) hg_proc_save_ptr(proc, string_len);
+    /* Encoded length includes the terminating NULL character */
+    if (data[string_len - 1] != '\0')
+        return HG_PROTOCOL_ERROR;
+    ret = hg_proc_restore_ptr(proc, data, string_len);
+    if (ret != HG_SUCCESS)
+        return ret;
+
+    ret = hg_proc_hg_uint8_t(proc, (hg_uint8_t *) &strobj->is_const);
+    if (ret != HG_SUCCESS)
+        return ret;
+    ret = hg_proc_hg_uint8_t(proc, (hg_uint8_t *) &strobj->is_owned);
+    if (ret != HG_SUCCESS)
+        return ret;
+
+    /* Buffer is owned by the proc, never free it */
+    strobj->data = data;
+    strobj->is_owned = 0;
+
+    return HG_SUCCESS;
+}
+#endif
+
 /*---------------------------------------------------------------------------*/
 hg_return_t
 hg_proc_hg_string_object_t(hg_proc_t proc, void *string)
@@ -57,6 +101,14 @@ hg_proc_hg_string_object_t(hg_proc_t proc, void *string)
             if (ret != HG_SUCCESS)
                 goto done;
             if (string_len) {
+#ifndef HG_HAS_XDR
+                if (hg_proc_get_flags(proc) & HG_PROC_ZERO_COPY) {
+                    ret = hg_proc_string_object_view(proc, strobj, string_len);
+                    if (ret != HG_SUCCESS)
+                        goto done;
+                    break;
+                }
+#endif
                 strobj->data = (char *) malloc(string_len);
                 if (strobj->data == NULL) {
                     ret = HG_NOMEM;
@@ -86,6 +138,11 @@ hg_proc_hg_string_object_t(hg_proc_t proc, void *string)
                 strobj->data = NULL;
             break;
         case HG_FREE:
+            /* Data points into the proc buffer if decoded in place */
+            if (hg_proc_get_flags(proc) & HG_PROC_ZERO_COPY) {
+                strobj->data = NULL;
+                break;
+            }
             ret = hg_string_object_free(strobj);
             if (ret != HG_SUCCESS)
                 goto done;
@@ -113,6 +113,20 @@ hg_atomic_queue_free(struct hg_atomic_queue *hg_atomic_queue);
 static HG_UTIL_INLINE int
 hg_atomic_queue_push(struct hg_atomic_queue *hg_atomic_queue, void *entry);
 
+/**
+ * Push up to \count entries to the queue. Slots for all the entries that can
+ * be pushed are reserved at once.
+ *
+ * \param hg_atomic_queue [IN/OUT]  pointer to queue
+ * \param entries [IN]              array of pointers to objects
+ * \param count [IN]                number of entries in array
+ *
+ * \return Number of entries pushed (less than \count if queue is full)
+ */
+static HG_UTIL_INLINE unsigned int
+hg_atomic_queue_push_n(struct hg_atomic_queue *hg_atomic_queue, void *entries[],
+    unsigned int count);
+
 /**
  * Pop an entry from the queue (multi-consumer).
  *
@@ -123,6 +137,20 @@ hg_atomic_queue_push(struct hg_atomic_queue *hg_atomic_queue, void *entry);
 static HG_UTIL_INLINE void *
 hg_atomic_queue_pop_mc(struct hg_atomic_queue *hg_atomic_queue);
 
+/**
+ * Pop up to \count entries from the queue (multi-consumer). Entries that are
+ * available are dequeued at once.
+ *
+ * \param hg_atomic_queue [IN/OUT]  pointer to queue
+ * \param entries [OUT]             array of pointers to popped objects
+ * \param count [IN]                max number of entries to pop
+ *
+ * \return Number of entries popped or 0 if queue is empty
+ */
+static HG_UTIL_INLINE unsigned int
+hg_atomic_queue_pop_n(struct hg_atomic_queue *hg_atomic_queue, void *entries[],
+    unsigned int count);
+
 /**
  * Pop an entry from the queue (single consumer).
  *
@@ -192,6 +220,60 @@ hg_atomic_queue_push(struct hg_atomic_queue *hg_atomic_queue, void *entry)
     return HG_UTIL_SUCCESS;
 }
 
+/*---------------------------------------------------------------------------*/
+static HG_UTIL_INLINE unsigned int
+hg_atomic_queue_push_n(struct hg_atomic_queue *hg_atomic_queue, void *entries[],
+    unsigned int count)
+{
+    int32_t prod_head, prod_next, cons_tail;
+    unsigned int free_count, n, i;
+
+    if (count == 0)
+        return 0;
+
+    for (;;) {
+        prod_head = hg_atomic_get32(&hg_atomic_queue->prod_head);
+        cons_tail = hg_atomic_get32(&hg_atomic_queue->cons_tail);
+        free_count = ((unsigned int) cons_tail - (unsigned int) prod_head - 1) &
+                     hg_atomic_queue->prod_mask;
+
+        if (free_count == 0) {
+            hg_atomic_fence();
+            if (prod_head == hg_atomic_get32(&hg_atomic_queue->prod_head) &&
+                cons_tail == hg_atomic_get32(&hg_atomic_queue->cons_tail)) {
+                hg_atomic_queue->drops++;
+                /* Full */
+                return 0;
+            }
+            continue;
+        }
+        n = (count < free_count) ? count : free_count;
+        prod_next =
+            (prod_head + (int32_t) n) & (int) hg_atomic_queue->prod_mask;
+
+        /* Reserve all n slots at once */
+        if (hg_atomic_cas32(&hg_atomic_queue->prod_head, prod_head, prod_next))
+            break;
+    }
+
+    for (i = 0; i < n; i++)
+        hg_atomic_set64(&hg_atomic_queue->ring[((unsigned int) prod_head + i) &
+                                               hg_atomic_queue->prod_mask],
+            (int64_t) entries[i]);
+
+    /*
+     * If there are other enqueues in progress
+     * that preceded us, we need to wait for them
+     * to complete
+     */
+    while (hg_atomic_get32(&hg_atomic_queue->prod_tail) != prod_head)
+        cpu_spinwait();
+
+    hg_atomic_set32(&hg_atomic_queue->prod_tail, prod_next);
+
+    return n;
+}
+
 /*---------------------------------------------------------------------------*/
 static HG_UTIL_INLINE void *
 hg_atomic_queue_pop_mc(struct hg_atomic_queue *hg_atomic_queue)
@@ -223,6 +305,51 @@ hg_atomic_queue_pop_mc(struct hg_atomic_queue *hg_atomic_queue)
     return entry;
 }
 
+/*---------------------------------------------------------------------------*/
+static HG_UTIL_INLINE unsigned int
+hg_atomic_queue_pop_n(struct hg_atomic_queue *hg_atomic_queue, void *entries[],
+    unsigned int count)
+{
+    int32_t cons_head, cons_next, prod_tail;
+    unsigned int avail_count, n, i;
+
+    if (count == 0)
+        return 0;
+
+    do {
+        cons_head = hg_atomic_get32(&hg_atomic_queue->cons_head);
+        prod_tail = hg_atomic_get32(&hg_atomic_queue->prod_tail);
+        avail_count = ((unsigned int) prod_tail - (unsigned int) cons_head) &
+                      hg_atomic_queue->cons_mask;
+
+        if (avail_count == 0)
+            /* Empty */
+            return 0;
+
+        n = (count < avail_count) ? count : avail_count;
+        cons_next =
+            (cons_head + (int32_t) n) & (int) hg_atomic_queue->cons_mask;
+    } while (
+        !hg_atomic_cas32(&hg_atomic_queue->cons_head, cons_head, cons_next));
+
+    for (i = 0; i < n; i++)
+        entries[i] = (void *) hg_atomic_get64(
+            &hg_atomic_queue->ring[((unsigned int) cons_head + i) &
+                                   hg_atomic_queue->cons_mask]);
+
+    /*
+     * If there are other dequeues in progress
+     * that preceded us, we need to wait for them
+     * to complete
+     */
+    while (hg_atomic_get32(&hg_atomic_queue->cons_tail) != cons_head)
+        cpu_spinwait();
+
+    hg_atomic_set32(&hg_atomic_queue->cons_tail, cons_next);
+
+    return n;
+}
+
 /*---------------------------------------------------------------------------*/
 static HG_UTIL_INLINE void *
 hg_atomic_queue_pop_sc(struct hg_atomic_queue *hg_atomic_queue)
@@ -0,0 +1,609 @@
+/**
+ * Copyright (c) 2013-2021 UChicago Argonne, LLC and The HDF Group.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "mercury_checksum.h"
+#include "mercury_byteswap.h"
+
+#include <string.h>
+
+#ifdef HG_UTIL_HAS_CHECKSUM_SIMD
+#    include <immintrin.h>
+#endif
+
+/****************/
+/* Local Macros */
+/****************/
+
+/* Non-reflected polynomial (CRC-16/BUYPASS, as used by mchecksum) */
+#define HG_CHECKSUM_CRC16_POLY (0x8005U)
+
+/* Reflected polynomials */
+#define HG_CHECKSUM_CRC32C_POLY (0x82F63B78U)
+#define HG_CHECKSUM_CRC64_POLY  (0xC96C5795D7870F42ULL)
+
+/* Minimum sizes for folding to be worth it */
+#define HG_CHECKSUM_FOLD_MIN    (64)
+#define HG_CHECKSUM_FOLD512_MIN (256)
+
+/* Function target attributes */
+#ifdef HG_UTIL_HAS_CHECKSUM_SIMD
+#    define HG_CHECKSUM_TARGET_SSE42  __attribute__((target("sse4.2")))
+#    define HG_CHECKSUM_TARGET_PCLMUL __attribute__((target("sse4.2,pclmul")))
+#    define HG_CHECKSUM_TARGET_AVX512                                          \
+        __attribute__((target("sse4.2,pclmul,avx512f,vpclmulqdq")))
+#endif
+
+/* Little-endian 64-bit loads */
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+#    define HG_CHECKSUM_LE64(x) bswap_64(x)
+#else
+#    define HG_CHECKSUM_LE64(x) (x)
+#endif
+
+/************************************/
+/* Local Type and Struct Definition */
+/************************************/
+
+/* Implementation levels */
+typedef enum {
+    HG_CHECKSUM_GENERIC,
+    HG_CHECKSUM_SSE42,
+    HG_CHECKSUM_PCLMUL,
+    HG_CHECKSUM_AVX512
+} hg_checksum_level_t;
+
+/* Raw CRC update (no pre/post inversion) */
+typedef uint64_t (*hg_checksum_raw_t)(
+    uint64_t crc, const unsigned char *buf, size_t size);
+
+/* Folding constants, each pair multiplies the low and high quadwords of a
+ * 128-bit block, 2^x below refers to the folding distance in bits */
+struct hg_checksum_fold {
+    uint64_t k128[2];  /* Fold by 2^128 */
+    uint64_t k512[2];  /* Fold by 2^512 */
+    uint64_t k2048[2]; /* Fold by 2^2048 */
+};
+
+/* Checksum descriptor */
+struct hg_checksum_crc {
+    struct hg_checksum_fold fold;   /* Folding constants */
+    hg_checksum_raw_t update;       /* Selected update routine */
+    hg_checksum_raw_t update_small; /* Update routine for small buffers */
+};
+
+/********************/
+/* Local Prototypes */
+/********************/
+
+/* Init tables and select implementation */
+static void
+hg_checksum_init(void) HG_ATTR_CONSTRUCTOR;
+
+/* Build CRC16 table */
+static void
+hg_checksum_crc16_table_init(uint16_t table[256], uint16_t poly);
+
+/* Build slicing tables */
+static void
+hg_checksum_table_init(uint64_t table[8][256], uint64_t poly);
+
+/* Compute folding constants */
+static void
+hg_checksum_fold_init(
+    struct hg_checksum_fold *fold, uint64_t poly, unsigned int width);
+
+/* Compute x^n mod P (non-reflected) */
+static uint64_t
+hg_checksum_xpow_mod(unsigned int n, uint64_t poly, unsigned int width);
+
+/* Reflect 64-bit value */
+static uint64_t
+hg_checksum_reflect64(uint64_t value, unsigned int width);
+
+/* Get highest level supported by CPU */
+static hg_checksum_level_t
+hg_checksum_level_max(void);
+
+/* Set implementation level */
+static void
+hg_checksum_level_set(hg_checksum_level_t level);
+
+/* Generic CRC32C (slicing-by-8) */
+static uint64_t
+hg_checksum_crc32c_generic(uint64_t crc, const unsigned char *buf, size_t size);
+
+/* Generic CRC64 (slicing-by-8) */
+static uint64_t
+hg_checksum_crc64_generic(uint64_t crc, const unsigned char *buf, size_t size);
+
+#ifdef HG_UTIL_HAS_CHECKSUM_SIMD
+/* CRC32C using SSE4.2 crc32 instruction */
+static uint64_t
+hg_checksum_crc32c_sse42(uint64_t crc, const unsigned char *buf,
+    size_t size) HG_CHECKSUM_TARGET_SSE42;
+
+/* Fold 128-bit lanes using PCLMULQDQ */
+static uint64_t
+hg_checksum_fold_pclmul(const struct hg_checksum_crc *crc_desc, uint64_t crc,
+    const unsigned char *buf, size_t size) HG_CHECKSUM_TARGET_PCLMUL;
+
+/* Fold 512-bit lanes using AVX-512 VPCLMULQDQ */
+static uint64_t
+hg_checksum_fold_avx512(const struct hg_checksum_crc *crc_desc, uint64_t crc,
+    const unsigned char *buf, size_t size) HG_CHECKSUM_TARGET_AVX512;
+
+/* Wrappers for folding routines */
+static uint64_t
+hg_checksum_crc32c_pclmul(uint64_t crc, const unsigned char *buf, size_t size);
+static uint64_t
+hg_checksum_crc32c_avx512(uint64_t crc, const unsigned char *buf, size_t size);
+static uint64_t
+hg_checksum_crc64_pclmul(uint64_t crc, const unsigned char *buf, size_t size);
+static uint64_t
+hg_checksum_crc64_avx512(uint64_t crc, const unsigned char *buf, size_t size);
+#endif
+
+/*******************/
+/* Local Variables */
+/*******************/
+
+/* CRC16 table */
+static uint16_t hg_checksum_crc16_table_g[256];
+
+/* Slicing tables */
+static uint64_t hg_checksum_crc32c_table_g[8][256];
+static uint64_t hg_checksum_crc64_table_g[8][256];
+
+/* Checksum descriptors */
+static struct hg_checksum_crc hg_checksum_crc32c_g = {
+    .update = hg_checksum_crc32c_generic,
+    .update_small = hg_checksum_crc32c_generic};
+static struct hg_checksum_crc hg_checksum_crc64_g = {
+    .update = hg_checksum_crc64_generic,
+    .update_small = hg_checksum_crc64_generic};
+
+/* Implementation names (indexed by level) */
+static const char *const hg_checksum_level_name_g[] = {
+    "generic", "sse4.2", "pclmul", "avx512"};
+
+/* Current level */
+static hg_checksum_level_t hg_checksum_level_g = HG_CHECKSUM_GENERIC;
+
+/*---------------------------------------------------------------------------*/
+static void
+hg_checksum_init(void)
+{
+    hg_checksum_crc16_table_init(
+        hg_checksum_crc16_table_g, HG_CHECKSUM_CRC16_POLY);
+    hg_checksum_table_init(hg_checksum_crc32c_table_g, HG_CHECKSUM_CRC32C_POLY);
+    hg_checksum_table_init(hg_checksum_crc64_table_g, HG_CHECKSUM_CRC64_POLY);
+
+    /* Folding operates on non-reflected polynomials */
+    hg_checksum_fold_init(&hg_checksum_crc32c_g.fold,
+        hg_checksum_reflect64(HG_CHECKSUM_CRC32C_POLY, 32), 32);
+    hg_checksum_fold_init(&hg_checksum_crc64_g.fold,
+        hg_checksum_reflect64(HG_CHECKSUM_CRC64_POLY, 64), 64);
+
+    hg_checksum_level_set(hg_checksum_level_max());
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+hg_checksum_crc16_table_init(uint16_t table[256], uint16_t poly)
+{
+    unsigned int i, j;
+
+    for (i = 0; i < 256; i++) {
+        uint16_t crc = (uint16_t) (i << 8);
+
+        for (j = 0; j < 8; j++)
+            crc = (uint16_t) ((crc << 1) ^ ((crc & 0x8000) ? poly : 0));
+        table[i] = crc;
+    }
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+hg_checksum_table_init(uint64_t table[8][256], uint64_t poly)
+{
+    unsigned int i, j;
+
+    for (i = 0; i < 256; i++) {
+        uint64_t crc = i;
+
+        for (j = 0; j < 8; j++)
+            crc = (crc >> 1) ^ ((crc & 1) ? poly : 0);
+        table[0][i] = crc;
+    }
+
+    for (i = 0; i < 256; i++)
+        for (j = 1; j < 8; j++)
+            table[j][i] =
+                (table[j - 1][i] >> 8) ^ table[0][table[j - 1][i] & 0xff];
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+hg_checksum_fold_init(
+    struct hg_checksum_fold *fold, uint64_t poly, unsigned int width)
+{
+    /* The low quadword of a block holds the upper 64 coefficients, products
+     * of reflected operands are off by one bit, hence the -1 */
+    fold->k128[0] = hg_checksum_reflect64(
+        hg_checksum_xpow_mod(128 + 63, poly, width), 64);
+    fold->k128[1] =
+        hg_checksum_reflect64(hg_checksum_xpow_mod(128 - 1, poly, width), 64);
+    fold->k512[0] = hg_checksum_reflect64(
+        hg_checksum_xpow_mod(512 + 63, poly, width), 64);
+    fold->k512[1] =
+        hg_checksum_reflect64(hg_checksum_xpow_mod(512 - 1, poly, width), 64);
+    fold->k2048[0] = hg_checksum_reflect64(
+        hg_checksum_xpow_mod(2048 + 63, poly, width), 64);
+    fold->k2048[1] =
+        hg_checksum_reflect64(hg_checksum_xpow_mod(2048 - 1, poly, width), 64);
+}
+
+/*---------------------------------------------------------------------------*/
+static uint64_t
+hg_checksum_xpow_mod(unsigned int n, uint64_t poly, unsigned int width)
+{
+    uint64_t top = (uint64_t) 1 << (width - 1);
+    uint64_t mask = (width == 64) ? ~(uint64_t) 0 : (top << 1) - 1;
+    uint64_t r = 1;
+
+    while (n--) {
+        uint64_t carry = r & top;
+
+        r = (r << 1) & mask;
+        if (carry)
+            r ^= poly;
+    }
+
+    return r;
+}
+
+/*---------------------------------------------------------------------------*/
+static uint64_t
+hg_checksum_reflect64(uint64_t value, unsigned int width)
+{
+    uint64_t r = 0;
+    unsigned int i;
+
+    for (i = 0; i < width; i++)
+        if (value & ((uint64_t) 1 << i))
+            r |= (uint64_t) 1 << (width - 1 - i);
+
+    return r;
+}
+
+/*---------------------------------------------------------------------------*/
+static hg_checksum_level_t
+hg_checksum_level_max(void)
+{
+#ifdef HG_UTIL_HAS_CHECKSUM_SIMD
+    __builtin_cpu_init();
+    if (!__builtin_cpu_supports("sse4.2"))
+        return HG_CHECKSUM_GENERIC;
+    if (!__builtin_cpu_supports("pclmul"))
+        return HG_CHECKSUM_SSE42;
+    if (!__builtin_cpu_supports("avx512f") ||
+        !__builtin_cpu_supports("vpclmulqdq"))
+        return HG_CHECKSUM_PCLMUL;
+    return HG_CHECKSUM_AVX512;
+#else
+    return HG_CHECKSUM_GENERIC;
+#endif
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+hg_checksum_level_set(hg_checksum_level_t level)
+{
+    hg_checksum_crc32c_g.update = hg_checksum_crc32c_generic;
+    hg_checksum_crc32c_g.update_small = hg_checksum_crc32c_generic;
+    hg_checksum_crc64_g.update = hg_checksum_crc64_generic;
+    hg_checksum_crc64_g.update_small = hg_checksum_crc64_generic;
+
+#ifdef HG_UTIL_HAS_CHECKSUM_SIMD
+    if (level >= HG_CHECKSUM_SSE42) {
+        hg_checksum_crc32c_g.update = hg_checksum_crc32c_sse42;
+        hg_checksum_crc32c_g.update_small = hg_checksum_crc32c_sse42;
+    }
+    if (level >= HG_CHECKSUM_PCLMUL) {
+        hg_checksum_crc32c_g.update = hg_checksum_crc32c_pclmul;
+        hg_checksum_crc64_g.update = hg_checksum_crc64_pclmul;
+    }
+    if (level >= HG_CHECKSUM_AVX512) {
+        hg_checksum_crc32c_g.update = hg_checksum_crc32c_avx512;
+        hg_checksum_crc64_g.update = hg_checksum_crc64_avx512;
+    }
+#endif
+
+    hg_checksum_level_g = level;
+}
+
+/*---------------------------------------------------------------------------*/
+static uint64_t
+hg_checksum_crc32c_generic(uint64_t crc, const unsigned char *buf, size_t size)
+{
+    uint64_t(*table)[256] = hg_checksum_crc32c_table_g;
+
+    while (size >= sizeof(uint64_t)) {
+        uint64_t value;
+        uint32_t lo, hi;
+
+        memcpy(&value, buf, sizeof(value));
+        value = HG_CHECKSUM_LE64(value);
+        lo = (uint32_t) (crc ^ value);
+        hi = (uint32_t) (value >> 32);
+        crc = table[7][lo & 0xff] ^ table[6][(lo >> 8) & 0xff] ^
+              table[5][(lo >> 16) & 0xff] ^ table[4][lo >> 24] ^
+              table[3][hi & 0xff] ^ table[2][(hi >> 8) & 0xff] ^
+              table[1][(hi >> 16) & 0xff] ^ table[0][hi >> 24];
+        buf += sizeof(uint64_t);
+        size -= sizeof(uint64_t);
+    }
+
+    while (size--)
+        crc = table[0][(crc ^ *buf++) & 0xff] ^ (crc >> 8);
+
+    return crc;
+}
+
+/*---------------------------------------------------------------------------*/
+static uint64_t
+hg_checksum_crc64_generic(uint64_t crc, const unsigned char *buf, size_t size)
+{
+    uint64_t(*table)[256] = hg_checksum_crc64_table_g;
+
+    while (size >= sizeof(uint64_t)) {
+        uint64_t value;
+
+        memcpy(&value, buf, sizeof(value));
+        crc ^= HG_CHECKSUM_LE64(value);
+        crc = table[7][crc & 0xff] ^ table[6][(crc >> 8) & 0xff] ^
+              table[5][(crc >> 16) & 0xff] ^ table[4][(crc >> 24) & 0xff] ^
+              table[3][(crc >> 32) & 0xff] ^ table[2][(crc >> 40) & 0xff] ^
+              table[1][(crc >> 48) & 0xff] ^ table[0][crc >> 56];
+        buf += sizeof(uint64_t);
+        size -= sizeof(uint64_t);
+    }
+
+    while (size--)
+        crc = table[0][(crc ^ *buf++) & 0xff] ^ (crc >> 8);
+
+    return crc;
+}
+
+#ifdef HG_UTIL_HAS_CHECKSUM_SIMD
+/*---------------------------------------------------------------------------*/
+static uint64_t
+hg_checksum_crc32c_sse42(uint64_t crc, const unsigned char *buf, size_t size)
+{
+    while (size >= sizeof(uint64_t)) {
+        uint64_t value;
+
+        memcpy(&value, buf, sizeof(value));
+        crc = _mm_crc32_u64(crc, value);
+        buf += sizeof(uint64_t);
+        size -= sizeof(uint64_t);
+    }
+
+    while (size--)
+        crc = _mm_crc32_u8((uint32_t) crc, *buf++);
+
+    return crc;
+}
+
+/*---------------------------------------------------------------------------*/
+static uint64_t
+hg_checksum_fold_pclmul(const struct hg_checksum_crc *crc_desc, uint64_t crc,
+    const unsigned char *buf, size_t size)
+{
+    const struct hg_checksum_fold *fold = &crc_desc->fold;
+    __m128i x0, x1, x2, x3, k;
+    unsigned char tmp[16];
+
+    if (size < HG_CHECKSUM_FOLD_MIN)
+        return crc_desc->update_small(crc, buf, size);
+
+    /* Initial CRC value is combined with the first bytes */
+    x0 = _mm_xor_si128(_mm_loadu_si128((const __m128i *) buf),
+        _mm_cvtsi64_si128((long long) crc));
+    x1 = _mm_loadu_si128((const __m128i *) (buf + 16));
+    x2 = _mm_loadu_si128((const __m128i *) (buf + 32));
+    x3 = _mm_loadu_si128((const __m128i *) (buf + 48));
+    buf += 64;
+    size -= 64;
+
+#    define HG_CHECKSUM_FOLD128(x, k, next)                                    \
+        _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x, k, 0x00),          \
+                          _mm_clmulepi64_si128(x, k, 0x11)),                   \
+            next)
+
+    /* Fold 4 lanes of 128 bits in parallel */
+    k = _mm_set_epi64x((long long) fold->k512[1], (long long) fold->k512[0]);
+    while (size >= 64) {
+        x0 = HG_CHECKSUM_FOLD128(
+            x0, k, _mm_loadu_si128((const __m128i *) buf));
+        x1 = HG_CHECKSUM_FOLD128(
+            x1, k, _mm_loadu_si128((const __m128i *) (buf + 16)));
+        x2 = HG_CHECKSUM_FOLD128(
+            x2, k, _mm_loadu_si128((const __m128i *) (buf + 32)));
+        x3 = HG_CHECKSUM_FOLD128(
+            x3, k, _mm_loadu_si128((const __m128i *) (buf + 48)));
+        buf += 64;
+        size -= 64;
+    }
+
+    /* Fold lanes into one and fold remaining blocks */
+    k = _mm_set_epi64x((long long) fold->k128[1], (long long) fold->k128[0]);
+    x0 = HG_CHECKSUM_FOLD128(x0, k, x1);
+    x0 = HG_CHECKSUM_FOLD128(x0, k, x2);
+    x0 = HG_CHECKSUM_FOLD128(x0, k, x3);
+    while (size >= 16) {
+        x0 = HG_CHECKSUM_FOLD128(
+            x0, k, _mm_loadu_si128((const __m128i *) buf));
+        buf += 16;
+        size -= 16;
+    }
+
+#    undef HG_CHECKSUM_FOLD128
+
+    /* Remaining 128 bits are congruent to the data folded so far */
+    _mm_storeu_si128((__m128i *) tmp, x0);
+    crc = crc_desc->update_small(0, tmp, sizeof(tmp));
+
+    return crc_desc->update_small(crc, buf, size);
+}
+
+/*---------------------------------------------------------------------------*/
+static uint64_t
+hg_checksum_fold_avx512(const struct hg_checksum_crc *crc_desc, uint64_t crc,
+    const unsigned char *buf, size_t size)
+{
+    const struct hg_checksum_fold *fold = &crc_desc->fold;
+    __m512i z0, z1, z2, z3, k;
+    unsigned char tmp[64];
+
+    if (size < HG_CHECKSUM_FOLD512_MIN)
+        return hg_checksum_fold_pclmul(crc_desc, crc, buf, size);
+
+    /* Initial CRC value is combined with the first bytes */
+    z0 = _mm512_xor_si512(_mm512_loadu_si512((const void *) buf),
+        _mm512_inserti32x4(_mm512_setzero_si512(),
+            _mm_cvtsi64_si128((long long) crc), 0));
+    z1 = _mm512_loadu_si512((const void *) (buf + 64));
+    z2 = _mm512_loadu_si512((const void *) (buf + 128));
+    z3 = _mm512_loadu_si512((const void *) (buf + 192));
+    buf += 256;
+    size -= 256;
+
+#    define HG_CHECKSUM_FOLD512(z, k, next)                                    \
+        _mm512_xor_si512(                                                      \
+            _mm512_xor_si512(_mm512_clmulepi64_epi128(z, k, 0x00),             \
+                _mm512_clmulepi64_epi128(z, k, 0x11)),                         \
+            next)
+
+    /* Fold 16 lanes of 128 bits in parallel */
+    k = _mm512_broadcast_i32x4(_mm_set_epi64x(
+        (long long) fold->k2048[1], (long long) fold->k2048[0]));
+    while (size >= 256) {
+        z0 = HG_CHECKSUM_FOLD512(
+            z0, k, _mm512_loadu_si512((const void *) buf));
+        z1 = HG_CHECKSUM_FOLD512(
+            z1, k, _mm512_loadu_si512((const void *) (buf + 64)));
+        z2 = HG_CHECKSUM_FOLD512(
+            z2, k, _mm512_loadu_si512((const void *) (buf + 128)));
+        z3 = HG_CHECKSUM_FOLD512(
+            z3, k, _mm512_loadu_si512((const void *) (buf + 192)));
+        buf += 256;
+        size -= 256;
+    }
+
+    /* Fold registers into one and fold remaining blocks */
+    k = _mm512_broadcast_i32x4(_mm_set_epi64x(
+        (long long) fold->k512[1], (long long) fold->k512[0]));
+    z0 = HG_CHECKSUM_FOLD512(z0, k, z1);
+    z0 = HG_CHECKSUM_FOLD512(z0, k, z2);
+    z0 = HG_CHECKSUM_FOLD512(z0, k, z3);
+    while (size >= 64) {
+        z0 = HG_CHECKSUM_FOLD512(
+            z0, k, _mm512_loadu_si512((const void *) buf));
+        buf += 64;
+        size -= 64;
+    }
+
+#    undef HG_CHECKSUM_FOLD512
+
+    /* Remaining 512 bits are congruent to the data folded so far */
+    _mm512_storeu_si512((void *) tmp, z0);
+    crc = hg_checksum_fold_pclmul(crc_desc, 0, tmp, sizeof(tmp));
+
+    return hg_checksum_fold_pclmul(crc_desc, crc, buf, size);
+}
+
+/*---------------------------------------------------------------------------*/
+static uint64_t
+hg_checksum_crc32c_pclmul(uint64_t crc, const unsigned char *buf, size_t size)
+{
+    return hg_checksum_fold_pclmul(&hg_checksum_crc32c_g, crc, buf, size);
+}
+
+/*---------------------------------------------------------------------------*/
+static uint64_t
+hg_checksum_crc32c_avx512(uint64_t crc, const unsigned char *buf, size_t size)
+{
+    return hg_checksum_fold_avx512(&hg_checksum_crc32c_g, crc, buf, size);
+}
+
+/*---------------------------------------------------------------------------*/
+static uint64_t
+hg_checksum_crc64_pclmul(uint64_t crc, const unsigned char *buf, size_t size)
+{
+    return hg_checksum_fold_pclmul(&hg_checksum_crc64_g, crc, buf, size);
+}
+
+/*---------------------------------------------------------------------------*/
+static uint64_t
+hg_checksum_crc64_avx512(uint64_t crc, const unsigned char *buf, size_t size)
+{
+    return hg_checksum_fold_avx512(&hg_checksum_crc64_g, crc, buf, size);
+}
+#endif
+
+/*---------------------------------------------------------------------------*/
+uint16_t
+hg_checksum_crc16(uint16_t crc, const void *buf, size_t size)
+{
+    const unsigned char *ptr = (const unsigned char *) buf;
+
+    /* Only used for small headers, a single table is enough */
+    while (size--)
+        crc = (uint16_t) ((crc << 8) ^
+                          hg_checksum_crc16_table_g[(crc >> 8) ^ *ptr++]);
+
+    return crc;
+}
+
+/*---------------------------------------------------------------------------*/
+uint32_t
+hg_checksum_crc32c(uint32_t crc, const void *buf, size_t size)
+{
+    return ~(uint32_t) hg_checksum_crc32c_g.update(
+        (uint64_t) ~crc, (const unsigned char *) buf, size);
+}
+
+/*---------------------------------------------------------------------------*/
+uint64_t
+hg_checksum_crc64(uint64_t crc, const void *buf, size_t size)
+{
+    return ~hg_checksum_crc64_g.update(
+        ~crc, (const unsigned char *) buf, size);
+}
+
+/*---------------------------------------------------------------------------*/
+int
+hg_checksum_set_impl(const char *name)
+{
+    unsigned int i;
+
+    for (i = 0; i <= (unsigned int) hg_checksum_level_max(); i++) {
+        if (strcmp(name, hg_checksum_level_name_g[i]) == 0) {
+            hg_checksum_level_set((hg_checksum_level_t) i);
+            return HG_UTIL_SUCCESS;
+        }
+    }
+
+    return HG_UTIL_FAIL;
+}
+
+/*---------------------------------------------------------------------------*/
+const char *
+hg_checksum_get_impl(void)
+{
+    return hg_checksum_level_name_g[hg_checksum_level_g];
+}
@@ -0,0 +1,103 @@
+/**
+ * Copyright (c) 2013-2021 UChicago Argonne, LLC and The HDF Group.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef MERCURY_CHECKSUM_H
+#define MERCURY_CHECKSUM_H
+
+#include "mercury_util_config.h"
+
+/*************************************/
+/* Public Type and Struct Definition */
+/*************************************/
+
+/*****************/
+/* Public Macros */
+/*****************/
+
+/*********************/
+/* Public Prototypes */
+/*********************/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Compute CRC16 (polynomial 0x8005, non-reflected, no final XOR) checksum of
+ * buffer, compatible with mchecksum's "crc16". Checksum of non-contiguous data
+ * can be computed by passing the value returned by a previous call as \crc,
+ * initial value must be 0.
+ *
+ * \param crc [IN]              previous checksum value
+ * \param buf [IN]              pointer to buffer
+ * \param size [IN]             buffer size
+ *
+ * \return Checksum value
+ */
+HG_UTIL_PUBLIC uint16_t
+hg_checksum_crc16(uint16_t crc, const void *buf, size_t size);
+
+/**
+ * Compute CRC32C (Castagnoli) checksum of buffer. Checksum of non-contiguous
+ * data can be computed by passing the value returned by a previous call as
+ * \crc, initial value must be 0.
+ *
+ * \remark The fastest implementation supported by the CPU is selected at
+ * load time (see hg_checksum_set_impl()).
+ *
+ * \param crc [IN]              previous checksum value
+ * \param buf [IN]              pointer to buffer
+ * \param size [IN]             buffer size
+ *
+ * \return Checksum value
+ */
+HG_UTIL_PUBLIC uint32_t
+hg_checksum_crc32c(uint32_t crc, const void *buf, size_t size);
+
+/**
+ * Compute CRC64 (ECMA-182 polynomial, reflected, as used by XZ) checksum of
+ * buffer. Checksum of non-contiguous data can be computed by passing the value
+ * returned by a previous call as \crc, initial value must be 0.
+ *
+ * \remark The fastest implementation supported by the CPU is selected at
+ * load time (see hg_checksum_set_impl()).
+ *
+ * \param crc [IN]              previous checksum value
+ * \param buf [IN]              pointer to buffer
+ * \param size [IN]             buffer size
+ *
+ * \return Checksum value
+ */
+HG_UTIL_PUBLIC uint64_t
+hg_checksum_crc64(uint64_t crc, const void *buf, size_t size);
+
+/**
+ * Select checksum implementation, available implementations are (if supported
+ * by the CPU): "generic", "sse4.2", "pclmul", "avx512". Implementations that
+ * do not apply to a given checksum fall back to the next slower one.
+ *
+ * \remark Not thread-safe, must not be called while checksums are computed.
+ *
+ * \param name [IN]             implementation name
+ *
+ * \return HG_UTIL_SUCCESS if successful / error code otherwise
+ */
+HG_UTIL_PUBLIC int
+hg_checksum_set_impl(const char *name);
+
+/**
+ * Get name of the checksum implementation currently in use.
+ *
+ * \return Implementation name
+ */
+HG_UTIL_PUBLIC const char *
+hg_checksum_get_impl(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MERCURY_CHECKSUM_H */
@@ -0,0 +1,431 @@
+/**
+ * Copyright (c) 2013-2021 UChicago Argonne, LLC and The HDF Group.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "mercury_hash_map.h"
+
+#include "mercury_atomic.h"
+#include "mercury_mem.h"
+#include "mercury_thread.h"
+#include "mercury_thread_spin.h"
+#include "mercury_util_error.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/****************/
+/* Local Macros */
+/****************/
+
+/* Initial number of slots (must be a power of 2) */
+#define HG_HASH_MAP_NUM_SLOTS_MIN (16)
+
+/* Round up to 8 bytes so that slot values stay aligned */
+#define HG_HASH_MAP_ALIGN(x) (((x) + 7) & ~((size_t) 7))
+
+/* Keys are stored after each slot header */
+#define HG_HASH_MAP_KEY_OFFSET                                                 \
+    HG_HASH_MAP_ALIGN(sizeof(struct hg_hash_map_slot))
+
+/* Get slot at index */
+#define HG_HASH_MAP_SLOT(map, table, index)                                    \
+    ((struct hg_hash_map_slot *) ((table)->slots +                             \
+                                  (size_t) (index) * (map)->slot_size))
+
+/* Get key of slot */
+#define HG_HASH_MAP_SLOT_KEY(slot)                                             \
+    ((void *) ((char *) (slot) + HG_HASH_MAP_KEY_OFFSET))
+
+/* Table is grown once more than 3/4 of its slots are used */
+#define HG_HASH_MAP_FULL(table, count)                                         \
+    (4 * (size_t) (count) > ((size_t) (table)->mask + 1) * 3)
+
+/************************************/
+/* Local Type and Struct Definition */
+/************************************/
+
+/**
+ * Slot header, followed by a copy of the key. Empty slots have a NULL value.
+ */
+struct hg_hash_map_slot {
+    hg_atomic_int64_t value; /* Value       */
+    unsigned int hash;       /* Hash of key */
+};
+
+/**
+ * Table of slots. Tables that are replaced when the map grows may still be
+ * read by concurrent lookups and are only freed with the map.
+ */
+struct hg_hash_map_table {
+    struct hg_hash_map_table *prev; /* Previous table      */
+    unsigned int mask;              /* Number of slots - 1 */
+    HG_UTIL_ALIGNED(char slots[], HG_MEM_CACHE_LINE_SIZE);
+};
+
+/**
+ * Hash map. Lookups only read the table and the sequence number, which is
+ * odd while a removal moves entries within the table. Writers are serialized
+ * by the lock, which is kept on a separate cache line.
+ */
+struct hg_hash_map {
+    hg_atomic_int64_t table;             /* Current table    */
+    hg_atomic_int32_t seq;               /* Removal sequence */
+    hg_hash_map_hash_func_t hash_func;   /* Hash function    */
+    hg_hash_map_equal_func_t equal_func; /* Equal function   */
+    size_t key_size;                     /* Size of keys     */
+    size_t slot_size;                    /* Size of slots    */
+    HG_UTIL_ALIGNED(hg_thread_spin_t lock, HG_MEM_CACHE_LINE_SIZE);
+    hg_atomic_int32_t num_entries; /* Number of entries */
+};
+
+/********************/
+/* Local Prototypes */
+/********************/
+
+/**
+ * Hash key and mix bits so that low bits can be used as index.
+ */
+static HG_UTIL_INLINE unsigned int
+hg_hash_map_hash(struct hg_hash_map *hg_hash_map, const void *key);
+
+/**
+ * Allocate empty table.
+ */
+static struct hg_hash_map_table *
+hg_hash_map_table_alloc(
+    struct hg_hash_map *hg_hash_map, unsigned int num_slots);
+
+/**
+ * Find slot that contains key.
+ */
+static struct hg_hash_map_slot *
+hg_hash_map_table_find(struct hg_hash_map *hg_hash_map,
+    struct hg_hash_map_table *table, const void *key, unsigned int hash);
+
+/**
+ * Replace table with a table twice as large.
+ */
+static struct hg_hash_map_table *
+hg_hash_map_grow(
+    struct hg_hash_map *hg_hash_map, struct hg_hash_map_table *table);
+
+/*******************/
+/* Local Variables */
+/*******************/
+
+/*---------------------------------------------------------------------------*/
+static HG_UTIL_INLINE unsigned int
+hg_hash_map_hash(struct hg_hash_map *hg_hash_map, const void *key)
+{
+    unsigned int hash = hg_hash_map->hash_func(key);
+
+    /* Finalizer of MurmurHash3 */
+    hash ^= hash >> 16;
+    hash *= 0x85ebca6bU;
+    hash ^= hash >> 13;
+    hash *= 0xc2b2ae35U;
+    hash ^= hash >> 16;
+
+    return hash;
+}
+
+/*---------------------------------------------------------------------------*/
+static struct hg_hash_map_table *
+hg_hash_map_table_alloc(struct hg_hash_map *hg_hash_map, unsigned int num_slots)
+{
+    struct hg_hash_map_table *table;
+    size_t slots_size = (size_t) num_slots * hg_hash_map->slot_size;
+
+    table = (struct hg_hash_map_table *) hg_mem_aligned_alloc(
+        HG_MEM_CACHE_LINE_SIZE, sizeof(struct hg_hash_map_table) + slots_size);
+    HG_UTIL_CHECK_ERROR_NORET(table == NULL, done, "Could not allocate table");
+
+    table->prev = NULL;
+    table->mask = num_slots - 1;
+    memset(table->slots, 0, slots_size);
+
+done:
+    return table;
+}
+
+/*---------------------------------------------------------------------------*/
+static struct hg_hash_map_slot *
+hg_hash_map_table_find(struct hg_hash_map *hg_hash_map,
+    struct hg_hash_map_table *table, const void *key, unsigned int hash)
+{
+    unsigned int i, n;
+
+    for (i = hash & table->mask, n = 0; n <= table->mask;
+         i = (i + 1) & table->mask, n++) {
+        struct hg_hash_map_slot *slot = HG_HASH_MAP_SLOT(hg_hash_map, table, i);
+
+        /* End of cluster */
+        if (hg_atomic_get64(&slot->value) == 0)
+            break;
+        if (slot->hash == hash &&
+            hg_hash_map->equal_func(HG_HASH_MAP_SLOT_KEY(slot), key))
+            return slot;
+    }
+
+    return NULL;
+}
+
+/*---------------------------------------------------------------------------*/
+static struct hg_hash_map_table *
+hg_hash_map_grow(
+    struct hg_hash_map *hg_hash_map, struct hg_hash_map_table *table)
+{
+    struct hg_hash_map_table *new_table;
+    unsigned int i;
+
+    new_table = hg_hash_map_table_alloc(hg_hash_map, (table->mask + 1) * 2);
+    HG_UTIL_CHECK_ERROR_NORET(new_table == NULL, done, "Could not grow table");
+
+    for (i = 0; i <= table->mask; i++) {
+        struct hg_hash_map_slot *slot = HG_HASH_MAP_SLOT(hg_hash_map, table, i),
+                                *new_slot;
+        unsigned int j;
+
+        if (hg_atomic_get64(&slot->value) == 0)
+            continue;
+
+        for (j = slot->hash & new_table->mask;;
+             j = (j + 1) & new_table->mask) {
+            new_slot = HG_HASH_MAP_SLOT(hg_hash_map, new_table, j);
+            if (hg_atomic_get64(&new_slot->value) == 0)
+                break;
+        }
+        memcpy(new_slot, slot, hg_hash_map->slot_size);
+    }
+
+    /* Lookups that already loaded the previous table keep reading it */
+    new_table->prev = table;
+    hg_atomic_set64(&hg_hash_map->table, (int64_t) new_table);
+
+done:
+    return new_table;
+}
+
+/*---------------------------------------------------------------------------*/
+hg_hash_map_t *
+hg_hash_map_new(size_t key_size, hg_hash_map_hash_func_t hash_func,
+    hg_hash_map_equal_func_t equal_func)
+{
+    struct hg_hash_map *hg_hash_map;
+    struct hg_hash_map_table *table;
+
+    hg_hash_map = (struct hg_hash_map *) hg_mem_aligned_alloc(
+        HG_MEM_CACHE_LINE_SIZE, sizeof(struct hg_hash_map));
+    HG_UTIL_CHECK_ERROR_NORET(
+        hg_hash_map == NULL, error, "Could not allocate hash map");
+
+    hg_hash_map->hash_func = hash_func;
+    hg_hash_map->equal_func = equal_func;
+    hg_hash_map->key_size = key_size;
+    hg_hash_map->slot_size =
+        HG_HASH_MAP_KEY_OFFSET + HG_HASH_MAP_ALIGN(key_size);
+    hg_atomic_init32(&hg_hash_map->seq, 0);
+    hg_atomic_init32(&hg_hash_map->num_entries, 0);
+
+    table = hg_hash_map_table_alloc(hg_hash_map, HG_HASH_MAP_NUM_SLOTS_MIN);
+    HG_UTIL_CHECK_ERROR_NORET(table == NULL, error, "Could not allocate table");
+    hg_atomic_init64(&hg_hash_map->table, (int64_t) table);
+
+    hg_thread_spin_init(&hg_hash_map->lock);
+
+    return hg_hash_map;
+
+error:
+    hg_mem_aligned_free(hg_hash_map);
+
+    return NULL;
+}
+
+/*---------------------------------------------------------------------------*/
+void
+hg_hash_map_free(hg_hash_map_t *hg_hash_map)
+{
+    struct hg_hash_map_table *table;
+
+    if (hg_hash_map == NULL)
+        return;
+
+    table = (struct hg_hash_map_table *) hg_atomic_get64(&hg_hash_map->table);
+    while (table != NULL) {
+        struct hg_hash_map_table *prev = table->prev;
+
+        hg_mem_aligned_free(table);
+        table = prev;
+    }
+
+    hg_thread_spin_destroy(&hg_hash_map->lock);
+    hg_mem_aligned_free(hg_hash_map);
+}
+
+/*---------------------------------------------------------------------------*/
+void *
+hg_hash_map_lookup(hg_hash_map_t *hg_hash_map, const void *key)
+{
+    unsigned int hash = hg_hash_map_hash(hg_hash_map, key);
+    void *value;
+    int32_t seq;
+
+    do {
+        struct hg_hash_map_table *table;
+        struct hg_hash_map_slot *slot;
+
+        /* Wait for removal to complete */
+        while ((seq = hg_atomic_get32(&hg_hash_map->seq)) & 1)
+            hg_thread_yield();
+
+        table =
+            (struct hg_hash_map_table *) hg_atomic_get64(&hg_hash_map->table);
+        slot = hg_hash_map_table_find(hg_hash_map, table, key, hash);
+        value = (slot != NULL) ? (void *) hg_atomic_get64(&slot->value) : NULL;
+
+        /* Retry if entries were moved while reading */
+        hg_atomic_fence();
+    } while (hg_atomic_get32(&hg_hash_map->seq) != seq);
+
+    return value;
+}
+
+/*---------------------------------------------------------------------------*/
+int
+hg_hash_map_insert(hg_hash_map_t *hg_hash_map, const void *key, void *value)
+{
+    unsigned int hash = hg_hash_map_hash(hg_hash_map, key);
+    struct hg_hash_map_table *table;
+    struct hg_hash_map_slot *slot;
+    unsigned int i;
+    int ret = HG_UTIL_SUCCESS;
+
+    HG_UTIL_CHECK_ERROR(value == NULL, done, ret, HG_UTIL_FAIL,
+        "NULL value cannot be inserted");
+
+    hg_thread_spin_lock(&hg_hash_map->lock);
+
+    table = (struct hg_hash_map_table *) hg_atomic_get64(&hg_hash_map->table);
+    if (HG_HASH_MAP_FULL(
+            table, hg_atomic_get32(&hg_hash_map->num_entries) + 1)) {
+        table = hg_hash_map_grow(hg_hash_map, table);
+        HG_UTIL_CHECK_ERROR(table == NULL, unlock, ret, HG_UTIL_FAIL,
+            "Could not grow hash map");
+    }
+
+    for (i = hash & table->mask;; i = (i + 1) & table->mask) {
+        slot = HG_HASH_MAP_SLOT(hg_hash_map, table, i);
+        if (hg_atomic_get64(&slot->value) == 0)
+            break;
+        if (slot->hash == hash &&
+            hg_hash_map->equal_func(HG_HASH_MAP_SLOT_KEY(slot), key))
+            HG_UTIL_GOTO_DONE(unlock, ret, HG_UTIL_FAIL);
+    }
+
+    /* Entry becomes visible to lookups once its value is set */
+    slot->hash = hash;
+    memcpy(HG_HASH_MAP_SLOT_KEY(slot), key, hg_hash_map->key_size);
+    hg_atomic_set64(&slot->value, (int64_t) value);
+    hg_atomic_incr32(&hg_hash_map->num_entries);
+
+unlock:
+    hg_thread_spin_unlock(&hg_hash_map->lock);
+
+done:
+    return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+void *
+hg_hash_map_remove(hg_hash_map_t *hg_hash_map, const void *key)
+{
+    unsigned int hash = hg_hash_map_hash(hg_hash_map, key);
+    struct hg_hash_map_table *table;
+    struct hg_hash_map_slot *slot;
+    void *value = NULL;
+    unsigned int i, j;
+
+    hg_thread_spin_lock(&hg_hash_map->lock);
+
+    table = (struct hg_hash_map_table *) hg_atomic_get64(&hg_hash_map->table);
+    slot = hg_hash_map_table_find(hg_hash_map, table, key, hash);
+    if (slot == NULL)
+        goto unlock;
+    value = (void *) hg_atomic_get64(&slot->value);
+    i = (unsigned int) (((char *) slot - table->slots) /
+                        hg_hash_map->slot_size);
+
+    hg_atomic_incr32(&hg_hash_map->seq);
+
+    /* Fill the hole by moving back entries of the cluster that can be found
+     * from it, so that lookups can stop at the first empty slot */
+    for (j = (i + 1) & table->mask;; j = (j + 1) & table->mask) {
+        struct hg_hash_map_slot *next = HG_HASH_MAP_SLOT(hg_hash_map, table, j);
+        unsigned int home;
+
+        if (hg_atomic_get64(&next->value) == 0)
+            break;
+
+        home = next->hash & table->mask;
+        if (((j - home) & table->mask) >= ((j - i) & table->mask)) {
+            slot->hash = next->hash;
+            memcpy(HG_HASH_MAP_SLOT_KEY(slot), HG_HASH_MAP_SLOT_KEY(next),
+                hg_hash_map->key_size);
+            hg_atomic_set64(&slot->value, hg_atomic_get64(&next->value));
+            slot = next;
+            i = j;
+        }
+    }
+    hg_atomic_set64(&slot->value, 0);
+    hg_atomic_decr32(&hg_hash_map->num_entries);
+
+    hg_atomic_incr32(&hg_hash_map->seq);
+
+unlock:
+    hg_thread_spin_unlock(&hg_hash_map->lock);
+
+    return value;
+}
+
+/*---------------------------------------------------------------------------*/
+unsigned int
+hg_hash_map_num_entries(hg_hash_map_t *hg_hash_map)
+{
+    return (unsigned int) hg_atomic_get32(&hg_hash_map->num_entries);
+}
+
+/*---------------------------------------------------------------------------*/
+void
+hg_hash_map_iterate(
+    hg_hash_map_t *hg_hash_map, hg_hash_map_iterate_func_t func, void *arg)
+{
+    struct hg_hash_map_table *table =
+        (struct hg_hash_map_table *) hg_atomic_get64(&hg_hash_map->table);
+    unsigned int start, i, n;
+
+    /* Start after an empty slot, entries moved back by removals are then
+     * never moved to slots that were already visited */
+    for (start = 0; start <= table->mask; start++)
+        if (hg_atomic_get64(
+                &HG_HASH_MAP_SLOT(hg_hash_map, table, start)->value) == 0)
+            break;
+
+    for (i = (start + 1) & table->mask, n = 0; n <= table->mask;) {
+        struct hg_hash_map_slot *slot = HG_HASH_MAP_SLOT(hg_hash_map, table, i);
+        void *value = (void *) hg_atomic_get64(&slot->value);
+
+        if (value != NULL) {
+            int32_t seq = hg_atomic_get32(&hg_hash_map->seq);
+
+            func(HG_HASH_MAP_SLOT_KEY(slot), value, arg);
+
+            /* Entry was removed, another one may have been moved in place */
+            if (hg_atomic_get32(&hg_hash_map->seq) != seq)
+                continue;
+        }
+        i = (i + 1) & table->mask;
+        n++;
+    }
+}
@@ -0,0 +1,146 @@
+/**
+ * Copyright (c) 2013-2021 UChicago Argonne, LLC and The HDF Group.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef MERCURY_HASH_MAP_H
+#define MERCURY_HASH_MAP_H
+
+#include "mercury_util_config.h"
+
+#include <stddef.h>
+
+/*************************************/
+/* Public Type and Struct Definition */
+/*************************************/
+
+typedef struct hg_hash_map hg_hash_map_t;
+
+/**
+ * Hash function used to generate hash values for keys.
+ *
+ * \param key [IN]              pointer to key
+ *
+ * \return Hash value
+ */
+typedef unsigned int (*hg_hash_map_hash_func_t)(const void *key);
+
+/**
+ * Function used to compare two keys for equality.
+ *
+ * \param key1 [IN]             pointer to first key
+ * \param key2 [IN]             pointer to second key
+ *
+ * \return Non-zero if the two keys are equal, zero if they are not
+ */
+typedef int (*hg_hash_map_equal_func_t)(const void *key1, const void *key2);
+
+/**
+ * Function called on each entry when iterating over the map.
+ *
+ * \param key [IN]              pointer to key
+ * \param value [IN/OUT]        value
+ * \param arg [IN/OUT]          optional arguments
+ */
+typedef void (*hg_hash_map_iterate_func_t)(
+    const void *key, void *value, void *arg);
+
+/*****************/
+/* Public Macros */
+/*****************/
+
+/*********************/
+/* Public Prototypes */
+/*********************/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Create a new hash map. Keys are fixed-size and copied into the map's slots,
+ * which use open addressing with linear probing. Lookups do not take any lock
+ * and can run concurrently with inserts and removals, which are serialized.
+ *
+ * \param key_size [IN]         size of keys
+ * \param hash_func [IN]        pointer to hash function
+ * \param equal_func [IN]       pointer to equal function
+ *
+ * \return Pointer to hash map or NULL on failure
+ */
+HG_UTIL_PUBLIC hg_hash_map_t *
+hg_hash_map_new(size_t key_size, hg_hash_map_hash_func_t hash_func,
+    hg_hash_map_equal_func_t equal_func);
+
+/**
+ * Free hash map. Values are not freed. No other thread may access the map
+ * concurrently.
+ *
+ * \param hg_hash_map [IN/OUT]  pointer to hash map
+ */
+HG_UTIL_PUBLIC void
+hg_hash_map_free(hg_hash_map_t *hg_hash_map);
+
+/**
+ * Look up a value in the hash map.
+ *
+ * \param hg_hash_map [IN]      pointer to hash map
+ * \param key [IN]              pointer to key
+ *
+ * \return Value associated to key or NULL if not found
+ */
+HG_UTIL_PUBLIC void *
+hg_hash_map_lookup(hg_hash_map_t *hg_hash_map, const void *key);
+
+/**
+ * Insert a value into the hash map.
+ *
+ * \param hg_hash_map [IN/OUT]  pointer to hash map
+ * \param key [IN]              pointer to key
+ * \param value [IN]            value (must not be NULL)
+ *
+ * \return HG_UTIL_SUCCESS if successful or HG_UTIL_FAIL if key already exists
+ * or if the map could not be grown
+ */
+HG_UTIL_PUBLIC int
+hg_hash_map_insert(hg_hash_map_t *hg_hash_map, const void *key, void *value);
+
+/**
+ * Remove a value from the hash map.
+ *
+ * \param hg_hash_map [IN/OUT]  pointer to hash map
+ * \param key [IN]              pointer to key
+ *
+ * \return Value that was removed or NULL if not found
+ */
+HG_UTIL_PUBLIC void *
+hg_hash_map_remove(hg_hash_map_t *hg_hash_map, const void *key);
+
+/**
+ * Retrieve the number of entries in the hash map.
+ *
+ * \param hg_hash_map [IN]      pointer to hash map
+ *
+ * \return Number of entries
+ */
+HG_UTIL_PUBLIC unsigned int
+hg_hash_map_num_entries(hg_hash_map_t *hg_hash_map);
+
+/**
+ * Call \func on each entry of the hash map. \func may remove the entry that
+ * it is called on but no other insert or removal may take place concurrently.
+ *
+ * \param hg_hash_map [IN/OUT]  pointer to hash map
+ * \param func [IN]             pointer to function
+ * \param arg [IN/OUT]          optional arguments passed to function
+ */
+HG_UTIL_PUBLIC void
+hg_hash_map_iterate(
+    hg_hash_map_t *hg_hash_map, hg_hash_map_iterate_func_t func, void *arg);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MERCURY_HASH_MAP_H */
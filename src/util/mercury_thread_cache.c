@@ -0,0 +1,340 @@
+/**
+ * Copyright (c) 2013-2021 UChicago Argonne, LLC and The HDF Group.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "mercury_thread_cache.h"
+
+#include "mercury_thread.h"
+#include "mercury_thread_spin.h"
+#include "mercury_util_error.h"
+
+#include <stdlib.h>
+
+/****************/
+/* Local Macros */
+/****************/
+
+/************************************/
+/* Local Type and Struct Definition */
+/************************************/
+
+/**
+ * Magazine of objects.
+ */
+struct hg_thread_cache_mag {
+    struct hg_thread_cache_mag *next; /* Next magazine in depot */
+    unsigned int count;               /* Number of objects      */
+    void *objs[];                     /* Objects                */
+};
+
+/**
+ * Thread magazines.
+ */
+struct hg_thread_cache_local {
+    struct hg_thread_cache_mag *loaded;   /* Magazine in use           */
+    struct hg_thread_cache_mag *previous; /* Magazine swapped with it  */
+    struct hg_thread_cache_local *next;   /* Next thread's magazines   */
+};
+
+/**
+ * Cache. The depot keeps full and empty magazines.
+ */
+struct hg_thread_cache {
+    hg_thread_key_t key;                     /* Key to thread magazines */
+    hg_thread_spin_t lock;                   /* Depot lock              */
+    struct hg_thread_cache_mag *full;        /* Full magazines          */
+    struct hg_thread_cache_mag *empty;       /* Empty magazines         */
+    struct hg_thread_cache_local *locals;    /* All thread magazines    */
+    hg_thread_cache_alloc_func_t alloc_func; /* Alloc function          */
+    hg_thread_cache_free_func_t free_func;   /* Free function           */
+    void *arg;                               /* Function arguments      */
+    unsigned int mag_size;                   /* Objects per magazine    */
+};
+
+/********************/
+/* Local Prototypes */
+/********************/
+
+/**
+ * Allocate empty magazine.
+ */
+static struct hg_thread_cache_mag *
+hg_thread_cache_mag_alloc(struct hg_thread_cache *hg_thread_cache);
+
+/**
+ * Free magazine and the objects that it contains.
+ */
+static void
+hg_thread_cache_mag_free(struct hg_thread_cache *hg_thread_cache,
+    struct hg_thread_cache_mag *hg_thread_cache_mag);
+
+/**
+ * Get magazines of calling thread, create them on first use.
+ */
+static struct hg_thread_cache_local *
+hg_thread_cache_get_local(struct hg_thread_cache *hg_thread_cache);
+
+/*******************/
+/* Local Variables */
+/*******************/
+
+/*---------------------------------------------------------------------------*/
+static struct hg_thread_cache_mag *
+hg_thread_cache_mag_alloc(struct hg_thread_cache *hg_thread_cache)
+{
+    struct hg_thread_cache_mag *hg_thread_cache_mag;
+
+    hg_thread_cache_mag = (struct hg_thread_cache_mag *) malloc(
+        sizeof(struct hg_thread_cache_mag) +
+        hg_thread_cache->mag_size * sizeof(void *));
+    HG_UTIL_CHECK_ERROR_NORET(
+        hg_thread_cache_mag == NULL, done, "Could not allocate magazine");
+
+    hg_thread_cache_mag->next = NULL;
+    hg_thread_cache_mag->count = 0;
+
+done:
+    return hg_thread_cache_mag;
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+hg_thread_cache_mag_free(struct hg_thread_cache *hg_thread_cache,
+    struct hg_thread_cache_mag *hg_thread_cache_mag)
+{
+    unsigned int i;
+
+    if (hg_thread_cache_mag == NULL)
+        return;
+
+    for (i = 0; i < hg_thread_cache_mag->count; i++)
+        hg_thread_cache->free_func(
+            hg_thread_cache_mag->objs[i], hg_thread_cache->arg);
+    free(hg_thread_cache_mag);
+}
+
+/*---------------------------------------------------------------------------*/
+static struct hg_thread_cache_local *
+hg_thread_cache_get_local(struct hg_thread_cache *hg_thread_cache)
+{
+    struct hg_thread_cache_local *hg_thread_cache_local;
+
+    hg_thread_cache_local = (struct hg_thread_cache_local *)
+        hg_thread_getspecific(hg_thread_cache->key);
+    if (hg_thread_cache_local)
+        return hg_thread_cache_local;
+
+    hg_thread_cache_local = (struct hg_thread_cache_local *) calloc(
+        1, sizeof(struct hg_thread_cache_local));
+    HG_UTIL_CHECK_ERROR_NORET(hg_thread_cache_local == NULL, error,
+        "Could not allocate thread magazines");
+
+    hg_thread_cache_local->loaded = hg_thread_cache_mag_alloc(hg_thread_cache);
+    HG_UTIL_CHECK_ERROR_NORET(
+        hg_thread_cache_local->loaded == NULL, error, "Could not get magazine");
+    hg_thread_cache_local->previous =
+        hg_thread_cache_mag_alloc(hg_thread_cache);
+    HG_UTIL_CHECK_ERROR_NORET(hg_thread_cache_local->previous == NULL, error,
+        "Could not get magazine");
+
+    HG_UTIL_CHECK_ERROR_NORET(
+        hg_thread_setspecific(hg_thread_cache->key, hg_thread_cache_local) !=
+            HG_UTIL_SUCCESS,
+        error, "Could not set thread specific value");
+
+    /* Keep track of it so that it can be released on destroy */
+    hg_thread_spin_lock(&hg_thread_cache->lock);
+    hg_thread_cache_local->next = hg_thread_cache->locals;
+    hg_thread_cache->locals = hg_thread_cache_local;
+    hg_thread_spin_unlock(&hg_thread_cache->lock);
+
+    return hg_thread_cache_local;
+
+error:
+    if (hg_thread_cache_local) {
+        free(hg_thread_cache_local->loaded);
+        free(hg_thread_cache_local->previous);
+        free(hg_thread_cache_local);
+    }
+    return NULL;
+}
+
+/*---------------------------------------------------------------------------*/
+struct hg_thread_cache *
+hg_thread_cache_create(unsigned int mag_size,
+    hg_thread_cache_alloc_func_t alloc_func,
+    hg_thread_cache_free_func_t free_func, void *arg)
+{
+    struct hg_thread_cache *hg_thread_cache = NULL;
+
+    HG_UTIL_CHECK_ERROR_NORET(
+        mag_size == 0, error, "Magazine size must be at least 1");
+    HG_UTIL_CHECK_ERROR_NORET(alloc_func == NULL || free_func == NULL, error,
+        "NULL alloc or free function");
+
+    hg_thread_cache =
+        (struct hg_thread_cache *) calloc(1, sizeof(struct hg_thread_cache));
+    HG_UTIL_CHECK_ERROR_NORET(
+        hg_thread_cache == NULL, error, "Could not allocate thread cache");
+
+    HG_UTIL_CHECK_ERROR_NORET(
+        hg_thread_key_create(&hg_thread_cache->key) != HG_UTIL_SUCCESS, error,
+        "Could not create thread key");
+    hg_thread_spin_init(&hg_thread_cache->lock);
+    hg_thread_cache->alloc_func = alloc_func;
+    hg_thread_cache->free_func = free_func;
+    hg_thread_cache->arg = arg;
+    hg_thread_cache->mag_size = mag_size;
+
+    return hg_thread_cache;
+
+error:
+    free(hg_thread_cache);
+
+    return NULL;
+}
+
+/*---------------------------------------------------------------------------*/
+void
+hg_thread_cache_destroy(struct hg_thread_cache *hg_thread_cache)
+{
+    struct hg_thread_cache_local *hg_thread_cache_local;
+    struct hg_thread_cache_mag *hg_thread_cache_mag;
+
+    if (hg_thread_cache == NULL)
+        return;
+
+    hg_thread_cache_local = hg_thread_cache->locals;
+    while (hg_thread_cache_local) {
+        struct hg_thread_cache_local *next = hg_thread_cache_local->next;
+
+        hg_thread_cache_mag_free(
+            hg_thread_cache, hg_thread_cache_local->loaded);
+        hg_thread_cache_mag_free(
+            hg_thread_cache, hg_thread_cache_local->previous);
+        free(hg_thread_cache_local);
+        hg_thread_cache_local = next;
+    }
+
+    hg_thread_cache_mag = hg_thread_cache->full;
+    while (hg_thread_cache_mag) {
+        struct hg_thread_cache_mag *next = hg_thread_cache_mag->next;
+
+        hg_thread_cache_mag_free(hg_thread_cache, hg_thread_cache_mag);
+        hg_thread_cache_mag = next;
+    }
+
+    hg_thread_cache_mag = hg_thread_cache->empty;
+    while (hg_thread_cache_mag) {
+        struct hg_thread_cache_mag *next = hg_thread_cache_mag->next;
+
+        free(hg_thread_cache_mag);
+        hg_thread_cache_mag = next;
+    }
+
+    hg_thread_key_delete(hg_thread_cache->key);
+    hg_thread_spin_destroy(&hg_thread_cache->lock);
+    free(hg_thread_cache);
+}
+
+/*---------------------------------------------------------------------------*/
+void *
+hg_thread_cache_get(struct hg_thread_cache *hg_thread_cache)
+{
+    struct hg_thread_cache_local *hg_thread_cache_local =
+        hg_thread_cache_get_local(hg_thread_cache);
+    struct hg_thread_cache_mag *hg_thread_cache_mag;
+
+    if (hg_thread_cache_local == NULL)
+        return hg_thread_cache->alloc_func(hg_thread_cache->arg);
+
+    hg_thread_cache_mag = hg_thread_cache_local->loaded;
+    if (hg_thread_cache_mag->count > 0)
+        return hg_thread_cache_mag->objs[--hg_thread_cache_mag->count];
+
+    /* Loaded magazine is empty, use previous one if it is not */
+    if (hg_thread_cache_local->previous->count > 0) {
+        hg_thread_cache_local->loaded = hg_thread_cache_local->previous;
+        hg_thread_cache_local->previous = hg_thread_cache_mag;
+        hg_thread_cache_mag = hg_thread_cache_local->loaded;
+        return hg_thread_cache_mag->objs[--hg_thread_cache_mag->count];
+    }
+
+    /* Both are empty, exchange previous one for a full one from the depot */
+    hg_thread_spin_lock(&hg_thread_cache->lock);
+    hg_thread_cache_mag = hg_thread_cache->full;
+    if (hg_thread_cache_mag) {
+        hg_thread_cache->full = hg_thread_cache_mag->next;
+        hg_thread_cache_local->previous->next = hg_thread_cache->empty;
+        hg_thread_cache->empty = hg_thread_cache_local->previous;
+        hg_thread_cache_local->previous = hg_thread_cache_local->loaded;
+        hg_thread_cache_local->loaded = hg_thread_cache_mag;
+    }
+    hg_thread_spin_unlock(&hg_thread_cache->lock);
+
+    if (hg_thread_cache_mag)
+        return hg_thread_cache_mag->objs[--hg_thread_cache_mag->count];
+
+    /* Depot is empty */
+    return hg_thread_cache->alloc_func(hg_thread_cache->arg);
+}
+
+/*---------------------------------------------------------------------------*/
+int
+hg_thread_cache_put(struct hg_thread_cache *hg_thread_cache, void *obj)
+{
+    struct hg_thread_cache_local *hg_thread_cache_local =
+        hg_thread_cache_get_local(hg_thread_cache);
+    struct hg_thread_cache_mag *hg_thread_cache_mag;
+    int ret = HG_UTIL_SUCCESS;
+
+    HG_UTIL_CHECK_ERROR(hg_thread_cache_local == NULL, error, ret,
+        HG_UTIL_FAIL, "Could not get thread magazines");
+
+    hg_thread_cache_mag = hg_thread_cache_local->loaded;
+    if (hg_thread_cache_mag->count < hg_thread_cache->mag_size) {
+        hg_thread_cache_mag->objs[hg_thread_cache_mag->count++] = obj;
+        return ret;
+    }
+
+    /* Loaded magazine is full, use previous one if it is empty */
+    if (hg_thread_cache_local->previous->count == 0) {
+        hg_thread_cache_local->loaded = hg_thread_cache_local->previous;
+        hg_thread_cache_local->previous = hg_thread_cache_mag;
+        hg_thread_cache_mag = hg_thread_cache_local->loaded;
+        hg_thread_cache_mag->objs[hg_thread_cache_mag->count++] = obj;
+        return ret;
+    }
+
+    /* Both are full, exchange previous one for an empty one from the depot */
+    hg_thread_spin_lock(&hg_thread_cache->lock);
+    hg_thread_cache_mag = hg_thread_cache->empty;
+    if (hg_thread_cache_mag)
+        hg_thread_cache->empty = hg_thread_cache_mag->next;
+    hg_thread_spin_unlock(&hg_thread_cache->lock);
+
+    if (hg_thread_cache_mag == NULL) {
+        hg_thread_cache_mag = hg_thread_cache_mag_alloc(hg_thread_cache);
+        HG_UTIL_CHECK_ERROR(hg_thread_cache_mag == NULL, error, ret,
+            HG_UTIL_FAIL, "Could not allocate magazine");
+    }
+
+    hg_thread_spin_lock(&hg_thread_cache->lock);
+    hg_thread_cache_local->previous->next = hg_thread_cache->full;
+    hg_thread_cache->full = hg_thread_cache_local->previous;
+    hg_thread_spin_unlock(&hg_thread_cache->lock);
+
+    hg_thread_cache_local->previous = hg_thread_cache_local->loaded;
+    hg_thread_cache_local->loaded = hg_thread_cache_mag;
+    hg_thread_cache_mag->objs[hg_thread_cache_mag->count++] = obj;
+
+    return ret;
+
+error:
+    /* Object cannot be cached */
+    hg_thread_cache->free_func(obj, hg_thread_cache->arg);
+
+    return ret;
+}
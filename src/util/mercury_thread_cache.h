@@ -0,0 +1,104 @@
+/**
+ * Copyright (c) 2013-2021 UChicago Argonne, LLC and The HDF Group.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef MERCURY_THREAD_CACHE_H
+#define MERCURY_THREAD_CACHE_H
+
+#include "mercury_util_config.h"
+
+/*************************************/
+/* Public Type and Struct Definition */
+/*************************************/
+
+/**
+ * Allocate a new object, called when the cache is empty.
+ *
+ * \param arg [IN/OUT]          optional arguments
+ *
+ * \return Pointer to object or NULL on failure
+ */
+typedef void *(*hg_thread_cache_alloc_func_t)(void *arg);
+
+/**
+ * Free an object, called when the cache is destroyed.
+ *
+ * \param obj [IN/OUT]          pointer to object
+ * \param arg [IN/OUT]          optional arguments
+ */
+typedef void (*hg_thread_cache_free_func_t)(void *obj, void *arg);
+
+/*****************/
+/* Public Macros */
+/*****************/
+
+/*********************/
+/* Public Prototypes */
+/*********************/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Create a cache of free objects. Each thread keeps two magazines of up to
+ * \mag_size objects that it gets objects from and puts objects back to without
+ * any locking. Full and empty magazines are exchanged with a shared depot,
+ * which only requires locking once every \mag_size operations. Objects are
+ * allocated with \alloc_func when both the thread's magazines and the depot
+ * are empty.
+ *
+ * \remark Objects cached by threads that exit are only released when the
+ * cache is destroyed.
+ *
+ * \param mag_size [IN]         number of objects per magazine
+ * \param alloc_func [IN]       pointer to alloc function
+ * \param free_func [IN]        pointer to free function
+ * \param arg [IN/OUT]          optional arguments passed to functions
+ *
+ * \return Pointer to cache or NULL on failure
+ */
+HG_UTIL_PUBLIC struct hg_thread_cache *
+hg_thread_cache_create(unsigned int mag_size,
+    hg_thread_cache_alloc_func_t alloc_func,
+    hg_thread_cache_free_func_t free_func, void *arg);
+
+/**
+ * Destroy cache and free all the objects that it contains. No other thread
+ * may access the cache concurrently.
+ *
+ * \param hg_thread_cache [IN/OUT]      pointer to cache
+ */
+HG_UTIL_PUBLIC void
+hg_thread_cache_destroy(struct hg_thread_cache *hg_thread_cache);
+
+/**
+ * Get an object from the cache, allocate a new one if the cache is empty.
+ *
+ * \param hg_thread_cache [IN/OUT]      pointer to cache
+ *
+ * \return Pointer to object or NULL on failure
+ */
+HG_UTIL_PUBLIC void *
+hg_thread_cache_get(struct hg_thread_cache *hg_thread_cache);
+
+/**
+ * Put an object back into the cache. Objects can be put back by a different
+ * thread than the one that got them. If the object cannot be cached, it is
+ * freed.
+ *
+ * \param hg_thread_cache [IN/OUT]      pointer to cache
+ * \param obj [IN]                      pointer to object
+ *
+ * \return HG_UTIL_SUCCESS if successful / error code otherwise
+ */
+HG_UTIL_PUBLIC int
+hg_thread_cache_put(struct hg_thread_cache *hg_thread_cache, void *obj);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MERCURY_THREAD_CACHE_H */
@@ -6,6 +6,8 @@
 
 #include "mercury_thread_pool.h"
 
+#include "mercury_atomic.h"
+#include "mercury_atomic_queue.h"
 #include "mercury_util_error.h"
 
 #include <stdlib.h>
@@ -14,14 +16,37 @@
 /* Local Macros */
 /****************/
 
+/* Default number of entries of each worker queue */
+#define HG_THREAD_POOL_QUEUE_SIZE (1024)
+
+/* Default number of times an idle worker polls queues before sleeping */
+#define HG_THREAD_POOL_SPIN_COUNT (128)
+
 /************************************/
 /* Local Type and Struct Definition */
 /************************************/
 
-struct hg_thread_pool_private {
-    struct hg_thread_pool pool;
-    unsigned int thread_count;
-    hg_thread_t *threads;
+/* Worker */
+struct hg_thread_pool_worker {
+    struct hg_atomic_queue *queue; /* Work queue (others steal from it) */
+    struct hg_thread_pool *pool;   /* Pool that worker belongs to */
+    hg_thread_t thread;            /* Worker thread */
+    unsigned int index;            /* Index of worker */
+};
+
+/* Thread pool */
+struct hg_thread_pool {
+    struct hg_thread_pool_worker *workers;   /* Array of workers */
+    HG_QUEUE_HEAD(hg_thread_work) overflow;  /* Work that did not fit */
+    hg_thread_mutex_t mutex;                 /* Overflow and sleep mutex */
+    hg_thread_cond_t cond;                   /* Sleep condition */
+    hg_atomic_int32_t overflow_count;        /* Number of overflow entries */
+    hg_atomic_int32_t sleeping_worker_count; /* Number of sleeping workers */
+    hg_atomic_int32_t next_worker;           /* Round-robin post index */
+    hg_atomic_int32_t shutdown;              /* Shutting down */
+    unsigned int thread_count;               /* Number of workers */
+    unsigned int started_count;              /* Number of workers started */
+    unsigned int spin_count;                 /* Idle polls before sleeping */
 };
 
 /********************/
@@ -34,6 +59,31 @@ struct hg_thread_pool_private {
 static HG_THREAD_RETURN_TYPE
 hg_thread_pool_worker(void *args);
 
+/**
+ * Get work from own queue, then from other workers, then from overflow queue.
+ */
+static struct hg_thread_work *
+hg_thread_pool_get_work(struct hg_thread_pool *pool, unsigned int index);
+
+/**
+ * Check whether there is no work left.
+ */
+static bool
+hg_thread_pool_is_empty(struct hg_thread_pool *pool);
+
+/**
+ * Push work to worker queue or to overflow queue if full.
+ */
+static void
+hg_thread_pool_push(struct hg_thread_pool *pool, unsigned int index,
+    struct hg_thread_work *work);
+
+/**
+ * Wake up sleeping workers.
+ */
+static int
+hg_thread_pool_wake(struct hg_thread_pool *pool, unsigned int count);
+
 /*******************/
 /* Local Variables */
 /*******************/
@@ -43,40 +93,138 @@ static HG_THREAD_RETURN_TYPE
 hg_thread_pool_worker(void *args)
 {
     hg_thread_ret_t ret = 0;
-    hg_thread_pool_t *pool = (hg_thread_pool_t *) args;
-    struct hg_thread_work *work;
+    struct hg_thread_pool_worker *worker =
+        (struct hg_thread_pool_worker *) args;
+    struct hg_thread_pool *pool = worker->pool;
+    unsigned int spin = 0;
 
     while (1) {
-        hg_thread_mutex_lock(&pool->mutex);
+        struct hg_thread_work *work =
+            hg_thread_pool_get_work(pool, worker->index);
+
+        if (work) {
+            /* Get to work */
+            (*work->func)(work->args);
+            spin = 0;
+            continue;
+        }
+
+        /* Only exit once all the work has been processed */
+        if (hg_atomic_get32(&pool->shutdown))
+            break;
 
-        /* If not shutting down and nothing to do, worker sleeps */
-        while (!pool->shutdown && HG_QUEUE_IS_EMPTY(&pool->queue)) {
-            int rc;
+        if (spin < pool->spin_count) {
+            spin++;
+            cpu_spinwait();
+            continue;
+        }
 
-            pool->sleeping_worker_count++;
+        /* Nothing to do, worker sleeps */
+        hg_thread_mutex_lock(&pool->mutex);
+        hg_atomic_incr32(&pool->sleeping_worker_count);
 
-            rc = hg_thread_cond_wait(&pool->cond, &pool->mutex);
+        /* Work posted before the increment is visible must be seen here */
+        hg_atomic_fence();
+        while (!hg_atomic_get32(&pool->shutdown) &&
+               hg_thread_pool_is_empty(pool)) {
+            int rc = hg_thread_cond_wait(&pool->cond, &pool->mutex);
             HG_UTIL_CHECK_ERROR_NORET(rc != HG_UTIL_SUCCESS, unlock,
                 "Thread cannot wait on condition variable");
-
-            pool->sleeping_worker_count--;
         }
 
-        if (pool->shutdown && HG_QUEUE_IS_EMPTY(&pool->queue))
-            goto unlock;
+        hg_atomic_decr32(&pool->sleeping_worker_count);
+        hg_thread_mutex_unlock(&pool->mutex);
+        spin = 0;
+    }
 
-        /* Grab our task */
-        work = HG_QUEUE_FIRST(&pool->queue);
-        HG_QUEUE_POP_HEAD(&pool->queue, entry);
+    return ret;
 
-        /* Unlock */
-        hg_thread_mutex_unlock(&pool->mutex);
+unlock:
+    hg_atomic_decr32(&pool->sleeping_worker_count);
+    hg_thread_mutex_unlock(&pool->mutex);
+
+    return ret;
+}
 
-        /* Get to work */
-        (*work->func)(work->args);
+/*---------------------------------------------------------------------------*/
+static struct hg_thread_work *
+hg_thread_pool_get_work(struct hg_thread_pool *pool, unsigned int index)
+{
+    struct hg_thread_work *work;
+    unsigned int i;
+
+    /* Own queue first, then steal from other workers */
+    for (i = 0; i < pool->thread_count; i++) {
+        work = (struct hg_thread_work *) hg_atomic_queue_pop_mc(
+            pool->workers[(index + i) % pool->thread_count].queue);
+        if (work)
+            return work;
     }
 
-unlock:
+    if (hg_atomic_get32(&pool->overflow_count) == 0)
+        return NULL;
+
+    hg_thread_mutex_lock(&pool->mutex);
+    work = HG_QUEUE_FIRST(&pool->overflow);
+    if (work) {
+        HG_QUEUE_POP_HEAD(&pool->overflow, entry);
+        hg_atomic_decr32(&pool->overflow_count);
+    }
+    hg_thread_mutex_unlock(&pool->mutex);
+
+    return work;
+}
+
+/*---------------------------------------------------------------------------*/
+static bool
+hg_thread_pool_is_empty(struct hg_thread_pool *pool)
+{
+    unsigned int i;
+
+    if (hg_atomic_get32(&pool->overflow_count) > 0)
+        return false;
+
+    for (i = 0; i < pool->thread_count; i++)
+        if (!hg_atomic_queue_is_empty(pool->workers[i].queue))
+            return false;
+
+    return true;
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+hg_thread_pool_push(struct hg_thread_pool *pool, unsigned int index,
+    struct hg_thread_work *work)
+{
+    if (pool->thread_count > 0 &&
+        hg_atomic_queue_push(
+            pool->workers[index % pool->thread_count].queue, (void *) work) ==
+            HG_UTIL_SUCCESS)
+        return;
+
+    /* Queue is full, other workers will steal from it once they are done */
+    hg_thread_mutex_lock(&pool->mutex);
+    HG_QUEUE_PUSH_TAIL(&pool->overflow, work, entry);
+    hg_atomic_incr32(&pool->overflow_count);
+    hg_thread_mutex_unlock(&pool->mutex);
+}
+
+/*---------------------------------------------------------------------------*/
+static int
+hg_thread_pool_wake(struct hg_thread_pool *pool, unsigned int count)
+{
+    int ret = HG_UTIL_SUCCESS;
+
+    /* Pairs with the fence of sleeping workers */
+    hg_atomic_fence();
+    if (hg_atomic_get32(&pool->sleeping_worker_count) == 0)
+        return ret;
+
+    hg_thread_mutex_lock(&pool->mutex);
+    if (count > 1)
+        ret = hg_thread_cond_broadcast(&pool->cond);
+    else
+        ret = hg_thread_cond_signal(&pool->cond);
     hg_thread_mutex_unlock(&pool->mutex);
 
     return ret;
@@ -85,53 +233,87 @@ unlock:
 /*---------------------------------------------------------------------------*/
 int
 hg_thread_pool_init(unsigned int thread_count, hg_thread_pool_t **pool_ptr)
+{
+    return hg_thread_pool_init_opt(thread_count, NULL, pool_ptr);
+}
+
+/*---------------------------------------------------------------------------*/
+int
+hg_thread_pool_init_opt(unsigned int thread_count,
+    const struct hg_thread_pool_init_info *init_info,
+    hg_thread_pool_t **pool_ptr)
 {
     int ret = HG_UTIL_SUCCESS, rc;
-    struct hg_thread_pool_private *priv_pool = NULL;
+    struct hg_thread_pool *pool = NULL;
+    unsigned int queue_size = HG_THREAD_POOL_QUEUE_SIZE;
     unsigned int i;
 
     HG_UTIL_CHECK_ERROR(
         pool_ptr == NULL, error, ret, HG_UTIL_FAIL, "NULL pointer");
 
-    priv_pool = (struct hg_thread_pool_private *) malloc(
-        sizeof(struct hg_thread_pool_private));
-    HG_UTIL_CHECK_ERROR(priv_pool == NULL, error, ret, HG_UTIL_FAIL,
+    pool = (struct hg_thread_pool *) calloc(1, sizeof(struct hg_thread_pool));
+    HG_UTIL_CHECK_ERROR(pool == NULL, error, ret, HG_UTIL_FAIL,
         "Could not allocate thread pool");
 
-    priv_pool->pool.sleeping_worker_count = 0;
-    priv_pool->thread_count = thread_count;
-    priv_pool->threads = NULL;
-    HG_QUEUE_INIT(&priv_pool->pool.queue);
-    priv_pool->pool.shutdown = 0;
+    HG_QUEUE_INIT(&pool->overflow);
+    hg_atomic_init32(&pool->overflow_count, 0);
+    hg_atomic_init32(&pool->sleeping_worker_count, 0);
+    hg_atomic_init32(&pool->next_worker, 0);
+    hg_atomic_init32(&pool->shutdown, 0);
+    pool->thread_count = thread_count;
+    pool->spin_count = HG_THREAD_POOL_SPIN_COUNT;
+    if (init_info) {
+        if (init_info->queue_size > 0)
+            queue_size = init_info->queue_size;
+        if (init_info->spin_count > 0)
+            pool->spin_count = init_info->spin_count;
+    }
 
-    rc = hg_thread_mutex_init(&priv_pool->pool.mutex);
+    rc = hg_thread_mutex_init(&pool->mutex);
     HG_UTIL_CHECK_ERROR(rc != HG_UTIL_SUCCESS, error, ret, HG_UTIL_FAIL,
         "Could not initialize mutex");
 
-    rc = hg_thread_cond_init(&priv_pool->pool.cond);
+    rc = hg_thread_cond_init(&pool->cond);
     HG_UTIL_CHECK_ERROR(rc != HG_UTIL_SUCCESS, error, ret, HG_UTIL_FAIL,
         "Could not initialize thread condition");
 
-    priv_pool->threads =
-        (hg_thread_t *) malloc(thread_count * sizeof(hg_thread_t));
-    HG_UTIL_CHECK_ERROR(!priv_pool->threads, error, ret, HG_UTIL_FAIL,
-        "Could not allocate thread pool array");
+    pool->workers = (struct hg_thread_pool_worker *) calloc(
+        thread_count, sizeof(struct hg_thread_pool_worker));
+    HG_UTIL_CHECK_ERROR(thread_count > 0 && pool->workers == NULL, error, ret,
+        HG_UTIL_FAIL, "Could not allocate thread pool array");
+
+    /* Queues must all exist before any worker starts stealing */
+    for (i = 0; i < thread_count; i++) {
+        pool->workers[i].queue = hg_atomic_queue_alloc(queue_size);
+        HG_UTIL_CHECK_ERROR(pool->workers[i].queue == NULL, error, ret,
+            HG_UTIL_FAIL, "Could not allocate worker queue");
+        pool->workers[i].pool = pool;
+        pool->workers[i].index = i;
+    }
 
     /* Start worker threads */
     for (i = 0; i < thread_count; i++) {
-        rc = hg_thread_create(
-            &priv_pool->threads[i], hg_thread_pool_worker, (void *) priv_pool);
+        rc = hg_thread_create(&pool->workers[i].thread, hg_thread_pool_worker,
+            (void *) &pool->workers[i]);
         HG_UTIL_CHECK_ERROR(rc != HG_UTIL_SUCCESS, error, ret, HG_UTIL_FAIL,
             "Could not create thread");
+        pool->started_count++;
+
+        if (init_info && init_info->cpu_masks) {
+            rc = hg_thread_setaffinity(
+                pool->workers[i].thread, &init_info->cpu_masks[i]);
+            HG_UTIL_CHECK_ERROR(rc != HG_UTIL_SUCCESS, error, ret,
+                HG_UTIL_FAIL, "Could not set thread affinity");
+        }
     }
 
-    *pool_ptr = (struct hg_thread_pool *) priv_pool;
+    *pool_ptr = pool;
 
     return ret;
 
 error:
-    if (priv_pool)
-        hg_thread_pool_destroy((struct hg_thread_pool *) priv_pool);
+    if (pool)
+        hg_thread_pool_destroy(pool);
 
     return ret;
 }
@@ -140,48 +322,96 @@ error:
 int
 hg_thread_pool_destroy(hg_thread_pool_t *pool)
 {
-    struct hg_thread_pool_private *priv_pool =
-        (struct hg_thread_pool_private *) pool;
     int ret = HG_UTIL_SUCCESS, rc;
     unsigned int i;
 
-    if (!priv_pool)
+    if (!pool)
         goto done;
 
-    if (priv_pool->threads) {
-        hg_thread_mutex_lock(&priv_pool->pool.mutex);
+    if (pool->started_count > 0) {
+        hg_thread_mutex_lock(&pool->mutex);
 
-        priv_pool->pool.shutdown = 1;
+        hg_atomic_set32(&pool->shutdown, 1);
 
-        rc = hg_thread_cond_broadcast(&priv_pool->pool.cond);
+        rc = hg_thread_cond_broadcast(&pool->cond);
         HG_UTIL_CHECK_ERROR(rc != HG_UTIL_SUCCESS, error, ret, HG_UTIL_FAIL,
             "Could not broadcast condition signal");
 
-        hg_thread_mutex_unlock(&priv_pool->pool.mutex);
+        hg_thread_mutex_unlock(&pool->mutex);
 
-        for (i = 0; i < priv_pool->thread_count; i++) {
-            rc = hg_thread_join(priv_pool->threads[i]);
+        for (i = 0; i < pool->started_count; i++) {
+            rc = hg_thread_join(pool->workers[i].thread);
             HG_UTIL_CHECK_ERROR(rc != HG_UTIL_SUCCESS, done, ret, HG_UTIL_FAIL,
                 "Could not join thread");
         }
     }
 
-    rc = hg_thread_mutex_destroy(&priv_pool->pool.mutex);
+    rc = hg_thread_mutex_destroy(&pool->mutex);
     HG_UTIL_CHECK_ERROR(rc != HG_UTIL_SUCCESS, done, ret, HG_UTIL_FAIL,
         "Could not destroy mutex");
 
-    rc = hg_thread_cond_destroy(&priv_pool->pool.cond);
+    rc = hg_thread_cond_destroy(&pool->cond);
     HG_UTIL_CHECK_ERROR(rc != HG_UTIL_SUCCESS, done, ret, HG_UTIL_FAIL,
         "Could not destroy thread condition");
 
-    free(priv_pool->threads);
-    free(priv_pool);
+    if (pool->workers) {
+        for (i = 0; i < pool->thread_count; i++)
+            hg_atomic_queue_free(pool->workers[i].queue);
+        free(pool->workers);
+    }
+    free(pool);
 
 done:
     return ret;
 
 error:
-    hg_thread_mutex_unlock(&priv_pool->pool.mutex);
+    hg_thread_mutex_unlock(&pool->mutex);
 
     return ret;
 }
+
+/*---------------------------------------------------------------------------*/
+int
+hg_thread_pool_post(hg_thread_pool_t *pool, struct hg_thread_work *work)
+{
+    if (!pool || !work)
+        return HG_UTIL_FAIL;
+
+    if (!work->func)
+        return HG_UTIL_FAIL;
+
+    /* Are we shutting down ? */
+    if (hg_atomic_get32(&pool->shutdown))
+        return HG_UTIL_FAIL;
+
+    hg_thread_pool_push(pool,
+        (unsigned int) hg_atomic_incr32(&pool->next_worker), work);
+
+    return hg_thread_pool_wake(pool, 1);
+}
+
+/*---------------------------------------------------------------------------*/
+int
+hg_thread_pool_post_n(
+    hg_thread_pool_t *pool, struct hg_thread_work *works[], unsigned int count)
+{
+    unsigned int i, index;
+
+    if (!pool || !works)
+        return HG_UTIL_FAIL;
+
+    for (i = 0; i < count; i++)
+        if (!works[i] || !works[i]->func)
+            return HG_UTIL_FAIL;
+
+    /* Are we shutting down ? */
+    if (hg_atomic_get32(&pool->shutdown))
+        return HG_UTIL_FAIL;
+
+    /* Spread batch over workers */
+    index = (unsigned int) hg_atomic_incr32(&pool->next_worker);
+    for (i = 0; i < count; i++)
+        hg_thread_pool_push(pool, index + i, works[i]);
+
+    return hg_thread_pool_wake(pool, count);
+}
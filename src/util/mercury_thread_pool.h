@@ -17,20 +17,28 @@
 
 typedef struct hg_thread_pool hg_thread_pool_t;
 
-struct hg_thread_pool {
-    unsigned int sleeping_worker_count;
-    HG_QUEUE_HEAD(hg_thread_work) queue;
-    int shutdown;
-    hg_thread_mutex_t mutex;
-    hg_thread_cond_t cond;
-};
-
 struct hg_thread_work {
     hg_thread_func_t func;
     void *args;
     HG_QUEUE_ENTRY(hg_thread_work) entry; /* Internal */
 };
 
+/* Thread pool init info */
+struct hg_thread_pool_init_info {
+    /* Number of entries of each worker queue, posting falls back to a
+     * shared queue when the worker queues are full (must be a power of 2,
+     * 0 for default) */
+    unsigned int queue_size;
+
+    /* Number of times an idle worker polls queues before going to sleep
+     * (0 for default) */
+    unsigned int spin_count;
+
+    /* Array of thread_count CPU masks that workers are bound to (NULL for
+     * no affinity) */
+    const hg_cpu_set_t *cpu_masks;
+};
+
 /*****************/
 /* Public Macros */
 /*****************/
@@ -65,6 +73,20 @@ hg_thread_pool_init(unsigned int thread_count, hg_thread_pool_t **pool);
 HG_UTIL_PUBLIC int
 hg_thread_pool_destroy(hg_thread_pool_t *pool);
 
+/**
+ * Initialize the thread pool with additional options.
+ *
+ * \param thread_count [IN]     number of threads that will be created at
+ *                              initialization
+ * \param init_info [IN]        pointer to init info (NULL for defaults)
+ * \param pool [OUT]            pointer to pool object
+ *
+ * \return Non-negative on success or negative on failure
+ */
+HG_UTIL_PUBLIC int
+hg_thread_pool_init_opt(unsigned int thread_count,
+    const struct hg_thread_pool_init_info *init_info, hg_thread_pool_t **pool);
+
 /**
  * Post work to the pool. Note that the operation may be queued depending on
  * the number of threads and number of tasks already running.
@@ -74,42 +96,22 @@ hg_thread_pool_destroy(hg_thread_pool_t *pool);
  *
  * \return Non-negative on success or negative on failure
  */
-static HG_UTIL_INLINE int
+HG_UTIL_PUBLIC int
 hg_thread_pool_post(hg_thread_pool_t *pool, struct hg_thread_work *work);
 
-/*---------------------------------------------------------------------------*/
-static HG_UTIL_INLINE int
-hg_thread_pool_post(hg_thread_pool_t *pool, struct hg_thread_work *work)
-{
-    int ret = HG_UTIL_SUCCESS;
-
-    if (!pool || !work)
-        return HG_UTIL_FAIL;
-
-    if (!work->func)
-        return HG_UTIL_FAIL;
-
-    hg_thread_mutex_lock(&pool->mutex);
-
-    /* Are we shutting down ? */
-    if (pool->shutdown) {
-        ret = HG_UTIL_FAIL;
-        goto unlock;
-    }
-
-    /* Add task to task queue */
-    HG_QUEUE_PUSH_TAIL(&pool->queue, work, entry);
-
-    /* Wake up sleeping worker */
-    if (pool->sleeping_worker_count &&
-        (hg_thread_cond_signal(&pool->cond) != HG_UTIL_SUCCESS))
-        ret = HG_UTIL_FAIL;
-
-unlock:
-    hg_thread_mutex_unlock(&pool->mutex);
-
-    return ret;
-}
+/**
+ * Post \count work items to the pool at once, sleeping workers are only
+ * woken up once for the entire batch.
+ *
+ * \param pool [IN/OUT]         pointer to pool object
+ * \param works [IN]            array of pointers to work structs
+ * \param count [IN]            number of work structs
+ *
+ * \return Non-negative on success or negative on failure
+ */
+HG_UTIL_PUBLIC int
+hg_thread_pool_post_n(hg_thread_pool_t *pool, struct hg_thread_work *works[],
+    unsigned int count);
 
 #ifdef __cplusplus
 }